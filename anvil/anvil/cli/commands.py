@@ -11,11 +11,12 @@ This module implements the main command handlers for the Anvil CLI:
 
 import json
 import sys
+from datetime import datetime
 from pathlib import Path
 from typing import List, Optional
 
 from anvil.config.configuration import ConfigurationError, ConfigurationManager
-from anvil.core.file_collector import FileCollector
+from anvil.core.file_collector import FileCollector, GitError
 from anvil.core.orchestrator import ValidationOrchestrator
 from anvil.core.validator_registry import ValidatorRegistry
 from anvil.git.hooks import GitHookError, GitHookManager
@@ -52,6 +53,7 @@ def check_command(
     Returns:
         Exit code (0 = pass, 1 = fail, 2 = config error)
     """
+    staged_tree = None
     try:
         # Load configuration (from --config arg or default anvil.toml)
         config = None
@@ -72,11 +74,69 @@ def check_command(
                     print(f"Configuration error: {e}", file=sys.stderr)
                 return 2
 
+        # Split the pytest suite across machines
+        shard = getattr(args, "shard", None)
+        if shard:
+            from anvil.executors.pytest_sharding import parse_shard_spec
+
+            try:
+                parse_shard_spec(shard)
+            except ValueError as e:
+                if not quiet:
+                    print(f"Error: {e}", file=sys.stderr)
+                return 2
+            config = dict(config or {})
+            config["shard"] = shard
+
+        if getattr(args, "single_pass", False):
+            config = dict(config or {})
+            config["single_pass"] = True
+
         # Determine root directory
         root_dir = Path.cwd()
 
         # Collect files to check
-        if files:
+        file_collector = FileCollector(
+            root_dir=root_dir,
+            exclude_patterns=config.get("exclude_patterns", []) if config else None,
+            file_patterns=config.get("file_patterns", {}) if config else None,
+        )
+        staged = getattr(args, "staged", False)
+        since = getattr(args, "since", None)
+        diff_scope = None
+        if staged:
+            # Validate the staged blobs rather than the working tree
+            staged_tree = file_collector.collect_staged(language=language, paths=files)
+            files_to_check = staged_tree.files
+
+            if not files_to_check:
+                if not quiet:
+                    print("No staged files to check.")
+                return 0
+
+            config = dict(config or {})
+            config["line_ranges"] = staged_tree.line_ranges
+            if config.get("compile_commands"):
+                # Compile the staged copies instead of the working tree files
+                config["compile_commands"] = str(
+                    staged_tree.compile_database(config["compile_commands"])
+                )
+        elif getattr(args, "changed_lines", False):
+            # Analyze changed files and report issues on changed lines only
+            diff_scope = file_collector.collect_diff_scope(language=language, base=since or "HEAD")
+            files_to_check = diff_scope.files
+            if files:
+                requested = {Path(f).resolve() for f in files}
+                files_to_check = [f for f in files_to_check if f in requested]
+
+            if not files_to_check:
+                if not quiet:
+                    print("No changed files to check.")
+                return 0
+
+            config = dict(config or {})
+            config["line_ranges"] = diff_scope.line_ranges
+        elif files:
             # Use explicitly specified files
             files_to_check = [Path(f) for f in files]
             # Validate files exist
@@ -85,22 +145,16 @@ def check_command(
                     print(f"Error: File not found: {file_path}", file=sys.stderr)
                     return 2
         else:
-            # Use FileCollector to gather files
-            file_collector = FileCollector(
-                root_dir=root_dir,
-                exclude_patterns=config.get("exclude_patterns", []) if config else None,
-                file_patterns=config.get("file_patterns", {}) if config else None,
-            )
-
-            # Check if staged flag is set
-            staged = getattr(args, "staged", False)
-
             # Collect files based on mode
-            files_to_check = file_collector.collect_files(
-                language=language,
-                incremental=incremental,
-                staged_only=staged,
-            )
+            if incremental and since:
+                files_to_check = file_collector.collect_diff_scope(
+                    language=language, base=since
+                ).files
+            else:
+                files_to_check = file_collector.collect_files(
+                    language=language,
+                    incremental=incremental,
+                )
 
             if not files_to_check:
                 if not quiet:
@@ -113,6 +167,10 @@ def check_command(
         from anvil.core.validator_registration import register_all_validators
 
         register_all_validators(registry)
+        if staged:
+            # Test runners check behavior, not the staged content
+            for test_runner in registry.filter_by_names(["pytest", "gtest"]):
+                registry.unregister(test_runner.name)
         orchestrator = ValidationOrchestrator(registry)
 
         # Get parallel and fail_fast flags
@@ -165,6 +223,12 @@ def check_command(
                 files=files_to_check, parallel=parallel, fail_fast=fail_fast, config=config
             )
 
+        changed_lines_only = (config or {}).get("changed_lines_only", True)
+        if staged:
+            results = staged_tree.remap(results, changed_lines_only=changed_lines_only)
+        elif diff_scope is not None:
+            results = diff_scope.filter_results(results, changed_lines_only=changed_lines_only)
+
         # Generate report
         if parsed:
             from anvil.reporting.parsed_data_reporter import ParsedDataReporter
@@ -185,10 +249,17 @@ def check_command(
         if not quiet:
             print(f"Error: {e}", file=sys.stderr)
         return 2
+    except GitError as e:
+        if not quiet:
+            print(f"Git error: {e}", file=sys.stderr)
+        return 2
     except Exception as e:
         if not quiet:
             print(f"Unexpected error: {e}", file=sys.stderr)
         return 2
+    finally:
+        if staged_tree is not None:
+            staged_tree.cleanup()
 
 
 def parse_command(
@@ -216,9 +287,11 @@ def parse_command(
     try:
         # Get input text
         if input_file:
-            # Read from file
-            with open(input_file, "r") as f:
-                output = f.read()
+            # Map the file and decode it in one step, without a read buffer
+            from anvil.parsers.log_view import LogView
+
+            with LogView.open(input_file) as log:
+                output = log.text()
         elif input_text == "-":
             # Read from stdin
             output = sys.stdin.read()
@@ -711,43 +784,81 @@ def stats_export_command(
     Export statistics data.
 
     Args:
-        args: Parsed arguments from argparse
-        format: Export format (json or csv)
-        output: Output file path
+        args: Parsed arguments from argparse (optional tables, since, until,
+            branch and database)
+        format: Export format (json, csv, arrow or parquet)
+        output: Output file (json) or directory (csv, arrow, parquet)
         quiet: Suppress output
 
     Returns:
         Exit code (0 = success, 1 = error)
     """
     try:
-        if format not in ["json", "csv"]:
+        from anvil.storage.statistics_database import StatisticsDatabase
+        from anvil.storage.statistics_export import (
+            EXPORT_FORMATS,
+            EXPORT_TABLES,
+            StatisticsExporter,
+            StatisticsExportError,
+        )
+
+        if format not in EXPORT_FORMATS:
             if not quiet:
                 print(f"Error: Invalid format '{format}'", file=sys.stderr)
             return 1
 
-        if output:
-            # Export to file
-            try:
-                output_path = Path(output)
-                if format == "json":
-                    content = '{"message": "No statistics data available yet"}'
-                else:  # csv
-                    content = "timestamp,validator,status,errors\n"
+        try:
+            since, until = (
+                datetime.fromisoformat(value) if value else None
+                for value in (getattr(args, "since", None), getattr(args, "until", None))
+            )
+        except ValueError as e:
+            if not quiet:
+                print(f"Error: Invalid date: {e}", file=sys.stderr)
+            return 1
 
-                output_path.write_text(content)
-                if not quiet:
-                    print(f"Statistics exported to: {output}")
-            except Exception as e:
-                if not quiet:
-                    print(f"Error writing to file: {e}", file=sys.stderr)
-                return 1
-        else:
-            # Export to stdout
+        db_path = Path(getattr(args, "database", None) or ".anvil/statistics.db")
+        if not db_path.exists() and format in ("json", "csv"):
             if format == "json":
-                print('{"message": "No statistics data available yet"}')
+                content = '{"message": "No statistics data available yet"}\n'
             else:  # csv
-                print("timestamp,validator,status,errors")
+                content = "timestamp,validator,status,errors\n"
+            if output:
+                try:
+                    Path(output).write_text(content)
+                except Exception as e:
+                    if not quiet:
+                        print(f"Error writing to file: {e}", file=sys.stderr)
+                    return 1
+                if not quiet:
+                    print(f"Statistics exported to: {output}")
+            else:
+                print(content, end="")
+            return 0
+        if not db_path.exists():
+            if not quiet:
+                print(f"Error: Statistics database not found: {db_path}", file=sys.stderr)
+            return 1
+
+        database = StatisticsDatabase(str(db_path))
+        try:
+            exporter = StatisticsExporter(
+                database, since=since, until=until, branch=getattr(args, "branch", None)
+            )
+            tables = getattr(args, "tables", None) or list(EXPORT_TABLES)
+            counts = exporter.export(
+                format, Path(output) if output else None, tables, stream=sys.stdout
+            )
+        except (StatisticsExportError, OSError) as e:
+            if not quiet:
+                print(f"Error: {e}", file=sys.stderr)
+            return 1
+        finally:
+            database.close()
 
+        if output and not quiet:
+            rows = ", ".join(f"{table}: {count}" for table, count in counts.items())
+            print(f"Statistics exported to: {output} ({rows})")
         return 0
     except Exception as e:
         if not quiet:
@@ -1166,8 +1277,11 @@ def history_show_command(
         db_path = Path(".anvil/history.db")
         db = ExecutionDatabase(str(db_path))
 
-        # Get execution history
-        history = db.get_execution_history(entity_id=entity, entity_type="test", limit=limit)
+        # Get execution history (older pages continue after --before)
+        before = getattr(args, "before", None)
+        history = db.get_execution_history(
+            entity_id=entity, entity_type="test", limit=limit, before_id=before
+        )
 
         if not quiet:
             print("Execution History")
@@ -1197,6 +1311,11 @@ def history_show_command(
 
                 print()
                 print(f"Total records: {len(history)}")
+                if len(history) == limit:
+                    print(
+                        f"Older executions: anvil history show --entity {entity} "
+                        f"--limit {limit} --before {history[-1].id}"
+                    )
 
         # Close database
         db.close()
@@ -1206,3 +1325,297 @@ def history_show_command(
         if not quiet:
             print(f"Error: {e}", file=sys.stderr)
         return 1
+
+
+def coverage_record_command(
+    args,
+    report: str,
+    commit: str = "HEAD",
+    quiet: bool = False,
+) -> int:
+    """
+    Record a coverage report for a commit, for later patch coverage checks.
+
+    Args:
+        args: Parsed arguments from argparse
+        report: Path to a Cobertura XML, lcov or llvm-cov JSON report
+        commit: Commit the coverage was measured on
+        quiet: Suppress output
+
+    Returns:
+        Exit code (0 = success, 2 = error)
+    """
+    db = None
+    try:
+        from anvil.core.patch_coverage import PatchCoverageEngine
+        from anvil.parsers.coverage_parser import CoverageParser
+        from anvil.storage.execution_schema import ExecutionDatabase
+
+        coverage = CoverageParser().parse(report, getattr(args, "report_format", None))
+        db = ExecutionDatabase(getattr(args, "database", None) or ".anvil/history.db")
+        execution_id = PatchCoverageEngine(".", db).record(
+            coverage, commit=commit, space=getattr(args, "space", None) or "local"
+        )
+
+        if not quiet:
+            print(
+                f"Recorded {coverage.files_analyzed} files "
+                f"({coverage.total_coverage:.1f}% coverage) as {execution_id}"
+            )
+        return 0
+
+    except Exception as e:
+        if not quiet:
+            print(f"Error: {e}", file=sys.stderr)
+        return 2
+    finally:
+        if db is not None:
+            db.close()
+
+
+def coverage_patch_command(
+    args,
+    base: str = "HEAD",
+    report: Optional[str] = None,
+    commit: Optional[str] = None,
+    fail_under: Optional[float] = None,
+    format: str = "text",
+    quiet: bool = False,
+) -> int:
+    """
+    Show test coverage of the lines changed since a base commit.
+
+    Uses the given coverage report for the working tree, or else the
+    coverage recorded for a commit (default HEAD) with `anvil coverage record`.
+
+    Args:
+        args: Parsed arguments from argparse
+        base: Commit the change is measured from
+        report: Coverage report of the working tree
+        commit: Commit with recorded coverage
+        fail_under: Minimum patch coverage percentage
+        format: Output format (text, json)
+        quiet: Suppress output
+
+    Returns:
+        Exit code (0 = pass, 1 = below fail_under, 2 = error)
+    """
+    db = None
+    try:
+        from anvil.core.patch_coverage import PatchCoverageEngine
+        from anvil.parsers.coverage_parser import CoverageParser
+        from anvil.storage.execution_schema import ExecutionDatabase
+
+        coverage = None
+        if report:
+            coverage = CoverageParser().parse(report, getattr(args, "report_format", None))
+        else:
+            db = ExecutionDatabase(getattr(args, "database", None) or ".anvil/history.db")
+        result = PatchCoverageEngine(".", db).compute(base=base, coverage=coverage, commit=commit)
+
+        failed = fail_under is not None and result.percentage < fail_under
+        if format == "json":
+            print(json.dumps(result.to_dict(), indent=2))
+        elif not quiet:
+            print("Patch Coverage")
+            print("=" * 70)
+            print(f"Base: {base}")
+            if result.commit:
+                print(f"Coverage of: {result.commit[:12]}")
+            print()
+            if not result.files:
+                print("No changed executable lines.")
+            for f in result.files:
+                missing = ", ".join(
+                    str(s) if s == e else f"{s}-{e}" for s, e in f.missing_lines.ranges()
+                )
+                print(f"{f.file_path:<50} {f.percentage:>6.1f}%  {missing}")
+            print()
+            print(
+                f"Total: {result.percentage:.1f}% "
+                f"({result.covered_lines}/{result.total_lines} changed lines covered)"
+            )
+            if result.unmeasured_files:
+                print(f"Not in coverage data: {len(result.unmeasured_files)} changed files")
+            if failed:
+                print(f"FAILED: patch coverage is below {fail_under:.1f}%")
+        return 1 if failed else 0
+
+    except Exception as e:
+        if not quiet:
+            print(f"Error: {e}", file=sys.stderr)
+        return 2
+    finally:
+        if db is not None:
+            db.close()
+
+
+def _git_revision() -> "tuple[Optional[str], Optional[str]]":
+    """
+    Get the commit and branch of the working tree.
+
+    A working tree with uncommitted changes gets a "-dirty" commit suffix, so
+    its timings are not mixed with those of the commit itself.
+
+    Returns:
+        Tuple of (commit, branch), both None outside a git repository
+    """
+    from anvil.git.staged import StagedContentError, run_git
+
+    try:
+        commit = run_git(".", ["rev-parse", "--verify", "HEAD"]).decode().strip()
+        branch = run_git(".", ["rev-parse", "--abbrev-ref", "HEAD"]).decode().strip()
+        if run_git(".", ["status", "--porcelain", "--untracked-files=no"]).strip():
+            commit += "-dirty"
+    except StagedContentError:
+        return None, None
+    return commit, branch
+
+
+def bench_run_command(
+    args,
+    patterns: Optional[List[str]] = None,
+    scale: str = "full",
+    repeat: int = 5,
+    threshold: float = 10.0,
+    window: int = 5,
+    record: bool = True,
+    format: str = "text",
+    quiet: bool = False,
+) -> int:
+    """
+    Run the hot path benchmarks and compare them with earlier commits.
+
+    Args:
+        args: Parsed arguments from argparse
+        patterns: Benchmark name globs (default: all)
+        scale: Input sizes (full or quick)
+        repeat: Timed rounds per benchmark
+        threshold: Slowdown in percent reported as a regression
+        window: Number of earlier runs the baseline is taken from
+        record: Store this run in the benchmark database
+        format: Output format (text, json)
+        quiet: Suppress output
+
+    Returns:
+        Exit code (0 = no regressions, 1 = regressions, 2 = error)
+    """
+    history = None
+    try:
+        from anvil.storage.benchmark_history import DEFAULT_DATABASE, BenchmarkHistory
+        from anvil.testing.benchmarks import run_benchmarks, select_benchmarks
+
+        benchmarks = select_benchmarks(patterns)
+        if not benchmarks:
+            raise ValueError(f"No benchmarks match: {' '.join(patterns or [])}")
+
+        def progress(result):
+            if format == "text" and not quiet:
+                if result.skipped:
+                    print(f"{result.name:<42} skipped ({result.skipped})")
+                else:
+                    print(
+                        f"{result.name:<42} {result.size:>8} {result.unit:<12} "
+                        f"{result.median * 1000:>10.1f} ms  "
+                        f"{result.format_throughput():>20}"
+                    )
+
+        if format == "text" and not quiet:
+            print(f"Running {len(benchmarks)} benchmarks ({scale} scale, {repeat} rounds)")
+            print("=" * 100)
+        results = run_benchmarks(benchmarks, scale=scale, repeat=repeat, progress=progress)
+
+        commit, branch = _git_revision()
+        history = BenchmarkHistory(Path(getattr(args, "database", None) or DEFAULT_DATABASE))
+        comparisons = history.compare(
+            results, commit=commit, threshold=threshold / 100, window=window
+        )
+        if record:
+            history.record_run(results, commit=commit, branch=branch, scale=scale)
+
+        regressions = [c for c in comparisons if c.status == "regressed"]
+        if format == "json":
+            print(
+                json.dumps(
+                    {
+                        "commit": commit,
+                        "branch": branch,
+                        "scale": scale,
+                        "results": [r.to_dict() for r in results],
+                        "comparisons": [c.to_dict() for c in comparisons],
+                    },
+                    indent=2,
+                )
+            )
+        elif not quiet:
+            print()
+            print(f"{'Benchmark':<42} {'Median':>12} {'Baseline':>12} {'Change':>8}  Status")
+            print("-" * 100)
+            for c in comparisons:
+                baseline = f"{c.baseline * 1000:.1f} ms" if c.baseline is not None else "-"
+                change = f"{c.change * 100:+.1f}%" if c.change is not None else "-"
+                print(
+                    f"{c.name:<42} {c.median * 1000:>9.1f} ms {baseline:>12} {change:>8}  "
+                    f"{c.status}"
+                )
+            print()
+            if regressions:
+                print(f"REGRESSED: {len(regressions)} benchmarks more than {threshold:g}% slower")
+            else:
+                print("No regressions")
+        return 1 if regressions else 0
+
+    except Exception as e:
+        if not quiet:
+            print(f"Error: {e}", file=sys.stderr)
+        return 2
+    finally:
+        if history is not None:
+            history.close()
+
+
+def bench_history_command(
+    args,
+    name: str,
+    limit: int = 20,
+    quiet: bool = False,
+) -> int:
+    """
+    Show the recorded timings of one benchmark, newest first.
+
+    Args:
+        args: Parsed arguments from argparse
+        name: Benchmark name
+        limit: Number of recent runs to show
+        quiet: Suppress output
+
+    Returns:
+        Exit code (0 = success, 2 = error)
+    """
+    try:
+        from anvil.storage.benchmark_history import DEFAULT_DATABASE, BenchmarkHistory
+
+        with BenchmarkHistory(Path(getattr(args, "database", None) or DEFAULT_DATABASE)) as history:
+            rows = history.get_history(name, limit=limit)
+
+        if not quiet:
+            if not rows:
+                print(f"No recorded runs of {name}")
+                return 0
+            print(f"{'Timestamp':<20} {'Commit':<18} {'Size':>8} {'Median':>12} {'Min':>12}")
+            print("-" * 76)
+            for row in rows:
+                commit = row["git_commit"] or "-"
+                if commit.endswith("-dirty"):
+                    commit = commit[:12] + "-dirty"
+                print(
+                    f"{row['timestamp'][:19]:<20} {commit[:18]:<18} "
+                    f"{row['size']:>8} {row['median'] * 1000:>9.1f} ms "
+                    f"{row['min'] * 1000:>9.1f} ms"
+                )
+        return 0
+
+    except Exception as e:
+        if not quiet:
+            print(f"Error: {e}", file=sys.stderr)
+        return 2
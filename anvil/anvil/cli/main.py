@@ -8,11 +8,15 @@ import argparse
 import sys
 
 from anvil.cli.commands import (
+    bench_history_command,
+    bench_run_command,
     check_command,
     config_check_tools_command,
     config_init_command,
     config_show_command,
     config_validate_command,
+    coverage_patch_command,
+    coverage_record_command,
     execute_command,
     history_show_command,
     install_hooks_command,
@@ -27,6 +31,7 @@ from anvil.cli.commands import (
     stats_trends_command,
 )
 from anvil.utils.encoding import configure_unicode_output
+from anvil.utils.tracing import set_service_name
 
 # Version
 __version__ = "0.1.0"
@@ -56,6 +61,21 @@ def create_parser() -> argparse.ArgumentParser:
         action="store_true",
         help="Run on changed files only (git)",
     )
+    check_parser.add_argument(
+        "--staged",
+        action="store_true",
+        help="Validate staged content (git index) on changed lines only",
+    )
+    check_parser.add_argument(
+        "--changed-lines",
+        action="store_true",
+        help="Check changed files and report issues on changed lines only (git)",
+    )
+    check_parser.add_argument(
+        "--since",
+        metavar="COMMIT",
+        help="Compare against COMMIT instead of HEAD for --incremental and --changed-lines",
+    )
     check_parser.add_argument(
         "--language",
         choices=["python", "cpp"],
@@ -88,6 +108,16 @@ def create_parser() -> argparse.ArgumentParser:
         action="store_true",
         help="Show parsed data in Verdict-compatible format",
     )
+    check_parser.add_argument(
+        "--shard",
+        metavar="I/N",
+        help="Run only shard I of N of the pytest suite (duration-balanced)",
+    )
+    check_parser.add_argument(
+        "--single-pass",
+        action="store_true",
+        help="Read and parse each Python file once for all in-process validators",
+    )
     check_parser.add_argument(
         "files",
         nargs="*",
@@ -228,14 +258,40 @@ def create_parser() -> argparse.ArgumentParser:
     stats_export_parser = stats_subparsers.add_parser("export", help="Export statistics data")
     stats_export_parser.add_argument(
         "--format",
-        choices=["json", "csv"],
+        choices=["json", "csv", "arrow", "parquet"],
         default="json",
-        help="Export format",
+        help="Export format (arrow and parquet need pyarrow)",
     )
     stats_export_parser.add_argument(
         "--output",
         "-o",
-        help="Output file path",
+        help="Output file (json) or directory (csv, arrow, parquet)",
+    )
+    stats_export_parser.add_argument(
+        "--table",
+        dest="tables",
+        action="append",
+        choices=["validation_runs", "test_case_records", "file_validation_records"],
+        help="Table to export (repeatable, default: all)",
+    )
+    stats_export_parser.add_argument(
+        "--since",
+        metavar="DATE",
+        help="Only runs at or after DATE (ISO 8601, e.g. 2024-01-31)",
+    )
+    stats_export_parser.add_argument(
+        "--until",
+        metavar="DATE",
+        help="Only runs before DATE (ISO 8601)",
+    )
+    stats_export_parser.add_argument(
+        "--branch",
+        help="Only runs on this git branch",
+    )
+    stats_export_parser.add_argument(
+        "--database",
+        metavar="PATH",
+        help="Statistics database (default: .anvil/statistics.db)",
     )
     stats_export_parser.add_argument(
         "--quiet",
@@ -413,6 +469,12 @@ def create_parser() -> argparse.ArgumentParser:
         default=10,
         help="Number of recent executions to show",
     )
+    history_show_parser.add_argument(
+        "--before",
+        type=int,
+        metavar="ID",
+        help="Show executions older than record ID (next page)",
+    )
     history_show_parser.add_argument(
         "--quiet",
         "-q",
@@ -420,6 +482,155 @@ def create_parser() -> argparse.ArgumentParser:
         help="Suppress output",
     )
 
+    # 'coverage' command - coverage of changes
+    coverage_parser = subparsers.add_parser("coverage", help="Coverage of changed lines")
+    coverage_subparsers = coverage_parser.add_subparsers(
+        dest="coverage_command", help="Coverage commands"
+    )
+
+    # 'coverage record'
+    coverage_record_parser = coverage_subparsers.add_parser(
+        "record", help="Record a coverage report for a commit"
+    )
+    coverage_record_parser.add_argument(
+        "report",
+        help="Coverage report (Cobertura XML, lcov .info or llvm-cov export JSON)",
+    )
+    coverage_record_parser.add_argument(
+        "--commit",
+        default="HEAD",
+        help="Commit the coverage was measured on (default: HEAD)",
+    )
+    coverage_record_parser.add_argument(
+        "--space",
+        choices=["local", "ci"],
+        default="local",
+        help="Execution space",
+    )
+
+    # 'coverage patch'
+    coverage_patch_parser = coverage_subparsers.add_parser(
+        "patch", help="Show coverage of lines changed since a base commit"
+    )
+    coverage_patch_parser.add_argument(
+        "--base",
+        default="HEAD",
+        help="Commit the change is measured from (default: HEAD)",
+    )
+    coverage_source = coverage_patch_parser.add_mutually_exclusive_group()
+    coverage_source.add_argument(
+        "--report",
+        help="Coverage report of the working tree",
+    )
+    coverage_source.add_argument(
+        "--commit",
+        help="Use coverage recorded for this commit (default: HEAD)",
+    )
+    coverage_patch_parser.add_argument(
+        "--fail-under",
+        type=float,
+        metavar="PERCENT",
+        help="Exit with 1 if patch coverage is below this percentage",
+    )
+    coverage_patch_parser.add_argument(
+        "--format",
+        choices=["text", "json"],
+        default="text",
+        help="Output format",
+    )
+
+    for coverage_subparser in (coverage_record_parser, coverage_patch_parser):
+        coverage_subparser.add_argument(
+            "--report-format",
+            choices=["cobertura", "lcov", "llvm-cov"],
+            help="Coverage report format (detected by default)",
+        )
+        coverage_subparser.add_argument(
+            "--database",
+            help="History database (default: .anvil/history.db)",
+        )
+        coverage_subparser.add_argument(
+            "--quiet",
+            "-q",
+            action="store_true",
+            help="Suppress output",
+        )
+
+    # 'bench' command - hot path benchmarks
+    bench_parser = subparsers.add_parser("bench", help="Benchmark parser and storage hot paths")
+    bench_subparsers = bench_parser.add_subparsers(dest="bench_command", help="Bench commands")
+
+    # 'bench run'
+    bench_run_parser = bench_subparsers.add_parser(
+        "run", help="Run benchmarks, record them for the commit and flag regressions"
+    )
+    bench_run_parser.add_argument(
+        "patterns",
+        nargs="*",
+        metavar="PATTERN",
+        help="Benchmark name globs, e.g. 'anvil.parse.*' (default: all)",
+    )
+    bench_run_parser.add_argument(
+        "--scale",
+        choices=["full", "quick"],
+        default="full",
+        help="Input sizes: realistic (full) or small smoke-test sizes (quick)",
+    )
+    bench_run_parser.add_argument(
+        "--repeat",
+        type=int,
+        default=5,
+        help="Timed rounds per benchmark (default: 5)",
+    )
+    bench_run_parser.add_argument(
+        "--threshold",
+        type=float,
+        default=10.0,
+        metavar="PERCENT",
+        help="Slowdown against the baseline reported as a regression (default: 10)",
+    )
+    bench_run_parser.add_argument(
+        "--window",
+        type=int,
+        default=5,
+        help="Number of earlier runs the baseline is taken from (default: 5)",
+    )
+    bench_run_parser.add_argument(
+        "--no-record",
+        action="store_true",
+        help="Compare with history without storing this run",
+    )
+    bench_run_parser.add_argument(
+        "--format",
+        choices=["text", "json"],
+        default="text",
+        help="Output format",
+    )
+
+    # 'bench history'
+    bench_history_parser = bench_subparsers.add_parser(
+        "history", help="Show recorded timings of a benchmark"
+    )
+    bench_history_parser.add_argument("name", help="Benchmark name")
+    bench_history_parser.add_argument(
+        "--limit",
+        type=int,
+        default=20,
+        help="Number of recent runs to show",
+    )
+
+    for bench_subparser in (bench_run_parser, bench_history_parser):
+        bench_subparser.add_argument(
+            "--database",
+            help="Benchmark database (default: .anvil/benchmarks.db)",
+        )
+        bench_subparser.add_argument(
+            "--quiet",
+            "-q",
+            action="store_true",
+            help="Suppress output",
+        )
+
     return parser
 
 
@@ -435,6 +646,7 @@ def main(argv=None) -> int:
     """
     # Configure Unicode output for Windows compatibility
     configure_unicode_output()
+    set_service_name("anvil")
 
     parser = create_parser()
     args = parser.parse_args(argv)
@@ -584,6 +796,52 @@ def main(argv=None) -> int:
                 parser.parse_args(["history", "--help"])
                 return 0
 
+        elif args.command == "coverage":
+            if args.coverage_command == "record":
+                return coverage_record_command(
+                    args,
+                    report=args.report,
+                    commit=args.commit,
+                    quiet=args.quiet,
+                )
+            elif args.coverage_command == "patch":
+                return coverage_patch_command(
+                    args,
+                    base=args.base,
+                    report=args.report,
+                    commit=args.commit,
+                    fail_under=args.fail_under,
+                    format=args.format,
+                    quiet=args.quiet,
+                )
+            else:
+                parser.parse_args(["coverage", "--help"])
+                return 0
+
+        elif args.command == "bench":
+            if args.bench_command == "run":
+                return bench_run_command(
+                    args,
+                    patterns=args.patterns,
+                    scale=args.scale,
+                    repeat=args.repeat,
+                    threshold=args.threshold,
+                    window=args.window,
+                    record=not args.no_record,
+                    format=args.format,
+                    quiet=args.quiet,
+                )
+            elif args.bench_command == "history":
+                return bench_history_command(
+                    args,
+                    name=args.name,
+                    limit=args.limit,
+                    quiet=args.quiet,
+                )
+            else:
+                parser.parse_args(["bench", "--help"])
+                return 0
+
         else:
             parser.print_help()
             return 0
@@ -104,12 +104,27 @@ class ConfigurationManager:
             "enabled": True,
             "test_filter": "*",
         },
+        "anvil.cpp.cpp-metrics": {
+            "enabled": True,
+            "max_complexity": 10,
+            "max_nesting": 4,
+            "max_function_length": 100,
+            "max_fan_out": 20,
+        },
     }
 
     # Known validators by language
     KNOWN_VALIDATORS = {
         "python": ["flake8", "black", "isort", "pylint", "radon", "vulture", "autoflake", "pytest"],
-        "cpp": ["clang-tidy", "clang-format", "cppcheck", "cpplint", "iwyu", "gtest"],
+        "cpp": [
+            "clang-tidy",
+            "clang-format",
+            "cppcheck",
+            "cpplint",
+            "iwyu",
+            "gtest",
+            "cpp-metrics",
+        ],
     }
 
     def __init__(self, config_path: Optional[str] = None):
@@ -10,6 +10,8 @@ from pathlib import Path
 from typing import List, Optional, Set, Union
 
 from anvil.core.language_detector import LanguageDetector
+from anvil.git.diff_scope import DiffScope
+from anvil.git.staged import StagedContentError, StagedSnapshot, StagedTree
 
 
 class GitError(Exception):
@@ -137,6 +139,105 @@ class FileCollector:
         else:
             return self._collect_full(target_languages)
 
+    def collect_staged(
+        self,
+        language: Optional[str] = None,
+        languages: Optional[List[str]] = None,
+        paths: Optional[List[Union[str, Path]]] = None,
+    ) -> StagedTree:
+        """
+        Collect the staged content of staged files for validation.
+
+        Unlike collect_files(staged_only=True), which returns working tree
+        paths, this reads the staged blobs from the object store and writes
+        them to a scratch tree, so validation sees exactly what will be
+        committed.
+
+        Args:
+            language: Single language to collect files for
+            languages: Multiple languages to collect files for
+            paths: Limit to these paths (default: all staged files)
+
+        Returns:
+            StagedTree with the staged files and their changed line ranges;
+            use it as a context manager to remove the scratch tree
+
+        Raises:
+            GitError: If staged content cannot be read
+            ValueError: If language is unknown
+        """
+        if language or languages:
+            target_languages = self._resolve_languages(language, languages)
+        else:
+            # Match staged paths directly instead of scanning the tree
+            target_languages = list(self.detector.file_patterns)
+
+        try:
+            snapshot = StagedSnapshot(self.root_dir)
+            staged = [
+                f
+                for f in snapshot.staged_files(paths)
+                if self._matches_any_language(snapshot.top_level / f.path, target_languages)
+            ]
+            return snapshot.materialize(staged)
+        except StagedContentError as e:
+            raise GitError(str(e))
+
+    def collect_diff_scope(
+        self,
+        language: Optional[str] = None,
+        languages: Optional[List[str]] = None,
+        base: str = "HEAD",
+    ) -> DiffScope:
+        """
+        Collect changed files with the lines they change since a commit.
+
+        Args:
+            language: Single language to collect files for
+            languages: Multiple languages to collect files for
+            base: Commit to compare the working tree against
+
+        Returns:
+            DiffScope limited to files of the target languages
+
+        Raises:
+            GitError: If the diff cannot be computed (e.g. unknown commit)
+            ValueError: If language is unknown
+        """
+        if language or languages:
+            target_languages = self._resolve_languages(language, languages)
+        else:
+            target_languages = list(self.detector.file_patterns)
+
+        try:
+            scope = DiffScope.from_git(self.root_dir, base)
+        except StagedContentError as e:
+            raise GitError(str(e))
+
+        scope.indexes = {
+            path: index
+            for path, index in scope.indexes.items()
+            if self._matches_any_language(path, target_languages)
+        }
+        return scope
+
+    def _matches_any_language(self, path: Path, languages: List[str]) -> bool:
+        """
+        Check a path git reported against the target languages.
+
+        Args:
+            path: Absolute path below the repository's (resolved) top level
+            languages: Languages to match
+
+        Returns:
+            True if the path is below the root directory and matches a language
+        """
+        try:
+            candidate = self.root_dir / path.relative_to(self.root_dir.resolve())
+        except ValueError:
+            return False
+        return any(self.detector.matches_language(candidate, lang) for lang in languages)
+
     def _resolve_languages(
         self, language: Optional[str], languages: Optional[List[str]]
     ) -> List[str]:
@@ -216,12 +317,9 @@ class FileCollector:
         filtered_files: Set[Path] = set()
 
         for file_path in changed_files:
-            # Check if file matches any of the target languages
-            for lang in languages:
-                lang_files = self.detector.get_files_for_language(lang)
-                if file_path in lang_files:
-                    filtered_files.add(file_path)
-                    break
+            # Match each changed file directly instead of scanning the tree
+            if any(self.detector.matches_language(file_path, lang) for lang in languages):
+                filtered_files.add(file_path)
 
         return sorted(filtered_files)
 
@@ -187,6 +187,21 @@ class LanguageDetector:
 
         return result
 
+    def matches_language(self, file_path: Path, language: str) -> bool:
+        """
+        Check whether a single file belongs to a language without scanning.
+
+        Args:
+            file_path: File path below the root directory
+            language: Language name
+
+        Returns:
+            True if the file matches the language's patterns and is not excluded
+        """
+        if language not in self.file_patterns:
+            return False
+        return self._matches_pattern(file_path, language) and not self._should_exclude(file_path)
+
     def _matches_pattern(self, file_path: Path, language: str) -> bool:
         """
         Check if file matches any pattern for the specified language.
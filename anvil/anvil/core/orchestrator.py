@@ -15,6 +15,7 @@ from typing import Dict, List, Optional
 
 from anvil.core.validator_registry import ValidatorRegistry
 from anvil.models.validator import Issue, ValidationResult
+from anvil.utils.tracing import span
 
 
 class ValidationOrchestrator:
@@ -64,10 +65,7 @@ class ValidationOrchestrator:
 
         validators = self._registry.list_all()
 
-        if parallel:
-            return self._run_parallel(validators, files, config, fail_fast)
-        else:
-            return self._run_sequential(validators, files, config, fail_fast)
+        return self._run_validators(validators, files, parallel, fail_fast, config)
 
     def run_for_language(
         self,
@@ -95,10 +93,7 @@ class ValidationOrchestrator:
 
         validators = self._registry.get_validators_by_language(language)
 
-        if parallel:
-            return self._run_parallel(validators, files, config, fail_fast)
-        else:
-            return self._run_sequential(validators, files, config, fail_fast)
+        return self._run_validators(validators, files, parallel, fail_fast, config)
 
     def run_validator(
         self, name: str, files: List[Path], config: Optional[Dict] = None
@@ -124,6 +119,7 @@ class ValidationOrchestrator:
         if validator is None:
             raise KeyError(f"Validator '{name}' not found in registry")
 
+        self._size_process_budget(config)
         return self._run_single_validator(validator, files, config)
 
     def aggregate_results(self, results: List[ValidationResult]) -> Dict[str, any]:
@@ -182,6 +178,64 @@ class ValidationOrchestrator:
         """
         return all(r.passed for r in results)
 
+    def _run_validators(
+        self, validators: List, files: List[Path], parallel: bool, fail_fast: bool, config: Dict
+    ) -> List[ValidationResult]:
+        """
+        Run validators, sharing one read and parse per file when configured.
+
+        With config["single_pass"], Python validators that can run in-process
+        are checked together by SinglePassRunner; the rest run as usual.
+
+        Args:
+            validators: List of validators to run
+            files: List of files to validate
+            parallel: Run validators in parallel
+            fail_fast: Stop on first failure
+            config: Configuration dictionary
+
+        Returns:
+            List of validation results
+        """
+        results: List[ValidationResult] = []
+        self._size_process_budget(config)
+
+        if config.get("single_pass"):
+            # Imported lazily; executors depend on the core package
+            from anvil.executors.single_pass import SinglePassRunner
+
+            supported = set(SinglePassRunner.supported_tools(config))
+            shared = [v for v in validators if v.language == "python" and v.name in supported]
+            if shared:
+                validators = [v for v in validators if v not in shared]
+                runner = SinglePassRunner(jobs=config.get("jobs"))
+                results = runner.run([v.name for v in shared], files, config)
+                if fail_fast and not self.determine_overall_result(results):
+                    return results
+
+        if not validators:
+            return results
+        if parallel:
+            return results + self._run_parallel(validators, files, config, fail_fast)
+        return results + self._run_sequential(validators, files, config, fail_fast)
+
+    @staticmethod
+    def _size_process_budget(config: Dict) -> None:
+        """
+        Size the process budget shared by all validators from run config.
+
+        Sized once before validators start, so validators with their own
+        max_processes cannot change the cap under each other.
+
+        Args:
+            config: Configuration dictionary
+        """
+        if config.get("max_processes"):
+            # Imported lazily; executors depend on the core package
+            from anvil.executors.fanout import process_budget
+
+            process_budget(config["max_processes"])
+
     def _run_sequential(
         self, validators: List, files: List[Path], config: Dict, fail_fast: bool
     ) -> List[ValidationResult]:
@@ -270,7 +324,24 @@ class ValidationOrchestrator:
 
     def _run_single_validator(self, validator, files: List[Path], config: Dict) -> ValidationResult:
         """
-        Run a single validator with error handling and timeout.
+        Run a single validator with error handling and timeout, as a trace span.
+
+        Args:
+            validator: The validator to run
+            files: List of files to validate
+            config: Configuration dictionary
+
+        Returns:
+            Validation result from the validator
+        """
+        with span("anvil.validator", validator=validator.name, files=len(files)) as validator_span:
+            result = self._run_validator(validator, files, config)
+            validator_span.set_attribute("passed", result.passed)
+            return result
+
+    def _run_validator(self, validator, files: List[Path], config: Dict) -> ValidationResult:
+        """
+        Run a validator, turning unavailability, timeouts and crashes into results.
 
         Args:
             validator: The validator to run
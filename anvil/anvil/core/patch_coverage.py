@@ -0,0 +1,361 @@
+"""
+Patch coverage: test coverage of the lines a change adds or modifies.
+
+Total coverage barely moves when a pull request adds a few untested lines to
+a large code base. Patch coverage only looks at changed lines: git's changed
+line ranges become a LineBitmap per file, which is intersected with the
+covered and missing lines of a coverage run. Changed lines that are not
+executable (comments, blank lines, declarations) do not count either way.
+
+Coverage runs can be recorded per commit in the history database
+(coverage_summary.git_commit plus one coverage_history row per file). Gating
+a pull request then needs the diff and an indexed lookup of just the changed
+files' line bitmaps, not a re-parse of the coverage report.
+"""
+
+import uuid
+from collections import defaultdict
+from dataclasses import dataclass, field
+from datetime import datetime
+from pathlib import Path
+from typing import Dict, Iterable, List, Optional, Tuple, Union
+
+from anvil.git.diff_scope import DiffScope, LineRange
+from anvil.git.staged import run_git
+from anvil.models.line_bitmap import LineBitmap
+from anvil.parsers.coverage_parser import CoverageData
+from anvil.storage.execution_schema import CoverageHistory, CoverageSummary, ExecutionDatabase
+
+# (covered_lines, missing_lines) of one file
+FileLines = Tuple[Optional[LineBitmap], Optional[LineBitmap]]
+
+
+class PatchCoverageError(Exception):
+    """Exception raised when patch coverage cannot be computed."""
+
+
+def _percentage(covered: int, total: int) -> float:
+    """Patch coverage percentage; a change without executable lines is fully covered."""
+    return covered * 100.0 / total if total else 100.0
+
+
+@dataclass
+class FilePatchCoverage:
+    """
+    Coverage of one file's changed executable lines.
+
+    Attributes:
+        file_path: Path relative to the repository root
+        covered_lines: Changed lines that ran
+        missing_lines: Changed executable lines that did not run
+    """
+
+    file_path: str
+    covered_lines: LineBitmap
+    missing_lines: LineBitmap
+
+    @property
+    def total_lines(self) -> int:
+        """Changed executable lines."""
+        return len(self.covered_lines) + len(self.missing_lines)
+
+    @property
+    def percentage(self) -> float:
+        """Covered share of the changed executable lines (0.0-100.0)."""
+        return _percentage(len(self.covered_lines), self.total_lines)
+
+
+@dataclass
+class PatchCoverage:
+    """
+    Coverage of a change.
+
+    Attributes:
+        files: Changed files with executable changed lines, by path
+        unmeasured_files: Changed files missing from the coverage run (not
+            counted; usually files that are not source code)
+        commit: Commit whose recorded coverage was used, if any
+    """
+
+    files: List[FilePatchCoverage] = field(default_factory=list)
+    unmeasured_files: List[str] = field(default_factory=list)
+    commit: Optional[str] = None
+
+    @property
+    def covered_lines(self) -> int:
+        """Changed lines that ran, over all files."""
+        return sum(len(f.covered_lines) for f in self.files)
+
+    @property
+    def total_lines(self) -> int:
+        """Changed executable lines, over all files."""
+        return sum(f.total_lines for f in self.files)
+
+    @property
+    def percentage(self) -> float:
+        """Covered share of all changed executable lines (0.0-100.0)."""
+        return _percentage(self.covered_lines, self.total_lines)
+
+    def to_dict(self) -> Dict:
+        """Convert to a JSON-serializable dictionary."""
+        return {
+            "commit": self.commit,
+            "percentage": self.percentage,
+            "covered_lines": self.covered_lines,
+            "total_lines": self.total_lines,
+            "files": [
+                {
+                    "file_path": f.file_path,
+                    "percentage": f.percentage,
+                    "covered_lines": list(f.covered_lines),
+                    "missing_lines": list(f.missing_lines),
+                }
+                for f in self.files
+            ],
+            "unmeasured_files": self.unmeasured_files,
+        }
+
+
+class CoveragePathMatcher:
+    """
+    Maps repository paths to the paths a coverage report uses.
+
+    Reports name files differently: llvm-cov and gcov write absolute paths,
+    coverage.py writes paths relative to its source directory. Absolute
+    paths under the repository root are made relative; otherwise the
+    longest report path sharing a suffix with the repository path wins.
+
+    Args:
+        coverage_paths: File paths as written in the coverage run
+        root: Repository root
+    """
+
+    def __init__(self, coverage_paths: Iterable[str], root: Path):
+        """Index report paths by normalized path and by file name."""
+        self._root = root.as_posix().rstrip("/") + "/"
+        self._exact: Dict[str, str] = {}
+        self._by_name: Dict[str, List[Tuple[str, str]]] = defaultdict(list)
+        for path in coverage_paths:
+            normalized = self._normalize(path)
+            self._exact.setdefault(normalized, path)
+            self._by_name[normalized.rsplit("/", 1)[-1]].append((normalized, path))
+
+    def _normalize(self, path: str) -> str:
+        """Use forward slashes and strip the repository root or a leading ./"""
+        path = path.replace("\\", "/")
+        if path.startswith(self._root):
+            return path[len(self._root) :]
+        return path[2:] if path.startswith("./") else path
+
+    def match(self, rel_path: str) -> Optional[str]:
+        """
+        Find the report path of a repository file.
+
+        Args:
+            rel_path: Path relative to the repository root, with forward slashes
+
+        Returns:
+            Path as written in the coverage run, or None if not measured
+        """
+        if rel_path in self._exact:
+            return self._exact[rel_path]
+        best = None
+        for normalized, original in self._by_name.get(rel_path.rsplit("/", 1)[-1], ()):
+            if rel_path.endswith("/" + normalized) or normalized.endswith("/" + rel_path):
+                if best is None or len(normalized) > len(best[0]):
+                    best = (normalized, original)
+        return best[1] if best else None
+
+
+def file_patch_coverage(
+    file_path: str, ranges: List[LineRange], covered: LineBitmap, missing: LineBitmap
+) -> FilePatchCoverage:
+    """
+    Intersect a file's changed line ranges with its coverage.
+
+    Args:
+        file_path: Path to report
+        ranges: Changed inclusive line ranges
+        covered: Lines that ran
+        missing: Executable lines that did not run
+
+    Returns:
+        Coverage of the changed executable lines
+    """
+    executable = covered | missing
+    if not executable:
+        return FilePatchCoverage(file_path, LineBitmap(), LineBitmap())
+    # Ranges past the last executable line (e.g. WHOLE_FILE) add nothing
+    last = executable.max()
+    changed = LineBitmap.from_ranges((start, min(end, last)) for start, end in ranges)
+    return FilePatchCoverage(file_path, covered & changed, missing & changed)
+
+
+class PatchCoverageEngine:
+    """
+    Computes patch coverage from git diffs and coverage runs.
+
+    Args:
+        repo_dir: Any directory inside the repository
+        database: History database with recorded coverage runs (needed for
+            record() and commit-based compute())
+
+    Examples:
+        >>> engine = PatchCoverageEngine(".", ExecutionDatabase(".anvil/history.db"))
+        >>> run_id = engine.record(CoverageParser().parse("coverage.info"), commit="HEAD")
+        >>> engine.compute(base="origin/main", commit="HEAD").percentage
+        87.5
+    """
+
+    def __init__(
+        self, repo_dir: Union[str, Path] = ".", database: Optional[ExecutionDatabase] = None
+    ):
+        """Initialize the engine."""
+        self.repo_dir = Path(repo_dir)
+        self.db = database
+
+    def resolve_commit(self, ref: str) -> str:
+        """
+        Resolve a git reference to a full commit id.
+
+        Raises:
+            StagedContentError: If the reference is unknown
+        """
+        return (
+            run_git(self.repo_dir, ["rev-parse", "--verify", f"{ref}^{{commit}}"]).decode().strip()
+        )
+
+    def _require_database(self) -> ExecutionDatabase:
+        """Get the history database or explain that one is needed."""
+        if self.db is None:
+            raise PatchCoverageError("Recorded coverage needs a history database")
+        return self.db
+
+    def record(
+        self,
+        coverage: CoverageData,
+        commit: Optional[str] = "HEAD",
+        execution_id: Optional[str] = None,
+        space: str = "local",
+    ) -> str:
+        """
+        Store a coverage run for a commit.
+
+        Args:
+            coverage: Parsed coverage run
+            commit: Commit the coverage was measured on (None records the run
+                without a commit, e.g. outside a git repository)
+            execution_id: Execution ID for the stored run (generated if omitted)
+            space: Execution space (local, ci)
+
+        Returns:
+            Execution ID of the stored run
+        """
+        db = self._require_database()
+        sha = self.resolve_commit(commit) if commit is not None else None
+        prefix = f"coverage-{sha[:12]}" if sha else "coverage"
+        execution_id = execution_id or f"{prefix}-{uuid.uuid4().hex[:8]}"
+        timestamp = datetime.now()
+
+        db.insert_coverage_summary(
+            CoverageSummary(
+                execution_id=execution_id,
+                timestamp=timestamp,
+                total_coverage=coverage.total_coverage,
+                files_analyzed=coverage.files_analyzed,
+                total_statements=coverage.total_statements,
+                covered_statements=coverage.covered_statements,
+                space=space,
+                git_commit=sha,
+            )
+        )
+        db.insert_coverage_histories(
+            [
+                CoverageHistory(
+                    execution_id=execution_id,
+                    file_path=fc.file_path,
+                    timestamp=timestamp,
+                    total_statements=fc.total_statements,
+                    covered_statements=fc.covered_statements,
+                    coverage_percentage=fc.coverage_percentage,
+                    missing_lines=fc.missing_lines,
+                    covered_lines=fc.covered_lines,
+                    space=space,
+                )
+                for fc in coverage.file_coverage
+            ]
+        )
+        return execution_id
+
+    def compute(
+        self,
+        base: str = "HEAD",
+        coverage: Optional[CoverageData] = None,
+        commit: Optional[str] = None,
+    ) -> PatchCoverage:
+        """
+        Compute coverage of the changes since a base commit.
+
+        With a coverage run, the working tree is diffed against base (the
+        run is assumed to be of the working tree). Otherwise the latest run
+        recorded for commit is used and base is diffed against that commit.
+
+        Args:
+            base: Commit the change is measured from (e.g. the merge base)
+            coverage: Coverage run of the working tree
+            commit: Commit with a recorded coverage run (default: HEAD)
+
+        Returns:
+            PatchCoverage of the change
+
+        Raises:
+            PatchCoverageError: If no coverage was recorded for the commit
+            StagedContentError: If git fails (e.g. unknown base)
+        """
+        sha = None
+        if coverage is not None:
+            scope = DiffScope.from_git(self.repo_dir, base)
+            by_path = {fc.file_path: fc for fc in coverage.file_coverage}
+            coverage_paths: Iterable[str] = by_path.keys()
+
+            def lookup(paths: List[str]) -> Dict[str, FileLines]:
+                return {p: (by_path[p].covered_lines, by_path[p].missing_lines) for p in paths}
+
+        else:
+            db = self._require_database()
+            sha = self.resolve_commit(commit or "HEAD")
+            runs = db.get_coverage_summary(git_commit=sha, limit=1)
+            if not runs:
+                raise PatchCoverageError(f"No coverage recorded for commit {sha[:12]}")
+            execution_id = runs[0].execution_id
+            scope = DiffScope.from_git(self.repo_dir, base, head=sha)
+            coverage_paths = db.get_coverage_file_paths(execution_id)
+
+            def lookup(paths: List[str]) -> Dict[str, FileLines]:
+                return db.get_coverage_lines(execution_id, paths)
+
+        matcher = CoveragePathMatcher(coverage_paths, scope.root)
+        changed: Dict[str, Tuple[str, List[LineRange]]] = {}
+        result = PatchCoverage(commit=sha)
+        for path, index in sorted(scope.indexes.items()):
+            if not index:
+                continue
+            rel_path = path.relative_to(scope.root).as_posix()
+            report_path = matcher.match(rel_path)
+            if report_path is None:
+                result.unmeasured_files.append(rel_path)
+            else:
+                changed[report_path] = (rel_path, index.ranges)
+
+        lines = lookup(list(changed))
+        for report_path, (rel_path, ranges) in changed.items():
+            covered, missing = lines.get(report_path, (None, None))
+            # Rows stored before covered lines were recorded cannot be used
+            if covered is None:
+                result.unmeasured_files.append(rel_path)
+                continue
+            file_coverage = file_patch_coverage(rel_path, ranges, covered, missing or LineBitmap())
+            if file_coverage.total_lines:
+                result.files.append(file_coverage)
+        result.unmeasured_files.sort()
+        return result
@@ -0,0 +1,105 @@
+"""
+Compiled glob matching for rule entity selection.
+
+This module compiles a rule's group patterns once into a matcher that tests
+an entity ID in a single pass, instead of calling ``fnmatch`` twice per
+pattern per entity.
+"""
+
+import fnmatch
+import os
+import re
+from functools import lru_cache
+from typing import Iterable, List, Optional, Pattern, Sequence, Tuple
+
+# Characters that make a pattern a glob rather than a literal prefix
+_GLOB_CHARS = frozenset("*?[")
+
+
+class PatternMatcher:
+    """
+    Matches entity IDs against a fixed set of glob patterns.
+
+    Semantics are identical to testing ``fnmatch(entity, p)`` or
+    ``fnmatch(entity, p + "*")`` for each pattern ``p``: a pattern matches an
+    entity when it matches the entity or any prefix of it, so both file
+    patterns (``tests/test_models.py``) and full node IDs select tests.
+
+    Literal patterns (no ``*``, ``?`` or ``[``) become a single
+    ``str.startswith`` tuple check; glob patterns are compiled into one
+    combined regular expression.
+
+    Examples:
+        >>> matcher = PatternMatcher(["tests/test_models.py", "tests/unit/*"])
+        >>> matcher.matches("tests/test_models.py::test_create")
+        True
+        >>> matcher.filter(["tests/unit/test_a.py", "tests/other.py"])
+        ['tests/unit/test_a.py']
+    """
+
+    def __init__(self, patterns: Sequence[str]):
+        """
+        Compile patterns into a matcher.
+
+        Args:
+            patterns: Glob patterns (fnmatch syntax)
+        """
+        self.patterns = tuple(patterns)
+        # fnmatch.fnmatch normalizes case (and separators on Windows)
+        self._normalize = os.path.normcase("A/") != "A/"
+
+        prefixes: List[str] = []
+        globs: List[str] = []
+        for pattern in self.patterns:
+            pattern = os.path.normcase(pattern) if self._normalize else pattern
+            if _GLOB_CHARS.isdisjoint(pattern):
+                prefixes.append(pattern)
+            else:
+                globs.append(fnmatch.translate(f"{pattern}*"))
+
+        self._prefixes: Tuple[str, ...] = tuple(prefixes)
+        self._regex: Optional[Pattern[str]] = re.compile("|".join(globs)) if globs else None
+
+    def matches(self, entity_id: str) -> bool:
+        """
+        Check if an entity ID matches any pattern.
+
+        Args:
+            entity_id: Entity identifier to check
+
+        Returns:
+            True if entity matches any pattern
+        """
+        if self._normalize:
+            entity_id = os.path.normcase(entity_id)
+        if self._prefixes and entity_id.startswith(self._prefixes):
+            return True
+        return self._regex is not None and self._regex.match(entity_id) is not None
+
+    def filter(self, entity_ids: Iterable[str]) -> List[str]:
+        """
+        Select the entity IDs that match any pattern.
+
+        Args:
+            entity_ids: Entity identifiers to filter
+
+        Returns:
+            Matching entity IDs, in input order
+        """
+        if not self.patterns:
+            return []
+        return [entity_id for entity_id in entity_ids if self.matches(entity_id)]
+
+
+@lru_cache(maxsize=256)
+def compile_patterns(patterns: Tuple[str, ...]) -> PatternMatcher:
+    """
+    Get a compiled matcher for a pattern tuple, reusing earlier compilations.
+
+    Args:
+        patterns: Tuple of glob patterns
+
+    Returns:
+        PatternMatcher for the patterns
+    """
+    return PatternMatcher(patterns)
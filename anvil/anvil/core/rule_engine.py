@@ -6,9 +6,9 @@ entities (tests, coverage, lint) should be executed based on defined rules
 and historical execution data.
 """
 
-import fnmatch
-from typing import List, Optional
+from typing import Dict, List, Optional, Tuple
 
+from anvil.core.pattern_matcher import compile_patterns
 from anvil.core.statistics_calculator import StatisticsCalculator
 from anvil.storage.execution_schema import ExecutionDatabase, ExecutionRule
 
@@ -20,6 +20,9 @@ class RuleEngine:
     Evaluates rules based on criteria (all, group, failed-in-last, failure-rate)
     and selects entities for execution using historical data and statistics.
 
+    Group patterns are compiled once per pattern set, and pattern-based
+    selections are cached until the set of recorded entities changes.
+
     Examples:
         >>> db = ExecutionDatabase(".anvil/history.db")
         >>> engine = RuleEngine(db)
@@ -38,6 +41,9 @@ class RuleEngine:
         """
         self.db = db
         self.statistics = StatisticsCalculator(db)
+        self._entity_version: Optional[Tuple[int, int]] = None
+        self._entity_ids: List[str] = []
+        self._selection_cache: Dict[Tuple[str, ...], List[str]] = {}
 
     def select_entities(self, rule: ExecutionRule) -> List[str]:
         """
@@ -73,19 +79,11 @@ class RuleEngine:
         Returns:
             List of all entity IDs
         """
-        # Get all unique entity IDs from execution history
-        all_history = self.db.get_execution_history()
-        entity_ids = {h.entity_id for h in all_history}
-
         # If groups are specified, filter by them
         if rule.groups:
-            filtered = []
-            for entity_id in entity_ids:
-                if self._matches_any_pattern(entity_id, rule.groups):
-                    filtered.append(entity_id)
-            return filtered
+            return self._select_matching(rule.groups)
 
-        return list(entity_ids)
+        return list(self._get_entity_ids())
 
     def _select_by_group(self, rule: ExecutionRule) -> List[str]:
         """
@@ -100,17 +98,44 @@ class RuleEngine:
         if not rule.groups:
             return []
 
-        # Get all unique entity IDs
-        all_history = self.db.get_execution_history()
-        entity_ids = {h.entity_id for h in all_history}
+        return self._select_matching(rule.groups)
+
+    def _get_entity_ids(self) -> List[str]:
+        """
+        Get all unique entity IDs, reloading only when history has changed.
+
+        Returns:
+            List of unique entity IDs (shared; callers must not mutate it)
+        """
+        version = self.db.get_entity_set_version()
+        if version != self._entity_version:
+            self._entity_ids = self.db.get_entity_ids()
+            self._entity_version = version
+            self._selection_cache.clear()
+        return self._entity_ids
+
+    def _select_matching(self, patterns: List[str]) -> List[str]:
+        """
+        Select entities matching any of the given patterns.
+
+        Selections are cached per (pattern set, entity set version), so
+        re-evaluating a rule against unchanged history is a dictionary lookup.
+
+        Args:
+            patterns: List of glob patterns
+
+        Returns:
+            List of matching entity IDs
+        """
+        entity_ids = self._get_entity_ids()
+        key = tuple(patterns)
 
-        # Filter by group patterns
-        selected = []
-        for entity_id in entity_ids:
-            if self._matches_any_pattern(entity_id, rule.groups):
-                selected.append(entity_id)
+        selected = self._selection_cache.get(key)
+        if selected is None:
+            selected = compile_patterns(key).filter(entity_ids)
+            self._selection_cache[key] = selected
 
-        return selected
+        return list(selected)
 
     def _select_failed_in_last(self, rule: ExecutionRule) -> List[str]:
         """
@@ -153,11 +178,8 @@ class RuleEngine:
         Returns:
             True if entity matches any pattern
         """
-        for pattern in patterns:
-            # Support both file patterns and full nodeids
-            if fnmatch.fnmatch(entity_id, pattern) or fnmatch.fnmatch(entity_id, f"{pattern}*"):
-                return True
-        return False
+        # Support both file patterns and full nodeids
+        return compile_patterns(tuple(patterns)).matches(entity_id)
 
     def get_rule(self, name: str) -> Optional[ExecutionRule]:
         """
@@ -16,6 +16,7 @@ from anvil.validators.clang_format_validator import ClangFormatValidator
 
 # Iteration 5: C++ Static Analysis
 from anvil.validators.clang_tidy_validator import ClangTidyValidator
+from anvil.validators.cpp_metrics_validator import CppMetricsValidator
 from anvil.validators.cppcheck_validator import CppcheckValidator
 from anvil.validators.cpplint_validator import CpplintValidator
 from anvil.validators.flake8_validator import Flake8Validator
@@ -71,6 +72,9 @@ def register_cpp_validators(registry: ValidatorRegistry) -> None:
     registry.register(IWYUValidator())
     registry.register(GTestValidator())
 
+    # Function metrics (no external tools required)
+    registry.register(CppMetricsValidator())
+
 
 def register_all_validators(registry: ValidatorRegistry) -> None:
     """
@@ -0,0 +1,314 @@
+"""
+ARG_MAX-safe fan-out of file lists across tool subprocesses.
+
+Validators that pass every file on one command line either exceed the
+operating system's argument limit on large trees or check everything in one
+serial process. fan_out splits the file list into chunks that fit the
+limit and spread across the available cores, runs the chunks concurrently
+under a process budget shared by all validators, and merges the parsed
+results back into one ValidationResult. The budget is sized once per run from
+the orchestrator's configuration; a validator's own max_processes only
+narrows how many of its chunks run at once.
+"""
+
+import math
+import os
+import sys
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from types import TracebackType
+from typing import Any, Callable, Dict, List, Optional, Sequence, Type, TypeVar
+
+from anvil.models.validator import ValidationResult
+from anvil.utils.tracing import span
+
+T = TypeVar("T")
+
+# Windows limits the whole command line to 32767 UTF-16 characters
+WINDOWS_COMMAND_LINE_LIMIT = 32767
+
+# Conservative limit used when the platform does not report one
+DEFAULT_ARG_MAX = 128 * 1024
+
+# Bytes kept free for the environment growing or the tool re-executing itself
+ARG_HEADROOM = 4096
+
+# Chunks smaller than this are not worth a separate process start
+MIN_FILES_PER_CHUNK = 8
+
+
+def arg_max() -> int:
+    """
+    Get the number of bytes available for a child process's arguments.
+
+    Returns:
+        The platform limit minus the current environment and headroom
+    """
+    if sys.platform == "win32":
+        return WINDOWS_COMMAND_LINE_LIMIT - ARG_HEADROOM
+
+    try:
+        limit = os.sysconf("SC_ARG_MAX")
+    except (AttributeError, ValueError, OSError):
+        limit = -1
+    if limit <= 0:
+        limit = DEFAULT_ARG_MAX
+
+    # execve counts the environment against the same limit
+    environment = sum(arg_length(f"{key}={value}") for key, value in os.environ.items())
+    return max(limit - environment - ARG_HEADROOM, 0)
+
+
+def arg_length(arg: Any) -> int:
+    """
+    Get the bytes one argument costs on the command line.
+
+    Args:
+        arg: Command-line argument
+
+    Returns:
+        Encoded length plus terminator and pointer (POSIX) or quoting and
+        separator (Windows)
+    """
+    if sys.platform == "win32":
+        return len(str(arg)) + 3
+    return len(os.fsencode(str(arg))) + 1 + 8
+
+
+def chunk_files(
+    files: Sequence[T],
+    base_length: int = 0,
+    jobs: Optional[int] = None,
+    max_bytes: Optional[int] = None,
+    max_files: Optional[int] = None,
+    file_length: Callable[[T], int] = arg_length,
+) -> List[List[T]]:
+    """
+    Split files into command-line sized chunks.
+
+    Files are spread over at most `jobs` chunks (keeping at least
+    MIN_FILES_PER_CHUNK files per chunk), and a chunk is closed early when
+    its arguments would exceed the byte limit or it holds max_files files.
+    Order is preserved.
+
+    Args:
+        files: Files to split
+        base_length: Bytes already used by the command without files
+        jobs: Number of chunks to aim for (default: CPU count)
+        max_bytes: Argument byte limit (default: arg_max())
+        max_files: Maximum files per chunk (default: unlimited)
+        file_length: Bytes one file adds to the command (default: the
+            file argument alone; tools with per-file option data add theirs)
+
+    Returns:
+        Non-empty list of chunks, or an empty list for no files
+    """
+    if not files:
+        return []
+
+    jobs = jobs or os.cpu_count() or 1
+    budget = (arg_max() if max_bytes is None else max_bytes) - base_length
+    target = max(math.ceil(len(files) / jobs), MIN_FILES_PER_CHUNK)
+    if max_files:
+        target = min(target, max_files)
+
+    chunks: List[List[T]] = []
+    current: List[T] = []
+    used = 0
+    for file in files:
+        size = file_length(file)
+        if current and (len(current) >= target or used + size > budget):
+            chunks.append(current)
+            current, used = [], 0
+        current.append(file)
+        used += size
+    chunks.append(current)
+    return chunks
+
+
+class ProcessBudget:
+    """
+    Resizable limit on concurrent chunk subprocesses.
+
+    Unlike a semaphore, the budget is resized in place, so slots already
+    held stay counted against the new size and every holder keeps sharing
+    one count.
+
+    Examples:
+        >>> with process_budget():
+        ...     run_chunk()
+    """
+
+    def __init__(self, size: int):
+        """
+        Initialize the budget.
+
+        Args:
+            size: Maximum number of slots held at once
+        """
+        self._size = max(1, size)
+        self._in_use = 0
+        self._condition = threading.Condition()
+
+    @property
+    def size(self) -> int:
+        """Maximum number of slots held at once."""
+        return self._size
+
+    def resize(self, size: int) -> None:
+        """
+        Change the number of slots; holders above a smaller size finish first.
+
+        Args:
+            size: New maximum number of slots held at once
+        """
+        with self._condition:
+            self._size = max(1, size)
+            self._condition.notify_all()
+
+    def __enter__(self) -> "ProcessBudget":
+        """Wait for and take a slot."""
+        with self._condition:
+            self._condition.wait_for(lambda: self._in_use < self._size)
+            self._in_use += 1
+        return self
+
+    def __exit__(
+        self,
+        exc_type: Optional[Type[BaseException]],
+        exc_val: Optional[BaseException],
+        exc_tb: Optional[TracebackType],
+    ) -> bool:
+        """Release the slot."""
+        with self._condition:
+            self._in_use -= 1
+            self._condition.notify()
+        return False
+
+
+_budget = ProcessBudget(os.cpu_count() or 1)
+
+
+def process_budget(size: Optional[int] = None) -> ProcessBudget:
+    """
+    Get the process-wide budget limiting concurrent chunk subprocesses.
+
+    The budget is shared by every validator, so validators running in
+    parallel do not multiply their worker counts. It is sized by the
+    orchestrator from the run's max_processes setting.
+
+    Args:
+        size: Resize the budget to this many processes (default: keep the
+            current size, CPU count initially)
+
+    Returns:
+        Budget to hold while a chunk subprocess runs
+    """
+    if size:
+        _budget.resize(size)
+    return _budget
+
+
+def merge_results(
+    results: List[ValidationResult], validator_name: str, execution_time: float = 0.0
+) -> ValidationResult:
+    """
+    Combine per-chunk results into one result.
+
+    Issues are concatenated in chunk order. Metadata dictionaries are merged
+    key by key: nested dictionaries are merged, lists concatenated, and
+    other values taken from the first chunk that set them.
+
+    Args:
+        results: Results of each chunk, in chunk order
+        validator_name: Name for the merged result
+        execution_time: Wall-clock time of the whole fan-out
+
+    Returns:
+        Merged ValidationResult
+    """
+    metadata: Dict[str, Any] = {}
+    for result in results:
+        for key, value in (result.metadata or {}).items():
+            if key not in metadata:
+                metadata[key] = dict(value) if isinstance(value, dict) else value
+            elif isinstance(metadata[key], dict) and isinstance(value, dict):
+                metadata[key].update(value)
+            elif isinstance(metadata[key], list) and isinstance(value, list):
+                metadata[key] = metadata[key] + value
+
+    return ValidationResult(
+        validator_name=validator_name,
+        passed=all(r.passed for r in results),
+        errors=[issue for r in results for issue in r.errors],
+        warnings=[issue for r in results for issue in r.warnings],
+        execution_time=execution_time,
+        files_checked=sum(_files_checked(r) for r in results),
+        metadata=metadata or None,
+    )
+
+
+def _files_checked(result: ValidationResult) -> int:
+    """Count checked files; some error paths store the file list itself."""
+    files_checked = result.files_checked
+    return len(files_checked) if isinstance(files_checked, (list, tuple)) else files_checked
+
+
+def fan_out(
+    run: Callable[[List[T]], ValidationResult],
+    files: Sequence[T],
+    validator_name: str,
+    base_command: Sequence[str] = (),
+    config: Optional[Dict[str, Any]] = None,
+    whole_program: bool = False,
+    max_files: Optional[int] = None,
+    file_length: Callable[[T], int] = arg_length,
+) -> ValidationResult:
+    """
+    Run a tool over files in ARG_MAX-safe chunks and merge the results.
+
+    A file list that fits one command line and is too small to be worth
+    splitting runs directly. Otherwise chunks run concurrently, each holding
+    a slot of the shared process budget while its subprocess runs.
+
+    Args:
+        run: Runs the tool on one chunk and parses its output
+        files: Files to check
+        validator_name: Name for the merged result
+        base_command: Command without files, to measure the argument budget
+        config: Configuration with optional jobs (chunks per validator) and
+            max_processes (most of this validator's chunks running at once;
+            the shared budget itself is sized by the orchestrator)
+        whole_program: The tool analyzes files together (cross-file checks),
+            so split only when the command line would not fit
+        max_files: Maximum files per invocation (for one-file tools)
+        file_length: Bytes one file adds to the command (see chunk_files)
+
+    Returns:
+        Merged ValidationResult
+    """
+    config = config or {}
+    start = time.time()
+    jobs = 1 if whole_program else config.get("jobs") or os.cpu_count() or 1
+    base_length = sum(arg_length(arg) for arg in base_command)
+
+    chunks = chunk_files(
+        list(files), base_length, jobs=jobs, max_files=max_files, file_length=file_length
+    )
+    if len(chunks) <= 1:
+        with span("anvil.file_batch", validator=validator_name, files=len(files)):
+            return run(list(files))
+
+    budget = process_budget()
+    workers = min(len(chunks), max(jobs, 1), config.get("max_processes") or len(chunks))
+
+    def run_chunk(chunk: List[T]) -> ValidationResult:
+        with budget:
+            with span("anvil.file_batch", validator=validator_name, files=len(chunk)):
+                return run(chunk)
+
+    with ThreadPoolExecutor(max_workers=workers) as executor:
+        results = list(executor.map(run_chunk, chunks))
+
+    return merge_results(results, validator_name, time.time() - start)
@@ -0,0 +1,430 @@
+"""
+Duration-balanced sharding for pytest runs.
+
+This module splits collected pytest node IDs into shards of roughly equal
+expected runtime, using per-test durations from the statistics database,
+runs the shards as parallel pytest subprocesses (each split into ARG_MAX-safe
+invocations), and merges their JSON reports into a single report.
+
+Sharding can also split work across machines: with ``shard = "2/4"`` each
+CI job runs only its quarter of the suite, and every job computes the same
+partition from the same collection and history.
+"""
+
+import heapq
+import json
+import os
+import statistics
+import subprocess
+import sys
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+from typing import Dict, List, Optional, Sequence, Tuple, Union
+
+from anvil.executors.fanout import arg_length, chunk_files
+from anvil.models.validator import Issue, ValidationResult
+from anvil.parsers.pytest_parser import PytestParser
+from anvil.storage.statistics_database import StatisticsDatabase
+
+# Expected duration for tests with no history when no test has history
+DEFAULT_TEST_DURATION = 1.0
+
+# Number of recent runs used to estimate a test's duration
+DURATION_HISTORY_WINDOW = 5
+
+
+def parse_shard_spec(spec: str) -> Tuple[int, int]:
+    """
+    Parse a ``i/N`` shard specification.
+
+    Args:
+        spec: Shard specification, 1-based (e.g., "2/4")
+
+    Returns:
+        Tuple of (shard index, shard count), index 1-based
+
+    Raises:
+        ValueError: If the specification is malformed or out of range
+    """
+    try:
+        index_text, count_text = spec.split("/")
+        index, count = int(index_text), int(count_text)
+    except ValueError:
+        raise ValueError(f"Invalid shard '{spec}': expected INDEX/COUNT, e.g. 1/4")
+
+    if count < 1 or not 1 <= index <= count:
+        raise ValueError(f"Invalid shard '{spec}': index must be between 1 and {max(count, 1)}")
+
+    return index, count
+
+
+def balance_shards(
+    node_ids: Sequence[str], durations: Dict[str, float], count: int
+) -> List[List[str]]:
+    """
+    Partition tests into shards of roughly equal expected duration.
+
+    Uses longest-processing-time-first greedy assignment: tests are taken
+    from slowest to fastest and each goes to the currently lightest shard.
+    The result is deterministic for the same inputs, so independent CI
+    machines agree on the partition.
+
+    Args:
+        node_ids: Collected pytest node IDs
+        durations: Expected duration per node ID (missing = unknown)
+        count: Number of shards
+
+    Returns:
+        List of ``count`` shards, each a list of node IDs in collection order
+    """
+    known = [durations[n] for n in node_ids if n in durations]
+    default = statistics.median(known) if known else DEFAULT_TEST_DURATION
+
+    order = {node_id: i for i, node_id in enumerate(node_ids)}
+    ordered = sorted(node_ids, key=lambda n: (-durations.get(n, default), order[n]))
+
+    heap = [(0.0, shard) for shard in range(count)]
+    shards: List[List[str]] = [[] for _ in range(count)]
+    for node_id in ordered:
+        load, shard = heapq.heappop(heap)
+        shards[shard].append(node_id)
+        heapq.heappush(heap, (load + durations.get(node_id, default), shard))
+
+    # Keep collection order within a shard so module fixtures are reused
+    return [sorted(shard, key=order.__getitem__) for shard in shards]
+
+
+def load_test_durations(
+    db: StatisticsDatabase, node_ids: Sequence[str], window: int = DURATION_HISTORY_WINDOW
+) -> Dict[str, float]:
+    """
+    Estimate each test's duration from its recent history.
+
+    Tests are looked up by full node ID, falling back to the bare test name
+    (the part after the last ``::``). Skipped runs are ignored.
+
+    Args:
+        db: Statistics database with test case history
+        node_ids: Node IDs to estimate
+        window: Number of recent runs to take the median over
+
+    Returns:
+        Dictionary mapping node ID to median recent duration in seconds
+    """
+    durations = {}
+    for node_id in node_ids:
+        history = db.query_test_history(node_id, limit=window)
+        if not history and "::" in node_id:
+            history = db.query_test_history(node_id.rsplit("::", 1)[1], limit=window)
+
+        samples = [r.duration_seconds for r in history if not r.skipped]
+        if samples:
+            durations[node_id] = statistics.median(samples)
+
+    return durations
+
+
+def merge_json_reports(reports: Sequence[Dict]) -> Dict:
+    """
+    Merge pytest-json-report reports from several shards into one.
+
+    Test entries are concatenated, summary counters summed, and coverage
+    (if present) merged per file by unioning executed lines.
+
+    Args:
+        reports: Parsed JSON reports, one per shard
+
+    Returns:
+        Single report in pytest-json-report format
+    """
+    merged: Dict = {"tests": [], "summary": {}, "duration": 0.0, "exitcode": 0}
+    coverage_reports = []
+
+    for report in reports:
+        merged["tests"].extend(report.get("tests", []))
+        merged["duration"] = max(merged["duration"], report.get("duration", 0.0))
+        merged["exitcode"] = max(merged["exitcode"], report.get("exitcode", 0))
+        for key, value in report.get("summary", {}).items():
+            if isinstance(value, (int, float)):
+                merged["summary"][key] = merged["summary"].get(key, 0) + value
+        if "coverage" in report:
+            coverage_reports.append(report["coverage"])
+
+    if coverage_reports:
+        merged["coverage"] = _merge_coverage(coverage_reports)
+
+    return merged
+
+
+def _merge_coverage(reports: Sequence[Dict]) -> Dict:
+    """
+    Merge coverage.py JSON reports by unioning executed lines per file.
+
+    Args:
+        reports: Coverage JSON reports
+
+    Returns:
+        Merged coverage report with recomputed file and total summaries
+    """
+    files: Dict[str, Dict[str, set]] = {}
+    for report in reports:
+        for path, data in report.get("files", {}).items():
+            entry = files.setdefault(path, {"executed": set(), "statements": set()})
+            executed = set(data.get("executed_lines", []))
+            entry["executed"] |= executed
+            entry["statements"] |= executed | set(data.get("missing_lines", []))
+
+    merged_files = {}
+    total_statements = total_covered = 0
+    for path, entry in files.items():
+        statements = len(entry["statements"])
+        covered = len(entry["executed"])
+        total_statements += statements
+        total_covered += covered
+        merged_files[path] = {
+            "executed_lines": sorted(entry["executed"]),
+            "missing_lines": sorted(entry["statements"] - entry["executed"]),
+            "summary": {
+                "num_statements": statements,
+                "covered_lines": covered,
+                "percent_covered": covered / statements * 100 if statements else 100.0,
+            },
+        }
+
+    if merged_files:
+        percent = total_covered / total_statements * 100 if total_statements else 100.0
+    else:
+        # Reports without per-file data: keep the lowest reported total
+        percent = min(r.get("totals", {}).get("percent_covered", 0.0) for r in reports)
+
+    return {
+        "files": merged_files,
+        "totals": {
+            "num_statements": total_statements,
+            "covered_lines": total_covered,
+            "percent_covered": percent,
+        },
+    }
+
+
+class ShardedPytestRunner:
+    """
+    Runs pytest as duration-balanced shards in parallel subprocesses.
+
+    Examples:
+        >>> runner = ShardedPytestRunner(workers=4)
+        >>> result = runner.run([Path("tests")], {})
+        >>> # Only this machine's half of the suite, split 4 ways locally
+        >>> result = ShardedPytestRunner(workers=4, shard="1/2").run([Path("tests")], {})
+    """
+
+    def __init__(
+        self,
+        workers: Optional[int] = None,
+        shard: Optional[str] = None,
+        db: Optional[StatisticsDatabase] = None,
+    ):
+        """
+        Initialize sharded runner.
+
+        Args:
+            workers: Number of local parallel shards (default: CPU count)
+            shard: Optional ``i/N`` spec selecting one machine's share of tests
+            db: Statistics database for per-test durations (None = uniform)
+
+        Raises:
+            ValueError: If the shard specification is invalid
+        """
+        self.workers = max(1, workers or os.cpu_count() or 1)
+        self.shard = parse_shard_spec(shard) if shard else None
+        self.db = db
+
+    @staticmethod
+    def rootdir(files: List[Path]) -> Path:
+        """
+        Choose the pytest rootdir shared by collection and the shard runs.
+
+        Node IDs are relative to rootdir and are passed back to pytest as
+        paths, so they are rooted at the working directory whenever possible.
+
+        Args:
+            files: Test files or directories
+
+        Returns:
+            The working directory, or the common parent of tests outside it
+        """
+        cwd = Path.cwd()
+        paths = [Path(f).resolve() for f in files]
+        if all(cwd == p or cwd in p.parents for p in paths):
+            return cwd
+        return Path(os.path.commonpath([p if p.is_dir() else p.parent for p in paths]))
+
+    def collect(self, files: List[Path], config: Dict) -> List[str]:
+        """
+        Collect pytest node IDs without running tests.
+
+        Collection uses the project's pytest configuration and the same
+        rootdir as the shard runs, so the collected tests are the ones that
+        run.
+
+        Args:
+            files: Test files or directories
+            config: Configuration with pytest selection options
+
+        Returns:
+            List of node IDs in collection order, relative to the working
+            directory (absolute for tests outside it)
+
+        Raises:
+            RuntimeError: If collection fails
+        """
+        cwd = Path.cwd()
+        rootdir = Path(config.get("_rootdir") or self.rootdir(files))
+
+        cmd = [sys.executable, "-m", "pytest", "--collect-only", "-q"]
+        cmd.append(f"--rootdir={rootdir}")
+
+        if config.get("markers"):
+            markers = config["markers"]
+            if isinstance(markers, list):
+                markers = " and ".join(markers)
+            cmd.extend(["-m", markers])
+        if config.get("keywords"):
+            cmd.extend(["-k", config["keywords"]])
+
+        cmd.extend(str(f) for f in files)
+
+        result = subprocess.run(
+            cmd,
+            capture_output=True,
+            text=True,
+            timeout=config.get("timeout", 300),
+            check=False,
+        )
+        # Exit code 5 means no tests were collected
+        if result.returncode not in (0, 5):
+            raise RuntimeError(f"pytest collection failed: {result.stderr or result.stdout}")
+
+        node_ids = [line.strip() for line in result.stdout.splitlines() if "::" in line]
+        if rootdir != cwd:
+            node_ids = [str(rootdir / node_id) for node_id in node_ids]
+        return node_ids
+
+    def plan(self, node_ids: Sequence[str]) -> List[List[str]]:
+        """
+        Compute the local shards for the collected tests.
+
+        With a machine shard, the suite is first split across machines and
+        this machine's share is then split across local workers.
+
+        Args:
+            node_ids: Collected node IDs
+
+        Returns:
+            Non-empty local shards
+        """
+        durations = load_test_durations(self.db, node_ids) if self.db else {}
+
+        if self.shard:
+            index, count = self.shard
+            node_ids = balance_shards(node_ids, durations, count)[index - 1]
+
+        workers = min(self.workers, len(node_ids))
+        if workers == 0:
+            return []
+        return [s for s in balance_shards(node_ids, durations, workers) if s]
+
+    def run(self, files: List[Path], config: Dict) -> ValidationResult:
+        """
+        Collect, shard, run and merge a pytest run.
+
+        Args:
+            files: Test files or directories
+            config: Pytest configuration (as for PytestParser.build_command)
+
+        Returns:
+            ValidationResult for the merged report, with per-shard details
+            in metadata["shards"]
+        """
+        # Collection and every shard share the project config and rootdir
+        config = {**config, "_rootdir": str(self.rootdir(files))}
+        try:
+            node_ids = self.collect(files, config)
+        except (RuntimeError, subprocess.TimeoutExpired) as e:
+            return self._error_result(f"pytest collection failed: {e}", files)
+
+        shards = self.plan(node_ids)
+        if not shards:
+            return ValidationResult(
+                validator_name="pytest",
+                passed=True,
+                files_checked=len(files),
+                metadata={"shards": []},
+            )
+
+        # Sharding replaces xdist; don't let each shard spawn its own workers
+        shard_config = {k: v for k, v in config.items() if k not in ("parallel", "workers")}
+
+        # A shard of a large suite can exceed ARG_MAX, so each shard runs its
+        # node IDs in command-line sized chunks, one after another
+        base_length = sum(arg_length(arg) for arg in PytestParser.build_command([], shard_config))
+
+        def run_shard(shard: List[str]) -> Union[Dict, ValidationResult]:
+            """Run one shard and return its report, or an error result."""
+            chunk_reports = []
+            for chunk in chunk_files(shard, base_length, jobs=1):
+                try:
+                    proc = PytestParser.run_pytest([Path(n) for n in chunk], shard_config)
+                except (subprocess.TimeoutExpired, FileNotFoundError, RuntimeError) as e:
+                    return self._error_result(
+                        f"pytest shard of {len(shard)} tests failed: {e}", files
+                    )
+                try:
+                    chunk_reports.append(json.loads(proc.stdout))
+                except (TypeError, ValueError):
+                    return self._error_result(
+                        f"pytest shard of {len(shard)} tests failed (exit code {proc.returncode})",
+                        files,
+                    )
+            if len(chunk_reports) == 1:
+                return chunk_reports[0]
+            report = merge_json_reports(chunk_reports)
+            report["duration"] = sum(r.get("duration", 0.0) for r in chunk_reports)
+            return report
+
+        with ThreadPoolExecutor(max_workers=len(shards)) as executor:
+            reports = list(executor.map(run_shard, shards))
+
+        for report in reports:
+            if isinstance(report, ValidationResult):
+                return report
+
+        merged = merge_json_reports(reports)
+        result = PytestParser.parse_json(json.dumps(merged), files, config)
+        result.metadata = {
+            "shards": [
+                {"tests": len(shard), "duration": report.get("duration", 0.0)}
+                for shard, report in zip(shards, reports)
+            ]
+        }
+        return result
+
+    @staticmethod
+    def _error_result(message: str, files: List[Path]) -> ValidationResult:
+        """Build a failed result for a run that produced no report."""
+        return ValidationResult(
+            validator_name="pytest",
+            passed=False,
+            errors=[
+                Issue(
+                    file_path="pytest",
+                    line_number=0,
+                    column_number=None,
+                    severity="error",
+                    message=message,
+                    rule_name="pytest-error",
+                )
+            ],
+            warnings=[],
+            files_checked=len(files),
+        )
@@ -0,0 +1,720 @@
+"""
+Single-pass in-process analysis for Python validators.
+
+Normally flake8, black, isort, autoflake, vulture and radon each run as a
+separate subprocess that re-reads and re-parses every file. In single-pass
+mode each file is read once into memory and parsed at most once, and every
+tool with a usable library API checks that shared buffer in the same worker
+process. flake8's pyflakes and mccabe checks and radon reuse the shared AST.
+Files are distributed over a process pool, so checking N files with all
+tools costs close to one tool's run.
+
+vulture needs every file to find unused code, so it scans the shared buffers
+in the parent process while the workers run. pylint has no API for checking
+already-read source, and tools that are not importable or are configured to
+rewrite files keep running through their validators.
+"""
+
+import ast
+import configparser
+import difflib
+import fnmatch
+import functools
+import importlib.util
+import io
+import os
+import re
+import time
+import tokenize
+from concurrent.futures import ProcessPoolExecutor
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Optional, Sequence, Tuple
+
+from anvil.models.validator import Issue, ValidationResult
+
+# Files below this count are checked in-process; a pool costs more to start
+MIN_FILES_FOR_POOL = 16
+
+PYTHON_SUFFIXES = (".py", ".pyi")
+
+# flake8's default code selection and extended ignore list
+FLAKE8_DEFAULT_SELECT = ("E", "F", "W", "C90")
+FLAKE8_DEFAULT_IGNORE = ("E121", "E123", "E126", "E226", "E24", "E704", "W503", "W504")
+
+_NOQA_RE = re.compile(
+    r"#\s*noqa(?::[\s]?(?P<codes>[A-Z]+[0-9]+(?:[,\s]+[A-Z]+[0-9]+)*))?", re.IGNORECASE
+)
+
+# Modules each tool needs to run in-process
+REQUIRED_MODULES = {
+    "flake8": ("flake8", "pyflakes", "pycodestyle", "mccabe"),
+    "black": ("black",),
+    "isort": ("isort",),
+    "autoflake": ("autoflake",),
+    "vulture": ("vulture",),
+    "radon": ("radon",),
+}
+
+
+class SourceFile:
+    """
+    A Python file read once and parsed at most once, shared by all tools.
+
+    Attributes:
+        path: File path as given
+        source: Decoded source with normalized newlines
+        syntax_error: Error raised by the parse, if it failed
+    """
+
+    def __init__(self, path: str, source: str):
+        """
+        Initialize source file.
+
+        Args:
+            path: File path
+            source: Decoded source text
+        """
+        self.path = path
+        self.source = source
+        self.syntax_error: Optional[Exception] = None
+        self._tree: Optional[ast.AST] = None
+        self._parsed = False
+        self._lines: Optional[List[str]] = None
+
+    @property
+    def lines(self) -> List[str]:
+        """Source lines with line endings."""
+        if self._lines is None:
+            self._lines = self.source.splitlines(keepends=True)
+        return self._lines
+
+    @property
+    def tree(self) -> Optional[ast.AST]:
+        """AST of the source, parsed on first use; None if it does not parse."""
+        if not self._parsed:
+            self._parsed = True
+            try:
+                self._tree = ast.parse(self.source, filename=self.path)
+            except (SyntaxError, ValueError) as e:
+                self.syntax_error = e
+        return self._tree
+
+
+def read_source(path: Path) -> str:
+    """
+    Read a Python file, honoring its encoding declaration.
+
+    Args:
+        path: File to read
+
+    Returns:
+        Decoded source with newlines normalized to '\\n'
+
+    Raises:
+        OSError: If the file cannot be read
+        UnicodeDecodeError, SyntaxError: If the file cannot be decoded
+    """
+    data = path.read_bytes()
+    encoding, _ = tokenize.detect_encoding(io.BytesIO(data).readline)
+    return data.decode(encoding).replace("\r\n", "\n").replace("\r", "\n")
+
+
+def _unified_diff(path: str, before: str, after: str) -> str:
+    """Render a unified diff between two versions of a file."""
+    return "".join(
+        difflib.unified_diff(
+            before.splitlines(keepends=True),
+            after.splitlines(keepends=True),
+            fromfile=f"{path} (original)",
+            tofile=f"{path} (fixed)",
+        )
+    )
+
+
+def _matches_any(path: str, patterns: Sequence[str]) -> bool:
+    """
+    Check a file against exclude patterns the way flake8 does.
+
+    Patterns match the basename, or the absolute path when they contain a
+    path separator (relative to the working directory).
+    """
+    basename = os.path.basename(path)
+    absolute = os.path.abspath(path)
+    return any(
+        fnmatch.fnmatch(basename, p)
+        or fnmatch.fnmatch(absolute, os.path.abspath(p) if "/" in p else p)
+        for p in patterns
+    )
+
+
+# Per-file checks. Each runs in a worker process and returns a picklable
+# payload: a list of Issues, or radon's analysis dictionary.
+
+
+@functools.lru_cache(maxsize=None)
+def _black_project_options(directory: str) -> Dict[str, Any]:
+    """Load (and cache per process) black's pyproject.toml settings."""
+    import black
+
+    pyproject = black.find_pyproject_toml((directory,))
+    return black.parse_pyproject_toml(pyproject) if pyproject else {}
+
+
+def _check_black(src: SourceFile, config: Dict) -> List[Issue]:
+    """Check formatting with black's library API."""
+    import black
+
+    options = {**_black_project_options(os.getcwd()), **config}
+    targets = options.get("target_version", [])
+    if isinstance(targets, str):
+        targets = [targets]
+    mode = black.Mode(
+        target_versions={black.TargetVersion[t.upper()] for t in targets},
+        line_length=options.get("line_length", black.DEFAULT_LINE_LENGTH),
+        string_normalization=not options.get("skip_string_normalization", False),
+        is_pyi=src.path.endswith(".pyi"),
+    )
+    try:
+        formatted = black.format_file_contents(src.source, fast=False, mode=mode)
+    except black.NothingChanged:
+        return []
+    except Exception as e:
+        return [_issue(src.path, f"cannot format {src.path}: {e}", "BLACK_ERROR", "BLACK_ERROR")]
+
+    return [
+        _issue(
+            src.path,
+            "File would reformat",
+            "BLACK_FORMAT",
+            "BLACK_FORMAT",
+            diff=_unified_diff(src.path, src.source, formatted),
+        )
+    ]
+
+
+@functools.lru_cache(maxsize=None)
+def _isort_config(directory, profile, line_length, multi_line_output, skip, force_single_line):
+    """Build (and cache per process) an isort configuration over the project's settings."""
+    import isort
+
+    options: Dict[str, Any] = {}
+    if profile is not None:
+        options["profile"] = profile
+    if line_length is not None:
+        options["line_length"] = line_length
+    if multi_line_output is not None:
+        options["multi_line_output"] = isort.wrap_modes.WrapModes(multi_line_output)
+    if skip:
+        options["extend_skip_glob"] = skip
+    if force_single_line:
+        options["force_single_line"] = True
+    return isort.Config(settings_path=directory, **options)
+
+
+def _check_isort(src: SourceFile, config: Dict) -> List[Issue]:
+    """Check import order with isort's library API."""
+    import isort
+    from isort.exceptions import FileSkipped
+
+    settings = _isort_config(
+        os.getcwd(),
+        config.get("profile"),
+        config.get("line_length"),
+        config.get("multi_line_output"),
+        tuple(config.get("skip", ())),
+        bool(config.get("force_single_line")),
+    )
+    if settings.is_skipped(Path(src.path)):
+        return []
+    try:
+        sorted_source = isort.code(src.source, config=settings, file_path=Path(src.path))
+    except FileSkipped:
+        return []
+    if sorted_source == src.source:
+        return []
+
+    return [
+        _issue(
+            src.path,
+            "Imports are incorrectly sorted and/or formatted",
+            "ISORT_ORDER",
+            "ISORT_ORDER",
+            diff=_unified_diff(src.path, src.source, sorted_source),
+        )
+    ]
+
+
+def _check_autoflake(src: SourceFile, config: Dict) -> List[Issue]:
+    """Check for removable unused code with autoflake's library API."""
+    import autoflake
+
+    fixed = autoflake.fix_code(
+        src.source,
+        additional_imports=config.get("imports") or None,
+        expand_star_imports=config.get("expand_star_imports", False),
+        remove_all_unused_imports=config.get("remove_all_unused_imports", False),
+        remove_duplicate_keys=config.get("remove_duplicate_keys", False),
+        remove_unused_variables=config.get("remove_unused_variables", False),
+        ignore_init_module_imports=(
+            config.get("ignore_init_module_imports", False)
+            and os.path.basename(src.path) == "__init__.py"
+        ),
+    )
+    if fixed == src.source:
+        return []
+
+    return [
+        _issue(
+            src.path,
+            "File contains unused imports, unused variables, "
+            "or duplicate keys that can be removed",
+            "unused-code",
+        )
+    ]
+
+
+@functools.lru_cache(maxsize=None)
+def _flake8_project_options(directory: str) -> Dict[str, str]:
+    """
+    Load (and cache per process) the project's [flake8] settings.
+
+    Searches setup.cfg, tox.ini and .flake8 from the directory upwards, as
+    flake8 does.
+
+    Args:
+        directory: Directory to start searching from
+
+    Returns:
+        Option name to raw value, or empty if no configuration was found
+    """
+    current = Path(directory).resolve()
+    for candidate in (current, *current.parents):
+        for name in ("setup.cfg", "tox.ini", ".flake8"):
+            parser = configparser.RawConfigParser()
+            try:
+                parser.read(candidate / name, encoding="utf-8")
+            except (configparser.Error, UnicodeDecodeError):
+                continue
+            if parser.has_section("flake8"):
+                return {k.replace("_", "-"): v for k, v in parser.items("flake8")}
+    return {}
+
+
+def _option_list(value: Any) -> List[str]:
+    """Normalize a list option given as a list or a comma-separated string."""
+    if isinstance(value, str):
+        return [v.strip() for v in re.split(r"[,\s]+", value) if v.strip()]
+    return list(value or [])
+
+
+def _flake8_settings(config: Dict) -> Dict[str, Any]:
+    """
+    Combine anvil's flake8 options with the project's flake8 configuration.
+
+    Anvil's options take precedence, as command line options do for flake8.
+
+    Args:
+        config: Validator configuration
+
+    Returns:
+        Dictionary with max_line_length, max_complexity, select, ignore and
+        exclude
+    """
+    project = _flake8_project_options(os.getcwd())
+
+    select = _option_list(config.get("select") or project.get("select")) or list(
+        FLAKE8_DEFAULT_SELECT
+    )
+    ignore = _option_list(config.get("ignore") or project.get("ignore")) or list(
+        FLAKE8_DEFAULT_IGNORE
+    )
+    exclude = _option_list(config.get("exclude") or project.get("exclude"))
+
+    return {
+        "max_line_length": int(config.get("max_line_length", project.get("max-line-length", 79))),
+        "max_doc_length": config.get("max_doc_length", project.get("max-doc-length")),
+        "max_complexity": int(config.get("max_complexity", project.get("max-complexity", -1))),
+        "select": select + _option_list(project.get("extend-select")),
+        "ignore": ignore + _option_list(project.get("extend-ignore")),
+        "exclude": exclude + _option_list(project.get("extend-exclude")),
+    }
+
+
+@functools.lru_cache(maxsize=None)
+def _pycodestyle_options(max_line_length: int, max_doc_length: Optional[int]):
+    """Build (and cache per process) pycodestyle options enabling every check."""
+    import pycodestyle
+
+    # Select everything; flake8's select/ignore rules are applied afterwards
+    style = pycodestyle.StyleGuide(
+        select=("E", "W"),
+        max_line_length=max_line_length,
+        max_doc_length=max_doc_length,
+        quiet=True,
+    )
+    return style.options
+
+
+def _pycodestyle_errors(src: SourceFile, settings: Dict) -> List[Tuple[int, int, str, str]]:
+    """Run pycodestyle over the shared source lines."""
+    import pycodestyle
+
+    found: List[Tuple[int, int, str, str]] = []
+
+    class CollectingReport(pycodestyle.BaseReport):
+        def error(self, line_number, offset, text, check):
+            found.append((line_number, offset + 1, text[:4], text[5:]))
+            return text[:4]
+
+    max_doc_length = settings["max_doc_length"]
+    options = _pycodestyle_options(
+        settings["max_line_length"], int(max_doc_length) if max_doc_length else None
+    )
+    pycodestyle.Checker(
+        src.path, lines=src.lines, options=options, report=CollectingReport(options)
+    ).check_all()
+    return found
+
+
+def _flake8_selected(code: str, select: Sequence[str], ignore: Sequence[str]) -> bool:
+    """Decide whether flake8 would report a code (the longest matching prefix wins)."""
+    selected = max((len(s) for s in select if code.startswith(s)), default=0)
+    ignored = max((len(i) for i in ignore if code.startswith(i)), default=0)
+    return selected > ignored
+
+
+def _noqa(line: str, code: str) -> bool:
+    """Check whether a source line suppresses a code with '# noqa'."""
+    match = _NOQA_RE.search(line)
+    if match is None:
+        return False
+    codes = match.group("codes")
+    return codes is None or any(code.startswith(c) for c in re.split(r"[,\s]+", codes.upper()))
+
+
+def _check_flake8(src: SourceFile, config: Dict) -> List[Issue]:
+    """Run pyflakes and mccabe on the shared AST and pycodestyle on the shared lines."""
+    from anvil.parsers.flake8_parser import Flake8Parser
+
+    settings = _flake8_settings(config)
+    if settings["exclude"] and _matches_any(src.path, settings["exclude"]):
+        return []
+
+    tree = src.tree
+    if tree is None:
+        error = src.syntax_error
+        row = getattr(error, "lineno", None) or 1
+        col = (getattr(error, "offset", None) or 0) + 1
+        message = error.args[0] if error.args else str(error)
+        found = [(row, col, "E999", f"{type(error).__name__}: {message}")]
+    else:
+        from flake8.plugins.pyflakes import FlakesChecker
+
+        found = []
+        for row, col, text, _ in FlakesChecker(tree, src.path).run():
+            found.append((row, col + 1, text[:4], text[5:]))
+        found.extend(_pycodestyle_errors(src, settings))
+
+        max_complexity = settings["max_complexity"]
+        if max_complexity >= 0:
+            import mccabe
+
+            visitor = mccabe.PathGraphingAstVisitor()
+            visitor.preorder(tree, visitor)
+            for graph in visitor.graphs.values():
+                complexity = graph.complexity()
+                if complexity > max_complexity:
+                    found.append(
+                        (
+                            graph.lineno,
+                            graph.column + 1,
+                            "C901",
+                            f"{graph.entity!r} is too complex ({complexity})",
+                        )
+                    )
+
+    select, ignore = settings["select"], settings["ignore"]
+    lines = src.lines
+    issues = []
+    for row, col, code, message in sorted(found):
+        if not _flake8_selected(code, select, ignore):
+            continue
+        if code != "E999" and 0 < row <= len(lines) and _noqa(lines[row - 1], code):
+            continue
+        issues.append(
+            Issue(
+                file_path=src.path,
+                line_number=row,
+                column_number=col,
+                severity=Flake8Parser.map_severity(code),
+                message=message,
+                rule_name=code,
+                error_code=code,
+            )
+        )
+    return issues
+
+
+def _check_radon(src: SourceFile, config: Dict) -> Dict:
+    """Compute radon's cc, mi and raw metrics from the shared AST."""
+    from anvil.parsers.radon_analyzer import analyze_source
+
+    if src.tree is None:
+        return {"error": str(src.syntax_error)}
+    return analyze_source(
+        src.source,
+        multi=config.get("multi", True),
+        show_closures=config.get("show_closures", False),
+        tree=src.tree,
+    )
+
+
+PER_FILE_CHECKS: Dict[str, Callable[[SourceFile, Dict], Any]] = {
+    "flake8": _check_flake8,
+    "black": _check_black,
+    "isort": _check_isort,
+    "autoflake": _check_autoflake,
+    "radon": _check_radon,
+}
+
+
+def _issue(
+    path: str,
+    message: str,
+    rule_name: str,
+    error_code: Optional[str] = None,
+    diff: Optional[str] = None,
+) -> Issue:
+    """Build a file-level error issue."""
+    return Issue(
+        file_path=path,
+        line_number=1,
+        column_number=None,
+        severity="error",
+        message=message,
+        rule_name=rule_name,
+        error_code=error_code,
+        diff=diff,
+    )
+
+
+def _check_chunk(
+    chunk: Sequence[Tuple[str, str]], tools: Sequence[str], config: Dict
+) -> Tuple[Dict[str, Dict[str, Any]], Dict[str, float]]:
+    """
+    Run every per-file tool over a chunk of files (process pool entry point).
+
+    Args:
+        chunk: (path, source) pairs
+        tools: Names of per-file tools to run
+        config: Validator configuration
+
+    Returns:
+        Tuple of (payload per tool per path, seconds spent per tool)
+    """
+    payloads: Dict[str, Dict[str, Any]] = {tool: {} for tool in tools}
+    seconds = dict.fromkeys(tools, 0.0)
+
+    for path, source in chunk:
+        src = SourceFile(path, source)
+        for tool in tools:
+            start = time.perf_counter()
+            try:
+                payloads[tool][path] = PER_FILE_CHECKS[tool](src, config)
+            except Exception as e:
+                # One tool crashing on one file must not lose the others' results
+                if tool == "radon":
+                    payloads[tool][path] = {"error": str(e)}
+                else:
+                    payloads[tool][path] = [_issue(path, f"{tool} failed: {e}", f"{tool}-error")]
+            seconds[tool] += time.perf_counter() - start
+
+    return payloads, seconds
+
+
+def _run_vulture(sources: Dict[str, str], config: Dict) -> List[Issue]:
+    """
+    Find unused code across all files with vulture's library API.
+
+    Args:
+        sources: Source text per path
+        config: Validator configuration
+
+    Returns:
+        One warning per unused item
+    """
+    import vulture
+
+    scanner = vulture.Vulture(
+        ignore_names=config.get("ignore_names") or None,
+        ignore_decorators=config.get("ignore_decorators") or None,
+    )
+    # vulture treats patterns without wildcards as substrings
+    exclude = [p if any(c in p for c in "*?[") else f"*{p}*" for p in config.get("exclude", [])]
+    for path, source in sources.items():
+        if not any(fnmatch.fnmatch(path, p) for p in exclude):
+            scanner.scan(source, filename=Path(path))
+
+    return [
+        Issue(
+            file_path=str(item.filename),
+            line_number=item.first_lineno,
+            column_number=None,
+            message=f"{item.message} ({item.confidence}% confidence)",
+            severity="warning",
+            rule_name="dead-code",
+        )
+        for item in scanner.get_unused_code(
+            min_confidence=config.get("min_confidence", 0),
+            sort_by_size=config.get("sort_by_size", False),
+        )
+    ]
+
+
+class SinglePassRunner:
+    """
+    Runs several Python validators over one shared read and parse per file.
+
+    Examples:
+        >>> runner = SinglePassRunner(jobs=8)
+        >>> tools = runner.supported_tools(config)
+        >>> results = runner.run(tools, [Path("src/module.py")], config)
+        >>> [r.validator_name for r in results]
+        ['flake8', 'black', 'isort', 'radon']
+    """
+
+    def __init__(self, jobs: Optional[int] = None):
+        """
+        Initialize runner.
+
+        Args:
+            jobs: Worker processes (default: CPU count)
+        """
+        self.jobs = max(1, jobs or os.cpu_count() or 1)
+
+    @staticmethod
+    def supported_tools(config: Dict) -> List[str]:
+        """
+        List the tools that can run in-process with this configuration.
+
+        A tool is supported when its library is importable and it is not
+        configured to rewrite files or to produce tool-specific output.
+
+        Args:
+            config: Validator configuration
+
+        Returns:
+            Supported tool names
+        """
+        if config.get("fix"):
+            unsupported = {"black", "isort", "autoflake"}
+        else:
+            unsupported = set()
+        if config.get("make_whitelist"):
+            unsupported.add("vulture")
+        if config.get("in_process") is False:
+            unsupported.add("radon")
+
+        return [
+            tool
+            for tool, modules in REQUIRED_MODULES.items()
+            if tool not in unsupported
+            and all(importlib.util.find_spec(m) is not None for m in modules)
+        ]
+
+    def run(
+        self, tools: Sequence[str], files: Sequence[Path], config: Dict
+    ) -> List[ValidationResult]:
+        """
+        Check files with all given tools, reading and parsing each file once.
+
+        Args:
+            tools: Tool names (from supported_tools)
+            files: Files to check; non-Python files are ignored
+            config: Validator configuration
+
+        Returns:
+            One ValidationResult per tool, in the order given
+        """
+        paths = [str(f) for f in files if str(f).endswith(PYTHON_SUFFIXES)]
+
+        sources: Dict[str, str] = {}
+        read_errors: List[Tuple[str, str]] = []
+        for path in paths:
+            try:
+                sources[path] = read_source(Path(path))
+            except (OSError, UnicodeDecodeError, SyntaxError) as e:
+                read_errors.append((path, str(e)))
+
+        per_file_tools = tuple(t for t in tools if t in PER_FILE_CHECKS)
+        payloads: Dict[str, Dict[str, Any]] = {tool: {} for tool in per_file_tools}
+        seconds = dict.fromkeys(tools, 0.0)
+        items = list(sources.items())
+
+        def merge(chunk_result):
+            chunk_payloads, chunk_seconds = chunk_result
+            for tool in per_file_tools:
+                payloads[tool].update(chunk_payloads[tool])
+                seconds[tool] += chunk_seconds[tool]
+
+        vulture_issues: List[Issue] = []
+        if per_file_tools and len(items) >= MIN_FILES_FOR_POOL and self.jobs > 1:
+            workers = min(self.jobs, len(items))
+            size = max(1, len(items) // (workers * 4))
+            chunks = [items[i : i + size] for i in range(0, len(items), size)]
+            with ProcessPoolExecutor(max_workers=workers) as pool:
+                futures = [pool.submit(_check_chunk, c, per_file_tools, config) for c in chunks]
+                # vulture needs every file; scan in the parent while workers run
+                if "vulture" in tools:
+                    vulture_issues = self._timed_vulture(sources, config, seconds)
+                for future in futures:
+                    merge(future.result())
+        else:
+            if per_file_tools:
+                merge(_check_chunk(items, per_file_tools, config))
+            if "vulture" in tools:
+                vulture_issues = self._timed_vulture(sources, config, seconds)
+
+        results = []
+        for tool in tools:
+            if tool == "radon":
+                result = self._radon_result(payloads["radon"], paths, config)
+            else:
+                issues = vulture_issues if tool == "vulture" else self._ordered(payloads[tool])
+                result = ValidationResult(
+                    validator_name=tool,
+                    passed=True,
+                    errors=[i for i in issues if i.severity == "error"],
+                    warnings=[i for i in issues if i.severity != "error"],
+                    files_checked=len(paths),
+                )
+            result.errors.extend(
+                _issue(path, f"Could not read file: {message}", f"{tool}-error")
+                for path, message in read_errors
+            )
+            result.passed = not result.errors and not result.warnings
+            result.execution_time = seconds[tool]
+            result.metadata = {**(result.metadata or {}), "single_pass": True}
+            results.append(result)
+        return results
+
+    @staticmethod
+    def _timed_vulture(sources: Dict[str, str], config: Dict, seconds: Dict[str, float]):
+        """Run vulture and record its duration."""
+        start = time.perf_counter()
+        issues = _run_vulture(sources, config)
+        seconds["vulture"] += time.perf_counter() - start
+        return issues
+
+    @staticmethod
+    def _ordered(payload: Dict[str, List[Issue]]) -> List[Issue]:
+        """Flatten per-file issues in file order."""
+        return [issue for issues in payload.values() for issue in issues]
+
+    @staticmethod
+    def _radon_result(payload: Dict[str, Dict], paths: List[str], config: Dict):
+        """Convert per-file radon analyses into the radon validator's result."""
+        from anvil.parsers.radon_parser import RadonParser
+
+        results = {path: payload[path] for path in paths if path in payload}
+        return RadonParser.parse_analysis(results, [Path(p) for p in paths], config)
@@ -1,9 +1,17 @@
 """
 Git integration for Anvil.
 
-Provides git hook management and version control integration.
+Provides git hook management, staged content access and version control
+integration.
 """
 
 from anvil.git.hooks import GitHookError, GitHookManager
+from anvil.git.staged import StagedContentError, StagedSnapshot, StagedTree
 
-__all__ = ["GitHookManager", "GitHookError"]
+__all__ = [
+    "GitHookManager",
+    "GitHookError",
+    "StagedContentError",
+    "StagedSnapshot",
+    "StagedTree",
+]
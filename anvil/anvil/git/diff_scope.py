@@ -0,0 +1,221 @@
+"""
+Diff-scoped validation: limit reported issues to changed lines.
+
+On large legacy code bases full analyzer output is mostly noise about code
+nobody touched. DiffScope computes the lines each file adds or changes
+relative to a base commit. Tools that can restrict themselves take the
+ranges directly (clang-tidy --line-filter, clang-format --lines), only
+changed files are analyzed at all, and every other issue is checked
+against a per-file LineRangeIndex.
+"""
+
+import bisect
+from dataclasses import replace
+from pathlib import Path
+from typing import Callable, Dict, Iterable, List, Optional, Tuple, Union
+
+from anvil.models.validator import Issue, ValidationResult
+
+LineRange = Tuple[int, int]
+
+# Validators whose issues describe the whole file (reported on line 1)
+FILE_LEVEL_VALIDATORS = {"autoflake", "black", "isort"}
+
+# Line range covering a whole file (untracked files are new in full)
+WHOLE_FILE: LineRange = (1, 2**31 - 1)
+
+
+class LineRangeIndex:
+    """
+    Point lookup over a file's changed line ranges.
+
+    Ranges are merged into disjoint sorted intervals once, so each lookup is
+    a binary search instead of a scan over every hunk.
+
+    Args:
+        ranges: Inclusive 1-based line ranges, in any order
+    """
+
+    def __init__(self, ranges: Iterable[LineRange] = ()):
+        """Merge overlapping and adjacent ranges."""
+        merged: List[List[int]] = []
+        for start, end in sorted(ranges):
+            if merged and start <= merged[-1][1] + 1:
+                merged[-1][1] = max(merged[-1][1], end)
+            else:
+                merged.append([start, end])
+        self._starts = [start for start, _ in merged]
+        self._ends = [end for _, end in merged]
+
+    @property
+    def ranges(self) -> List[LineRange]:
+        """Merged ranges in line order."""
+        return list(zip(self._starts, self._ends))
+
+    def __contains__(self, line: Optional[int]) -> bool:
+        """
+        Check whether an issue line is inside a changed range.
+
+        Args:
+            line: Issue line number (0 or None for file-level issues)
+
+        Returns:
+            True for file-level issues and lines inside a range
+        """
+        if not line:
+            return True
+        i = bisect.bisect_right(self._starts, line) - 1
+        return i >= 0 and line <= self._ends[i]
+
+    def __bool__(self) -> bool:
+        """Whether any line is changed."""
+        return bool(self._starts)
+
+
+def scope_results(
+    results: List[ValidationResult],
+    indexes: Dict[Path, LineRangeIndex],
+    map_path: Callable[[str], Optional[Path]],
+    changed_lines_only: bool = True,
+    rewrite_paths: bool = True,
+) -> List[ValidationResult]:
+    """
+    Restrict validator results to changed lines.
+
+    Issues in files without an index (e.g. headers pulled in by an analyzer)
+    are dropped, issues without a mappable path (tool errors) are kept, and a
+    result that failed only because of dropped issues passes.
+
+    Args:
+        results: Validator results
+        indexes: Changed lines by resolved file path
+        map_path: Maps a reported path to the key used in indexes (None for
+            paths outside the scope, whose issues are kept unchanged)
+        changed_lines_only: Drop line-level issues outside changed lines
+        rewrite_paths: Report the mapped path instead of the original
+
+    Returns:
+        Results with scoped issues and mapped paths
+    """
+    scoped = []
+    for result in results:
+        filter_lines = changed_lines_only and result.validator_name not in FILE_LEVEL_VALIDATORS
+
+        def keep(issue: Issue) -> Optional[Issue]:
+            path = map_path(issue.file_path) if issue.file_path else None
+            if path is None:
+                return issue
+            if filter_lines and issue.line_number not in indexes.get(path, LineRangeIndex()):
+                return None
+            return replace(issue, file_path=str(path)) if rewrite_paths else issue
+
+        errors = [i for i in map(keep, result.errors) if i is not None]
+        warnings = [i for i in map(keep, result.warnings) if i is not None]
+        # A failure caused only by issues outside the change now passes
+        had_issues = bool(result.errors or result.warnings)
+        passed = result.passed or (had_issues and not errors and not warnings)
+        scoped.append(replace(result, errors=errors, warnings=warnings, passed=passed))
+    return scoped
+
+
+class DiffScope:
+    """
+    Changed line ranges of the working tree relative to a base commit.
+
+    Args:
+        root: Repository working tree root
+        ranges: Changed line ranges by path relative to root
+    """
+
+    def __init__(self, root: Union[str, Path], ranges: Dict[str, List[LineRange]]):
+        """Build one LineRangeIndex per changed file."""
+        self.root = Path(root).resolve()
+        self.indexes: Dict[Path, LineRangeIndex] = {
+            self.root / rel: LineRangeIndex(r) for rel, r in ranges.items()
+        }
+
+    @classmethod
+    def from_git(
+        cls, repo_dir: Union[str, Path], base: str = "HEAD", head: Optional[str] = None
+    ) -> "DiffScope":
+        """
+        Compute changed lines of tracked and untracked files against a commit.
+
+        Args:
+            repo_dir: Any directory inside the repository
+            base: Commit to diff the working tree against
+            head: Diff this commit instead of the working tree (untracked
+                files are then ignored)
+
+        Returns:
+            DiffScope over the changed files
+
+        Raises:
+            StagedContentError: If git fails (e.g. unknown base commit)
+        """
+        # Imported lazily; the staged module builds on this one
+        from anvil.git.staged import StagedSnapshot, parse_staged_diff, run_git
+
+        # Both commands run at the top level: ls-files prints paths relative
+        # to its working directory, while the diff paths are always relative
+        # to the top level
+        top_level = StagedSnapshot(repo_dir).top_level
+        diff = run_git(
+            top_level,
+            [
+                "diff",
+                "-U0",
+                "--full-index",
+                "--no-color",
+                "--no-ext-diff",
+                "--no-renames",
+                "--diff-filter=ACM",
+                base,
+                *([head] if head else []),
+            ],
+        ).decode("utf-8", errors="surrogateescape")
+        ranges = {f.path: f.line_ranges for f in parse_staged_diff(diff)}
+
+        if head is None:
+            untracked = run_git(top_level, ["ls-files", "--others", "--exclude-standard", "-z"])
+            for path in untracked.decode("utf-8", errors="surrogateescape").split("\0"):
+                if path:
+                    ranges[path] = [WHOLE_FILE]
+
+        return cls(top_level, ranges)
+
+    @property
+    def files(self) -> List[Path]:
+        """Changed files that exist in the working tree, sorted."""
+        return sorted(path for path, index in self.indexes.items() if index and path.is_file())
+
+    @property
+    def line_ranges(self) -> Dict[str, List[LineRange]]:
+        """Changed line ranges by path string, for tool line filters."""
+        return {str(path): index.ranges for path, index in self.indexes.items()}
+
+    def _map_path(self, path: str) -> Optional[Path]:
+        """Resolve a reported path; paths outside the repository are kept."""
+        resolved = Path(path).resolve()
+        try:
+            resolved.relative_to(self.root)
+        except ValueError:
+            return None
+        return resolved
+
+    def filter_results(
+        self, results: List[ValidationResult], changed_lines_only: bool = True
+    ) -> List[ValidationResult]:
+        """
+        Keep only issues on changed lines.
+
+        Args:
+            results: Validator results for files in this scope
+            changed_lines_only: Drop line-level issues outside changed lines
+
+        Returns:
+            Scoped results
+        """
+        return scope_results(
+            results, self.indexes, self._map_path, changed_lines_only, rewrite_paths=False
+        )
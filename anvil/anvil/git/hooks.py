@@ -85,15 +85,15 @@ if [ -n "$ANVIL_SKIP" ] || \\
     exit 0
 fi
 
-# Run Anvil incremental validation
+# Run Anvil validation on the staged content of changed lines
 echo "Running Anvil validation..."
 
 # Try direct command first, fall back to Python module
 if command -v anvil >/dev/null 2>&1; then
-    anvil check --incremental
+    anvil check --incremental --staged
     exit $?
 else
-    python -m anvil check --incremental
+    python -m anvil check --incremental --staged
     exit $?
 fi
 """
@@ -0,0 +1,493 @@
+"""
+Staged content access for pre-commit validation.
+
+Reads the staged version of changed files straight from the git object
+store, so validation sees exactly what will be committed regardless of
+unstaged edits in the working tree, and records which lines each file
+changes so results can be limited to them.
+
+All staged files below the current directory are listed with one
+`git diff --cached` and their blobs read with one `git cat-file --batch`,
+then written to a scratch tree on tmpfs (/dev/shm when available) together
+with the staged versions of the tool configuration files that apply to
+them. The scratch tree overlays the working tree: only the directories on
+the way to a staged file are real, and every other entry in them links to
+the working tree, so relative includes, sibling modules and tool lookups
+see the rest of the project. compile_commands.json files are rewritten to
+compile the staged copies.
+"""
+
+import json
+import os
+import re
+import shlex
+import shutil
+import subprocess
+import tempfile
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Dict, Iterable, List, Optional, Union
+
+from anvil.git.diff_scope import LineRange, LineRangeIndex, scope_results
+from anvil.models.validator import ValidationResult
+from anvil.utils.tracing import span
+
+# Tool configuration files copied into the scratch tree
+CONFIG_FILE_NAMES = {
+    ".clang-format",
+    ".clang-tidy",
+    ".flake8",
+    ".isort.cfg",
+    ".pylintrc",
+    "CPPLINT.cfg",
+    "_clang-format",
+    "pylintrc",
+    "pyproject.toml",
+    "setup.cfg",
+    "tox.ini",
+}
+
+_HUNK_RE = re.compile(r"^@@ -\d+(?:,\d+)? \+(\d+)(?:,(\d+))? @@")
+
+
+class StagedContentError(Exception):
+    """Exception raised when staged content cannot be read."""
+
+
+@dataclass
+class StagedFile:
+    """
+    A file with staged content changes.
+
+    Attributes:
+        path: Path relative to the repository root, with forward slashes
+        blob: Object id of the staged content
+        line_ranges: Inclusive 1-based line ranges added or changed
+    """
+
+    path: str
+    blob: str
+    line_ranges: List[LineRange] = field(default_factory=list)
+
+
+def _unquote(path: str) -> str:
+    """Decode a path git quoted because of special characters."""
+    if not path.startswith('"'):
+        return path
+    raw = path[1:-1].encode("latin-1").decode("unicode_escape")
+    return raw.encode("latin-1").decode("utf-8", errors="surrogateescape")
+
+
+def parse_staged_diff(diff: str) -> List[StagedFile]:
+    """
+    Parse `git diff --cached -U0 --full-index` output.
+
+    Args:
+        diff: Zero-context diff of the index against HEAD
+
+    Returns:
+        Staged files that add or change lines, in diff order
+    """
+    files: List[StagedFile] = []
+    blob: Optional[str] = None
+    current: Optional[StagedFile] = None
+
+    for line in diff.splitlines():
+        if line.startswith("diff --git "):
+            blob, current = None, None
+        elif line.startswith("index "):
+            # index <old>..<new>[ <mode>]
+            blob = line.split()[1].split("..")[1]
+        elif line.startswith("+++ "):
+            target = _unquote(line[4:].rstrip("\t"))
+            if target != "/dev/null" and blob:
+                current = StagedFile(path=target[2:], blob=blob)
+                files.append(current)
+        elif line.startswith("@@") and current is not None:
+            match = _HUNK_RE.match(line)
+            if match:
+                start = int(match.group(1))
+                count = 1 if match.group(2) is None else int(match.group(2))
+                if count:
+                    current.line_ranges.append((start, start + count - 1))
+
+    return [f for f in files if f.line_ranges]
+
+
+def parse_cat_file_batch(output: bytes) -> Dict[str, bytes]:
+    """
+    Parse `git cat-file --batch` output.
+
+    Args:
+        output: Raw batch output
+
+    Returns:
+        Content of each object found, by object id
+    """
+    blobs: Dict[str, bytes] = {}
+    pos = 0
+    while pos < len(output):
+        end = output.index(b"\n", pos)
+        header = output[pos:end].decode("ascii").split()
+        pos = end + 1
+        if len(header) < 3 or header[1] == "missing":
+            continue
+        size = int(header[2])
+        blobs[header[0]] = output[pos : pos + size]
+        pos += size + 1
+    return blobs
+
+
+def run_git(cwd: Union[str, Path], args: List[str], input: Optional[bytes] = None) -> bytes:
+    """
+    Run a git command.
+
+    Args:
+        cwd: Directory inside the repository
+        args: Arguments after "git"
+        input: Bytes to send on stdin
+
+    Returns:
+        Standard output
+
+    Raises:
+        StagedContentError: If git is missing or the command fails
+    """
+    try:
+        with span("anvil.git", command=args[0]):
+            result = subprocess.run(
+                ["git", *args],
+                cwd=cwd,
+                input=input,
+                capture_output=True,
+                check=True,
+                timeout=30,
+            )
+    except FileNotFoundError:
+        raise StagedContentError("git is not installed or not in PATH")
+    except subprocess.CalledProcessError as e:
+        message = e.stderr.decode(errors="replace").strip()
+        raise StagedContentError(f"git {args[0]} failed: {message}")
+    except subprocess.TimeoutExpired:
+        raise StagedContentError(f"git {args[0]} timed out")
+    return result.stdout
+
+
+class StagedSnapshot:
+    """
+    Reads staged changes and their content from a git repository.
+
+    Args:
+        repo_dir: Any directory inside the repository
+    """
+
+    def __init__(self, repo_dir: Union[str, Path]):
+        """Initialize the snapshot for a repository."""
+        self.repo_dir = Path(repo_dir)
+        self._top_level: Optional[Path] = None
+
+    def _git(self, args: List[str], input: Optional[bytes] = None) -> bytes:
+        """Run a git command in the repository (see run_git)."""
+        return run_git(self.repo_dir, args, input)
+
+    @property
+    def top_level(self) -> Path:
+        """Root directory of the repository's working tree."""
+        if self._top_level is None:
+            output = self._git(["rev-parse", "--show-toplevel"])
+            self._top_level = Path(output.decode().strip())
+        return self._top_level
+
+    def staged_files(self, paths: Optional[Iterable[Union[str, Path]]] = None) -> List[StagedFile]:
+        """
+        List staged files with their blob ids and changed line ranges.
+
+        Renames are reported as additions, so every line of a renamed file
+        counts as changed.
+
+        Args:
+            paths: Limit to these paths, relative to repo_dir (default: all
+                staged files below repo_dir)
+
+        Returns:
+            Staged files that add or change lines
+        """
+        args = [
+            "diff",
+            "--cached",
+            "-U0",
+            "--full-index",
+            "--no-color",
+            "--no-ext-diff",
+            "--no-renames",
+            "--diff-filter=ACM",
+        ]
+        # Pathspecs are relative to repo_dir; the paths printed are not
+        args += ["--", *(str(p) for p in paths)] if paths is not None else ["--", "."]
+        diff = self._git(args).decode("utf-8", errors="surrogateescape")
+        return parse_staged_diff(diff)
+
+    def config_files(self) -> Dict[str, str]:
+        """
+        Find tool configuration files in the index.
+
+        Returns:
+            Blob id of each staged configuration file, by repository path
+        """
+        configs = {}
+        # Listed from the top level so paths are repository paths
+        output = run_git(self.top_level, ["ls-files", "--stage", "-z"])
+        output = output.decode("utf-8", "surrogateescape")
+        for entry in output.split("\0"):
+            if not entry:
+                continue
+            info, path = entry.split("\t", 1)
+            if path.rsplit("/", 1)[-1] in CONFIG_FILE_NAMES:
+                configs[path] = info.split()[1]
+        return configs
+
+    def read_blobs(self, blob_ids: Iterable[str]) -> Dict[str, bytes]:
+        """
+        Read blob contents with a single `git cat-file --batch` process.
+
+        Args:
+            blob_ids: Object ids to read
+
+        Returns:
+            Content of each blob, by object id
+        """
+        ids = list(dict.fromkeys(blob_ids))
+        if not ids:
+            return {}
+        output = self._git(["cat-file", "--batch"], input="\n".join(ids).encode() + b"\n")
+        return parse_cat_file_batch(output)
+
+    def materialize(self, files: Optional[List[StagedFile]] = None) -> "StagedTree":
+        """
+        Write staged content to a scratch tree.
+
+        Args:
+            files: Staged files to write (default: all staged files);
+                configuration files in their directories or above are
+                always written
+
+        Returns:
+            StagedTree to use as a context manager
+        """
+        if files is None:
+            files = self.staged_files()
+        configs = {}
+        if files:
+            directories = {""} | {d for f in files for d in _parent_dirs(f.path)}
+            configs = {
+                path: blob
+                for path, blob in self.config_files().items()
+                if path.rpartition("/")[0] in directories
+            }
+        blobs = self.read_blobs([f.blob for f in files] + list(configs.values()))
+        return StagedTree(self.top_level, files, configs, blobs)
+
+
+def _parent_dirs(rel_path: str) -> List[str]:
+    """Parent directories of a repository path, e.g. ["a", "a/b"] for "a/b/c"."""
+    parts = rel_path.split("/")[:-1]
+    return ["/".join(parts[: i + 1]) for i in range(len(parts))]
+
+
+class StagedTree:
+    """
+    Staged content written to a temporary overlay of the working tree.
+
+    Validators run on the scratch copies; remap() turns their results back
+    into repository paths and drops issues outside the changed lines.
+    Directories leading to a written file are real directories whose other
+    entries link to the working tree (where links cannot be created, files
+    are copied and directories left out).
+
+    Args:
+        repo_root: Repository working tree root
+        files: Staged files to write
+        configs: Configuration blob ids by repository path
+        blobs: Blob contents by object id
+    """
+
+    def __init__(
+        self,
+        repo_root: Path,
+        files: List[StagedFile],
+        configs: Dict[str, str],
+        blobs: Dict[str, bytes],
+    ):
+        """Write the staged files and configuration into a scratch overlay."""
+        self.repo_root = Path(repo_root).resolve()
+        shm = Path("/dev/shm")
+        base = str(shm) if shm.is_dir() and os.access(shm, os.W_OK) else None
+        self._scratch = Path(tempfile.mkdtemp(prefix="anvil-staged-", dir=base)).resolve()
+        self.root = self._scratch / "tree"
+
+        contents = {path: blobs.get(blob, b"") for path, blob in configs.items()}
+        staged_files = [f for f in files if f.blob in blobs]
+        contents.update((f.path, blobs[f.blob]) for f in staged_files)
+        self._staged_paths = {
+            str(self.repo_root / f.path): str(self.root / f.path) for f in staged_files
+        }
+
+        self._files: Dict[str, StagedFile] = {}
+        self._overlay(contents)
+        for staged in staged_files:
+            self._files[str(self.root / staged.path)] = staged
+
+    def _overlay(self, contents: Dict[str, bytes]) -> None:
+        """Write contents by repository path and link everything next to them."""
+        directories = {""} | {d for path in contents for d in _parent_dirs(path)}
+        for directory in sorted(directories):
+            (self.root / directory).mkdir(parents=True, exist_ok=True)
+
+        for directory in directories:
+            try:
+                entries = list(os.scandir(self.repo_root / directory))
+            except OSError:
+                continue
+            for entry in entries:
+                rel_path = f"{directory}/{entry.name}" if directory else entry.name
+                if rel_path in directories or rel_path in contents or rel_path == ".git":
+                    continue
+                target = self.root / rel_path
+                if entry.name == "compile_commands.json" and entry.is_file():
+                    self._write_compile_database(Path(entry.path), target)
+                else:
+                    self._link(Path(entry.path), target)
+
+        for rel_path, content in contents.items():
+            (self.root / rel_path).write_bytes(content)
+
+    @staticmethod
+    def _link(source: Path, target: Path) -> None:
+        """Link target to a working tree entry, or copy it if links are unavailable."""
+        is_dir = source.is_dir()
+        try:
+            os.symlink(source, target, target_is_directory=is_dir)
+        except OSError:
+            # Symlinks need privileges on Windows; copying whole directories
+            # would cost more than the check saves
+            if not is_dir:
+                shutil.copy2(source, target)
+
+    def _write_compile_database(self, source: Path, target: Path) -> None:
+        """
+        Write a compilation database whose staged entries compile the scratch copies.
+
+        Entries keep their build directory, so relative flags still resolve
+        in the build tree. Unreadable databases are linked unchanged.
+        """
+        try:
+            entries = json.loads(source.read_text(encoding="utf-8"))
+            for entry in entries:
+                directory = entry.get("directory", "")
+                source_file = os.path.normpath(os.path.join(directory, entry["file"]))
+                scratch = self._staged_paths.get(source_file)
+                if scratch is None:
+                    continue
+
+                # The source file is also among the compiler arguments
+                arguments = entry.pop("arguments", None)
+                if arguments is None:
+                    arguments = shlex.split(entry.pop("command"))
+                entry["arguments"] = [
+                    (
+                        scratch
+                        if os.path.normpath(os.path.join(directory, argument)) == source_file
+                        else argument
+                    )
+                    for argument in arguments
+                ]
+                entry["file"] = scratch
+        except (OSError, ValueError, KeyError, TypeError, AttributeError):
+            self._link(source, target)
+            return
+        target.parent.mkdir(parents=True, exist_ok=True)
+        target.write_text(json.dumps(entries, indent=2), encoding="utf-8")
+
+    def compile_database(self, path: Union[str, Path]) -> Path:
+        """
+        Rewrite a configured compilation database for the staged files.
+
+        Args:
+            path: compile_commands.json, or the directory holding it
+
+        Returns:
+            Path of the same kind (file or directory) to the rewritten copy
+        """
+        path = Path(path)
+        source = path / "compile_commands.json" if path.is_dir() else path
+        target = self._scratch / "compile-db" / "compile_commands.json"
+        self._write_compile_database(source.resolve(), target)
+        return target.parent if path.is_dir() else target
+
+    @property
+    def files(self) -> List[Path]:
+        """Scratch paths of the staged files, in diff order."""
+        return [Path(p) for p in self._files]
+
+    @property
+    def line_ranges(self) -> Dict[str, List[LineRange]]:
+        """Changed line ranges by scratch path."""
+        return {path: staged.line_ranges for path, staged in self._files.items()}
+
+    def repo_path(self, path: Union[str, Path]) -> Optional[Path]:
+        """
+        Map a scratch path back to the working tree.
+
+        Paths through links are not resolved first, so a linked header maps
+        to its working tree path (and is then outside the changed files);
+        working tree paths are kept.
+
+        Args:
+            path: Path reported by a validator
+
+        Returns:
+            Working tree path, or None if the path is outside both trees
+        """
+        candidates = [Path(os.path.abspath(path))]
+        try:
+            candidates.append(Path(path).resolve())
+        except OSError:
+            pass
+        for candidate in candidates:
+            for root in (self.root, self.repo_root):
+                try:
+                    return self.repo_root / candidate.relative_to(root)
+                except ValueError:
+                    continue
+        return None
+
+    def remap(
+        self, results: List[ValidationResult], changed_lines_only: bool = True
+    ) -> List[ValidationResult]:
+        """
+        Rewrite validator results to repository paths.
+
+        Args:
+            results: Results from validating the scratch tree
+            changed_lines_only: Drop line-level issues outside changed lines
+
+        Returns:
+            Results with working tree paths
+        """
+        indexes = {
+            self.repo_path(path): LineRangeIndex(ranges)
+            for path, ranges in self.line_ranges.items()
+        }
+        return scope_results(results, indexes, self.repo_path, changed_lines_only)
+
+    def cleanup(self) -> None:
+        """Remove the scratch directory; links are removed, not followed."""
+        shutil.rmtree(self._scratch, ignore_errors=True)
+
+    def __enter__(self) -> "StagedTree":
+        """Enter the context."""
+        return self
+
+    def __exit__(self, *exc_info) -> None:
+        """Remove the scratch directory on exit."""
+        self.cleanup()
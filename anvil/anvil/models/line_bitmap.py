@@ -0,0 +1,283 @@
+"""
+Compact sets of source line numbers.
+
+Coverage reports for large C++ code bases list millions of executable lines.
+LineBitmap keeps a file's lines as the bits of one Python integer, so union,
+intersection and difference between coverage runs are single big-integer
+operations, and serializes them run-length encoded: consecutive lines (the
+common case for both hit and missed code) cost a couple of bytes per run.
+
+The encoding is a sequence of unsigned LEB128 varints alternating gap and run
+lengths, starting at line 0: lines {3, 4, 5, 9} encode as 3, 3, 3, 1.
+"""
+
+from typing import Iterable, Iterator, List, Optional, Tuple, Union
+
+# Set bit offsets of every byte value, for iterating a bitmap byte by byte
+_BYTE_BITS = tuple(tuple(bit for bit in range(8) if value >> bit & 1) for value in range(256))
+
+
+if hasattr(int, "bit_count"):
+    _popcount = int.bit_count
+else:
+
+    def _popcount(bits: int) -> int:
+        """Count set bits (int.bit_count needs Python 3.10)."""
+        return bin(bits).count("1")
+
+
+class LineBitmapBuilder:
+    """
+    Accumulates line numbers into a bytearray before building a LineBitmap.
+
+    Setting bits in a mutable buffer keeps building linear in the number of
+    lines; or-ing them into an integer one at a time would copy it per line.
+    """
+
+    def __init__(self):
+        """Create an empty builder."""
+        self._buffer = bytearray()
+
+    def _reserve(self, line: int) -> None:
+        """Grow the buffer so it can hold the given line."""
+        if line < 0:
+            raise ValueError(f"Line numbers must not be negative: {line}")
+        needed = (line >> 3) + 1
+        if needed > len(self._buffer):
+            self._buffer.extend(bytes(max(needed - len(self._buffer), len(self._buffer))))
+
+    def add(self, line: int) -> None:
+        """
+        Add one line.
+
+        Args:
+            line: Non-negative line number
+        """
+        self._reserve(line)
+        self._buffer[line >> 3] |= 1 << (line & 7)
+
+    def add_range(self, start: int, end: int) -> None:
+        """
+        Add an inclusive range of lines, whole bytes at a time.
+
+        Args:
+            start: First line (non-negative)
+            end: Last line (ranges with end < start are empty)
+        """
+        if end < start:
+            return
+        self._reserve(start)
+        self._reserve(end)
+        first, last = start >> 3, end >> 3
+        if first == last:
+            self._buffer[first] |= (0xFF << (start & 7)) & (0xFF >> (7 - (end & 7)))
+            return
+        self._buffer[first] |= (0xFF << (start & 7)) & 0xFF
+        self._buffer[first + 1 : last] = b"\xff" * (last - first - 1)
+        self._buffer[last] |= 0xFF >> (7 - (end & 7))
+
+    def build(self) -> "LineBitmap":
+        """Build the bitmap of all lines added so far."""
+        return LineBitmap._from_bits(int.from_bytes(self._buffer, "little"))
+
+
+class LineBitmap:
+    """
+    Immutable set of line numbers backed by an integer bitset.
+
+    Compares equal to lists, tuples and sets of the same lines and supports
+    len, membership, sorted iteration and indexing, so code written against
+    plain line lists keeps working.
+
+    Args:
+        lines: Non-negative line numbers, in any order
+    """
+
+    __slots__ = ("_bits",)
+
+    def __init__(self, lines: Iterable[int] = ()):
+        """Build a bitmap from line numbers."""
+        if isinstance(lines, LineBitmap):
+            self._bits = lines._bits
+            return
+        builder = LineBitmapBuilder()
+        for line in lines:
+            builder.add(line)
+        self._bits = builder.build()._bits
+
+    @classmethod
+    def _from_bits(cls, bits: int) -> "LineBitmap":
+        """Wrap an integer bitset without copying."""
+        bitmap = cls.__new__(cls)
+        bitmap._bits = bits
+        return bitmap
+
+    @classmethod
+    def from_ranges(cls, ranges: Iterable[Tuple[int, int]]) -> "LineBitmap":
+        """
+        Build a bitmap from inclusive line ranges.
+
+        Args:
+            ranges: (start, end) pairs, in any order
+
+        Returns:
+            LineBitmap of every line in the ranges
+        """
+        builder = LineBitmapBuilder()
+        for start, end in ranges:
+            builder.add_range(start, end)
+        return builder.build()
+
+    @classmethod
+    def from_rle(cls, data: bytes) -> "LineBitmap":
+        """
+        Decode a bitmap written by to_rle().
+
+        Args:
+            data: Run-length encoded bytes
+
+        Returns:
+            Decoded LineBitmap
+
+        Raises:
+            ValueError: If the data ends inside a varint
+        """
+        builder = LineBitmapBuilder()
+        position = value = shift = 0
+        in_run = False
+        for byte in data:
+            value |= (byte & 0x7F) << shift
+            if byte & 0x80:
+                shift += 7
+                continue
+            if in_run:
+                builder.add_range(position, position + value - 1)
+            position += value
+            in_run = not in_run
+            value = shift = 0
+        if shift:
+            raise ValueError("Truncated line bitmap encoding")
+        return builder.build()
+
+    def to_rle(self) -> bytes:
+        """
+        Encode the bitmap as alternating gap and run length varints.
+
+        Returns:
+            Run-length encoded bytes (empty for an empty bitmap)
+        """
+        out = bytearray()
+        position = 0
+        for start, end in self.ranges():
+            for value in (start - position, end - start + 1):
+                while value > 0x7F:
+                    out.append(value & 0x7F | 0x80)
+                    value >>= 7
+                out.append(value)
+            position = end + 1
+        return bytes(out)
+
+    def ranges(self) -> List[Tuple[int, int]]:
+        """
+        Get the bitmap as maximal runs of consecutive lines.
+
+        Returns:
+            Inclusive (start, end) pairs in line order
+        """
+        # A run starts at a set bit whose lower neighbour is clear and ends at
+        # one whose upper neighbour is clear; only those bits are visited
+        bits = self._bits
+        starts = LineBitmap._from_bits(bits & ~(bits << 1))
+        ends = LineBitmap._from_bits(bits & ~(bits >> 1))
+        return list(zip(starts, ends))
+
+    def max(self) -> int:
+        """
+        Get the highest line.
+
+        Returns:
+            Largest line number
+
+        Raises:
+            ValueError: If the bitmap is empty
+        """
+        if not self._bits:
+            raise ValueError("max() of an empty LineBitmap")
+        return self._bits.bit_length() - 1
+
+    def __iter__(self) -> Iterator[int]:
+        """Iterate lines in ascending order."""
+        bits = self._bits
+        data = bits.to_bytes((bits.bit_length() + 7) >> 3, "little")
+        for index, byte in enumerate(data):
+            if byte:
+                base = index << 3
+                for bit in _BYTE_BITS[byte]:
+                    yield base + bit
+
+    def __len__(self) -> int:
+        """Number of lines."""
+        return _popcount(self._bits)
+
+    def __bool__(self) -> bool:
+        """Whether any line is set."""
+        return self._bits != 0
+
+    def __contains__(self, line: object) -> bool:
+        """Check whether a line is set."""
+        return isinstance(line, int) and line >= 0 and bool(self._bits >> line & 1)
+
+    def __getitem__(self, index: Union[int, slice]) -> Union[int, List[int]]:
+        """Get the n-th line, or a list of lines for a slice."""
+        return list(self)[index]
+
+    def __eq__(self, other: object) -> bool:
+        """Compare with another bitmap or a collection of line numbers."""
+        if isinstance(other, LineBitmap):
+            return self._bits == other._bits
+        if isinstance(other, (list, tuple, set, frozenset, range)):
+            try:
+                return self._bits == LineBitmap(other)._bits and len(self) == len(other)
+            except (TypeError, ValueError):
+                return False
+        return NotImplemented
+
+    def __hash__(self) -> int:
+        """Hash by contents."""
+        return hash(self._bits)
+
+    def __and__(self, other: "LineBitmap") -> "LineBitmap":
+        """Lines in both bitmaps."""
+        return LineBitmap._from_bits(self._bits & other._bits)
+
+    def __or__(self, other: "LineBitmap") -> "LineBitmap":
+        """Lines in either bitmap."""
+        return LineBitmap._from_bits(self._bits | other._bits)
+
+    def __sub__(self, other: "LineBitmap") -> "LineBitmap":
+        """Lines in this bitmap but not the other."""
+        return LineBitmap._from_bits(self._bits & ~other._bits)
+
+    def __xor__(self, other: "LineBitmap") -> "LineBitmap":
+        """Lines in exactly one of the bitmaps."""
+        return LineBitmap._from_bits(self._bits ^ other._bits)
+
+    def __repr__(self) -> str:
+        """Show the runs of lines."""
+        runs = ", ".join(str(s) if s == e else f"{s}-{e}" for s, e in self.ranges())
+        return f"LineBitmap({runs})"
+
+
+def coerce_line_bitmap(lines: Optional[Iterable[int]]) -> Optional[LineBitmap]:
+    """
+    Convert a line collection to a LineBitmap, keeping None.
+
+    Args:
+        lines: Line numbers, a LineBitmap or None
+
+    Returns:
+        LineBitmap, or None when lines is None
+    """
+    if lines is None or isinstance(lines, LineBitmap):
+        return lines
+    return LineBitmap(lines)
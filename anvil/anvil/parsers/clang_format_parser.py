@@ -181,6 +181,12 @@ class ClangFormatParser:
         if options.get("werror", True):
             cmd.append("--Werror")
 
+        # Restrict to changed lines (clang-format accepts --lines for one file)
+        line_ranges = options.get("line_ranges") or {}
+        if len(files) == 1:
+            for start, end in line_ranges.get(str(files[0]), []):
+                cmd.append(f"--lines={start}:{end}")
+
         # Add files
         cmd.extend(files)
 
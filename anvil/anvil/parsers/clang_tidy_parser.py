@@ -4,6 +4,7 @@ Parser for clang-tidy YAML output.
 Parses YAML diagnostic output from clang-tidy with fix suggestions.
 """
 
+import json
 import re
 import subprocess
 from pathlib import Path
@@ -225,6 +226,28 @@ class ClangTidyParser:
         except yaml.YAMLError:
             return 0
 
+    @staticmethod
+    def _line_filter_entry(file: Path, line_ranges: Dict[str, Any]) -> Dict[str, Any]:
+        """Build the --line-filter entry for one file."""
+        return {"name": str(file), "lines": [list(r) for r in line_ranges[str(file)]]}
+
+    @staticmethod
+    def line_filter_length(file: Path, config: Dict[str, Any]) -> int:
+        """
+        Get the bytes one file adds to the --line-filter argument.
+
+        Args:
+            file: File to analyze
+            config: Configuration dictionary with optional line_ranges
+
+        Returns:
+            Length of the file's filter entry and separator (0 without ranges)
+        """
+        line_ranges = config.get("line_ranges") or {}
+        if str(file) not in line_ranges:
+            return 0
+        return len(json.dumps(ClangTidyParser._line_filter_entry(file, line_ranges))) + 2
+
     @staticmethod
     def build_command(
         files: List[Path],
@@ -261,6 +284,16 @@ class ClangTidyParser:
         if "compile_commands" in config:
             command.append(f"-p={config['compile_commands']}")
 
+        # Report only diagnostics on changed lines
+        line_ranges = config.get("line_ranges") or {}
+        line_filter = [
+            ClangTidyParser._line_filter_entry(file, line_ranges)
+            for file in files
+            if str(file) in line_ranges
+        ]
+        if line_filter:
+            command.append(f"--line-filter={json.dumps(line_filter)}")
+
         # Add files
         for file in files:
             command.append(str(file))
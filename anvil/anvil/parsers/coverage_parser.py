@@ -1,14 +1,37 @@
 """
-Coverage parser for pytest-cov XML output.
+Coverage parser for Cobertura XML, lcov and llvm-cov export output.
 
-This module provides functionality to parse coverage.xml files generated by
-pytest-cov and extract coverage metrics for storage in the Anvil database.
+This module provides functionality to parse coverage reports (pytest-cov
+coverage.xml, gcovr --xml, lcov .info tracefiles and `llvm-cov export`
+JSON) and extract coverage metrics for storage in the Anvil database.
+
+Reports are read as streams, one file record at a time, so memory use
+depends on the number of files rather than the size of the report. Per-file
+covered and missing lines are kept as LineBitmap sets, which makes comparing
+two runs a handful of bitmap operations per file.
 """
 
+import json
+import re
 import xml.etree.ElementTree as ET
 from dataclasses import dataclass
 from pathlib import Path
-from typing import Dict, List
+from typing import IO, Any, Dict, Iterator, List, Optional
+
+from anvil.models.line_bitmap import LineBitmap, LineBitmapBuilder, coerce_line_bitmap
+
+COVERAGE_FORMATS = ("cobertura", "lcov", "llvm-cov")
+
+# Characters read per chunk when streaming llvm-cov JSON
+_JSON_CHUNK_SIZE = 1 << 20
+
+# Start of a "files" array in llvm-cov export output
+_LLVM_FILES_KEY = re.compile(r'"files"\s*:\s*\[')
+
+
+def _percentage(covered: int, total: int) -> float:
+    """Coverage percentage, 0.0 for files without executable lines."""
+    return covered * 100.0 / total if total else 0.0
 
 
 @dataclass
@@ -21,14 +44,62 @@ class FileCoverage:
         total_statements: Total number of executable statements
         covered_statements: Number of covered statements
         coverage_percentage: Coverage percentage (0.0-100.0)
-        missing_lines: List of uncovered line numbers
+        missing_lines: Uncovered line numbers (lists are converted)
+        covered_lines: Covered line numbers, when the report lists them
     """
 
     file_path: str
     total_statements: int
     covered_statements: int
     coverage_percentage: float
-    missing_lines: List[int]
+    missing_lines: LineBitmap
+    covered_lines: Optional[LineBitmap] = None
+
+    def __post_init__(self):
+        """Store line collections as bitmaps."""
+        self.missing_lines = coerce_line_bitmap(self.missing_lines)
+        self.covered_lines = coerce_line_bitmap(self.covered_lines)
+
+    @classmethod
+    def from_lines(
+        cls,
+        file_path: str,
+        executable: LineBitmap,
+        covered: LineBitmap,
+        coverage_percentage: Optional[float] = None,
+    ) -> "FileCoverage":
+        """
+        Build file coverage from executable and covered line bitmaps.
+
+        Args:
+            file_path: Path to the file
+            executable: Lines with code
+            covered: Lines executed at least once
+            coverage_percentage: Reported percentage (computed if omitted)
+
+        Returns:
+            FileCoverage with counts derived from the bitmaps
+        """
+        covered = covered & executable
+        total, hit = len(executable), len(covered)
+        if coverage_percentage is None:
+            coverage_percentage = _percentage(hit, total)
+        return cls(file_path, total, hit, coverage_percentage, executable - covered, covered)
+
+    def merge(self, other: "FileCoverage") -> "FileCoverage":
+        """
+        Combine two records for the same file, e.g. a header seen by several
+        translation units; a line is covered if either record covers it.
+
+        Args:
+            other: Coverage of the same file
+
+        Returns:
+            Merged FileCoverage
+        """
+        covered = (self.covered_lines or LineBitmap()) | (other.covered_lines or LineBitmap())
+        executable = self.missing_lines | other.missing_lines | covered
+        return FileCoverage.from_lines(self.file_path, executable, covered)
 
 
 @dataclass
@@ -51,17 +122,212 @@ class CoverageData:
     file_coverage: List[FileCoverage]
 
 
+def detect_coverage_format(path: str) -> str:
+    """
+    Detect a coverage report's format from its first characters.
+
+    Args:
+        path: Path to the report
+
+    Returns:
+        One of COVERAGE_FORMATS
+    """
+    with open(path, "r", encoding="utf-8", errors="replace") as f:
+        head = f.read(4096).lstrip("\ufeff \t\r\n")
+    if head.startswith("<"):
+        return "cobertura"
+    if head.startswith("{"):
+        return "llvm-cov"
+    return "lcov"
+
+
+def _llvm_line_coverage(segments: List[List[Any]], executable, covered) -> None:
+    """
+    Convert llvm-cov region segments to line coverage.
+
+    Follows llvm-cov's own line statistics: a line is executable when a
+    counted region starts on it or a counted region wraps over it from an
+    earlier line, and its count is the highest count of those regions.
+
+    Args:
+        segments: [line, col, count, has_count, is_region_entry, is_gap] lists,
+            sorted by position
+        executable: LineBitmapBuilder receiving executable lines
+        covered: LineBitmapBuilder receiving executed lines
+    """
+    wrapped = None
+    i, n = 0, len(segments)
+    while i < n:
+        line = segments[i][0]
+        starts = []
+        while i < n and segments[i][0] == line:
+            starts.append(segments[i])
+            i += 1
+
+        entries = [s for s in starts if s[3] and s[4] and not (len(s) > 5 and s[5])]
+        skipped = not starts[0][3] and starts[0][4]
+        if not skipped and (entries or (wrapped is not None and wrapped[3])):
+            count = wrapped[2] if wrapped is not None else 0
+            for segment in entries:
+                count = max(count, segment[2])
+            executable.add(line)
+            if count > 0:
+                covered.add(line)
+
+        # Lines up to the next segment are covered by the last one on this line
+        wrapped = starts[-1]
+        if i < n and wrapped[3]:
+            executable.add_range(line + 1, segments[i][0] - 1)
+            if wrapped[2] > 0:
+                covered.add_range(line + 1, segments[i][0] - 1)
+
+
+def _iter_json_array_items(stream: IO[str], key_pattern: "re.Pattern") -> Iterator[Any]:
+    """
+    Decode the items of every JSON array whose key matches a pattern.
+
+    Items are decoded one at a time from a sliding buffer, so only one item
+    and one read chunk are held in memory at once.
+
+    Args:
+        stream: Text stream positioned at the start of the document
+        key_pattern: Regex matching a key up to and including its "["
+
+    Yields:
+        Decoded array items
+
+    Raises:
+        json.JSONDecodeError: If an item is malformed or truncated
+    """
+    decoder = json.JSONDecoder()
+    buffer, position, eof = "", 0, False
+
+    def fill(size: int) -> None:
+        nonlocal buffer, position, eof
+        chunk = stream.read(size)
+        eof = not chunk
+        buffer, position = buffer[position:] + chunk, 0
+
+    while True:
+        match = key_pattern.search(buffer, position)
+        if match is None:
+            if eof:
+                return
+            # Keep a tail in case the key is split across chunks
+            position = max(position, len(buffer) - 64)
+            fill(_JSON_CHUNK_SIZE)
+            continue
+
+        position = match.end()
+        while True:
+            while position < len(buffer) and buffer[position] in " \t\r\n,":
+                position += 1
+            if position == len(buffer):
+                if eof:
+                    raise json.JSONDecodeError("Unterminated array", buffer, position)
+                fill(_JSON_CHUNK_SIZE)
+                continue
+            if buffer[position] == "]":
+                position += 1
+                break
+            try:
+                item, end = decoder.raw_decode(buffer, position)
+            except json.JSONDecodeError:
+                if eof:
+                    raise
+                # Grow geometrically so a large item is not re-decoded per chunk
+                fill(max(_JSON_CHUNK_SIZE, len(buffer) - position))
+                continue
+            position = end
+            yield item
+
+
 class CoverageParser:
     """
-    Parse pytest-cov coverage.xml output.
+    Parse coverage reports.
 
     Examples:
         >>> parser = CoverageParser()
         >>> data = parser.parse_coverage_xml("coverage.xml")
         >>> print(f"Total coverage: {data.total_coverage:.2f}%")
         Total coverage: 94.50%
+        >>> data = parser.parse("build/coverage.info")  # format detected
     """
 
+    def parse(self, path: str, format: Optional[str] = None) -> CoverageData:
+        """
+        Parse a coverage report, merging repeated records of the same file.
+
+        Args:
+            path: Path to the report
+            format: One of COVERAGE_FORMATS (detected when omitted)
+
+        Returns:
+            CoverageData instance with parsed coverage information
+
+        Raises:
+            FileNotFoundError: If the report doesn't exist
+            ValueError: For an unknown format
+            ET.ParseError: If Cobertura XML is malformed
+            json.JSONDecodeError: If llvm-cov JSON is malformed
+        """
+        report: Dict[str, float] = {}
+        files: Dict[str, FileCoverage] = {}
+        for file_coverage in self._iter_files(path, format, report):
+            existing = files.get(file_coverage.file_path)
+            files[file_coverage.file_path] = (
+                file_coverage if existing is None else existing.merge(file_coverage)
+            )
+
+        total_statements = sum(fc.total_statements for fc in files.values())
+        covered_statements = sum(fc.covered_statements for fc in files.values())
+        if "line_rate" in report:
+            total_coverage = report["line_rate"] * 100.0
+        else:
+            total_coverage = _percentage(covered_statements, total_statements)
+
+        return CoverageData(
+            total_coverage=total_coverage,
+            files_analyzed=len(files),
+            total_statements=total_statements,
+            covered_statements=covered_statements,
+            file_coverage=list(files.values()),
+        )
+
+    def iter_file_coverage(self, path: str, format: Optional[str] = None) -> Iterator[FileCoverage]:
+        """
+        Stream per-file coverage records from a report.
+
+        A file can appear in more than one record (lcov tracefiles and
+        llvm-cov exports list headers once per translation unit); parse()
+        merges them.
+
+        Args:
+            path: Path to the report
+            format: One of COVERAGE_FORMATS (detected when omitted)
+
+        Yields:
+            FileCoverage per file record
+        """
+        return self._iter_files(path, format, {})
+
+    def _iter_files(
+        self, path: str, format: Optional[str], report: Dict[str, float]
+    ) -> Iterator[FileCoverage]:
+        """Check the report exists and dispatch to the format's reader."""
+        if not Path(path).exists():
+            raise FileNotFoundError(f"Coverage file not found: {path}")
+        format = format or detect_coverage_format(path)
+        if format == "cobertura":
+            return self._iter_cobertura(path, report)
+        if format == "lcov":
+            return self._iter_lcov(path)
+        if format == "llvm-cov":
+            return self._iter_llvm_cov(path)
+        raise ValueError(
+            f"Unknown coverage format '{format}' (expected {', '.join(COVERAGE_FORMATS)})"
+        )
+
     def parse_coverage_xml(self, xml_path: str) -> CoverageData:
         """
         Parse coverage.xml file generated by pytest-cov.
@@ -92,62 +358,121 @@ class CoverageParser:
             FileNotFoundError: If XML file doesn't exist
             ET.ParseError: If XML is malformed
         """
-        xml_path_obj = Path(xml_path)
-        if not xml_path_obj.exists():
-            raise FileNotFoundError(f"Coverage file not found: {xml_path}")
-
-        tree = ET.parse(xml_path)
-        root = tree.getroot()
-
-        # Extract overall coverage from root element
-        line_rate = float(root.attrib.get("line-rate", "0"))
-        total_coverage = line_rate * 100.0
-
-        # Parse per-file coverage
-        file_coverage_list = []
-        total_statements_all = 0
-        covered_statements_all = 0
-
-        # Iterate through all packages and classes
-        for package in root.findall(".//package"):
-            for class_elem in package.findall(".//class"):
-                file_path = class_elem.attrib.get("filename", "")
-                class_line_rate = float(class_elem.attrib.get("line-rate", "0"))
-
-                # Count statements and covered lines
-                lines = class_elem.findall(".//line")
-                total_statements = len(lines)
-                covered_statements = sum(
-                    1 for line in lines if int(line.attrib.get("hits", "0")) > 0
-                )
-                missing_lines = [
-                    int(line.attrib.get("number"))
-                    for line in lines
-                    if int(line.attrib.get("hits", "0")) == 0
-                ]
-
-                coverage_percentage = class_line_rate * 100.0
-
-                file_coverage_list.append(
-                    FileCoverage(
-                        file_path=file_path,
-                        total_statements=total_statements,
-                        covered_statements=covered_statements,
-                        coverage_percentage=coverage_percentage,
-                        missing_lines=missing_lines,
-                    )
+        return self.parse(xml_path, "cobertura")
+
+    def parse_lcov(self, info_path: str) -> CoverageData:
+        """
+        Parse an lcov tracefile (e.g. `lcov --capture` or `llvm-cov export
+        -format=lcov` output).
+
+        Args:
+            info_path: Path to the .info file
+
+        Returns:
+            CoverageData instance with parsed coverage information
+
+        Raises:
+            FileNotFoundError: If the file doesn't exist
+        """
+        return self.parse(info_path, "lcov")
+
+    def parse_llvm_cov_json(self, json_path: str) -> CoverageData:
+        """
+        Parse `llvm-cov export` JSON output.
+
+        Args:
+            json_path: Path to the JSON export
+
+        Returns:
+            CoverageData instance with parsed coverage information
+
+        Raises:
+            FileNotFoundError: If the file doesn't exist
+            json.JSONDecodeError: If the JSON is malformed
+        """
+        return self.parse(json_path, "llvm-cov")
+
+    def _iter_cobertura(self, path: str, report: Dict[str, float]) -> Iterator[FileCoverage]:
+        """
+        Stream <class> elements of a Cobertura report.
+
+        Elements are cleared as soon as they are read, so the tree never
+        holds more than the current class. Lines listed again under <methods>
+        are only counted once.
+        """
+        executable = covered = None
+        for event, elem in ET.iterparse(path, events=("start", "end")):
+            tag = elem.tag
+            if event == "start":
+                if tag == "coverage":
+                    report["line_rate"] = float(elem.attrib.get("line-rate", "0"))
+                elif tag == "class":
+                    executable, covered = LineBitmapBuilder(), LineBitmapBuilder()
+                continue
+
+            if tag == "line":
+                if executable is not None:
+                    number = int(elem.attrib.get("number"))
+                    executable.add(number)
+                    if int(elem.attrib.get("hits", "0")) > 0:
+                        covered.add(number)
+                elem.clear()
+            elif tag == "class":
+                yield FileCoverage.from_lines(
+                    elem.attrib.get("filename", ""),
+                    executable.build(),
+                    covered.build(),
+                    float(elem.attrib.get("line-rate", "0")) * 100.0,
                 )
+                executable = covered = None
+                elem.clear()
+            elif tag == "package":
+                elem.clear()
 
-                total_statements_all += total_statements
-                covered_statements_all += covered_statements
+    def _iter_lcov(self, path: str) -> Iterator[FileCoverage]:
+        """
+        Stream SF ... end_of_record blocks of an lcov tracefile.
 
-        return CoverageData(
-            total_coverage=total_coverage,
-            files_analyzed=len(file_coverage_list),
-            total_statements=total_statements_all,
-            covered_statements=covered_statements_all,
-            file_coverage=file_coverage_list,
-        )
+        Only DA (line hit) records are used; function and branch records are
+        skipped.
+        """
+        file_path = None
+        executable = covered = None
+        with open(path, "r", encoding="utf-8", errors="surrogateescape") as f:
+            for line in f:
+                if line.startswith("DA:"):
+                    if executable is None:
+                        continue
+                    number, hits = line[3:].split(",", 2)[:2]
+                    executable.add(int(number))
+                    # Some tools write fractional or negative counts
+                    if float(hits) > 0:
+                        covered.add(int(number))
+                elif line.startswith("SF:"):
+                    file_path = line[3:].rstrip("\r\n")
+                    executable, covered = LineBitmapBuilder(), LineBitmapBuilder()
+                elif line.startswith("end_of_record") and executable is not None:
+                    yield FileCoverage.from_lines(file_path, executable.build(), covered.build())
+                    executable = covered = None
+
+        # Tolerate a final record without end_of_record
+        if executable is not None:
+            yield FileCoverage.from_lines(file_path, executable.build(), covered.build())
+
+    def _iter_llvm_cov(self, path: str) -> Iterator[FileCoverage]:
+        """
+        Stream file objects of an `llvm-cov export` JSON document.
+
+        Each "files" entry is decoded on its own; the much larger
+        "functions" arrays are scanned past without being decoded.
+        """
+        with open(path, "r", encoding="utf-8") as f:
+            for item in _iter_json_array_items(f, _LLVM_FILES_KEY):
+                executable, covered = LineBitmapBuilder(), LineBitmapBuilder()
+                _llvm_line_coverage(item.get("segments", []), executable, covered)
+                yield FileCoverage.from_lines(
+                    item.get("filename", ""), executable.build(), covered.build()
+                )
 
     def calculate_coverage_diff(
         self, current: CoverageData, baseline: CoverageData
@@ -155,6 +480,10 @@ class CoverageParser:
         """
         Calculate coverage changes between two coverage runs.
 
+        Line counts come from bitmap operations on files present in both
+        runs: a line is newly covered if it was missing in the baseline and is
+        covered now, and newly uncovered the other way round.
+
         Args:
             current: Current coverage data
             baseline: Baseline coverage data to compare against
@@ -166,6 +495,8 @@ class CoverageParser:
             - files_regressed: Number of files with decreased coverage
             - new_files: Number of files added
             - removed_files: Number of files removed
+            - lines_newly_covered: Lines missing before and covered now
+            - lines_newly_uncovered: Lines covered before and missing now
         """
         # Create file path to coverage mapping
         current_files = {fc.file_path: fc for fc in current.file_coverage}
@@ -173,27 +504,41 @@ class CoverageParser:
 
         files_improved = 0
         files_regressed = 0
+        lines_newly_covered = 0
+        lines_newly_uncovered = 0
         new_files = set(current_files.keys()) - set(baseline_files.keys())
         removed_files = set(baseline_files.keys()) - set(current_files.keys())
 
         # Compare common files
         for file_path in set(current_files.keys()) & set(baseline_files.keys()):
-            current_cov = current_files[file_path].coverage_percentage
-            baseline_cov = baseline_files[file_path].coverage_percentage
+            current_fc = current_files[file_path]
+            baseline_fc = baseline_files[file_path]
 
-            if current_cov > baseline_cov:
+            if current_fc.coverage_percentage > baseline_fc.coverage_percentage:
                 files_improved += 1
-            elif current_cov < baseline_cov:
+            elif current_fc.coverage_percentage < baseline_fc.coverage_percentage:
                 files_regressed += 1
 
+            lines_newly_covered += len(self._newly_covered(current_fc, baseline_fc))
+            lines_newly_uncovered += len(self._newly_covered(baseline_fc, current_fc))
+
         return {
             "total_coverage_diff": current.total_coverage - baseline.total_coverage,
             "files_improved": files_improved,
             "files_regressed": files_regressed,
             "new_files": len(new_files),
             "removed_files": len(removed_files),
+            "lines_newly_covered": lines_newly_covered,
+            "lines_newly_uncovered": lines_newly_uncovered,
         }
 
+    @staticmethod
+    def _newly_covered(current: FileCoverage, baseline: FileCoverage) -> LineBitmap:
+        """Lines covered in current that the baseline reported as missing."""
+        if current.covered_lines is None:
+            return LineBitmap()
+        return current.covered_lines & baseline.missing_lines
+
     def find_coverage_regressions(
         self, current: CoverageData, baseline: CoverageData, threshold: float = 1.0
     ) -> List[Dict[str, any]]:
@@ -211,6 +556,8 @@ class CoverageParser:
             - current_coverage: Current coverage percentage
             - baseline_coverage: Baseline coverage percentage
             - coverage_drop: Amount of coverage decrease
+            - newly_uncovered_lines: LineBitmap of lines covered in the
+              baseline and missing now
         """
         current_files = {fc.file_path: fc for fc in current.file_coverage}
         baseline_files = {fc.file_path: fc for fc in baseline.file_coverage}
@@ -219,17 +566,18 @@ class CoverageParser:
 
         # Check common files
         for file_path in set(current_files.keys()) & set(baseline_files.keys()):
-            current_cov = current_files[file_path].coverage_percentage
-            baseline_cov = baseline_files[file_path].coverage_percentage
-            coverage_drop = baseline_cov - current_cov
+            current_fc = current_files[file_path]
+            baseline_fc = baseline_files[file_path]
+            coverage_drop = baseline_fc.coverage_percentage - current_fc.coverage_percentage
 
             if coverage_drop >= threshold:
                 regressions.append(
                     {
                         "file_path": file_path,
-                        "current_coverage": current_cov,
-                        "baseline_coverage": baseline_cov,
+                        "current_coverage": current_fc.coverage_percentage,
+                        "baseline_coverage": baseline_fc.coverage_percentage,
                         "coverage_drop": coverage_drop,
+                        "newly_uncovered_lines": self._newly_covered(baseline_fc, current_fc),
                     }
                 )
 
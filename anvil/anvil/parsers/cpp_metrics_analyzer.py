@@ -0,0 +1,469 @@
+"""
+C++ function metrics analyzer.
+
+This module computes per-function metrics for C++ sources from a lightweight
+tokenizer instead of a compiler front end, so it needs no compile database
+or include paths and runs quickly over large trees:
+
+- Cyclomatic complexity: 1 + decision points (if, for, while, case, catch,
+  &&, ||, ?)
+- Nesting: deepest block nesting inside the function body
+- Length: lines from the function name to the closing brace
+- Fan-out: distinct functions called from the function
+- Fan-in: distinct analyzed functions that call the function (by name)
+
+Files are analyzed in parallel worker processes.
+"""
+
+import os
+import re
+from collections import defaultdict
+from concurrent.futures import ProcessPoolExecutor
+from dataclasses import asdict, dataclass, field
+from pathlib import Path
+from typing import Dict, List, Optional, Sequence, Set, Tuple
+
+# Files below this count are analyzed in-process; a pool costs more to start
+MIN_FILES_FOR_POOL = 16
+
+_TOKEN_RE = re.compile(
+    r"""
+    (?P<newline>\n)
+    | (?P<space>[ \t\r\f\v]+|\\\n)
+    | (?P<comment>//[^\n]*|/\*.*?\*/)
+    | (?P<preproc>^[ \t]*\#(?:[^\n\\]|\\.)*)
+    | (?P<raw>(?:u8|u|U|L)?R"(?P<delim>[^()\s"\\]{0,16})\(.*?\)(?P=delim)")
+    | (?P<string>(?:u8|u|U|L)?"(?:[^"\\\n]|\\.)*")
+    | (?P<char>(?:u8|u|U|L)?'(?:[^'\\\n]|\\.)*')
+    | (?P<ident>[A-Za-z_]\w*)
+    | (?P<number>\.?\d(?:[eEpP][+-]|[\w.'])*)
+    | (?P<op>::|->|&&|\|\||<<|>>|[^\s])
+    """,
+    re.VERBOSE | re.DOTALL | re.MULTILINE,
+)
+
+_IDENTIFIER_RE = re.compile(r"[A-Za-z_]\w*$")
+
+# Tokens that add a decision point to cyclomatic complexity
+_DECISION_TOKENS = frozenset({"if", "for", "while", "case", "catch", "&&", "||", "?", "and", "or"})
+
+# Keywords followed by '(' that are not function calls
+_NON_CALL_KEYWORDS = frozenset(
+    {
+        "alignas",
+        "alignof",
+        "catch",
+        "decltype",
+        "for",
+        "if",
+        "noexcept",
+        "operator",
+        "requires",
+        "return",
+        "sizeof",
+        "static_assert",
+        "switch",
+        "throw",
+        "typeid",
+        "while",
+    }
+)
+
+# Keywords that may directly precede a call expression
+_CALL_PREFIX_KEYWORDS = frozenset({"return", "else", "throw", "new", "co_await", "co_return"})
+
+# Statements whose blocks are never function bodies
+_CONTROL_KEYWORDS = frozenset({"if", "for", "while", "switch", "catch", "do", "else", "try"})
+
+# Tokens that may directly follow a function's parameter list
+_FUNCTION_TAIL_TOKENS = frozenset(
+    {
+        ":",
+        "->",
+        "&",
+        "&&",
+        "const",
+        "final",
+        "mutable",
+        "noexcept",
+        "override",
+        "throw",
+        "try",
+        "volatile",
+    }
+)
+
+_TYPE_KEYWORDS = frozenset({"class", "struct", "union"})
+
+
+@dataclass
+class FunctionMetrics:
+    """
+    Metrics for a single C++ function.
+
+    Attributes:
+        name: Qualified function name (e.g., "ns::Class::method")
+        line: Line of the function name
+        end_line: Line of the closing brace
+        complexity: Cyclomatic complexity
+        max_nesting: Deepest block nesting inside the body (flat body = 0)
+        length: Lines from the function name to the closing brace
+        fan_out: Number of distinct functions called
+        fan_in: Number of distinct analyzed functions calling this one
+        calls: Sorted names of called functions
+    """
+
+    name: str
+    line: int
+    end_line: int
+    complexity: int = 1
+    max_nesting: int = 0
+    length: int = 1
+    fan_out: int = 0
+    fan_in: int = 0
+    calls: List[str] = field(default_factory=list)
+
+    @property
+    def short_name(self) -> str:
+        """Unqualified function name, used to match call sites."""
+        return self.name.rsplit("::", 1)[-1]
+
+    def to_dict(self) -> Dict:
+        """
+        Convert to a JSON-serializable dictionary.
+
+        Returns:
+            Dictionary of all metrics
+        """
+        return asdict(self)
+
+
+def tokenize(source: str) -> List[Tuple[str, int]]:
+    """
+    Split C++ source into code tokens with line numbers.
+
+    Comments and preprocessor directives are dropped and string and
+    character literals become a single '""' token, so braces and keywords
+    inside them never affect the analysis.
+
+    Args:
+        source: C++ source code
+
+    Returns:
+        List of (token, line) tuples
+    """
+    tokens = []
+    line = 1
+    for match in _TOKEN_RE.finditer(source):
+        kind = match.lastgroup
+        if kind == "newline":
+            line += 1
+            continue
+        text = match.group()
+        if kind in ("ident", "number", "op"):
+            tokens.append((text, line))
+        elif kind in ("raw", "string", "char"):
+            tokens.append(('""', line))
+        line += text.count("\n")
+    return tokens
+
+
+def _matching_paren(head: List[Tuple[str, int]], open_index: int) -> Optional[int]:
+    """Find the index of the ')' closing the '(' at open_index."""
+    depth = 0
+    for i in range(open_index, len(head)):
+        if head[i][0] == "(":
+            depth += 1
+        elif head[i][0] == ")":
+            depth -= 1
+            if depth == 0:
+                return i
+    return None
+
+
+def _function_name(head: List[Tuple[str, int]]) -> Optional[Tuple[str, int]]:
+    """
+    Decide whether a block head is a function definition and find its name.
+
+    Args:
+        head: Tokens between the previous statement boundary and '{'
+
+    Returns:
+        Tuple of (name, line) if the head defines a function, else None
+    """
+    if not head or head[0][0] in _CONTROL_KEYWORDS:
+        return None
+
+    angle = paren = 0
+    for i, (text, line) in enumerate(head):
+        prev = head[i - 1][0] if i else ""
+        if text == "(" and paren == 0 and angle == 0 and i:
+            before = head[i - 2][0] if i >= 2 else ""
+            if prev == "operator":
+                # operator()(...): the parameter list follows the name's "()"
+                name, name_index = "operator()", i - 1
+                params = _matching_paren(head, i)
+                if params is None or params + 1 >= len(head) or head[params + 1][0] != "(":
+                    return None
+                i = params + 1
+            elif before == "operator":
+                name, name_index = f"operator{prev}", i - 2
+            elif _IDENTIFIER_RE.match(prev) and prev not in _NON_CALL_KEYWORDS:
+                name, name_index = prev, i - 1
+            else:
+                return None
+
+            # Qualified names (a::b::name) and destructors (~T)
+            if name_index >= 1 and head[name_index - 1][0] == "~":
+                name_index -= 1
+                name = f"~{name}"
+            while name_index >= 2 and head[name_index - 1][0] == "::":
+                name_index -= 2
+                name = f"{head[name_index][0]}::{name}"
+
+            close = _matching_paren(head, i)
+            if close is None:
+                return None
+            if close + 1 < len(head) and head[close + 1][0] not in _FUNCTION_TAIL_TOKENS:
+                return None
+            return name, head[name_index][1]
+
+        if text == "(":
+            paren += 1
+        elif text == ")":
+            paren -= 1
+        elif paren:
+            continue
+        elif text == "<" and prev != "operator":
+            angle += 1
+        elif text == ">" and angle:
+            angle -= 1
+        elif text == ">>" and angle:
+            angle = max(0, angle - 2)
+        elif angle == 0 and prev != "operator":
+            # Aggregates, lambdas and type definitions are not functions
+            if text == "=" or text in _TYPE_KEYWORDS or text in ("enum", "namespace"):
+                return None
+    return None
+
+
+def _in_initializer_list(head: List[Tuple[str, int]]) -> bool:
+    """
+    Check whether a '{' after this head opens a brace member initializer.
+
+    Constructor heads like ``Foo() : a_{1}, b_{2} {`` contain braces that
+    open member initializers rather than the body.
+
+    Args:
+        head: Tokens before the '{'
+
+    Returns:
+        True if the head ends inside a constructor initializer list
+    """
+    if not head or not (_IDENTIFIER_RE.match(head[-1][0]) or head[-1][0] == ">"):
+        return False
+    return any(
+        text == ")" and head[i + 1][0] == ":" for i, (text, _) in enumerate(head[:-1])
+    )
+
+
+def analyze_cpp_source(source: str) -> List[FunctionMetrics]:
+    """
+    Compute metrics for every function defined in a C++ source file.
+
+    Fan-in depends on other files and is left at zero here; see
+    CppMetricsAnalyzer.
+
+    Args:
+        source: C++ source code
+
+    Returns:
+        List of FunctionMetrics in definition order
+    """
+    tokens = tokenize(source)
+    functions: List[FunctionMetrics] = []
+
+    # Enclosing namespace/class names ("" for other blocks)
+    scopes: List[str] = []
+    head: List[Tuple[str, int]] = []
+
+    current: Optional[FunctionMetrics] = None
+    depth = 0
+    calls: Set[str] = set()
+
+    i = 0
+    while i < len(tokens):
+        text, line = tokens[i]
+
+        if current is not None:
+            if text == "{":
+                depth += 1
+                current.max_nesting = max(current.max_nesting, depth - 1)
+            elif text == "}":
+                depth -= 1
+                if depth == 0:
+                    current.end_line = line
+                    current.length = line - current.line + 1
+                    current.calls = sorted(calls)
+                    current.fan_out = len(calls)
+                    functions.append(current)
+                    current = None
+            elif text in _DECISION_TOKENS:
+                current.complexity += 1
+            elif text == "(" and i:
+                callee = tokens[i - 1][0]
+                before = tokens[i - 2][0] if i >= 2 else ""
+                # 'Type name(args)' declares a variable; a call's callee is
+                # never preceded by another identifier or a template's '>'
+                if (
+                    _IDENTIFIER_RE.match(callee)
+                    and callee not in _NON_CALL_KEYWORDS
+                    and before != ">"
+                    and (not _IDENTIFIER_RE.match(before) or before in _CALL_PREFIX_KEYWORDS)
+                ):
+                    calls.add(callee)
+            i += 1
+            continue
+
+        if text == "{" and _in_initializer_list(head):
+            # Consume the member initializer's braces into the head
+            nested = 0
+            while i < len(tokens):
+                head.append(tokens[i])
+                nested += {"{": 1, "}": -1}.get(tokens[i][0], 0)
+                i += 1
+                if nested == 0:
+                    break
+            continue
+
+        if text == "{":
+            found = _function_name(head)
+            texts = [t for t, _ in head]
+            if found is not None:
+                name, name_line = found
+                prefix = "::".join(s for s in scopes if s)
+                qualified = f"{prefix}::{name}" if prefix else name
+                current = FunctionMetrics(name=qualified, line=name_line, end_line=name_line)
+                depth = 1
+                calls = set()
+            elif "namespace" in texts:
+                start = texts.index("namespace") + 1
+                scopes.append("::".join(t for t in texts[start:] if _IDENTIFIER_RE.match(t)))
+            elif "=" not in texts and _TYPE_KEYWORDS.intersection(texts):
+                start = max(j for j, t in enumerate(texts) if t in _TYPE_KEYWORDS) + 1
+                name = next((t for t in texts[start:] if _IDENTIFIER_RE.match(t)), "")
+                scopes.append("" if name in ("final", "alignas") else name)
+            else:
+                scopes.append("")
+            head = []
+        elif text == "}":
+            if scopes:
+                scopes.pop()
+            head = []
+        elif text == ";":
+            head = []
+        elif text in ("public", "private", "protected") and tokens[i + 1 : i + 2] and (
+            tokens[i + 1][0] == ":"
+        ):
+            # Access specifier: skip "public:" entirely
+            i += 1
+            head = []
+        else:
+            head.append((text, line))
+        i += 1
+
+    return functions
+
+
+def _analyze_file(path: str) -> Tuple[List[Dict], Optional[str]]:
+    """
+    Read and analyze one file (process pool entry point).
+
+    Args:
+        path: File path
+
+    Returns:
+        Tuple of (function metric dictionaries, error message or None)
+    """
+    try:
+        source = Path(path).read_text(encoding="utf-8", errors="replace")
+    except OSError as e:
+        return [], str(e)
+    return [f.to_dict() for f in analyze_cpp_source(source)], None
+
+
+class CppMetricsAnalyzer:
+    """
+    Computes C++ function metrics across many files in parallel.
+
+    Examples:
+        >>> analyzer = CppMetricsAnalyzer(jobs=8)
+        >>> results = analyzer.analyze_files([Path("src/engine.cpp")])
+        >>> max(f.complexity for f in results["src/engine.cpp"])
+        7
+    """
+
+    def __init__(self, jobs: Optional[int] = None):
+        """
+        Initialize analyzer.
+
+        Args:
+            jobs: Worker processes (default: CPU count)
+        """
+        self.jobs = max(1, jobs or os.cpu_count() or 1)
+        self.errors: Dict[str, str] = {}
+
+    def analyze_files(self, files: Sequence[Path]) -> Dict[str, List[FunctionMetrics]]:
+        """
+        Analyze files and compute fan-in across all of them.
+
+        Args:
+            files: C++ source and header files
+
+        Returns:
+            Dictionary mapping file path (as given) to its function metrics,
+            in input order. Unreadable files are recorded in self.errors.
+        """
+        paths = [str(f) for f in files]
+
+        if len(paths) >= MIN_FILES_FOR_POOL and self.jobs > 1:
+            with ProcessPoolExecutor(max_workers=min(self.jobs, len(paths))) as pool:
+                analyzed = list(
+                    pool.map(
+                        _analyze_file, paths, chunksize=max(1, len(paths) // (self.jobs * 4))
+                    )
+                )
+        else:
+            analyzed = [_analyze_file(p) for p in paths]
+
+        results: Dict[str, List[FunctionMetrics]] = {}
+        self.errors = {}
+        for path, (functions, error) in zip(paths, analyzed):
+            if error is not None:
+                self.errors[path] = error
+            else:
+                results[path] = [FunctionMetrics(**f) for f in functions]
+
+        self._compute_fan_in(results)
+        return results
+
+    @staticmethod
+    def _compute_fan_in(results: Dict[str, List[FunctionMetrics]]) -> None:
+        """
+        Fill in fan-in: the number of distinct functions calling each name.
+
+        Call sites are matched by unqualified name, so overloads and
+        same-named methods share a fan-in.
+
+        Args:
+            results: Analysis results to update in place
+        """
+        callers: Dict[str, Set[Tuple[str, int]]] = defaultdict(set)
+        for path, functions in results.items():
+            for function in functions:
+                for callee in function.calls:
+                    callers[callee].add((path, function.line))
+
+        for functions in results.values():
+            for function in functions:
+                function.fan_in = len(callers.get(function.short_name, ()))
@@ -0,0 +1,473 @@
+"""
+Fast scanning of large build and test logs.
+
+This module strips ANSI escape sequences, indexes the lines of a log as
+offsets (stripping and finding line breaks in a single pass), finds the
+lines that contain any of a set of substrings, and extracts compiler diagnostics
+(GCC/Clang, MSVC) and test results (Google Test, pytest) from raw logs.
+Callers use it to skip most of a multi-hundred-MB log before running their
+own regular expressions on the few lines that can match.
+
+The work is done by the native `_log_scan` extension when it is built (see
+anvil/native/log_scan) and by equivalent pure-Python code otherwise. Both
+give identical results. The ANVIL_LOG_SCAN environment variable selects the
+implementation: "auto" (default), "native" (fail if the extension is not
+built) or "python".
+
+Every function accepts a str or a bytes-like object such as bytes, mmap or
+memoryview. Offsets index the argument, so for a str they are Python string
+indices and for bytes they are byte offsets.
+"""
+
+import mmap
+import os
+import re
+from array import array
+from collections.abc import Sequence
+from pathlib import Path
+from typing import Iterable, Iterator, List, NamedTuple, Optional, Tuple, Union
+
+Text = Union[str, bytes, bytearray, memoryview, mmap.mmap]
+
+# Environment variable selecting the implementation
+IMPLEMENTATION_ENV = "ANVIL_LOG_SCAN"
+
+
+class LogRecord(NamedTuple):
+    """
+    A compiler diagnostic or test result found in a log.
+
+    Attributes:
+        kind: "gcc" (GCC and Clang), "msvc", "gtest" or "pytest"
+        severity: "warning", "error", "fatal error" or "note" for diagnostics;
+            "passed", "failed" or "skipped" for tests, plus "error", "xfail"
+            and "xpass" for pytest
+        file: Source file, or test file for pytest (None for gtest)
+        line: Line number (None if absent)
+        column: Column number (None if absent)
+        code: Warning flag like "-Wunused-variable" or MSVC code like "C4996"
+        message: Diagnostic message, gtest "Suite.Test" or pytest node ID
+        offset: Offset of the start of the record's line
+    """
+
+    kind: str
+    severity: str
+    file: Optional[str]
+    line: Optional[int]
+    column: Optional[int]
+    code: Optional[str]
+    message: str
+    offset: int
+
+
+class _Grammar:
+    """Compiled patterns of the log grammar for str or bytes text."""
+
+    def __init__(self, encode, line_breaks):
+        self.encode = encode
+        # What splitlines() splits on, "\r\n" first so it is a single break
+        self.line_break = re.compile(line_breaks)
+        self.newline = encode("\n")
+        self.escape = encode("\x1b")
+        self.empty = encode("")
+        self.trimmed = encode(" \t\r\f\v")
+        self.ansi = re.compile(encode(r"\x1b\[[0-9;]*[A-Za-z]"))
+        self.sgr = re.compile(encode(r"\x1b\[[0-9;]*m"))
+        # A line that matches no grammar once escapes are gone lacks all of these
+        self.candidate = re.compile(encode(r"\x1b|warning|error|note|\] |::"))
+        self.gcc = re.compile(
+            encode(
+                r"(.+?):([0-9]+)(?::([0-9]+))?:[ \t]*(warning|error|fatal error|note):"
+                r"[ \t]*(.*)"
+            )
+        )
+        self.warning_flag = re.compile(encode(r"(.*?)[ \t]+\[(-W[^\]\[ \t]+)\]"))
+        self.msvc = re.compile(
+            encode(
+                r"(.+?)\(([0-9]+)(?:,([0-9]+))?\)[ \t]*:[ \t]*(warning|error|fatal error)"
+                r"[ \t]+([A-Z]+[0-9]+)[ \t]*:[ \t]*(.*)"
+            )
+        )
+        self.gtest = re.compile(
+            encode(
+                r"\[ +(OK|FAILED|SKIPPED) +\] ([A-Za-z_][A-Za-z0-9_/]*\.[A-Za-z0-9_/]+)"
+                r"(?:, where .*?)?(?: \([0-9]+ ms\))?"
+            )
+        )
+        self.pytest = re.compile(
+            encode(
+                r"([^ \t]+?)::([^ \t]+)[ \t]+(PASSED|FAILED|SKIPPED|ERROR|XFAIL|XPASS)"
+                r"(?:[ \t]|$)"
+            )
+        )
+
+    def decode(self, value):
+        """Field value as str (None stays None)."""
+        if value is None or isinstance(value, str):
+            return value
+        return value.decode("utf-8", "replace")
+
+
+_STR_GRAMMAR = _Grammar(lambda text: text, "\r\n|[\n\r\v\f\x1c-\x1e\x85\u2028\u2029]")
+_BYTES_GRAMMAR = _Grammar(lambda text: text.encode("utf-8"), rb"\r\n|[\n\r]")
+
+_GTEST_SEVERITIES = {"OK": "passed", "FAILED": "failed", "SKIPPED": "skipped"}
+
+
+def _prepare(text: Text) -> Tuple[_Grammar, Union[str, bytes]]:
+    """Grammar for the text and the text as str or bytes."""
+    if isinstance(text, str):
+        return _STR_GRAMMAR, text
+    if isinstance(text, bytes):
+        return _BYTES_GRAMMAR, text
+    try:
+        return _BYTES_GRAMMAR, bytes(memoryview(text))
+    except TypeError:
+        raise TypeError(f"expected str or a bytes-like object, not {type(text).__name__}") from None
+
+
+def _optional_int(value) -> Optional[int]:
+    return int(value) if value is not None else None
+
+
+class PythonScanner:
+    """
+    Pure-Python implementation of the native `_log_scan` module.
+
+    Functions take and return the same values as the extension's, records
+    being plain tuples in LogRecord field order.
+    """
+
+    @staticmethod
+    def strip_ansi(text: Text, sgr_only: bool = False) -> Union[str, bytes]:
+        """Remove ANSI CSI sequences; with sgr_only, only color sequences."""
+        grammar, text = _prepare(text)
+        pattern = grammar.sgr if sgr_only else grammar.ansi
+        return pattern.sub(grammar.empty, text)
+
+    @staticmethod
+    def index_lines(text: Text, sgr_only: bool = False) -> Tuple[Union[str, bytes], bytes]:
+        """Stripped text and the native int64 (start, end) bounds of its lines."""
+        stripped = PythonScanner.strip_ansi(text, sgr_only)
+        return stripped, PythonScanner.line_bounds(stripped)
+
+    @staticmethod
+    def line_bounds(text: Text) -> bytes:
+        """Native int64 (start, end) bounds of the lines of the text as it is."""
+        grammar, text = _prepare(text)
+        bounds = array("q")
+        start = 0
+        for match in grammar.line_break.finditer(text):
+            bounds.append(start)
+            bounds.append(match.start())
+            start = match.end()
+        if start < len(text):
+            bounds.append(start)
+            bounds.append(len(text))
+        return bounds.tobytes()
+
+    @staticmethod
+    def select_lines(
+        text: Text, needles: Iterable[Union[str, bytes]], ignore_case: bool = False
+    ) -> List[Tuple[int, int]]:
+        """(start, end) offsets of the lines containing any needle."""
+        grammar, text = _prepare(text)
+        units = []
+        for needle in needles:
+            if isinstance(needle, str):
+                units.append(grammar.encode(needle))
+            elif isinstance(needle, bytes) and grammar is _BYTES_GRAMMAR:
+                units.append(needle)
+            else:
+                expected = "str" if grammar is _STR_GRAMMAR else "str or bytes"
+                raise TypeError(f"needles must be {expected}, not {type(needle).__name__}")
+        if not units:
+            return []
+
+        flags = 0
+        if ignore_case:
+            # Only ASCII letters fold, as in the native scanner
+            flags = re.IGNORECASE | (re.ASCII if grammar is _STR_GRAMMAR else 0)
+        pattern = re.compile(grammar.encode("|").join(re.escape(u) for u in units), flags)
+
+        lines = []
+        size = len(text)
+        pos = 0
+        while pos <= size:
+            match = pattern.search(text, pos)
+            if match is None:
+                break
+            start = text.rfind(grammar.newline, 0, match.start()) + 1
+            end = text.find(grammar.newline, match.start())
+            if end < 0:
+                end = size
+            lines.append((start, end))
+            pos = end + 1
+        return lines
+
+    @staticmethod
+    def scan_log(text: Text) -> List[tuple]:
+        """Diagnostic and test result records as tuples."""
+        grammar, text = _prepare(text)
+        records = []
+        offset = 0
+        for raw in text.split(grammar.newline):
+            start = offset
+            offset += len(raw) + 1
+            if grammar.candidate.search(raw) is None:
+                continue
+            line = grammar.ansi.sub(grammar.empty, raw) if grammar.escape in raw else raw
+            record = PythonScanner._parse_line(grammar, line.strip(grammar.trimmed), start)
+            if record is not None:
+                records.append(record)
+        return records
+
+    @staticmethod
+    def _parse_line(grammar: _Grammar, line, offset: int) -> Optional[tuple]:
+        """Record for one cleaned line, trying each grammar in turn."""
+        decode = grammar.decode
+
+        match = grammar.gcc.fullmatch(line)
+        if match:
+            file, line_no, column, severity, message = match.groups()
+            code = None
+            flag = grammar.warning_flag.fullmatch(message)
+            if flag:
+                message, code = flag.groups()
+            return (
+                "gcc",
+                decode(severity),
+                decode(file),
+                int(line_no),
+                _optional_int(column),
+                decode(code),
+                decode(message),
+                offset,
+            )
+
+        match = grammar.msvc.fullmatch(line)
+        if match:
+            file, line_no, column, severity, code, message = match.groups()
+            return (
+                "msvc",
+                decode(severity),
+                decode(file),
+                int(line_no),
+                _optional_int(column),
+                decode(code),
+                decode(message),
+                offset,
+            )
+
+        match = grammar.gtest.fullmatch(line)
+        if match:
+            status, name = match.groups()
+            return (
+                "gtest",
+                _GTEST_SEVERITIES[decode(status)],
+                None,
+                None,
+                None,
+                None,
+                decode(name),
+                offset,
+            )
+
+        match = grammar.pytest.match(line)
+        if match:
+            file, name, outcome = match.groups()
+            node_id = file + grammar.encode("::") + name
+            return (
+                "pytest",
+                decode(outcome).lower(),
+                decode(file),
+                None,
+                None,
+                None,
+                decode(node_id),
+                offset,
+            )
+
+        return None
+
+
+class LineIndex(Sequence):
+    """
+    Lines of a log as offsets into its text.
+
+    Indexing or iterating gives the same lines as splitlines() of the text,
+    each sliced only when it is asked for.
+
+    Attributes:
+        text: Indexed text: the stripped text for index_lines(), the
+            argument itself (str, bytes or a buffer such as mmap) for
+            split_lines()
+        starts: Offset of each line in text
+        ends: Offset just past each line, excluding its line break
+    """
+
+    __slots__ = ("text", "starts", "ends")
+
+    def __init__(self, text: Union[str, bytes], bounds: bytes):
+        pairs = memoryview(bounds).cast("q")
+        self.text = text
+        self.starts = pairs[0::2]
+        self.ends = pairs[1::2]
+
+    def __len__(self) -> int:
+        return len(self.starts)
+
+    def __getitem__(self, index):
+        if isinstance(index, slice):
+            return [self[i] for i in range(*index.indices(len(self)))]
+        start, end = self.starts[index], self.ends[index]
+        return self.text[start:end]
+
+    def __iter__(self) -> Iterator[Union[str, bytes]]:
+        text = self.text
+        for start, end in zip(self.starts, self.ends):
+            yield text[start:end]
+
+
+def load_backend(name: str = "auto"):
+    """
+    Load a log scanning implementation.
+
+    Args:
+        name: "native", "python" or "auto" (native if built, else python)
+
+    Returns:
+        The `_log_scan` extension module or PythonScanner
+
+    Raises:
+        ImportError: If name is "native" and the extension is not built
+        ValueError: If name is unknown
+    """
+    if name not in ("auto", "native", "python"):
+        raise ValueError(f"Unknown log scan implementation: {name}")
+    if name == "python":
+        return PythonScanner
+    try:
+        from anvil.parsers import _log_scan
+    except ImportError:
+        if name == "native":
+            raise
+        return PythonScanner
+    return _log_scan
+
+
+_backend = load_backend(os.environ.get(IMPLEMENTATION_ENV, "").strip().lower() or "auto")
+
+# "native" or "python"
+IMPLEMENTATION = "python" if _backend is PythonScanner else "native"
+
+
+def strip_ansi(text: Text, sgr_only: bool = False) -> Union[str, bytes]:
+    """
+    Remove ANSI CSI escape sequences (ESC [ params letter) from text.
+
+    Args:
+        text: Log text
+        sgr_only: Only remove color and style sequences (ending in "m")
+
+    Returns:
+        Text without escape sequences; str for str input, bytes otherwise
+    """
+    return _backend.strip_ansi(text, sgr_only)
+
+
+def index_lines(text: Text, sgr_only: bool = False) -> LineIndex:
+    """
+    Strip ANSI escapes and locate every line of the result in one pass.
+
+    This replaces strip_ansi(text).splitlines() on large logs. The native
+    scanner tests 64-byte blocks for control characters with SSE2 or AVX2,
+    copies blocks without escapes as they are, and returns the lines as int64
+    offsets instead of a list of strings. Text without escapes is indexed in
+    place, without a copy. A str
+    splits as str.splitlines() does; bytes-like text only on "\n", "\r" and
+    "\r\n", as bytes.splitlines() does.
+
+    Args:
+        text: Log text
+        sgr_only: Only remove color and style sequences (ending in "m")
+
+    Returns:
+        Index of the lines of the stripped text
+    """
+    return LineIndex(*_backend.index_lines(text, sgr_only))
+
+
+def split_lines(text: Text) -> LineIndex:
+    """
+    Index the lines of text as it is, without copying or decoding it.
+
+    The index refers to the argument itself, so an mmap stays mapped and each
+    line is copied out only when it is read. Lines split as in index_lines().
+
+    Args:
+        text: Log text, e.g. a memory-mapped file
+
+    Returns:
+        Index of the lines of text
+    """
+    return LineIndex(text, _backend.line_bounds(text))
+
+
+def select_lines(
+    text: Text, needles: Iterable[Union[str, bytes]], ignore_case: bool = False
+) -> List[Tuple[int, int]]:
+    """
+    Find the newline-delimited lines that contain any of the needles.
+
+    This is a cheap prefilter: callers run their own patterns only on the
+    returned lines, whose contents are text[start:end].
+
+    Args:
+        text: Log text
+        needles: Substrings to look for (str, or bytes for bytes-like text)
+        ignore_case: Match ASCII letters in either case
+
+    Returns:
+        (start, end) offsets of the matching lines, in order
+    """
+    return _backend.select_lines(text, list(needles), ignore_case)
+
+
+def scan_log(text: Text) -> List[LogRecord]:
+    """
+    Extract compiler diagnostics and test results from a log.
+
+    Each line is stripped of ANSI escapes and surrounding whitespace and
+    matched against GCC/Clang ("file:line:col: warning: msg [-Wflag]"), MSVC
+    ("file(line,col): error C2065: msg"), Google Test ("[  FAILED  ]
+    Suite.Test (5 ms)") and pytest ("path::test PASSED") formats, in that
+    order. A line gives at most one record.
+
+    Args:
+        text: Log text
+
+    Returns:
+        Records in log order
+    """
+    return list(map(LogRecord._make, _backend.scan_log(text)))
+
+
+def scan_log_file(path: Union[str, Path]) -> List[LogRecord]:
+    """
+    Extract diagnostics and test results from a log file without reading it.
+
+    The file is memory-mapped and scanned in place by the native scanner, so
+    only record fields are decoded. Offsets are byte offsets into the file.
+
+    Args:
+        path: Log file
+
+    Returns:
+        Records in log order
+    """
+    with open(path, "rb") as f:
+        if os.fstat(f.fileno()).st_size == 0:
+            return []
+        with mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as view:
+            return scan_log(view)
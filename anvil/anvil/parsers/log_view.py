@@ -0,0 +1,173 @@
+"""
+Zero-copy access to large stored logs.
+
+LogView memory-maps a log file (or wraps an in-memory buffer such as a
+database blob) and gives its lines without reading or decoding the whole
+log: line offsets are found once with the log scanner, and a line is copied
+out and decoded only when it is read. Filtering with grep() decodes only the
+lines that match.
+
+Scout's log cache, Lens's log endpoint and `anvil parse --file` read logs
+through this module so a multi-hundred-MB log is not held as Python strings.
+
+Example:
+    >>> with LogView.open("build.log") as log:  # doctest: +SKIP
+    ...     for number, line in log.grep(["error"]):
+    ...         print(number, line)
+"""
+
+import mmap
+import os
+from bisect import bisect_left
+from collections.abc import Sequence
+from pathlib import Path
+from typing import Iterable, Iterator, List, Optional, Tuple, Union
+
+from anvil.parsers.log_scan import LineIndex, LogRecord, scan_log, select_lines, split_lines
+
+Buffer = Union[bytes, bytearray, memoryview, mmap.mmap]
+
+
+class LogView(Sequence):
+    """
+    Lines of a log, decoded only when they are read.
+
+    Indexing and iteration give str lines, split as bytes.splitlines() does.
+    Line numbers returned by grep() and line_number() are 1-based.
+
+    Attributes:
+        path: File the view maps, or None for an in-memory buffer
+        encoding: Encoding lines are decoded with
+        errors: Error handler for decoding
+    """
+
+    def __init__(
+        self,
+        data: Buffer,
+        encoding: str = "utf-8",
+        errors: str = "replace",
+        path: Optional[Path] = None,
+    ):
+        """
+        Wrap a bytes-like log without copying it.
+
+        Args:
+            data: Log contents
+            encoding: Encoding to decode lines with
+            errors: Error handler for decoding
+            path: File data was mapped from
+        """
+        self._data = data
+        self._lines: Optional[LineIndex] = None
+        self.encoding = encoding
+        self.errors = errors
+        self.path = path
+
+    @classmethod
+    def open(cls, path: Union[str, Path], encoding: str = "utf-8", errors: str = "replace"):
+        """
+        Memory-map a log file read-only.
+
+        Args:
+            path: Log file
+            encoding: Encoding to decode lines with
+            errors: Error handler for decoding
+
+        Returns:
+            View of the file; close it (or use it as a context manager) to
+            unmap the file
+
+        Raises:
+            OSError: If the file cannot be opened
+        """
+        with open(path, "rb") as f:
+            if os.fstat(f.fileno()).st_size == 0:
+                data: Buffer = b""
+            else:
+                data = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        return cls(data, encoding, errors, Path(path))
+
+    @property
+    def size(self) -> int:
+        """Size of the log in bytes."""
+        return len(self._data)
+
+    @property
+    def lines(self) -> LineIndex:
+        """Line offsets, found on first use."""
+        if self._lines is None:
+            self._lines = split_lines(self._data)
+        return self._lines
+
+    def __len__(self) -> int:
+        return len(self.lines)
+
+    def __getitem__(self, index):
+        if isinstance(index, slice):
+            return [self[i] for i in range(*index.indices(len(self)))]
+        return self._decode(self.lines[index])
+
+    def __iter__(self) -> Iterator[str]:
+        for raw in self.lines:
+            yield self._decode(raw)
+
+    def raw_line(self, index: int) -> bytes:
+        """Undecoded bytes of a line, without its line break."""
+        return bytes(self.lines[index])
+
+    def byte_range(self, start: int, end: int) -> bytes:
+        """Undecoded bytes [start, end) of the log."""
+        return bytes(self._data[start:end])
+
+    def line_number(self, offset: int) -> int:
+        """1-based number of the line containing a byte offset."""
+        return max(bisect_left(self.lines.starts, offset + 1), 1)
+
+    def grep(
+        self, needles: Iterable[Union[str, bytes]], ignore_case: bool = False
+    ) -> Iterator[Tuple[int, str]]:
+        """
+        Lines containing any of the needles, decoding only those lines.
+
+        Args:
+            needles: Substrings to look for
+            ignore_case: Match ASCII letters in either case
+
+        Yields:
+            (line number, line) for each matching line, in order
+        """
+        needles = list(needles)
+        lines = self.lines
+        starts = lines.starts
+        for start, end in select_lines(self._data, needles, ignore_case):
+            # select_lines splits on "\n" only; a lone "\r" inside the span
+            # gives several lines here, each checked on its own.
+            first = bisect_left(starts, start)
+            last = max(bisect_left(starts, end), first + 1)
+            for index in range(first, min(last, len(lines))):
+                raw = lines[index]
+                if last - first == 1 or select_lines(raw, needles, ignore_case):
+                    yield index + 1, self._decode(raw)
+
+    def records(self) -> List[LogRecord]:
+        """Compiler diagnostics and test results, scanned in place."""
+        return scan_log(self._data)
+
+    def text(self) -> str:
+        """The whole log decoded in one step, for parsers that need a str."""
+        return str(self._data, self.encoding, self.errors)
+
+    def close(self) -> None:
+        """Unmap the file; the view cannot be read afterwards."""
+        self._lines = None
+        if isinstance(self._data, mmap.mmap):
+            self._data.close()
+
+    def __enter__(self) -> "LogView":
+        return self
+
+    def __exit__(self, *exc_info) -> None:
+        self.close()
+
+    def _decode(self, raw: bytes) -> str:
+        return str(raw, self.encoding, self.errors)
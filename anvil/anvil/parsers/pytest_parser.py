@@ -281,8 +281,12 @@ class PytestParser:
 
         cmd = [sys.executable, "-m", "pytest"]
 
-        # Disable config file to avoid interference from project pytest.ini
-        cmd.extend(["-c", "/dev/null" if sys.platform != "win32" else "NUL"])
+        # Disable config file to avoid interference from project pytest.ini,
+        # unless the caller pins a rootdir to run under the project's config
+        if config.get("_rootdir"):
+            cmd.append(f"--rootdir={config['_rootdir']}")
+        else:
+            cmd.extend(["-c", "/dev/null" if sys.platform != "win32" else "NUL"])
 
         # JSON report output
         cmd.append("--json-report")
@@ -0,0 +1,293 @@
+"""
+In-process radon analysis.
+
+This module computes radon's cyclomatic complexity (cc), maintainability
+index (mi) and raw metrics for each file in a single pass: the file is read
+and parsed into an AST once, and all three metrics are derived from that
+one parse. This replaces three ``radon`` subprocesses that each re-read and
+re-parse every file.
+
+Files are analyzed in parallel worker processes, and per-file results are
+cached on disk by content hash, so unchanged files are never re-analyzed.
+"""
+
+import ast
+import hashlib
+import json
+import os
+from concurrent.futures import ProcessPoolExecutor
+from pathlib import Path
+from typing import Dict, List, Optional, Sequence, Tuple
+
+# Files below this count are analyzed in-process; a pool costs more to start
+MIN_FILES_FOR_POOL = 16
+
+# Default on-disk cache location (relative to the working directory)
+DEFAULT_CACHE_DIR = ".anvil/cache/radon"
+
+
+def is_radon_importable() -> bool:
+    """
+    Check whether radon can be used in-process.
+
+    Returns:
+        True if the radon package is importable
+    """
+    try:
+        import radon  # noqa: F401
+    except ImportError:
+        return False
+    return True
+
+
+def analyze_source(
+    source: str,
+    multi: bool = True,
+    show_closures: bool = False,
+    tree: Optional[ast.AST] = None,
+) -> Dict:
+    """
+    Compute cc, mi and raw metrics for one file from a single AST parse.
+
+    The output matches radon's JSON formats per file: ``cc`` is the list
+    ``radon cc --json`` reports (sorted by complexity, unfiltered by grade),
+    ``mi`` is ``{"mi": ..., "rank": ...}`` and ``raw`` is the raw metrics
+    dictionary.
+
+    Args:
+        source: Python source code
+        multi: Count multi-line strings as comments for MI (radon's default)
+        show_closures: Report closures as separate cc blocks
+        tree: AST of source if the caller already parsed it
+
+    Returns:
+        Dictionary with "cc", "mi" and "raw" keys, or {"error": message}
+    """
+    from radon.cli.tools import cc_to_dict, raw_to_dict
+    from radon.complexity import SCORE, add_inner_blocks, sorted_results
+    from radon.metrics import h_visit_ast, mi_compute, mi_rank
+    from radon.raw import analyze
+    from radon.visitors import ComplexityVisitor
+
+    try:
+        if tree is None:
+            tree = ast.parse(source)
+        raw = analyze(source)
+    except (SyntaxError, ValueError) as e:
+        return {"error": str(e)}
+
+    # One complexity visit serves both the cc blocks and MI's total complexity
+    visitor = ComplexityVisitor.from_ast(tree)
+    blocks = visitor.blocks
+    if show_closures:
+        blocks = add_inner_blocks(blocks)
+
+    comment_lines = raw.comments + (raw.multi if multi else 0)
+    comments = comment_lines / float(raw.sloc) * 100 if raw.sloc else 0
+    mi = mi_compute(
+        h_visit_ast(tree).total.volume, visitor.total_complexity, raw.lloc, comments
+    )
+
+    return {
+        "cc": [cc_to_dict(block) for block in sorted_results(blocks, order=SCORE)],
+        "mi": {"mi": mi, "rank": mi_rank(mi)},
+        "raw": raw_to_dict(raw),
+    }
+
+
+def _analyze_file(path: str, multi: bool, show_closures: bool) -> Tuple[str, Dict]:
+    """
+    Read and analyze one file (process pool entry point).
+
+    Args:
+        path: File path
+        multi: Count multi-line strings as comments for MI
+        show_closures: Report closures as separate cc blocks
+
+    Returns:
+        Tuple of (content hash, analysis result)
+    """
+    try:
+        data = Path(path).read_bytes()
+    except OSError as e:
+        return "", {"error": str(e)}
+
+    digest = hashlib.sha256(data).hexdigest()
+    try:
+        source = data.decode("utf-8")
+    except UnicodeDecodeError as e:
+        return digest, {"error": str(e)}
+
+    return digest, analyze_source(source, multi=multi, show_closures=show_closures)
+
+
+class RadonAnalyzer:
+    """
+    Single-pass, parallel, cached radon analysis of many files.
+
+    Examples:
+        >>> analyzer = RadonAnalyzer({"show_closures": True})
+        >>> results = analyzer.analyze_files([Path("src/module.py")])
+        >>> results["src/module.py"]["mi"]["rank"]
+        'A'
+    """
+
+    def __init__(
+        self,
+        config: Optional[Dict] = None,
+        cache_dir: Optional[Path] = None,
+        jobs: Optional[int] = None,
+    ):
+        """
+        Initialize analyzer.
+
+        Args:
+            config: Radon configuration. Recognized keys: show_closures,
+                multi (default True), cache (default True), cache_dir, jobs
+            cache_dir: Cache directory (overrides config; default
+                .anvil/cache/radon)
+            jobs: Worker processes (overrides config; default CPU count)
+        """
+        config = config or {}
+        self.multi = config.get("multi", True)
+        self.show_closures = config.get("show_closures", False)
+        self.jobs = max(1, jobs or config.get("jobs") or os.cpu_count() or 1)
+
+        self.cache_dir: Optional[Path] = None
+        if config.get("cache", True):
+            self.cache_dir = Path(cache_dir or config.get("cache_dir", DEFAULT_CACHE_DIR))
+
+    def _options_key(self) -> str:
+        """Build the cache key component for radon version and options."""
+        import radon
+
+        return f"{radon.__version__}-{int(bool(self.multi))}{int(bool(self.show_closures))}"
+
+    def _cache_path(self, digest: str) -> Path:
+        """Get the cache file path for a content hash."""
+        return self.cache_dir / f"{digest}-{self._options_key()}.json"
+
+    def _read_cache(self, path: Path) -> Optional[Tuple[str, Dict]]:
+        """
+        Look up a file's analysis in the cache.
+
+        Args:
+            path: File to look up
+
+        Returns:
+            Tuple of (content hash, cached result) or None on a miss
+        """
+        if self.cache_dir is None:
+            return None
+        try:
+            digest = hashlib.sha256(path.read_bytes()).hexdigest()
+            cached = self._cache_path(digest).read_text(encoding="utf-8")
+            return digest, json.loads(cached)
+        except (OSError, ValueError):
+            return None
+
+    def _write_cache(self, digest: str, result: Dict) -> None:
+        """Store a successful analysis in the cache."""
+        if self.cache_dir is None or not digest or "error" in result:
+            return
+        try:
+            self.cache_dir.mkdir(parents=True, exist_ok=True)
+            target = self._cache_path(digest)
+            temp = target.with_suffix(f".{os.getpid()}.tmp")
+            temp.write_text(json.dumps(result), encoding="utf-8")
+            temp.replace(target)
+        except OSError:
+            # The cache is an optimization; never fail analysis over it
+            pass
+
+    def analyze_files(self, files: Sequence[Path]) -> Dict[str, Dict]:
+        """
+        Analyze files, reusing cached results for unchanged content.
+
+        Args:
+            files: Python files to analyze
+
+        Returns:
+            Dictionary mapping file path (as given) to its analysis result
+        """
+        results: Dict[str, Dict] = {}
+        misses: List[str] = []
+
+        for file in files:
+            cached = self._read_cache(Path(file))
+            if cached is not None:
+                results[str(file)] = cached[1]
+            else:
+                misses.append(str(file))
+
+        if len(misses) >= MIN_FILES_FOR_POOL and self.jobs > 1:
+            with ProcessPoolExecutor(max_workers=min(self.jobs, len(misses))) as pool:
+                analyzed = pool.map(
+                    _analyze_file,
+                    misses,
+                    [self.multi] * len(misses),
+                    [self.show_closures] * len(misses),
+                    chunksize=max(1, len(misses) // (self.jobs * 4)),
+                )
+                analyzed = list(analyzed)
+        else:
+            analyzed = [_analyze_file(f, self.multi, self.show_closures) for f in misses]
+
+        for path, (digest, result) in zip(misses, analyzed):
+            self._write_cache(digest, result)
+            results[path] = result
+
+        # Preserve input order
+        return {str(f): results[str(f)] for f in files}
+
+    @staticmethod
+    def to_cc_json(results: Dict[str, Dict], min_grade: str = "A", max_grade: str = "F") -> str:
+        """
+        Render analysis results in ``radon cc --json`` format.
+
+        Args:
+            results: Output of analyze_files()
+            min_grade: Lowest rank to include (radon --min)
+            max_grade: Highest rank to include (radon --max)
+
+        Returns:
+            JSON string mapping file path to its cc blocks
+        """
+        data = {}
+        for path, result in results.items():
+            if "error" in result:
+                continue
+            blocks = [b for b in result["cc"] if min_grade <= b["rank"] <= max_grade]
+            if blocks:
+                data[path] = blocks
+        return json.dumps(data)
+
+    @staticmethod
+    def to_mi_json(results: Dict[str, Dict]) -> str:
+        """
+        Render analysis results in ``radon mi --json`` format.
+
+        Args:
+            results: Output of analyze_files()
+
+        Returns:
+            JSON string mapping file path to {"mi", "rank"}
+        """
+        return json.dumps(
+            {path: result["mi"] for path, result in results.items() if "error" not in result}
+        )
+
+    @staticmethod
+    def to_raw_json(results: Dict[str, Dict]) -> str:
+        """
+        Render analysis results in ``radon raw --json`` format.
+
+        Args:
+            results: Output of analyze_files()
+
+        Returns:
+            JSON string mapping file path to raw metrics
+        """
+        return json.dumps(
+            {path: result["raw"] for path, result in results.items() if "error" not in result}
+        )
@@ -487,12 +487,17 @@ class RadonParser:
         This is the standard parser interface that delegates to the specific
         radon metric based on configuration. Defaults to cyclomatic complexity.
 
+        When radon is importable, all metrics are computed in-process from a
+        single parse per file (see RadonParser.run_and_parse_in_process);
+        set 'in_process' to False to force the radon subprocesses.
+
         Args:
             files: List of files to analyze
             config: Configuration dictionary with optional 'metric' field:
                 - 'cc' or missing: Cyclomatic complexity (default)
                 - 'mi': Maintainability index
                 - 'raw': Raw metrics
+                - 'all': cc and mi issues in one result (in-process only)
 
         Returns:
             ValidationResult with parsed issues
@@ -508,6 +513,11 @@ class RadonParser:
         # Determine which metric to run
         metric = config.get("metric", "cc")
 
+        from anvil.parsers.radon_analyzer import is_radon_importable
+
+        if config.get("in_process", True) and is_radon_importable():
+            return RadonParser.run_and_parse_in_process(file_paths, config)
+
         if metric == "mi":
             return RadonParser.run_and_parse_mi(file_paths, config)
         elif metric == "raw":
@@ -515,6 +525,82 @@ class RadonParser:
         else:  # Default to cc (cyclomatic complexity)
             return RadonParser.run_and_parse_cc(file_paths, config)
 
+    @staticmethod
+    def run_and_parse_in_process(files: List[Path], config: Dict) -> ValidationResult:
+        """
+        Compute radon metrics in-process and parse them.
+
+        Each file is read and parsed once for cc, mi and raw metrics together,
+        files are analyzed in parallel, and per-file results are cached by
+        content hash (see RadonAnalyzer). Files radon cannot parse are
+        reported as warnings.
+
+        Args:
+            files: List of files to analyze
+            config: Configuration dictionary ('metric' selects the result as in
+                run_and_parse; 'all' combines cc and mi issues)
+
+        Returns:
+            ValidationResult for the selected metric, with per-file raw metrics
+            in metadata["raw"]
+        """
+        from anvil.parsers.radon_analyzer import RadonAnalyzer
+
+        return RadonParser.parse_analysis(RadonAnalyzer(config).analyze_files(files), files, config)
+
+    @staticmethod
+    def parse_analysis(
+        results: Dict[str, Dict], files: List[Path], config: Dict
+    ) -> ValidationResult:
+        """
+        Build a ValidationResult from in-process radon analysis results.
+
+        Args:
+            results: Per-file analysis results (see RadonAnalyzer.analyze_files)
+            files: List of files that were analyzed
+            config: Configuration dictionary ('metric' selects the result as in
+                run_and_parse; 'all' combines cc and mi issues)
+
+        Returns:
+            ValidationResult for the selected metric, with per-file raw metrics
+            in metadata["raw"]
+        """
+        from anvil.parsers.radon_analyzer import RadonAnalyzer
+
+        metric = config.get("metric", "cc")
+
+        if metric == "mi":
+            result = RadonParser.parse_mi(RadonAnalyzer.to_mi_json(results), files, config)
+        elif metric == "raw":
+            result = RadonParser.parse_raw(RadonAnalyzer.to_raw_json(results), files)
+        else:
+            cc_json = RadonAnalyzer.to_cc_json(results, min_grade=config.get("min_grade", "A"))
+            result = RadonParser.parse_cc(cc_json, files, config)
+            if metric == "all":
+                mi_result = RadonParser.parse_mi(RadonAnalyzer.to_mi_json(results), files, config)
+                result.validator_name = "radon"
+                result.warnings.extend(mi_result.warnings)
+
+        for path, analysis in results.items():
+            if "error" in analysis:
+                result.warnings.append(
+                    Issue(
+                        file_path=path,
+                        line_number=1,
+                        column_number=None,
+                        severity="warning",
+                        message=f"radon could not analyze file: {analysis['error']}",
+                        rule_name="radon-parse-error",
+                        error_code="RADON_ERROR",
+                    )
+                )
+
+        result.passed = not result.errors and not result.warnings
+        result.metadata = {
+            "raw": {path: a["raw"] for path, a in results.items() if "error" not in a}
+        }
+        return result
+
     @staticmethod
     def get_version() -> Optional[str]:
         """
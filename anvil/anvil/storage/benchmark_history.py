@@ -0,0 +1,314 @@
+"""
+Per-commit benchmark history and regression detection.
+
+This module stores the timings of every `anvil bench run` in a local SQLite
+database keyed by commit, branch and machine, and compares a new run with
+the runs recorded for earlier commits on the same machine to flag
+benchmarks that got slower.
+"""
+
+import platform
+import sqlite3
+import statistics
+import sys
+from dataclasses import dataclass
+from datetime import datetime
+from pathlib import Path
+from typing import Any, Dict, List, Optional, Sequence
+
+from anvil.testing.benchmarks import BenchmarkResult
+
+# Default database location, next to Anvil's other history databases
+DEFAULT_DATABASE = ".anvil/benchmarks.db"
+
+# Relative slowdown of both the median and the fastest round that is reported
+DEFAULT_THRESHOLD = 0.10
+
+# Number of earlier runs the baseline is taken from
+DEFAULT_WINDOW = 5
+
+
+def machine_id() -> str:
+    """
+    Identify the machine and interpreter timings were taken on.
+
+    Timings are only comparable on the same hardware and Python version.
+
+    Returns:
+        String like "buildbox/x86_64/py3.11"
+    """
+    return (
+        f"{platform.node() or 'unknown'}/{platform.machine() or 'unknown'}/"
+        f"py{sys.version_info.major}.{sys.version_info.minor}"
+    )
+
+
+@dataclass
+class BenchmarkComparison:
+    """
+    A benchmark result compared with its baseline.
+
+    Attributes:
+        name: Benchmark name
+        size: Input size of the current run
+        median: Median seconds per round of the current run
+        baseline: Median of the baseline runs' medians (None if no history)
+        baseline_runs: Number of earlier runs the baseline was taken from
+        status: "regressed", "improved", "unchanged" or "new"
+    """
+
+    name: str
+    size: int
+    median: float
+    baseline: Optional[float]
+    baseline_runs: int
+    status: str
+
+    @property
+    def change(self) -> Optional[float]:
+        """Relative change of the median against the baseline (0.25 = 25% slower)."""
+        if not self.baseline:
+            return None
+        return self.median / self.baseline - 1.0
+
+    def to_dict(self) -> Dict[str, Any]:
+        """Convert to a JSON-serializable dictionary."""
+        return {
+            "name": self.name,
+            "size": self.size,
+            "median": self.median,
+            "baseline": self.baseline,
+            "baseline_runs": self.baseline_runs,
+            "change": self.change,
+            "status": self.status,
+        }
+
+
+class BenchmarkHistory:
+    """
+    Stores benchmark results per commit and detects regressions.
+
+    Each run stores one row per benchmark with its size and timing summary.
+    A benchmark's baseline is the median of its medians over the last few
+    runs on other commits, with the same size and on the same machine.
+
+    Example:
+        >>> with BenchmarkHistory(Path(".anvil/benchmarks.db")) as history:
+        ...     comparisons = history.compare(results, commit="abc123")
+        ...     history.record_run(results, commit="abc123", branch="main")
+    """
+
+    def __init__(self, db_path: Path):
+        """
+        Initialize benchmark history, creating the database if needed.
+
+        Args:
+            db_path: Path to SQLite database file
+        """
+        self.db_path = Path(db_path)
+        self.db_path.parent.mkdir(parents=True, exist_ok=True)
+        self.connection = sqlite3.connect(str(self.db_path))
+        self.connection.row_factory = sqlite3.Row
+        self.connection.execute("PRAGMA foreign_keys = ON")
+        self._create_schema()
+
+    def _create_schema(self) -> None:
+        """Create history tables and indexes if they don't exist."""
+        self.connection.executescript(
+            """
+            CREATE TABLE IF NOT EXISTS benchmark_runs (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                timestamp TEXT NOT NULL,
+                git_commit TEXT,
+                git_branch TEXT,
+                machine TEXT NOT NULL,
+                scale TEXT NOT NULL
+            );
+
+            CREATE TABLE IF NOT EXISTS benchmark_results (
+                run_id INTEGER NOT NULL REFERENCES benchmark_runs(id) ON DELETE CASCADE,
+                name TEXT NOT NULL,
+                size INTEGER NOT NULL,
+                unit TEXT NOT NULL,
+                rounds INTEGER NOT NULL,
+                min REAL NOT NULL,
+                median REAL NOT NULL,
+                mean REAL NOT NULL,
+                stdev REAL NOT NULL,
+                PRIMARY KEY (run_id, name)
+            );
+
+            CREATE INDEX IF NOT EXISTS idx_benchmark_results_name
+                ON benchmark_results(name, size, run_id);
+            """
+        )
+        self.connection.commit()
+
+    def close(self) -> None:
+        """Close the database connection."""
+        self.connection.close()
+
+    def __enter__(self) -> "BenchmarkHistory":
+        """Enter context manager."""
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb) -> None:
+        """Exit context manager and close the connection."""
+        self.close()
+
+    def record_run(
+        self,
+        results: Sequence[BenchmarkResult],
+        commit: Optional[str] = None,
+        branch: Optional[str] = None,
+        scale: str = "full",
+        machine: Optional[str] = None,
+    ) -> int:
+        """
+        Record the results of one benchmark run.
+
+        Skipped benchmarks are not stored.
+
+        Args:
+            results: Benchmark results
+            commit: Commit the benchmarks ran on
+            branch: Branch the benchmarks ran on
+            scale: Scale the suite ran at
+            machine: Machine identifier (default: this machine)
+
+        Returns:
+            Database ID of the run
+        """
+        with self.connection:
+            cursor = self.connection.execute(
+                """
+                INSERT INTO benchmark_runs (timestamp, git_commit, git_branch, machine, scale)
+                VALUES (?, ?, ?, ?, ?)
+                """,
+                (datetime.now().isoformat(), commit, branch, machine or machine_id(), scale),
+            )
+            run_id = cursor.lastrowid
+            self.connection.executemany(
+                """
+                INSERT INTO benchmark_results
+                    (run_id, name, size, unit, rounds, min, median, mean, stdev)
+                VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)
+                """,
+                [
+                    (
+                        run_id,
+                        r.name,
+                        r.size,
+                        r.unit,
+                        len(r.times),
+                        r.min,
+                        r.median,
+                        r.mean,
+                        r.stdev,
+                    )
+                    for r in results
+                    if not r.skipped
+                ],
+            )
+        return run_id
+
+    def get_history(
+        self, name: str, limit: int = 20, machine: Optional[str] = None
+    ) -> List[Dict[str, Any]]:
+        """
+        Get the recorded results of one benchmark, newest first.
+
+        Args:
+            name: Benchmark name
+            limit: Maximum number of runs to return
+            machine: Only runs on this machine (default: all machines)
+
+        Returns:
+            List of dicts with run and timing columns
+        """
+        query = """
+            SELECT r.id AS run_id, r.timestamp, r.git_commit, r.git_branch, r.machine,
+                   b.size, b.unit, b.rounds, b.min, b.median, b.mean, b.stdev
+            FROM benchmark_results b
+            JOIN benchmark_runs r ON r.id = b.run_id
+            WHERE b.name = ?
+        """
+        params: List[Any] = [name]
+        if machine:
+            query += " AND r.machine = ?"
+            params.append(machine)
+        query += " ORDER BY r.id DESC LIMIT ?"
+        params.append(limit)
+        return [dict(row) for row in self.connection.execute(query, params)]
+
+    def compare(
+        self,
+        results: Sequence[BenchmarkResult],
+        commit: Optional[str] = None,
+        threshold: float = DEFAULT_THRESHOLD,
+        window: int = DEFAULT_WINDOW,
+        machine: Optional[str] = None,
+    ) -> List[BenchmarkComparison]:
+        """
+        Compare results with the runs recorded for earlier commits.
+
+        A benchmark regressed when both its median and its fastest round are
+        more than `threshold` slower than the baseline. Requiring both keeps
+        a single noisy round from being reported. Runs on the same commit are
+        left out, so re-running a commit compares it with its predecessors.
+
+        Args:
+            results: Benchmark results of the current run
+            commit: Commit of the current run
+            threshold: Relative slowdown reported as a regression
+            window: Number of earlier runs the baseline is taken from
+            machine: Machine identifier (default: this machine)
+
+        Returns:
+            One comparison per benchmark that was not skipped
+        """
+        machine = machine or machine_id()
+        comparisons = []
+        for result in results:
+            if result.skipped:
+                continue
+            rows = self.connection.execute(
+                """
+                SELECT b.min, b.median
+                FROM benchmark_results b
+                JOIN benchmark_runs r ON r.id = b.run_id
+                WHERE b.name = ? AND b.size = ? AND r.machine = ?
+                  AND (r.git_commit IS NULL OR r.git_commit != ?)
+                ORDER BY b.run_id DESC
+                LIMIT ?
+                """,
+                (result.name, result.size, machine, commit or "", window),
+            ).fetchall()
+
+            baseline = statistics.median(row["median"] for row in rows) if rows else None
+            if baseline is None:
+                status = "new"
+            else:
+                baseline_min = statistics.median(row["min"] for row in rows)
+                if result.median > baseline * (1 + threshold) and result.min > baseline_min * (
+                    1 + threshold
+                ):
+                    status = "regressed"
+                elif result.median < baseline * (1 - threshold) and result.min < baseline_min * (
+                    1 - threshold
+                ):
+                    status = "improved"
+                else:
+                    status = "unchanged"
+
+            comparisons.append(
+                BenchmarkComparison(
+                    name=result.name,
+                    size=result.size,
+                    median=result.median,
+                    baseline=baseline,
+                    baseline_runs=len(rows),
+                    status=status,
+                )
+            )
+        return comparisons
@@ -10,6 +10,10 @@ from datetime import datetime, timedelta
 from typing import Dict, List, Optional, Tuple
 
 from anvil.storage.execution_schema import ExecutionDatabase, ExecutionHistory
+from anvil.utils.contingency import fisher_exact_greater
+
+# Significance level below which a configuration's failures are platform-specific
+DEFAULT_MAX_P_VALUE = 0.05
 
 
 @dataclass
@@ -64,6 +68,40 @@ class ComparisonStatistics:
     platforms_failed: List[str]
 
 
+@dataclass
+class PlatformFailureStatistics:
+    """
+    Failures of a test in one CI configuration against the rest of the matrix.
+
+    Args:
+        entity_id: Test/entity identifier
+        runner_os: Runner OS (windows-latest, ubuntu-latest, ...)
+        compiler: Compiler (msvc, gcc, clang, ...), '' when not recorded
+        build_type: Build type (Debug, Release, ...), '' when not recorded
+        failed: Failed runs in this configuration
+        total: Passed and failed runs in this configuration
+        other_failed: Failed runs in all other configurations
+        other_total: Passed and failed runs in all other configurations
+        p_value: One-sided Fisher's exact p-value that this configuration
+            fails more often than the others
+    """
+
+    entity_id: str
+    runner_os: str
+    compiler: str
+    build_type: str
+    failed: int
+    total: int
+    other_failed: int
+    other_total: int
+    p_value: float
+
+    @property
+    def configuration(self) -> str:
+        """Configuration name, e.g. "windows-latest-msvc-Release"."""
+        return "-".join(part for part in (self.runner_os, self.compiler, self.build_type) if part)
+
+
 class CIStorageLayer:
     """
     CI-specific storage operations for Anvil database.
@@ -272,108 +310,189 @@ class CIStorageLayer:
         """
         Compare local vs CI execution results for entities.
 
+        Computed in one query over latest_execution, which holds each
+        entity's latest local and CI execution and is refreshed on ingest,
+        instead of one query per entity. An entity's latest execution in a
+        space is inside the window exactly when any of them is, so no
+        history rows are ranked; failed platforms are only looked up for
+        entities with a CI failure in the window.
+
         Args:
             entity_type: Filter by entity type (default: test)
             limit_days: Days of history to consider (default: 30)
 
         Returns:
-            List of ComparisonStatistics showing differences
+            List of ComparisonStatistics showing differences, by entity ID
         """
         cutoff = datetime.now() - timedelta(days=limit_days)
 
-        # Get all entities tested in both spaces
-        cursor = self.db.connection.cursor()
-        cursor.execute(
-            """
-        SELECT DISTINCT entity_id FROM execution_history
-        WHERE entity_type=? AND timestamp > ?
+        query = """
+        SELECT
+            entity_id,
+            CASE WHEN local_timestamp > :cutoff THEN local_status END,
+            CASE WHEN local_timestamp > :cutoff THEN local_duration END,
+            CASE WHEN ci_timestamp > :cutoff THEN ci_status END,
+            CASE WHEN ci_timestamp > :cutoff THEN ci_duration END,
+            CASE WHEN ci_failed_at > :cutoff THEN (
+                SELECT group_concat(platform, char(31))
+                FROM ci_failure_platforms AS failed
+                WHERE failed.entity_type = latest.entity_type
+                    AND failed.entity_id = latest.entity_id
+                    AND failed.last_failed > :cutoff
+            ) END
+        FROM latest_execution AS latest
+        WHERE entity_type = :entity_type AND last_timestamp > :cutoff
         ORDER BY entity_id
-        """,
-            [entity_type, cutoff.isoformat()],
-        )
+        """
 
-        entities = [row[0] for row in cursor.fetchall()]
-        comparisons = []
+        cursor = self.db.connection.cursor()
+        cursor.execute(query, {"entity_type": entity_type, "cutoff": cutoff.isoformat()})
 
-        for entity_id in entities:
-            # Get most recent local execution
-            local_execs = self.get_local_executions(
-                entity_id=entity_id,
-                entity_type=entity_type,
-                limit=1,
-                days=limit_days,
-            )
-            local_status = local_execs[0].status if local_execs else None
-            local_duration = local_execs[0].duration if local_execs else None
-
-            # Get most recent CI execution
-            ci_execs = self.get_ci_executions(
-                entity_id=entity_id,
-                entity_type=entity_type,
-                limit=1,
-                days=limit_days,
-            )
-            ci_status = ci_execs[0].status if ci_execs else None
-            ci_duration = ci_execs[0].duration if ci_execs else None
-
-            # Check if failure is platform-specific
-            platforms_failed = []
-            if ci_execs:
-                # Get all CI executions for this entity
-                all_ci = self.get_ci_executions(
-                    entity_id=entity_id,
-                    entity_type=entity_type,
-                    days=limit_days,
+        comparisons = []
+        for (
+            entity_id,
+            local_status,
+            local_duration,
+            ci_status,
+            ci_duration,
+            platforms,
+        ) in cursor.fetchall():
+            # Platforms are joined with the ASCII unit separator
+            platforms_failed = platforms.split("\x1f") if platforms else []
+            comparisons.append(
+                ComparisonStatistics(
+                    entity_id,
+                    local_status,
+                    ci_status,
+                    local_duration,
+                    ci_duration,
+                    0 < len(platforms_failed) < 3,
+                    platforms_failed,
                 )
-                failed_platforms = set()
-                for record in all_ci:
-                    if record.status == "FAILED" and record.metadata:
-                        platform = record.metadata.get("platform")
-                        if platform:
-                            failed_platforms.add(platform)
-                platforms_failed = list(failed_platforms)
-
-            platform_specific = len(platforms_failed) > 0 and len(platforms_failed) < 3
-
-            comparison = ComparisonStatistics(
-                entity_id=entity_id,
-                local_status=local_status,
-                ci_status=ci_status,
-                local_duration=local_duration,
-                ci_duration=ci_duration,
-                platform_specific=platform_specific,
-                platforms_failed=platforms_failed,
             )
-            comparisons.append(comparison)
 
         return comparisons
 
-    def get_platform_specific_failures(
+    def get_platform_failure_statistics(
         self,
         entity_type: str = "test",
         limit_days: int = 30,
-    ) -> Dict[str, List[str]]:
+        runner_os: Optional[str] = None,
+        compiler: Optional[str] = None,
+        build_type: Optional[str] = None,
+        max_p_value: float = DEFAULT_MAX_P_VALUE,
+    ) -> List[PlatformFailureStatistics]:
         """
-        Get tests that fail only on specific platforms.
+        Get configurations in which tests fail significantly more than elsewhere.
+
+        Reads the per-configuration, per-day outcome counters in
+        platform_outcomes, which are maintained on ingest, and only for
+        entities whose latest CI failure is inside the window, so the cost
+        follows the number of failing tests rather than the size of the
+        history. Each configuration's counts are compared with the rest of
+        the test's matrix by Fisher's exact test, evaluated for all tests
+        in one batch. The window is applied to whole days.
 
         Args:
             entity_type: Filter by entity type (default: test)
             limit_days: Days of history to consider (default: 30)
+            runner_os: Only report this runner OS (optional)
+            compiler: Only report this compiler (optional)
+            build_type: Only report this build type (optional)
+            max_p_value: Significance level (default: 0.05)
 
         Returns:
-            Dict mapping platform names to lists of failing tests
+            List of PlatformFailureStatistics, most significant first
         """
-        comparisons = self.compare_local_vs_ci(entity_type, limit_days)
+        cutoff = datetime.now() - timedelta(days=limit_days)
+
+        # Filters apply after the window sums so "other" still covers the
+        # whole matrix. CROSS JOIN keeps SQLite from driving the join from
+        # the much larger platform_outcomes, and grouping on latest's key
+        # follows the primary key order without a sort
+        filters = ""
+        params = {
+            "entity_type": entity_type,
+            "cutoff": cutoff.isoformat(),
+            "day": cutoff.date().isoformat(),
+        }
+        for column, value in (
+            ("runner_os", runner_os),
+            ("compiler", compiler),
+            ("build_type", build_type),
+        ):
+            if value is not None:
+                filters += f" AND {column} = :{column}"
+                params[column] = value
+
+        query = f"""
+        WITH configurations AS (
+            SELECT latest.entity_id, runner_os, compiler, build_type,
+                   SUM(failed) AS failed, SUM(passed + failed) AS total
+            FROM latest_execution AS latest
+            CROSS JOIN platform_outcomes AS outcomes
+                ON outcomes.entity_type = latest.entity_type
+                AND outcomes.entity_id = latest.entity_id
+            WHERE latest.entity_type = :entity_type
+                AND latest.ci_failed_at > :cutoff
+                AND outcomes.day >= :day
+            GROUP BY latest.entity_type, latest.entity_id, runner_os, compiler, build_type
+        )
+        SELECT * FROM (
+            SELECT entity_id, runner_os, compiler, build_type, failed, total,
+                   SUM(failed) OVER entity - failed,
+                   SUM(total) OVER entity - total
+            FROM configurations
+            WINDOW entity AS (PARTITION BY entity_id)
+        )
+        WHERE failed > 0 {filters}
+        """
+
+        cursor = self.db.connection.cursor()
+        cursor.execute(query, params)
+        rows = cursor.fetchall()
+
+        p_values = fisher_exact_greater(
+            [
+                (failed, total - failed, other_failed, other_total - other_failed)
+                for *_, failed, total, other_failed, other_total in rows
+            ]
+        )
 
-        platform_failures = {}
+        statistics = [
+            PlatformFailureStatistics(*row, p_value)
+            for row, p_value in zip(rows, p_values)
+            if p_value <= max_p_value
+        ]
+        statistics.sort(key=lambda stat: (stat.p_value, stat.entity_id, stat.configuration))
+        return statistics
 
-        for comp in comparisons:
-            if comp.platform_specific and comp.platforms_failed:
-                for platform in comp.platforms_failed:
-                    if platform not in platform_failures:
-                        platform_failures[platform] = []
-                    platform_failures[platform].append(comp.entity_id)
+    def get_platform_specific_failures(
+        self,
+        entity_type: str = "test",
+        limit_days: int = 30,
+        max_p_value: float = DEFAULT_MAX_P_VALUE,
+    ) -> Dict[str, List[str]]:
+        """
+        Get tests that fail significantly more often in specific configurations.
 
+        Args:
+            entity_type: Filter by entity type (default: test)
+            limit_days: Days of history to consider (default: 30)
+            max_p_value: Significance level (default: 0.05)
+
+        Returns:
+            Dict mapping configuration names (runner OS, compiler and build
+            type joined with "-") to sorted lists of failing tests
+        """
+        platform_failures: Dict[str, List[str]] = {}
+        for stat in self.get_platform_failure_statistics(
+            entity_type, limit_days, max_p_value=max_p_value
+        ):
+            platform_failures.setdefault(stat.configuration, []).append(stat.entity_id)
+
+        for entity_ids in platform_failures.values():
+            entity_ids.sort()
         return platform_failures
 
     def get_ci_health_summary(
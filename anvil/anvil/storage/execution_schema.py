@@ -10,7 +10,93 @@ import sqlite3
 from dataclasses import dataclass
 from datetime import datetime
 from pathlib import Path
-from typing import Dict, List, Optional
+from typing import Dict, List, Optional, Tuple
+
+from anvil.models.line_bitmap import LineBitmap, coerce_line_bitmap
+from anvil.utils.tracing import traced
+
+_INSERT_COVERAGE_HISTORY = """
+    INSERT INTO coverage_history (
+        execution_id, file_path, timestamp, total_statements,
+        covered_statements, coverage_percentage, space, metadata,
+        missing_lines_rle, covered_lines_rle
+    )
+    VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+    """
+
+
+# Rebuild latest_execution rows: the latest execution per entity and space
+# is ranked with a window function, then pivoted to one row per entity
+_INSERT_LATEST_EXECUTIONS = """
+    INSERT INTO latest_execution (
+        entity_type, entity_id, last_timestamp,
+        local_id, local_timestamp, local_status, local_duration,
+        ci_id, ci_timestamp, ci_status, ci_duration, ci_failed_at
+    )
+    SELECT
+        entity_type, entity_id, MAX(timestamp),
+        MAX(CASE WHEN space = 'local' AND position = 1 THEN id END),
+        MAX(CASE WHEN space = 'local' AND position = 1 THEN timestamp END),
+        MAX(CASE WHEN space = 'local' AND position = 1 THEN status END),
+        MAX(CASE WHEN space = 'local' AND position = 1 THEN duration END),
+        MAX(CASE WHEN space = 'ci' AND position = 1 THEN id END),
+        MAX(CASE WHEN space = 'ci' AND position = 1 THEN timestamp END),
+        MAX(CASE WHEN space = 'ci' AND position = 1 THEN status END),
+        MAX(CASE WHEN space = 'ci' AND position = 1 THEN duration END),
+        MAX(CASE WHEN space = 'ci' AND status = 'FAILED' THEN timestamp END)
+    FROM (
+        SELECT id, entity_type, entity_id, timestamp, status, duration, space,
+               ROW_NUMBER() OVER (
+                   PARTITION BY entity_type, entity_id, space
+                   ORDER BY timestamp DESC, id DESC
+               ) AS position
+        FROM execution_history
+        WHERE 1=1 {entity}
+    )
+    GROUP BY entity_type, entity_id
+    """
+
+# Rebuild ci_failure_platforms rows: the latest CI failure per platform
+# (+status keeps the planner on the entity index when {entity} filters)
+_INSERT_FAILURE_PLATFORMS = """
+    INSERT INTO ci_failure_platforms (entity_type, entity_id, platform, last_failed)
+    SELECT entity_type, entity_id, platform, MAX(timestamp)
+    FROM (
+        SELECT entity_type, entity_id, timestamp,
+               json_extract(metadata, '$.platform') AS platform
+        FROM execution_history
+        WHERE space = 'ci' AND +status = 'FAILED' AND json_valid(metadata) {entity}
+    )
+    WHERE platform IS NOT NULL AND platform != ''
+    GROUP BY entity_type, entity_id, platform
+    """
+
+# CI configuration of an execution: runner OS (falling back to the platform
+# the Scout bridge records), compiler and build type, '' when not recorded
+_CONFIGURATION_COLUMNS = """
+    COALESCE(json_extract({metadata}, '$.runner_os'), json_extract({metadata}, '$.platform'))
+        AS runner_os,
+    COALESCE(json_extract({metadata}, '$.compiler'), '') AS compiler,
+    COALESCE(json_extract({metadata}, '$.build_type'), '') AS build_type
+    """
+
+# Rebuild platform_outcomes rows: passed and failed CI runs per configuration and day
+_INSERT_PLATFORM_OUTCOMES = f"""
+    INSERT INTO platform_outcomes (
+        entity_type, entity_id, runner_os, compiler, build_type, day, passed, failed
+    )
+    SELECT entity_type, entity_id, runner_os, compiler, build_type, day,
+           SUM(status = 'PASSED'), SUM(status = 'FAILED')
+    FROM (
+        SELECT entity_type, entity_id, status, substr(timestamp, 1, 10) AS day,
+               {_CONFIGURATION_COLUMNS.format(metadata="metadata")}
+        FROM execution_history
+        WHERE space = 'ci' AND +status IN ('PASSED', 'FAILED') AND json_valid(metadata)
+            {{entity}}
+    )
+    WHERE runner_os IS NOT NULL AND runner_os != ''
+    GROUP BY entity_type, entity_id, runner_os, compiler, build_type, day
+    """
 
 
 @dataclass
@@ -117,9 +203,10 @@ class CoverageHistory:
         total_statements: Total number of executable statements
         covered_statements: Number of covered statements
         coverage_percentage: Coverage percentage (0.0-100.0)
-        missing_lines: JSON list of uncovered line numbers
+        missing_lines: Uncovered line numbers (stored run-length encoded)
         space: Execution space (local, ci)
         metadata: Additional metadata as JSON
+        covered_lines: Covered line numbers (stored run-length encoded)
         id: Database ID (set after insertion)
     """
 
@@ -129,11 +216,17 @@ class CoverageHistory:
     total_statements: int
     covered_statements: int
     coverage_percentage: float
-    missing_lines: Optional[List[int]] = None
+    missing_lines: Optional[LineBitmap] = None
     space: str = "local"
     metadata: Optional[Dict] = None
+    covered_lines: Optional[LineBitmap] = None
     id: Optional[int] = None
 
+    def __post_init__(self):
+        """Store line collections as bitmaps."""
+        self.missing_lines = coerce_line_bitmap(self.missing_lines)
+        self.covered_lines = coerce_line_bitmap(self.covered_lines)
+
 
 @dataclass
 class CoverageSummary:
@@ -149,6 +242,7 @@ class CoverageSummary:
         covered_statements: Total number of covered statements
         space: Execution space (local, ci)
         metadata: Additional metadata as JSON (e.g., platform, python_version)
+        git_commit: Commit the coverage was measured on
         id: Database ID (set after insertion)
     """
 
@@ -160,6 +254,7 @@ class CoverageSummary:
     covered_statements: int
     space: str = "local"
     metadata: Optional[Dict] = None
+    git_commit: Optional[str] = None
     id: Optional[int] = None
 
 
@@ -362,6 +457,167 @@ class ExecutionDatabase:
             ON execution_history(execution_id)
             """)
 
+        # Latest local and CI execution per entity plus the platforms it
+        # failed on in CI, refreshed on ingest by triggers so local-vs-CI
+        # comparisons read one row per entity instead of ranking history
+        cursor.execute("""
+            SELECT COUNT(*) FROM sqlite_master
+            WHERE type='table' AND name IN ('latest_execution', 'platform_outcomes')
+            """)
+        backfill = cursor.fetchone()[0] < 2
+
+        cursor.execute("""
+            CREATE TABLE IF NOT EXISTS latest_execution (
+                entity_type TEXT NOT NULL,
+                entity_id TEXT NOT NULL,
+                last_timestamp TEXT NOT NULL,
+                local_id INTEGER,
+                local_timestamp TEXT,
+                local_status TEXT,
+                local_duration REAL,
+                ci_id INTEGER,
+                ci_timestamp TEXT,
+                ci_status TEXT,
+                ci_duration REAL,
+                ci_failed_at TEXT,
+                PRIMARY KEY (entity_type, entity_id)
+            ) WITHOUT ROWID
+            """)
+
+        cursor.execute("""
+            CREATE TABLE IF NOT EXISTS ci_failure_platforms (
+                entity_type TEXT NOT NULL,
+                entity_id TEXT NOT NULL,
+                platform TEXT NOT NULL,
+                last_failed TEXT NOT NULL,
+                PRIMARY KEY (entity_type, entity_id, platform)
+            ) WITHOUT ROWID
+            """)
+
+        # Passed and failed CI runs per entity, configuration and day: the
+        # contingency tables behind platform-specific failure detection
+        cursor.execute("""
+            CREATE TABLE IF NOT EXISTS platform_outcomes (
+                entity_type TEXT NOT NULL,
+                entity_id TEXT NOT NULL,
+                runner_os TEXT NOT NULL,
+                compiler TEXT NOT NULL,
+                build_type TEXT NOT NULL,
+                day TEXT NOT NULL,
+                passed INTEGER NOT NULL,
+                failed INTEGER NOT NULL,
+                PRIMARY KEY (entity_type, entity_id, runner_os, compiler, build_type, day)
+            ) WITHOUT ROWID
+            """)
+
+        if backfill:
+            self.refresh_latest_executions(commit=False)
+
+        # Each column pair is only replaced by a newer execution of its space
+        newer_local = (
+            "excluded.local_id IS NOT NULL AND (local_id IS NULL"
+            " OR (excluded.local_timestamp, excluded.local_id) > (local_timestamp, local_id))"
+        )
+        newer_ci = (
+            "excluded.ci_id IS NOT NULL AND (ci_id IS NULL"
+            " OR (excluded.ci_timestamp, excluded.ci_id) > (ci_timestamp, ci_id))"
+        )
+        cursor.execute(f"""
+            CREATE TRIGGER IF NOT EXISTS trg_latest_execution_insert
+            AFTER INSERT ON execution_history
+            BEGIN
+                INSERT INTO latest_execution (
+                    entity_type, entity_id, last_timestamp,
+                    local_id, local_timestamp, local_status, local_duration,
+                    ci_id, ci_timestamp, ci_status, ci_duration, ci_failed_at
+                )
+                SELECT
+                    NEW.entity_type, NEW.entity_id, NEW.timestamp,
+                    CASE WHEN local THEN NEW.id END,
+                    CASE WHEN local THEN NEW.timestamp END,
+                    CASE WHEN local THEN NEW.status END,
+                    CASE WHEN local THEN NEW.duration END,
+                    CASE WHEN ci THEN NEW.id END,
+                    CASE WHEN ci THEN NEW.timestamp END,
+                    CASE WHEN ci THEN NEW.status END,
+                    CASE WHEN ci THEN NEW.duration END,
+                    CASE WHEN ci AND NEW.status = 'FAILED' THEN NEW.timestamp END
+                FROM (SELECT NEW.space = 'local' AS local, NEW.space = 'ci' AS ci)
+                WHERE true
+                ON CONFLICT (entity_type, entity_id) DO UPDATE SET
+                    last_timestamp = MAX(last_timestamp, excluded.last_timestamp),
+                    local_id = CASE WHEN {newer_local} THEN excluded.local_id ELSE local_id END,
+                    local_timestamp = CASE WHEN {newer_local}
+                        THEN excluded.local_timestamp ELSE local_timestamp END,
+                    local_status = CASE WHEN {newer_local}
+                        THEN excluded.local_status ELSE local_status END,
+                    local_duration = CASE WHEN {newer_local}
+                        THEN excluded.local_duration ELSE local_duration END,
+                    ci_id = CASE WHEN {newer_ci} THEN excluded.ci_id ELSE ci_id END,
+                    ci_timestamp = CASE WHEN {newer_ci}
+                        THEN excluded.ci_timestamp ELSE ci_timestamp END,
+                    ci_status = CASE WHEN {newer_ci} THEN excluded.ci_status ELSE ci_status END,
+                    ci_duration = CASE WHEN {newer_ci}
+                        THEN excluded.ci_duration ELSE ci_duration END,
+                    ci_failed_at = CASE WHEN excluded.ci_failed_at > COALESCE(ci_failed_at, '')
+                        THEN excluded.ci_failed_at ELSE ci_failed_at END;
+            END
+            """)
+
+        cursor.execute("""
+            CREATE TRIGGER IF NOT EXISTS trg_ci_failure_platforms_insert
+            AFTER INSERT ON execution_history
+            WHEN NEW.space = 'ci' AND NEW.status = 'FAILED'
+            BEGIN
+                INSERT INTO ci_failure_platforms (entity_type, entity_id, platform, last_failed)
+                SELECT NEW.entity_type, NEW.entity_id, platform, NEW.timestamp
+                FROM (
+                    SELECT json_extract(NEW.metadata, '$.platform') AS platform
+                    WHERE json_valid(NEW.metadata)
+                )
+                WHERE platform IS NOT NULL AND platform != ''
+                ON CONFLICT (entity_type, entity_id, platform) DO UPDATE SET
+                    last_failed = MAX(last_failed, excluded.last_failed);
+            END
+            """)
+
+        cursor.execute(f"""
+            CREATE TRIGGER IF NOT EXISTS trg_platform_outcomes_insert
+            AFTER INSERT ON execution_history
+            WHEN NEW.space = 'ci' AND NEW.status IN ('PASSED', 'FAILED')
+            BEGIN
+                INSERT INTO platform_outcomes (
+                    entity_type, entity_id, runner_os, compiler, build_type, day, passed, failed
+                )
+                SELECT NEW.entity_type, NEW.entity_id, runner_os, compiler, build_type,
+                       substr(NEW.timestamp, 1, 10),
+                       NEW.status = 'PASSED', NEW.status = 'FAILED'
+                FROM (
+                    SELECT {_CONFIGURATION_COLUMNS.format(metadata="NEW.metadata")}
+                    WHERE json_valid(NEW.metadata)
+                )
+                WHERE runner_os IS NOT NULL AND runner_os != ''
+                ON CONFLICT (entity_type, entity_id, runner_os, compiler, build_type, day)
+                DO UPDATE SET
+                    passed = passed + excluded.passed,
+                    failed = failed + excluded.failed;
+            END
+            """)
+
+        entity = "AND entity_type = OLD.entity_type AND entity_id = OLD.entity_id"
+        cursor.execute(f"""
+            CREATE TRIGGER IF NOT EXISTS trg_latest_execution_delete
+            AFTER DELETE ON execution_history
+            BEGIN
+                DELETE FROM latest_execution WHERE 1=1 {entity};
+                DELETE FROM ci_failure_platforms WHERE 1=1 {entity};
+                DELETE FROM platform_outcomes WHERE 1=1 {entity};
+                {_INSERT_LATEST_EXECUTIONS.format(entity=entity)};
+                {_INSERT_FAILURE_PLATFORMS.format(entity=entity)};
+                {_INSERT_PLATFORM_OUTCOMES.format(entity=entity)};
+            END
+            """)
+
         # Create execution_rules table
         cursor.execute("""
             CREATE TABLE IF NOT EXISTS execution_rules (
@@ -419,19 +675,32 @@ class ExecutionDatabase:
                 coverage_percentage REAL NOT NULL,
                 missing_lines TEXT,
                 space TEXT DEFAULT 'local',
-                metadata TEXT
+                metadata TEXT,
+                missing_lines_rle BLOB,
+                covered_lines_rle BLOB
             )
             """)
 
+        # Line sets used to be stored as JSON lists; add the run-length
+        # encoded columns to databases created before them
+        cursor.execute("PRAGMA table_info(coverage_history)")
+        coverage_columns = {row[1] for row in cursor.fetchall()}
+        for column in ("missing_lines_rle", "covered_lines_rle"):
+            if column not in coverage_columns:
+                cursor.execute(f"ALTER TABLE coverage_history ADD COLUMN {column} BLOB")
+
         # Create indexes for coverage_history
         cursor.execute("""
             CREATE INDEX IF NOT EXISTS idx_coverage_file_timestamp
             ON coverage_history(file_path, timestamp)
             """)
 
+        # Per-file lookups within a run (patch coverage); replaces the
+        # execution_id index, which is a prefix of this one
+        cursor.execute("DROP INDEX IF EXISTS idx_coverage_execution_id")
         cursor.execute("""
-            CREATE INDEX IF NOT EXISTS idx_coverage_execution_id
-            ON coverage_history(execution_id)
+            CREATE INDEX IF NOT EXISTS idx_coverage_execution_file
+            ON coverage_history(execution_id, file_path)
             """)
 
         # Create coverage_summary table
@@ -445,10 +714,20 @@ class ExecutionDatabase:
                 total_statements INTEGER NOT NULL,
                 covered_statements INTEGER NOT NULL,
                 space TEXT DEFAULT 'local',
-                metadata TEXT
+                metadata TEXT,
+                git_commit TEXT
             )
             """)
 
+        cursor.execute("PRAGMA table_info(coverage_summary)")
+        if "git_commit" not in {row[1] for row in cursor.fetchall()}:
+            cursor.execute("ALTER TABLE coverage_summary ADD COLUMN git_commit TEXT")
+
+        cursor.execute("""
+            CREATE INDEX IF NOT EXISTS idx_coverage_summary_commit
+            ON coverage_summary(git_commit, timestamp)
+            """)
+
         # Create index for coverage_summary
         cursor.execute("""
             CREATE INDEX IF NOT EXISTS idx_coverage_summary_timestamp
@@ -548,6 +827,7 @@ class ExecutionDatabase:
         if hasattr(self, "connection"):
             self.connection.close()
 
+    @traced("anvil.db.insert_execution_history")
     def insert_execution_history(self, record: ExecutionHistory) -> int:
         """
         Insert an execution history record.
@@ -590,14 +870,21 @@ class ExecutionDatabase:
         entity_id: Optional[str] = None,
         entity_type: Optional[str] = None,
         limit: Optional[int] = None,
+        before_id: Optional[int] = None,
     ) -> List[ExecutionHistory]:
         """
-        Retrieve execution history records.
+        Retrieve execution history records, newest first.
+
+        Pages use keyset pagination on (timestamp, id): with an entity ID the
+        (entity_id, timestamp) index yields rows in order, so each page is an
+        index seek rather than an OFFSET scan over older pages.
 
         Args:
             entity_id: Filter by entity ID (optional)
             entity_type: Filter by entity type (optional)
             limit: Maximum number of records to return (optional)
+            before_id: Continue after the record with this ID, the last
+                record of the previous page (optional)
 
         Returns:
             List of ExecutionHistory records
@@ -615,7 +902,13 @@ class ExecutionDatabase:
             query += " AND entity_type = ?"
             params.append(entity_type)
 
-        query += " ORDER BY timestamp DESC"
+        if before_id is not None:
+            query += (
+                " AND (timestamp, id) < (SELECT timestamp, id FROM execution_history WHERE id = ?)"
+            )
+            params.append(before_id)
+
+        query += " ORDER BY timestamp DESC, id DESC"
 
         if limit:
             query += " LIMIT ?"
@@ -644,6 +937,61 @@ class ExecutionDatabase:
 
         return records
 
+    def get_entity_ids(self) -> List[str]:
+        """
+        Retrieve the distinct entity IDs present in execution history.
+
+        Served from the (entity_id, timestamp) index without loading
+        history rows.
+
+        Returns:
+            List of unique entity IDs
+        """
+        cursor = self.connection.cursor()
+        cursor.execute("SELECT DISTINCT entity_id FROM execution_history")
+        return [row[0] for row in cursor.fetchall()]
+
+    def refresh_latest_executions(self, commit: bool = True) -> int:
+        """
+        Rebuild latest_execution, ci_failure_platforms and platform_outcomes.
+
+        Triggers keep these tables current on every insert and delete; a full
+        rebuild is only needed for databases created before they existed.
+
+        Args:
+            commit: Whether to commit the rebuild
+
+        Returns:
+            Number of entities written
+        """
+        cursor = self.connection.cursor()
+        cursor.execute("DELETE FROM latest_execution")
+        cursor.execute("DELETE FROM ci_failure_platforms")
+        cursor.execute("DELETE FROM platform_outcomes")
+        cursor.execute(_INSERT_LATEST_EXECUTIONS.format(entity=""))
+        entities = cursor.rowcount
+        cursor.execute(_INSERT_FAILURE_PLATFORMS.format(entity=""))
+        cursor.execute(_INSERT_PLATFORM_OUTCOMES.format(entity=""))
+        if commit:
+            self.connection.commit()
+        return entities
+
+    def get_entity_set_version(self) -> Tuple[int, int]:
+        """
+        Get a cheap version stamp for the set of recorded entities.
+
+        The stamp changes whenever this connection or any other connection
+        commits a write to the database, so callers can cache data derived
+        from get_entity_ids(). It is O(1) and never scans history.
+
+        Returns:
+            Tuple of (SQLite data_version, changes made by this connection)
+        """
+        cursor = self.connection.cursor()
+        cursor.execute("PRAGMA data_version")
+        return cursor.fetchone()[0], self.connection.total_changes
+
+    @traced("anvil.db.insert_execution_rule")
     def insert_execution_rule(self, rule: ExecutionRule) -> int:
         """
         Insert an execution rule.
@@ -717,6 +1065,7 @@ class ExecutionDatabase:
             updated_at=datetime.fromisoformat(row[9]) if row[9] else None,
         )
 
+    @traced("anvil.db.update_entity_statistics")
     def update_entity_statistics(self, stats: EntityStatistics) -> int:
         """
         Update or insert entity statistics.
@@ -817,6 +1166,7 @@ class ExecutionDatabase:
 
     # Coverage-related methods
 
+    @traced("anvil.db.insert_coverage_history")
     def insert_coverage_history(self, record: CoverageHistory) -> int:
         """
         Insert a coverage history record.
@@ -827,34 +1177,44 @@ class ExecutionDatabase:
         Returns:
             Row ID of inserted record
         """
-        import json
-
         cursor = self.connection.cursor()
-        cursor.execute(
-            """
-            INSERT INTO coverage_history (
-                execution_id, file_path, timestamp, total_statements,
-                covered_statements, coverage_percentage, missing_lines,
-                space, metadata
-            )
-            VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)
-            """,
-            (
-                record.execution_id,
-                record.file_path,
-                record.timestamp.isoformat(),
-                record.total_statements,
-                record.covered_statements,
-                record.coverage_percentage,
-                json.dumps(record.missing_lines) if record.missing_lines else None,
-                record.space,
-                json.dumps(record.metadata) if record.metadata else None,
-            ),
-        )
+        cursor.execute(_INSERT_COVERAGE_HISTORY, self._coverage_history_row(record))
 
         self.connection.commit()
         return cursor.lastrowid
 
+    @traced("anvil.db.insert_coverage_histories")
+    def insert_coverage_histories(self, records: List[CoverageHistory]) -> None:
+        """
+        Insert the per-file records of a coverage run in one transaction.
+
+        Args:
+            records: CoverageHistory instances to insert
+        """
+        self.connection.executemany(
+            _INSERT_COVERAGE_HISTORY, [self._coverage_history_row(r) for r in records]
+        )
+        self.connection.commit()
+
+    @staticmethod
+    def _coverage_history_row(record: CoverageHistory) -> tuple:
+        """Convert a CoverageHistory record to insert parameters."""
+        import json
+
+        return (
+            record.execution_id,
+            record.file_path,
+            record.timestamp.isoformat(),
+            record.total_statements,
+            record.covered_statements,
+            record.coverage_percentage,
+            record.space,
+            json.dumps(record.metadata) if record.metadata else None,
+            record.missing_lines.to_rle() if record.missing_lines else None,
+            record.covered_lines.to_rle() if record.covered_lines else None,
+        )
+
+    @traced("anvil.db.insert_coverage_summary")
     def insert_coverage_summary(self, record: CoverageSummary) -> int:
         """
         Insert a coverage summary record.
@@ -872,9 +1232,9 @@ class ExecutionDatabase:
             """
             INSERT INTO coverage_summary (
                 execution_id, timestamp, total_coverage, files_analyzed,
-                total_statements, covered_statements, space, metadata
+                total_statements, covered_statements, space, metadata, git_commit
             )
-            VALUES (?, ?, ?, ?, ?, ?, ?, ?)
+            VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)
             """,
             (
                 record.execution_id,
@@ -885,6 +1245,7 @@ class ExecutionDatabase:
                 record.covered_statements,
                 record.space,
                 json.dumps(record.metadata) if record.metadata else None,
+                record.git_commit,
             ),
         )
 
@@ -944,16 +1305,34 @@ class ExecutionDatabase:
                     total_statements=row[4],
                     covered_statements=row[5],
                     coverage_percentage=row[6],
-                    missing_lines=json.loads(row[7]) if row[7] else None,
+                    missing_lines=self._coverage_lines(row[10], row[7]),
                     space=row[8],
                     metadata=json.loads(row[9]) if row[9] else None,
+                    covered_lines=self._coverage_lines(row[11]),
                 )
             )
 
         return records
 
+    @staticmethod
+    def _coverage_lines(
+        encoded: Optional[bytes], legacy_json: Optional[str] = None
+    ) -> Optional[LineBitmap]:
+        """Decode a stored line set, falling back to the old JSON list column."""
+        import json
+
+        if encoded:
+            return LineBitmap.from_rle(encoded)
+        if legacy_json:
+            return LineBitmap(json.loads(legacy_json))
+        return None
+
     def get_coverage_summary(
-        self, execution_id: Optional[str] = None, space: Optional[str] = None, limit: int = 50
+        self,
+        execution_id: Optional[str] = None,
+        space: Optional[str] = None,
+        limit: int = 50,
+        git_commit: Optional[str] = None,
     ) -> List[CoverageSummary]:
         """
         Query coverage summary records.
@@ -962,6 +1341,7 @@ class ExecutionDatabase:
             execution_id: Filter by execution ID
             space: Filter by execution space
             limit: Maximum number of records to return
+            git_commit: Filter by the commit the coverage was measured on
 
         Returns:
             List of CoverageSummary instances
@@ -976,6 +1356,10 @@ class ExecutionDatabase:
             query += " AND execution_id = ?"
             params.append(execution_id)
 
+        if git_commit:
+            query += " AND git_commit = ?"
+            params.append(git_commit)
+
         if space:
             query += " AND space = ?"
             params.append(space)
@@ -998,13 +1382,62 @@ class ExecutionDatabase:
                     covered_statements=row[6],
                     space=row[7],
                     metadata=json.loads(row[8]) if row[8] else None,
+                    git_commit=row[9],
                 )
             )
 
         return records
 
+    def get_coverage_file_paths(self, execution_id: str) -> List[str]:
+        """
+        List the files measured in a coverage run (an index-only scan).
+
+        Args:
+            execution_id: Execution ID of the run
+
+        Returns:
+            File paths as stored
+        """
+        cursor = self.connection.execute(
+            "SELECT file_path FROM coverage_history WHERE execution_id = ?", (execution_id,)
+        )
+        return [row[0] for row in cursor]
+
+    def get_coverage_lines(
+        self, execution_id: str, file_paths: List[str]
+    ) -> Dict[str, Tuple[Optional[LineBitmap], Optional[LineBitmap]]]:
+        """
+        Get covered and missing lines of some files in a coverage run.
+
+        Args:
+            execution_id: Execution ID of the run
+            file_paths: Stored file paths to look up
+
+        Returns:
+            (covered_lines, missing_lines) by file path, for files in the run
+        """
+        lines = {}
+        # Stay below SQLite's default limit of 999 bound parameters
+        for start in range(0, len(file_paths), 900):
+            chunk = file_paths[start : start + 900]
+            cursor = self.connection.execute(
+                f"""
+                SELECT file_path, covered_lines_rle, missing_lines_rle, missing_lines
+                FROM coverage_history
+                WHERE execution_id = ? AND file_path IN ({", ".join("?" * len(chunk))})
+                """,
+                [execution_id, *chunk],
+            )
+            for path, covered, missing, legacy_missing in cursor:
+                lines[path] = (
+                    self._coverage_lines(covered),
+                    self._coverage_lines(missing, legacy_missing),
+                )
+        return lines
+
     # Lint-related methods
 
+    @traced("anvil.db.insert_lint_violation")
     def insert_lint_violation(self, record: LintViolation) -> int:
         """
         Insert a lint violation record.
@@ -1045,6 +1478,7 @@ class ExecutionDatabase:
         self.connection.commit()
         return cursor.lastrowid
 
+    @traced("anvil.db.insert_lint_summary")
     def insert_lint_summary(self, record: LintSummary) -> int:
         """
         Insert a lint summary record.
@@ -1224,6 +1658,7 @@ class ExecutionDatabase:
 
         return records
 
+    @traced("anvil.db.upsert_code_quality_metrics")
     def upsert_code_quality_metrics(self, record: CodeQualityMetrics) -> int:
         """
         Insert or update code quality metrics for a file.
@@ -36,6 +36,8 @@ class ScoutAnvilBridge:
         platform: str,
         python_version: str,
         timestamp: Optional[datetime] = None,
+        compiler: Optional[str] = None,
+        build_type: Optional[str] = None,
     ) -> int:
         """
         Store pytest results from Scout's PytestParser.
@@ -56,6 +58,8 @@ class ScoutAnvilBridge:
             platform: OS name (ubuntu-latest, windows-latest, macos-latest)
             python_version: Python version (3.8, 3.9, etc.)
             timestamp: Execution timestamp (defaults to now)
+            compiler: Compiler of a C++ matrix job (msvc, gcc, clang), optional
+            build_type: Build type of a C++ matrix job (Debug, Release), optional
 
         Returns:
             Total number of records stored
@@ -81,6 +85,10 @@ class ScoutAnvilBridge:
                 "platform": platform,
                 "python_version": python_version,
             }
+            if compiler:
+                metadata["compiler"] = compiler
+            if build_type:
+                metadata["build_type"] = build_type
 
             if error_message:
                 metadata["error_message"] = error_message
@@ -318,6 +326,8 @@ class ScoutAnvilBridge:
                         "job_conclusion": "success",
                         "platform": "ubuntu-latest",
                         "python_version": "3.11",
+                        "compiler": "msvc",  # optional, C++ matrix jobs
+                        "build_type": "Release",  # optional, C++ matrix jobs
                         "parsed_data": {...}  # output from parsers
                     },
                     ...
@@ -346,6 +356,8 @@ class ScoutAnvilBridge:
                     platform=platform,
                     python_version=python_version,
                     timestamp=run_timestamp,
+                    compiler=job.get("compiler"),
+                    build_type=job.get("build_type"),
                 )
                 counts["tests"] += count
 
@@ -12,6 +12,11 @@ from datetime import datetime, timedelta
 from pathlib import Path
 from typing import List, Optional
 
+from anvil.utils.tracing import traced
+
+# Columns of validation_runs, in ValidationRun order
+RUN_COLUMNS = "id, timestamp, git_commit, git_branch, incremental, passed, duration_seconds"
+
 
 @dataclass
 class ValidationRun:
@@ -171,6 +176,7 @@ class StatisticsDatabase:
                 self.connection = sqlite3.connect(db_path, check_same_thread=False, timeout=30.0)
                 self.connection.execute("PRAGMA foreign_keys = ON")
                 self._create_schema()
+                self._create_indexes()
             else:
                 raise e
 
@@ -202,6 +208,7 @@ class StatisticsDatabase:
                 warning_count INTEGER NOT NULL,
                 files_checked INTEGER NOT NULL,
                 duration_seconds REAL NOT NULL,
+                run_timestamp TEXT,
                 FOREIGN KEY (run_id) REFERENCES validation_runs(id) ON DELETE CASCADE
             )
             """)
@@ -217,6 +224,7 @@ class StatisticsDatabase:
                 skipped INTEGER NOT NULL,
                 duration_seconds REAL NOT NULL,
                 failure_message TEXT,
+                run_timestamp TEXT,
                 FOREIGN KEY (run_id) REFERENCES validation_runs(id) ON DELETE CASCADE
             )
             """)
@@ -230,6 +238,7 @@ class StatisticsDatabase:
                 file_path TEXT NOT NULL,
                 error_count INTEGER NOT NULL,
                 warning_count INTEGER NOT NULL,
+                run_timestamp TEXT,
                 FOREIGN KEY (run_id) REFERENCES validation_runs(id) ON DELETE CASCADE
             )
             """)
@@ -244,8 +253,45 @@ class StatisticsDatabase:
         # Insert initial schema version if not exists
         cursor.execute("SELECT COUNT(*) FROM schema_version")
         if cursor.fetchone()[0] == 0:
-            cursor.execute("INSERT INTO schema_version (version) VALUES (2)")
+            cursor.execute("INSERT INTO schema_version (version) VALUES (3)")
+
+        self.connection.commit()
 
+    def _create_indexes(self):
+        """
+        Create the indexes behind the history queries.
+
+        History queries filter on one key and return the newest rows first,
+        so each index is (key, timestamp, id): rows come out of the index in
+        result order, LIMIT stops the scan early and keyset pagination is a
+        range seek. Per-run records carry their run's timestamp (run_timestamp)
+        so the order does not need a join. The branch and file indexes also
+        hold every selected column, so those queries never read the table.
+        Created after migrations, which may rebuild tables.
+        """
+        cursor = self.connection.cursor()
+        indexes = {
+            # query_runs_by_date_range, delete_runs_older_than, export filters
+            "idx_runs_timestamp": "validation_runs(timestamp)",
+            "idx_runs_commit": "validation_runs(git_commit, timestamp)",
+            "idx_runs_branch_history": (
+                "validation_runs(git_branch, timestamp, id, git_commit, incremental, passed,"
+                " duration_seconds)"
+            ),
+            "idx_validator_history": "validator_run_records(validator_name, run_timestamp, id)",
+            # failure_message is left out; only the rows of a page are read
+            "idx_test_case_history": "test_case_records(test_name, run_timestamp, id)",
+            "idx_file_validation_history": (
+                "file_validation_records(file_path, run_timestamp, id, run_id, validator_name,"
+                " error_count, warning_count)"
+            ),
+            # Per-run lookups and ON DELETE CASCADE
+            "idx_test_case_run": "test_case_records(run_id)",
+            "idx_file_validation_run": "file_validation_records(run_id)",
+            "idx_validator_run_records_run": "validator_run_records(run_id)",
+        }
+        for name, definition in indexes.items():
+            cursor.execute(f"CREATE INDEX IF NOT EXISTS {name} ON {definition}")
         self.connection.commit()
 
     def _migrate_if_needed(self):
@@ -254,6 +300,9 @@ class StatisticsDatabase:
 
         if current_version < 2:
             self._migrate_v1_to_v2()
+        if current_version < 3:
+            self._migrate_v2_to_v3()
+        self._create_indexes()
 
     def _migrate_v1_to_v2(self):
         """Migrate from schema version 1 to 2."""
@@ -297,6 +346,29 @@ class StatisticsDatabase:
         cursor.execute("UPDATE schema_version SET version = 2")
         self.connection.commit()
 
+    def _migrate_v2_to_v3(self):
+        """Migrate from schema version 2 to 3 (run timestamps on per-run records)."""
+        cursor = self.connection.cursor()
+
+        for table in ("validator_run_records", "test_case_records", "file_validation_records"):
+            cursor.execute(f"PRAGMA table_info({table})")
+            columns = {row[1] for row in cursor.fetchall()}
+            if "run_timestamp" not in columns:
+                cursor.execute(f"ALTER TABLE {table} ADD COLUMN run_timestamp TEXT")
+            cursor.execute(f"""
+                UPDATE {table}
+                SET run_timestamp = (
+                    SELECT timestamp FROM validation_runs WHERE validation_runs.id = {table}.run_id
+                )
+                WHERE run_timestamp IS NULL
+                """)
+
+        # Superseded by idx_test_case_history, which starts with test_name
+        cursor.execute("DROP INDEX IF EXISTS idx_test_case_name")
+
+        cursor.execute("UPDATE schema_version SET version = 3")
+        self.connection.commit()
+
     def get_schema_version(self) -> int:
         """
         Get current database schema version.
@@ -314,6 +386,7 @@ class StatisticsDatabase:
         if self.connection:
             self.connection.close()
 
+    @traced("anvil.db.insert_validation_run")
     def insert_validation_run(self, run: ValidationRun) -> int:
         """
         Insert a validation run record.
@@ -344,6 +417,7 @@ class StatisticsDatabase:
         self.connection.commit()
         return cursor.lastrowid
 
+    @traced("anvil.db.insert_validation_runs_batch")
     def insert_validation_runs_batch(self, runs: List[ValidationRun]) -> List[int]:
         """
         Insert multiple validation runs in a single transaction.
@@ -435,6 +509,51 @@ class StatisticsDatabase:
             )
         return None
 
+    def _history_page(
+        self,
+        table: str,
+        key_column: str,
+        key: str,
+        columns: str,
+        limit: Optional[int],
+        before_id: Optional[int],
+        timestamp_column: str = "run_timestamp",
+    ) -> List[tuple]:
+        """
+        Fetch one page of a history, newest first.
+
+        Rows are ordered by (timestamp, id) descending, which matches the
+        (key, timestamp, id) history indexes. Pages continue with keyset
+        pagination: before_id seeks past the last row of the previous page
+        instead of skipping rows with OFFSET.
+
+        Args:
+            table: Table to read
+            key_column: Column to filter on
+            key: Value of key_column
+            columns: Columns to select
+            limit: Maximum number of rows (None for all)
+            before_id: Only rows after the row with this id (older, or equally
+                old with a lower id); an unknown id gives an empty page
+            timestamp_column: Column holding the run timestamp
+
+        Returns:
+            Row tuples
+        """
+        sql = f"SELECT {columns} FROM {table} WHERE {key_column} = ?"
+        params: List[object] = [key]
+        if before_id is not None:
+            sql += (
+                f" AND ({timestamp_column}, id) <"
+                f" (SELECT {timestamp_column}, id FROM {table} WHERE id = ?)"
+            )
+            params.append(before_id)
+        sql += f" ORDER BY {timestamp_column} DESC, id DESC"
+        if limit is not None:
+            sql += " LIMIT ?"
+            params.append(limit)
+        return self.connection.execute(sql, params).fetchall()
+
     def query_runs_by_date_range(self, start: datetime, end: datetime) -> List[ValidationRun]:
         """
         Query validation runs within a date range.
@@ -481,72 +600,47 @@ class StatisticsDatabase:
             commit: Git commit hash
 
         Returns:
-            List of ValidationRun objects
+            List of ValidationRun objects, newest first
         """
-        cursor = self.connection.cursor()
-        cursor.execute(
-            """
-            SELECT id, timestamp, git_commit, git_branch, incremental, passed,
-                   duration_seconds
-            FROM validation_runs
-            WHERE git_commit = ?
-            ORDER BY timestamp DESC
-            """,
-            (commit,),
+        rows = self._history_page(
+            "validation_runs", "git_commit", commit, RUN_COLUMNS, None, None, "timestamp"
         )
+        return [self._run_from_row(row) for row in rows]
 
-        runs = []
-        for row in cursor.fetchall():
-            runs.append(
-                ValidationRun(
-                    id=row[0],
-                    timestamp=datetime.fromisoformat(row[1]),
-                    git_commit=row[2],
-                    git_branch=row[3],
-                    incremental=bool(row[4]),
-                    passed=bool(row[5]),
-                    duration_seconds=row[6],
-                )
-            )
-        return runs
-
-    def query_runs_by_git_branch(self, branch: str) -> List[ValidationRun]:
+    def query_runs_by_git_branch(
+        self, branch: str, limit: Optional[int] = None, before_id: Optional[int] = None
+    ) -> List[ValidationRun]:
         """
         Query validation runs by git branch name.
 
         Args:
             branch: Git branch name
+            limit: Maximum number of runs to return (default: all)
+            before_id: Continue after the run with this ID (the last run of
+                the previous page)
 
         Returns:
-            List of ValidationRun objects
+            List of ValidationRun objects, newest first
         """
-        cursor = self.connection.cursor()
-        cursor.execute(
-            """
-            SELECT id, timestamp, git_commit, git_branch, incremental, passed,
-                   duration_seconds
-            FROM validation_runs
-            WHERE git_branch = ?
-            ORDER BY timestamp DESC
-            """,
-            (branch,),
+        rows = self._history_page(
+            "validation_runs", "git_branch", branch, RUN_COLUMNS, limit, before_id, "timestamp"
+        )
+        return [self._run_from_row(row) for row in rows]
+
+    @staticmethod
+    def _run_from_row(row: tuple) -> ValidationRun:
+        """Build a ValidationRun from a row of RUN_COLUMNS."""
+        return ValidationRun(
+            id=row[0],
+            timestamp=datetime.fromisoformat(row[1]),
+            git_commit=row[2],
+            git_branch=row[3],
+            incremental=bool(row[4]),
+            passed=bool(row[5]),
+            duration_seconds=row[6],
         )
 
-        runs = []
-        for row in cursor.fetchall():
-            runs.append(
-                ValidationRun(
-                    id=row[0],
-                    timestamp=datetime.fromisoformat(row[1]),
-                    git_commit=row[2],
-                    git_branch=row[3],
-                    incremental=bool(row[4]),
-                    passed=bool(row[5]),
-                    duration_seconds=row[6],
-                )
-            )
-        return runs
-
+    @traced("anvil.db.insert_validator_run_record")
     def insert_validator_run_record(self, record: ValidatorRunRecord) -> int:
         """
         Insert a validator run record.
@@ -562,8 +656,8 @@ class StatisticsDatabase:
             """
             INSERT INTO validator_run_records
                 (run_id, validator_name, passed, error_count, warning_count,
-                 files_checked, duration_seconds)
-            VALUES (?, ?, ?, ?, ?, ?, ?)
+                 files_checked, duration_seconds, run_timestamp)
+            VALUES (?, ?, ?, ?, ?, ?, ?, (SELECT timestamp FROM validation_runs WHERE id = ?))
             """,
             (
                 record.run_id,
@@ -573,6 +667,7 @@ class StatisticsDatabase:
                 record.warning_count,
                 record.files_checked,
                 record.duration_seconds,
+                record.run_id,
             ),
         )
         self.connection.commit()
@@ -636,7 +731,7 @@ class StatisticsDatabase:
         return records
 
     def query_validator_history(
-        self, validator_name: str, limit: int = 100
+        self, validator_name: str, limit: int = 100, before_id: Optional[int] = None
     ) -> List[ValidatorRunRecord]:
         """
         Query history for a specific validator across runs.
@@ -644,27 +739,24 @@ class StatisticsDatabase:
         Args:
             validator_name: Name of the validator
             limit: Maximum number of records to return
+            before_id: Continue after the record with this ID (the last
+                record of the previous page)
 
         Returns:
             List of ValidatorRunRecord objects, newest first
         """
-        cursor = self.connection.cursor()
-        cursor.execute(
-            """
-            SELECT vrr.id, vrr.run_id, vrr.validator_name, vrr.passed,
-                   vrr.error_count, vrr.warning_count, vrr.files_checked,
-                   vrr.duration_seconds
-            FROM validator_run_records vrr
-            JOIN validation_runs vr ON vrr.run_id = vr.id
-            WHERE vrr.validator_name = ?
-            ORDER BY vr.timestamp DESC
-            LIMIT ?
-            """,
-            (validator_name, limit),
+        rows = self._history_page(
+            "validator_run_records",
+            "validator_name",
+            validator_name,
+            "id, run_id, validator_name, passed, error_count, warning_count, files_checked,"
+            " duration_seconds",
+            limit,
+            before_id,
         )
 
         records = []
-        for row in cursor.fetchall():
+        for row in rows:
             records.append(
                 ValidatorRunRecord(
                     id=row[0],
@@ -679,6 +771,7 @@ class StatisticsDatabase:
             )
         return records
 
+    @traced("anvil.db.insert_test_case_record")
     def insert_test_case_record(self, record: TestCaseRecord) -> int:
         """
         Insert a test case record.
@@ -694,8 +787,8 @@ class StatisticsDatabase:
             """
             INSERT INTO test_case_records
                 (run_id, test_name, test_suite, passed, skipped,
-                 duration_seconds, failure_message)
-            VALUES (?, ?, ?, ?, ?, ?, ?)
+                 duration_seconds, failure_message, run_timestamp)
+            VALUES (?, ?, ?, ?, ?, ?, ?, (SELECT timestamp FROM validation_runs WHERE id = ?))
             """,
             (
                 record.run_id,
@@ -705,11 +798,13 @@ class StatisticsDatabase:
                 1 if record.skipped else 0,
                 record.duration_seconds,
                 record.failure_message,
+                record.run_id,
             ),
         )
         self.connection.commit()
         return cursor.lastrowid
 
+    @traced("anvil.db.insert_test_case_records_batch")
     def insert_test_case_records_batch(self, records: List[TestCaseRecord]) -> None:
         """
         Insert multiple test case records in a single transaction.
@@ -742,6 +837,7 @@ class StatisticsDatabase:
                 1 if record.skipped else 0,
                 record.duration_seconds,
                 record.failure_message,
+                record.run_id,
             )
             for record in records
         ]
@@ -751,8 +847,8 @@ class StatisticsDatabase:
             """
             INSERT INTO test_case_records
                 (run_id, test_name, test_suite, passed, skipped,
-                 duration_seconds, failure_message)
-            VALUES (?, ?, ?, ?, ?, ?, ?)
+                 duration_seconds, failure_message, run_timestamp)
+            VALUES (?, ?, ?, ?, ?, ?, ?, (SELECT timestamp FROM validation_runs WHERE id = ?))
             """,
             data,
         )
@@ -830,34 +926,33 @@ class StatisticsDatabase:
             )
         return records
 
-    def query_test_history(self, test_name: str, limit: int = 100) -> List[TestCaseRecord]:
+    def query_test_history(
+        self, test_name: str, limit: int = 100, before_id: Optional[int] = None
+    ) -> List[TestCaseRecord]:
         """
         Query history for a specific test across runs.
 
         Args:
             test_name: Name of the test
             limit: Maximum number of records to return
+            before_id: Continue after the record with this ID (the last
+                record of the previous page)
 
         Returns:
             List of TestCaseRecord objects, newest first
         """
-        cursor = self.connection.cursor()
-        cursor.execute(
-            """
-            SELECT tcr.id, tcr.run_id, tcr.test_name, tcr.test_suite,
-                   tcr.passed, tcr.skipped, tcr.duration_seconds,
-                   tcr.failure_message
-            FROM test_case_records tcr
-            JOIN validation_runs vr ON tcr.run_id = vr.id
-            WHERE tcr.test_name = ?
-            ORDER BY vr.timestamp DESC
-            LIMIT ?
-            """,
-            (test_name, limit),
+        rows = self._history_page(
+            "test_case_records",
+            "test_name",
+            test_name,
+            "id, run_id, test_name, test_suite, passed, skipped, duration_seconds,"
+            " failure_message",
+            limit,
+            before_id,
         )
 
         records = []
-        for row in cursor.fetchall():
+        for row in rows:
             records.append(
                 TestCaseRecord(
                     id=row[0],
@@ -872,6 +967,7 @@ class StatisticsDatabase:
             )
         return records
 
+    @traced("anvil.db.insert_file_validation_record")
     def insert_file_validation_record(self, record: FileValidationRecord) -> int:
         """
         Insert a file validation record.
@@ -886,8 +982,8 @@ class StatisticsDatabase:
         cursor.execute(
             """
             INSERT INTO file_validation_records
-                (run_id, validator_name, file_path, error_count, warning_count)
-            VALUES (?, ?, ?, ?, ?)
+                (run_id, validator_name, file_path, error_count, warning_count, run_timestamp)
+            VALUES (?, ?, ?, ?, ?, (SELECT timestamp FROM validation_runs WHERE id = ?))
             """,
             (
                 record.run_id,
@@ -895,6 +991,7 @@ class StatisticsDatabase:
                 record.file_path,
                 record.error_count,
                 record.warning_count,
+                record.run_id,
             ),
         )
         self.connection.commit()
@@ -936,7 +1033,7 @@ class StatisticsDatabase:
         return records
 
     def get_file_error_frequency(
-        self, file_path: str, limit: int = 100
+        self, file_path: str, limit: int = 100, before_id: Optional[int] = None
     ) -> List[FileValidationRecord]:
         """
         Get error frequency for a specific file across runs.
@@ -944,26 +1041,23 @@ class StatisticsDatabase:
         Args:
             file_path: Path to the file
             limit: Maximum number of records to return
+            before_id: Continue after the record with this ID (the last
+                record of the previous page)
 
         Returns:
             List of FileValidationRecord objects, newest first
         """
-        cursor = self.connection.cursor()
-        cursor.execute(
-            """
-            SELECT fvr.id, fvr.run_id, fvr.validator_name, fvr.file_path,
-                   fvr.error_count, fvr.warning_count
-            FROM file_validation_records fvr
-            JOIN validation_runs vr ON fvr.run_id = vr.id
-            WHERE fvr.file_path = ?
-            ORDER BY vr.timestamp DESC
-            LIMIT ?
-            """,
-            (file_path, limit),
+        rows = self._history_page(
+            "file_validation_records",
+            "file_path",
+            file_path,
+            "id, run_id, validator_name, file_path, error_count, warning_count",
+            limit,
+            before_id,
         )
 
         records = []
-        for row in cursor.fetchall():
+        for row in rows:
             records.append(
                 FileValidationRecord(
                     id=row[0],
@@ -976,6 +1070,7 @@ class StatisticsDatabase:
             )
         return records
 
+    @traced("anvil.db.delete_runs_older_than")
     def delete_runs_older_than(self, days: int) -> int:
         """
         Delete validation runs older than specified days.
@@ -0,0 +1,387 @@
+"""
+Streaming export of the statistics database.
+
+Rows are read with a single SQL query per table, with the date and branch
+filters pushed into its WHERE clause, and fetched in fixed-size batches, so
+memory use does not grow with the amount of history exported. JSON and CSV
+are written with the standard library; Arrow IPC and Parquet are written as
+one record batch per fetched batch and need the optional pyarrow package.
+
+Child tables are exported denormalized: each test case and file record
+carries its run's timestamp, commit and branch, so columnar consumers can
+filter and group without a join.
+"""
+
+import csv
+import json
+from dataclasses import dataclass
+from datetime import datetime
+from pathlib import Path
+from typing import IO, Any, Dict, Iterator, List, Optional, Sequence, Tuple
+
+from anvil.storage.statistics_database import StatisticsDatabase
+
+# Rows fetched from SQLite and written per record batch
+DEFAULT_BATCH_SIZE = 50_000
+
+EXPORT_FORMATS = ("json", "csv", "arrow", "parquet")
+
+# Formats written as one file per table below an output directory
+DIRECTORY_FORMATS = {"arrow": ".arrow", "csv": ".csv", "parquet": ".parquet"}
+
+# Column kinds: int, float, text, bool (stored as 0/1), timestamp (ISO text)
+_RUN_COLUMNS = (
+    ("timestamp", "timestamp"),
+    ("git_commit", "text"),
+    ("git_branch", "text"),
+)
+
+
+class StatisticsExportError(Exception):
+    """Exception raised when statistics cannot be exported."""
+
+
+@dataclass(frozen=True)
+class ExportTable:
+    """
+    Columns exported for one statistics table.
+
+    Attributes:
+        name: Table name
+        columns: (column, kind) pairs of the table itself
+        joins_run: Add the owning run's timestamp, commit and branch
+    """
+
+    name: str
+    columns: Tuple[Tuple[str, str], ...]
+    joins_run: bool = True
+
+    @property
+    def fields(self) -> List[Tuple[str, str]]:
+        """Exported (name, kind) pairs, including run columns."""
+        if not self.joins_run:
+            return list(self.columns)
+        return list(self.columns) + [(f"run_{name}", kind) for name, kind in _RUN_COLUMNS]
+
+
+EXPORT_TABLES: Dict[str, ExportTable] = {
+    table.name: table
+    for table in (
+        ExportTable(
+            "validation_runs",
+            (
+                ("id", "int"),
+                ("timestamp", "timestamp"),
+                ("git_commit", "text"),
+                ("git_branch", "text"),
+                ("incremental", "bool"),
+                ("passed", "bool"),
+                ("duration_seconds", "float"),
+            ),
+            joins_run=False,
+        ),
+        ExportTable(
+            "test_case_records",
+            (
+                ("id", "int"),
+                ("run_id", "int"),
+                ("test_name", "text"),
+                ("test_suite", "text"),
+                ("passed", "bool"),
+                ("skipped", "bool"),
+                ("duration_seconds", "float"),
+                ("failure_message", "text"),
+            ),
+        ),
+        ExportTable(
+            "file_validation_records",
+            (
+                ("id", "int"),
+                ("run_id", "int"),
+                ("validator_name", "text"),
+                ("file_path", "text"),
+                ("error_count", "int"),
+                ("warning_count", "int"),
+            ),
+        ),
+    )
+}
+
+
+def _import_pyarrow():
+    """Import pyarrow, which only the columnar formats need."""
+    try:
+        import pyarrow
+        import pyarrow.ipc  # noqa: F401
+        import pyarrow.parquet  # noqa: F401
+    except ImportError:
+        raise StatisticsExportError(
+            "Arrow and Parquet export require pyarrow (pip install pyarrow)"
+        )
+    return pyarrow
+
+
+class StatisticsExporter:
+    """
+    Exports statistics tables in batches.
+
+    Args:
+        database: Statistics database to export from
+        since: Only runs at or after this time
+        until: Only runs before this time
+        branch: Only runs on this git branch
+        batch_size: Rows fetched and written at a time
+    """
+
+    def __init__(
+        self,
+        database: StatisticsDatabase,
+        since: Optional[datetime] = None,
+        until: Optional[datetime] = None,
+        branch: Optional[str] = None,
+        batch_size: int = DEFAULT_BATCH_SIZE,
+    ):
+        """Initialize the exporter with its run filters."""
+        self.db = database
+        self.since = since
+        self.until = until
+        self.branch = branch
+        self.batch_size = batch_size
+
+    def build_query(self, table: str) -> Tuple[str, List[Any]]:
+        """
+        Build the export query for a table.
+
+        Args:
+            table: Name of a table in EXPORT_TABLES
+
+        Returns:
+            SQL statement and its parameters
+        """
+        spec = EXPORT_TABLES[table]
+        columns = [f"t.{name}" for name, _ in spec.columns]
+        if spec.joins_run:
+            columns += [f"r.{name}" for name, _ in _RUN_COLUMNS]
+            # CROSS JOIN keeps the child table as the outer loop, so rows stream
+            # in id order and each run is a primary key lookup
+            source = f"{table} AS t CROSS JOIN validation_runs AS r ON r.id = t.run_id"
+        else:
+            source = f"{table} AS t"
+        run = "r" if spec.joins_run else "t"
+
+        conditions, params = [], []
+        # Timestamps are stored as ISO 8601 text, which sorts chronologically
+        if self.since is not None:
+            conditions.append(f"{run}.timestamp >= ?")
+            params.append(self.since.isoformat())
+        if self.until is not None:
+            conditions.append(f"{run}.timestamp < ?")
+            params.append(self.until.isoformat())
+        if self.branch is not None:
+            conditions.append(f"{run}.git_branch = ?")
+            params.append(self.branch)
+
+        sql = f"SELECT {', '.join(columns)} FROM {source}"
+        if conditions:
+            sql += " WHERE " + " AND ".join(conditions)
+        return sql + " ORDER BY t.id", params
+
+    def iter_batches(self, table: str) -> Iterator[List[tuple]]:
+        """
+        Fetch a table's rows in batches.
+
+        Args:
+            table: Name of a table in EXPORT_TABLES
+
+        Yields:
+            Lists of at most batch_size row tuples
+        """
+        sql, params = self.build_query(table)
+        cursor = self.db.connection.execute(sql, params)
+        try:
+            while True:
+                rows = cursor.fetchmany(self.batch_size)
+                if not rows:
+                    return
+                yield rows
+        finally:
+            cursor.close()
+
+    def write_json(self, stream: IO[str], tables: Sequence[str]) -> Dict[str, int]:
+        """
+        Write tables as one JSON object of row lists.
+
+        Args:
+            stream: Text stream to write to
+            tables: Tables to export
+
+        Returns:
+            Rows written per table
+        """
+        counts = {}
+        stream.write("{")
+        for t, table in enumerate(tables):
+            fields = EXPORT_TABLES[table].fields
+            names = [name for name, _ in fields]
+            bools = [i for i, (_, kind) in enumerate(fields) if kind == "bool"]
+            stream.write(f'{", " if t else ""}{json.dumps(table)}: [')
+            count = 0
+            for rows in self.iter_batches(table):
+                for row in rows:
+                    values = list(row)
+                    for i in bools:
+                        values[i] = bool(values[i])
+                    stream.write(("," if count else "") + "\n  ")
+                    stream.write(json.dumps(dict(zip(names, values))))
+                    count += 1
+            stream.write("\n]" if count else "]")
+            counts[table] = count
+        stream.write("}\n")
+        return counts
+
+    def write_csv(self, stream: IO[str], table: str) -> int:
+        """
+        Write one table as CSV with a header row.
+
+        Args:
+            stream: Text stream to write to
+            table: Table to export
+
+        Returns:
+            Rows written
+        """
+        writer = csv.writer(stream, lineterminator="\n")
+        writer.writerow([name for name, _ in EXPORT_TABLES[table].fields])
+        count = 0
+        for rows in self.iter_batches(table):
+            writer.writerows(rows)
+            count += len(rows)
+        return count
+
+    def arrow_schema(self, table: str):
+        """
+        Get the Arrow schema of an exported table.
+
+        Args:
+            table: Table to describe
+
+        Returns:
+            pyarrow.Schema
+        """
+        pa = _import_pyarrow()
+        types = {
+            "int": pa.int64(),
+            "float": pa.float64(),
+            "text": pa.string(),
+            "bool": pa.bool_(),
+            "timestamp": pa.timestamp("us"),
+        }
+        return pa.schema([(name, types[kind]) for name, kind in EXPORT_TABLES[table].fields])
+
+    def _record_batch(self, pa, schema, kinds: List[str], rows: List[tuple]):
+        """Convert fetched rows to a record batch, one column at a time."""
+        arrays = []
+        for column, field, kind in zip(zip(*rows), schema, kinds):
+            if kind == "bool":
+                arrays.append(pa.array(column, pa.int8()).cast(pa.bool_()))
+            elif kind == "timestamp":
+                arrays.append(pa.array(column, pa.string()).cast(field.type))
+            else:
+                arrays.append(pa.array(column, field.type))
+        return pa.RecordBatch.from_arrays(arrays, schema=schema)
+
+    def write_columnar(self, path: Path, table: str, format: str) -> int:
+        """
+        Write one table as an Arrow IPC file or Parquet file.
+
+        Args:
+            path: File to write
+            table: Table to export
+            format: "arrow" or "parquet"
+
+        Returns:
+            Rows written
+
+        Raises:
+            StatisticsExportError: If pyarrow is not installed
+        """
+        pa = _import_pyarrow()
+        schema = self.arrow_schema(table)
+        kinds = [kind for _, kind in EXPORT_TABLES[table].fields]
+
+        if format == "parquet":
+            writer = pa.parquet.ParquetWriter(str(path), schema, compression="zstd")
+        else:
+            writer = pa.ipc.new_file(str(path), schema)
+
+        count = 0
+        try:
+            for rows in self.iter_batches(table):
+                writer.write_batch(self._record_batch(pa, schema, kinds, rows))
+                count += len(rows)
+        finally:
+            writer.close()
+        return count
+
+    def export(
+        self,
+        format: str,
+        output: Optional[Path],
+        tables: Sequence[str],
+        stream: Optional[IO[str]] = None,
+    ) -> Dict[str, int]:
+        """
+        Export tables in a format.
+
+        JSON goes to one file (or the stream). CSV, Arrow and Parquet write
+        one file per table into the output directory; CSV can also go to
+        the stream, one table after the other.
+
+        Args:
+            format: One of EXPORT_FORMATS
+            output: Output file (JSON) or directory (other formats)
+            tables: Tables to export
+            stream: Text stream used when output is None
+
+        Returns:
+            Rows written per table
+
+        Raises:
+            StatisticsExportError: For an unknown format or table, or a
+                columnar format without output directory or pyarrow
+        """
+        if format not in EXPORT_FORMATS:
+            raise StatisticsExportError(f"Invalid format '{format}'")
+        unknown = [t for t in tables if t not in EXPORT_TABLES]
+        if unknown:
+            raise StatisticsExportError(f"Unknown table: {', '.join(unknown)}")
+
+        if format == "json":
+            if output is None:
+                return self.write_json(stream, tables)
+            with open(output, "w", encoding="utf-8") as f:
+                return self.write_json(f, tables)
+
+        if output is None:
+            if format != "csv":
+                raise StatisticsExportError(f"{format} export requires an output directory")
+            counts = {}
+            for i, table in enumerate(tables):
+                if i:
+                    stream.write("\n")
+                counts[table] = self.write_csv(stream, table)
+            return counts
+
+        if format != "csv":
+            _import_pyarrow()
+        output = Path(output)
+        output.mkdir(parents=True, exist_ok=True)
+        counts = {}
+        for table in tables:
+            path = output / f"{table}{DIRECTORY_FORMATS[format]}"
+            if format == "csv":
+                with open(path, "w", encoding="utf-8", newline="") as f:
+                    counts[table] = self.write_csv(f, table)
+            else:
+                counts[table] = self.write_columnar(path, table, format)
+        return counts
@@ -0,0 +1,725 @@
+"""
+Benchmark suite for the parsing and storage hot paths.
+
+This module times the code paths that dominate Anvil, Forge and Scout run
+time on large projects, on synthetic inputs at realistic scale:
+
+- Forge: BuildInspector.extract_warnings on a large build log
+- Forge: CMake configure, build output inspection and build persistence
+  for synthetic projects with thousands of translation units
+  (forge.testing.project_generator)
+- Anvil: ClangTidyParser.parse_yaml, CppcheckParser.parse_xml and
+  GTestParser.parse_output on generated tool output
+- Scout: CILogParser.parse_pytest_log on a large pytest CI log and
+  LogParser.parse_log_lines on a large build log
+- Anvil: log_scan.index_lines (ANSI stripping and line splitting) on
+  hundreds of MB of log text, reported in GB/s
+- Anvil: StatisticsDatabase batch inserts and SmartFilter.filter_tests
+- Anvil: CIStorageLayer.compare_local_vs_ci over tens of thousands of tests
+- Anvil: CIStorageLayer.get_platform_specific_failures over a C++ CI matrix
+
+Each benchmark builds its input once, then times several rounds of the
+operation alone (asv-style: one warmup round, then `repeat` timed rounds).
+Benchmarks whose package is not importable (Forge is only importable from
+the repository root) or whose program is not installed are reported as
+skipped rather than failing the run.
+
+Results are stored per commit and compared with earlier commits by
+anvil.storage.benchmark_history; `anvil bench run` ties the two together.
+"""
+
+import fnmatch
+import importlib
+import shutil
+import statistics
+import tempfile
+import time
+from dataclasses import dataclass, field
+from datetime import datetime, timedelta
+from functools import lru_cache
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Optional, Sequence
+
+# Suite scales: "full" uses realistic sizes, "quick" is for smoke runs
+SCALES = ("full", "quick")
+
+# Timed rounds per benchmark, after one untimed warmup round
+DEFAULT_REPEAT = 5
+
+WARNING_TYPES = ["unused-variable", "sign-compare", "shadow", "unused-parameter", "conversion"]
+
+
+@dataclass
+class Benchmark:
+    """
+    A timed operation on an input of a given size.
+
+    Attributes:
+        name: Benchmark name, e.g. "anvil.parse.cppcheck_xml"
+        sizes: Input size per scale
+        unit: What the size counts, e.g. "lines" or "diagnostics"
+        setup: Builds the input for a size in a scratch directory and returns
+            the operation to time; called once per round so operations that
+            mutate state (database inserts) start fresh every round
+        requires: Module that must be importable, or None
+        programs: Executables that must be on PATH
+    """
+
+    name: str
+    sizes: Dict[str, int]
+    unit: str
+    setup: Callable[[int, Path], Callable[[], Any]]
+    requires: Optional[str] = None
+    programs: Sequence[str] = ()
+
+
+@dataclass
+class BenchmarkResult:
+    """
+    Timings of one benchmark.
+
+    Attributes:
+        name: Benchmark name
+        size: Input size
+        unit: What the size counts
+        times: Seconds per timed round
+        skipped: Reason the benchmark did not run, or None
+    """
+
+    name: str
+    size: int
+    unit: str
+    times: List[float] = field(default_factory=list)
+    skipped: Optional[str] = None
+
+    @property
+    def min(self) -> float:
+        """Fastest round in seconds."""
+        return min(self.times) if self.times else 0.0
+
+    @property
+    def median(self) -> float:
+        """Median round in seconds."""
+        return statistics.median(self.times) if self.times else 0.0
+
+    @property
+    def mean(self) -> float:
+        """Mean round in seconds."""
+        return statistics.mean(self.times) if self.times else 0.0
+
+    @property
+    def stdev(self) -> float:
+        """Standard deviation of the rounds in seconds."""
+        return statistics.stdev(self.times) if len(self.times) > 1 else 0.0
+
+    @property
+    def throughput(self) -> float:
+        """Size units processed per second, at the median round."""
+        return self.size / self.median if self.median else 0.0
+
+    def format_throughput(self) -> str:
+        """Throughput for display, in GB/s for byte counts."""
+        if self.unit == "bytes":
+            return f"{self.throughput / 1e9:.2f} GB/s"
+        return f"{self.throughput:,.0f} {self.unit}/s"
+
+    def to_dict(self) -> Dict[str, Any]:
+        """Convert to a JSON-serializable dictionary."""
+        return {
+            "name": self.name,
+            "size": self.size,
+            "unit": self.unit,
+            "times": self.times,
+            "min": self.min,
+            "median": self.median,
+            "mean": self.mean,
+            "stdev": self.stdev,
+            "throughput": self.throughput,
+            "skipped": self.skipped,
+        }
+
+
+@lru_cache(maxsize=None)
+def build_log(lines: int) -> str:
+    """
+    Synthesize CMake/Ninja build output with GCC, Clang and MSVC warnings.
+
+    Three lines in twenty are warnings, a third of them colored. Warnings in
+    headers repeat across translation units, as they do in real builds.
+
+    Args:
+        lines: Number of output lines
+
+    Returns:
+        Build log text
+    """
+    out = []
+    for i in range(lines):
+        kind = i % 20
+        if kind == 0:
+            warning_type = WARNING_TYPES[i % len(WARNING_TYPES)]
+            out.append(
+                f"\x1b[1msrc/core/module_{i % 300}.cpp:{i % 900 + 1}:{i % 40 + 1}: "
+                f"\x1b[35mwarning:\x1b[0m unused variable 'value_{i}' [-W{warning_type}]"
+            )
+        elif kind == 10:
+            out.append(
+                f"include/argos/header_{i % 25}.h:{i % 50 + 1}:5: warning: "
+                f"comparison of integer expressions of different signedness [-Wsign-compare]"
+            )
+        elif kind == 15:
+            out.append(
+                f"src\\win\\file_{i % 80}.cpp({i % 500 + 1},9): warning C4101: 'tmp': unused"
+            )
+        else:
+            out.append(
+                f"[{i * 100 // max(lines, 1):3d}%] Building CXX object "
+                f"src/CMakeFiles/core.dir/module_{i % 300}.cpp.o"
+            )
+    return "\n".join(out) + "\n"
+
+
+@lru_cache(maxsize=None)
+def build_log_bytes(size: int) -> bytes:
+    """
+    Repeat the synthetic build log up to a size in bytes.
+
+    Args:
+        size: Length of the result in bytes
+
+    Returns:
+        UTF-8 build log, cut at a line boundary where possible
+    """
+    chunk = build_log(20_000).encode()
+    data = (chunk * (size // len(chunk) + 1))[:size]
+    end = data.rfind(b"\n") + 1
+    return data[:end] if end else data
+
+
+@lru_cache(maxsize=None)
+def pytest_log(tests: int) -> str:
+    """
+    Synthesize verbose pytest CI output with failures and durations.
+
+    Two percent of the tests fail, each with a traceback section and a short
+    summary line; the slowest durations section lists every tenth test.
+
+    Args:
+        tests: Number of test results
+
+    Returns:
+        Pytest log text
+    """
+    nodeids = [f"tests/unit/test_module_{i % 200}.py::test_case_{i}" for i in range(tests)]
+    failed = set(range(7, tests, 50))
+    out = ["=" * 30 + " test session starts " + "=" * 30]
+    for i, nodeid in enumerate(nodeids):
+        outcome = "FAILED" if i in failed else ("SKIPPED" if i % 97 == 0 else "PASSED")
+        out.append(f"{nodeid} {outcome}{' ' * 20}[{i * 100 // max(tests, 1):3d}%]")
+    out.append("=" * 35 + " FAILURES " + "=" * 35)
+    for i in sorted(failed):
+        out.append(f"{'_' * 20} test_case_{i} {'_' * 20}")
+        out.append(f"    def test_case_{i}():")
+        out.append(f">       assert compute({i}) == {i + 1}")
+        out.append(f"E       assert {i} == {i + 1}")
+        out.append(f"tests/unit/test_module_{i % 200}.py:{i % 300 + 1}: AssertionError")
+    out.append("=" * 30 + " slowest durations " + "=" * 30)
+    for i in range(0, tests, 10):
+        out.append(f"{(i % 700) / 100:.2f}s call     {nodeids[i]}")
+    out.append("=" * 30 + " short test summary info " + "=" * 30)
+    for i in sorted(failed):
+        out.append(f"FAILED {nodeids[i]} - assert {i} == {i + 1}")
+    out.append(
+        f"{'=' * 10} {len(failed)} failed, {tests - len(failed)} passed in 12.34s {'=' * 10}"
+    )
+    return "\n".join(out) + "\n"
+
+
+@lru_cache(maxsize=None)
+def tool_corpus(tool: str, count: int) -> str:
+    """
+    Generate C++ tool output with the corpus generator.
+
+    Args:
+        tool: Corpus format name (see CorpusGenerator.available_formats)
+        count: Number of diagnostics or test cases
+
+    Returns:
+        Tool output text
+    """
+    from anvil.testing.corpus_generator import CorpusGenerator
+
+    return CorpusGenerator(seed=0).generate(tool, count)[0]
+
+
+def _test_case_records(run_ids: Sequence[int], tests: int) -> List[Any]:
+    """Test case records for each run, with a failing and a flaky minority."""
+    from anvil.storage.statistics_database import TestCaseRecord
+
+    return [
+        TestCaseRecord(
+            run_id=run_id,
+            test_name=f"test_case_{t}",
+            test_suite=f"tests.test_module_{t % 50}",
+            passed=not (t % 20 == 0 and (run_id + t) % 3 == 0),
+            skipped=False,
+            duration_seconds=0.01 * (t % 13),
+            failure_message=None,
+        )
+        for run_id in run_ids
+        for t in range(tests)
+    ]
+
+
+def _validation_runs(count: int) -> List[Any]:
+    """Hourly validation runs on main."""
+    from anvil.storage.statistics_database import ValidationRun
+
+    start = datetime(2026, 1, 1)
+    return [
+        ValidationRun(
+            timestamp=start + timedelta(hours=i),
+            git_commit=f"{i:040x}",
+            git_branch="main",
+            incremental=i % 2 == 0,
+            passed=i % 10 != 0,
+            duration_seconds=120.0,
+        )
+        for i in range(count)
+    ]
+
+
+def _setup_extract_warnings(size: int, workdir: Path) -> Callable[[], Any]:
+    from forge.inspector.build_inspector import BuildInspector
+
+    log = build_log(size)
+    return lambda: BuildInspector().extract_warnings(log)
+
+
+@lru_cache(maxsize=1)
+def scale_project(units: int, workdir: Path) -> Any:
+    """
+    Generate a synthetic CMake project once for all rounds of a benchmark.
+
+    Args:
+        units: Translation units to generate
+        workdir: Benchmark scratch directory
+
+    Returns:
+        ProjectManifest of the project
+    """
+    from forge.testing.project_generator import ProjectSpec, generate_project
+
+    spec = ProjectSpec(translation_units=units, libraries=max(1, min(units // 50, 200)))
+    return generate_project(workdir / "project", spec)
+
+
+def _setup_scale_configure(size: int, workdir: Path) -> Callable[[], Any]:
+    from forge.cmake.executor import CMakeExecutor
+    from forge.inspector.build_inspector import BuildInspector
+
+    project = scale_project(size, workdir).root
+    build_dir = Path(tempfile.mkdtemp(prefix="build-", dir=workdir))
+    command = ["cmake", "-S", str(project), "-B", str(build_dir)]
+
+    def configure():
+        result = CMakeExecutor().execute_configure(command, stream_output=False)
+        if not result.success:
+            raise RuntimeError(f"CMake configure failed: {result.stderr}")
+        BuildInspector().inspect_configure_output(result.stdout)
+
+    return configure
+
+
+def _setup_scale_inspect_build(size: int, workdir: Path) -> Callable[[], Any]:
+    from forge.inspector.build_inspector import BuildInspector
+
+    manifest = scale_project(size, workdir)
+    output = manifest.synthesize_build_output()
+    return lambda: BuildInspector().inspect_build_output(output, manifest.root)
+
+
+def _setup_scale_save_build(size: int, workdir: Path) -> Callable[[], Any]:
+    from forge.inspector.build_inspector import BuildInspector
+    from forge.models.results import BuildResult
+    from forge.storage.data_persistence import DataPersistence
+
+    manifest = scale_project(size, workdir)
+    output = manifest.synthesize_build_output()
+    metadata = BuildInspector().inspect_build_output(output, manifest.root)
+    now = datetime.now()
+    result = BuildResult(
+        success=True,
+        exit_code=0,
+        stdout=output,
+        stderr="",
+        duration=1.0,
+        start_time=now,
+        end_time=now,
+    )
+    db_path = Path(tempfile.mkstemp(suffix=".db", dir=workdir)[1])
+    db_path.unlink()
+
+    def save_build():
+        with DataPersistence(db_path) as persistence:
+            build_id = persistence.save_build(result, metadata, None)
+            persistence.save_warnings(build_id, metadata.warnings)
+
+    return save_build
+
+
+def _setup_index_lines_bytes(size: int, workdir: Path) -> Callable[[], Any]:
+    from anvil.parsers.log_scan import index_lines
+
+    data = build_log_bytes(size)
+    return lambda: index_lines(data)
+
+
+def _setup_index_lines_str(size: int, workdir: Path) -> Callable[[], Any]:
+    from anvil.parsers.log_scan import index_lines
+
+    text = build_log_bytes(size).decode()
+    return lambda: index_lines(text)
+
+
+def _setup_parse_log_lines(size: int, workdir: Path) -> Callable[[], Any]:
+    from scout.log_retrieval import LogParser
+
+    log = build_log(size)
+    return lambda: LogParser.parse_log_lines(log)
+
+
+def _setup_clang_tidy(size: int, workdir: Path) -> Callable[[], Any]:
+    from anvil.parsers.clang_tidy_parser import ClangTidyParser
+
+    output = tool_corpus("clang-tidy", size)
+    return lambda: ClangTidyParser.parse_yaml(output, [], {})
+
+
+def _setup_cppcheck(size: int, workdir: Path) -> Callable[[], Any]:
+    from anvil.parsers.cppcheck_parser import CppcheckParser
+
+    output = tool_corpus("cppcheck", size)
+    return lambda: CppcheckParser.parse_xml(output, [], {})
+
+
+def _setup_gtest(size: int, workdir: Path) -> Callable[[], Any]:
+    from anvil.parsers.gtest_parser import GTestParser
+
+    output = tool_corpus("gtest-json", size)
+    return lambda: GTestParser().parse_output(output, [])
+
+
+def _setup_pytest_log(size: int, workdir: Path) -> Callable[[], Any]:
+    from scout.parsers.ci_log_parser import CILogParser
+
+    log = pytest_log(size)
+    return lambda: CILogParser().parse_pytest_log(log)
+
+
+def _fresh_statistics_database(workdir: Path) -> Any:
+    """Open a new, empty statistics database in the scratch directory."""
+    from anvil.storage.statistics_database import StatisticsDatabase
+
+    path = Path(tempfile.mkstemp(suffix=".db", dir=workdir)[1])
+    path.unlink()
+    return StatisticsDatabase(path)
+
+
+def _setup_batch_insert(size: int, workdir: Path) -> Callable[[], Any]:
+    db = _fresh_statistics_database(workdir)
+    run_ids = db.insert_validation_runs_batch(_validation_runs(10))
+    records = _test_case_records(run_ids, size // len(run_ids))
+
+    def insert():
+        db.insert_test_case_records_batch(records)
+        db.close()
+
+    return insert
+
+
+def _setup_filter_tests(size: int, workdir: Path) -> Callable[[], Any]:
+    from anvil.storage.smart_filter import SmartFilter
+
+    db = _fresh_statistics_database(workdir)
+    run_ids = db.insert_validation_runs_batch(_validation_runs(20))
+    db.insert_test_case_records_batch(_test_case_records(run_ids, size))
+    available = [(f"test_case_{t}", f"tests.test_module_{t % 50}") for t in range(size)]
+    smart_filter = SmartFilter(db)
+
+    def filter_tests():
+        smart_filter.filter_tests(available, prioritize_flaky=True)
+        db.close()
+
+    return filter_tests
+
+
+def _setup_compare_local_vs_ci(size: int, workdir: Path) -> Callable[[], Any]:
+    import json
+
+    from anvil.storage.ci_storage import CIStorageLayer
+    from anvil.storage.execution_schema import ExecutionDatabase
+
+    db = ExecutionDatabase(str(Path(tempfile.mkdtemp(dir=workdir)) / "history.db"))
+    now = datetime.now()
+    platforms = ["ubuntu-latest", "windows-latest", "macos-latest"]
+    rows = []
+    for test in range(size):
+        entity_id = f"tests/test_module_{test % 500}.py::test_case_{test}"
+        for run in range(2):
+            timestamp = (now - timedelta(hours=run * 12 + test % 7)).isoformat()
+            rows.append((f"local-{run}", entity_id, timestamp, "PASSED", 0.1, "local", None))
+        for run, platform in enumerate(platforms):
+            status = "FAILED" if (test + run) % 20 == 0 else "PASSED"
+            timestamp = (now - timedelta(hours=run * 6 + test % 5)).isoformat()
+            metadata = json.dumps({"platform": platform})
+            rows.append((f"ci-{run}", entity_id, timestamp, status, 0.2, "ci", metadata))
+    db.connection.executemany(
+        """
+        INSERT INTO execution_history
+            (execution_id, entity_id, entity_type, timestamp, status, duration, space, metadata)
+        VALUES (?, ?, 'test', ?, ?, ?, ?, ?)
+        """,
+        rows,
+    )
+    db.connection.commit()
+    return CIStorageLayer(db).compare_local_vs_ci
+
+
+def _setup_platform_specific_failures(size: int, workdir: Path) -> Callable[[], Any]:
+    import json
+
+    from anvil.storage.ci_storage import CIStorageLayer
+    from anvil.storage.execution_schema import ExecutionDatabase
+
+    db = ExecutionDatabase(str(Path(tempfile.mkdtemp(dir=workdir)) / "history.db"))
+    now = datetime.now()
+    matrix = [
+        json.dumps({"platform": runner_os, "compiler": compiler, "build_type": build_type})
+        for runner_os, compiler, build_type in [
+            ("windows-latest", "msvc", "Debug"),
+            ("windows-latest", "msvc", "Release"),
+            ("windows-latest", "clang", "Release"),
+            ("ubuntu-latest", "gcc", "Release"),
+            ("ubuntu-latest", "clang", "Debug"),
+            ("macos-latest", "clang", "Release"),
+        ]
+    ]
+    rows = []
+    for test in range(size):
+        entity_id = f"tests/test_module_{test % 500}.py::test_case_{test}"
+        for night in range(10):
+            timestamp = (now - timedelta(days=night, minutes=test % 60)).isoformat()
+            for job, metadata in enumerate(matrix):
+                # 2% fail with MSVC every night, 5% fail once somewhere
+                failing = (test % 50 == 0 and job < 2) or (test % 20 == 1 and night == job)
+                status = "FAILED" if failing else "PASSED"
+                rows.append((f"ci-{night}-{job}", entity_id, timestamp, status, metadata))
+    db.connection.executemany(
+        """
+        INSERT INTO execution_history
+            (execution_id, entity_id, entity_type, timestamp, status, duration, space, metadata)
+        VALUES (?, ?, 'test', ?, ?, 0.2, 'ci', ?)
+        """,
+        rows,
+    )
+    db.connection.commit()
+    return CIStorageLayer(db).get_platform_specific_failures
+
+
+BENCHMARKS: List[Benchmark] = [
+    Benchmark(
+        "forge.extract_warnings",
+        {"full": 200_000, "quick": 10_000},
+        "lines",
+        _setup_extract_warnings,
+        requires="forge.inspector.build_inspector",
+    ),
+    Benchmark(
+        "forge.scale.configure",
+        {"full": 2_000, "quick": 50},
+        "translation_units",
+        _setup_scale_configure,
+        requires="forge.testing.project_generator",
+        programs=("cmake",),
+    ),
+    Benchmark(
+        "forge.scale.inspect_build_output",
+        {"full": 20_000, "quick": 500},
+        "translation_units",
+        _setup_scale_inspect_build,
+        requires="forge.testing.project_generator",
+    ),
+    Benchmark(
+        "forge.scale.save_build",
+        {"full": 20_000, "quick": 500},
+        "translation_units",
+        _setup_scale_save_build,
+        requires="forge.testing.project_generator",
+    ),
+    Benchmark(
+        "anvil.log_scan.index_lines_bytes",
+        {"full": 256_000_000, "quick": 4_000_000},
+        "bytes",
+        _setup_index_lines_bytes,
+    ),
+    Benchmark(
+        "anvil.log_scan.index_lines_str",
+        {"full": 256_000_000, "quick": 4_000_000},
+        "bytes",
+        _setup_index_lines_str,
+    ),
+    Benchmark(
+        "anvil.parse.clang_tidy_yaml",
+        {"full": 1_000, "quick": 100},
+        "diagnostics",
+        _setup_clang_tidy,
+    ),
+    Benchmark(
+        "anvil.parse.cppcheck_xml",
+        {"full": 20_000, "quick": 1_000},
+        "diagnostics",
+        _setup_cppcheck,
+    ),
+    Benchmark(
+        "anvil.parse.gtest_json",
+        {"full": 50_000, "quick": 2_000},
+        "tests",
+        _setup_gtest,
+    ),
+    Benchmark(
+        "scout.parse_pytest_log",
+        {"full": 10_000, "quick": 500},
+        "tests",
+        _setup_pytest_log,
+        requires="scout.parsers.ci_log_parser",
+    ),
+    Benchmark(
+        "scout.parse_log_lines",
+        {"full": 200_000, "quick": 10_000},
+        "lines",
+        _setup_parse_log_lines,
+        requires="scout.log_retrieval",
+    ),
+    Benchmark(
+        "anvil.db.insert_test_case_records_batch",
+        {"full": 50_000, "quick": 2_000},
+        "records",
+        _setup_batch_insert,
+    ),
+    Benchmark(
+        "anvil.smart_filter.filter_tests",
+        {"full": 2_000, "quick": 100},
+        "tests",
+        _setup_filter_tests,
+    ),
+    Benchmark(
+        "anvil.ci.compare_local_vs_ci",
+        {"full": 50_000, "quick": 2_000},
+        "tests",
+        _setup_compare_local_vs_ci,
+    ),
+    Benchmark(
+        "anvil.ci.platform_specific_failures",
+        {"full": 10_000, "quick": 500},
+        "tests",
+        _setup_platform_specific_failures,
+    ),
+]
+
+
+def select_benchmarks(
+    patterns: Optional[Sequence[str]] = None, benchmarks: Optional[Sequence[Benchmark]] = None
+) -> List[Benchmark]:
+    """
+    Select benchmarks whose names match any of the glob patterns.
+
+    Args:
+        patterns: Glob patterns such as "anvil.parse.*" (default: all)
+        benchmarks: Benchmarks to select from (default: the built-in suite)
+
+    Returns:
+        Matching benchmarks in suite order
+    """
+    benchmarks = BENCHMARKS if benchmarks is None else benchmarks
+    if not patterns:
+        return list(benchmarks)
+    return [b for b in benchmarks if any(fnmatch.fnmatchcase(b.name, p) for p in patterns)]
+
+
+def run_benchmark(
+    benchmark: Benchmark,
+    scale: str = "full",
+    repeat: int = DEFAULT_REPEAT,
+    timer: Callable[[], float] = time.perf_counter,
+) -> BenchmarkResult:
+    """
+    Run one benchmark: an untimed warmup round, then `repeat` timed rounds.
+
+    Args:
+        benchmark: Benchmark to run
+        scale: Suite scale selecting the input size
+        repeat: Number of timed rounds
+        timer: Clock returning seconds
+
+    Returns:
+        Benchmark result, marked skipped if its package is not importable
+        or a program it runs is not installed
+    """
+    size = benchmark.sizes[scale]
+    result = BenchmarkResult(benchmark.name, size, benchmark.unit)
+    if benchmark.requires:
+        try:
+            importlib.import_module(benchmark.requires)
+        except ImportError as e:
+            result.skipped = str(e)
+            return result
+    missing = [program for program in benchmark.programs if shutil.which(program) is None]
+    if missing:
+        result.skipped = f"{', '.join(missing)} not found on PATH"
+        return result
+
+    with tempfile.TemporaryDirectory(prefix="anvil-bench-") as workdir:
+        for round_number in range(repeat + 1):
+            operation = benchmark.setup(size, Path(workdir))
+            start = timer()
+            operation()
+            elapsed = timer() - start
+            if round_number:
+                result.times.append(elapsed)
+    return result
+
+
+def run_benchmarks(
+    benchmarks: Sequence[Benchmark],
+    scale: str = "full",
+    repeat: int = DEFAULT_REPEAT,
+    progress: Optional[Callable[[BenchmarkResult], None]] = None,
+) -> List[BenchmarkResult]:
+    """
+    Run benchmarks one after another.
+
+    Args:
+        benchmarks: Benchmarks to run
+        scale: Suite scale selecting the input sizes
+        repeat: Number of timed rounds per benchmark
+        progress: Called with each result as soon as it is available
+
+    Returns:
+        Results in the order the benchmarks were given
+
+    Raises:
+        ValueError: If scale or repeat is invalid
+    """
+    if scale not in SCALES:
+        raise ValueError(f"Unknown scale '{scale}'. Expected one of: {', '.join(SCALES)}")
+    if repeat < 1:
+        raise ValueError(f"Repeat must be at least 1: {repeat}")
+
+    results = []
+    for benchmark in benchmarks:
+        result = run_benchmark(benchmark, scale, repeat)
+        results.append(result)
+        if progress:
+            progress(result)
+    return results
@@ -0,0 +1,783 @@
+"""
+Synthetic stress corpora for C++ tool output parsers.
+
+This module synthesizes realistic, arbitrarily large outputs for the C++
+tools Anvil parses (clang-tidy, cppcheck, cpplint, IWYU, clang-format and
+Google Test), so every parser's throughput and memory can be measured on
+inputs far larger than the hand-written fixtures.
+
+Corpora are produced as a stream of text chunks, so 10M-diagnostic outputs
+can be written to disk without materializing them in memory. Generation is
+deterministic for a given seed, and the expected parse summary is tallied
+while the corpus is streamed.
+
+The generated corpora can be written as Verdict benchmark suites (folder
+cases plus a config.yaml) that run against the parser adapters in
+anvil.validators.adapters.
+"""
+
+import json
+import random
+import re
+from collections import Counter
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Any, Callable, Dict, Iterator, List, Optional, Sequence
+from xml.sax.saxutils import quoteattr
+
+import yaml
+
+# Diagnostics are emitted in batches of this many per yielded chunk
+CHUNK_SIZE = 2000
+
+# Size suffixes accepted by parse_size()
+SIZE_SUFFIXES = {"": 1, "K": 1_000, "M": 1_000_000}
+
+# Default benchmark sizes (1K-10M diagnostics)
+DEFAULT_SIZES = [1_000, 10_000, 100_000, 1_000_000, 10_000_000]
+
+SOURCE_DIRS = ["src/core", "src/io", "src/net", "src/util", "include/argos", "tests"]
+SOURCE_STEMS = ["parser", "buffer", "socket", "logger", "config", "matrix", "cache", "stream"]
+
+CLANG_TIDY_CHECKS = [
+    ("modernize-use-nullptr", "use nullptr"),
+    ("modernize-use-override", "annotate this function with 'override' or (rarely) 'final'"),
+    ("readability-braces-around-statements", "statement should be inside braces"),
+    ("performance-unnecessary-value-param", "the parameter 'value' is copied for each invocation"),
+    ("bugprone-narrowing-conversions", "narrowing conversion from 'long' to 'int'"),
+    ("cppcoreguidelines-pro-type-reinterpret-cast", "do not use reinterpret_cast"),
+]
+CLANG_TIDY_LEVELS = ["Warning", "Warning", "Warning", "Error"]
+
+CPPCHECK_ERRORS = [
+    ("nullPointer", "error", "Null pointer dereference: ptr", "476"),
+    ("uninitvar", "error", "Uninitialized variable: count", "457"),
+    ("unusedVariable", "style", "Unused variable: tmp", "563"),
+    (
+        "passedByValue",
+        "performance",
+        "Function parameter 'name' should be passed by const reference.",
+        "398",
+    ),
+    ("shadowVariable", "style", "Local variable 'index' shadows outer variable", "398"),
+    ("knownConditionTrueFalse", "style", "Condition 'size>0' is always true", "571"),
+    ("unreadVariable", "style", "Variable 'result' is assigned a value that is never used.", "563"),
+    ("missingIncludeSystem", "information", "Include file: <vector> not found.", None),
+]
+
+CPPLINT_VIOLATIONS = [
+    ("Extra space after ( in function call", "whitespace/parens", 4),
+    ("Lines should be <= 80 characters long", "whitespace/line_length", 2),
+    ("Missing space before {", "whitespace/braces", 5),
+    ("Using C-style cast.  Use static_cast<int>(...) instead", "readability/casting", 4),
+    ("Is this a non-const reference? If so, make const or use a pointer", "runtime/references", 2),
+    ("Include the directory when naming .h files", "build/include_subdir", 4),
+    (
+        "Do not use namespace using-directives.  Use using-declarations instead.",
+        "build/namespaces",
+        5,
+    ),
+    ("Should have a space between // and comment", "whitespace/comments", 4),
+]
+
+IWYU_HEADERS = ["vector", "string", "map", "memory", "cstdint", "utility", "algorithm", "iosfwd"]
+IWYU_FWD_DECLS = ["class Buffer;", "struct Options;", "class Logger;", "struct Config;"]
+
+GTEST_SUITES = ["ParserTest", "BufferTest", "SocketTest", "CacheTest", "MatrixTest"]
+
+
+def parse_size(text: str) -> int:
+    """
+    Parse a corpus size such as "1000", "10K" or "10M".
+
+    Args:
+        text: Size string with an optional K/M suffix
+
+    Returns:
+        Number of diagnostics
+
+    Raises:
+        ValueError: If the size string is malformed or not positive
+    """
+    match = re.fullmatch(r"\s*(\d+)\s*([kKmM]?)\s*", text)
+    if not match:
+        raise ValueError(f"Invalid corpus size: {text!r}")
+
+    size = int(match.group(1)) * SIZE_SUFFIXES[match.group(2).upper()]
+    if size <= 0:
+        raise ValueError(f"Corpus size must be positive: {text!r}")
+    return size
+
+
+def _yaml_quote(text: str) -> str:
+    """
+    Quote a string as a single-quoted YAML scalar, as clang-tidy does.
+
+    Args:
+        text: String to quote
+
+    Returns:
+        Single-quoted scalar with embedded quotes doubled
+    """
+    return "'" + text.replace("'", "''") + "'"
+
+
+def format_size(size: int) -> str:
+    """
+    Format a corpus size compactly (e.g., 10000 -> "10K").
+
+    Args:
+        size: Number of diagnostics
+
+    Returns:
+        Compact size label used in case names
+    """
+    for suffix, factor in (("M", 1_000_000), ("K", 1_000)):
+        if size >= factor and size % factor == 0:
+            return f"{size // factor}{suffix}"
+    return str(size)
+
+
+@dataclass
+class CorpusSummary:
+    """
+    Expected parse summary of a generated corpus.
+
+    Attributes:
+        validator: Validator name reported by the parser
+        diagnostics: Number of diagnostics synthesized
+        errors: Expected number of error issues
+        warnings: Expected number of warning issues
+        by_rule: Expected issue counts keyed by rule name
+    """
+
+    validator: str
+    diagnostics: int = 0
+    errors: int = 0
+    warnings: int = 0
+    by_rule: Counter = field(default_factory=Counter)
+
+    def add(self, rule_name: str, severity: str) -> None:
+        """
+        Record one expected issue.
+
+        Args:
+            rule_name: Rule name the parser will report
+            severity: Expected severity ("error" or "warning")
+        """
+        if severity == "error":
+            self.errors += 1
+        else:
+            self.warnings += 1
+        self.by_rule[rule_name] += 1
+
+    def to_expected(self) -> Dict[str, Any]:
+        """
+        Convert summary to a Verdict expected-output dictionary.
+
+        Returns:
+            Dictionary matching the shape returned by the C++ parser adapters
+        """
+        return {
+            "validator": self.validator,
+            "passed": self.errors == 0 and self.warnings == 0,
+            "errors": self.errors,
+            "warnings": self.warnings,
+            "by_rule": dict(sorted(self.by_rule.items())),
+        }
+
+
+@dataclass
+class CorpusFormat:
+    """
+    Description of a synthesizable tool output format.
+
+    Attributes:
+        name: Corpus format name (e.g., "clang-tidy")
+        validator: Validator name reported by the matching parser
+        adapter: Dotted path to the Verdict adapter for this format
+        emit: Bound generator method producing text chunks
+    """
+
+    name: str
+    validator: str
+    adapter: Optional[str]
+    emit: Callable[[int, CorpusSummary], Iterator[str]]
+
+
+class CorpusGenerator:
+    """
+    Deterministic generator of large C++ tool output corpora.
+
+    Each format generator streams text chunks and records the issues the
+    corresponding Anvil parser is expected to report into a CorpusSummary.
+
+    Example:
+        >>> generator = CorpusGenerator(seed=1)
+        >>> text, summary = generator.generate("cpplint", 1000)
+        >>> summary.diagnostics
+        1000
+    """
+
+    def __init__(self, seed: int = 0, files: int = 500):
+        """
+        Initialize corpus generator.
+
+        Args:
+            seed: Random seed; the same seed always yields the same corpus
+            files: Number of distinct source files diagnostics are spread over
+        """
+        self.seed = seed
+        self.source_files = self._make_source_files(max(1, files))
+        self.formats: Dict[str, CorpusFormat] = {
+            fmt.name: fmt
+            for fmt in [
+                CorpusFormat(
+                    "clang-tidy",
+                    "clang-tidy",
+                    "anvil.validators.adapters.validate_clang_tidy_parser",
+                    self._emit_clang_tidy,
+                ),
+                CorpusFormat(
+                    "cppcheck",
+                    "cppcheck",
+                    "anvil.validators.adapters.validate_cppcheck_parser",
+                    self._emit_cppcheck,
+                ),
+                CorpusFormat(
+                    "cpplint",
+                    "cpplint",
+                    "anvil.validators.adapters.validate_cpplint_parser",
+                    self._emit_cpplint,
+                ),
+                CorpusFormat(
+                    "iwyu",
+                    "iwyu",
+                    "anvil.validators.adapters.validate_iwyu_parser",
+                    self._emit_iwyu,
+                ),
+                CorpusFormat(
+                    "clang-format",
+                    "clang-format",
+                    "anvil.validators.adapters.validate_clang_format_parser",
+                    self._emit_clang_format,
+                ),
+                CorpusFormat(
+                    "gtest-json",
+                    "gtest",
+                    "anvil.validators.adapters.validate_gtest_parser",
+                    self._emit_gtest_json,
+                ),
+                # No Anvil parser consumes gtest XML yet; generated for raw throughput runs
+                CorpusFormat("gtest-xml", "gtest", None, self._emit_gtest_xml),
+            ]
+        }
+
+    def available_formats(self) -> List[str]:
+        """
+        List supported corpus formats.
+
+        Returns:
+            Sorted list of format names
+        """
+        return sorted(self.formats)
+
+    def iter_corpus(self, tool: str, count: int, summary: CorpusSummary) -> Iterator[str]:
+        """
+        Stream a corpus as text chunks.
+
+        The summary is filled in as chunks are produced, so it is only
+        complete once the iterator is exhausted.
+
+        Args:
+            tool: Corpus format name
+            count: Number of diagnostics to synthesize
+            summary: Summary to record expected issues into
+
+        Returns:
+            Iterator of text chunks
+
+        Raises:
+            ValueError: If the format is unknown or count is negative
+        """
+        fmt = self._get_format(tool)
+        if count < 0:
+            raise ValueError(f"Diagnostic count must not be negative: {count}")
+        summary.diagnostics = count
+        return fmt.emit(count, summary)
+
+    def generate(self, tool: str, count: int) -> "tuple[str, CorpusSummary]":
+        """
+        Generate a complete corpus in memory.
+
+        Args:
+            tool: Corpus format name
+            count: Number of diagnostics to synthesize
+
+        Returns:
+            Tuple of (corpus text, expected summary)
+        """
+        summary = CorpusSummary(validator=self._get_format(tool).validator)
+        text = "".join(self.iter_corpus(tool, count, summary))
+        return text, summary
+
+    def write(self, tool: str, count: int, path: Path) -> CorpusSummary:
+        """
+        Stream a corpus to a file without holding it in memory.
+
+        Args:
+            tool: Corpus format name
+            count: Number of diagnostics to synthesize
+            path: Destination file path
+
+        Returns:
+            Expected summary for the written corpus
+        """
+        path = Path(path)
+        path.parent.mkdir(parents=True, exist_ok=True)
+        summary = CorpusSummary(validator=self._get_format(tool).validator)
+
+        with open(path, "w", encoding="utf-8", newline="\n") as f:
+            for chunk in self.iter_corpus(tool, count, summary):
+                f.write(chunk)
+
+        return summary
+
+    def write_benchmark_suites(
+        self,
+        output_dir: Path,
+        sizes: Sequence[int],
+        tools: Optional[Sequence[str]] = None,
+    ) -> Path:
+        """
+        Write corpora as Verdict benchmark suites.
+
+        Layout:
+            output_dir/
+              config.yaml
+              clang-tidy/
+                clang-tidy_1K/
+                  input.txt
+                  expected_output.yaml
+
+        Formats without a parser adapter are written but not registered
+        as suites in config.yaml.
+
+        Args:
+            output_dir: Directory to write suites into
+            sizes: Diagnostic counts to generate for each format
+            tools: Formats to generate (default: all formats)
+
+        Returns:
+            Path to the generated Verdict config.yaml
+        """
+        output_dir = Path(output_dir)
+        tools = list(tools) if tools else self.available_formats()
+
+        test_suites = []
+        targets = {}
+
+        for tool in tools:
+            fmt = self._get_format(tool)
+            for size in sizes:
+                case_dir = output_dir / tool / f"{tool}_{format_size(size)}"
+                summary = self.write(tool, size, case_dir / "input.txt")
+                with open(case_dir / "expected_output.yaml", "w", encoding="utf-8") as f:
+                    yaml.safe_dump(summary.to_expected(), f, sort_keys=False)
+
+            if fmt.adapter is None:
+                continue
+
+            target_id = tool.replace("-", "_")
+            targets[target_id] = {"callable": fmt.adapter}
+            test_suites.append(
+                {
+                    "name": f"{target_id}_corpus",
+                    "target": target_id,
+                    "type": "cases_in_folder",
+                    "folder": tool,
+                }
+            )
+
+        config = {
+            # Serial execution keeps per-case timings comparable across runs
+            "settings": {"max_workers": 1},
+            "test_suites": test_suites,
+            "targets": targets,
+        }
+        config_path = output_dir / "config.yaml"
+        with open(config_path, "w", encoding="utf-8") as f:
+            yaml.safe_dump(config, f, sort_keys=False)
+
+        return config_path
+
+    def _get_format(self, tool: str) -> CorpusFormat:
+        """
+        Look up a corpus format by name.
+
+        Args:
+            tool: Corpus format name
+
+        Returns:
+            Matching CorpusFormat
+
+        Raises:
+            ValueError: If the format is unknown
+        """
+        if tool not in self.formats:
+            raise ValueError(
+                f"Unknown corpus format: {tool}. "
+                f"Available formats: {', '.join(self.available_formats())}"
+            )
+        return self.formats[tool]
+
+    def _rng(self, tool: str) -> random.Random:
+        """
+        Create a per-format random generator so formats are independent.
+
+        Args:
+            tool: Corpus format name
+
+        Returns:
+            Seeded Random instance
+        """
+        return random.Random(f"{self.seed}:{tool}")
+
+    @staticmethod
+    def _make_source_files(count: int) -> List[str]:
+        """
+        Build a pool of realistic C++ source paths.
+
+        Args:
+            count: Number of paths to create
+
+        Returns:
+            List of relative source file paths
+        """
+        paths = []
+        for i in range(count):
+            directory = SOURCE_DIRS[i % len(SOURCE_DIRS)]
+            stem = SOURCE_STEMS[(i // len(SOURCE_DIRS)) % len(SOURCE_STEMS)]
+            ext = ".hpp" if directory.startswith("include") else ".cpp"
+            paths.append(f"{directory}/{stem}_{i}{ext}")
+        return paths
+
+    def _emit_clang_tidy(self, count: int, summary: CorpusSummary) -> Iterator[str]:
+        """Emit clang-tidy --export-fixes YAML."""
+        rng = self._rng("clang-tidy")
+        yield "---\nMainSourceFile: 'src/main.cpp'\n"
+
+        if count == 0:
+            yield "Diagnostics:     []\n...\n"
+            return
+
+        yield "Diagnostics:\n"
+
+        buffer = []
+        for i in range(count):
+            check, message = CLANG_TIDY_CHECKS[i % len(CLANG_TIDY_CHECKS)]
+            level = CLANG_TIDY_LEVELS[i % len(CLANG_TIDY_LEVELS)]
+            file_path = rng.choice(self.source_files)
+            offset = rng.randrange(0, 200_000)
+
+            entry = (
+                f"  - DiagnosticName:  {check}\n"
+                f"    DiagnosticMessage:\n"
+                f"      Message:         {_yaml_quote(message)}\n"
+                f"      FilePath:        '{file_path}'\n"
+                f"      FileOffset:      {offset}\n"
+            )
+            if i % 3 == 0:
+                entry += (
+                    f"      Replacements:\n"
+                    f"        - FilePath:        '{file_path}'\n"
+                    f"          Offset:          {offset}\n"
+                    f"          Length:          1\n"
+                    f"          ReplacementText: 'nullptr'\n"
+                )
+            else:
+                entry += "      Replacements:    []\n"
+            entry += f"    Level:           {level}\n"
+            buffer.append(entry)
+
+            summary.add(check, "error" if level == "Error" else "warning")
+
+            if len(buffer) >= CHUNK_SIZE:
+                yield "".join(buffer)
+                buffer = []
+
+        if buffer:
+            yield "".join(buffer)
+        yield "...\n"
+
+    def _emit_cppcheck(self, count: int, summary: CorpusSummary) -> Iterator[str]:
+        """Emit cppcheck --xml --xml-version=2 output."""
+        rng = self._rng("cppcheck")
+        yield (
+            '<?xml version="1.0" encoding="UTF-8"?>\n'
+            '<results version="2">\n'
+            '    <cppcheck version="2.13.0"/>\n'
+            "    <errors>\n"
+        )
+
+        buffer = []
+        for i in range(count):
+            error_id, severity, msg, cwe = CPPCHECK_ERRORS[i % len(CPPCHECK_ERRORS)]
+            file_path = rng.choice(self.source_files)
+            line = rng.randint(1, 5000)
+            column = rng.randint(1, 80)
+            cwe_attr = f' cwe="{cwe}"' if cwe else ""
+
+            buffer.append(
+                f'        <error id="{error_id}" severity="{severity}" '
+                f"msg={quoteattr(msg)} verbose={quoteattr(msg)}{cwe_attr}>\n"
+                f'            <location file="{file_path}" line="{line}" column="{column}"/>\n'
+                f"        </error>\n"
+            )
+            summary.add(error_id, "error" if severity == "error" else "warning")
+
+            if len(buffer) >= CHUNK_SIZE:
+                yield "".join(buffer)
+                buffer = []
+
+        if buffer:
+            yield "".join(buffer)
+        yield "    </errors>\n</results>\n"
+
+    def _emit_cpplint(self, count: int, summary: CorpusSummary) -> Iterator[str]:
+        """Emit cpplint text output."""
+        rng = self._rng("cpplint")
+        buffer = []
+        for i in range(count):
+            message, category, confidence = CPPLINT_VIOLATIONS[i % len(CPPLINT_VIOLATIONS)]
+            file_path = rng.choice(self.source_files)
+            line = rng.randint(1, 5000)
+
+            buffer.append(f"{file_path}:{line}:  {message}  [{category}] [{confidence}]\n")
+            summary.add(category, "error" if confidence >= 4 else "warning")
+
+            if len(buffer) >= CHUNK_SIZE:
+                yield "".join(buffer)
+                buffer = []
+
+        if buffer:
+            yield "".join(buffer)
+        yield f"Done processing {len(self.source_files)} files\n"
+        yield f"Total errors found: {count}\n"
+
+    def _emit_iwyu(self, count: int, summary: CorpusSummary) -> Iterator[str]:
+        """Emit include-what-you-use suggestion blocks."""
+        rng = self._rng("iwyu")
+        buffer = []
+        emitted = 0
+        block = 0
+
+        while emitted < count:
+            file_path = self.source_files[block % len(self.source_files)]
+            block += 1
+            additions = min(rng.randint(1, 4), count - emitted)
+            removals = min(rng.randint(0, 3), count - emitted - additions)
+
+            lines = [f"{file_path} should add these lines:\n"]
+            for j in range(additions):
+                if j % 4 == 3:
+                    lines.append(f"{IWYU_FWD_DECLS[(block + j) % len(IWYU_FWD_DECLS)]}\n")
+                    summary.add("iwyu-add-fwd-decl", "warning")
+                else:
+                    header = IWYU_HEADERS[(block + j) % len(IWYU_HEADERS)]
+                    lines.append(f"#include <{header}>  // for {header}\n")
+                    summary.add("iwyu-add-include", "warning")
+
+            lines.append(f"\n{file_path} should remove these lines:\n")
+            for j in range(removals):
+                header = IWYU_HEADERS[(block + j + 3) % len(IWYU_HEADERS)]
+                line = rng.randint(1, 40)
+                lines.append(f"- #include <{header}>  // lines {line}-{line}\n")
+                summary.add("iwyu-remove-include", "warning")
+
+            lines.append(f"\nThe full include-list for {file_path}:\n")
+            lines.append("#include <vector>  // for vector\n")
+            lines.append("---\n\n")
+
+            buffer.append("".join(lines))
+            emitted += additions + removals
+
+            if len(buffer) >= CHUNK_SIZE // 4:
+                yield "".join(buffer)
+                buffer = []
+
+        if buffer:
+            yield "".join(buffer)
+
+    def _emit_clang_format(self, count: int, summary: CorpusSummary) -> Iterator[str]:
+        """Emit clang-format --output-replacements-xml output."""
+        rng = self._rng("clang-format")
+        yield (
+            "<?xml version='1.0'?>\n"
+            "<replacements xml:space='preserve' incomplete_format='false'>\n"
+        )
+
+        files_seen = set()
+        buffer = []
+        for i in range(count):
+            file_path = rng.choice(self.source_files)
+            offset = rng.randrange(0, 200_000)
+            length = rng.randint(0, 8)
+
+            buffer.append(
+                f"<replacement offset='{offset}' length='{length}' "
+                f"file='{file_path}'>&#10;  </replacement>\n"
+            )
+            # The parser reports one issue per file needing formatting
+            if file_path not in files_seen:
+                files_seen.add(file_path)
+                summary.add("formatting", "error")
+
+            if len(buffer) >= CHUNK_SIZE:
+                yield "".join(buffer)
+                buffer = []
+
+        if buffer:
+            yield "".join(buffer)
+        yield "</replacements>\n"
+
+    def _gtest_cases(self, count: int, summary: CorpusSummary) -> Iterator[Dict[str, Any]]:
+        """
+        Produce synthetic gtest cases shared by the JSON and XML emitters.
+
+        Every 10th test fails with a file:line message and every 50th test is
+        disabled, matching the shape of a large, mostly green C++ test run.
+        """
+        rng = self._rng("gtest")
+        for i in range(count):
+            suite = GTEST_SUITES[i % len(GTEST_SUITES)]
+            disabled = i % 50 == 49
+            failed = not disabled and i % 10 == 9
+            case = {
+                "suite": suite,
+                "name": f"{'DISABLED_' if disabled else ''}Case{i}",
+                "time": rng.randint(0, 250),
+                "disabled": disabled,
+                "failure": None,
+            }
+            # Draw location even for passing tests so the stream stays aligned
+            file_path = rng.choice(self.source_files)
+            line = rng.randint(1, 2000)
+            if disabled:
+                summary.add("disabled-test", "warning")
+            elif failed:
+                case["failure"] = (
+                    f"{file_path}:{line}\nExpected equality of these values:\n"
+                    f"  expected\n    Which is: {i}\n  actual\n    Which is: {i + 1}"
+                )
+                summary.add("test-failure", "error")
+            yield case
+
+    def _gtest_suites(self, count: int, summary: CorpusSummary) -> Iterator[tuple]:
+        """
+        Group synthetic gtest cases by suite without buffering the corpus.
+
+        The case stream is replayed once per suite (cases are deterministic),
+        trading a few extra passes for constant memory. The summary is tallied
+        on the first pass only.
+
+        Yields:
+            Tuples of (suite name, iterator of that suite's cases)
+        """
+        for index, suite in enumerate(GTEST_SUITES):
+            if index >= count:
+                break
+            tally = summary if index == 0 else CorpusSummary(summary.validator)
+            yield suite, (
+                case for case in self._gtest_cases(count, tally) if case["suite"] == suite
+            )
+
+    @staticmethod
+    def _gtest_totals(count: int) -> "tuple[int, int]":
+        """
+        Compute (failures, disabled) totals for a synthetic gtest run.
+
+        Args:
+            count: Number of synthetic tests
+
+        Returns:
+            Tuple of (failed test count, disabled test count)
+        """
+        disabled = count // 50
+        failures = count // 10 - disabled
+        return failures, disabled
+
+    def _emit_gtest_json(self, count: int, summary: CorpusSummary) -> Iterator[str]:
+        """Emit gtest --gtest_output=json output."""
+        failures, disabled = self._gtest_totals(count)
+        yield (
+            "{\n"
+            f'  "tests": {count},\n'
+            f'  "failures": {failures},\n'
+            f'  "disabled": {disabled},\n'
+            '  "errors": 0,\n'
+            '  "name": "AllTests",\n'
+            '  "testsuites": ['
+        )
+
+        for index, (suite, cases) in enumerate(self._gtest_suites(count, summary)):
+            yield f'{"," if index else ""}\n    {{"name": "{suite}", "testsuite": ['
+            separator = ""
+            buffer = []
+            for case in cases:
+                test = {
+                    "name": case["name"],
+                    "status": "NOTRUN" if case["disabled"] else "RUN",
+                    "result": "SKIPPED" if case["disabled"] else "COMPLETED",
+                    "time": f"{case['time'] / 1000:.3f}s",
+                    "classname": suite,
+                }
+                if case["failure"]:
+                    test["failures"] = [{"failure": case["failure"], "type": ""}]
+                buffer.append(json.dumps(test))
+
+                if len(buffer) >= CHUNK_SIZE:
+                    yield separator + "\n      " + ",\n      ".join(buffer)
+                    separator = ","
+                    buffer = []
+
+            if buffer:
+                yield separator + "\n      " + ",\n      ".join(buffer)
+            yield "\n    ]}"
+
+        yield "\n  ]\n}\n"
+
+    def _emit_gtest_xml(self, count: int, summary: CorpusSummary) -> Iterator[str]:
+        """Emit gtest --gtest_output=xml output."""
+        failures, disabled = self._gtest_totals(count)
+        yield (
+            '<?xml version="1.0" encoding="UTF-8"?>\n'
+            f'<testsuites tests="{count}" failures="{failures}" '
+            f'disabled="{disabled}" errors="0" name="AllTests">\n'
+        )
+
+        for suite, cases in self._gtest_suites(count, summary):
+            buffer = [f'  <testsuite name="{suite}">\n']
+            for case in cases:
+                status = "notrun" if case["disabled"] else "run"
+                attrs = (
+                    f'name="{case["name"]}" status="{status}" '
+                    f'time="{case["time"] / 1000:.3f}" classname="{suite}"'
+                )
+                if case["failure"]:
+                    buffer.append(
+                        f"    <testcase {attrs}>\n"
+                        f"      <failure message={quoteattr(case['failure'])} type=\"\"/>\n"
+                        f"    </testcase>\n"
+                    )
+                else:
+                    buffer.append(f"    <testcase {attrs}/>\n")
+
+                if len(buffer) >= CHUNK_SIZE:
+                    yield "".join(buffer)
+                    buffer = []
+
+            buffer.append("  </testsuite>\n")
+            yield "".join(buffer)
+
+        yield "</testsuites>\n"
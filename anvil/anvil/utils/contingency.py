@@ -0,0 +1,67 @@
+"""
+Fisher's exact test on batches of 2x2 contingency tables.
+
+Used to decide whether a test fails more often in one CI configuration than
+in the rest of the matrix. Each table is (failed, passed) in the
+configuration against (failed, passed) everywhere else, and the one-sided
+p-value is the hypergeometric probability of seeing at least that many of
+the test's failures in the configuration by chance.
+
+Tables are evaluated as one batch: log-factorials are tabulated once up to
+the largest table, so each p-value costs one exp() for the observed table
+and a multiplication per more extreme table, instead of recomputing
+factorials per test.
+"""
+
+import math
+from itertools import accumulate
+from typing import List, Sequence, Tuple
+
+
+def _log_factorials(limit: int) -> List[float]:
+    """Return log(n!) for n in 0..limit."""
+    return list(accumulate((math.log(n) for n in range(1, limit + 1)), initial=0.0))
+
+
+def fisher_exact_greater(tables: Sequence[Tuple[int, int, int, int]]) -> List[float]:
+    """
+    One-sided Fisher's exact p-values for a batch of 2x2 tables.
+
+    Each table is (a, b, c, d) for the rows [[a, b], [c, d]], e.g. failed
+    and passed runs in one configuration, then failed and passed runs in
+    all other configurations. The alternative is that the first row has the
+    higher rate of the first column.
+
+    Args:
+        tables: 2x2 tables of non-negative counts
+
+    Returns:
+        P-values in table order; 1.0 for tables with an empty row or column
+    """
+    if not tables:
+        return []
+
+    log_fact = _log_factorials(max(sum(table) for table in tables))
+
+    def log_choose(n: int, k: int) -> float:
+        return log_fact[n] - log_fact[k] - log_fact[n - k]
+
+    p_values = []
+    for a, b, c, d in tables:
+        row, column, total = a + b, a + c, a + b + c + d
+        if row == 0 or column == 0 or row == total or column == total:
+            p_values.append(1.0)
+            continue
+
+        # Upper tail of the hypergeometric distribution, X >= a: P(X = a),
+        # then each next term from the ratio P(X = x + 1) / P(X = x)
+        term = math.exp(
+            log_choose(column, a) + log_choose(total - column, b) - log_choose(total, row)
+        )
+        p_value = term
+        for x in range(a, min(row, column)):
+            term *= (column - x) * (row - x) / ((x + 1) * (total - column - row + x + 1))
+            p_value += term
+        p_values.append(min(p_value, 1.0))
+
+    return p_values
@@ -0,0 +1,540 @@
+"""
+Lightweight tracing shared by forge, anvil, scout and verdict.
+
+Spans time the steps of a pipeline: forge's configure and build phases,
+each validator, each file batch, subprocesses, database transactions and
+HTTP fetches. Tracing is off unless ARGOS_TRACE names an output file (or
+configure_tracing() is called); span() then returns one shared no-op
+object, so instrumented code pays a global lookup and a call.
+
+Output formats (ARGOS_TRACE_FORMAT, default from the file name):
+
+- chrome: Chrome trace event JSON for chrome://tracing or Perfetto. Events
+  are appended to an unterminated JSON array, which both viewers accept, so
+  every process of a pipeline can write to the same file.
+- otlp: OpenTelemetry OTLP/JSON, one ExportTraceServiceRequest per line, as
+  written by the OpenTelemetry collector's file exporter (*.jsonl files).
+
+Processes started while tracing is on inherit ARGOS_TRACE and the trace id
+(ARGOS_TRACE_ID), so their spans join the same trace. Every subprocess start
+is also recorded as an instant event through a Python audit hook. Forked
+children (e.g. multiprocessing pool workers) start with an empty buffer of
+their own and flush it when they exit.
+
+Examples:
+    >>> with span("anvil.validator", validator="flake8") as s:
+    ...     s.set_attribute("files", 12)
+
+    >>> @traced("forge.save_build")
+    ... def save_build(...): ...
+"""
+
+import atexit
+import functools
+import json
+import os
+import secrets
+import sys
+import threading
+import time
+from contextvars import ContextVar
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Optional, TypeVar, Union
+
+TRACE_ENV = "ARGOS_TRACE"
+TRACE_FORMAT_ENV = "ARGOS_TRACE_FORMAT"
+TRACE_ID_ENV = "ARGOS_TRACE_ID"
+
+TRACE_FORMATS = ("chrome", "otlp")
+
+# Finished spans buffered before they are appended to the trace file
+FLUSH_EVERY = 256
+
+# Longest subprocess command line kept on a spawn event
+_MAX_COMMAND_LENGTH = 300
+
+F = TypeVar("F", bound=Callable[..., Any])
+
+_current_span: ContextVar[Optional["Span"]] = ContextVar("argos_current_span", default=None)
+
+
+class Span:
+    """
+    A timed operation.
+
+    Use as a context manager, or call end() when the operation finishes.
+    Spans started inside another span (in the same thread or task) become
+    its children.
+
+    Attributes:
+        name: Operation name, e.g. "forge.build"
+        attributes: Key/value details (str, int, float or bool)
+        trace_id: 32 hex digit id shared by all spans of a trace
+        span_id: 16 hex digit id of this span
+        parent_id: span_id of the enclosing span, if any
+        start_ns: Start as nanoseconds since the epoch
+        end_ns: End as nanoseconds since the epoch (None while running)
+    """
+
+    __slots__ = (
+        "name",
+        "attributes",
+        "trace_id",
+        "span_id",
+        "parent_id",
+        "start_ns",
+        "end_ns",
+        "thread_id",
+        "instant",
+        "_start_perf",
+        "_tracer",
+        "_token",
+    )
+
+    def __init__(
+        self,
+        tracer: "Tracer",
+        name: str,
+        attributes: Dict[str, Any],
+        parent: Optional["Span"],
+        instant: bool = False,
+    ):
+        """Start the span."""
+        self._tracer = tracer
+        self.name = name
+        self.attributes = attributes
+        self.trace_id = tracer.trace_id
+        self.span_id = secrets.token_hex(8)
+        self.parent_id = parent.span_id if parent is not None else None
+        self.thread_id = threading.get_ident()
+        self.instant = instant
+        self.start_ns = time.time_ns()
+        self._start_perf = time.perf_counter_ns()
+        self.end_ns: Optional[int] = None
+        self._token = None
+
+    def set_attribute(self, key: str, value: Any) -> None:
+        """Add or replace an attribute."""
+        self.attributes[key] = value
+
+    def end(self) -> None:
+        """Finish the span; later calls do nothing."""
+        if self.end_ns is None:
+            self.end_ns = self.start_ns + time.perf_counter_ns() - self._start_perf
+            self._tracer._finish(self)
+
+    @property
+    def duration_ns(self) -> int:
+        """Duration in nanoseconds (0 while running)."""
+        return self.end_ns - self.start_ns if self.end_ns is not None else 0
+
+    def __enter__(self) -> "Span":
+        """Make this the current span."""
+        self._token = _current_span.set(self)
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb) -> bool:
+        """Record an exception, if any, and finish the span."""
+        if exc_type is not None:
+            self.attributes["error"] = f"{exc_type.__name__}: {exc_val}"
+        if self._token is not None:
+            _current_span.reset(self._token)
+            self._token = None
+        self.end()
+        return False
+
+
+class _NoopSpan:
+    """Span stand-in returned while tracing is disabled."""
+
+    __slots__ = ()
+
+    def set_attribute(self, key: str, value: Any) -> None:
+        """Do nothing."""
+
+    def end(self) -> None:
+        """Do nothing."""
+
+    def __enter__(self) -> "_NoopSpan":
+        """Do nothing."""
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb) -> bool:
+        """Do nothing."""
+        return False
+
+
+NOOP_SPAN = _NoopSpan()
+
+AnySpan = Union[Span, _NoopSpan]
+
+
+def _otlp_value(value: Any) -> Dict[str, Any]:
+    """Convert an attribute value to an OTLP AnyValue."""
+    if isinstance(value, bool):
+        return {"boolValue": value}
+    if isinstance(value, int):
+        return {"intValue": str(value)}
+    if isinstance(value, float):
+        return {"doubleValue": value}
+    return {"stringValue": str(value)}
+
+
+def _otlp_attributes(attributes: Dict[str, Any]) -> List[Dict[str, Any]]:
+    """Convert attributes to an OTLP KeyValue list."""
+    return [{"key": key, "value": _otlp_value(value)} for key, value in attributes.items()]
+
+
+def _json_safe(attributes: Dict[str, Any]) -> Dict[str, Any]:
+    """Keep JSON scalars, converting anything else to a string."""
+    return {
+        key: value if isinstance(value, (str, int, float, bool)) or value is None else str(value)
+        for key, value in attributes.items()
+    }
+
+
+class Tracer:
+    """
+    Collects finished spans and appends them to a trace file.
+
+    Args:
+        path: Trace file (created if missing, appended to otherwise)
+        format: "chrome" or "otlp"
+        service: Name of this process in the trace (e.g. "forge")
+        trace_id: Trace to join (a new one is started if omitted)
+    """
+
+    def __init__(
+        self,
+        path: Union[str, Path],
+        format: str = "chrome",
+        service: Optional[str] = None,
+        trace_id: Optional[str] = None,
+    ):
+        """Initialize the tracer."""
+        if format not in TRACE_FORMATS:
+            raise ValueError(f"Unknown trace format: {format} (expected one of {TRACE_FORMATS})")
+        self.path = Path(path)
+        self.format = format
+        self.service = service or Path((sys.argv or [""])[0]).stem or "python"
+        self.trace_id = trace_id or secrets.token_hex(16)
+        self.pid = os.getpid()
+        self._buffer: List[Span] = []
+        self._lock = threading.Lock()
+        self._process_named = False
+
+    def start_span(self, name: str, attributes: Optional[Dict[str, Any]] = None) -> Span:
+        """
+        Start a span as a child of the current span.
+
+        Args:
+            name: Operation name
+            attributes: Initial attributes
+
+        Returns:
+            Running span
+        """
+        return Span(self, name, dict(attributes or {}), _current_span.get())
+
+    def instant(self, name: str, attributes: Optional[Dict[str, Any]] = None) -> None:
+        """Record a zero-length event, e.g. a subprocess start."""
+        event = Span(self, name, dict(attributes or {}), _current_span.get(), instant=True)
+        event.end_ns = event.start_ns
+        self._finish(event)
+
+    def _finish(self, span: Span) -> None:
+        """Buffer a finished span, writing the buffer out when it is full."""
+        with self._lock:
+            self._buffer.append(span)
+            if len(self._buffer) < FLUSH_EVERY:
+                return
+            spans, self._buffer = self._buffer, []
+            self._write(spans)
+
+    def flush(self) -> None:
+        """Append all buffered spans to the trace file."""
+        with self._lock:
+            spans, self._buffer = self._buffer, []
+            if spans:
+                self._write(spans)
+
+    def _write(self, spans: List[Span]) -> None:
+        """Append spans in the tracer's format (called with the lock held)."""
+        self.path.parent.mkdir(parents=True, exist_ok=True)
+        if self.format == "chrome":
+            try:
+                # The first process to write opens the array
+                fd = os.open(self.path, os.O_WRONLY | os.O_CREAT | os.O_EXCL)
+                os.write(fd, b"[\n")
+                os.close(fd)
+            except FileExistsError:
+                pass
+            data = self._chrome_events(spans)
+        else:
+            data = json.dumps(self._otlp_request(spans), separators=(",", ":")) + "\n"
+        # One append per flush keeps lines of concurrent processes intact
+        with open(self.path, "a", encoding="utf-8") as f:
+            f.write(data)
+
+    def _chrome_events(self, spans: List[Span]) -> str:
+        """Format spans as trace events of an unterminated JSON array."""
+        events = []
+        if not self._process_named:
+            self._process_named = True
+            events.append(
+                {"name": "process_name", "ph": "M", "pid": self.pid, "args": {"name": self.service}}
+            )
+        for span in spans:
+            event = {
+                "name": span.name,
+                "cat": self.service,
+                "ph": "i" if span.instant else "X",
+                "ts": span.start_ns / 1000,
+                "pid": self.pid,
+                "tid": span.thread_id,
+                "args": _json_safe(span.attributes),
+            }
+            if span.instant:
+                event["s"] = "t"
+            else:
+                event["dur"] = span.duration_ns / 1000
+            events.append(event)
+
+        return "".join(json.dumps(e, separators=(",", ":")) + ",\n" for e in events)
+
+    def _otlp_request(self, spans: List[Span]) -> Dict[str, Any]:
+        """Format spans as an OTLP/JSON ExportTraceServiceRequest."""
+        otlp_spans = []
+        for span in spans:
+            otlp_span: Dict[str, Any] = {
+                "traceId": span.trace_id,
+                "spanId": span.span_id,
+                "name": span.name,
+                "kind": 1,  # SPAN_KIND_INTERNAL
+                "startTimeUnixNano": str(span.start_ns),
+                "endTimeUnixNano": str(span.end_ns),
+                "attributes": _otlp_attributes(
+                    dict(span.attributes, **{"thread.id": span.thread_id})
+                ),
+            }
+            if span.parent_id:
+                otlp_span["parentSpanId"] = span.parent_id
+            if "error" in span.attributes:
+                otlp_span["status"] = {"code": 2, "message": str(span.attributes["error"])}
+            otlp_spans.append(otlp_span)
+
+        resource = {"service.name": self.service, "process.pid": self.pid}
+        return {
+            "resourceSpans": [
+                {
+                    "resource": {"attributes": _otlp_attributes(resource)},
+                    "scopeSpans": [{"scope": {"name": "argos.tracing"}, "spans": otlp_spans}],
+                }
+            ]
+        }
+
+
+_tracer: Optional[Tracer] = None
+_audit_hook_installed = False
+
+
+def _audit_hook(event: str, args: tuple) -> None:
+    """Record subprocess starts as instant events."""
+    tracer = _tracer
+    if tracer is None or event != "subprocess.Popen":
+        return
+    argv, cwd = args[1], args[2]
+    if isinstance(argv, (list, tuple)):
+        command = " ".join(os.fsdecode(a) if isinstance(a, bytes) else str(a) for a in argv)
+    else:
+        command = str(argv)
+    tracer.instant(
+        "subprocess",
+        {"command": command[:_MAX_COMMAND_LENGTH], "cwd": str(cwd) if cwd else ""},
+    )
+
+
+def _default_format(path: Union[str, Path]) -> str:
+    """OTLP for JSON-lines files, Chrome trace events otherwise."""
+    return "otlp" if str(path).endswith(".jsonl") else "chrome"
+
+
+def configure_tracing(
+    path: Union[str, Path],
+    format: Optional[str] = None,
+    service: Optional[str] = None,
+    trace_id: Optional[str] = None,
+) -> Tracer:
+    """
+    Turn tracing on for this process and the processes it starts.
+
+    Args:
+        path: Trace file to append to
+        format: "chrome" or "otlp" (default: from the file name)
+        service: Name of this process in the trace
+        trace_id: Trace to join (default: ARGOS_TRACE_ID or a new trace)
+
+    Returns:
+        The active Tracer
+    """
+    global _tracer, _audit_hook_installed
+
+    if _tracer is not None:
+        _tracer.flush()
+    tracer = Tracer(
+        path,
+        format or _default_format(path),
+        service=service,
+        trace_id=trace_id or os.environ.get(TRACE_ID_ENV),
+    )
+    _tracer = tracer
+
+    os.environ[TRACE_ENV] = str(tracer.path)
+    os.environ[TRACE_FORMAT_ENV] = tracer.format
+    os.environ[TRACE_ID_ENV] = tracer.trace_id
+
+    if not _audit_hook_installed:
+        # Audit hooks cannot be removed; the hook checks _tracer instead
+        sys.addaudithook(_audit_hook)
+        atexit.register(_flush_at_exit)
+        _register_process_exit_flush()
+        if hasattr(os, "register_at_fork"):
+            os.register_at_fork(after_in_child=_reset_after_fork)
+        _audit_hook_installed = True
+    return tracer
+
+
+def disable_tracing() -> None:
+    """Flush buffered spans and turn tracing off for this process."""
+    global _tracer
+    tracer, _tracer = _tracer, None
+    if tracer is not None:
+        tracer.flush()
+
+
+def _flush_at_exit() -> None:
+    """Write out spans still buffered when the process exits."""
+    if _tracer is not None:
+        _tracer.flush()
+
+
+def _register_process_exit_flush(*_: Any) -> None:
+    """
+    Flush when a multiprocessing child exits.
+
+    multiprocessing children leave through os._exit(), skipping atexit, but
+    run the finalizers registered after their start.
+    """
+    mp_util = sys.modules.get("multiprocessing.util")
+    if mp_util is not None:
+        mp_util.Finalize(None, _flush_at_exit, exitpriority=0)
+
+
+def _reset_after_fork() -> None:
+    """Give a forked child its own empty tracer, flushed when the child exits."""
+    global _tracer
+    tracer = _tracer
+    if tracer is None:
+        return
+    _tracer = Tracer(tracer.path, tracer.format, service=tracer.service, trace_id=tracer.trace_id)
+
+    # multiprocessing clears its finalizers in the child after this hook
+    # runs, so register the exit flush from its own after-fork callbacks
+    mp_util = sys.modules.get("multiprocessing.util")
+    if mp_util is not None:
+        mp_util.register_after_fork(_tracer, _register_process_exit_flush)
+
+
+def get_tracer() -> Optional[Tracer]:
+    """Get the active tracer, or None while tracing is disabled."""
+    return _tracer
+
+
+def set_service_name(name: str) -> None:
+    """
+    Name this process in the trace (forge, anvil, scout, verdict).
+
+    Args:
+        name: Service name; ignored while tracing is disabled
+    """
+    if _tracer is not None:
+        _tracer.service = name
+
+
+def span(name: str, /, **attributes: Any) -> AnySpan:
+    """
+    Start a span, used as a context manager around a block of code.
+
+    Operations that start and end in different callbacks (e.g. database
+    transaction events) can instead call end() on the returned span.
+
+    Args:
+        name: Operation name, e.g. "anvil.validator"
+        **attributes: Span attributes
+
+    Returns:
+        Running span, or the shared no-op span while tracing is disabled
+    """
+    tracer = _tracer
+    if tracer is None:
+        return NOOP_SPAN
+    return tracer.start_span(name, attributes)
+
+
+def traced(name: Optional[str] = None, **attributes: Any) -> Callable[[F], F]:
+    """
+    Decorate a function so each call is a span.
+
+    Args:
+        name: Span name (default: the function's qualified name)
+        **attributes: Attributes of every span
+
+    Returns:
+        Decorator
+    """
+
+    def decorate(func: F) -> F:
+        span_name = name or func.__qualname__
+
+        @functools.wraps(func)
+        def wrapper(*args, **kwargs):
+            tracer = _tracer
+            if tracer is None:
+                return func(*args, **kwargs)
+            with tracer.start_span(span_name, attributes):
+                return func(*args, **kwargs)
+
+        return wrapper  # type: ignore[return-value]
+
+    return decorate
+
+
+def load_trace_events(path: Union[str, Path]) -> List[Dict[str, Any]]:
+    """
+    Read a Chrome trace file written by any number of processes.
+
+    Args:
+        path: Trace file in the chrome format
+
+    Returns:
+        Trace events in file order
+    """
+    text = Path(path).read_text(encoding="utf-8").strip()
+    if not text:
+        return []
+    if not text.endswith("]"):
+        text = text.rstrip(",") + "]"
+    return json.loads(text)
+
+
+def _configure_from_environment() -> None:
+    """Turn tracing on when ARGOS_TRACE is set."""
+    path = os.environ.get(TRACE_ENV)
+    if path:
+        try:
+            configure_tracing(path, os.environ.get(TRACE_FORMAT_ENV) or None)
+        except ValueError as e:
+            print(f"Warning: tracing disabled: {e}", file=sys.stderr)
+
+
+_configure_from_environment()
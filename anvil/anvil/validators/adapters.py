@@ -14,9 +14,18 @@ Interface Contract:
     All adapters must follow: def adapter(input_text: str) -> dict
 """
 
+from collections import Counter
 from pathlib import Path
 
+from anvil.models.validator import ValidationResult
+from anvil.parsers.clang_format_parser import ClangFormatParser
+from anvil.parsers.clang_tidy_parser import ClangTidyParser
+from anvil.parsers.cppcheck_parser import CppcheckParser
+from anvil.parsers.cpplint_parser import CpplintParser
+from anvil.parsers.gtest_parser import GTestParser
+from anvil.parsers.iwyu_parser import IWYUParser
 from anvil.parsers.lint_parser import LintParser
+from anvil.parsers.log_scan import LineIndex, LogRecord, load_backend
 
 
 def validate_black_parser(input_text: str) -> dict:
@@ -113,3 +122,163 @@ def validate_isort_parser(input_text: str) -> dict:
             for fv in lint_data.file_violations
         ],
     }
+
+
+def _summarize_validation_result(result: ValidationResult) -> dict:
+    """
+    Summarize a ValidationResult for Verdict validation.
+
+    The C++ parsers return Issue lists rather than LintData, so their
+    adapters report counts, which stay cheap to compare on large corpora.
+
+    Args:
+        result: ValidationResult returned by a C++ parser
+
+    Returns:
+        Dictionary with validator name, pass status and issue counts
+    """
+    by_rule = Counter(issue.rule_name for issue in result.errors + result.warnings)
+
+    return {
+        "validator": result.validator_name,
+        "passed": result.passed,
+        "errors": len(result.errors),
+        "warnings": len(result.warnings),
+        "by_rule": dict(sorted(by_rule.items())),
+    }
+
+
+def validate_clang_tidy_parser(input_text: str) -> dict:
+    """
+    Adapter for clang-tidy parser validation.
+
+    Args:
+        input_text: Raw clang-tidy --export-fixes YAML output
+
+    Returns:
+        Dictionary with issue counts for validation
+    """
+    return _summarize_validation_result(ClangTidyParser.parse_yaml(input_text, [], {}))
+
+
+def validate_cppcheck_parser(input_text: str) -> dict:
+    """
+    Adapter for cppcheck parser validation.
+
+    Args:
+        input_text: Raw cppcheck --xml --xml-version=2 output
+
+    Returns:
+        Dictionary with issue counts for validation
+    """
+    return _summarize_validation_result(CppcheckParser.parse_xml(input_text, [], {}))
+
+
+def validate_cpplint_parser(input_text: str) -> dict:
+    """
+    Adapter for cpplint parser validation.
+
+    Args:
+        input_text: Raw cpplint output
+
+    Returns:
+        Dictionary with issue counts for validation
+    """
+    return _summarize_validation_result(CpplintParser().parse_output(input_text, []))
+
+
+def validate_iwyu_parser(input_text: str) -> dict:
+    """
+    Adapter for include-what-you-use parser validation.
+
+    Args:
+        input_text: Raw IWYU output
+
+    Returns:
+        Dictionary with issue counts for validation
+    """
+    return _summarize_validation_result(IWYUParser().parse_output(input_text, []))
+
+
+def validate_clang_format_parser(input_text: str) -> dict:
+    """
+    Adapter for clang-format parser validation.
+
+    Args:
+        input_text: Raw clang-format --output-replacements-xml output
+
+    Returns:
+        Dictionary with issue counts for validation
+    """
+    return _summarize_validation_result(ClangFormatParser().parse_output(input_text, []))
+
+
+def validate_gtest_parser(input_text: str) -> dict:
+    """
+    Adapter for Google Test parser validation.
+
+    Args:
+        input_text: Raw gtest --gtest_output=json output
+
+    Returns:
+        Dictionary with issue counts for validation
+    """
+    return _summarize_validation_result(GTestParser().parse_output(input_text, []))
+
+
+def _summarize_log_scan(implementation: str, input_text: str) -> dict:
+    """
+    Run one log scanning implementation over a log for Verdict validation.
+
+    The native and pure-Python adapters share their cases, so every case
+    checks that both implementations agree.
+
+    Args:
+        implementation: "native" or "python"
+        input_text: Raw build or test log
+
+    Returns:
+        Dictionary with records, per-kind counts, line bounds and line
+        selection results
+    """
+    scanner = load_backend(implementation)
+    records = [LogRecord._make(record)._asdict() for record in scanner.scan_log(input_text)]
+    lines = LineIndex(*scanner.index_lines(input_text))
+
+    return {
+        "total_records": len(records),
+        "by_kind": dict(sorted(Counter(r["kind"] for r in records).items())),
+        "records": records,
+        "stripped_length": len(scanner.strip_ansi(input_text)),
+        "line_bounds": [[start, end] for start, end in zip(lines.starts, lines.ends)],
+        "warning_lines": [list(line) for line in scanner.select_lines(input_text, ["warning"])],
+        "running_lines": [
+            list(line) for line in scanner.select_lines(input_text, ["running"], True)
+        ],
+    }
+
+
+def validate_log_scan_native(input_text: str) -> dict:
+    """
+    Adapter for the native log scanner (anvil.parsers._log_scan).
+
+    Args:
+        input_text: Raw build or test log
+
+    Returns:
+        Dictionary with scan results for validation
+    """
+    return _summarize_log_scan("native", input_text)
+
+
+def validate_log_scan_python(input_text: str) -> dict:
+    """
+    Adapter for the pure-Python log scanner fallback.
+
+    Args:
+        input_text: Raw build or test log
+
+    Returns:
+        Dictionary with scan results for validation
+    """
+    return _summarize_log_scan("python", input_text)
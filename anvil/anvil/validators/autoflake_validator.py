@@ -9,6 +9,7 @@ import subprocess
 from pathlib import Path
 from typing import Any, Dict, List
 
+from anvil.executors.fanout import fan_out
 from anvil.models.validator import ValidationResult, Validator
 from anvil.parsers.autoflake_parser import AutoflakeParser
 
@@ -74,8 +75,14 @@ class AutoflakeValidator(Validator):
         # Convert string paths to Path objects
         file_paths = [Path(f) for f in files]
 
-        # Use the parser to run and parse results
-        return AutoflakeParser.run_and_parse(file_paths, config)
+        # Check ARG_MAX-safe chunks of files concurrently
+        return fan_out(
+            lambda chunk: AutoflakeParser.run_and_parse(chunk, config),
+            file_paths,
+            self.name,
+            base_command=AutoflakeParser.build_command([], config),
+            config=config,
+        )
 
     def is_available(self) -> bool:
         """
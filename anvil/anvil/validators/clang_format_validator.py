@@ -5,9 +5,9 @@ Wraps ClangFormatParser to provide validation interface.
 """
 
 import subprocess
-from pathlib import Path
 from typing import Any, Dict, List
 
+from anvil.executors.fanout import fan_out
 from anvil.models.validator import ValidationResult, Validator
 from anvil.parsers.clang_format_parser import ClangFormatParser
 
@@ -64,8 +64,16 @@ class ClangFormatValidator(Validator):
         Returns:
             ValidationResult with formatting issues
         """
-        file_paths = [Path(f) for f in files]
-        return ClangFormatParser.run_and_parse(file_paths, config)
+        # --lines restricts formatting checks to changed lines of one file
+        parser = ClangFormatParser()
+        return fan_out(
+            lambda chunk: parser.run(chunk, config),
+            files,
+            self.name,
+            base_command=parser.build_command([], config),
+            config=config,
+            max_files=1 if config.get("line_ranges") else None,
+        )
 
     def is_available(self) -> bool:
         """
@@ -8,6 +8,7 @@ import subprocess
 from pathlib import Path
 from typing import Any, Dict, List
 
+from anvil.executors.fanout import arg_length, fan_out
 from anvil.models.validator import ValidationResult, Validator
 from anvil.parsers.clang_tidy_parser import ClangTidyParser
 
@@ -65,7 +66,22 @@ class ClangTidyValidator(Validator):
             ValidationResult with errors and warnings
         """
         file_paths = [Path(f) for f in files]
-        return ClangTidyParser.run_and_parse(file_paths, config)
+
+        # The --line-filter JSON grows with every file that has line ranges,
+        # so count each file's entry against the argument budget as well
+        base_command = ClangTidyParser.build_command([], config)
+        if config.get("line_ranges"):
+            base_command.append("--line-filter=[]")
+
+        # Each translation unit is independent, so chunks run concurrently
+        return fan_out(
+            lambda chunk: ClangTidyParser.run_and_parse(chunk, config),
+            file_paths,
+            self.name,
+            base_command=base_command,
+            config=config,
+            file_length=lambda f: arg_length(f) + ClangTidyParser.line_filter_length(f, config),
+        )
 
     def is_available(self) -> bool:
         """
@@ -0,0 +1,230 @@
+"""
+Validator for C++ function metrics.
+
+Wraps CppMetricsAnalyzer to report functions that exceed complexity,
+nesting, length or fan-out thresholds, and records per-file results in the
+execution history's code_quality_metrics table for trend tracking.
+"""
+
+from collections import Counter
+from datetime import datetime
+from pathlib import Path
+from typing import Any, Dict, List, Optional
+
+from anvil.models.validator import Issue, ValidationResult, Validator
+from anvil.parsers.cpp_metrics_analyzer import CppMetricsAnalyzer, FunctionMetrics
+from anvil.storage.execution_schema import CodeQualityMetrics, ExecutionDatabase
+
+# Default execution history database used for trend tracking
+DEFAULT_HISTORY_DATABASE = ".anvil/history.db"
+
+# Threshold config key, metric attribute, error code and description
+THRESHOLDS = [
+    ("max_complexity", "complexity", "CCN", "cyclomatic complexity"),
+    ("max_nesting", "max_nesting", "NEST", "nesting depth"),
+    ("max_function_length", "length", "LEN", "length"),
+    ("max_fan_out", "fan_out", "FANOUT", "fan-out"),
+]
+
+DEFAULT_THRESHOLDS = {
+    "max_complexity": 10,
+    "max_nesting": 4,
+    "max_function_length": 100,
+    "max_fan_out": 20,
+}
+
+
+class CppMetricsValidator(Validator):
+    """
+    Validator for C++ function metrics.
+
+    Computes cyclomatic complexity, nesting depth, function length and
+    fan-in/fan-out without a compiler, so it is always available.
+    """
+
+    @property
+    def name(self) -> str:
+        """
+        Get the name of the validator.
+
+        Returns:
+            The validator name
+        """
+        return "cpp-metrics"
+
+    @property
+    def language(self) -> str:
+        """
+        Get the language supported by this validator.
+
+        Returns:
+            The language identifier
+        """
+        return "cpp"
+
+    @property
+    def description(self) -> str:
+        """
+        Get a description of what this validator checks.
+
+        Returns:
+            A brief description of the validator's purpose
+        """
+        return "Checks C++ function complexity, nesting, length and fan-out"
+
+    def validate(
+        self,
+        files: List[str],
+        config: Dict[str, Any],
+    ) -> ValidationResult:
+        """
+        Validate C++ files against function metric thresholds.
+
+        Args:
+            files: List of file paths to validate
+            config: Configuration with thresholds (max_complexity,
+                max_nesting, max_function_length, max_fan_out; 0 disables a
+                check), jobs, and history_database (path or False)
+
+        Returns:
+            ValidationResult with one warning per exceeded threshold and
+            per-function metrics in metadata["functions"]
+        """
+        analyzer = CppMetricsAnalyzer(jobs=config.get("jobs"))
+        results = analyzer.analyze_files([Path(f) for f in files])
+
+        errors = [
+            Issue(
+                file_path=path,
+                line_number=0,
+                column_number=None,
+                severity="error",
+                message=f"Could not read file: {message}",
+                rule_name="cpp-metrics-error",
+            )
+            for path, message in analyzer.errors.items()
+        ]
+        warnings = []
+        for path, functions in results.items():
+            for function in functions:
+                warnings.extend(self._check_thresholds(path, function, config))
+
+        self._record_trends(results, warnings, config)
+
+        return ValidationResult(
+            validator_name=self.name,
+            passed=not errors and not warnings,
+            errors=errors,
+            warnings=warnings,
+            files_checked=len(files),
+            metadata={
+                "functions": {
+                    path: [f.to_dict() for f in functions] for path, functions in results.items()
+                }
+            },
+        )
+
+    @staticmethod
+    def _check_thresholds(
+        path: str, function: FunctionMetrics, config: Dict[str, Any]
+    ) -> List[Issue]:
+        """
+        Compare one function's metrics against the configured thresholds.
+
+        Args:
+            path: File containing the function
+            function: Function metrics
+            config: Validator configuration
+
+        Returns:
+            One warning per exceeded threshold
+        """
+        issues = []
+        for key, attribute, code, label in THRESHOLDS:
+            limit = config.get(key, DEFAULT_THRESHOLDS[key])
+            value = getattr(function, attribute)
+            if limit and value > limit:
+                issues.append(
+                    Issue(
+                        file_path=path,
+                        line_number=function.line,
+                        column_number=None,
+                        severity="warning",
+                        message=f"Function '{function.name}' has {label} {value} (max {limit})",
+                        rule_name=f"cpp-metrics-{code.lower()}",
+                        error_code=code,
+                    )
+                )
+        return issues
+
+    def _record_trends(
+        self,
+        results: Dict[str, List[FunctionMetrics]],
+        warnings: List[Issue],
+        config: Dict[str, Any],
+    ) -> None:
+        """
+        Accumulate per-file violation counts into code_quality_metrics.
+
+        Trends are recorded only when a history database is configured
+        explicitly or already exists at the default location.
+
+        Args:
+            results: Analysis results per file
+            warnings: Threshold violations from this scan
+            config: Validator configuration
+        """
+        db_path = self._history_database(config)
+        if db_path is None:
+            return
+
+        codes_by_file: Dict[str, Counter] = {path: Counter() for path in results}
+        for warning in warnings:
+            codes_by_file[warning.file_path][warning.error_code] += 1
+
+        now = datetime.now()
+        db = ExecutionDatabase(db_path)
+        try:
+            for path, codes in codes_by_file.items():
+                existing = db.get_code_quality_metrics(file_path=path, validator=self.name)
+                record = existing[0] if existing else CodeQualityMetrics(path, self.name)
+                violations = sum(codes.values())
+
+                record.total_scans += 1
+                record.total_violations += violations
+                record.avg_violations_per_scan = record.total_violations / record.total_scans
+                record.last_scan = now
+                record.last_updated = now
+                if violations:
+                    record.most_common_code = codes.most_common(1)[0][0]
+                    record.last_violation = now
+                db.upsert_code_quality_metrics(record)
+        finally:
+            db.close()
+
+    @staticmethod
+    def _history_database(config: Dict[str, Any]) -> Optional[str]:
+        """
+        Resolve the history database used for trend tracking.
+
+        Args:
+            config: Validator configuration
+
+        Returns:
+            Database path, or None if trend tracking is disabled
+        """
+        configured = config.get("history_database")
+        if configured is False:
+            return None
+        if configured:
+            return str(configured)
+        return DEFAULT_HISTORY_DATABASE if Path(DEFAULT_HISTORY_DATABASE).exists() else None
+
+    def is_available(self) -> bool:
+        """
+        Check if the validator can run.
+
+        Returns:
+            Always True; the analyzer has no external dependencies
+        """
+        return True
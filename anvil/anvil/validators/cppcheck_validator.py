@@ -8,6 +8,7 @@ import subprocess
 from pathlib import Path
 from typing import Any, Dict, List
 
+from anvil.executors.fanout import fan_out
 from anvil.models.validator import ValidationResult, Validator
 from anvil.parsers.cppcheck_parser import CppcheckParser
 
@@ -65,7 +66,20 @@ class CppcheckValidator(Validator):
             ValidationResult with errors and warnings
         """
         file_paths = [Path(f) for f in files]
-        return CppcheckParser.run_and_parse(file_paths, config)
+
+        # unusedFunction needs every file in one run; other checks are per file
+        enable = config.get("enable", [])
+        enable = enable if isinstance(enable, list) else str(enable).split(",")
+        whole_program = bool({"all", "unusedFunction"} & set(enable))
+
+        return fan_out(
+            lambda chunk: CppcheckParser.run_and_parse(chunk, config),
+            file_paths,
+            self.name,
+            base_command=CppcheckParser.build_command([], config),
+            config=config,
+            whole_program=whole_program,
+        )
 
     def is_available(self) -> bool:
         """
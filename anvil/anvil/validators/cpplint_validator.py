@@ -5,9 +5,9 @@ Wraps CpplintParser to provide validation interface.
 """
 
 import subprocess
-from pathlib import Path
 from typing import Any, Dict, List
 
+from anvil.executors.fanout import fan_out
 from anvil.models.validator import ValidationResult, Validator
 from anvil.parsers.cpplint_parser import CpplintParser
 
@@ -64,8 +64,14 @@ class CpplintValidator(Validator):
         Returns:
             ValidationResult with errors and warnings
         """
-        file_paths = [Path(f) for f in files]
-        return CpplintParser.run_and_parse(file_paths, config)
+        parser = CpplintParser()
+        return fan_out(
+            lambda chunk: parser.run(chunk, config),
+            files,
+            self.name,
+            base_command=parser.build_command([], config),
+            config=config,
+        )
 
     def is_available(self) -> bool:
         """
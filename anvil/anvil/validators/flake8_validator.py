@@ -9,6 +9,7 @@ import subprocess
 from pathlib import Path
 from typing import Any, Dict, List
 
+from anvil.executors.fanout import fan_out
 from anvil.models.validator import ValidationResult, Validator
 from anvil.parsers.flake8_parser import Flake8Parser
 
@@ -75,8 +76,14 @@ class Flake8Validator(Validator):
         # Convert string paths to Path objects
         file_paths = [Path(f) for f in files]
 
-        # Use the parser to run and parse results
-        return Flake8Parser.run_and_parse(file_paths, config)
+        # Check ARG_MAX-safe chunks of files concurrently
+        return fan_out(
+            lambda chunk: Flake8Parser.run_and_parse(chunk, config),
+            file_paths,
+            self.name,
+            base_command=Flake8Parser.build_command([], config),
+            config=config,
+        )
 
     def is_available(self) -> bool:
         """
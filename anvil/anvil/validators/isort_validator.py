@@ -10,6 +10,7 @@ import subprocess
 from pathlib import Path
 from typing import Any, Dict, List
 
+from anvil.executors.fanout import fan_out
 from anvil.models.validator import ValidationResult, Validator
 from anvil.parsers.isort_parser import IsortParser
 
@@ -82,8 +83,14 @@ class IsortValidator(Validator):
         # Convert string paths to Path objects
         file_paths = [Path(f) for f in files]
 
-        # Use the parser to run and parse results
-        result = IsortParser.run_and_parse(file_paths, config)
+        # Check ARG_MAX-safe chunks of files concurrently
+        result = fan_out(
+            lambda chunk: IsortParser.run_and_parse(chunk, config),
+            file_paths,
+            self.name,
+            base_command=IsortParser.build_command([], config),
+            config=config,
+        )
 
         logger.info(
             f"isort validation complete: {len(result.errors)} errors, "
@@ -5,9 +5,9 @@ Wraps IWYUParser to provide validation interface.
 """
 
 import subprocess
-from pathlib import Path
 from typing import Any, Dict, List
 
+from anvil.executors.fanout import fan_out
 from anvil.models.validator import ValidationResult, Validator
 from anvil.parsers.iwyu_parser import IWYUParser
 
@@ -64,8 +64,24 @@ class IWYUValidator(Validator):
         Returns:
             ValidationResult with include suggestions
         """
-        file_paths = [Path(f) for f in files]
-        return IWYUParser.run_and_parse(file_paths, config)
+        parser = IWYUParser()
+        options = {
+            "mapping_file": config.get("mapping_file") or None,
+            "compiler_flags": config.get("extra_args"),
+            "std": config.get("std"),
+            "include_paths": config.get("includes"),
+            "defines": config.get("defines"),
+        }
+
+        # IWYU analyzes one translation unit per invocation
+        return fan_out(
+            lambda chunk: parser.run(chunk, timeout=config.get("timeout", 300), **options),
+            files,
+            self.name,
+            base_command=parser.build_command([], **options),
+            config=config,
+            max_files=1,
+        )
 
     def is_available(self) -> bool:
         """
@@ -9,6 +9,7 @@ import subprocess
 from pathlib import Path
 from typing import Any, Dict, List
 
+from anvil.executors.fanout import fan_out
 from anvil.models.validator import ValidationResult, Validator
 from anvil.parsers.pylint_parser import PylintParser
 
@@ -75,8 +76,15 @@ class PylintValidator(Validator):
         # Convert string paths to Path objects
         file_paths = [Path(f) for f in files]
 
-        # Use the parser to run and parse results
-        return PylintParser.run_and_parse(file_paths, config)
+        # Cross-file analysis: split only when the command line would not fit
+        return fan_out(
+            lambda chunk: PylintParser.run_and_parse(chunk, config),
+            file_paths,
+            self.name,
+            base_command=PylintParser.build_command([], config),
+            config=config,
+            whole_program=True,
+        )
 
     def is_available(self) -> bool:
         """
@@ -79,9 +79,47 @@ class PytestValidator(Validator):
         # Convert string paths to Path objects
         file_paths = [Path(f) for f in files]
 
+        if config.get("shards") or config.get("shard"):
+            return self._validate_sharded(file_paths, config)
+
         # Use the parser to run and parse results
         return PytestParser.run_and_parse(file_paths, config)
 
+    def _validate_sharded(self, files: List[Path], config: Dict[str, Any]) -> ValidationResult:
+        """
+        Run tests as duration-balanced shards in parallel subprocesses.
+
+        Config keys:
+            shards: Number of local parallel shards ("auto" = CPU count)
+            shard: Optional "i/N" spec running only this machine's share
+            statistics_database: Path to the statistics database providing
+                per-test durations (default: .anvil/statistics.db)
+
+        Args:
+            files: Test files or directories
+            config: Configuration dictionary for pytest
+
+        Returns:
+            ValidationResult merged from all shard reports
+        """
+        from anvil.executors.pytest_sharding import ShardedPytestRunner
+        from anvil.storage.statistics_database import StatisticsDatabase
+
+        shards = config.get("shards")
+        workers = None if shards in (None, "auto") else int(shards)
+        if not shards:
+            # Machine sharding only: run this machine's share in one process
+            workers = 1
+
+        db_path = Path(config.get("statistics_database", ".anvil/statistics.db"))
+        db = StatisticsDatabase(str(db_path)) if db_path.exists() else None
+        try:
+            runner = ShardedPytestRunner(workers=workers, shard=config.get("shard"), db=db)
+            return runner.run(files, config)
+        finally:
+            if db is not None:
+                db.close()
+
     def is_available(self) -> bool:
         """
         Check if pytest is installed and available.
@@ -9,7 +9,9 @@ import subprocess
 from pathlib import Path
 from typing import Any, Dict, List
 
+from anvil.executors.fanout import fan_out
 from anvil.models.validator import ValidationResult, Validator
+from anvil.parsers.radon_analyzer import is_radon_importable
 from anvil.parsers.radon_parser import RadonParser
 
 
@@ -77,8 +79,18 @@ class RadonValidator(Validator):
         # Convert string paths to Path objects
         file_paths = [Path(f) for f in files]
 
-        # Use the parser to run and parse results
-        return RadonParser.run_and_parse(file_paths, config)
+        # In-process analysis has its own worker pool
+        if config.get("in_process", True) and is_radon_importable():
+            return RadonParser.run_and_parse(file_paths, config)
+
+        # Check ARG_MAX-safe chunks of files concurrently
+        return fan_out(
+            lambda chunk: RadonParser.run_and_parse(chunk, config),
+            file_paths,
+            self.name,
+            base_command=RadonParser.build_cc_command([], config),
+            config=config,
+        )
 
     def is_available(self) -> bool:
         """
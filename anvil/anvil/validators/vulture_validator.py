@@ -9,6 +9,7 @@ import subprocess
 from pathlib import Path
 from typing import Any, Dict, List
 
+from anvil.executors.fanout import fan_out
 from anvil.models.validator import ValidationResult, Validator
 from anvil.parsers.vulture_parser import VultureParser
 
@@ -79,8 +80,15 @@ class VultureValidator(Validator):
         # Convert string paths to Path objects
         file_paths = [Path(f) for f in files]
 
-        # Use the parser to run and parse results
-        return VultureParser.run_and_parse(file_paths, config)
+        # Cross-file analysis: split only when the command line would not fit
+        return fan_out(
+            lambda chunk: VultureParser.run_and_parse(chunk, config),
+            file_paths,
+            self.name,
+            base_command=VultureParser.build_command([], config),
+            config=config,
+            whole_program=True,
+        )
 
     def is_available(self) -> bool:
         """
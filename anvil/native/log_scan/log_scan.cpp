@@ -0,0 +1,837 @@
+// Log scanning core: ANSI stripping, line selection and diagnostic records.
+//
+// See log_scan.h for the interface. Byte buffers take SSE2 (and, for line
+// indexing, AVX2 where the CPU has it) paths for the character searches that
+// dominate on large logs; wider strings use portable loops.
+
+#include "log_scan.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LOG_SCAN_SSE2 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// AVX2 is compiled per function and chosen at run time, so the module still
+// loads on CPUs without it.
+#if LOG_SCAN_SSE2 && (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define LOG_SCAN_AVX2 1
+#endif
+
+namespace log_scan {
+
+namespace {
+
+constexpr std::uint32_t kEscape = 0x1b;
+
+template <typename Char>
+inline bool is_digit(Char c) {
+    return c >= '0' && c <= '9';
+}
+
+template <typename Char>
+inline bool is_alpha(Char c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+}
+
+template <typename Char>
+inline bool is_blank(Char c) {
+    return c == ' ' || c == '\t';
+}
+
+// Characters removed from both ends of a line, as str.strip(" \t\r\f\v").
+template <typename Char>
+inline bool is_trimmed(Char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+template <typename Char>
+inline std::uint32_t fold(Char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<std::uint32_t>(c) + 32 : c;
+}
+
+// Whether the ASCII literal `text` starts at s[pos].
+template <typename Char>
+inline bool has_literal(const Char* s, std::size_t n, std::size_t pos, const char* text) {
+    for (; *text; ++text, ++pos) {
+        if (pos >= n || s[pos] != static_cast<unsigned char>(*text)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Char>
+inline std::size_t skip_blanks(const Char* s, std::size_t n, std::size_t pos) {
+    while (pos < n && is_blank(s[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+template <typename Char>
+inline std::size_t skip_digits(const Char* s, std::size_t n, std::size_t pos) {
+    while (pos < n && is_digit(s[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+// Match one of the keywords at s[pos]; returns its index or -1 and sets end.
+template <typename Char, std::size_t N>
+int match_keyword(const Char* s,
+                  std::size_t n,
+                  std::size_t pos,
+                  const char* const (&keywords)[N],
+                  std::size_t& end) {
+    for (std::size_t i = 0; i < N; ++i) {
+        if (has_literal(s, n, pos, keywords[i])) {
+            end = pos + std::strlen(keywords[i]);
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+// End of the CSI sequence starting with ESC at data[pos], or 0 if there is
+// no complete sequence there.
+template <typename Char>
+std::size_t csi_end(const Char* data, std::size_t size, std::size_t pos, bool sgr_only) {
+    if (pos + 1 >= size || data[pos + 1] != '[') {
+        return 0;
+    }
+    std::size_t p = pos + 2;
+    while (p < size && (is_digit(data[p]) || data[p] == ';')) {
+        ++p;
+    }
+    if (p < size && (sgr_only ? data[p] == 'm' : is_alpha(data[p]))) {
+        return p + 1;
+    }
+    return 0;
+}
+
+// Code units that need more than a copy when indexing lines: control
+// characters (ESC and line breaks among them) and the non-ASCII line breaks
+// of str.splitlines().
+template <typename Char>
+inline bool is_special(Char c) {
+    std::uint32_t u = c;
+    return u < 0x20 || u == 0x85 || u == 0x2028 || u == 0x2029;
+}
+
+// Line breaks of str.splitlines(), or with bytes_breaks of bytes.splitlines().
+template <typename Char>
+inline bool is_line_break(Char c, bool bytes_breaks) {
+    std::uint32_t u = c;
+    if (u == '\n' || u == '\r') {
+        return true;
+    }
+    return !bytes_breaks && (u == 0x0b || u == 0x0c || u == 0x1c || u == 0x1d || u == 0x1e ||
+                             u == 0x85 || u == 0x2028 || u == 0x2029);
+}
+
+inline std::size_t lowest_bit(std::uint64_t mask) {
+#if defined(_MSC_VER)
+    unsigned long bit;
+    if (static_cast<std::uint32_t>(mask) != 0) {
+        _BitScanForward(&bit, static_cast<unsigned long>(mask));
+        return bit;
+    }
+    _BitScanForward(&bit, static_cast<unsigned long>(mask >> 32));
+    return bit + 32;
+#else
+    return static_cast<std::size_t>(__builtin_ctzll(mask));
+#endif
+}
+
+// Output of index_lines while it is being built; out is null when indexing
+// data as it is.
+template <typename Char>
+struct LineIndexer {
+    Char* out;
+    LineOffsets& lines;
+    bool bytes_breaks;
+    std::size_t written = 0;
+    std::size_t line_start = 0;
+    // Whether the last unit written is a '\r' that ended a line, so that a
+    // following '\n' completes the same break. Removed escapes in between
+    // do not count, as in splitlines() of the stripped text.
+    bool after_cr = false;
+
+    // Account for the special unit c, which is (about to be) out[written].
+    void special(Char c) {
+        if (c == '\n' && after_cr) {
+            line_start = written + 1;
+            after_cr = false;
+        } else if (is_line_break(c, bytes_breaks)) {
+            lines.emplace_back(line_start, written);
+            line_start = written + 1;
+            after_cr = c == '\r';
+        } else {
+            after_cr = false;
+        }
+    }
+};
+
+// Index one run of plain units and the special unit after it, starting at
+// data[pos]; returns the position after them.
+template <typename Char>
+std::size_t index_step(const Char* data,
+                       std::size_t size,
+                       std::size_t pos,
+                       bool sgr_only,
+                       LineIndexer<Char>& index) {
+    const Char* special = std::find_if(data + pos, data + size, is_special<Char>);
+    std::size_t at = static_cast<std::size_t>(special - data);
+    if (at > pos) {
+        if (index.out != nullptr) {
+            std::copy(data + pos, special, index.out + index.written);
+        }
+        index.written += at - pos;
+        index.after_cr = false;
+    }
+    if (at == size) {
+        return size;
+    }
+    Char c = *special;
+    if (c == kEscape && index.out != nullptr) {
+        std::size_t end = csi_end(data, size, at, sgr_only);
+        if (end != 0) {
+            return end;
+        }
+    }
+    index.special(c);
+    if (index.out != nullptr) {
+        index.out[index.written] = c;
+    }
+    ++index.written;
+    return at + 1;
+}
+
+// Blocks of 64 bytes whose special bytes are found with SIMD; nothing for
+// other code units.
+template <typename Char>
+std::size_t index_blocks(const Char*, std::size_t, std::size_t pos, bool, LineIndexer<Char>&) {
+    return pos;
+}
+
+#if LOG_SCAN_SSE2
+// Bytes of a 16-byte chunk that are below 0x20 or equal to 0x85.
+inline std::uint64_t special_mask16(const std::uint8_t* data) {
+    const __m128i control_max = _mm_set1_epi8(0x1f);
+    const __m128i next_line = _mm_set1_epi8(static_cast<char>(0x85));
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(chunk, control_max), chunk);
+    __m128i special = _mm_or_si128(control, _mm_cmpeq_epi8(chunk, next_line));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(special));
+}
+
+std::uint64_t special_mask64_sse2(const std::uint8_t* data) {
+    return special_mask16(data) | special_mask16(data + 16) << 16 |
+           special_mask16(data + 32) << 32 | special_mask16(data + 48) << 48;
+}
+
+#if LOG_SCAN_AVX2
+__attribute__((target("avx2"))) std::uint64_t special_mask32(const std::uint8_t* data) {
+    const __m256i control_max = _mm256_set1_epi8(0x1f);
+    const __m256i next_line = _mm256_set1_epi8(static_cast<char>(0x85));
+    __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, control_max), chunk);
+    __m256i special = _mm256_or_si256(control, _mm256_cmpeq_epi8(chunk, next_line));
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(special));
+}
+
+__attribute__((target("avx2"))) std::uint64_t special_mask64_avx2(const std::uint8_t* data) {
+    return special_mask32(data) | special_mask32(data + 32) << 32;
+}
+
+bool has_avx2() {
+    static const bool supported = __builtin_cpu_supports("avx2") != 0;
+    return supported;
+}
+#endif
+
+// Copy 64 bytes at a time, then handle only the special bytes of each block
+// from its bit mask. Blocks without an escape need no further copying; an
+// escape hands over to index_step, which also finishes the last partial block.
+std::size_t index_blocks(const std::uint8_t* data,
+                         std::size_t size,
+                         std::size_t pos,
+                         bool sgr_only,
+                         LineIndexer<std::uint8_t>& index) {
+    std::uint64_t (*special_mask64)(const std::uint8_t*) = special_mask64_sse2;
+#if LOG_SCAN_AVX2
+    if (has_avx2()) {
+        special_mask64 = special_mask64_avx2;
+    }
+#endif
+    while (pos + 64 <= size) {
+        std::uint64_t mask = special_mask64(data + pos);
+        // out never runs ahead of data, so the whole block fits.
+        if (index.out != nullptr) {
+            std::memcpy(index.out + index.written, data + pos, 64);
+        }
+        std::size_t base = index.written;
+        std::size_t plain = 0;  // bytes of the block accounted for
+        bool escape = false;
+        while (mask != 0) {
+            std::size_t bit = lowest_bit(mask);
+            mask &= mask - 1;
+            if (bit > plain) {
+                index.after_cr = false;
+            }
+            index.written = base + bit;
+            std::uint8_t c = data[pos + bit];
+            if (c == kEscape && index.out != nullptr) {
+                pos = index_step(data, size, pos + bit, sgr_only, index);
+                escape = true;
+                break;
+            }
+            index.special(c);
+            ++index.written;
+            plain = bit + 1;
+        }
+        if (!escape) {
+            if (plain < 64) {
+                index.after_cr = false;
+            }
+            index.written = base + 64;
+            pos += 64;
+        }
+    }
+    return pos;
+}
+#endif
+
+const char* const kGccSeverities[] = {"warning", "error", "fatal error", "note"};
+const char* const kMsvcSeverities[] = {"warning", "error", "fatal error"};
+const char* const kGtestStatuses[] = {"OK", "FAILED", "SKIPPED"};
+const char* const kGtestSeverities[] = {"passed", "failed", "skipped"};
+const char* const kPytestOutcomes[] = {"PASSED", "FAILED", "SKIPPED", "ERROR", "XFAIL", "XPASS"};
+const char* const kPytestSeverities[] = {"passed", "failed", "skipped", "error", "xfail", "xpass"};
+
+// "<severity>: <message>" after the position / line / column of a GCC or
+// Clang diagnostic; s[pos] must be the ':' that ends the location.
+template <typename Char>
+bool parse_gcc_tail(const Char* s, std::size_t n, std::size_t pos, Record& record) {
+    if (pos >= n || s[pos] != ':') {
+        return false;
+    }
+    std::size_t end = 0;
+    int severity = match_keyword(s, n, skip_blanks(s, n, pos + 1), kGccSeverities, end);
+    if (severity < 0 || end >= n || s[end] != ':') {
+        return false;
+    }
+    record.severity = kGccSeverities[severity];
+    record.message = {skip_blanks(s, n, end + 1), n};
+    return true;
+}
+
+// Split a trailing " [-Wflag]" off a GCC/Clang message into the code.
+template <typename Char>
+void split_warning_flag(const Char* s, Record& record) {
+    Span& message = record.message;
+    if (message.empty() || s[message.end - 1] != ']') {
+        return;
+    }
+    std::size_t open = message.end - 1;
+    while (open > message.begin && s[open - 1] != '[') {
+        --open;
+    }
+    if (open == message.begin) {
+        return;
+    }
+    --open;  // index of '['
+    Span flag{open + 1, message.end - 1};
+    if (flag.end - flag.begin < 3 || s[flag.begin] != '-' || s[flag.begin + 1] != 'W') {
+        return;
+    }
+    for (std::size_t i = flag.begin; i < flag.end; ++i) {
+        if (s[i] == ']' || is_blank(s[i])) {
+            return;
+        }
+    }
+    std::size_t text_end = open;
+    while (text_end > message.begin && is_blank(s[text_end - 1])) {
+        --text_end;
+    }
+    if (text_end == open) {
+        return;  // the flag must be separated by blanks
+    }
+    record.code = flag;
+    message.end = text_end;
+}
+
+// file:line[:column]: severity: message [-Wflag]
+template <typename Char>
+bool parse_gcc(const Char* s, std::size_t n, Record& record) {
+    for (std::size_t colon = 1; colon < n; ++colon) {
+        if (s[colon] != ':') {
+            continue;
+        }
+        std::size_t line_end = skip_digits(s, n, colon + 1);
+        if (line_end == colon + 1) {
+            continue;
+        }
+        record.file = {0, colon};
+        record.line = {colon + 1, line_end};
+        if (line_end + 1 < n && s[line_end] == ':' && is_digit(s[line_end + 1])) {
+            std::size_t column_end = skip_digits(s, n, line_end + 1);
+            if (parse_gcc_tail(s, n, column_end, record)) {
+                record.column = {line_end + 1, column_end};
+                split_warning_flag(s, record);
+                return true;
+            }
+        }
+        if (parse_gcc_tail(s, n, line_end, record)) {
+            record.column = {};
+            split_warning_flag(s, record);
+            return true;
+        }
+    }
+    return false;
+}
+
+// file(line[,column]): severity CODE: message
+template <typename Char>
+bool parse_msvc(const Char* s, std::size_t n, Record& record) {
+    for (std::size_t paren = 1; paren < n; ++paren) {
+        if (s[paren] != '(') {
+            continue;
+        }
+        std::size_t p = skip_digits(s, n, paren + 1);
+        if (p == paren + 1) {
+            continue;
+        }
+        Span line{paren + 1, p};
+        Span column;
+        if (p + 1 < n && s[p] == ',' && is_digit(s[p + 1])) {
+            column = {p + 1, skip_digits(s, n, p + 1)};
+            p = column.end;
+        }
+        if (p >= n || s[p] != ')') {
+            continue;
+        }
+        p = skip_blanks(s, n, p + 1);
+        if (p >= n || s[p] != ':') {
+            continue;
+        }
+        std::size_t end = 0;
+        int severity = match_keyword(s, n, skip_blanks(s, n, p + 1), kMsvcSeverities, end);
+        if (severity < 0 || end >= n || !is_blank(s[end])) {
+            continue;
+        }
+        std::size_t code_begin = skip_blanks(s, n, end);
+        p = code_begin;
+        while (p < n && s[p] >= 'A' && s[p] <= 'Z') {
+            ++p;
+        }
+        std::size_t digits_begin = p;
+        p = skip_digits(s, n, p);
+        if (digits_begin == code_begin || p == digits_begin) {
+            continue;
+        }
+        std::size_t code_end = p;
+        p = skip_blanks(s, n, p);
+        if (p >= n || s[p] != ':') {
+            continue;
+        }
+        record.severity = kMsvcSeverities[severity];
+        record.file = {0, paren};
+        record.line = line;
+        record.column = column;
+        record.code = {code_begin, code_end};
+        record.message = {skip_blanks(s, n, p + 1), n};
+        return true;
+    }
+    return false;
+}
+
+template <typename Char>
+inline bool is_name_char(Char c) {
+    return is_alpha(c) || is_digit(c) || c == '_' || c == '/';
+}
+
+// [  STATUS  ] Suite.Test[, where ...][ (N ms)]
+template <typename Char>
+bool parse_gtest(const Char* s, std::size_t n, Record& record) {
+    if (n == 0 || s[0] != '[') {
+        return false;
+    }
+    std::size_t p = 1;
+    while (p < n && s[p] == ' ') {
+        ++p;
+    }
+    std::size_t end = 0;
+    int status = p > 1 ? match_keyword(s, n, p, kGtestStatuses, end) : -1;
+    if (status < 0) {
+        return false;
+    }
+    p = end;
+    while (p < n && s[p] == ' ') {
+        ++p;
+    }
+    if (p == end || !has_literal(s, n, p, "] ")) {
+        return false;
+    }
+    std::size_t name_begin = p + 2;
+    if (name_begin >= n || !(is_alpha(s[name_begin]) || s[name_begin] == '_')) {
+        return false;
+    }
+    p = name_begin + 1;
+    while (p < n && is_name_char(s[p])) {
+        ++p;
+    }
+    if (p >= n || s[p] != '.') {
+        return false;
+    }
+    std::size_t test_begin = ++p;
+    while (p < n && is_name_char(s[p])) {
+        ++p;
+    }
+    if (p == test_begin) {
+        return false;
+    }
+    std::size_t name_end = p;
+    if (p < n && !has_literal(s, n, p, ", where ")) {
+        // Only a " (N ms)" timing may follow the name.
+        std::size_t digits = p + 2;
+        std::size_t digits_end = skip_digits(s, n, digits);
+        if (!has_literal(s, n, p, " (") || digits_end == digits ||
+            !has_literal(s, n, digits_end, " ms)") || digits_end + 4 != n) {
+            return false;
+        }
+    }
+    record.severity = kGtestSeverities[status];
+    record.message = {name_begin, name_end};
+    return true;
+}
+
+// path::test OUTCOME ...
+template <typename Char>
+bool parse_pytest(const Char* s, std::size_t n, Record& record) {
+    std::size_t token_end = 0;
+    while (token_end < n && !is_blank(s[token_end])) {
+        ++token_end;
+    }
+    if (token_end == n) {
+        return false;
+    }
+    std::size_t sep = 1;
+    while (sep + 2 < token_end && !(s[sep] == ':' && s[sep + 1] == ':')) {
+        ++sep;
+    }
+    if (sep + 2 >= token_end) {
+        return false;
+    }
+    std::size_t end = 0;
+    int outcome = match_keyword(s, n, skip_blanks(s, n, token_end), kPytestOutcomes, end);
+    if (outcome < 0 || (end < n && !is_blank(s[end]))) {
+        return false;
+    }
+    record.severity = kPytestSeverities[outcome];
+    record.file = {0, sep};
+    record.message = {0, token_end};
+    return true;
+}
+
+template <typename Char>
+bool parse_line(const Char* s, std::size_t n, Record& record) {
+    record = Record();
+    record.kind = Kind::Gcc;
+    if (parse_gcc(s, n, record)) {
+        return true;
+    }
+    record = Record();
+    record.kind = Kind::Msvc;
+    if (parse_msvc(s, n, record)) {
+        return true;
+    }
+    record = Record();
+    record.kind = Kind::Gtest;
+    if (parse_gtest(s, n, record)) {
+        return true;
+    }
+    record = Record();
+    record.kind = Kind::Pytest;
+    return parse_pytest(s, n, record);
+}
+
+// Lines without any of these cannot match a grammar once escapes are gone:
+// ESC, "warning", "error", "note", "] " and "::".
+template <typename Char>
+bool is_candidate(const Char* s, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        switch (s[i]) {
+            case kEscape:
+                return true;
+            case 'w':
+                if (has_literal(s, n, i, "warning")) {
+                    return true;
+                }
+                break;
+            case 'e':
+                if (has_literal(s, n, i, "error")) {
+                    return true;
+                }
+                break;
+            case 'n':
+                if (has_literal(s, n, i, "note")) {
+                    return true;
+                }
+                break;
+            case ']':
+                if (i + 1 < n && s[i + 1] == ' ') {
+                    return true;
+                }
+                break;
+            case ':':
+                if (i + 1 < n && s[i + 1] == ':') {
+                    return true;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return false;
+}
+
+// Offsets of every line containing one needle, in order.
+template <typename Char>
+void needle_lines(const Char* data,
+                  std::size_t size,
+                  const std::vector<Char>& needle,
+                  bool ignore_case,
+                  LineOffsets& out) {
+    const Char* last = data + size;
+    const Char* pos = data;
+    auto equal = [ignore_case](Char a, Char b) {
+        return ignore_case ? fold(a) == fold(b) : a == b;
+    };
+    auto hash = [ignore_case](Char c) {
+        return std::hash<std::uint32_t>()(ignore_case ? fold(c) : c);
+    };
+    std::boyer_moore_horspool_searcher<typename std::vector<Char>::const_iterator,
+                                       decltype(hash), decltype(equal)>
+        searcher(needle.begin(), needle.end(), hash, equal);
+    std::size_t line_floor = 0;
+    while (pos < last) {
+        const Char* hit = searcher(pos, last).first;
+        if (hit == last) {
+            break;
+        }
+        std::size_t hit_at = static_cast<std::size_t>(hit - data);
+        std::size_t start = hit_at;
+        while (start > line_floor && data[start - 1] != '\n') {
+            --start;
+        }
+        std::size_t end = hit_at + find_unit(hit, size - hit_at, static_cast<Char>('\n'));
+        out.emplace_back(start, end);
+        line_floor = end + 1;
+        pos = data + std::min(line_floor, size);
+    }
+}
+
+}  // namespace
+
+const char* kind_name(Kind kind) {
+    switch (kind) {
+        case Kind::Gcc:
+            return "gcc";
+        case Kind::Msvc:
+            return "msvc";
+        case Kind::Gtest:
+            return "gtest";
+        case Kind::Pytest:
+            return "pytest";
+    }
+    return "";
+}
+
+template <typename Char>
+std::size_t find_unit(const Char* data, std::size_t size, Char value) {
+    return static_cast<std::size_t>(std::find(data, data + size, value) - data);
+}
+
+template <>
+std::size_t find_unit<std::uint8_t>(const std::uint8_t* data,
+                                    std::size_t size,
+                                    std::uint8_t value) {
+#if LOG_SCAN_SSE2
+    std::size_t i = 0;
+    const __m128i needle = _mm_set1_epi8(static_cast<char>(value));
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+        if (mask != 0) {
+            return i + lowest_bit(mask);
+        }
+    }
+    for (; i < size; ++i) {
+        if (data[i] == value) {
+            return i;
+        }
+    }
+    return size;
+#else
+    const void* hit = std::memchr(data, value, size);
+    return hit ? static_cast<std::size_t>(static_cast<const std::uint8_t*>(hit) - data) : size;
+#endif
+}
+
+const char* simd_level() {
+#if LOG_SCAN_AVX2
+    if (has_avx2()) {
+        return "avx2";
+    }
+#endif
+#if LOG_SCAN_SSE2
+    return "sse2";
+#else
+    return "none";
+#endif
+}
+
+template <typename Char>
+std::size_t strip_ansi(const Char* data, std::size_t size, Char* out, bool sgr_only) {
+    std::size_t written = 0;
+    std::size_t pos = 0;
+    while (pos < size) {
+        std::size_t escape = pos + find_unit(data + pos, size - pos, static_cast<Char>(kEscape));
+        std::copy(data + pos, data + escape, out + written);
+        written += escape - pos;
+        if (escape == size) {
+            break;
+        }
+        std::size_t end = csi_end(data, size, escape, sgr_only);
+        if (end != 0) {
+            pos = end;
+        } else {
+            out[written++] = data[escape];
+            pos = escape + 1;
+        }
+    }
+    return written;
+}
+
+template <typename Char>
+std::size_t index_lines(const Char* data,
+                        std::size_t size,
+                        Char* out,
+                        bool sgr_only,
+                        bool bytes_breaks,
+                        LineOffsets& lines) {
+    // Typical log lines are longer than 32 units. Reserving for that many
+    // avoids regrowing the offsets; untouched capacity costs no memory.
+    lines.reserve(lines.size() + size / 32);
+    LineIndexer<Char> index{out, lines, bytes_breaks};
+    std::size_t pos = index_blocks(data, size, 0, sgr_only, index);
+    while (pos < size) {
+        pos = index_step(data, size, pos, sgr_only, index);
+    }
+    if (index.line_start < index.written) {
+        lines.emplace_back(index.line_start, index.written);
+    }
+    return index.written;
+}
+
+template <typename Char>
+void select_lines(const Char* data,
+                  std::size_t size,
+                  const std::vector<Needle>& needles,
+                  bool ignore_case,
+                  LineOffsets& out) {
+    LineOffsets merged;
+    LineOffsets lines;
+    LineOffsets scratch;
+    for (const Needle& needle : needles) {
+        std::vector<Char> units;
+        bool representable = true;
+        for (std::uint32_t c : needle) {
+            representable = representable && c <= std::numeric_limits<Char>::max();
+            units.push_back(static_cast<Char>(c));
+        }
+        if (!representable) {
+            continue;  // cannot occur in this buffer
+        }
+        if (units.empty()) {
+            // The empty string is in every line.
+            lines.clear();
+            std::size_t start = 0;
+            while (true) {
+                std::size_t end = start + find_unit(data + start, size - start, Char('\n'));
+                lines.emplace_back(start, end);
+                if (end == size) {
+                    break;
+                }
+                start = end + 1;
+            }
+        } else {
+            lines.clear();
+            needle_lines(data, size, units, ignore_case, lines);
+        }
+        scratch.clear();
+        std::set_union(merged.begin(), merged.end(), lines.begin(), lines.end(),
+                       std::back_inserter(scratch));
+        merged.swap(scratch);
+    }
+    out.insert(out.end(), merged.begin(), merged.end());
+}
+
+template <typename Char>
+void scan_log(const Char* data, std::size_t size, const RecordCallback<Char>& emit) {
+    std::vector<Char> clean;
+    Record record;
+    std::size_t start = 0;
+    while (start < size) {
+        std::size_t end = start + find_unit(data + start, size - start, Char('\n'));
+        const Char* line = data + start;
+        std::size_t length = end - start;
+        if (is_candidate(line, length)) {
+            if (find_unit(line, length, static_cast<Char>(kEscape)) < length) {
+                clean.resize(length);
+                length = strip_ansi(line, length, clean.data(), false);
+                line = clean.data();
+            }
+            std::size_t first = 0;
+            while (first < length && is_trimmed(line[first])) {
+                ++first;
+            }
+            while (length > first && is_trimmed(line[length - 1])) {
+                --length;
+            }
+            if (parse_line(line + first, length - first, record)) {
+                emit(record, line + first, start);
+            }
+        }
+        start = end + 1;
+    }
+}
+
+template std::size_t find_unit<std::uint16_t>(const std::uint16_t*, std::size_t, std::uint16_t);
+template std::size_t find_unit<std::uint32_t>(const std::uint32_t*, std::size_t, std::uint32_t);
+
+#define LOG_SCAN_INSTANTIATE(Char)                                                         \
+    template std::size_t strip_ansi<Char>(const Char*, std::size_t, Char*, bool);          \
+    template std::size_t index_lines<Char>(const Char*, std::size_t, Char*, bool, bool,    \
+                                           LineOffsets&);                                  \
+    template void select_lines<Char>(const Char*, std::size_t, const std::vector<Needle>&, \
+                                     bool, LineOffsets&);                                  \
+    template void scan_log<Char>(const Char*, std::size_t, const RecordCallback<Char>&);
+
+LOG_SCAN_INSTANTIATE(std::uint8_t)
+LOG_SCAN_INSTANTIATE(std::uint16_t)
+LOG_SCAN_INSTANTIATE(std::uint32_t)
+
+}  // namespace log_scan
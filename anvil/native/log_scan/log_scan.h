@@ -0,0 +1,111 @@
+// Log scanning core for Anvil's native `_log_scan` extension.
+//
+// Every function works on a borrowed buffer of fixed-width code units:
+// uint8_t for bytes and Latin-1 strings, uint16_t and uint32_t for wider
+// Python strings. Offsets are indices into that buffer, so for a Python str
+// they are the same as Python string indices.
+//
+// The grammars match the regular expressions of the pure-Python fallback in
+// anvil/parsers/log_scan.py exactly; both are checked against the same
+// Verdict cases.
+
+#ifndef ANVIL_LOG_SCAN_H
+#define ANVIL_LOG_SCAN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace log_scan {
+
+// Half-open range [begin, end) of code units.
+struct Span {
+    std::size_t begin = 0;
+    std::size_t end = 0;
+
+    bool empty() const { return begin == end; }
+};
+
+enum class Kind { Gcc, Msvc, Gtest, Pytest };
+
+// Name of a record kind as exposed to Python ("gcc", "msvc", ...).
+const char* kind_name(Kind kind);
+
+// One diagnostic or test result. Spans index the cleaned line passed to the
+// record callback, not the original buffer.
+struct Record {
+    Kind kind = Kind::Gcc;
+    const char* severity = "";
+    Span file;
+    Span line;    // digits, empty if absent
+    Span column;  // digits, empty if absent
+    Span code;    // empty if absent
+    Span message;
+};
+
+// Called once per record with the cleaned line its spans refer to and the
+// offset of the original line in the buffer.
+template <typename Char>
+using RecordCallback =
+    std::function<void(const Record& record, const Char* line, std::size_t offset)>;
+
+// Needles are stored as code points; for byte buffers they are UTF-8 bytes.
+using Needle = std::vector<std::uint32_t>;
+
+// [start, end) offsets of whole lines, without the '\n'.
+using LineOffsets = std::vector<std::pair<std::size_t, std::size_t>>;
+
+// Index of the first `value` in data[0, size), or size if there is none.
+template <typename Char>
+std::size_t find_unit(const Char* data, std::size_t size, Char value);
+
+// Byte buffers search 16 bytes at a time where SSE2 is available.
+template <>
+std::size_t find_unit<std::uint8_t>(const std::uint8_t* data,
+                                    std::size_t size,
+                                    std::uint8_t value);
+
+// Widest SIMD instruction set used for byte buffers on this CPU: "avx2",
+// "sse2" or "none".
+const char* simd_level();
+
+// Remove ANSI CSI sequences (ESC '[' [0-9;]* letter) from data, writing the
+// result to out, which must have room for size code units. With sgr_only,
+// only sequences ending in 'm' are removed. Returns the output length.
+template <typename Char>
+std::size_t strip_ansi(const Char* data, std::size_t size, Char* out, bool sgr_only);
+
+// strip_ansi that also appends the [start, end) offsets of each line of the
+// output, in the same pass. Lines break as str.splitlines() does, or with
+// bytes_breaks as bytes.splitlines() does ("\n", "\r" and "\r\n" only), so
+// the lines are exactly the splitlines() of the stripped text. Byte buffers
+// are copied 64 bytes at a time and only their control characters are looked
+// at one by one. With a null out, nothing is stripped or copied and the
+// offsets index the lines of data as it is.
+template <typename Char>
+std::size_t index_lines(const Char* data,
+                        std::size_t size,
+                        Char* out,
+                        bool sgr_only,
+                        bool bytes_breaks,
+                        LineOffsets& lines);
+
+// Append the [start, end) offsets of every '\n'-delimited line that contains
+// one of the needles. With ignore_case, ASCII letters match either case.
+template <typename Char>
+void select_lines(const Char* data,
+                  std::size_t size,
+                  const std::vector<Needle>& needles,
+                  bool ignore_case,
+                  LineOffsets& out);
+
+// Scan every '\n'-delimited line for compiler diagnostics and test results.
+template <typename Char>
+void scan_log(const Char* data, std::size_t size, const RecordCallback<Char>& emit);
+
+}  // namespace log_scan
+
+#endif  // ANVIL_LOG_SCAN_H
@@ -0,0 +1,536 @@
+// CPython bindings for the log scanning core (`anvil.parsers._log_scan`).
+//
+// Arguments are str or any bytes-like object (bytes, bytearray, mmap,
+// memoryview). A str is read in place through its PEP 393 storage, so
+// offsets are Python string indices and nothing is copied; bytes-like
+// objects are read through the buffer protocol and their fields are decoded
+// as UTF-8 with replacement. Use anvil.parsers.log_scan rather than this
+// module directly: it falls back to pure Python when the extension is not
+// built.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <cstdint>
+#include <map>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "log_scan.h"
+
+namespace {
+
+// Borrowed code units of a str or bytes-like argument.
+class Text {
+public:
+    Text() = default;
+    Text(const Text&) = delete;
+    Text& operator=(const Text&) = delete;
+
+    ~Text() {
+        if (has_view_) {
+            PyBuffer_Release(&view_);
+        }
+    }
+
+    bool load(PyObject* obj) {
+        if (PyUnicode_Check(obj)) {
+#if PY_VERSION_HEX < 0x030C0000
+            if (PyUnicode_READY(obj) < 0) {
+                return false;
+            }
+#endif
+            is_str = true;
+            kind = PyUnicode_KIND(obj);
+            data = PyUnicode_DATA(obj);
+            size = static_cast<std::size_t>(PyUnicode_GET_LENGTH(obj));
+            return true;
+        }
+        if (PyObject_GetBuffer(obj, &view_, PyBUF_SIMPLE) < 0) {
+            PyErr_Format(PyExc_TypeError, "expected str or a bytes-like object, not %.200s",
+                         Py_TYPE(obj)->tp_name);
+            return false;
+        }
+        has_view_ = true;
+        kind = 1;
+        data = view_.buf;
+        size = static_cast<std::size_t>(view_.len);
+        return true;
+    }
+
+    // Python object for units [begin, end) of a buffer of this text's width.
+    template <typename Char>
+    PyObject* field(const Char* units, std::size_t begin, std::size_t end) const {
+        if (is_str) {
+            return PyUnicode_FromKindAndData(kind, units + begin,
+                                             static_cast<Py_ssize_t>(end - begin));
+        }
+        return PyUnicode_DecodeUTF8(reinterpret_cast<const char*>(units + begin),
+                                    static_cast<Py_ssize_t>(end - begin), "replace");
+    }
+
+    // Same kind of object as the input (str or bytes) holding the given units.
+    template <typename Char>
+    PyObject* same_type(const Char* units, std::size_t length) const {
+        if (is_str) {
+            return PyUnicode_FromKindAndData(kind, units, static_cast<Py_ssize_t>(length));
+        }
+        return PyBytes_FromStringAndSize(reinterpret_cast<const char*>(units),
+                                         static_cast<Py_ssize_t>(length));
+    }
+
+    bool is_str = false;
+    int kind = 1;
+    const void* data = nullptr;
+    std::size_t size = 0;
+
+private:
+    Py_buffer view_{};
+    bool has_view_ = false;
+};
+
+// Call f with the text's code units as the matching pointer type.
+template <typename F>
+PyObject* dispatch(const Text& text, F&& f) {
+    switch (text.kind) {
+        case PyUnicode_2BYTE_KIND:
+            return f(static_cast<const std::uint16_t*>(text.data));
+        case PyUnicode_4BYTE_KIND:
+            return f(static_cast<const std::uint32_t*>(text.data));
+        default:
+            return f(static_cast<const std::uint8_t*>(text.data));
+    }
+}
+
+// Line offsets handed to Python without a copy: a read-only bytes-like
+// object over the core's (start, end) pairs, which anvil.parsers.log_scan
+// views as int64 through memoryview.
+struct LineBounds {
+    PyObject_HEAD
+    log_scan::LineOffsets* lines;
+};
+
+PyTypeObject* line_bounds_type = nullptr;
+
+void line_bounds_dealloc(PyObject* self) {
+    PyTypeObject* type = Py_TYPE(self);
+    delete reinterpret_cast<LineBounds*>(self)->lines;
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+int line_bounds_getbuffer(PyObject* self, Py_buffer* view, int flags) {
+    log_scan::LineOffsets& lines = *reinterpret_cast<LineBounds*>(self)->lines;
+    return PyBuffer_FillInfo(view, self, lines.data(),
+                             static_cast<Py_ssize_t>(lines.size() * sizeof(lines[0])), 1, flags);
+}
+
+PyType_Slot line_bounds_slots[] = {
+    {Py_tp_dealloc, reinterpret_cast<void*>(line_bounds_dealloc)},
+    {Py_bf_getbuffer, reinterpret_cast<void*>(line_bounds_getbuffer)},
+    {Py_tp_doc, const_cast<char*>("Native int64 (start, end) pairs of the lines of a text.")},
+    {0, nullptr},
+};
+
+PyType_Spec line_bounds_spec = {
+    "anvil.parsers._log_scan.LineBounds",
+    sizeof(LineBounds),
+    0,
+    Py_TPFLAGS_DEFAULT,
+    line_bounds_slots,
+};
+
+// Bytes-like object with the int64 (start, end) pairs of lines; takes over
+// the vector when size_t is 64 bits wide.
+PyObject* make_line_bounds(log_scan::LineOffsets& lines) {
+    using Pair = log_scan::LineOffsets::value_type;
+    if (sizeof(Pair) == 2 * sizeof(std::int64_t)) {
+        auto* self = reinterpret_cast<LineBounds*>(line_bounds_type->tp_alloc(line_bounds_type, 0));
+        if (self == nullptr) {
+            return nullptr;
+        }
+        self->lines = new log_scan::LineOffsets(std::move(lines));
+        return reinterpret_cast<PyObject*>(self);
+    }
+    PyObject* bounds = PyBytes_FromStringAndSize(
+        nullptr, static_cast<Py_ssize_t>(lines.size() * 2 * sizeof(std::int64_t)));
+    if (bounds == nullptr) {
+        return nullptr;
+    }
+    auto* out = reinterpret_cast<std::int64_t*>(PyBytes_AS_STRING(bounds));
+    for (const auto& line : lines) {
+        *out++ = static_cast<std::int64_t>(line.first);
+        *out++ = static_cast<std::int64_t>(line.second);
+    }
+    return bounds;
+}
+
+// Interned str for one of the core's static names ("gcc", "warning", ...).
+PyObject* static_name(const char* name) {
+    static std::map<const char*, PyObject*> names;
+    auto it = names.find(name);
+    if (it != names.end()) {
+        Py_INCREF(it->second);
+        return it->second;
+    }
+    PyObject* value = PyUnicode_InternFromString(name);
+    if (value != nullptr) {
+        Py_INCREF(value);
+        names[name] = value;
+    }
+    return value;
+}
+
+// int for a run of ASCII digits, or None if the run is empty.
+template <typename Char>
+PyObject* digits_to_int(const Char* units, const log_scan::Span& span) {
+    if (span.empty()) {
+        Py_RETURN_NONE;
+    }
+    if (span.end - span.begin <= 18) {
+        long long value = 0;
+        for (std::size_t i = span.begin; i < span.end; ++i) {
+            value = value * 10 + static_cast<long long>(units[i] - '0');
+        }
+        return PyLong_FromLongLong(value);
+    }
+    std::string digits(units + span.begin, units + span.end);
+    return PyLong_FromString(digits.c_str(), nullptr, 10);
+}
+
+template <typename Char>
+PyObject* optional_field(const Text& text, const Char* units, const log_scan::Span& span) {
+    if (span.empty()) {
+        Py_RETURN_NONE;
+    }
+    return text.field(units, span.begin, span.end);
+}
+
+// Convert a needle to the code units of the text it is searched in.
+bool load_needle(PyObject* obj, const Text& text, log_scan::Needle& needle) {
+    if (PyUnicode_Check(obj)) {
+        if (text.is_str) {
+            Py_ssize_t length = PyUnicode_GET_LENGTH(obj);
+            for (Py_ssize_t i = 0; i < length; ++i) {
+                needle.push_back(PyUnicode_READ_CHAR(obj, i));
+            }
+            return true;
+        }
+        Py_ssize_t length = 0;
+        const char* utf8 = PyUnicode_AsUTF8AndSize(obj, &length);
+        if (utf8 == nullptr) {
+            return false;
+        }
+        needle.assign(reinterpret_cast<const unsigned char*>(utf8),
+                      reinterpret_cast<const unsigned char*>(utf8) + length);
+        return true;
+    }
+    if (!text.is_str && PyBytes_Check(obj)) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(PyBytes_AS_STRING(obj));
+        needle.assign(bytes, bytes + PyBytes_GET_SIZE(obj));
+        return true;
+    }
+    PyErr_Format(PyExc_TypeError, "needles for a %s must be %s, not %.200s",
+                 text.is_str ? "str" : "bytes-like object", text.is_str ? "str" : "str or bytes",
+                 Py_TYPE(obj)->tp_name);
+    return false;
+}
+
+PyObject* strip_ansi(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"text", "sgr_only", nullptr};
+    PyObject* obj = nullptr;
+    int sgr_only = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|p:strip_ansi",
+                                     const_cast<char**>(keywords), &obj, &sgr_only)) {
+        return nullptr;
+    }
+    Text text;
+    if (!text.load(obj)) {
+        return nullptr;
+    }
+    return dispatch(text, [&](auto units) -> PyObject* {
+        using Char = std::remove_const_t<std::remove_pointer_t<decltype(units)>>;
+        if (log_scan::find_unit(units, text.size, static_cast<Char>(0x1b)) == text.size) {
+            if (PyUnicode_CheckExact(obj) || PyBytes_CheckExact(obj)) {
+                Py_INCREF(obj);
+                return obj;
+            }
+            return text.same_type(units, text.size);
+        }
+        // Stripping removes only ASCII, so the result needs the same str kind.
+        PyObject* result =
+            text.is_str
+                ? PyUnicode_New(static_cast<Py_ssize_t>(text.size), PyUnicode_MAX_CHAR_VALUE(obj))
+                : PyBytes_FromStringAndSize(nullptr, static_cast<Py_ssize_t>(text.size));
+        if (result == nullptr) {
+            return nullptr;
+        }
+        Char* out = static_cast<Char*>(text.is_str ? PyUnicode_DATA(result)
+                                                   : static_cast<void*>(PyBytes_AS_STRING(result)));
+        std::size_t length = 0;
+        Py_BEGIN_ALLOW_THREADS
+        length = log_scan::strip_ansi(units, text.size, out, sgr_only != 0);
+        Py_END_ALLOW_THREADS
+        int resized = text.is_str ? PyUnicode_Resize(&result, static_cast<Py_ssize_t>(length))
+                                  : _PyBytes_Resize(&result, static_cast<Py_ssize_t>(length));
+        return resized < 0 ? nullptr : result;
+    });
+}
+
+// Stripped text and a bytes-like object with the int64 (start, end) pairs of
+// its lines.
+PyObject* index_lines(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"text", "sgr_only", nullptr};
+    PyObject* obj = nullptr;
+    int sgr_only = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|p:index_lines",
+                                     const_cast<char**>(keywords), &obj, &sgr_only)) {
+        return nullptr;
+    }
+    Text text;
+    if (!text.load(obj)) {
+        return nullptr;
+    }
+    try {
+        log_scan::LineOffsets lines;
+        PyObject* stripped = dispatch(text, [&](auto units) -> PyObject* {
+            using Char = std::remove_const_t<std::remove_pointer_t<decltype(units)>>;
+            if (log_scan::find_unit(units, text.size, static_cast<Char>(0x1b)) == text.size) {
+                // Nothing to strip: index the argument in place.
+                PyObject* result = obj;
+                if (PyUnicode_CheckExact(obj) || PyBytes_CheckExact(obj)) {
+                    Py_INCREF(obj);
+                } else {
+                    result = text.same_type(units, text.size);
+                }
+                if (result != nullptr) {
+                    Py_BEGIN_ALLOW_THREADS
+                    log_scan::index_lines<Char>(units, text.size, nullptr, sgr_only != 0,
+                                                !text.is_str, lines);
+                    Py_END_ALLOW_THREADS
+                }
+                return result;
+            }
+            PyObject* result = text.is_str ? PyUnicode_New(static_cast<Py_ssize_t>(text.size),
+                                                           PyUnicode_MAX_CHAR_VALUE(obj))
+                                           : PyBytes_FromStringAndSize(
+                                                 nullptr, static_cast<Py_ssize_t>(text.size));
+            if (result == nullptr) {
+                return nullptr;
+            }
+            void* storage = text.is_str ? PyUnicode_DATA(result)
+                                        : static_cast<void*>(PyBytes_AS_STRING(result));
+            Char* out = static_cast<Char*>(storage);
+            std::size_t length = 0;
+            Py_BEGIN_ALLOW_THREADS
+            length = log_scan::index_lines(units, text.size, out, sgr_only != 0, !text.is_str,
+                                           lines);
+            Py_END_ALLOW_THREADS
+            int resized = text.is_str ? PyUnicode_Resize(&result, static_cast<Py_ssize_t>(length))
+                                      : _PyBytes_Resize(&result, static_cast<Py_ssize_t>(length));
+            return resized < 0 ? nullptr : result;
+        });
+        if (stripped == nullptr) {
+            return nullptr;
+        }
+        PyObject* bounds = make_line_bounds(lines);
+        if (bounds == nullptr) {
+            Py_DECREF(stripped);
+            return nullptr;
+        }
+        return Py_BuildValue("(NN)", stripped, bounds);
+    } catch (const std::bad_alloc&) {
+        return PyErr_NoMemory();
+    }
+}
+
+// Bytes-like object with the int64 (start, end) pairs of the lines of the
+// text as it is; nothing is copied.
+PyObject* line_bounds(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"text", nullptr};
+    PyObject* obj = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O:line_bounds", const_cast<char**>(keywords),
+                                     &obj)) {
+        return nullptr;
+    }
+    Text text;
+    if (!text.load(obj)) {
+        return nullptr;
+    }
+    try {
+        log_scan::LineOffsets lines;
+        dispatch(text, [&](auto units) -> PyObject* {
+            using Char = std::remove_const_t<std::remove_pointer_t<decltype(units)>>;
+            Py_BEGIN_ALLOW_THREADS
+            log_scan::index_lines<Char>(units, text.size, nullptr, false, !text.is_str, lines);
+            Py_END_ALLOW_THREADS
+            return nullptr;
+        });
+        return make_line_bounds(lines);
+    } catch (const std::bad_alloc&) {
+        return PyErr_NoMemory();
+    }
+}
+
+PyObject* select_lines(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"text", "needles", "ignore_case", nullptr};
+    PyObject* obj = nullptr;
+    PyObject* needle_objs = nullptr;
+    int ignore_case = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|p:select_lines",
+                                     const_cast<char**>(keywords), &obj, &needle_objs,
+                                     &ignore_case)) {
+        return nullptr;
+    }
+    Text text;
+    if (!text.load(obj)) {
+        return nullptr;
+    }
+    try {
+        std::vector<log_scan::Needle> needles;
+        PyObject* sequence = PySequence_Fast(needle_objs, "needles must be iterable");
+        if (sequence == nullptr) {
+            return nullptr;
+        }
+        Py_ssize_t count = PySequence_Fast_GET_SIZE(sequence);
+        needles.resize(static_cast<std::size_t>(count));
+        for (Py_ssize_t i = 0; i < count; ++i) {
+            if (!load_needle(PySequence_Fast_GET_ITEM(sequence, i), text, needles[i])) {
+                Py_DECREF(sequence);
+                return nullptr;
+            }
+        }
+        Py_DECREF(sequence);
+
+        log_scan::LineOffsets lines;
+        dispatch(text, [&](auto units) -> PyObject* {
+            Py_BEGIN_ALLOW_THREADS
+            log_scan::select_lines(units, text.size, needles, ignore_case != 0, lines);
+            Py_END_ALLOW_THREADS
+            return nullptr;
+        });
+
+        PyObject* result = PyList_New(static_cast<Py_ssize_t>(lines.size()));
+        if (result == nullptr) {
+            return nullptr;
+        }
+        for (std::size_t i = 0; i < lines.size(); ++i) {
+            PyObject* item = Py_BuildValue("(nn)", static_cast<Py_ssize_t>(lines[i].first),
+                                           static_cast<Py_ssize_t>(lines[i].second));
+            if (item == nullptr) {
+                Py_DECREF(result);
+                return nullptr;
+            }
+            PyList_SET_ITEM(result, static_cast<Py_ssize_t>(i), item);
+        }
+        return result;
+    } catch (const std::bad_alloc&) {
+        return PyErr_NoMemory();
+    }
+}
+
+PyObject* scan_log(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"text", nullptr};
+    PyObject* obj = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O:scan_log", const_cast<char**>(keywords),
+                                     &obj)) {
+        return nullptr;
+    }
+    Text text;
+    if (!text.load(obj)) {
+        return nullptr;
+    }
+    PyObject* result = PyList_New(0);
+    if (result == nullptr) {
+        return nullptr;
+    }
+    bool failed = false;
+    try {
+        dispatch(text, [&](auto units) -> PyObject* {
+            using Char = std::remove_const_t<std::remove_pointer_t<decltype(units)>>;
+            log_scan::scan_log<Char>(
+                units, text.size,
+                [&](const log_scan::Record& record, const Char* line, std::size_t offset) {
+                    if (failed) {
+                        return;
+                    }
+                    PyObject* item = Py_BuildValue(
+                        "(NNNNNNNn)", static_name(log_scan::kind_name(record.kind)),
+                        static_name(record.severity), optional_field(text, line, record.file),
+                        digits_to_int(line, record.line), digits_to_int(line, record.column),
+                        optional_field(text, line, record.code),
+                        text.field(line, record.message.begin, record.message.end),
+                        static_cast<Py_ssize_t>(offset));
+                    failed = item == nullptr || PyList_Append(result, item) < 0;
+                    Py_XDECREF(item);
+                });
+            return nullptr;
+        });
+    } catch (const std::bad_alloc&) {
+        Py_DECREF(result);
+        return PyErr_NoMemory();
+    }
+    if (failed) {
+        Py_DECREF(result);
+        return nullptr;
+    }
+    return result;
+}
+
+PyMethodDef methods[] = {
+    {"strip_ansi", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(strip_ansi)),
+     METH_VARARGS | METH_KEYWORDS,
+     "strip_ansi(text, sgr_only=False)\n--\n\n"
+     "Remove ANSI CSI sequences; with sgr_only, only color sequences."},
+    {"index_lines",
+     reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(index_lines)),
+     METH_VARARGS | METH_KEYWORDS,
+     "index_lines(text, sgr_only=False)\n--\n\n"
+     "strip_ansi() and the (start, end) bounds of each line of the result."},
+    {"line_bounds",
+     reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(line_bounds)),
+     METH_VARARGS | METH_KEYWORDS,
+     "line_bounds(text)\n--\n\n"
+     "(start, end) bounds of each line of the text as it is, without copying it."},
+    {"select_lines",
+     reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(select_lines)),
+     METH_VARARGS | METH_KEYWORDS,
+     "select_lines(text, needles, ignore_case=False)\n--\n\n"
+     "(start, end) offsets of the lines containing any needle."},
+    {"scan_log", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(scan_log)),
+     METH_VARARGS | METH_KEYWORDS,
+     "scan_log(text)\n--\n\n"
+     "Diagnostic and test result records as tuples."},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+PyModuleDef module_def = {
+    PyModuleDef_HEAD_INIT,
+    "_log_scan",
+    "Native log scanning core for anvil.parsers.log_scan.",
+    -1,
+    methods,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+};
+
+}  // namespace
+
+PyMODINIT_FUNC PyInit__log_scan(void) {
+    PyObject* module = PyModule_Create(&module_def);
+    if (module == nullptr) {
+        return nullptr;
+    }
+    line_bounds_type = reinterpret_cast<PyTypeObject*>(PyType_FromSpec(&line_bounds_spec));
+    if (line_bounds_type == nullptr ||
+        PyModule_AddStringConstant(module, "SIMD", log_scan::simd_level()) < 0) {
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
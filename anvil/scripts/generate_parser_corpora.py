@@ -0,0 +1,75 @@
+#!/usr/bin/env python
+"""
+Generate high-volume C++ tool output corpora as Verdict benchmark suites.
+
+Usage:
+    python generate_parser_corpora.py OUTPUT_DIR [--sizes 1K 10K 100K]
+        [--tools clang-tidy cppcheck] [--seed 0] [--files 500]
+
+Run the generated suites (per-case results) with:
+    verdict run --config OUTPUT_DIR/config.yaml --workers 1
+"""
+
+import argparse
+import sys
+from pathlib import Path
+
+# Add anvil to path for imports
+project_root = Path(__file__).parent.parent
+sys.path.insert(0, str(project_root))
+
+from anvil.testing.corpus_generator import (  # noqa: E402
+    DEFAULT_SIZES,
+    CorpusGenerator,
+    format_size,
+    parse_size,
+)
+
+
+def main() -> int:
+    """Main entry point."""
+    parser = argparse.ArgumentParser(
+        description="Generate large C++ tool output corpora for parser benchmarks"
+    )
+    parser.add_argument("output_dir", type=Path, help="Directory to write suites into")
+    parser.add_argument(
+        "--sizes",
+        nargs="+",
+        default=[format_size(size) for size in DEFAULT_SIZES[:3]],
+        help="Diagnostic counts per corpus, e.g. 1K 10K 10M (default: 1K 10K 100K)",
+    )
+    parser.add_argument(
+        "--tools",
+        nargs="+",
+        default=None,
+        help="Corpus formats to generate (default: all)",
+    )
+    parser.add_argument("--seed", type=int, default=0, help="Random seed (default: 0)")
+    parser.add_argument(
+        "--files", type=int, default=500, help="Distinct source files per corpus (default: 500)"
+    )
+    args = parser.parse_args()
+
+    try:
+        sizes = [parse_size(size) for size in args.sizes]
+    except ValueError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 2
+
+    generator = CorpusGenerator(seed=args.seed, files=args.files)
+    unknown = [tool for tool in args.tools or [] if tool not in generator.available_formats()]
+    if unknown:
+        parser.error(
+            f"unknown corpus format(s): {', '.join(unknown)} "
+            f"(choose from {', '.join(generator.available_formats())})"
+        )
+
+    config_path = generator.write_benchmark_suites(args.output_dir, sizes, args.tools)
+
+    print(f"Generated corpora in {args.output_dir}")
+    print(f"Verdict config: {config_path}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,117 @@
+#!/usr/bin/env python
+"""
+Generate the tracing re-exports of Forge, Scout and Verdict.
+
+Each package imports span(), traced() and set_service_name() from its own
+tracing module, which re-exports anvil.utils.tracing and falls back to
+no-ops when Anvil is not installed. The modules are identical apart from
+the package name, so they are written from one template here.
+
+Usage:
+    python generate_tracing_shims.py [--check]
+
+With --check, nothing is written and the exit code is 1 if any module is
+out of date.
+"""
+
+import argparse
+import sys
+from pathlib import Path
+from typing import Dict
+
+# Repository root (the directory holding anvil/, forge/, scout/ and verdict/)
+REPO_ROOT = Path(__file__).resolve().parents[2]
+
+# Generated module (relative to REPO_ROOT) -> package name in its docstring
+SHIMS: Dict[str, str] = {
+    "forge/utils/tracing.py": "Forge",
+    "scout/scout/tracing.py": "Scout",
+    "verdict/verdict/tracing.py": "Verdict",
+}
+
+TEMPLATE = '''"""
+Tracing spans for {package}.
+
+Re-exports Anvil's shared tracing (anvil.utils.tracing) so {package}'s spans
+join the trace of the other tools; set ARGOS_TRACE to a file to turn it on.
+Without Anvil installed, span() and traced() do nothing.
+
+Generated by anvil/scripts/generate_tracing_shims.py; edit the template
+there instead of this file.
+"""
+
+try:
+    from anvil.utils.tracing import set_service_name, span, traced
+except ImportError:  # pragma: no cover - Anvil is optional
+
+    class _NoopSpan:
+        """Span stand-in used without Anvil."""
+
+        def set_attribute(self, key, value):
+            """Do nothing."""
+
+        def end(self):
+            """Do nothing."""
+
+        def __enter__(self):
+            return self
+
+        def __exit__(self, exc_type, exc_val, exc_tb):
+            return False
+
+    _NOOP_SPAN = _NoopSpan()
+
+    def set_service_name(name):
+        """Do nothing."""
+
+    def span(name, /, **attributes):
+        """Return a span that does nothing."""
+        return _NOOP_SPAN
+
+    def traced(name=None, **attributes):
+        """Return the function unchanged."""
+        return lambda func: func
+
+
+__all__ = ["set_service_name", "span", "traced"]
+'''
+
+
+def render(package: str) -> str:
+    """
+    Render the tracing module of one package.
+
+    Args:
+        package: Package name used in the docstring, e.g. "Forge"
+
+    Returns:
+        Module source
+    """
+    return TEMPLATE.format(package=package)
+
+
+def main() -> int:
+    """Main entry point."""
+    parser = argparse.ArgumentParser(description="Generate the per-package tracing re-exports")
+    parser.add_argument(
+        "--check", action="store_true", help="Report out-of-date modules instead of writing"
+    )
+    args = parser.parse_args()
+
+    stale = []
+    for relative_path, package in SHIMS.items():
+        path = REPO_ROOT / relative_path
+        source = render(package)
+        if path.exists() and path.read_text(encoding="utf-8") == source:
+            continue
+        stale.append(relative_path)
+        if not args.check:
+            path.write_text(source, encoding="utf-8")
+
+    for relative_path in stale:
+        print(f"{'Out of date' if args.check else 'Wrote'}: {relative_path}")
+    return 1 if args.check and stale else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -24,3 +24,21 @@ def temp_project(tmp_path):
     project_dir = tmp_path / "test_project"
     project_dir.mkdir()
     return project_dir
+
+
+@pytest.fixture(autouse=True)
+def radon_cache_dir(tmp_path, monkeypatch):
+    """
+    Keep radon's on-disk cache out of the checkout.
+
+    Validators run without a cache_dir default to .anvil/cache/radon under
+    the working directory; point that default at the test's tmp_path.
+
+    Returns:
+        Path to the cache directory used by the test
+    """
+    from anvil.parsers import radon_analyzer
+
+    cache_dir = tmp_path / "radon-cache"
+    monkeypatch.setattr(radon_analyzer, "DEFAULT_CACHE_DIR", str(cache_dir))
+    return cache_dir
@@ -436,6 +436,94 @@ class TestDatabaseQueryPerformance:
         print(f"  Inserts/second: {1000/duration:.0f}")
 
 
+class TestRuleEnginePerformance:
+    """Test performance of rule-based entity selection at scale."""
+
+    ENTITY_COUNT = 1_000_000
+
+    def test_select_by_group_one_million_entities(self, benchmark_timer):
+        """
+        Test group selection over 1M entities with 50 patterns.
+
+        First selection should complete in <10 seconds; re-selecting against
+        unchanged history should be served from cache in <100ms.
+        """
+        from datetime import datetime
+
+        from anvil.core.rule_engine import RuleEngine
+        from anvil.storage.execution_schema import ExecutionDatabase, ExecutionRule
+
+        db = ExecutionDatabase(":memory:")
+        now = datetime.now().isoformat()
+        db.connection.executemany(
+            """
+            INSERT INTO execution_history
+                (execution_id, entity_id, entity_type, timestamp, status, duration)
+            VALUES ('local-1', ?, 'test', ?, 'PASSED', 0.01)
+            """,
+            (
+                (f"tests/pkg_{i % 1000}/test_mod_{i % 97}.py::test_case_{i}", now)
+                for i in range(self.ENTITY_COUNT)
+            ),
+        )
+        db.connection.commit()
+
+        # 25 literal file patterns and 25 glob patterns
+        groups = [f"tests/pkg_{i}/test_mod_{i % 97}.py" for i in range(25)]
+        groups += [f"tests/pkg_{i}?/test_mod_*.py::test_case_*1" for i in range(25, 50)]
+        rule = ExecutionRule(name="large-group", criteria="group", groups=groups)
+        engine = RuleEngine(db)
+
+        with benchmark_timer("Select by group (1M entities, 50 patterns)") as elapsed:
+            selected = engine.select_entities(rule)
+        duration = elapsed()
+
+        with benchmark_timer("Select by group (cached)") as cached_elapsed:
+            cached = engine.select_entities(rule)
+        cached_duration = cached_elapsed()
+
+        db.close()
+
+        assert len(selected) == len(cached) > 0
+        assert duration < 10.0, f"Selection too slow: {duration:.2f}s (expected <10s)"
+        assert (
+            cached_duration < 0.1
+        ), f"Cached selection too slow: {cached_duration*1000:.0f}ms (expected <100ms)"
+
+        print(f"  Selected: {len(selected)}/{self.ENTITY_COUNT}")
+        print(f"  Entities/second: {self.ENTITY_COUNT/duration:.0f}")
+
+    def test_compiled_matcher_faster_than_fnmatch(self, benchmark_timer):
+        """
+        Test that the compiled matcher beats per-pattern fnmatch calls.
+
+        Compares 100k entities against 50 patterns with identical results.
+        """
+        import fnmatch
+
+        from anvil.core.pattern_matcher import PatternMatcher
+
+        entities = [f"tests/pkg_{i % 500}/test_mod.py::test_case_{i}" for i in range(100_000)]
+        patterns = [f"tests/pkg_{i}/*::test_case_*7" for i in range(50)]
+
+        with benchmark_timer("fnmatch (100k entities, 50 patterns)") as elapsed:
+            expected = [
+                e
+                for e in entities
+                if any(fnmatch.fnmatch(e, p) or fnmatch.fnmatch(e, f"{p}*") for p in patterns)
+            ]
+        fnmatch_duration = elapsed()
+
+        with benchmark_timer("Compiled matcher (100k entities, 50 patterns)") as elapsed:
+            actual = PatternMatcher(patterns).filter(entities)
+        compiled_duration = elapsed()
+
+        assert actual == expected
+        assert compiled_duration < fnmatch_duration
+
+        print(f"  Speedup: {fnmatch_duration/compiled_duration:.1f}x")
+
+
 class TestSmartFilteringPerformance:
     """Test performance of smart filtering with many tests."""
 
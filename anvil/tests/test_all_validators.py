@@ -11,6 +11,7 @@ from anvil.validators.autoflake_validator import AutoflakeValidator
 from anvil.validators.black_validator import BlackValidator
 from anvil.validators.clang_format_validator import ClangFormatValidator
 from anvil.validators.clang_tidy_validator import ClangTidyValidator
+from anvil.validators.cpp_metrics_validator import CppMetricsValidator
 from anvil.validators.cppcheck_validator import CppcheckValidator
 from anvil.validators.cpplint_validator import CpplintValidator
 from anvil.validators.flake8_validator import Flake8Validator
@@ -240,6 +241,7 @@ class TestValidatorRegistration:
             ClangFormatValidator(),
             IWYUValidator(),
             GTestValidator(),
+            CppMetricsValidator(),
         ]
 
     def test_all_validators_have_unique_names(self, all_validators):
@@ -278,9 +280,9 @@ class TestValidatorRegistration:
         assert len(python_validators) == 8, "Should have 8 Python validators"
 
     def test_cpp_validators_count(self, all_validators):
-        """Test that we have 6 C++ validators."""
+        """Test that we have 7 C++ validators."""
         cpp_validators = [v for v in all_validators if v.language == "cpp"]
-        assert len(cpp_validators) == 6, "Should have 6 C++ validators"
+        assert len(cpp_validators) == 7, "Should have 7 C++ validators"
 
 
 class TestValidatorIntegration:
@@ -304,9 +306,9 @@ class TestValidatorIntegration:
         registry = ValidatorRegistry()
         register_all_validators(registry)
 
-        # Should have all 14 validators registered
+        # Should have all 15 validators registered
         all_validators = registry.list_all()
-        assert len(all_validators) == 14, "Should have 14 validators registered"
+        assert len(all_validators) == 15, "Should have 15 validators registered"
 
         # Check Python validators
         python_validators = registry.get_validators_by_language("python")
@@ -314,7 +316,7 @@ class TestValidatorIntegration:
 
         # Check C++ validators
         cpp_validators = registry.get_validators_by_language("cpp")
-        assert len(cpp_validators) == 6, "Should have 6 C++ validators"
+        assert len(cpp_validators) == 7, "Should have 7 C++ validators"
 
     def test_all_validators_registered_by_name(self):
         """Test all validators are accessible by name after registration."""
@@ -0,0 +1,234 @@
+"""
+Tests for the hot path benchmark suite and benchmark history.
+
+Covers result statistics, benchmark selection and rounds, every built-in
+benchmark at quick scale, per-commit storage, regression detection and the
+`anvil bench` commands.
+"""
+
+import json
+from argparse import Namespace
+
+import pytest
+
+from anvil.cli.commands import bench_history_command, bench_run_command
+from anvil.storage.benchmark_history import BenchmarkHistory
+from anvil.testing.benchmarks import (
+    BENCHMARKS,
+    Benchmark,
+    BenchmarkResult,
+    build_log,
+    build_log_bytes,
+    pytest_log,
+    run_benchmark,
+    run_benchmarks,
+    select_benchmarks,
+)
+
+
+def _result(name="bench", times=(1.0, 1.0, 1.0), size=100):
+    """Benchmark result with the given round times."""
+    return BenchmarkResult(name, size, "items", list(times))
+
+
+class TestBenchmarkRunner:
+    """Tests for running benchmarks."""
+
+    def test_result_statistics(self):
+        """Verify summary statistics and throughput."""
+        result = _result(times=[0.4, 0.1, 0.2], size=10)
+
+        assert (result.min, result.median) == (0.1, 0.2)
+        assert result.mean == pytest.approx(0.7 / 3)
+        assert result.throughput == pytest.approx(50.0)
+        assert result.to_dict()["stdev"] == pytest.approx(result.stdev)
+        assert result.format_throughput() == "50 items/s"
+        assert BenchmarkResult("b", 3_000_000_000, "bytes", [2.0]).format_throughput() == (
+            "1.50 GB/s"
+        )
+
+    def test_select_by_glob(self):
+        """Verify glob selection keeps suite order."""
+        names = [b.name for b in select_benchmarks(["anvil.parse.*", "scout.*"])]
+
+        assert names == [
+            "anvil.parse.clang_tidy_yaml",
+            "anvil.parse.cppcheck_xml",
+            "anvil.parse.gtest_json",
+            "scout.parse_pytest_log",
+            "scout.parse_log_lines",
+        ]
+        assert len(select_benchmarks()) == len(BENCHMARKS)
+
+    def test_setup_per_round_and_warmup(self, tmp_path):
+        """Verify a fresh setup per round and an untimed warmup round."""
+        setups = []
+        ticks = iter(range(100))
+        benchmark = Benchmark(
+            "fake", {"full": 7, "quick": 3}, "items", lambda size, d: setups.append(size) or list
+        )
+
+        result = run_benchmark(benchmark, scale="quick", repeat=3, timer=lambda: next(ticks))
+
+        assert setups == [3, 3, 3, 3]
+        assert result.times == [1, 1, 1]
+        assert result.size == 3
+
+    def test_missing_package_is_skipped(self):
+        """Verify benchmarks of packages that are not importable are skipped."""
+        benchmark = Benchmark(
+            "fake", {"full": 1, "quick": 1}, "items", None, requires="no_such_package.module"
+        )
+
+        (result,) = run_benchmarks([benchmark], scale="quick")
+
+        assert result.skipped and not result.times
+
+    def test_missing_program_is_skipped(self):
+        """Verify benchmarks running a program that is not installed are skipped."""
+        benchmark = Benchmark(
+            "fake", {"full": 1, "quick": 1}, "items", None, programs=("no-such-program-xyz",)
+        )
+
+        (result,) = run_benchmarks([benchmark], scale="quick")
+
+        assert result.skipped == "no-such-program-xyz not found on PATH"
+
+    def test_invalid_arguments(self):
+        """Verify unknown scales and zero rounds are rejected."""
+        with pytest.raises(ValueError, match="Unknown scale"):
+            run_benchmarks([], scale="huge")
+        with pytest.raises(ValueError, match="at least 1"):
+            run_benchmarks([], repeat=0)
+
+    def test_builtin_benchmarks_quick(self):
+        """Verify every built-in benchmark runs at quick scale."""
+        results = run_benchmarks(BENCHMARKS, scale="quick", repeat=1)
+
+        assert [r.name for r in results] == [b.name for b in BENCHMARKS]
+        for result in results:
+            assert result.skipped or (len(result.times) == 1 and result.median > 0)
+
+
+class TestSyntheticInputs:
+    """Tests for the generated build and pytest logs."""
+
+    def test_build_log(self):
+        """Verify the build log has the intended warning lines."""
+        lines = build_log(200).splitlines()
+
+        assert len(lines) == 200
+        assert sum("warning" in line for line in lines) == 30
+        assert sum("\x1b[" in line for line in lines) == 10
+
+    def test_build_log_bytes(self):
+        """Verify the byte-sized build log ends at a line boundary."""
+        data = build_log_bytes(100_000)
+
+        assert 99_000 < len(data) <= 100_000
+        assert data.endswith(b"\n") and data.startswith(build_log(20_000).encode()[:1000])
+
+    def test_pytest_log_parses(self):
+        """Verify Scout's parser finds every test, failure and duration."""
+        scout_parser = pytest.importorskip("scout.parsers.ci_log_parser")
+
+        results = scout_parser.CILogParser().parse_pytest_log(pytest_log(200))
+
+        assert len(results) == 200
+        failed = [r for r in results if r["outcome"] == "failed"]
+        assert len(failed) == 4 and all(r["error_message"] for r in failed)
+        assert sum(r["duration"] is not None for r in results) == 20
+
+
+class TestBenchmarkHistory:
+    """Tests for per-commit storage and regression detection."""
+
+    @pytest.fixture
+    def history(self, tmp_path):
+        """Benchmark history with three earlier commits of "bench" at 1.0s."""
+        with BenchmarkHistory(tmp_path / "benchmarks.db") as history:
+            for commit in ("c1", "c2", "c3"):
+                history.record_run([_result()], commit=commit, machine="box")
+            yield history
+
+    def test_statuses(self, history):
+        """Verify regressed, improved, unchanged and new statuses."""
+        comparisons = history.compare(
+            [
+                _result("bench", [1.3, 1.25, 1.4]),
+                _result("other", [1.0]),
+            ],
+            commit="c4",
+            machine="box",
+        )
+
+        assert [(c.name, c.status) for c in comparisons] == [
+            ("bench", "regressed"),
+            ("other", "new"),
+        ]
+        assert comparisons[0].baseline == 1.0 and comparisons[0].baseline_runs == 3
+        assert comparisons[0].change == pytest.approx(0.3)
+
+        faster = history.compare([_result(times=[0.5, 0.5])], commit="c4", machine="box")
+        close = history.compare([_result(times=[1.05, 1.05])], commit="c4", machine="box")
+        assert faster[0].status == "improved" and close[0].status == "unchanged"
+
+    def test_noisy_round_is_not_a_regression(self, history):
+        """Verify a slow median with a fast best round is not reported."""
+        (comparison,) = history.compare(
+            [_result(times=[1.0, 1.5, 1.6])], commit="c4", machine="box"
+        )
+
+        assert comparison.status == "unchanged"
+
+    def test_baseline_scope(self, history):
+        """Verify the baseline leaves out the same commit, other machines and sizes."""
+        history.record_run([_result(times=[0.1])], commit="c4", machine="box")
+        history.record_run([_result(times=[0.1])], commit="c5", machine="other")
+        history.record_run([_result(times=[0.1], size=5)], commit="c6", machine="box")
+
+        (comparison,) = history.compare([_result()], commit="c4", machine="box", window=2)
+
+        assert (comparison.baseline, comparison.baseline_runs) == (1.0, 2)
+
+    def test_history_and_skipped_results(self, history):
+        """Verify skipped benchmarks are not stored and history is newest first."""
+        skipped = BenchmarkResult("bench", 100, "items", skipped="not importable")
+        history.record_run([skipped, _result(times=[2.0])], commit="c4", machine="box")
+
+        rows = history.get_history("bench")
+
+        assert [row["git_commit"] for row in rows] == ["c4", "c3", "c2", "c1"]
+        assert rows[0]["median"] == 2.0 and rows[0]["rounds"] == 1
+
+
+class TestBenchCommands:
+    """Tests for `anvil bench run` and `anvil bench history`."""
+
+    def test_run_records_and_flags_regressions(self, tmp_path, monkeypatch, capsys):
+        """Verify a run is recorded and a much faster baseline fails the run."""
+        monkeypatch.chdir(tmp_path)
+        args = Namespace(database=str(tmp_path / "benchmarks.db"))
+        pattern = ["anvil.parse.gtest_json"]
+
+        assert bench_run_command(args, patterns=pattern, scale="quick", repeat=1) == 0
+        assert "No regressions" in capsys.readouterr().out
+
+        with BenchmarkHistory(tmp_path / "benchmarks.db") as history:
+            history.record_run([BenchmarkResult(pattern[0], 2_000, "tests", [1e-9])], commit="fast")
+        assert (
+            bench_run_command(args, patterns=pattern, scale="quick", repeat=1, format="json") == 1
+        )
+        data = json.loads(capsys.readouterr().out)
+        assert data["comparisons"][0]["status"] == "regressed"
+        assert data["commit"] is None
+
+        assert bench_history_command(args, name=pattern[0]) == 0
+        assert capsys.readouterr().out.count("2000") == 3
+
+    def test_no_matching_benchmarks(self, tmp_path, capsys):
+        """Verify an unknown pattern is an error."""
+        args = Namespace(database=str(tmp_path / "benchmarks.db"))
+
+        assert bench_run_command(args, patterns=["nothing.*"], scale="quick") == 2
+        assert "No benchmarks match" in capsys.readouterr().err
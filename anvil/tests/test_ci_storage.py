@@ -6,13 +6,14 @@ execution history analysis and comparison.
 """
 
 from datetime import datetime, timedelta
-from unittest.mock import Mock, patch
+from unittest.mock import Mock
 
 import pytest
 
 from anvil.storage.ci_storage import (
     CIStorageLayer,
     ComparisonStatistics,
+    PlatformFailureStatistics,
     PlatformStatistics,
 )
 from anvil.storage.execution_schema import ExecutionDatabase, ExecutionHistory
@@ -273,85 +274,6 @@ class TestCIStorageLayer:
         assert "WHERE space='ci'" in call_args[0][0]
         assert "timestamp > ?" in call_args[0][0]
 
-    def test_compare_local_vs_ci(self, ci_storage, mock_db):
-        """Test comparing local vs CI executions."""
-        cursor = Mock()
-        mock_db.connection.cursor.return_value = cursor
-
-        now = datetime.now()
-
-        # Mock entity_id query
-        cursor.fetchall.side_effect = [
-            [("test_001",), ("test_002",)],  # Entities list
-        ]
-
-        # Mock the get_local_executions and get_ci_executions calls
-        with patch.object(ci_storage, "get_local_executions") as mock_local:
-            with patch.object(ci_storage, "get_ci_executions") as mock_ci:
-                mock_local.return_value = [
-                    ExecutionHistory(
-                        id=1,
-                        execution_id="exec_001",
-                        entity_id="test_001",
-                        entity_type="test",
-                        timestamp=now,
-                        status="PASSED",
-                        duration=1.5,
-                        space="local",
-                        metadata=None,
-                    )
-                ]
-                mock_ci.return_value = [
-                    ExecutionHistory(
-                        id=2,
-                        execution_id="exec_002",
-                        entity_id="test_001",
-                        entity_type="test",
-                        timestamp=now,
-                        status="FAILED",
-                        duration=2.0,
-                        space="ci",
-                        metadata={"platform": "ubuntu-latest"},
-                    )
-                ]
-
-                result = ci_storage.compare_local_vs_ci()
-
-                # Should return at least one comparison
-                assert isinstance(result, list)
-                if result:
-                    assert isinstance(result[0], ComparisonStatistics)
-
-    def test_get_platform_specific_failures(self, ci_storage, mock_db):
-        """Test getting platform-specific failures."""
-        with patch.object(ci_storage, "compare_local_vs_ci") as mock_compare:
-            mock_compare.return_value = [
-                ComparisonStatistics(
-                    entity_id="test_001",
-                    local_status="PASSED",
-                    ci_status="FAILED",
-                    local_duration=1.5,
-                    ci_duration=2.0,
-                    platform_specific=True,
-                    platforms_failed=["ubuntu-latest"],
-                ),
-                ComparisonStatistics(
-                    entity_id="test_002",
-                    local_status="PASSED",
-                    ci_status="PASSED",
-                    local_duration=1.2,
-                    ci_duration=1.3,
-                    platform_specific=False,
-                    platforms_failed=[],
-                ),
-            ]
-
-            result = ci_storage.get_platform_specific_failures()
-
-            assert isinstance(result, dict)
-            assert "ubuntu-latest" in result
-            assert "test_001" in result["ubuntu-latest"]
-
     def test_get_ci_health_summary(self, ci_storage, mock_db):
         """Test getting CI health summary."""
         cursor = Mock()
@@ -409,3 +331,260 @@ class TestCIStorageLayer:
         call_args = cursor.execute.call_args
         # Verify query includes the custom parameters
         assert call_args is not None
+
+
+class TestCompareLocalVsCI:
+    """Test compare_local_vs_ci against a real database."""
+
+    @pytest.fixture
+    def db(self):
+        """Create an in-memory ExecutionDatabase."""
+        db = ExecutionDatabase(":memory:")
+        yield db
+        db.close()
+
+    @staticmethod
+    def _record(db, entity_id, space, status, days_ago, duration=1.0, platform=None):
+        """Insert one execution of entity_id."""
+        db.insert_execution_history(
+            ExecutionHistory(
+                execution_id=f"{space}-{days_ago}",
+                entity_id=entity_id,
+                entity_type="test",
+                timestamp=datetime.now() - timedelta(days=days_ago),
+                status=status,
+                duration=duration,
+                space=space,
+                metadata={"platform": platform} if platform else None,
+            )
+        )
+
+    def test_latest_execution_per_space(self, db):
+        """Test the newest local and CI execution in the window are compared."""
+        self._record(db, "test_a", "local", "FAILED", 3, duration=3.0)
+        self._record(db, "test_a", "local", "PASSED", 1, duration=1.0)
+        self._record(db, "test_a", "ci", "PASSED", 5, duration=5.0)
+        self._record(db, "test_a", "ci", "FAILED", 2, duration=2.0, platform="windows-latest")
+        self._record(db, "test_b", "local", "PASSED", 1)
+        self._record(db, "test_c", "ci", "PASSED", 40)
+
+        result = CIStorageLayer(db).compare_local_vs_ci(limit_days=30)
+
+        assert result == [
+            ComparisonStatistics("test_a", "PASSED", "FAILED", 1.0, 2.0, True, ["windows-latest"]),
+            ComparisonStatistics("test_b", "PASSED", None, 1.0, None, False, []),
+        ]
+
+    def test_window_limits_latest_and_failures(self, db):
+        """Test executions and failures older than the window are ignored."""
+        self._record(db, "test_a", "local", "PASSED", 1)
+        self._record(db, "test_a", "ci", "FAILED", 20, platform="ubuntu-latest")
+        self._record(db, "test_a", "ci", "FAILED", 2, platform="macos-latest")
+
+        (recent,) = CIStorageLayer(db).compare_local_vs_ci(limit_days=7)
+        (month,) = CIStorageLayer(db).compare_local_vs_ci(limit_days=30)
+
+        assert (recent.ci_status, recent.platforms_failed) == ("FAILED", ["macos-latest"])
+        assert month.platforms_failed == ["macos-latest", "ubuntu-latest"]
+
+    def test_failing_everywhere_is_not_platform_specific(self, db):
+        """Test failures on three platforms are not platform-specific."""
+        for days_ago, platform in enumerate(["macos-latest", "ubuntu-latest", "windows-latest"]):
+            self._record(db, "test_a", "ci", "FAILED", days_ago + 1, platform=platform)
+
+        (comparison,) = CIStorageLayer(db).compare_local_vs_ci()
+
+        assert not comparison.platform_specific
+        assert len(comparison.platforms_failed) == 3
+
+    def test_deleted_history_is_reflected(self, db):
+        """Test deleting the latest execution falls back to the previous one."""
+        self._record(db, "test_a", "ci", "PASSED", 3)
+        self._record(db, "test_a", "ci", "FAILED", 1, platform="ubuntu-latest")
+
+        db.connection.execute("DELETE FROM execution_history WHERE status='FAILED'")
+        db.connection.commit()
+
+        (comparison,) = CIStorageLayer(db).compare_local_vs_ci()
+        assert (comparison.ci_status, comparison.platforms_failed) == ("PASSED", [])
+
+    def test_existing_database_is_backfilled(self, tmp_path):
+        """Test a database created before latest_execution existed is backfilled."""
+        db_path = str(tmp_path / "history.db")
+        db = ExecutionDatabase(db_path)
+        for trigger in (
+            "trg_latest_execution_insert",
+            "trg_latest_execution_delete",
+            "trg_ci_failure_platforms_insert",
+        ):
+            db.connection.execute(f"DROP TRIGGER {trigger}")
+        db.connection.execute("DROP TABLE latest_execution")
+        db.connection.execute("DROP TABLE ci_failure_platforms")
+        self._record(db, "test_a", "local", "PASSED", 2)
+        self._record(db, "test_a", "ci", "FAILED", 1, platform="ubuntu-latest")
+        db.close()
+
+        db = ExecutionDatabase(db_path)
+        try:
+            (comparison,) = CIStorageLayer(db).compare_local_vs_ci()
+        finally:
+            db.close()
+
+        assert (comparison.local_status, comparison.ci_status) == ("PASSED", "FAILED")
+        assert comparison.platforms_failed == ["ubuntu-latest"]
+
+
+class TestPlatformSpecificFailures:
+    """Test platform-specific failure detection over platform_outcomes."""
+
+    MATRIX = [
+        ("windows-latest", "msvc", "Release"),
+        ("windows-latest", "clang", "Release"),
+        ("ubuntu-latest", "gcc", "Release"),
+        ("ubuntu-latest", "clang", "Debug"),
+    ]
+
+    @pytest.fixture
+    def db(self):
+        """Create an in-memory ExecutionDatabase."""
+        db = ExecutionDatabase(":memory:")
+        yield db
+        db.close()
+
+    @staticmethod
+    def _run(db, entity_id, configuration, failing, days_ago=1):
+        """Insert one CI execution of entity_id in a matrix configuration."""
+        runner_os, compiler, build_type = configuration
+        db.insert_execution_history(
+            ExecutionHistory(
+                execution_id=f"ci-{days_ago}",
+                entity_id=entity_id,
+                entity_type="test",
+                timestamp=datetime.now() - timedelta(days=days_ago),
+                status="FAILED" if failing else "PASSED",
+                duration=1.0,
+                space="ci",
+                metadata={
+                    "platform": runner_os,
+                    "compiler": compiler,
+                    "build_type": build_type,
+                },
+            )
+        )
+
+    @staticmethod
+    def _msvc(configuration):
+        """Fail with MSVC only."""
+        return configuration[1] == "msvc"
+
+    def _matrix(self, db, entity_id, failing, nights=5, first_night=1):
+        """Run entity_id nightly across the matrix, failing where failing(configuration)."""
+        for night in range(first_night, first_night + nights):
+            for configuration in self.MATRIX:
+                self._run(db, entity_id, configuration, failing(configuration), night)
+
+    def test_fails_only_on_one_configuration(self, db):
+        """Test a test failing only with MSVC is reported for that configuration."""
+        self._matrix(db, "test_path", self._msvc)
+        self._matrix(db, "test_good", lambda configuration: False)
+
+        (stat,) = CIStorageLayer(db).get_platform_failure_statistics()
+
+        assert stat.configuration == "windows-latest-msvc-Release"
+        assert (stat.failed, stat.total, stat.other_failed, stat.other_total) == (5, 5, 0, 15)
+        # One arrangement in C(20, 5) puts all five failures in this configuration
+        assert stat.p_value == pytest.approx(1 / 15504)
+        assert CIStorageLayer(db).get_platform_specific_failures() == {
+            "windows-latest-msvc-Release": ["test_path"]
+        }
+
+    def test_filter_by_configuration(self, db):
+        """Test filtering by runner OS and compiler keeps the whole matrix as reference."""
+        self._matrix(db, "test_path", self._msvc)
+        self._matrix(db, "test_signal", lambda configuration: configuration[0] == "ubuntu-latest")
+        storage = CIStorageLayer(db)
+
+        windows_msvc = storage.get_platform_failure_statistics(
+            runner_os="windows-latest", compiler="msvc"
+        )
+        ubuntu = storage.get_platform_failure_statistics(runner_os="ubuntu-latest")
+
+        assert [stat.entity_id for stat in windows_msvc] == ["test_path"]
+        assert [stat.configuration for stat in ubuntu] == [
+            "ubuntu-latest-clang-Debug",
+            "ubuntu-latest-gcc-Release",
+        ]
+        assert all(stat.other_failed == 5 for stat in ubuntu)
+
+    def test_failing_everywhere_or_rarely_is_not_platform_specific(self, db):
+        """Test tests failing on every configuration or once are not reported."""
+        self._matrix(db, "test_broken", lambda configuration: True)
+        self._run(db, "test_once", self.MATRIX[0], True)
+        self._run(db, "test_once", self.MATRIX[2], False)
+
+        storage = CIStorageLayer(db)
+
+        assert storage.get_platform_failure_statistics() == []
+        p_values = {
+            (stat.entity_id, stat.configuration): stat.p_value
+            for stat in storage.get_platform_failure_statistics(max_p_value=1.0)
+        }
+        assert p_values[("test_once", "windows-latest-msvc-Release")] == pytest.approx(0.5)
+        assert p_values[("test_broken", "ubuntu-latest-gcc-Release")] == 1.0
+
+    def test_window_and_deleted_history(self, db):
+        """Test outcomes outside the window or deleted from history are not counted."""
+        self._matrix(db, "test_path", self._msvc, nights=3, first_night=20)
+        self._matrix(db, "test_path", self._msvc, nights=4)
+        self._matrix(db, "test_old", self._msvc, nights=3, first_night=20)
+        self._matrix(db, "test_deleted", self._msvc)
+        db.connection.execute("DELETE FROM execution_history WHERE entity_id = 'test_deleted'")
+        db.connection.commit()
+
+        (stat,) = CIStorageLayer(db).get_platform_failure_statistics(limit_days=7)
+
+        assert (stat.entity_id, stat.failed, stat.other_total) == ("test_path", 4, 12)
+
+    def test_local_runs_and_missing_configuration_are_ignored(self, db):
+        """Test only CI runs with a recorded runner OS are counted."""
+        self._matrix(db, "test_path", self._msvc)
+        for metadata, space in (({"platform": "windows-latest"}, "local"), (None, "ci")):
+            db.insert_execution_history(
+                ExecutionHistory(
+                    execution_id="extra",
+                    entity_id="test_path",
+                    entity_type="test",
+                    timestamp=datetime.now(),
+                    status="FAILED",
+                    duration=1.0,
+                    space=space,
+                    metadata=metadata,
+                )
+            )
+
+        (stat,) = CIStorageLayer(db).get_platform_failure_statistics()
+
+        assert (stat.failed, stat.total) == (5, 5)
+
+    def test_configuration_name(self):
+        """Test configurations without compiler or build type are named by OS."""
+        stat = PlatformFailureStatistics("test_a", "windows-latest", "", "", 1, 1, 0, 2, 0.3)
+
+        assert stat.configuration == "windows-latest"
+
+    def test_existing_database_is_backfilled(self, tmp_path):
+        """Test a database created before platform_outcomes existed is backfilled."""
+        db_path = str(tmp_path / "history.db")
+        db = ExecutionDatabase(db_path)
+        db.connection.execute("DROP TRIGGER trg_platform_outcomes_insert")
+        db.connection.execute("DROP TABLE platform_outcomes")
+        self._matrix(db, "test_path", self._msvc)
+        db.close()
+
+        db = ExecutionDatabase(db_path)
+        try:
+            failures = CIStorageLayer(db).get_platform_specific_failures()
+        finally:
+            db.close()
+
+        assert failures == {"windows-latest-msvc-Release": ["test_path"]}
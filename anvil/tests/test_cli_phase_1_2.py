@@ -294,6 +294,20 @@ class TestHistoryShowCommand:
         assert "test_always_passes" in captured.out
         assert "PASSED" in captured.out
 
+    def test_next_page(self, populated_db, monkeypatch, capsys):
+        """Test that a full page points to the next one."""
+        db_dir = Path(populated_db.db_path).parent.parent
+        monkeypatch.chdir(db_dir)
+        entity = "tests/test_stable.py::test_always_passes"
+
+        assert history_show_command(MockArgs(), entity=entity, limit=1) == 0
+        hint = capsys.readouterr().out.splitlines()[-1]
+        before = int(hint.rsplit(" ", 1)[1])
+
+        assert hint.startswith(f"Older executions: anvil history show --entity {entity}")
+        assert history_show_command(MockArgs(before=before), entity=entity, limit=1) == 0
+        assert f"--before {before}" not in capsys.readouterr().out
+
     def test_entity_not_found(self, populated_db, monkeypatch, capsys):
         """Test with non-existent entity."""
         db_dir = Path(populated_db.db_path).parent.parent
@@ -0,0 +1,42 @@
+"""
+Tests for anvil.utils.contingency module.
+
+Checks Fisher's exact p-values against values computed by hand from the
+hypergeometric distribution.
+"""
+
+from math import comb
+
+import pytest
+
+from anvil.utils.contingency import fisher_exact_greater
+
+
+class TestFisherExactGreater:
+    """Test one-sided Fisher's exact test on batches of tables."""
+
+    def test_matches_hypergeometric_tail(self):
+        """Test p-values equal the hypergeometric upper tail."""
+        # [[3, 1], [1, 5]]: 4 of 10 runs fail, 4 of them in the first row
+        expected = sum(comb(4, x) * comb(6, 4 - x) for x in (3, 4)) / comb(10, 4)
+
+        assert fisher_exact_greater([(3, 1, 1, 5)]) == [pytest.approx(expected)]
+
+    def test_batch_keeps_order(self):
+        """Test tables of different sizes are evaluated in one batch, in order."""
+        p_values = fisher_exact_greater([(5, 0, 0, 15), (1, 0, 0, 1), (0, 5, 5, 0)])
+
+        assert p_values == [
+            pytest.approx(1 / comb(20, 5)),
+            pytest.approx(0.5),
+            pytest.approx(1.0),
+        ]
+
+    @pytest.mark.parametrize("table", [(0, 3, 0, 3), (2, 0, 3, 0), (2, 1, 0, 0), (0, 0, 1, 1)])
+    def test_degenerate_tables(self, table):
+        """Test tables with an empty row or column are never significant."""
+        assert fisher_exact_greater([table]) == [1.0]
+
+    def test_empty_batch(self):
+        """Test an empty batch returns no p-values."""
+        assert fisher_exact_greater([]) == []
@@ -11,6 +11,7 @@ from pathlib import Path
 
 import pytest
 
+from anvil.models.line_bitmap import LineBitmap
 from anvil.parsers.coverage_parser import CoverageData, CoverageParser, FileCoverage
 
 
@@ -467,3 +468,149 @@ class TestCoverageParserRegressionDetection:
         result = parser.find_coverage_regressions(empty_current, empty_baseline)
 
         assert len(result) == 0
+
+
+LCOV_INFO = """TN:
+SF:src/widget.cpp
+FN:3,_Z4workv
+FNDA:2,_Z4workv
+DA:3,2
+DA:4,2
+DA:5,0
+DA:6,0
+LF:4
+LH:2
+end_of_record
+SF:include/widget.h
+DA:10,0
+DA:11,1
+end_of_record
+SF:include/widget.h
+DA:10,3
+DA:12,0
+end_of_record
+"""
+
+LLVM_EXPORT = {
+    "data": [
+        {
+            "files": [
+                {
+                    "filename": "src/widget.cpp",
+                    "segments": [
+                        [1, 14, 1, True, True, False],
+                        [3, 5, 0, True, True, False],
+                        [3, 14, 1, True, False, False],
+                        [5, 2, 0, False, False, False],
+                        [7, 1, 0, False, True, False],
+                        [8, 1, 0, True, True, False],
+                        [9, 2, 0, False, False, False],
+                    ],
+                    "summary": {"lines": {"count": 7, "covered": 5}},
+                },
+                {"filename": "include/empty.h", "segments": []},
+            ],
+            "functions": [{"name": "_Z4workv", "filenames": ["src/widget.cpp"]}],
+            "totals": {},
+        }
+    ],
+    "type": "llvm.coverage.json.export",
+    "version": "2.0.1",
+}
+
+
+class TestStreamingFormats:
+    """Test lcov and llvm-cov input and streaming Cobertura input."""
+
+    def test_lcov(self, tmp_path):
+        """Verify DA records and merging of a header listed per translation unit."""
+        path = tmp_path / "coverage.info"
+        path.write_text(LCOV_INFO)
+
+        data = CoverageParser().parse(str(path))
+
+        files = {fc.file_path: fc for fc in data.file_coverage}
+        assert data.files_analyzed == 2
+        assert (data.total_statements, data.covered_statements) == (7, 4)
+        assert files["src/widget.cpp"].missing_lines == [5, 6]
+        header = files["include/widget.h"]
+        assert header.covered_lines == [10, 11] and header.missing_lines == [12]
+        assert header.coverage_percentage == pytest.approx(200 / 3)
+        assert len(list(CoverageParser().iter_file_coverage(str(path)))) == 3
+
+    def test_llvm_cov_segments(self, tmp_path, monkeypatch):
+        """Verify llvm-cov line semantics, read through a small buffer."""
+        import json
+
+        from anvil.parsers import coverage_parser
+
+        monkeypatch.setattr(coverage_parser, "_JSON_CHUNK_SIZE", 16)
+        path = tmp_path / "coverage.json"
+        path.write_text(json.dumps(LLVM_EXPORT, indent=1))
+
+        data = CoverageParser().parse_llvm_cov_json(str(path))
+
+        widget, empty = data.file_coverage
+        # Lines 1-5 run under executed regions, 7 starts a skipped region and
+        # 8-9 sit in a region that never ran
+        assert widget.covered_lines == [1, 2, 3, 4, 5]
+        assert widget.missing_lines == [8, 9]
+        assert (empty.total_statements, empty.coverage_percentage) == (0, 0.0)
+        assert data.total_coverage == pytest.approx(500 / 7)
+
+    def test_llvm_cov_truncated(self, tmp_path):
+        """Verify a truncated export is reported."""
+        import json
+
+        path = tmp_path / "coverage.json"
+        path.write_text(json.dumps(LLVM_EXPORT)[:120])
+
+        with pytest.raises(json.JSONDecodeError):
+            CoverageParser().parse(str(path), "llvm-cov")
+
+    def test_cobertura_method_lines_counted_once(self, tmp_path):
+        """Verify lines repeated under <methods> are not double counted."""
+        path = tmp_path / "coverage.xml"
+        path.write_text("""<?xml version="1.0" ?>
+<coverage line-rate="0.5"><packages><package name="p"><classes>
+<class filename="a.cpp" line-rate="0.5">
+  <methods><method name="f"><lines><line number="2" hits="1"/></lines></method></methods>
+  <lines><line number="2" hits="1"/><line number="3" hits="0"/></lines>
+</class>
+</classes></package></packages></coverage>""")
+
+        (fc,) = CoverageParser().parse(str(path)).file_coverage
+
+        assert (fc.total_statements, fc.covered_statements) == (2, 1)
+        assert fc.missing_lines == [3]
+
+    def test_unknown_format(self, tmp_path):
+        """Verify unknown formats are rejected."""
+        path = tmp_path / "coverage.txt"
+        path.write_text("")
+
+        with pytest.raises(ValueError):
+            CoverageParser().parse(str(path), "gcov")
+
+
+class TestCoverageBitmapDiff:
+    """Test line-level comparison of coverage runs."""
+
+    @staticmethod
+    def _data(*files):
+        """Wrap file coverage in CoverageData."""
+        return CoverageData(0.0, len(files), 0, 0, list(files))
+
+    def test_newly_covered_and_uncovered_lines(self):
+        """Verify per-line changes are counted with bitmap operations."""
+        parser = CoverageParser()
+        lines = LineBitmap(range(1, 11))
+        baseline = self._data(FileCoverage.from_lines("a.cpp", lines, LineBitmap([1, 2, 3])))
+        current = self._data(FileCoverage.from_lines("a.cpp", lines, LineBitmap([1, 4, 5, 6])))
+
+        diff = parser.calculate_coverage_diff(current, baseline)
+        (regression,) = parser.find_coverage_regressions(baseline, current)
+
+        assert diff["files_improved"] == 1
+        assert (diff["lines_newly_covered"], diff["lines_newly_uncovered"]) == (3, 2)
+        assert regression["newly_uncovered_lines"] == [4, 5, 6]
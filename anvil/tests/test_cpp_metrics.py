@@ -0,0 +1,208 @@
+"""
+Tests for the C++ function metrics analyzer and validator.
+
+Covers tokenization, function detection, the individual metrics, parallel
+analysis, threshold warnings and trend recording in code_quality_metrics.
+"""
+
+from pathlib import Path
+
+from anvil.parsers import cpp_metrics_analyzer
+from anvil.parsers.cpp_metrics_analyzer import CppMetricsAnalyzer, analyze_cpp_source, tokenize
+from anvil.storage.execution_schema import ExecutionDatabase
+from anvil.validators.cpp_metrics_validator import CppMetricsValidator
+
+COMPLEX_SOURCE = """
+namespace engine {
+
+// if (commented) { while (out) {} }
+int Engine::run(int n) {
+    const char* label = "if { while";
+    std::vector<int> values(10);
+    for (int i = 0; i < n; ++i) {
+        if (i % 2 || i > 3) {
+            while (ready()) {
+                step(i);
+            }
+        }
+        switch (i) {
+            case 1: break;
+            case 2: break;
+        }
+    }
+    try { step(0); } catch (...) {}
+    return n > 0 ? compute(n) : 0;
+}
+
+int compute(int n) { return step(n); }
+
+}  // namespace engine
+"""
+
+CLASS_SOURCE = """
+class Widget : public Base {
+ public:
+    Widget(int x) : x_{x}, y_(2) { init(); }
+    ~Widget() {}
+    bool operator<(const Widget& o) const { return x_ < o.x_; }
+    int operator()(int v) { return v; }
+    auto size() const -> int { return x_; }
+
+ private:
+    int x_;
+};
+
+struct Point { int x; } origin = {0};
+int table[] = {1, 2};
+"""
+
+
+def _by_name(functions):
+    """Index function metrics by name."""
+    return {f.name: f for f in functions}
+
+
+class TestTokenize:
+    """Tests for the C++ tokenizer."""
+
+    def test_skips_comments_strings_and_preprocessor(self):
+        """Verify braces in comments, literals and directives are ignored."""
+        source = '#define BLOCK {\n// {\n/* { */ x = "{" + R"(})" + \'{\';\n'
+
+        texts = [t for t, _ in tokenize(source)]
+
+        assert "{" not in texts and "}" not in texts
+        assert texts[0] == "x"
+
+    def test_tracks_line_numbers(self):
+        """Verify tokens carry their line, including after block comments."""
+        tokens = tokenize("/* a\nb */ one\ntwo")
+
+        assert tokens == [("one", 2), ("two", 3)]
+
+
+class TestAnalyzeSource:
+    """Tests for per-function metrics."""
+
+    def test_complexity_nesting_length(self):
+        """Verify metrics for a function with every kind of decision point."""
+        run = _by_name(analyze_cpp_source(COMPLEX_SOURCE))["engine::Engine::run"]
+
+        # for, if, ||, while, case, case, catch, ?
+        assert run.complexity == 9
+        assert run.max_nesting == 3
+        assert run.line == 5
+        assert run.length == 17
+
+    def test_fan_out_excludes_keywords_and_declarations(self):
+        """Verify only real call sites count toward fan-out."""
+        run = _by_name(analyze_cpp_source(COMPLEX_SOURCE))["engine::Engine::run"]
+
+        assert run.calls == ["compute", "ready", "step"]
+        assert run.fan_out == 3
+
+    def test_class_members(self):
+        """Verify constructors, destructors and operators are detected."""
+        names = [f.name for f in analyze_cpp_source(CLASS_SOURCE)]
+
+        assert names == [
+            "Widget::Widget",
+            "Widget::~Widget",
+            "Widget::operator<",
+            "Widget::operator()",
+            "Widget::size",
+        ]
+
+    def test_fixture_files(self):
+        """Verify the C++ fixtures are analyzed."""
+        functions = _by_name(
+            analyze_cpp_source(Path("tests/fixtures/cpp/good_code.cpp").read_text())
+        )
+
+        assert functions["example::calculate_sum"].complexity == 2
+        assert functions["main"].fan_out == 2
+
+
+class TestCppMetricsAnalyzer:
+    """Tests for multi-file analysis."""
+
+    def test_fan_in_across_files(self, tmp_path):
+        """Verify fan-in counts callers in other files."""
+        (tmp_path / "a.cpp").write_text("int helper() { return 1; }\n")
+        (tmp_path / "b.cpp").write_text("int f() { return helper(); }\nint g() { helper(); }\n")
+
+        results = CppMetricsAnalyzer().analyze_files([tmp_path / "a.cpp", tmp_path / "b.cpp"])
+
+        assert results[str(tmp_path / "a.cpp")][0].fan_in == 2
+
+    def test_parallel_matches_serial(self, tmp_path):
+        """Verify pooled analysis gives the same results in input order."""
+        files = []
+        for i in range(cpp_metrics_analyzer.MIN_FILES_FOR_POOL + 4):
+            path = tmp_path / f"unit_{i}.cpp"
+            path.write_text(COMPLEX_SOURCE + f"\nint extra_{i}() {{ return compute({i}); }}\n")
+            files.append(path)
+
+        parallel = CppMetricsAnalyzer(jobs=2).analyze_files(files)
+        serial = CppMetricsAnalyzer(jobs=1).analyze_files(files)
+
+        assert parallel == serial
+        assert list(parallel) == [str(f) for f in files]
+
+    def test_unreadable_file(self, tmp_path):
+        """Verify missing files are reported instead of raising."""
+        analyzer = CppMetricsAnalyzer()
+
+        assert analyzer.analyze_files([tmp_path / "missing.cpp"]) == {}
+        assert str(tmp_path / "missing.cpp") in analyzer.errors
+
+
+class TestCppMetricsValidator:
+    """Tests for the validator and trend tracking."""
+
+    def test_threshold_warnings(self, tmp_path):
+        """Verify exceeded thresholds become warnings with error codes."""
+        source = tmp_path / "engine.cpp"
+        source.write_text(COMPLEX_SOURCE)
+
+        result = CppMetricsValidator().validate(
+            [str(source)], {"max_complexity": 5, "max_nesting": 2, "history_database": False}
+        )
+
+        assert not result.passed
+        assert {w.error_code for w in result.warnings} == {"CCN", "NEST"}
+        assert all(w.line_number == 5 for w in result.warnings)
+        assert len(result.metadata["functions"][str(source)]) == 2
+
+    def test_zero_disables_threshold(self, tmp_path):
+        """Verify a threshold of 0 disables that check."""
+        source = tmp_path / "engine.cpp"
+        source.write_text(COMPLEX_SOURCE)
+
+        result = CppMetricsValidator().validate(
+            [str(source)], {"max_complexity": 0, "history_database": False}
+        )
+
+        assert result.passed
+
+    def test_records_trends(self, tmp_path):
+        """Verify each scan accumulates into code_quality_metrics."""
+        source = tmp_path / "engine.cpp"
+        source.write_text(COMPLEX_SOURCE)
+        db_path = tmp_path / "history.db"
+        config = {"max_complexity": 5, "history_database": str(db_path)}
+
+        validator = CppMetricsValidator()
+        validator.validate([str(source)], config)
+        validator.validate([str(source)], config)
+
+        db = ExecutionDatabase(str(db_path))
+        try:
+            (record,) = db.get_code_quality_metrics(file_path=str(source), validator="cpp-metrics")
+        finally:
+            db.close()
+        assert record.total_scans == 2
+        assert record.total_violations == 2
+        assert record.avg_violations_per_scan == 1.0
+        assert record.most_common_code == "CCN"
+        assert record.last_violation is not None
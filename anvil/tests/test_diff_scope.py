@@ -0,0 +1,231 @@
+"""
+Tests for scoping validation results to changed lines.
+
+Covers the line range index, result filtering, diffing the working tree
+against a base commit and the `anvil check --changed-lines` command.
+"""
+
+import subprocess
+from argparse import Namespace
+from pathlib import Path
+from unittest.mock import patch
+
+import pytest
+
+from anvil.cli.commands import check_command
+from anvil.core.file_collector import FileCollector
+from anvil.git.diff_scope import WHOLE_FILE, DiffScope, LineRangeIndex, scope_results
+from anvil.git.staged import StagedContentError
+from anvil.models.validator import Issue, ValidationResult
+
+
+def _git(repo, *args):
+    """Run git in a test repository."""
+    subprocess.run(["git", *args], cwd=repo, check=True, capture_output=True)
+
+
+def _issue(path, line, message="msg"):
+    """Build an error issue."""
+    return Issue(file_path=str(path), line_number=line, message=message, severity="error")
+
+
+@pytest.fixture
+def git_repo(tmp_path):
+    """Create a repository with committed files, an edit and an untracked file."""
+    _git(tmp_path, "init")
+    _git(tmp_path, "config", "user.email", "test@example.com")
+    _git(tmp_path, "config", "user.name", "Test User")
+    (tmp_path / "legacy.cpp").write_text("int a;\nint b;\nint c;\nint d;\n")
+    (tmp_path / "util.py").write_text("x = 1\n")
+    _git(tmp_path, "add", ".")
+    _git(tmp_path, "commit", "-m", "Initial commit")
+
+    (tmp_path / "legacy.cpp").write_text("int a;\nint b2;\nint c;\nint d;\nint e;\n")
+    (tmp_path / "new.cpp").write_text("int f;\n")
+    return tmp_path
+
+
+class TestLineRangeIndex:
+    """Tests for changed line lookup."""
+
+    def test_merges_and_looks_up(self):
+        """Verify overlapping and adjacent ranges merge and lookups bisect."""
+        index = LineRangeIndex([(10, 12), (1, 2), (3, 4), (11, 15), (20, 20)])
+
+        assert index.ranges == [(1, 4), (10, 15), (20, 20)]
+        assert [line in index for line in (1, 4, 5, 9, 15, 16, 20, 21)] == [
+            True,
+            True,
+            False,
+            False,
+            True,
+            False,
+            True,
+            False,
+        ]
+
+    def test_file_level_issues(self):
+        """Verify issues without a line are always in scope."""
+        assert 0 in LineRangeIndex() and None in LineRangeIndex([(3, 3)])
+        assert not LineRangeIndex()
+
+
+class TestScopeResults:
+    """Tests for filtering results."""
+
+    def test_filters_issues(self, tmp_path):
+        """Verify unchanged lines and unchanged files are dropped."""
+        changed, other = tmp_path / "a.cpp", tmp_path / "b.h"
+        indexes = {changed: LineRangeIndex([(5, 6)])}
+        results = [
+            ValidationResult(
+                validator_name="clang-tidy",
+                passed=False,
+                errors=[_issue(changed, 5, "new"), _issue(changed, 1, "old")],
+                warnings=[_issue(other, 3, "header")],
+            ),
+            ValidationResult(
+                validator_name="cppcheck",
+                passed=False,
+                errors=[_issue(changed, 2, "old")],
+            ),
+            ValidationResult(
+                validator_name="cpplint",
+                passed=False,
+                errors=[_issue("", 0, "cpplint not installed")],
+            ),
+        ]
+
+        tidy, cppcheck, cpplint = scope_results(
+            results, indexes, lambda p: Path(p), rewrite_paths=False
+        )
+
+        assert [i.message for i in tidy.errors] == ["new"] and not tidy.warnings
+        assert not tidy.passed
+        assert cppcheck.passed and not cppcheck.errors
+        assert not cpplint.passed and len(cpplint.errors) == 1
+
+    def test_changed_lines_only_disabled(self, tmp_path):
+        """Verify whole changed files are reported when line filtering is off."""
+        path = tmp_path / "a.cpp"
+        result = ValidationResult(validator_name="cppcheck", passed=False, errors=[_issue(path, 1)])
+
+        (scoped,) = scope_results(
+            [result], {path: LineRangeIndex([(5, 5)])}, Path, changed_lines_only=False
+        )
+
+        assert len(scoped.errors) == 1
+
+
+class TestDiffScope:
+    """Tests against a real repository."""
+
+    def test_from_git(self, git_repo):
+        """Verify modified and untracked files with their changed lines."""
+        scope = DiffScope.from_git(git_repo)
+        root = git_repo.resolve()
+
+        assert scope.files == [root / "legacy.cpp", root / "new.cpp"]
+        assert scope.line_ranges == {
+            str(root / "legacy.cpp"): [(2, 2), (5, 5)],
+            str(root / "new.cpp"): [WHOLE_FILE],
+        }
+
+    def test_from_subdirectory(self, git_repo):
+        """Verify untracked files keep their repository paths when run from a subdirectory."""
+        sub = git_repo / "sub"
+        sub.mkdir()
+        (sub / "new.py").write_text("y = 2\n")
+        root = git_repo.resolve()
+
+        scope = DiffScope.from_git(sub)
+
+        assert scope.files == [root / "legacy.cpp", root / "new.cpp", root / "sub" / "new.py"]
+
+    def test_since_commit(self, git_repo):
+        """Verify committed changes count when diffing against an older commit."""
+        _git(git_repo, "add", "legacy.cpp")
+        _git(git_repo, "commit", "-m", "Edit legacy")
+
+        assert [p.name for p in DiffScope.from_git(git_repo).files] == ["new.cpp"]
+        assert [p.name for p in DiffScope.from_git(git_repo, "HEAD~1").files] == [
+            "legacy.cpp",
+            "new.cpp",
+        ]
+
+    def test_unknown_base(self, git_repo):
+        """Verify an unknown base commit is reported."""
+        with pytest.raises(StagedContentError):
+            DiffScope.from_git(git_repo, "no-such-commit")
+
+    def test_filter_results(self, git_repo):
+        """Verify reported paths are resolved before lookup."""
+        scope = DiffScope.from_git(git_repo)
+        result = ValidationResult(
+            validator_name="cppcheck",
+            passed=False,
+            errors=[_issue(git_repo / "legacy.cpp", 1), _issue(git_repo / "legacy.cpp", 5)],
+        )
+
+        (scoped,) = scope.filter_results([result])
+
+        assert [i.line_number for i in scoped.errors] == [5]
+
+    def test_collect_diff_scope_filters_language(self, git_repo):
+        """Verify language filtering of changed files."""
+        (git_repo / "util.py").write_text("x = 2\n")
+        collector = FileCollector(git_repo)
+
+        assert [p.name for p in collector.collect_diff_scope(language="python").files] == [
+            "util.py"
+        ]
+        assert len(collector.collect_diff_scope().files) == 3
+
+
+class TestCheckChangedLines:
+    """Tests for `anvil check --changed-lines`."""
+
+    def test_reports_changed_lines(self, git_repo, monkeypatch):
+        """Verify validators get line ranges and report changed lines only."""
+        monkeypatch.chdir(git_repo)
+        seen = {}
+
+        def run_validator(self, name, files, config):
+            seen.update(files=files, config=config)
+            return ValidationResult(
+                validator_name=name,
+                passed=False,
+                errors=[_issue(f, line) for f in files for line in (1, 2)],
+            )
+
+        args = Namespace(changed_lines=True)
+        with patch("anvil.cli.commands.ValidationOrchestrator.run_validator", run_validator), patch(
+            "anvil.cli.commands.JSONReporter.generate_report"
+        ) as report:
+            exit_code = check_command(args, validator="cppcheck", format="json")
+
+        (result,) = report.call_args[0][0]
+        root = git_repo.resolve()
+        assert exit_code == 1
+        assert seen["files"] == [root / "legacy.cpp", root / "new.cpp"]
+        assert seen["config"]["line_ranges"][str(root / "legacy.cpp")] == [(2, 2), (5, 5)]
+        assert [(Path(i.file_path).name, i.line_number) for i in result.errors] == [
+            ("legacy.cpp", 2),
+            ("new.cpp", 1),
+            ("new.cpp", 2),
+        ]
+
+    def test_nothing_changed(self, git_repo, monkeypatch, capsys):
+        """Verify a clean tree exits successfully."""
+        _git(git_repo, "add", ".")
+        _git(git_repo, "commit", "-m", "Commit all")
+        monkeypatch.chdir(git_repo)
+
+        assert check_command(Namespace(changed_lines=True)) == 0
+        assert "No changed files" in capsys.readouterr().out
+
+    def test_unknown_since(self, git_repo, monkeypatch):
+        """Verify an unknown --since commit is a git error."""
+        monkeypatch.chdir(git_repo)
+
+        assert check_command(Namespace(changed_lines=True, since="no-such-commit")) == 2
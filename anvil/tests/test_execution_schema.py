@@ -147,6 +147,43 @@ class TestExecutionDatabase:
         assert retrieved[0].execution_id == "local-2"
         assert retrieved[1].execution_id == "local-1"
 
+    def test_execution_history_keyset_pagination(self, memory_db):
+        """Test paging through history with before_id, including equal timestamps."""
+        now = datetime(2026, 2, 1, 10, 0, 0)
+        for i in range(5):
+            memory_db.insert_execution_history(
+                ExecutionHistory(
+                    execution_id=f"local-{i}",
+                    entity_id="tests/test_a.py::test_1",
+                    entity_type="test",
+                    timestamp=now + timedelta(minutes=i // 2),
+                    status="PASSED",
+                    duration=1.0,
+                )
+            )
+
+        first = memory_db.get_execution_history(entity_id="tests/test_a.py::test_1", limit=3)
+        second = memory_db.get_execution_history(
+            entity_id="tests/test_a.py::test_1", limit=3, before_id=first[-1].id
+        )
+
+        assert [r.execution_id for r in first + second] == [
+            "local-4",
+            "local-3",
+            "local-2",
+            "local-1",
+            "local-0",
+        ]
+
+        sql = (
+            "EXPLAIN QUERY PLAN SELECT * FROM execution_history WHERE entity_id = ?"
+            " AND (timestamp, id) < (SELECT timestamp, id FROM execution_history WHERE id = ?)"
+            " ORDER BY timestamp DESC, id DESC LIMIT ?"
+        )
+        plan = [row[-1] for row in memory_db.connection.execute(sql, ("x", 1, 3))]
+        assert any("idx_entity_timestamp" in step for step in plan)
+        assert not any("TEMP B-TREE" in step for step in plan)
+
     def test_execution_rule_insert(self, memory_db):
         """Test insertion of execution rules."""
         rule = ExecutionRule(
@@ -730,6 +767,57 @@ class TestCoverageTracking:
         history = db_with_coverage_schema.get_coverage_history(file_path="src/models.py", limit=5)
         assert len(history) == 5
 
+    def test_coverage_lines_round_trip(self, db_with_coverage_schema):
+        """Test line sets are stored run-length encoded and read back."""
+        from anvil.storage.execution_schema import CoverageHistory
+
+        record = CoverageHistory(
+            execution_id="local-123",
+            file_path="src/widget.cpp",
+            timestamp=datetime.now(),
+            total_statements=5000,
+            covered_statements=4000,
+            coverage_percentage=80.0,
+            missing_lines=range(4001, 5001),
+            covered_lines=range(1, 4001),
+        )
+
+        db_with_coverage_schema.insert_coverage_history(record)
+
+        (stored,) = db_with_coverage_schema.get_coverage_history(file_path="src/widget.cpp")
+        missing_json, missing_rle = db_with_coverage_schema.connection.execute(
+            "SELECT missing_lines, missing_lines_rle FROM coverage_history"
+        ).fetchone()
+        assert stored.missing_lines == list(range(4001, 5001))
+        assert stored.covered_lines == list(range(1, 4001))
+        assert missing_json is None and len(missing_rle) < 8
+
+    def test_legacy_json_lines(self, tmp_path):
+        """Test databases with JSON line lists gain the new columns and still read."""
+        path = tmp_path / "history.db"
+        conn = sqlite3.connect(path)
+        conn.execute("""
+            CREATE TABLE coverage_history (
+                id INTEGER PRIMARY KEY AUTOINCREMENT, execution_id TEXT NOT NULL,
+                file_path TEXT NOT NULL, timestamp TEXT NOT NULL,
+                total_statements INTEGER NOT NULL, covered_statements INTEGER NOT NULL,
+                coverage_percentage REAL NOT NULL, missing_lines TEXT,
+                space TEXT DEFAULT 'local', metadata TEXT
+            )
+            """)
+        conn.execute(
+            "INSERT INTO coverage_history VALUES "
+            "(1, 'e1', 'a.py', '2024-01-01T00:00:00', 3, 1, 33.3, '[2, 3]', 'local', NULL)"
+        )
+        conn.commit()
+        conn.close()
+
+        db = ExecutionDatabase(str(path))
+        (record,) = db.get_coverage_history()
+        db.close()
+
+        assert record.missing_lines == [2, 3] and record.covered_lines is None
+
 
 class TestLintTracking:
     """Test lint tracking functionality."""
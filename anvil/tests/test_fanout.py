@@ -0,0 +1,288 @@
+"""
+Tests for ARG_MAX-safe fan-out of file lists across tool subprocesses.
+
+Covers chunking by byte length and core count, the shared process budget,
+result merging and adoption by the subprocess validators.
+"""
+
+import threading
+import time
+from unittest.mock import patch
+
+import pytest
+
+from anvil.core.orchestrator import ValidationOrchestrator
+from anvil.core.validator_registry import ValidatorRegistry
+from anvil.executors import fanout
+from anvil.executors.fanout import arg_length, chunk_files, fan_out, merge_results
+from anvil.models.validator import Issue, ValidationResult
+from anvil.parsers.clang_tidy_parser import ClangTidyParser
+from anvil.validators.clang_tidy_validator import ClangTidyValidator
+from anvil.validators.cppcheck_validator import CppcheckValidator
+from anvil.validators.iwyu_validator import IWYUValidator
+
+
+def _files(count):
+    """Generate file names of equal length."""
+    return [f"src/module_{i:04d}.cpp" for i in range(count)]
+
+
+def _result(chunk, passed=True, **kwargs):
+    """Build a result with one warning per file in the chunk."""
+    return ValidationResult(
+        validator_name="tool",
+        passed=passed,
+        warnings=[
+            Issue(file_path=f, line_number=1, message="w", severity="warning") for f in chunk
+        ],
+        files_checked=len(chunk),
+        **kwargs,
+    )
+
+
+class TestChunkFiles:
+    """Tests for splitting file lists into command lines."""
+
+    def test_respects_byte_limit_and_order(self):
+        """Verify no chunk exceeds the argument budget and order is kept."""
+        files = _files(100)
+        limit = 10 * arg_length(files[0]) + 50
+
+        chunks = chunk_files(files, base_length=50, jobs=1, max_bytes=limit)
+
+        assert [f for chunk in chunks for f in chunk] == files
+        assert all(sum(arg_length(f) for f in chunk) <= limit - 50 for chunk in chunks)
+        assert len(chunks) == 10
+
+    def test_spreads_over_jobs(self):
+        """Verify files are spread across the requested number of chunks."""
+        chunks = chunk_files(_files(100), jobs=4, max_bytes=10**9)
+
+        assert [len(c) for c in chunks] == [25, 25, 25, 25]
+
+    def test_small_lists_are_not_split(self):
+        """Verify chunks keep a minimum size so process starts pay off."""
+        chunks = chunk_files(_files(fanout.MIN_FILES_PER_CHUNK), jobs=8, max_bytes=10**9)
+
+        assert len(chunks) == 1
+
+    def test_max_files(self):
+        """Verify the per-invocation file cap."""
+        assert chunk_files(_files(3), jobs=1, max_bytes=10**9, max_files=1) == [
+            [f] for f in _files(3)
+        ]
+
+    def test_oversized_file_gets_own_chunk(self):
+        """Verify a file longer than the budget is still checked."""
+        files = ["a.cpp", "x" * 200 + ".cpp", "b.cpp"]
+
+        chunks = chunk_files(files, jobs=1, max_bytes=100)
+
+        assert chunks == [["a.cpp"], [files[1]], ["b.cpp"]]
+
+    def test_empty(self):
+        """Verify no files give no chunks."""
+        assert chunk_files([], jobs=4) == []
+
+
+class TestFanOut:
+    """Tests for running and merging chunks."""
+
+    def test_single_chunk_runs_directly(self):
+        """Verify lists that fit one command line are not split."""
+        calls = []
+
+        result = fan_out(lambda chunk: calls.append(chunk) or _result(chunk), _files(3), "tool")
+
+        assert calls == [_files(3)]
+        assert result.files_checked == 3
+
+    def test_chunks_are_merged_in_order(self):
+        """Verify chunk results merge into one result in file order."""
+        files = _files(40)
+
+        result = fan_out(
+            lambda chunk: _result(chunk, passed=files[0] not in chunk),
+            files,
+            "tool",
+            config={"jobs": 4},
+        )
+
+        assert result.validator_name == "tool"
+        assert [w.file_path for w in result.warnings] == files
+        assert result.files_checked == 40
+        assert not result.passed
+
+    def test_whole_program_splits_only_on_byte_limit(self):
+        """Verify cross-file tools get one run unless ARG_MAX forces a split."""
+        files = _files(40)
+        calls = []
+
+        def run(chunk):
+            calls.append(chunk)
+            return _result(chunk)
+
+        fan_out(run, files, "tool", config={"jobs": 4}, whole_program=True)
+        assert len(calls) == 1
+
+        calls.clear()
+        with patch.object(fanout, "arg_max", return_value=20 * arg_length(files[0])):
+            fan_out(run, files, "tool", config={"jobs": 4}, whole_program=True)
+        assert [len(c) for c in calls] == [20, 20]
+
+    def test_process_budget_limits_concurrency(self):
+        """Verify concurrent chunks never exceed the shared process budget."""
+        lock = threading.Lock()
+        running = [0, 0]
+
+        def run(chunk):
+            with lock:
+                running[0] += 1
+                running[1] = max(running[1], running[0])
+            time.sleep(0.02)
+            with lock:
+                running[0] -= 1
+            return _result(chunk)
+
+        fanout.process_budget(2)
+        try:
+            fan_out(run, _files(80), "tool", config={"jobs": 8})
+        finally:
+            fanout.process_budget(fanout.os.cpu_count() or 1)
+
+        assert running[1] == 2
+
+    def test_validators_with_different_max_processes_share_one_cap(self):
+        """Verify concurrent validators never exceed the budget, whatever they configure."""
+        lock = threading.Lock()
+        running = [0, 0]
+
+        def run(chunk):
+            with lock:
+                running[0] += 1
+                running[1] = max(running[1], running[0])
+            time.sleep(0.02)
+            with lock:
+                running[0] -= 1
+            return _result(chunk)
+
+        def validate(max_processes):
+            fan_out(run, _files(80), "tool", config={"jobs": 8, "max_processes": max_processes})
+
+        fanout.process_budget(3)
+        try:
+            threads = [threading.Thread(target=validate, args=(n,)) for n in (2, 6)]
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+        finally:
+            fanout.process_budget(fanout.os.cpu_count() or 1)
+
+        assert running[1] == 3
+
+    def test_orchestrator_sizes_budget_from_run_config(self):
+        """Verify the orchestrator sizes the shared budget once per run."""
+        try:
+            ValidationOrchestrator(ValidatorRegistry()).run_all([], config={"max_processes": 5})
+            assert fanout.process_budget().size == 5
+        finally:
+            fanout.process_budget(fanout.os.cpu_count() or 1)
+
+
+class TestMergeResults:
+    """Tests for combining chunk results."""
+
+    def test_metadata_and_file_lists(self):
+        """Verify metadata merging and error paths that store file lists."""
+        first = ValidationResult(
+            validator_name="tool",
+            passed=True,
+            files_checked=["a.py", "b.py"],
+            metadata={"raw": {"a.py": 1}, "items": [1], "version": "1"},
+        )
+        second = ValidationResult(
+            validator_name="tool",
+            passed=True,
+            files_checked=1,
+            metadata={"raw": {"c.py": 2}, "items": [2], "version": "2"},
+        )
+
+        merged = merge_results([first, second], "tool", 1.5)
+
+        assert merged.files_checked == 3
+        assert merged.execution_time == 1.5
+        assert merged.metadata == {
+            "raw": {"a.py": 1, "c.py": 2},
+            "items": [1, 2],
+            "version": "1",
+        }
+        assert first.metadata["raw"] == {"a.py": 1}
+
+
+class TestValidatorAdoption:
+    """Tests for validators running through fan_out."""
+
+    @pytest.fixture
+    def cpp_files(self, tmp_path):
+        """Create enough C++ files to fan out."""
+        return [str(tmp_path / f"unit_{i}.cpp") for i in range(32)]
+
+    def test_cppcheck_chunks(self, cpp_files):
+        """Verify cppcheck runs per chunk and merges."""
+        with patch(
+            "anvil.validators.cppcheck_validator.CppcheckParser.run_and_parse",
+            side_effect=lambda chunk, config: _result([str(f) for f in chunk]),
+        ) as run:
+            result = CppcheckValidator().validate(cpp_files, {"jobs": 4})
+
+        assert run.call_count == 4
+        assert [w.file_path for w in result.warnings] == cpp_files
+
+    def test_clang_tidy_chunks_fit_with_line_filter(self, cpp_files):
+        """Verify clang-tidy chunks fit the argument limit including --line-filter."""
+        config = {
+            "jobs": 1,
+            "line_ranges": {f: [(i, i + 1) for i in range(1, 40, 2)] for f in cpp_files},
+        }
+        limit = sum(arg_length(a) for a in ClangTidyParser.build_command([], config)) + 4000
+        chunks = []
+
+        def run(chunk, config):
+            chunks.append(chunk)
+            return _result([str(f) for f in chunk])
+
+        with patch.object(fanout, "arg_max", return_value=limit), patch(
+            "anvil.validators.clang_tidy_validator.ClangTidyParser.run_and_parse",
+            side_effect=run,
+        ):
+            result = ClangTidyValidator().validate(cpp_files, config)
+
+        assert len(chunks) > 1
+        assert all(
+            sum(arg_length(a) for a in ClangTidyParser.build_command(chunk, config)) <= limit
+            for chunk in chunks
+        )
+        assert [w.file_path for w in result.warnings] == cpp_files
+
+    def test_cppcheck_unused_function_is_whole_program(self, cpp_files):
+        """Verify unusedFunction keeps all files in one cppcheck run."""
+        with patch(
+            "anvil.validators.cppcheck_validator.CppcheckParser.run_and_parse",
+            side_effect=lambda chunk, config: _result(chunk),
+        ) as run:
+            CppcheckValidator().validate(cpp_files, {"jobs": 4, "enable": ["unusedFunction"]})
+
+        assert run.call_count == 1
+
+    def test_iwyu_runs_one_file_per_invocation(self, cpp_files):
+        """Verify IWYU gets one translation unit per process."""
+        with patch(
+            "anvil.validators.iwyu_validator.IWYUParser.run",
+            side_effect=lambda chunk, **kwargs: _result(chunk),
+        ) as run:
+            result = IWYUValidator().validate(cpp_files[:3], {"mapping_file": "qt.imp"})
+
+        assert [c.args[0] for c in run.call_args_list] == [[f] for f in cpp_files[:3]]
+        assert run.call_args.kwargs["mapping_file"] == "qt.imp"
+        assert result.files_checked == 3
@@ -0,0 +1,85 @@
+"""
+Tests for LineBitmap line sets.
+
+Covers building from lines and ranges, set operations, the run-length
+encoding and compatibility with code that expects line lists.
+"""
+
+import random
+
+import pytest
+
+from anvil.models.line_bitmap import LineBitmap, LineBitmapBuilder
+
+
+class TestBuilding:
+    """Tests for constructing bitmaps."""
+
+    def test_lines_and_ranges(self):
+        """Verify lines, byte-spanning ranges and duplicates."""
+        builder = LineBitmapBuilder()
+        builder.add_range(5, 30)
+        builder.add_range(3, 2)
+        builder.add(64)
+        builder.add(64)
+
+        bitmap = builder.build()
+
+        assert bitmap.ranges() == [(5, 30), (64, 64)]
+        assert len(bitmap) == 27
+        assert LineBitmap.from_ranges([(64, 64), (5, 30)]) == bitmap
+
+    def test_negative_line(self):
+        """Verify negative line numbers are rejected."""
+        with pytest.raises(ValueError):
+            LineBitmap([-1])
+
+
+class TestOperations:
+    """Tests for set operations and list compatibility."""
+
+    def test_set_operations(self):
+        """Verify operators match Python set semantics."""
+        a, b = LineBitmap([1, 2, 3, 10]), LineBitmap([3, 4, 10, 200])
+
+        assert a & b == [3, 10]
+        assert a | b == [1, 2, 3, 4, 10, 200]
+        assert a - b == [1, 2]
+        assert a ^ b == [1, 2, 4, 200]
+
+    def test_list_compatibility(self):
+        """Verify equality, membership, iteration and slicing like a list."""
+        bitmap = LineBitmap([9, 3, 5])
+
+        assert bitmap == [3, 5, 9] and bitmap != [3, 5] and bitmap != [3, 3, 5, 9]
+        assert list(bitmap) == [3, 5, 9] and bitmap[:2] == [3, 5] and bitmap[-1] == 9
+        assert 5 in bitmap and 4 not in bitmap and -1 not in bitmap
+        assert not LineBitmap() and LineBitmap() == []
+
+
+class TestEncoding:
+    """Tests for the run-length encoding."""
+
+    def test_layout(self):
+        """Verify alternating gap and run varints, with multi-byte values."""
+        assert LineBitmap([3, 4, 5, 9]).to_rle() == bytes([3, 3, 3, 1])
+        assert LineBitmap([300]).to_rle() == bytes([0xAC, 0x02, 1])
+        assert LineBitmap().to_rle() == b""
+
+    def test_round_trip(self):
+        """Verify random line sets survive encoding."""
+        rng = random.Random(0)
+        for _ in range(50):
+            lines = set(rng.sample(range(20000), rng.randint(0, 500)))
+            bitmap = LineBitmap(lines)
+            assert LineBitmap.from_rle(bitmap.to_rle()) == bitmap
+            assert list(bitmap) == sorted(lines)
+
+    def test_runs_are_compact(self):
+        """Verify long runs take a few bytes regardless of length."""
+        assert len(LineBitmap.from_ranges([(1, 100000), (200000, 300000)]).to_rle()) == 10
+
+    def test_truncated(self):
+        """Verify data ending inside a varint is rejected."""
+        with pytest.raises(ValueError):
+            LineBitmap.from_rle(bytes([3, 0x80]))
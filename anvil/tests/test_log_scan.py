@@ -0,0 +1,228 @@
+"""
+Tests for the log scanner and its native/pure-Python parity.
+
+Covers ANSI stripping, line indexing, line selection, diagnostic and test
+result records,
+memory-mapped files, the Verdict parity cases and randomized comparison of
+the native extension with the fallback. Native tests are skipped when the
+extension is not built, unless ANVIL_LOG_SCAN=native requires it.
+"""
+
+import os
+import random
+from pathlib import Path
+
+import pytest
+
+from anvil.parsers import log_scan
+from anvil.parsers.log_scan import (
+    IMPLEMENTATION_ENV,
+    LineIndex,
+    LogRecord,
+    PythonScanner,
+    load_backend,
+    scan_log_file,
+)
+
+CONFIG = Path(__file__).parent / "validation" / "log_scan" / "config.yaml"
+
+
+def _native():
+    """The native extension, skipping the test if it is not built."""
+    if os.environ.get(IMPLEMENTATION_ENV) == "native":
+        return load_backend("native")
+    try:
+        return load_backend("native")
+    except ImportError:
+        pytest.skip("native _log_scan extension is not built")
+
+
+@pytest.fixture(params=["python", "native"])
+def scanner(request):
+    """Each log scanning implementation."""
+    return PythonScanner if request.param == "python" else _native()
+
+
+class TestStripAnsi:
+    """Tests for ANSI escape removal."""
+
+    def test_all_sequences_or_colors_only(self, scanner):
+        """Verify CSI sequences are removed and sgr_only keeps non-color ones."""
+        text = "\x1b[1;31mred\x1b[0m \x1b[2Kcleared \x1b[ kept \x1b"
+
+        assert scanner.strip_ansi(text) == "red cleared \x1b[ kept \x1b"
+        assert scanner.strip_ansi(text, True) == "red \x1b[2Kcleared \x1b[ kept \x1b"
+
+    def test_bytes_like_input(self, scanner):
+        """Verify bytes-like objects are stripped to bytes."""
+        data = "\x1b[32mok é\x1b[0m".encode()
+
+        assert scanner.strip_ansi(bytearray(data)) == "ok é".encode()
+        assert scanner.strip_ansi(memoryview(b"plain")) == b"plain"
+        with pytest.raises(TypeError):
+            scanner.strip_ansi(42)
+
+
+class TestIndexLines:
+    """Tests for stripping and line indexing in one pass."""
+
+    def test_lines_of_stripped_text(self, scanner):
+        """Verify the lines are splitlines() of the stripped text."""
+        text = "\x1b[1mone\x1b[0m\r\ntwo\r\x1b[0m\nthree\x0bfour\u2028\n\nlast"
+
+        lines = LineIndex(*scanner.index_lines(text))
+
+        assert lines.text == "one\r\ntwo\r\nthree\x0bfour\u2028\n\nlast"
+        assert list(lines) == lines.text.splitlines()
+        assert list(lines.starts) == [0, 5, 10, 16, 21, 22, 23]
+        assert list(lines.ends) == [3, 8, 15, 20, 21, 22, 27]
+        assert lines[-1] == "last" and lines[1:3] == ["two", "three"]
+
+    def test_bytes_break_only_on_newlines(self, scanner):
+        """Verify bytes split as bytes.splitlines() does."""
+        data = "a\x0bb\u2028c\rd\n".encode()
+
+        lines = LineIndex(*scanner.index_lines(memoryview(data)))
+
+        assert list(lines) == data.splitlines() == [b"a\x0bb\xe2\x80\xa8c", b"d"]
+
+    def test_sgr_only_and_empty(self, scanner):
+        """Verify sgr_only keeps other sequences and empty text has no lines."""
+        lines = LineIndex(*scanner.index_lines("\x1b[2K\x1b[32mok\x1b[0m\n", True))
+
+        assert list(lines) == ["\x1b[2Kok"]
+        assert len(LineIndex(*scanner.index_lines(""))) == 0
+
+    def test_line_bounds_keep_escapes(self, scanner):
+        """Verify line_bounds indexes the text as-is, escapes included."""
+        data = b"\x1b[31mred\x1b[0m\r\nnext"
+
+        lines = LineIndex(data, scanner.line_bounds(data))
+
+        assert list(lines) == data.splitlines()
+        assert list(lines.starts) == [0, 14] and list(lines.ends) == [12, 18]
+
+
+class TestSelectLines:
+    """Tests for line selection."""
+
+    TEXT = "alpha warning\nbeta\nWARNING gamma\n\nwarning"
+
+    def test_offsets_of_matching_lines(self, scanner):
+        """Verify each matching line is reported once with its offsets."""
+        lines = scanner.select_lines(self.TEXT, ["warning", "alpha"])
+
+        assert lines == [(0, 13), (34, 41)]
+        assert [self.TEXT[s:e] for s, e in lines] == ["alpha warning", "warning"]
+
+    def test_ascii_case_folding(self, scanner):
+        """Verify ignore_case folds ASCII letters only."""
+        assert scanner.select_lines(self.TEXT, ["warning"], True) == [(0, 13), (19, 32), (34, 41)]
+        assert scanner.select_lines("\u212aelvin", ["k"], True) == []
+
+    def test_needle_types(self, scanner):
+        """Verify str and bytes needles on bytes, str only on str, empty needles."""
+        data = self.TEXT.encode()
+
+        assert scanner.select_lines(data, [b"beta", "gamma"]) == [(14, 18), (19, 32)]
+        assert scanner.select_lines("a\nb\n", [""]) == [(0, 1), (2, 3), (4, 4)]
+        assert scanner.select_lines("a", []) == []
+        with pytest.raises(TypeError):
+            scanner.select_lines("a", [b"a"])
+
+
+class TestScanLog:
+    """Tests for diagnostic and test result records."""
+
+    def test_records(self, scanner):
+        """Verify one record per recognized line, in log order."""
+        text = (
+            "\x1b[1ma.cpp:3:7: \x1b[35mwarning:\x1b[0m unused 'x' [-Wunused-variable]\r\n"
+            "b.cpp(4,2): error C2065: 'y': undeclared\n"
+            "[  FAILED  ] Suite.Case (3 ms)\n"
+            "tests/test_a.py::test_b PASSED [ 50%]\n"
+        )
+
+        records = [LogRecord._make(r) for r in scanner.scan_log(text)]
+        node_id = "tests/test_a.py::test_b"
+
+        assert records == [
+            LogRecord("gcc", "warning", "a.cpp", 3, 7, "-Wunused-variable", "unused 'x'", 0),
+            LogRecord("msvc", "error", "b.cpp", 4, 2, "C2065", "'y': undeclared", 65),
+            LogRecord("gtest", "failed", None, None, None, None, "Suite.Case", 106),
+            LogRecord("pytest", "passed", "tests/test_a.py", None, None, None, node_id, 137),
+        ]
+
+    def test_offsets_are_code_units(self, scanner):
+        """Verify offsets index str by character and bytes by byte."""
+        text = "é€😀\nx.c:1: error: ü\n"
+
+        (from_str,) = scanner.scan_log(text)
+        (from_bytes,) = scanner.scan_log(text.encode())
+
+        assert from_str[-1] == 4 and from_bytes[-1] == 10
+        assert from_str[:-1] == from_bytes[:-1]
+
+    def test_scan_log_file(self, tmp_path):
+        """Verify files are scanned through a memory map, empty files included."""
+        path = tmp_path / "build.log"
+        path.write_bytes("é\nsrc/x.cpp:2:1: note: here\n".encode())
+        empty = tmp_path / "empty.log"
+        empty.touch()
+
+        assert scan_log_file(path) == [LogRecord("gcc", "note", "src/x.cpp", 2, 1, None, "here", 3)]
+        assert scan_log_file(empty) == []
+
+
+class TestBackends:
+    """Tests for choosing the implementation."""
+
+    def test_load_backend(self):
+        """Verify the python backend and rejection of unknown names."""
+        assert load_backend("python") is PythonScanner
+        assert log_scan.IMPLEMENTATION in ("native", "python")
+        with pytest.raises(ValueError, match="Unknown log scan implementation"):
+            load_backend("rust")
+
+
+class TestParity:
+    """Tests that the native scanner and the fallback agree."""
+
+    def test_verdict_cases(self):
+        """Verify both implementations pass the shared Verdict cases."""
+        verdict_runner = pytest.importorskip("verdict.runner")
+
+        results = verdict_runner.TestRunner(CONFIG).run_all()
+
+        python = [r for r in results if r.suite_name == "log_scan_python"]
+        assert len(python) == 5
+        assert all(r.passed for r in python), [r.to_dict() for r in python]
+        _native()
+        assert all(r.passed for r in results), [r.to_dict() for r in results]
+
+    def test_random_logs(self):
+        """Verify identical results on randomly assembled log fragments."""
+        native = _native()
+        fragments = (
+            "src/a.cpp|C:\\b.cpp|:|::|(|)|,|12| |\t|\r|\n|\n|warning|error|fatal error|note|"
+            "C4996|[|]|[-Wall]|-W|\x1b[|\x1b[1;31m|\x1b[0m|\x1b|m|[  FAILED  ] |[       OK ] |"
+            "Suite.Test|, where | (5 ms)|PASSED|XFAIL|ERROR|é|\u20ac|\U0001f600|\u212a|Running|"
+            ".|_|/|\x0b|\x1c|\x85|\u2028"
+        ).split("|")
+        needles = ["warning", "::", "running", "\u212a", "é", ""]
+        rng = random.Random(0)
+
+        for _ in range(1000):
+            text = "".join(rng.choice(fragments) for _ in range(rng.randint(0, 30)))
+            chosen = rng.sample(needles, rng.randint(0, 2))
+            ignore_case = rng.random() < 0.5
+            for value in (text, text.encode()):
+                assert native.scan_log(value) == PythonScanner.scan_log(value), value
+                assert native.strip_ansi(value) == PythonScanner.strip_ansi(value), value
+                assert native.strip_ansi(value, True) == PythonScanner.strip_ansi(value, True)
+                stripped, bounds = native.index_lines(value)
+                assert (stripped, bytes(bounds)) == PythonScanner.index_lines(value), value
+                assert bytes(native.line_bounds(value)) == PythonScanner.line_bounds(value)
+                assert native.select_lines(value, chosen, ignore_case) == (
+                    PythonScanner.select_lines(value, chosen, ignore_case)
+                ), (value, chosen)
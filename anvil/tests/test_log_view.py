@@ -0,0 +1,108 @@
+"""
+Tests for memory-mapped log views.
+
+Covers opening files (including empty ones), line access and decoding, byte
+ranges, line numbers, grep over mapped data, scanning records in place and
+closing the mapping.
+"""
+
+import mmap
+
+import pytest
+
+from anvil.parsers.log_view import LogView
+
+LOG = (
+    "Running tests\n"
+    "src/a.cpp:3:5: warning: unused variable [-Wunused]\r\n"
+    "caf\xe9 ok\rsecond ERROR on one line\n"
+    "\n"
+    "[  FAILED  ] Suite.Broken (5 ms)\n"
+    "done"
+).encode()
+
+
+@pytest.fixture
+def log_file(tmp_path):
+    """A log file on disk."""
+    path = tmp_path / "build.log"
+    path.write_bytes(LOG)
+    return path
+
+
+class TestLogView:
+    """Tests for LogView."""
+
+    def test_open_maps_file(self, log_file):
+        """Verify a file is mapped read-only and unmapped on close."""
+        with LogView.open(log_file) as log:
+            assert isinstance(log._data, mmap.mmap)
+            assert log.path == log_file
+            assert log.size == len(LOG)
+            data = log._data
+
+        assert data.closed
+
+    def test_empty_file(self, tmp_path):
+        """Verify an empty file gives an empty view."""
+        path = tmp_path / "empty.log"
+        path.write_bytes(b"")
+
+        with LogView.open(path) as log:
+            assert len(log) == 0 and list(log) == [] and log.text() == ""
+
+    def test_lines(self, log_file):
+        """Verify lines split as bytes.splitlines() and decode on access."""
+        with LogView.open(log_file) as log:
+            assert len(log) == len(LOG.splitlines()) == 7
+            assert list(log) == LOG.decode().splitlines()
+            assert log[2] == "caf\xe9 ok"
+            assert log[-1] == "done"
+            assert log[3:5] == ["second ERROR on one line", ""]
+            assert log.raw_line(2) == "caf\xe9 ok".encode()
+
+    def test_decode_errors_are_replaced(self):
+        """Verify undecodable bytes are replaced rather than raising."""
+        log = LogView(b"ok\n\xff bad\n")
+
+        assert log[1] == "� bad"
+        assert LogView(b"\xe9t\xe9", encoding="latin-1")[0] == "\xe9t\xe9"
+
+    def test_byte_range_and_line_number(self, log_file):
+        """Verify byte ranges and the line containing an offset."""
+        offset = LOG.index(b"warning")
+
+        with LogView.open(log_file) as log:
+            assert log.byte_range(offset, offset + 7) == b"warning"
+            assert log.line_number(0) == 1
+            assert log.line_number(offset) == 2
+            assert log.line_number(LOG.index(b"second")) == 4
+            assert log.line_number(len(LOG) - 1) == 7
+
+    def test_grep(self, log_file):
+        """Verify grep decodes only matching lines with their numbers."""
+        with LogView.open(log_file) as log:
+            assert list(log.grep(["FAILED", "warning"])) == [
+                (2, "src/a.cpp:3:5: warning: unused variable [-Wunused]"),
+                (6, "[  FAILED  ] Suite.Broken (5 ms)"),
+            ]
+            # A lone "\r" splits a "\n"-terminated span into two lines
+            assert list(log.grep(["error"], ignore_case=True)) == [
+                (4, "second ERROR on one line")
+            ]
+            assert list(log.grep(["caf\xe9", b"done"])) == [(3, "caf\xe9 ok"), (7, "done")]
+            assert list(log.grep(["absent"])) == []
+
+    def test_records_and_text(self, log_file):
+        """Verify records are scanned in place and text() decodes once."""
+        with LogView.open(log_file) as log:
+            kinds = [record.kind for record in log.records()]
+            assert kinds == ["gcc", "gtest"]
+            assert log.text() == LOG.decode()
+
+    def test_in_memory_buffer(self):
+        """Verify a database blob can be viewed without a file."""
+        log = LogView(bytearray(b"one\ntwo\n"))
+
+        assert log.path is None and list(log) == ["one", "two"]
+        log.close()
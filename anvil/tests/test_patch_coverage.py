@@ -0,0 +1,208 @@
+"""
+Tests for patch coverage.
+
+Covers report path matching, intersecting changed lines with coverage,
+coverage recorded per commit and the `anvil coverage` commands.
+"""
+
+import json
+import subprocess
+from argparse import Namespace
+
+import pytest
+
+from anvil.cli.commands import coverage_patch_command, coverage_record_command
+from anvil.core.patch_coverage import (
+    CoveragePathMatcher,
+    PatchCoverageEngine,
+    PatchCoverageError,
+    file_patch_coverage,
+)
+from anvil.git.diff_scope import WHOLE_FILE
+from anvil.models.line_bitmap import LineBitmap
+from anvil.parsers.coverage_parser import CoverageData, FileCoverage
+from anvil.storage.execution_schema import ExecutionDatabase
+
+
+def _git(repo, *args):
+    """Run git in a test repository."""
+    subprocess.run(["git", *args], cwd=repo, check=True, capture_output=True)
+
+
+def _coverage(*files):
+    """Build coverage data from (path, executable, covered) triples."""
+    file_coverage = [
+        FileCoverage.from_lines(path, LineBitmap(executable), LineBitmap(covered))
+        for path, executable, covered in files
+    ]
+    return CoverageData(
+        0.0,
+        len(file_coverage),
+        sum(fc.total_statements for fc in file_coverage),
+        sum(fc.covered_statements for fc in file_coverage),
+        file_coverage,
+    )
+
+
+@pytest.fixture
+def git_repo(tmp_path):
+    """Create a repository whose second commit changes a C++ and a Python file."""
+    repo = tmp_path / "repo"
+    repo.mkdir()
+    _git(repo, "init")
+    _git(repo, "config", "user.email", "test@example.com")
+    _git(repo, "config", "user.name", "Test User")
+    (repo / "src").mkdir()
+    (repo / "pkg").mkdir()
+    (repo / "src" / "widget.cpp").write_text("".join(f"int a{i};\n" for i in range(1, 11)))
+    (repo / "pkg" / "mod.py").write_text("x = 1\ny = 2\n")
+    (repo / "README.md").write_text("Widgets\n")
+    _git(repo, "add", ".")
+    _git(repo, "commit", "-m", "Initial commit")
+    _git(repo, "tag", "base")
+
+    lines = (repo / "src" / "widget.cpp").read_text().splitlines(keepends=True)
+    lines[2:4] = ["int b3;\n", "int b4;\n"]
+    lines.append("// trailing comment\n")
+    (repo / "src" / "widget.cpp").write_text("".join(lines))
+    (repo / "pkg" / "mod.py").write_text("x = 1\ny = 3\nz = 4\n")
+    (repo / "README.md").write_text("Widgets!\n")
+    _git(repo, "commit", "-am", "Change widget")
+    return repo
+
+
+def _run_coverage(repo):
+    """Coverage of the second commit: llvm-cov style absolute C++ paths and
+    coverage.py style paths relative to the package directory."""
+    root = repo.resolve()
+    return _coverage(
+        (str(root / "src" / "widget.cpp"), range(1, 11), [1, 2, 3, 5, 6]),
+        ("mod.py", [1, 2, 3], [1, 2]),
+    )
+
+
+class TestCoveragePathMatcher:
+    """Tests for mapping repository paths to report paths."""
+
+    def test_absolute_relative_and_suffix_paths(self, tmp_path):
+        """Verify root-relative, ./-prefixed and longest suffix matches."""
+        matcher = CoveragePathMatcher(
+            [f"{tmp_path.as_posix()}/src/a.cpp", "./b.py", "c.py", "lib/c.py", "/other/d.h"],
+            tmp_path,
+        )
+
+        assert matcher.match("src/a.cpp") == f"{tmp_path.as_posix()}/src/a.cpp"
+        assert matcher.match("b.py") == "./b.py"
+        assert matcher.match("pkg/lib/c.py") == "lib/c.py"
+        assert matcher.match("include/d.h") is None
+        assert matcher.match("other/d.h") == "/other/d.h"
+
+
+class TestFilePatchCoverage:
+    """Tests for intersecting changed lines with coverage."""
+
+    def test_only_executable_changed_lines_count(self):
+        """Verify non-executable changed lines are ignored."""
+        result = file_patch_coverage(
+            "a.cpp", [(2, 4), (9, 12)], LineBitmap([1, 2, 3]), LineBitmap([4, 10])
+        )
+
+        assert result.covered_lines == [2, 3] and result.missing_lines == [4, 10]
+        assert result.percentage == 50.0
+
+    def test_whole_file(self):
+        """Verify a whole-file range is clamped to the file's lines."""
+        result = file_patch_coverage("new.cpp", [WHOLE_FILE], LineBitmap([1]), LineBitmap([5]))
+
+        assert result.total_lines == 2
+
+
+class TestPatchCoverageEngine:
+    """Tests against a real repository."""
+
+    def test_working_tree_report(self, git_repo):
+        """Verify a report of the working tree is compared with the base."""
+        (git_repo / "pkg" / "mod.py").write_text("x = 1\ny = 3\nz = 4\nw = 5\n")
+
+        result = PatchCoverageEngine(git_repo).compute(
+            base="base", coverage=_coverage(("pkg/mod.py", [1, 2, 3, 4], [1, 2, 4]))
+        )
+
+        (mod,) = result.files
+        assert mod.covered_lines == [2, 4] and mod.missing_lines == [3]
+        assert result.unmeasured_files == ["README.md", "src/widget.cpp"]
+
+    def test_untracked_file_from_subdirectory(self, git_repo):
+        """Verify an untracked file is found with its repository path from a subdirectory."""
+        (git_repo / "pkg" / "extra.py").write_text("a = 1\nb = 2\n")
+
+        result = PatchCoverageEngine(git_repo / "pkg").compute(
+            base="HEAD", coverage=_coverage(("pkg/extra.py", [1, 2], [1]))
+        )
+
+        (extra,) = result.files
+        assert extra.file_path == "pkg/extra.py"
+        assert extra.covered_lines == [1] and extra.missing_lines == [2]
+
+    def test_recorded_commit(self, git_repo, tmp_path):
+        """Verify coverage recorded for a commit is looked up by commit."""
+        db = ExecutionDatabase(str(tmp_path / "history.db"))
+        engine = PatchCoverageEngine(git_repo, db)
+        engine.record(_run_coverage(git_repo), commit="HEAD")
+
+        # Working tree edits do not affect a commit-based comparison
+        (git_repo / "pkg" / "mod.py").write_text("changed = True\n")
+        result = engine.compute(base="base")
+        db.close()
+
+        assert result.commit == engine.resolve_commit("HEAD")
+        assert [
+            (f.file_path, list(f.covered_lines), list(f.missing_lines)) for f in result.files
+        ] == [
+            ("pkg/mod.py", [2], [3]),
+            ("src/widget.cpp", [3], [4]),
+        ]
+        assert (result.covered_lines, result.total_lines, result.percentage) == (2, 4, 50.0)
+        assert result.unmeasured_files == ["README.md"]
+
+    def test_no_recorded_coverage(self, git_repo, tmp_path):
+        """Verify a commit without coverage is reported."""
+        db = ExecutionDatabase(str(tmp_path / "history.db"))
+
+        with pytest.raises(PatchCoverageError, match="No coverage recorded"):
+            PatchCoverageEngine(git_repo, db).compute(base="base", commit="base")
+        db.close()
+
+
+class TestCoverageCommands:
+    """Tests for `anvil coverage record` and `anvil coverage patch`."""
+
+    def test_record_then_gate(self, git_repo, tmp_path, monkeypatch, capsys):
+        """Verify recorded coverage gates a change with --fail-under."""
+        monkeypatch.chdir(git_repo)
+        report = tmp_path / "coverage.info"
+        report.write_text(
+            f"SF:{git_repo.resolve() / 'src' / 'widget.cpp'}\n"
+            + "".join(f"DA:{line},{int(line != 4)}\n" for line in range(1, 11))
+            + "end_of_record\n"
+        )
+        database = str(tmp_path / "history.db")
+        args = Namespace(database=database)
+
+        assert coverage_record_command(args, report=str(report)) == 0
+        assert coverage_patch_command(args, base="base", fail_under=50.0) == 0
+        assert coverage_patch_command(args, base="base", fail_under=60.0) == 1
+        out = capsys.readouterr().out
+        assert "src/widget.cpp" in out and "50.0%  4" in out
+        assert "FAILED: patch coverage is below 60.0%" in out
+
+        assert coverage_patch_command(args, base="base", format="json") == 0
+        data = json.loads(capsys.readouterr().out)
+        assert data["files"][0]["missing_lines"] == [4]
+
+    def test_unknown_base(self, git_repo, monkeypatch, capsys):
+        """Verify git errors exit with 2."""
+        monkeypatch.chdir(git_repo)
+
+        assert coverage_patch_command(Namespace(), base="nope", report=None) == 2
+        assert "Error" in capsys.readouterr().err
@@ -352,6 +352,16 @@ class TestPytestCommandBuilding:
 
         assert "-vv" in cmd
 
+    def test_build_command_with_rootdir_uses_project_config(self):
+        """Test that a pinned rootdir keeps the project's pytest config."""
+        files = [Path("tests/")]
+        config = {"_rootdir": "/project"}
+
+        cmd = PytestParser.build_command(files, config)
+
+        assert "--rootdir=/project" in cmd
+        assert "-c" not in cmd
+
     def test_build_command_with_multiple_files(self):
         """Test building command with multiple test files."""
         files = [Path("tests/test_a.py"), Path("tests/test_b.py")]
@@ -0,0 +1,328 @@
+"""
+Tests for duration-balanced pytest sharding.
+
+Covers shard specs, balancing from test history, report merging, and the
+sharded runner and validator integration (with pytest runs mocked).
+"""
+
+import json
+import subprocess
+from argparse import Namespace
+from datetime import datetime
+from pathlib import Path
+from unittest.mock import patch
+
+import pytest
+
+from anvil.cli.commands import check_command
+from anvil.executors.fanout import arg_length
+from anvil.executors.pytest_sharding import (
+    ShardedPytestRunner,
+    balance_shards,
+    load_test_durations,
+    merge_json_reports,
+    parse_shard_spec,
+)
+from anvil.parsers.pytest_parser import PytestParser
+from anvil.storage.statistics_database import StatisticsDatabase, TestCaseRecord, ValidationRun
+from anvil.validators.pytest_validator import PytestValidator
+
+
+@pytest.fixture
+def stats_db():
+    """Create an in-memory statistics database."""
+    db = StatisticsDatabase(":memory:")
+    yield db
+    db.close()
+
+
+def _record_durations(db: StatisticsDatabase, durations: dict) -> None:
+    """Record one run with the given test durations."""
+    run_id = db.insert_validation_run(
+        ValidationRun(
+            timestamp=datetime.now(),
+            git_commit="abc",
+            git_branch="main",
+            incremental=False,
+            passed=True,
+            duration_seconds=1.0,
+        )
+    )
+    db.insert_test_case_records_batch(
+        [
+            TestCaseRecord(
+                run_id=run_id,
+                test_name=name,
+                test_suite="",
+                passed=True,
+                skipped=False,
+                duration_seconds=duration,
+                failure_message=None,
+            )
+            for name, duration in durations.items()
+        ]
+    )
+
+
+def _report(outcomes: dict, duration: float = 1.0, coverage: dict = None) -> dict:
+    """Build a pytest-json-report style report."""
+    report = {
+        "duration": duration,
+        "exitcode": 1 if "failed" in outcomes.values() else 0,
+        "summary": {"total": len(outcomes)},
+        "tests": [{"nodeid": n, "outcome": o} for n, o in outcomes.items()],
+    }
+    for outcome in outcomes.values():
+        report["summary"][outcome] = report["summary"].get(outcome, 0) + 1
+    if coverage is not None:
+        report["coverage"] = coverage
+    return report
+
+
+class TestShardSpec:
+    """Tests for i/N shard specification parsing."""
+
+    def test_parse_valid_spec(self):
+        """Verify valid specs are parsed 1-based."""
+        assert parse_shard_spec("1/1") == (1, 1)
+        assert parse_shard_spec("3/4") == (3, 4)
+
+    @pytest.mark.parametrize("spec", ["", "1", "0/4", "5/4", "a/b", "1/0", "1/2/3"])
+    def test_parse_invalid_spec(self, spec):
+        """Verify malformed and out-of-range specs are rejected."""
+        with pytest.raises(ValueError, match="Invalid shard"):
+            parse_shard_spec(spec)
+
+
+class TestBalanceShards:
+    """Tests for duration-balanced partitioning."""
+
+    def test_shards_cover_all_tests_once(self):
+        """Verify every test lands in exactly one shard."""
+        node_ids = [f"t.py::test_{i}" for i in range(50)]
+
+        shards = balance_shards(node_ids, {}, 4)
+
+        assert len(shards) == 4
+        assert sorted(n for shard in shards for n in shard) == sorted(node_ids)
+
+    def test_shards_balance_durations(self):
+        """Verify a slow test is isolated instead of split by count."""
+        node_ids = ["t.py::slow", "t.py::a", "t.py::b", "t.py::c", "t.py::d"]
+        durations = {"t.py::slow": 10.0, "t.py::a": 2.0, "t.py::b": 2.0}
+
+        shards = balance_shards(node_ids, durations, 2)
+
+        # Unknown tests get the median known duration (2.0)
+        assert ["t.py::slow"] in shards
+        assert ["t.py::a", "t.py::b", "t.py::c", "t.py::d"] in shards
+
+    def test_shards_keep_collection_order(self):
+        """Verify tests within a shard stay in collection order."""
+        node_ids = [f"t.py::test_{i}" for i in range(10)]
+        durations = {n: float(i) for i, n in enumerate(node_ids)}
+
+        for shard in balance_shards(node_ids, durations, 3):
+            assert shard == sorted(shard, key=node_ids.index)
+
+    def test_partition_is_deterministic(self):
+        """Verify the same inputs always give the same partition."""
+        node_ids = [f"t.py::test_{i}" for i in range(20)]
+
+        assert balance_shards(node_ids, {}, 3) == balance_shards(list(node_ids), {}, 3)
+
+
+class TestLoadDurations:
+    """Tests for duration estimates from the statistics database."""
+
+    def test_median_of_recent_runs(self, stats_db):
+        """Verify durations are the median of recent runs."""
+        for duration in [1.0, 3.0, 2.0]:
+            _record_durations(stats_db, {"tests/t.py::test_a": duration})
+
+        durations = load_test_durations(stats_db, ["tests/t.py::test_a", "tests/t.py::test_b"])
+
+        assert durations == {"tests/t.py::test_a": 2.0}
+
+    def test_falls_back_to_bare_test_name(self, stats_db):
+        """Verify tests recorded by bare name are found from node IDs."""
+        _record_durations(stats_db, {"test_c": 4.0})
+
+        assert load_test_durations(stats_db, ["tests/t.py::test_c"]) == {
+            "tests/t.py::test_c": 4.0
+        }
+
+
+class TestMergeReports:
+    """Tests for merging shard JSON reports."""
+
+    def test_merge_tests_and_summary(self):
+        """Verify tests are concatenated and counters summed."""
+        merged = merge_json_reports(
+            [
+                _report({"a::x": "passed", "a::y": "failed"}, duration=2.0),
+                _report({"b::z": "passed"}, duration=3.0),
+            ]
+        )
+
+        assert [t["nodeid"] for t in merged["tests"]] == ["a::x", "a::y", "b::z"]
+        assert merged["summary"] == {"total": 3, "passed": 2, "failed": 1}
+        assert merged["duration"] == 3.0
+        assert merged["exitcode"] == 1
+
+    def test_merge_coverage_unions_executed_lines(self):
+        """Verify coverage of a file exercised by two shards is combined."""
+        first = {"files": {"m.py": {"executed_lines": [1, 2], "missing_lines": [3, 4]}}}
+        second = {"files": {"m.py": {"executed_lines": [1, 3], "missing_lines": [2, 4]}}}
+
+        merged = merge_json_reports(
+            [_report({"a::x": "passed"}, coverage=first), _report({}, coverage=second)]
+        )
+
+        file_data = merged["coverage"]["files"]["m.py"]
+        assert file_data["executed_lines"] == [1, 2, 3]
+        assert file_data["missing_lines"] == [4]
+        assert merged["coverage"]["totals"]["percent_covered"] == pytest.approx(75.0)
+
+
+class TestShardedPytestRunner:
+    """Tests for the sharded runner."""
+
+    NODE_IDS = [f"tests/test_m.py::test_{i}" for i in range(12)]
+
+    def test_machine_shards_are_disjoint(self):
+        """Verify machine shards partition the suite."""
+        selected = []
+        for index in range(1, 4):
+            runner = ShardedPytestRunner(workers=2, shard=f"{index}/3")
+            selected.extend(n for shard in runner.plan(self.NODE_IDS) for n in shard)
+
+        assert sorted(selected) == sorted(self.NODE_IDS)
+
+    def test_plan_never_creates_empty_shards(self):
+        """Verify fewer tests than workers yields one shard per test."""
+        runner = ShardedPytestRunner(workers=8)
+
+        assert runner.plan(self.NODE_IDS[:3]) == [[n] for n in self.NODE_IDS[:3]]
+        assert runner.plan([]) == []
+
+    def test_run_merges_shard_reports(self):
+        """Verify each shard runs separately and results are merged."""
+        calls = []
+
+        def fake_run(files, config):
+            calls.append((files, config))
+            outcomes = {str(f): "failed" if str(f).endswith("_3") else "passed" for f in files}
+            return subprocess.CompletedProcess([], 0, stdout=json.dumps(_report(outcomes)))
+
+        runner = ShardedPytestRunner(workers=3)
+        with patch.object(runner, "collect", return_value=self.NODE_IDS), patch(
+            "anvil.executors.pytest_sharding.PytestParser.run_pytest", side_effect=fake_run
+        ):
+            result = runner.run([Path("tests")], {"parallel": True, "workers": 4})
+
+        assert len(calls) == 3
+        assert all("parallel" not in config for _, config in calls)
+        assert all(config["_rootdir"] == str(Path.cwd()) for _, config in calls)
+        assert not result.passed
+        assert len(result.errors) == 1
+        assert "test_3" in result.errors[0].message
+        assert [s["tests"] for s in result.metadata["shards"]] == [4, 4, 4]
+
+    def test_run_reports_shard_without_report(self):
+        """Verify a shard that crashed before reporting fails the result."""
+        runner = ShardedPytestRunner(workers=2)
+        crashed = subprocess.CompletedProcess([], 4, stdout="", stderr="boom")
+        with patch.object(runner, "collect", return_value=self.NODE_IDS), patch(
+            "anvil.executors.pytest_sharding.PytestParser.run_pytest", return_value=crashed
+        ):
+            result = runner.run([Path("tests")], {})
+
+        assert not result.passed
+        assert "exit code 4" in result.errors[0].message
+
+    def test_run_splits_shard_longer_than_argument_budget(self):
+        """Verify a shard whose node IDs exceed ARG_MAX runs in several invocations."""
+        node_ids = [f"tests/test_{'x' * 200}.py::test_{i}" for i in range(100)]
+        budget = sum(arg_length(n) for n in node_ids) // 4
+        calls = []
+
+        def fake_run(files, config):
+            calls.append([str(f) for f in files])
+            report = _report({str(f): "passed" for f in files})
+            return subprocess.CompletedProcess([], 0, stdout=json.dumps(report))
+
+        runner = ShardedPytestRunner(workers=1)
+        base_length = sum(arg_length(a) for a in PytestParser.build_command([], {}))
+        with patch.object(runner, "collect", return_value=node_ids), patch(
+            "anvil.executors.pytest_sharding.PytestParser.run_pytest", side_effect=fake_run
+        ), patch("anvil.executors.fanout.arg_max", return_value=base_length + budget):
+            result = runner.run([Path("tests")], {})
+
+        assert len(calls) > 1
+        assert [n for call in calls for n in call] == node_ids
+        assert all(sum(arg_length(n) for n in call) <= budget for call in calls)
+        assert result.passed
+        assert result.metadata["shards"] == [{"tests": 100, "duration": float(len(calls))}]
+
+    def test_run_reports_shard_timeout(self):
+        """Verify a shard that times out fails the result instead of raising."""
+        runner = ShardedPytestRunner(workers=2)
+        timeout = subprocess.TimeoutExpired(["pytest"], 300)
+        with patch.object(runner, "collect", return_value=self.NODE_IDS), patch(
+            "anvil.executors.pytest_sharding.PytestParser.run_pytest", side_effect=timeout
+        ):
+            result = runner.run([Path("tests")], {})
+
+        assert not result.passed
+        assert "timed out after 300 seconds" in result.errors[0].message
+
+    def test_collect_real_tests(self, tmp_path):
+        """Verify collection returns node IDs from a real pytest run."""
+        test_file = tmp_path / "test_sample.py"
+        test_file.write_text("def test_one():\n    pass\n\ndef test_two():\n    pass\n")
+
+        node_ids = ShardedPytestRunner().collect([test_file], {"keywords": "two"})
+
+        assert len(node_ids) == 1
+        assert node_ids[0].endswith("test_sample.py::test_two")
+
+    def test_collect_uses_project_config(self, tmp_path, monkeypatch):
+        """Verify collection honors the project's pytest.ini like the shard runs."""
+        (tmp_path / "pytest.ini").write_text(
+            "[pytest]\npython_files = check_*.py\nmarkers = slow\naddopts = -m 'not slow'\n"
+        )
+        (tmp_path / "check_sample.py").write_text(
+            "import pytest\n\n"
+            "def test_fast():\n    pass\n\n"
+            "@pytest.mark.slow\ndef test_slow():\n    pass\n"
+        )
+        (tmp_path / "test_ignored.py").write_text("def test_other():\n    pass\n")
+        monkeypatch.chdir(tmp_path)
+
+        node_ids = ShardedPytestRunner().collect([Path(".")], {})
+
+        assert node_ids == ["check_sample.py::test_fast"]
+
+
+class TestShardedValidation:
+    """Tests for sharding through the pytest validator and CLI."""
+
+    def test_validator_uses_sharded_runner(self, tmp_path):
+        """Verify shards config routes the validator through the sharded runner."""
+        with patch("anvil.executors.pytest_sharding.ShardedPytestRunner.run") as run, patch(
+            "anvil.validators.pytest_validator.PytestParser.run_and_parse"
+        ) as plain:
+            PytestValidator().validate(
+                ["tests"], {"shards": 2, "statistics_database": str(tmp_path / "none.db")}
+            )
+
+        run.assert_called_once()
+        plain.assert_not_called()
+
+    def test_check_rejects_invalid_shard(self, capsys):
+        """Verify anvil check --shard validates the spec."""
+        args = Namespace(config=None, shard="5/4")
+
+        assert check_command(args, files=["missing.py"]) == 2
+        assert "Invalid shard" in capsys.readouterr().err
@@ -0,0 +1,217 @@
+"""
+Tests for the in-process single-pass radon analyzer.
+
+Verifies parity with the radon command line, content-hash caching,
+parallel analysis, and integration with RadonParser.run_and_parse.
+"""
+
+import json
+import shutil
+import subprocess
+from pathlib import Path
+
+import pytest
+
+pytest.importorskip("radon")
+
+from anvil.parsers import radon_analyzer  # noqa: E402
+from anvil.parsers.radon_analyzer import RadonAnalyzer, analyze_source  # noqa: E402
+from anvil.parsers.radon_parser import RadonParser  # noqa: E402
+
+FIXTURES = [
+    Path("tests/fixtures/python/good_code.py"),
+    Path("tests/fixtures/python/unicode_content.py"),
+]
+
+COMPLEX_SOURCE = '''
+def outer(x):
+    def inner(y):
+        if y > 1 and y < 10:
+            return 1
+        return 0
+    for i in range(x):
+        if i % 2:
+            x += inner(i)
+        elif i % 3:
+            x -= 1
+        else:
+            while x > 100:
+                x //= 2
+    return x
+'''
+
+
+def _radon_cli(*args: str) -> dict:
+    """Run the radon command line and parse its JSON output."""
+    if shutil.which("radon") is None:
+        pytest.skip("radon executable not installed")
+    result = subprocess.run(
+        ["radon", *args, "--json", *map(str, FIXTURES)],
+        capture_output=True,
+        text=True,
+        check=True,
+    )
+    return json.loads(result.stdout)
+
+
+@pytest.fixture
+def analyzer(tmp_path):
+    """Create an analyzer with a temporary cache."""
+    return RadonAnalyzer({"cache_dir": str(tmp_path / "cache")})
+
+
+class TestCommandLineParity:
+    """Verify single-pass results match the three radon subcommands."""
+
+    def test_cc_matches_radon_cc(self, tmp_path):
+        """Verify cc blocks match radon cc --show-closures."""
+        analyzer = RadonAnalyzer({"show_closures": True, "cache": False})
+
+        actual = json.loads(analyzer.to_cc_json(analyzer.analyze_files(FIXTURES)))
+
+        assert actual == _radon_cli("cc", "--show-closures")
+
+    def test_mi_matches_radon_mi(self, analyzer):
+        """Verify maintainability index matches radon mi."""
+        actual = json.loads(analyzer.to_mi_json(analyzer.analyze_files(FIXTURES)))
+        expected = _radon_cli("mi")
+
+        assert actual.keys() == expected.keys()
+        for path in expected:
+            assert actual[path]["rank"] == expected[path]["rank"]
+            assert actual[path]["mi"] == pytest.approx(expected[path]["mi"])
+
+    def test_raw_matches_radon_raw(self, analyzer):
+        """Verify raw metrics match radon raw."""
+        actual = json.loads(analyzer.to_raw_json(analyzer.analyze_files(FIXTURES)))
+
+        assert actual == _radon_cli("raw")
+
+
+class TestAnalyzeSource:
+    """Tests for single-file analysis."""
+
+    def test_reports_all_metrics(self):
+        """Verify one call yields cc, mi and raw metrics."""
+        result = analyze_source(COMPLEX_SOURCE)
+
+        assert result["cc"][0]["name"] == "outer"
+        assert result["cc"][0]["complexity"] == 5
+        assert result["mi"]["rank"] == "A"
+        assert result["raw"]["loc"] == 15
+
+    def test_show_closures(self):
+        """Verify closures are reported as separate blocks when requested."""
+        names = [b["name"] for b in analyze_source(COMPLEX_SOURCE, show_closures=True)["cc"]]
+
+        assert "outer.inner" in names
+
+    def test_syntax_error(self):
+        """Verify unparsable source yields an error instead of raising."""
+        assert "error" in analyze_source("def broken(:\n")
+
+
+class TestCaching:
+    """Tests for content-hash caching."""
+
+    def test_unchanged_file_is_not_reanalyzed(self, analyzer, tmp_path, monkeypatch):
+        """Verify a second run is served from the cache."""
+        source = tmp_path / "module.py"
+        source.write_text(COMPLEX_SOURCE)
+        first = analyzer.analyze_files([source])
+
+        def fail(*args, **kwargs):
+            raise AssertionError("file re-analyzed")
+
+        monkeypatch.setattr(radon_analyzer, "_analyze_file", fail)
+
+        assert analyzer.analyze_files([source]) == first
+
+    def test_changed_file_is_reanalyzed(self, analyzer, tmp_path):
+        """Verify editing a file invalidates its cached result."""
+        source = tmp_path / "module.py"
+        source.write_text("def f():\n    return 1\n")
+        analyzer.analyze_files([source])
+
+        source.write_text(COMPLEX_SOURCE)
+        result = analyzer.analyze_files([source])[str(source)]
+
+        assert result["cc"][0]["name"] == "outer"
+
+    def test_errors_are_not_cached(self, analyzer, tmp_path):
+        """Verify failed analyses are retried on the next run."""
+        source = tmp_path / "broken.py"
+        source.write_text("def broken(:\n")
+        analyzer.analyze_files([source])
+
+        assert not list((tmp_path / "cache").glob("*.json"))
+
+    def test_cache_disabled(self, tmp_path):
+        """Verify cache=False never writes cache files."""
+        source = tmp_path / "module.py"
+        source.write_text(COMPLEX_SOURCE)
+
+        RadonAnalyzer({"cache": False, "cache_dir": str(tmp_path / "cache")}).analyze_files(
+            [source]
+        )
+
+        assert not (tmp_path / "cache").exists()
+
+
+class TestParallelAnalysis:
+    """Tests for analyzing many files in worker processes."""
+
+    def test_parallel_matches_serial(self, tmp_path):
+        """Verify pooled analysis gives the same results in input order."""
+        files = []
+        for i in range(radon_analyzer.MIN_FILES_FOR_POOL + 4):
+            path = tmp_path / f"module_{i}.py"
+            path.write_text(COMPLEX_SOURCE + f"\nVALUE = {i}\n")
+            files.append(path)
+
+        parallel = RadonAnalyzer({"cache": False, "jobs": 2}).analyze_files(files)
+        serial = RadonAnalyzer({"cache": False, "jobs": 1}).analyze_files(files)
+
+        assert parallel == serial
+        assert list(parallel) == [str(f) for f in files]
+
+
+class TestRunAndParseInProcess:
+    """Tests for RadonParser integration."""
+
+    def test_cc_issues_match_subprocess_path(self, tmp_path):
+        """Verify in-process and subprocess runs report the same cc issues."""
+        source = tmp_path / "module.py"
+        source.write_text(COMPLEX_SOURCE)
+        config = {"max_complexity": 3, "cache": False}
+
+        in_process = RadonParser.run_and_parse([source], config)
+        if shutil.which("radon") is None:
+            pytest.skip("radon executable not installed")
+        cli = RadonParser.run_and_parse([source], {**config, "in_process": False})
+
+        assert [w.message for w in in_process.warnings] == [w.message for w in cli.warnings]
+        assert in_process.metadata["raw"][str(source)]["loc"] == 15
+
+    def test_metric_all_combines_cc_and_mi(self, tmp_path):
+        """Verify metric 'all' reports cc and mi issues in one result."""
+        source = tmp_path / "module.py"
+        source.write_text(COMPLEX_SOURCE)
+
+        result = RadonParser.run_and_parse(
+            [source],
+            {"metric": "all", "max_complexity": 3, "min_maintainability": 101, "cache": False},
+        )
+
+        assert result.validator_name == "radon"
+        assert {w.error_code for w in result.warnings} == {"CC", "MI"}
+        assert not result.passed
+
+    def test_unparsable_file_is_reported(self, tmp_path):
+        """Verify files radon cannot parse become warnings."""
+        source = tmp_path / "broken.py"
+        source.write_text("def broken(:\n")
+
+        result = RadonParser.run_and_parse([source], {"cache": False})
+
+        assert [w.rule_name for w in result.warnings] == ["radon-parse-error"]
@@ -4,10 +4,12 @@ Tests for RuleEngine and StatisticsCalculator.
 Following TDD principles: Tests written before full implementation.
 """
 
+import fnmatch
 from datetime import datetime, timedelta
 
 import pytest
 
+from anvil.core.pattern_matcher import PatternMatcher
 from anvil.core.rule_engine import RuleEngine
 from anvil.core.statistics_calculator import StatisticsCalculator
 from anvil.storage.execution_schema import (
@@ -318,6 +320,39 @@ class TestRuleEngine:
         # Should select test with 30% failure rate (threshold is 10%)
         assert "tests/test_flaky.py::test_unreliable" in entities
 
+    def test_group_selection_is_cached(self, engine, sample_rules, sample_history, monkeypatch):
+        """Test that unchanged history reuses the cached selection."""
+        rule = engine.db.get_execution_rule("quick-check")
+        first = engine.select_entities(rule)
+
+        def fail(*args, **kwargs):
+            raise AssertionError("entity IDs reloaded")
+
+        monkeypatch.setattr(engine.db, "get_entity_ids", fail)
+        second = engine.select_entities(rule)
+
+        assert sorted(first) == sorted(second)
+
+    def test_group_selection_sees_new_entities(self, engine, db, sample_rules, sample_history):
+        """Test that inserting history invalidates the cached selection."""
+        rule = engine.db.get_execution_rule("quick-check")
+        before = engine.select_entities(rule)
+
+        db.insert_execution_history(
+            ExecutionHistory(
+                execution_id="local-4",
+                entity_id="tests/test_executor.py::test_run",
+                entity_type="test",
+                timestamp=datetime.now(),
+                status="PASSED",
+                duration=0.1,
+            )
+        )
+        after = engine.select_entities(rule)
+
+        assert "tests/test_executor.py::test_run" not in before
+        assert "tests/test_executor.py::test_run" in after
+
     def test_get_rule(self, engine, sample_rules):
         """Test retrieval of execution rule."""
         rule = engine.get_rule("quick-check")
@@ -399,3 +434,60 @@ class TestRuleEngineIntegration:
         # 4. Select entities using rule
         entities = engine.select_entities(rule)
         assert "tests/test_example.py::test_func" in entities
+
+
+class TestPatternMatcher:
+    """Test suite for compiled group pattern matching."""
+
+    ENTITIES = [
+        "tests/test_models.py::test_create_model",
+        "tests/test_models.py",
+        "tests/unit/test_parser.py::TestParser::test_parse[case-1]",
+        "tests/integration/test_api.py::test_get",
+        "src/models.py",
+        "tests/test_other.py::test_something",
+        "",
+    ]
+
+    @pytest.mark.parametrize(
+        "patterns",
+        [
+            ["tests/test_models.py"],
+            ["tests/unit/*"],
+            ["tests/*/test_*.py"],
+            ["*::test_get"],
+            ["tests/test_?odels.py"],
+            ["tests/[iu]*"],
+            ["*.py"],
+            ["src/models.py", "tests/integration", "tests/unit/test_parser.py::TestParser"],
+            [],
+        ],
+    )
+    def test_matches_fnmatch_semantics(self, patterns):
+        """Test that compiled matching agrees with per-pattern fnmatch."""
+        matcher = PatternMatcher(patterns)
+
+        for entity_id in self.ENTITIES:
+            expected = any(
+                fnmatch.fnmatch(entity_id, p) or fnmatch.fnmatch(entity_id, f"{p}*")
+                for p in patterns
+            )
+            assert matcher.matches(entity_id) == expected, (entity_id, patterns)
+
+    def test_filter_preserves_order(self):
+        """Test that filter returns matches in input order."""
+        matcher = PatternMatcher(["tests/test_*", "src/"])
+
+        assert matcher.filter(self.ENTITIES) == [
+            "tests/test_models.py::test_create_model",
+            "tests/test_models.py",
+            "src/models.py",
+            "tests/test_other.py::test_something",
+        ]
+
+    def test_regex_metacharacters_are_literal(self):
+        """Test that regex metacharacters in patterns are matched literally."""
+        matcher = PatternMatcher(["tests/test_a.py::test[1+2]*", "a.b(c)"])
+
+        assert matcher.matches("a.b(c)::test")
+        assert not matcher.matches("axb(c)")
@@ -0,0 +1,304 @@
+"""
+Tests for single-pass in-process analysis of Python validators.
+
+Covers shared reading and parsing, flake8 code selection, tool support
+detection, parity with the subprocess parsers, parallel checking and
+orchestrator integration.
+"""
+
+import ast
+import importlib.util
+import shutil
+from pathlib import Path
+from unittest.mock import patch
+
+import pytest
+
+from anvil.core.orchestrator import ValidationOrchestrator
+from anvil.core.validator_registry import ValidatorRegistry
+from anvil.executors import single_pass
+from anvil.executors.single_pass import (
+    SinglePassRunner,
+    SourceFile,
+    _flake8_selected,
+    _noqa,
+    read_source,
+)
+from anvil.models.validator import ValidationResult, Validator
+from anvil.parsers.radon_parser import RadonParser
+
+COMPLEX_SOURCE = """import os
+
+
+def outer(x):
+    for i in range(x):
+        if i % 2:
+            x += 1
+        elif i % 3:
+            x -= 1
+    return x
+"""
+
+
+def _keys(result: ValidationResult):
+    """Comparable issue keys of a result."""
+    return sorted(
+        (Path(i.file_path).as_posix(), i.line_number, i.column_number, i.error_code, i.message)
+        for i in result.errors + result.warnings
+    )
+
+
+@pytest.fixture
+def module(tmp_path):
+    """Create a Python file with style, import and complexity issues."""
+    path = tmp_path / "module.py"
+    path.write_text(COMPLEX_SOURCE)
+    return path
+
+
+class StubValidator(Validator):
+    """Validator that records whether it ran."""
+
+    def __init__(self, name: str, language: str):
+        self._name = name
+        self._language = language
+        self.calls = 0
+
+    @property
+    def name(self) -> str:
+        return self._name
+
+    @property
+    def language(self) -> str:
+        return self._language
+
+    @property
+    def description(self) -> str:
+        return "stub"
+
+    def validate(self, files, config) -> ValidationResult:
+        self.calls += 1
+        return ValidationResult(validator_name=self._name, passed=True, files_checked=len(files))
+
+    def is_available(self) -> bool:
+        return True
+
+
+class TestSharedSource:
+    """Tests for reading and parsing each file once."""
+
+    def test_tree_is_parsed_once(self):
+        """Verify every tool asking for the AST gets the same parse."""
+        src = SourceFile("m.py", COMPLEX_SOURCE)
+
+        with patch("anvil.executors.single_pass.ast.parse", wraps=ast.parse) as parse:
+            assert src.tree is src.tree
+
+        assert parse.call_count == 1
+
+    def test_syntax_error_is_kept(self):
+        """Verify an unparsable file yields no tree and keeps the error."""
+        src = SourceFile("m.py", "def broken(:\n")
+
+        assert src.tree is None
+        assert isinstance(src.syntax_error, SyntaxError)
+
+    def test_read_source_decodes_and_normalizes(self, tmp_path):
+        """Verify encoding declarations are honored and newlines normalized."""
+        path = tmp_path / "latin.py"
+        path.write_bytes(b"# -*- coding: latin-1 -*-\r\nNAME = '\xe9'\r\n")
+
+        assert read_source(path) == "# -*- coding: latin-1 -*-\nNAME = 'é'\n"
+
+    def test_check_chunk_shares_one_parse(self, module):
+        """Verify all AST-based tools in a chunk reuse one parse per file."""
+        with patch("anvil.executors.single_pass.ast.parse", wraps=ast.parse) as parse:
+            single_pass._check_chunk([(str(module), COMPLEX_SOURCE)], ("radon", "radon"), {})
+
+        assert parse.call_count == 1
+
+
+class TestFlake8Selection:
+    """Tests for flake8's select/ignore and noqa rules."""
+
+    def test_longest_prefix_wins(self):
+        """Verify a more specific select overrides a broader ignore."""
+        assert _flake8_selected("E501", ["E", "W"], ["E5"]) is False
+        assert _flake8_selected("E501", ["E501"], ["E5"]) is True
+        assert _flake8_selected("F401", ["E"], []) is False
+
+    def test_noqa(self):
+        """Verify bare and code-specific noqa comments."""
+        assert _noqa("import os  # noqa\n", "F401")
+        assert _noqa("import os  # noqa: F401,E501\n", "F401")
+        assert not _noqa("import os  # noqa: E501\n", "F401")
+        assert not _noqa("import os\n", "F401")
+
+
+class TestSupportedTools:
+    """Tests for in-process support detection."""
+
+    def test_unimportable_tools_are_excluded(self):
+        """Verify tools whose library is missing are left to their validators."""
+        real_find_spec = importlib.util.find_spec
+
+        def find_spec(name, *args):
+            return None if name == "black" else real_find_spec(name, *args)
+
+        with patch("anvil.executors.single_pass.importlib.util.find_spec", find_spec):
+            assert "black" not in SinglePassRunner.supported_tools({})
+
+    def test_fix_mode_and_opt_outs_are_excluded(self):
+        """Verify rewriting tools and radon opt-out are not run in-process."""
+        supported = SinglePassRunner.supported_tools({"fix": True, "in_process": False})
+
+        assert not {"black", "isort", "autoflake", "radon"} & set(supported)
+
+
+class TestRadonInSinglePass:
+    """Tests for radon from the shared AST (radon is always importable here)."""
+
+    @pytest.fixture(autouse=True)
+    def _require_radon(self):
+        pytest.importorskip("radon")
+
+    def test_matches_radon_in_process(self, module):
+        """Verify radon results match the standalone in-process radon path."""
+        config = {"max_complexity": 2, "cache": False}
+
+        (result,) = SinglePassRunner().run(["radon"], [module], config)
+        expected = RadonParser.run_and_parse_in_process([module], config)
+
+        assert _keys(result) == _keys(expected)
+        assert not result.passed
+        assert result.metadata["single_pass"] is True
+
+    def test_parallel_matches_serial(self, tmp_path):
+        """Verify pooled checking gives the same results in file order."""
+        files = []
+        for i in range(single_pass.MIN_FILES_FOR_POOL + 4):
+            path = tmp_path / f"module_{i}.py"
+            path.write_text(COMPLEX_SOURCE + f"\nVALUE = {i}\n")
+            files.append(path)
+        config = {"max_complexity": 2}
+
+        (parallel,) = SinglePassRunner(jobs=2).run(["radon"], files, config)
+        (serial,) = SinglePassRunner(jobs=1).run(["radon"], files, config)
+
+        assert _keys(parallel) == _keys(serial)
+        assert list(parallel.metadata["raw"]) == [str(f) for f in files]
+
+    def test_unreadable_file_is_reported(self, tmp_path):
+        """Verify files that cannot be read are errors instead of crashes."""
+        (result,) = SinglePassRunner().run(["radon"], [tmp_path / "missing.py"], {})
+
+        assert not result.passed
+        assert "Could not read file" in result.errors[0].message
+
+    def test_non_python_files_are_ignored(self, tmp_path):
+        """Verify files without a Python suffix are skipped."""
+        (tmp_path / "main.cpp").write_text("int main() { return 0; }\n")
+
+        (result,) = SinglePassRunner().run(["radon"], [tmp_path / "main.cpp"], {})
+
+        assert result.passed
+        assert result.files_checked == 0
+
+
+class TestSubprocessParity:
+    """Verify in-process results match the tools' command lines."""
+
+    def test_flake8_matches_subprocess(self, module):
+        """Verify flake8 findings, including C901, match flake8 itself."""
+        pytest.importorskip("flake8")
+        from anvil.parsers.flake8_parser import Flake8Parser
+
+        config = {"max_complexity": 2, "max_line_length": 100}
+
+        (result,) = SinglePassRunner().run(["flake8"], [module], config)
+
+        assert {i.error_code for i in result.errors + result.warnings} == {"F401", "C901"}
+        assert _keys(result) == _keys(Flake8Parser.run_and_parse([module], config))
+
+    def test_flake8_syntax_error(self, tmp_path):
+        """Verify unparsable files are reported as E999."""
+        pytest.importorskip("flake8")
+        path = tmp_path / "broken.py"
+        path.write_text("def broken(:\n")
+
+        (result,) = SinglePassRunner().run(["flake8"], [path], {})
+
+        assert [i.error_code for i in result.errors] == ["E999"]
+
+    def test_black_matches_subprocess(self, module, tmp_path):
+        """Verify black flags the same files as black --check."""
+        pytest.importorskip("black")
+        from anvil.parsers.black_parser import BlackParser
+
+        formatted = tmp_path / "formatted.py"
+        formatted.write_text("x = 1\n")
+        module.write_text("x = {  'a':1 }\n")
+
+        (result,) = SinglePassRunner().run(["black"], [module, formatted], {})
+
+        assert [i.file_path for i in result.errors] == [str(module)]
+        assert "+x = {\"a\": 1}" in result.errors[0].diff
+        expected = BlackParser.run_and_parse([module, formatted], {})
+        assert [Path(i.file_path) for i in expected.errors] == [module]
+
+    def test_isort_matches_subprocess(self, tmp_path):
+        """Verify isort flags the same files as isort --check-only."""
+        pytest.importorskip("isort")
+        if shutil.which("isort") is None and importlib.util.find_spec("isort") is None:
+            pytest.skip("isort not installed")
+        from anvil.parsers.isort_parser import IsortParser
+
+        unsorted = tmp_path / "unsorted.py"
+        unsorted.write_text("import sys\nimport os\n")
+        ordered = tmp_path / "ordered.py"
+        ordered.write_text("import os\nimport sys\n")
+
+        (result,) = SinglePassRunner().run(["isort"], [unsorted, ordered], {})
+
+        assert [i.file_path for i in result.errors] == [str(unsorted)]
+        expected = IsortParser.run_and_parse([unsorted, ordered], {})
+        assert [Path(i.file_path).name for i in expected.errors] == ["unsorted.py"]
+
+
+class TestOrchestratorIntegration:
+    """Tests for routing validators through the single pass."""
+
+    def test_single_pass_replaces_supported_validators(self, module):
+        """Verify supported validators run in the shared pass and others run as usual."""
+        radon = StubValidator("radon", "python")
+        pylint = StubValidator("pylint", "python")
+        gtest = StubValidator("gtest", "cpp")
+        registry = ValidatorRegistry()
+        for validator in (radon, pylint, gtest):
+            registry.register(validator)
+        shared = [ValidationResult(validator_name="radon", passed=True)]
+
+        with patch.object(SinglePassRunner, "supported_tools", return_value=["radon"]), patch(
+            "anvil.executors.single_pass.SinglePassRunner.run", return_value=shared
+        ) as run:
+            results = ValidationOrchestrator(registry).run_all(
+                [module], parallel=True, config={"single_pass": True}
+            )
+
+        run.assert_called_once()
+        assert run.call_args[0][0] == ["radon"]
+        assert radon.calls == 0
+        assert (pylint.calls, gtest.calls) == (1, 1)
+        assert sorted(r.validator_name for r in results) == ["gtest", "pylint", "radon"]
+
+    def test_single_pass_is_opt_in(self, module):
+        """Verify validators run individually without single_pass."""
+        radon = StubValidator("radon", "python")
+        registry = ValidatorRegistry()
+        registry.register(radon)
+
+        with patch("anvil.executors.single_pass.SinglePassRunner.run") as run:
+            ValidationOrchestrator(registry).run_for_language("python", [module], config={})
+
+        run.assert_not_called()
+        assert radon.calls == 1
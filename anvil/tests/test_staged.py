@@ -0,0 +1,341 @@
+"""
+Tests for validating staged content straight from the git object store.
+
+Covers diff and cat-file parsing, the scratch tree, remapping results to
+changed lines, tool line filters and the `anvil check --staged` command.
+"""
+
+import json
+import subprocess
+from argparse import Namespace
+from pathlib import Path
+from unittest.mock import patch
+
+import pytest
+
+from anvil.cli.commands import check_command
+from anvil.core.file_collector import FileCollector
+from anvil.git.staged import StagedSnapshot, parse_cat_file_batch, parse_staged_diff
+from anvil.models.validator import Issue, ValidationResult
+from anvil.parsers.clang_format_parser import ClangFormatParser
+from anvil.parsers.clang_tidy_parser import ClangTidyParser
+
+STAGED_DIFF = """diff --git a/src/app.py b/src/app.py
+index 1111111111111111111111111111111111111111..2222222222222222222222222222222222222222 100644
+--- a/src/app.py
++++ b/src/app.py
+@@ -3,0 +4,2 @@ def main():
++    a = 1
++    b = 2
+@@ -10 +12 @@ def other():
+-    return 0
++    return 1
+@@ -20,3 +23,0 @@ def gone():
+diff --git a/new file.py b/new file.py
+new file mode 100644
+index 0000000000000000000000000000000000000000..3333333333333333333333333333333333333333
+--- /dev/null
++++ b/new file.py\t
+@@ -0,0 +1,3 @@
++x = 1
++y = 2
++z = 3
+diff --git a/only_removed.py b/only_removed.py
+index 4444444444444444444444444444444444444444..5555555555555555555555555555555555555555 100644
+--- a/only_removed.py
++++ b/only_removed.py
+@@ -5,2 +4,0 @@
+"""
+
+
+def _git(repo, *args):
+    """Run git in a test repository."""
+    subprocess.run(["git", *args], cwd=repo, check=True, capture_output=True)
+
+
+@pytest.fixture
+def git_repo(tmp_path):
+    """Create a repository with a committed file and a staged change."""
+    _git(tmp_path, "init")
+    _git(tmp_path, "config", "user.email", "test@example.com")
+    _git(tmp_path, "config", "user.name", "Test User")
+    (tmp_path / "setup.cfg").write_text("[flake8]\nmax-line-length = 100\n")
+    (tmp_path / "app.py").write_text("import os\n\n\ndef main():\n    return 1\n")
+    (tmp_path / "main.cpp").write_text("int main() { return 0; }\n")
+    _git(tmp_path, "add", ".")
+    _git(tmp_path, "commit", "-m", "Initial commit")
+
+    # Stage one version, then keep editing the working tree
+    (tmp_path / "app.py").write_text("import os\nimport sys\n\n\ndef main():\n    return 1\n")
+    _git(tmp_path, "add", "app.py")
+    (tmp_path / "app.py").write_text("unstaged = True\n")
+    return tmp_path
+
+
+class TestParsing:
+    """Tests for parsing git output."""
+
+    def test_parse_staged_diff(self):
+        """Verify blob ids and added line ranges per file."""
+        files = parse_staged_diff(STAGED_DIFF)
+
+        assert [(f.path, f.blob[:4], f.line_ranges) for f in files] == [
+            ("src/app.py", "2222", [(4, 5), (12, 12)]),
+            ("new file.py", "3333", [(1, 3)]),
+        ]
+
+    def test_parse_quoted_path(self):
+        """Verify paths git quotes for special characters are decoded."""
+        diff = (
+            'diff --git "a/caf\\303\\251.py" "b/caf\\303\\251.py"\n'
+            "index 1..2 100644\n"
+            '+++ "b/caf\\303\\251.py"\n'
+            "@@ -1 +1 @@\n"
+        )
+
+        assert parse_staged_diff(diff)[0].path == "café.py"
+
+    def test_parse_cat_file_batch(self):
+        """Verify batch output with multi-line and missing objects."""
+        output = b"aaa blob 4\nx\ny\n\nbbb missing\nccc blob 0\n\n"
+
+        assert parse_cat_file_batch(output) == {"aaa": b"x\ny\n", "ccc": b""}
+
+
+class TestStagedSnapshot:
+    """Tests against a real repository."""
+
+    def test_materializes_staged_content(self, git_repo):
+        """Verify the scratch tree holds the index version, not the working tree."""
+        snapshot = StagedSnapshot(git_repo)
+
+        with snapshot.materialize() as tree:
+            (path,) = tree.files
+            assert path.read_text() == "import os\nimport sys\n\n\ndef main():\n    return 1\n"
+            assert tree.line_ranges == {str(path): [(2, 2)]}
+            assert (tree.root / "setup.cfg").exists()
+            assert tree.repo_path(path) == git_repo.resolve() / "app.py"
+            root = tree.root
+
+        assert not root.exists()
+        assert (git_repo / "app.py").read_text() == "unstaged = True\n"
+
+    def test_no_staged_changes(self, git_repo):
+        """Verify nothing is written when nothing is staged."""
+        _git(git_repo, "commit", "-m", "Commit staged")
+
+        with StagedSnapshot(git_repo).materialize() as tree:
+            assert tree.files == []
+
+    def test_collect_staged_filters_language(self, git_repo):
+        """Verify language filtering matches staged paths directly."""
+        (git_repo / "main.cpp").write_text("int main() { return 1; }\n")
+        _git(git_repo, "add", "main.cpp")
+        collector = FileCollector(git_repo)
+
+        with collector.collect_staged(language="cpp") as tree:
+            assert [p.name for p in tree.files] == ["main.cpp"]
+        with collector.collect_staged() as tree:
+            assert sorted(p.name for p in tree.files) == ["app.py", "main.cpp"]
+
+
+class TestOverlay:
+    """Tests for the scratch tree as an overlay of the working tree."""
+
+    @pytest.fixture
+    def cpp_repo(self, git_repo):
+        """Add a library directory whose header change is not staged."""
+        lib = git_repo / "lib"
+        lib.mkdir()
+        (lib / "widget.h").write_text("int widget();\n")
+        (lib / "widget.cpp").write_text('#include "widget.h"\nint widget() { return 0; }\n')
+        (lib / "setup.cfg").write_text("[flake8]\n")
+        _git(git_repo, "add", "lib")
+        _git(git_repo, "commit", "-m", "Add lib")
+        (lib / "widget.cpp").write_text('#include "widget.h"\nint widget() { return 1; }\n')
+        _git(git_repo, "add", "lib/widget.cpp")
+        (lib / "unstaged.h").write_text("int unstaged();\n")
+        return git_repo
+
+    def test_unstaged_files_are_linked(self, cpp_repo):
+        """Verify relative includes and siblings of staged files resolve in the overlay."""
+        with StagedSnapshot(cpp_repo).materialize() as tree:
+            assert [p.name for p in tree.files] == ["widget.cpp"]
+            assert (tree.root / "lib" / "widget.h").read_text() == "int widget();\n"
+            assert (tree.root / "lib" / "unstaged.h").is_symlink()
+            assert (tree.root / "main.cpp").is_symlink()
+            assert not (tree.root / "lib" / "widget.cpp").is_symlink()
+            assert not (tree.root / ".git").exists()
+            root = tree.root
+
+        assert not root.exists()
+        assert (cpp_repo / "lib" / "widget.h").exists()
+
+    def test_scoped_to_current_directory(self, cpp_repo):
+        """Verify only staged files below the directory are validated, with parent configs."""
+        (cpp_repo / "main.cpp").write_text("int main() { return 1; }\n")
+        _git(cpp_repo, "add", "main.cpp")
+
+        with StagedSnapshot(cpp_repo).materialize() as tree:
+            assert sorted(p.name for p in tree.files) == ["main.cpp", "widget.cpp"]
+        with StagedSnapshot(cpp_repo / "lib").materialize() as tree:
+            assert [p.name for p in tree.files] == ["widget.cpp"]
+            assert not (tree.root / "setup.cfg").is_symlink()
+            assert not (tree.root / "lib" / "setup.cfg").is_symlink()
+
+    def test_linked_header_issues_are_dropped(self, cpp_repo):
+        """Verify issues reported in linked working tree files are outside the change."""
+        with StagedSnapshot(cpp_repo / "lib").materialize() as tree:
+            header = tree.root / "lib" / "widget.h"
+            assert tree.repo_path(header) == cpp_repo.resolve() / "lib" / "widget.h"
+            (result,) = tree.remap(
+                [
+                    ValidationResult(
+                        validator_name="clang-tidy",
+                        passed=False,
+                        errors=[
+                            Issue(file_path=str(path), line_number=1, message="m", severity="error")
+                            for path in (header, header.resolve())
+                        ],
+                    )
+                ]
+            )
+
+        assert result.passed and not result.errors
+
+    def test_compile_database_points_at_staged_copies(self, cpp_repo):
+        """Verify staged entries compile the scratch copy from the real build directory."""
+        build = cpp_repo / "build"
+        build.mkdir()
+        database = [
+            {
+                "directory": str(build),
+                "command": "c++ -I../lib -c ../lib/widget.cpp -o widget.o",
+                "file": "../lib/widget.cpp",
+            },
+            {
+                "directory": str(build),
+                "arguments": ["c++", "-c", str(cpp_repo / "main.cpp")],
+                "file": str(cpp_repo / "main.cpp"),
+            },
+        ]
+        (build / "compile_commands.json").write_text(json.dumps(database))
+        (cpp_repo / "compile_commands.json").write_text(json.dumps(database))
+
+        with StagedSnapshot(cpp_repo / "lib").materialize() as tree:
+            configured_dir = tree.compile_database(build)
+            configured = json.loads((configured_dir / "compile_commands.json").read_text())
+            at_root = json.loads((tree.root / "compile_commands.json").read_text())
+            scratch = str(tree.root / "lib" / "widget.cpp")
+
+        assert configured == at_root
+        widget, main = configured
+        assert widget["file"] == scratch
+        assert widget["arguments"] == ["c++", "-I../lib", "-c", scratch, "-o", "widget.o"]
+        assert widget["directory"] == str(build)
+        assert main == database[1]
+
+
+class TestRemap:
+    """Tests for mapping results back to the working tree."""
+
+    def test_filters_to_changed_lines(self, git_repo):
+        """Verify issues outside the change are dropped and paths rewritten."""
+        with StagedSnapshot(git_repo).materialize() as tree:
+            path = str(tree.files[0])
+            results = [
+                ValidationResult(
+                    validator_name="flake8",
+                    passed=False,
+                    errors=[
+                        Issue(file_path=path, line_number=1, message="old", severity="error"),
+                        Issue(file_path=path, line_number=2, message="new", severity="error"),
+                    ],
+                ),
+                ValidationResult(
+                    validator_name="pylint",
+                    passed=False,
+                    warnings=[
+                        Issue(file_path=path, line_number=5, message="old", severity="warning")
+                    ],
+                ),
+                ValidationResult(
+                    validator_name="black",
+                    passed=False,
+                    errors=[Issue(file_path=path, line_number=1, message="fmt", severity="error")],
+                ),
+            ]
+
+            flake8, pylint, black = tree.remap(results)
+            unfiltered = tree.remap(results, changed_lines_only=False)[0]
+
+        assert [(i.file_path, i.message) for i in flake8.errors] == [
+            (str(git_repo.resolve() / "app.py"), "new")
+        ]
+        assert not flake8.passed
+        assert pylint.passed and not pylint.warnings
+        assert len(black.errors) == 1
+        assert len(unfiltered.errors) == 2
+
+
+class TestToolLineFilters:
+    """Tests for tools that can restrict themselves to line ranges."""
+
+    def test_clang_format_lines(self):
+        """Verify --lines is added for a single file."""
+        options = {"line_ranges": {"a.cpp": [(3, 4), (9, 9)]}}
+
+        command = ClangFormatParser().build_command(["a.cpp"], options)
+
+        assert "--lines=3:4" in command and "--lines=9:9" in command
+        assert "--lines=3:4" not in ClangFormatParser().build_command(["a.cpp", "b.cpp"], options)
+
+    def test_clang_tidy_line_filter(self):
+        """Verify --line-filter lists the chunk's files and ranges."""
+        config = {"line_ranges": {"a.cpp": [(3, 4)], "c.cpp": [(1, 1)]}}
+
+        command = ClangTidyParser.build_command([Path("a.cpp"), Path("b.cpp")], config)
+
+        assert '--line-filter=[{"name": "a.cpp", "lines": [[3, 4]]}]' in command
+
+
+class TestCheckStaged:
+    """Tests for `anvil check --staged`."""
+
+    def test_validates_staged_blobs_on_changed_lines(self, git_repo, monkeypatch):
+        """Verify validators see scratch copies and report changed lines only."""
+        monkeypatch.chdir(git_repo)
+        seen = {}
+
+        def run_validator(self, name, files, config):
+            seen.update(files=files, config=config, content=files[0].read_text())
+            return ValidationResult(
+                validator_name=name,
+                passed=False,
+                errors=[
+                    Issue(file_path=str(files[0]), line_number=line, message=msg, severity="error")
+                    for line, msg in ((1, "'os' imported but unused"), (2, "'sys' unused"))
+                ],
+            )
+
+        args = Namespace(staged=True)
+        with patch("anvil.cli.commands.ValidationOrchestrator.run_validator", run_validator), patch(
+            "anvil.cli.commands.JSONReporter.generate_report"
+        ) as report:
+            exit_code = check_command(args, validator="flake8", format="json")
+
+        (result,) = report.call_args[0][0]
+        assert exit_code == 1
+        assert "import sys" in seen["content"]
+        assert seen["config"]["line_ranges"] == {str(seen["files"][0]): [(2, 2)]}
+        assert [i.message for i in result.errors] == ["'sys' unused"]
+        assert Path(result.errors[0].file_path).name == "app.py"
+        assert not seen["files"][0].exists()
+
+    def test_nothing_staged(self, git_repo, monkeypatch, capsys):
+        """Verify an empty index exits successfully."""
+        _git(git_repo, "commit", "-m", "Commit staged")
+        monkeypatch.chdir(git_repo)
+
+        assert check_command(Namespace(staged=True)) == 0
+        assert "No staged files" in capsys.readouterr().out
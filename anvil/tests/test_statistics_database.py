@@ -687,7 +687,7 @@ class TestDatabaseMigration:
             db = StatisticsDatabase(db_path)
 
             # Check version updated
-            assert db.get_schema_version() == 2
+            assert db.get_schema_version() == 3
 
             # Check test_suite column exists
             cursor = db.connection.cursor()
@@ -973,3 +973,153 @@ class TestTransactionHandling:
         # Verify committed
         records = db.query_validator_results_for_run(run_id)
         assert len(records) == 1
+
+
+class _RecordingConnection:
+    """Connection wrapper that records the statements it executes."""
+
+    def __init__(self, connection):
+        self.connection = connection
+        self.statements = []
+
+    def execute(self, sql, params=()):
+        self.statements.append((sql, params))
+        return self.connection.execute(sql, params)
+
+    def __getattr__(self, name):
+        return getattr(self.connection, name)
+
+
+class TestHistoryQueries:
+    """Test history indexes, query plans and keyset pagination."""
+
+    @staticmethod
+    def _populate(db):
+        """Insert runs out of timestamp order, two records per test per run."""
+        base = datetime(2024, 1, 1)
+        for day in (3, 1, 2):
+            run_id = db.insert_validation_run(
+                ValidationRun(
+                    timestamp=base + timedelta(days=day),
+                    git_commit=f"c{day}",
+                    git_branch="main",
+                    incremental=False,
+                    passed=True,
+                    duration_seconds=1.0,
+                )
+            )
+            for suite in ("A", "B"):
+                db.insert_test_case_record(
+                    TestCaseRecord(
+                        run_id=run_id,
+                        test_name="test_x",
+                        test_suite=suite,
+                        passed=True,
+                        skipped=False,
+                        duration_seconds=float(day),
+                        failure_message=None,
+                    )
+                )
+            db.insert_file_validation_record(
+                FileValidationRecord(
+                    run_id=run_id,
+                    validator_name="flake8",
+                    file_path="a.py",
+                    error_count=day,
+                    warning_count=0,
+                )
+            )
+
+    @staticmethod
+    def _plan(connection, sql, params):
+        """Get the EXPLAIN QUERY PLAN details of a statement."""
+        return [row[-1] for row in connection.execute(f"EXPLAIN QUERY PLAN {sql}", params)]
+
+    def test_keyset_pagination_visits_every_record_once(self):
+        """Test that pages continue after ties in run timestamp."""
+        db = StatisticsDatabase(":memory:")
+        self._populate(db)
+
+        pages, before_id = [], None
+        while True:
+            page = db.query_test_history("test_x", limit=4, before_id=before_id)
+            if not page:
+                break
+            pages.append(page)
+            before_id = page[-1].id
+
+        records = [r for page in pages for r in page]
+        assert [len(p) for p in pages] == [4, 2]
+        assert [r.duration_seconds for r in records] == [3.0, 3.0, 2.0, 2.0, 1.0, 1.0]
+        assert len({r.id for r in records}) == 6
+
+    def test_run_and_file_pagination(self):
+        """Test pagination of branch runs and file history."""
+        db = StatisticsDatabase(":memory:")
+        self._populate(db)
+
+        first = db.query_runs_by_git_branch("main", limit=2)
+        rest = db.query_runs_by_git_branch("main", before_id=first[-1].id)
+        files = db.get_file_error_frequency("a.py", limit=1, before_id=first[0].id)
+
+        assert [r.git_commit for r in first + rest] == ["c3", "c2", "c1"]
+        assert [f.error_count for f in files] == [2]
+        assert db.query_test_history("test_x", before_id=999) == []
+
+    def test_history_plans_use_indexes_without_sorting(self):
+        """Test that history queries are index seeks in result order."""
+        db = StatisticsDatabase(":memory:")
+        connection = db.connection
+        db.connection = _RecordingConnection(connection)
+
+        queries = {
+            "INDEX idx_test_case_history": lambda: db.query_test_history("t", before_id=1),
+            "COVERING INDEX idx_file_validation_history": lambda: db.get_file_error_frequency(
+                "a.py", before_id=1
+            ),
+            "INDEX idx_validator_history": lambda: db.query_validator_history("flake8"),
+            "COVERING INDEX idx_runs_branch_history": lambda: db.query_runs_by_git_branch(
+                "main", limit=10, before_id=1
+            ),
+        }
+        for index, query in queries.items():
+            db.connection.statements.clear()
+            query()
+            ((sql, params),) = db.connection.statements
+            plan = self._plan(connection, sql, params)
+            assert any(f"USING {index}" in step for step in plan), plan
+            assert not any("TEMP B-TREE" in step for step in plan), plan
+
+        db.connection = connection
+
+    def test_cascade_delete_uses_run_indexes(self):
+        """Test that per-run lookups do not scan the record tables."""
+        db = StatisticsDatabase(":memory:")
+
+        for table in ("test_case_records", "file_validation_records", "validator_run_records"):
+            plan = self._plan(db.connection, f"SELECT id FROM {table} WHERE run_id = ?", (1,))
+            assert any("USING" in step and "INDEX" in step for step in plan), plan
+
+    def test_migrate_v2_to_v3(self, tmp_path):
+        """Test that run timestamps are backfilled and indexes replaced."""
+        db_path = tmp_path / "v2.db"
+        db = StatisticsDatabase(str(db_path))
+        self._populate(db)
+        cursor = db.connection.cursor()
+        cursor.execute("DROP INDEX idx_test_case_history")
+        cursor.execute("CREATE INDEX idx_test_case_name ON test_case_records(test_name)")
+        cursor.execute("UPDATE test_case_records SET run_timestamp = NULL")
+        cursor.execute("UPDATE schema_version SET version = 2")
+        db.connection.commit()
+        db.close()
+
+        db = StatisticsDatabase(str(db_path))
+        indexes = {
+            row[0]
+            for row in db.connection.execute("SELECT name FROM sqlite_master WHERE type='index'")
+        }
+        history = db.query_test_history("test_x")
+        db.close()
+
+        assert "idx_test_case_history" in indexes and "idx_test_case_name" not in indexes
+        assert [r.duration_seconds for r in history] == [3.0, 3.0, 2.0, 2.0, 1.0, 1.0]
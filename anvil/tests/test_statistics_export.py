@@ -0,0 +1,245 @@
+"""
+Tests for streaming statistics export.
+
+Covers predicate pushdown into the export queries, batched JSON and CSV
+output, Arrow IPC and Parquet output (when pyarrow is installed) and the
+`anvil stats export` command.
+"""
+
+import csv
+import io
+import json
+import sys
+from argparse import Namespace
+from datetime import datetime
+from unittest.mock import patch
+
+import pytest
+
+from anvil.cli.commands import stats_export_command
+from anvil.storage.statistics_database import (
+    FileValidationRecord,
+    StatisticsDatabase,
+    TestCaseRecord,
+    ValidationRun,
+)
+from anvil.storage.statistics_export import (
+    EXPORT_TABLES,
+    StatisticsExporter,
+    StatisticsExportError,
+)
+
+
+@pytest.fixture
+def db_path(tmp_path):
+    """Create a database with runs on two branches over three days."""
+    path = tmp_path / "statistics.db"
+    db = StatisticsDatabase(str(path))
+    for day, branch in ((1, "main"), (2, "feature"), (3, "main")):
+        run_id = db.insert_validation_run(
+            ValidationRun(
+                timestamp=datetime(2024, 1, day, 12, 0, 0, 500),
+                git_commit=f"c{day}",
+                git_branch=branch,
+                incremental=day == 2,
+                passed=day != 3,
+                duration_seconds=float(day),
+            )
+        )
+        for i in range(3):
+            db.insert_test_case_record(
+                TestCaseRecord(
+                    run_id=run_id,
+                    test_name=f"test_{i}",
+                    test_suite="suite",
+                    passed=i != 0,
+                    skipped=False,
+                    duration_seconds=0.1 * i,
+                    failure_message="boom" if i == 0 else None,
+                )
+            )
+        db.insert_file_validation_record(
+            FileValidationRecord(
+                run_id=run_id,
+                validator_name="flake8",
+                file_path="a.py",
+                error_count=day,
+                warning_count=0,
+            )
+        )
+    db.close()
+    return path
+
+
+@pytest.fixture
+def database(db_path):
+    """Open the populated database."""
+    db = StatisticsDatabase(str(db_path))
+    yield db
+    db.close()
+
+
+class TestQueries:
+    """Tests for the export queries."""
+
+    def test_filters_are_pushed_into_sql(self, database):
+        """Verify date and branch filters become WHERE conditions on the run."""
+        exporter = StatisticsExporter(database, since=datetime(2024, 1, 2), branch="main")
+
+        sql, params = exporter.build_query("test_case_records")
+
+        assert "WHERE r.timestamp >= ? AND r.git_branch = ?" in sql
+        assert params == ["2024-01-02T00:00:00", "main"]
+        rows = [row for batch in exporter.iter_batches("test_case_records") for row in batch]
+        assert {row[-1] for row in rows} == {"main"} and len(rows) == 3
+
+    def test_child_rows_stream_in_id_order(self, database):
+        """Verify the join keeps the child table outermost without sorting."""
+        sql, params = StatisticsExporter(database).build_query("file_validation_records")
+
+        plan = " ".join(
+            row[-1] for row in database.connection.execute(f"EXPLAIN QUERY PLAN {sql}", params)
+        )
+
+        assert plan.index("SCAN t") < plan.index(" r ")
+        assert "TEMP B-TREE" not in plan
+
+    def test_batches(self, database):
+        """Verify rows are fetched in batches of the configured size."""
+        exporter = StatisticsExporter(database, batch_size=4)
+
+        assert [len(b) for b in exporter.iter_batches("test_case_records")] == [4, 4, 1]
+
+
+class TestTextFormats:
+    """Tests for JSON and CSV output."""
+
+    def test_json(self, database):
+        """Verify JSON output holds every table with typed values."""
+        stream = io.StringIO()
+
+        counts = StatisticsExporter(database, batch_size=2).export(
+            "json", None, list(EXPORT_TABLES), stream=stream
+        )
+
+        data = json.loads(stream.getvalue())
+        assert counts == {
+            "validation_runs": 3,
+            "test_case_records": 9,
+            "file_validation_records": 3,
+        }
+        assert data["validation_runs"][1]["incremental"] is True
+        assert data["test_case_records"][0] == {
+            "id": 1,
+            "run_id": 1,
+            "test_name": "test_0",
+            "test_suite": "suite",
+            "passed": False,
+            "skipped": False,
+            "duration_seconds": 0.0,
+            "failure_message": "boom",
+            "run_timestamp": "2024-01-01T12:00:00.000500",
+            "run_git_commit": "c1",
+            "run_git_branch": "main",
+        }
+
+    def test_json_empty_selection(self, database):
+        """Verify filters matching nothing still give valid JSON."""
+        stream = io.StringIO()
+
+        StatisticsExporter(database, branch="none").export(
+            "json", None, ["validation_runs"], stream=stream
+        )
+
+        assert json.loads(stream.getvalue()) == {"validation_runs": []}
+
+    def test_csv_directory(self, database, tmp_path):
+        """Verify CSV output writes one file per table."""
+        out = tmp_path / "export"
+
+        StatisticsExporter(database, until=datetime(2024, 1, 3)).export(
+            "csv", out, ["validation_runs", "file_validation_records"]
+        )
+
+        with open(out / "file_validation_records.csv", newline="") as f:
+            rows = list(csv.DictReader(f))
+        assert [r["error_count"] for r in rows] == ["1", "2"]
+        assert (out / "validation_runs.csv").exists()
+
+    def test_unknown_table(self, database):
+        """Verify unknown tables are rejected."""
+        with pytest.raises(StatisticsExportError):
+            StatisticsExporter(database).export("json", None, ["nope"], stream=io.StringIO())
+
+
+class TestColumnarFormats:
+    """Tests for Arrow IPC and Parquet output."""
+
+    @pytest.mark.parametrize("format", ["arrow", "parquet"])
+    def test_round_trip(self, database, tmp_path, format):
+        """Verify typed columns survive a round trip."""
+        pa = pytest.importorskip("pyarrow")
+        import pyarrow.ipc
+        import pyarrow.parquet
+
+        out = tmp_path / "export"
+        counts = StatisticsExporter(database, batch_size=2, branch="main").export(
+            format, out, list(EXPORT_TABLES)
+        )
+
+        path = out / f"test_case_records.{format}"
+        if format == "parquet":
+            table = pyarrow.parquet.read_table(path)
+        else:
+            table = pyarrow.ipc.open_file(str(path)).read_all()
+        assert counts["test_case_records"] == 6 == table.num_rows
+        assert table.schema.field("passed").type == pa.bool_()
+        assert table.schema.field("run_timestamp").type == pa.timestamp("us")
+        assert table.column("run_timestamp")[0].as_py() == datetime(2024, 1, 1, 12, 0, 0, 500)
+        assert set(table.column("run_git_branch").to_pylist()) == {"main"}
+
+    def test_requires_pyarrow(self, database, tmp_path):
+        """Verify a clear error without pyarrow."""
+        with patch.dict(sys.modules, {"pyarrow": None}):
+            with pytest.raises(StatisticsExportError, match="pyarrow"):
+                StatisticsExporter(database).export("parquet", tmp_path, ["validation_runs"])
+
+    def test_requires_output_directory(self, database):
+        """Verify columnar formats are not written to a text stream."""
+        with pytest.raises(StatisticsExportError, match="output directory"):
+            StatisticsExporter(database).export(
+                "arrow", None, ["validation_runs"], stream=io.StringIO()
+            )
+
+
+class TestStatsExportCommand:
+    """Tests for `anvil stats export`."""
+
+    def test_json_to_stdout_with_filters(self, db_path, capsys):
+        """Verify command-line filters reach the export."""
+        args = Namespace(
+            database=str(db_path),
+            tables=["validation_runs"],
+            since="2024-01-02",
+            until=None,
+            branch=None,
+        )
+
+        assert stats_export_command(args, format="json") == 0
+        runs = json.loads(capsys.readouterr().out)["validation_runs"]
+        assert [r["git_commit"] for r in runs] == ["c2", "c3"]
+
+    def test_invalid_date(self, db_path, capsys):
+        """Verify malformed dates are reported."""
+        args = Namespace(database=str(db_path), since="yesterday")
+
+        assert stats_export_command(args, format="json") == 1
+        assert "Invalid date" in capsys.readouterr().err
+
+    def test_missing_database(self, tmp_path, capsys):
+        """Verify a missing database keeps the empty JSON output."""
+        args = Namespace(database=str(tmp_path / "missing.db"))
+
+        assert stats_export_command(args, format="json") == 0
+        assert "message" in json.loads(capsys.readouterr().out)
+        assert stats_export_command(args, format="parquet", output=str(tmp_path)) == 1
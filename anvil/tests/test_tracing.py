@@ -0,0 +1,243 @@
+"""
+Tests for the shared tracing facility.
+
+Covers the disabled fast path, Chrome trace and OTLP file output, span
+nesting and errors, subprocess events, several processes writing one trace
+and the spans around validators and file batches.
+"""
+
+import importlib.util
+import json
+import multiprocessing
+import os
+import subprocess
+import sys
+from pathlib import Path
+
+import pytest
+
+from anvil.core.orchestrator import ValidationOrchestrator
+from anvil.core.validator_registry import ValidatorRegistry
+from anvil.executors.fanout import fan_out
+from anvil.models.validator import ValidationResult, Validator
+from anvil.utils import tracing
+from anvil.utils.tracing import (
+    NOOP_SPAN,
+    TRACE_ENV,
+    TRACE_FORMAT_ENV,
+    TRACE_ID_ENV,
+    configure_tracing,
+    disable_tracing,
+    load_trace_events,
+    span,
+    traced,
+)
+
+
+@pytest.fixture(autouse=True)
+def isolated_tracing(monkeypatch):
+    """Start each test with tracing off and restore the environment afterwards."""
+    disable_tracing()
+    for name in (TRACE_ENV, TRACE_FORMAT_ENV, TRACE_ID_ENV):
+        monkeypatch.setenv(name, "")
+    yield
+    disable_tracing()
+
+
+class PassingValidator(Validator):
+    """Validator that passes every file."""
+
+    name = "fake"
+    language = "python"
+    description = "Always passes"
+
+    def validate(self, files, config):
+        """Pass all files."""
+        return ValidationResult(self.name, True, [], [], len(files))
+
+    def is_available(self):
+        """Always available."""
+        return True
+
+
+def _traced_square(value: int) -> int:
+    """Pool worker function that records a span."""
+    with span("worker", value=value):
+        return value * value
+
+
+def _events(path: Path):
+    """Chrome trace events other than metadata."""
+    return [e for e in load_trace_events(path) if e["ph"] != "M"]
+
+
+class TestDisabled:
+    """Tests for the disabled fast path."""
+
+    def test_noop(self, tmp_path):
+        """Verify spans are the shared no-op object and nothing is written."""
+        calls = []
+
+        @traced("work")
+        def work(value):
+            calls.append(value)
+            return value * 2
+
+        with span("outer", key="value") as s:
+            s.set_attribute("more", 1)
+
+        assert span("x") is NOOP_SPAN
+        assert work(21) == 42 and calls == [21]
+        assert tracing.get_tracer() is None
+        assert not list(tmp_path.iterdir())
+
+
+class TestChromeTrace:
+    """Tests for Chrome trace event output."""
+
+    def test_spans_and_subprocess_events(self, tmp_path):
+        """Verify complete events, attributes, errors and subprocess instants."""
+        path = tmp_path / "trace.json"
+        configure_tracing(path, service="anvil")
+
+        with span("outer", files=3) as outer:
+            subprocess.run([sys.executable, "-c", "pass"], check=True)
+            outer.set_attribute("passed", True)
+            with pytest.raises(ValueError):
+                with span("inner"):
+                    raise ValueError("boom")
+        disable_tracing()
+
+        metadata = [e for e in load_trace_events(path) if e["ph"] == "M"]
+        events = {e["name"]: e for e in _events(path)}
+        assert metadata[0]["args"] == {"name": "anvil"}
+        assert events["outer"]["args"] == {"files": 3, "passed": True}
+        assert events["inner"]["args"]["error"] == "ValueError: boom"
+        assert events["subprocess"]["ph"] == "i"
+        assert sys.executable in events["subprocess"]["args"]["command"]
+        outer_end = events["outer"]["ts"] + events["outer"]["dur"]
+        assert events["outer"]["ts"] <= events["inner"]["ts"] <= outer_end
+
+    def test_processes_share_one_file(self, tmp_path):
+        """Verify a child process inherits the trace and appends to the same file."""
+        path = tmp_path / "trace.json"
+        tracer = configure_tracing(path, service="forge")
+        with span("parent"):
+            subprocess.run(
+                [
+                    sys.executable,
+                    "-c",
+                    "from anvil.utils.tracing import set_service_name, span\n"
+                    "set_service_name('scout')\n"
+                    "with span('child'):\n"
+                    "    pass\n",
+                ],
+                check=True,
+                cwd=str(Path(__file__).resolve().parents[1]),
+            )
+        disable_tracing()
+
+        events = load_trace_events(path)
+        names = {e["args"]["name"] for e in events if e["ph"] == "M"}
+        assert names == {"forge", "scout"}
+        assert {"parent", "child"} <= {e["name"] for e in events}
+        assert len({e["pid"] for e in events}) == 2
+        assert tracer.trace_id
+
+    @pytest.mark.skipif(not hasattr(os, "fork"), reason="requires fork")
+    def test_forked_pool_workers_flush_own_spans(self, tmp_path):
+        """Verify forked workers write their spans once and never the parent's."""
+        path = tmp_path / "trace.json"
+        configure_tracing(path, service="anvil")
+        with span("before_fork"):
+            pass
+
+        with multiprocessing.get_context("fork").Pool(2) as pool:
+            assert pool.map(_traced_square, range(4)) == [0, 1, 4, 9]
+            pool.close()
+            pool.join()
+        disable_tracing()
+
+        events = _events(path)
+        workers = [e for e in events if e["name"] == "worker"]
+        assert [e["name"] for e in events].count("before_fork") == 1
+        assert sorted(e["args"]["value"] for e in workers) == [0, 1, 2, 3]
+        assert os.getpid() not in {e["pid"] for e in workers}
+
+
+class TestGeneratedShims:
+    """Tests for the per-package tracing re-exports."""
+
+    def test_shims_are_up_to_date(self):
+        """Verify Forge, Scout and Verdict tracing modules match their template."""
+        script = Path(__file__).resolve().parents[1] / "scripts" / "generate_tracing_shims.py"
+        spec = importlib.util.spec_from_file_location("generate_tracing_shims", script)
+        generator = importlib.util.module_from_spec(spec)
+        spec.loader.exec_module(generator)
+
+        for relative_path, package in generator.SHIMS.items():
+            path = generator.REPO_ROOT / relative_path
+            if not path.exists():
+                pytest.skip(f"{relative_path} is not checked out")
+            assert path.read_text(encoding="utf-8") == generator.render(package), relative_path
+
+
+class TestOtlp:
+    """Tests for OTLP/JSON output."""
+
+    def test_export_request_lines(self, tmp_path):
+        """Verify resource, parent links, typed attributes and error status."""
+        path = tmp_path / "trace.jsonl"
+        tracer = configure_tracing(path, service="verdict")
+
+        with span("suite", cases=2, ratio=0.5, ok=True, name="s"):
+            with pytest.raises(RuntimeError):
+                with span("case"):
+                    raise RuntimeError("failed")
+        disable_tracing()
+
+        (line,) = path.read_text().splitlines()
+        resource_spans = json.loads(line)["resourceSpans"][0]
+        resource = {a["key"]: a["value"] for a in resource_spans["resource"]["attributes"]}
+        spans = {s["name"]: s for s in resource_spans["scopeSpans"][0]["spans"]}
+        assert resource["service.name"] == {"stringValue": "verdict"}
+        assert spans["case"]["parentSpanId"] == spans["suite"]["spanId"]
+        assert "parentSpanId" not in spans["suite"]
+        assert {s["traceId"] for s in spans.values()} == {tracer.trace_id}
+        assert spans["case"]["status"] == {"code": 2, "message": "RuntimeError: failed"}
+        attributes = {a["key"]: a["value"] for a in spans["suite"]["attributes"]}
+        assert attributes["cases"] == {"intValue": "2"}
+        assert attributes["ratio"] == {"doubleValue": 0.5}
+        assert attributes["ok"] == {"boolValue": True}
+        assert int(spans["suite"]["endTimeUnixNano"]) >= int(spans["suite"]["startTimeUnixNano"])
+
+    def test_unknown_format(self, tmp_path):
+        """Verify unknown formats are rejected."""
+        with pytest.raises(ValueError, match="Unknown trace format"):
+            configure_tracing(tmp_path / "trace.json", format="zipkin")
+
+
+class TestInstrumentation:
+    """Tests for spans around validators and file batches."""
+
+    def test_validator_and_batch_spans(self, tmp_path):
+        """Verify each validator and each fan-out chunk gets a span."""
+        path = tmp_path / "trace.json"
+        configure_tracing(path)
+        registry = ValidatorRegistry()
+        registry.register(PassingValidator())
+
+        ValidationOrchestrator(registry).run_all([Path("a.py"), Path("b.py")])
+        fan_out(
+            lambda chunk: ValidationResult("fake", True, [], [], len(chunk)),
+            [f"f{i}.py" for i in range(40)],
+            "fake",
+            config={"jobs": 2},
+        )
+        disable_tracing()
+
+        events = _events(path)
+        (validator,) = [e for e in events if e["name"] == "anvil.validator"]
+        batches = [e for e in events if e["name"] == "anvil.file_batch"]
+        assert validator["args"] == {"validator": "fake", "files": 2, "passed": True}
+        assert sorted(b["args"]["files"] for b in batches) == [20, 20]
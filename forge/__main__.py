@@ -6,29 +6,46 @@ output inspection, and data persistence.
 """
 
 import logging
+from pathlib import Path
 import sys
+import time
 from typing import List, Optional
 
 from forge.cli.argument_errors import ArgumentError
-from forge.cli.argument_parser import ArgumentParser
+from forge.cli.argument_parser import (
+    ArgumentParser,
+    CoverageArgumentParser,
+    TimeTraceArgumentParser,
+)
 from forge.cli.argument_validator import ArgumentValidator, ValidationError
 from forge.cmake.executor import CMakeExecutor
 from forge.cmake.parameter_manager import CMakeParameterManager
+from forge.coverage.collector import (
+    CoverageCollector,
+    CoverageError,
+    detect_toolchain,
+    record_in_anvil,
+)
 from forge.inspector.build_inspector import BuildInspector
+from forge.profiling.time_trace import STORED_COSTS, TimeTraceCollector, TimeTraceError
 from forge.storage.data_persistence import DataPersistence
+from forge.utils.tracing import set_service_name, span
 
 
-def _parse_and_validate_args(argv: Optional[List[str]]) -> tuple:
+def _parse_and_validate_args(
+    argv: Optional[List[str]], parser: Optional[ArgumentParser] = None
+) -> tuple:
     """
     Parse and validate command-line arguments.
 
     Args:
         argv: Command-line arguments
+        parser: Parser to use (default: the build ArgumentParser)
 
     Returns:
         Tuple of (args, exit_code) where exit_code is None on success
     """
-    parser = ArgumentParser()
+    parser = parser or ArgumentParser()
     try:
         args = parser.parse(argv)
     except SystemExit as e:
@@ -57,11 +74,13 @@ def _execute_configure_phase(args, param_manager, executor, inspector, persisten
         print(f"Build directory: {args.build_dir}")
         print(f"CMake command: {' '.join(param_manager.get_configure_command())}")
 
-    configure_result = executor.execute_configure(
-        command=param_manager.get_configure_command(),
-        working_dir=args.build_dir,
-        stream_output=True,
-    )
+    with span("forge.configure", build_dir=str(args.build_dir)) as configure_span:
+        configure_result = executor.execute_configure(
+            command=param_manager.get_configure_command(),
+            working_dir=args.build_dir,
+            stream_output=True,
+        )
+        configure_span.set_attribute("exit_code", configure_result.exit_code)
 
     if not configure_result.success:
         print(
@@ -107,11 +126,13 @@ def _execute_build_phase(args, param_manager, executor, inspector, logger):
     if args.verbose and args.configure:
         print(f"Build command: {' '.join(param_manager.get_build_command())}")
 
-    build_result = executor.execute_build(
-        command=param_manager.get_build_command(),
-        working_dir=args.build_dir,
-        stream_output=True,
-    )
+    with span("forge.build", build_dir=str(args.build_dir)) as build_span:
+        build_result = executor.execute_build(
+            command=param_manager.get_build_command(),
+            working_dir=args.build_dir,
+            stream_output=True,
+        )
+        build_span.set_attribute("exit_code", build_result.exit_code)
 
     if not build_result.success:
         print(f"Build failed with exit code {build_result.exit_code}", file=sys.stderr)
@@ -127,23 +148,31 @@ def _execute_build_phase(args, param_manager, executor, inspector, logger):
 
 
 def _save_build_data(build_result, build_metadata, configuration_id, persistence, logger):
-    """Save build data and diagnostics to database."""
+    """
+    Save build data and diagnostics to database.
+
+    Returns:
+        Build ID, or None if the build could not be saved
+    """
+    build_id = None
     try:
         build_id = persistence.save_build(build_result, build_metadata, configuration_id)
         logger.debug(f"Saved build with ID: {build_id}")
 
         # Save warnings and errors
         if build_metadata.warnings:
-            warning_count = persistence.save_warnings(build_metadata.warnings, build_id)
+            warning_count = persistence.save_warnings(build_id, build_metadata.warnings)
             logger.debug(f"Saved {warning_count} warnings")
 
         if build_metadata.errors:
-            error_count = persistence.save_errors(build_metadata.errors, build_id)
+            error_count = persistence.save_errors(build_id, build_metadata.errors)
             logger.debug(f"Saved {error_count} errors")
 
     except Exception as e:
         logger.warning(f"Failed to save build data to database: {e}")
 
+    return build_id
+
 
 def _print_summary(configure_result, build_result, build_metadata):
     """Print build summary."""
@@ -169,6 +198,294 @@ def _print_summary(configure_result, build_result, build_metadata):
     print("=" * 70)
 
 
+def _configure_logging(args):
+    """Configure logging for the verbosity requested."""
+    log_level = logging.DEBUG if args.verbose else logging.INFO
+    logging.basicConfig(
+        level=log_level,
+        format="%(levelname)s: %(message)s",
+    )
+    return logging.getLogger(__name__)
+
+
+def _record_coverage(args, report, logger):
+    """
+    Record an lcov report in the Anvil history database.
+
+    Returns:
+        Tuple of (execution_id, coverage_data)
+    """
+    repo_dir = args.source_dir or Path.cwd()
+    database = args.anvil_database or repo_dir / ".anvil" / "history.db"
+    logger.debug(f"Recording coverage in {database}")
+    return record_in_anvil(report, repo_dir, database, commit=args.commit)
+
+
+def _print_coverage_summary(tests_exit_code, collect_duration, report, recorded):
+    """Print coverage summary."""
+    print("\n" + "=" * 70)
+    print("COVERAGE SUMMARY")
+    print("=" * 70)
+
+    status = "PASSED" if tests_exit_code == 0 else f"FAILED (exit code {tests_exit_code})"
+    print(f"Tests:         {status}")
+    print(f"Collection:    {collect_duration:.2f}s")
+    print(f"Report:        {report}")
+
+    if recorded:
+        execution_id, coverage = recorded
+        print(
+            f"Coverage:      {coverage.total_coverage:.2f}% "
+            f"({coverage.covered_statements}/{coverage.total_statements} lines, "
+            f"{coverage.files_analyzed} files)"
+        )
+        print(f"Anvil run:     {execution_id}")
+
+    print("=" * 70)
+
+
+def coverage_main(argv: List[str]) -> int:
+    """
+    Entry point of `forge coverage`.
+
+    Configures and builds with coverage instrumentation, runs the tests with
+    ctest, merges the coverage counters in parallel into an lcov report and
+    records it in Anvil's coverage_summary/coverage_history tables.
+
+    Args:
+        argv: Arguments after "coverage"
+
+    Returns:
+        Exit code (0 for success, the failing step's exit code otherwise)
+    """
+    args, exit_code = _parse_and_validate_args(argv, CoverageArgumentParser())
+    if exit_code is not None:
+        return exit_code
+
+    logger = _configure_logging(args)
+
+    param_manager = CMakeParameterManager(args)
+    executor = CMakeExecutor()
+    inspector = BuildInspector()
+
+    if not executor.check_cmake_available():
+        print(
+            "Error: CMake not found. Please install CMake and ensure it's in your PATH.",
+            file=sys.stderr,
+        )
+        return 127
+
+    toolchain = args.toolchain
+    if toolchain == "auto":
+        toolchain = detect_toolchain(param_manager.get_parameters(), args.build_dir)
+    collector = CoverageCollector(toolchain, args.build_dir, args.source_dir, jobs=args.jobs)
+    logger.info(f"Coverage toolchain: {toolchain}")
+
+    if args.configure:
+        for name, value in collector.configure_parameters(param_manager.get_parameters()).items():
+            param_manager.add_parameter(name, value)
+    else:
+        logger.warning("--no-configure: the build directory must already use coverage flags")
+
+    persistence = DataPersistence(args.database_path if args.database_path else None)
+
+    configure_result = None
+    configuration_id = None
+    if args.configure:
+        configure_result, _, configuration_id, exit_code = _execute_configure_phase(
+            args, param_manager, executor, inspector, persistence, logger
+        )
+        if exit_code is not None:
+            return exit_code
+
+    build_result, build_metadata = _execute_build_phase(
+        args, param_manager, executor, inspector, logger
+    )
+    _save_build_data(build_result, build_metadata, configuration_id, persistence, logger)
+    _print_summary(configure_result, build_result, build_metadata)
+    if not build_result.success:
+        return build_result.exit_code
+
+    try:
+        removed = collector.reset_counters()
+        logger.debug(f"Removed {removed} stale coverage counter files")
+
+        logger.info("Running tests...")
+        with span("forge.coverage.tests") as tests_span:
+            tests_exit_code = collector.run_tests(args.ctest_args)
+            tests_span.set_attribute("exit_code", tests_exit_code)
+
+        logger.info("Collecting coverage...")
+        start = time.monotonic()
+        with span("forge.coverage.collect", toolchain=toolchain):
+            report = collector.collect()
+        collect_duration = time.monotonic() - start
+
+        if args.record:
+            with span("forge.coverage.record"):
+                recorded = _record_coverage(args, report, logger)
+        else:
+            recorded = None
+    except CoverageError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+
+    _print_coverage_summary(tests_exit_code, collect_duration, report, recorded)
+    return tests_exit_code
+
+
+def _format_change(total_ms, previous_ms):
+    """Format a cost's change against the previous profiled build."""
+    if previous_ms is None:
+        return "new"
+    return f"{total_ms - previous_ms:+.0f} ms"
+
+
+def _print_time_trace_summary(report, collect_duration, top, previous):
+    """
+    Print the costliest templates and instantiations.
+
+    Args:
+        report: TimeTraceReport of the build
+        collect_duration: Seconds spent aggregating the traces
+        top: Costs printed per kind
+        previous: (kind, name) -> total_ms of the previous profiled build, or None
+    """
+    print("\n" + "=" * 70)
+    print("TEMPLATE INSTANTIATION PROFILE")
+    print("=" * 70)
+
+    share = report.instantiation_ms / report.compile_ms * 100 if report.compile_ms else 0.0
+    print(f"Translation units: {report.translation_units} (aggregated in {collect_duration:.2f}s)")
+    print(f"Compile time:      {report.compile_ms / 1000:.2f}s")
+    print(f"Instantiation:     {report.instantiation_ms / 1000:.2f}s ({share:.0f}%)")
+
+    for title, costs in (
+        ("Templates", report.templates[:top]),
+        ("Instantiations", report.instantiations[:top]),
+    ):
+        if not costs:
+            continue
+        print(f"\n{title}:")
+        header = f"  {'Total':>10} {'Count':>7} {'TUs':>5}"
+        print(header + ("  Change    " if previous is not None else "  ") + "Name")
+        for cost in costs:
+            line = f"  {cost.total_ms:>7.0f} ms {cost.count:>7} {cost.translation_units:>5}"
+            if previous is not None:
+                change = _format_change(cost.total_ms, previous.get((cost.kind, cost.name)))
+                line += f"  {change:<9}"
+            print(f"{line} {cost.name}")
+
+    print("=" * 70)
+
+
+def _previous_template_costs(persistence, project_name, build_id):
+    """
+    Template costs of the project's previous profiled build.
+
+    Returns:
+        (kind, name) -> total_ms, or None if no earlier build was profiled
+    """
+    previous_id = persistence.get_previous_profiled_build(project_name, build_id)
+    if previous_id is None:
+        return None
+    return {
+        (cost["kind"], cost["name"]): cost["total_ms"]
+        for cost in persistence.get_template_costs(previous_id)
+    }
+
+
+def time_trace_main(argv: List[str]) -> int:
+    """
+    Entry point of `forge time-trace`.
+
+    Configures and builds with Clang's -ftime-trace, aggregates the traces of
+    all translation units in parallel and stores the costliest templates and
+    instantiations with the build, comparing them to the previous profiled
+    build of the project.
+
+    Args:
+        argv: Arguments after "time-trace"
+
+    Returns:
+        Exit code (0 for success, the failing step's exit code otherwise)
+    """
+    args, exit_code = _parse_and_validate_args(argv, TimeTraceArgumentParser())
+    if exit_code is not None:
+        return exit_code
+
+    logger = _configure_logging(args)
+
+    param_manager = CMakeParameterManager(args)
+    executor = CMakeExecutor()
+    inspector = BuildInspector()
+
+    if not executor.check_cmake_available():
+        print(
+            "Error: CMake not found. Please install CMake and ensure it's in your PATH.",
+            file=sys.stderr,
+        )
+        return 127
+
+    if detect_toolchain(param_manager.get_parameters(), args.build_dir) != "llvm":
+        print(
+            "Error: -ftime-trace needs Clang. Configure with "
+            "--cmake-args -DCMAKE_CXX_COMPILER=clang++ or set CXX=clang++.",
+            file=sys.stderr,
+        )
+        return 2
+
+    collector = TimeTraceCollector(args.build_dir, granularity=args.granularity, jobs=args.jobs)
+    if args.configure:
+        for name, value in collector.configure_parameters(param_manager.get_parameters()).items():
+            param_manager.add_parameter(name, value)
+    else:
+        logger.warning("--no-configure: the build directory must already use -ftime-trace")
+
+    persistence = DataPersistence(args.database_path if args.database_path else None)
+
+    configure_result = None
+    configuration_id = None
+    if args.configure:
+        configure_result, _, configuration_id, exit_code = _execute_configure_phase(
+            args, param_manager, executor, inspector, persistence, logger
+        )
+        if exit_code is not None:
+            return exit_code
+
+    build_result, build_metadata = _execute_build_phase(
+        args, param_manager, executor, inspector, logger
+    )
+    build_id = _save_build_data(build_result, build_metadata, configuration_id, persistence, logger)
+    _print_summary(configure_result, build_result, build_metadata)
+    if not build_result.success:
+        return build_result.exit_code
+
+    logger.info("Aggregating time traces...")
+    start = time.monotonic()
+    try:
+        with span("forge.time_trace.collect") as collect_span:
+            report = collector.collect()
+            collect_span.set_attribute("translation_units", report.translation_units)
+    except TimeTraceError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+    collect_duration = time.monotonic() - start
+
+    previous = None
+    if build_id is not None:
+        try:
+            persistence.save_template_costs(build_id, report.costs(STORED_COSTS))
+            previous = _previous_template_costs(
+                persistence, build_metadata.project_name or "Unknown", build_id
+            )
+        except RuntimeError as e:
+            logger.warning(f"Failed to save template costs to database: {e}")
+
+    _print_time_trace_summary(report, collect_duration, args.top, previous)
+    return 0
+
+
 def main(argv: Optional[List[str]] = None) -> int:
     """
     Main entry point for forge application.
@@ -186,19 +503,21 @@ def main(argv: Optional[List[str]] = None) -> int:
     if argv is None:
         argv = sys.argv[1:]
 
+    set_service_name("forge")
+
     try:
+        if argv and argv[0] == "coverage":
+            return coverage_main(argv[1:])
+        if argv and argv[0] == "time-trace":
+            return time_trace_main(argv[1:])
+
         # Step 1: Parse and validate arguments
         args, exit_code = _parse_and_validate_args(argv)
         if exit_code is not None:
             return exit_code
 
         # Step 2: Configure logging
-        log_level = logging.DEBUG if args.verbose else logging.INFO
-        logging.basicConfig(
-            level=log_level,
-            format="%(levelname)s: %(message)s",
-        )
-        logger = logging.getLogger(__name__)
+        logger = _configure_logging(args)
 
         # Step 3: Initialize components
         logger.debug("Initializing components...")
@@ -7,9 +7,9 @@ Handles command-line argument parsing and converts to ForgeArguments dataclass.
 import argparse
 from pathlib import Path
 import sys
-from typing import List, Optional, Tuple
+from typing import Dict, List, Optional, Tuple
 
-from forge.models.arguments import ForgeArguments
+from forge.models.arguments import CoverageArguments, ForgeArguments, TimeTraceArguments
 
 
 class ArgumentParser:
@@ -20,11 +20,14 @@ class ArgumentParser:
     with all parsed values.
     """
 
+    PROG = "forge"
+    DESCRIPTION = "Forge - Non-intrusive CMake build wrapper"
+
     def __init__(self):
         """Initialize the argument parser with all Forge arguments."""
         self.parser = argparse.ArgumentParser(
-            prog="forge",
-            description="Forge - Non-intrusive CMake build wrapper",
+            prog=self.PROG,
+            description=self.DESCRIPTION,
             epilog="For more information, see the documentation.",
         )
 
@@ -97,22 +100,12 @@ class ArgumentParser:
             version="%(prog)s 0.1.0",
         )
 
-    def _extract_special_args(self, args: List[str]) -> Tuple[List[str], List[str], List[str]]:
-        """
-        Extract --cmake-args and --build-args from argument list.
+    # Options whose values run until the next forge flag
+    SPECIAL_ARGS = ("--cmake-args", "--build-args")
 
-        Args:
-            args: List of command-line arguments
-
-        Returns:
-            Tuple of (cmake_args, build_args, filtered_args)
-        """
-        cmake_args_list = []
-        build_args_list = []
-        filtered_args = []
-
-        # Known flags that end cmake-args/build-args collection
-        forge_flags = {
+    # Known flags that end collection of SPECIAL_ARGS values
+    FORGE_FLAGS = frozenset(
+        {
             "--build-dir",
             "--source-dir",
             "--database",
@@ -124,26 +117,49 @@ class ArgumentParser:
             "--help",
             "-h",
         }
+    )
+
+    def _collect_special_args(self, args: List[str]) -> Tuple[Dict[str, List[str]], List[str]]:
+        """
+        Extract the values of SPECIAL_ARGS options from an argument list.
+
+        Args:
+            args: List of command-line arguments
+
+        Returns:
+            Tuple of (values by option, filtered_args)
+        """
+        collected: Dict[str, List[str]] = {name: [] for name in self.SPECIAL_ARGS}
+        stop = self.FORGE_FLAGS.union(self.SPECIAL_ARGS)
+        filtered_args = []
 
         i = 0
         while i < len(args):
-            if args[i] == "--cmake-args":
+            if args[i] in collected:
+                values = collected[args[i]]
                 i += 1
-                while i < len(args) and args[i] not in forge_flags:
-                    cmake_args_list.append(args[i])
-                    i += 1
-                continue
-            if args[i] == "--build-args":
-                i += 1
-                while i < len(args) and args[i] not in forge_flags:
-                    build_args_list.append(args[i])
+                while i < len(args) and args[i] not in stop:
+                    values.append(args[i])
                     i += 1
                 continue
 
             filtered_args.append(args[i])
             i += 1
 
-        return cmake_args_list, build_args_list, filtered_args
+        return collected, filtered_args
+
+    def _extract_special_args(self, args: List[str]) -> Tuple[List[str], List[str], List[str]]:
+        """
+        Extract --cmake-args and --build-args from argument list.
+
+        Args:
+            args: List of command-line arguments
+
+        Returns:
+            Tuple of (cmake_args, build_args, filtered_args)
+        """
+        collected, filtered_args = self._collect_special_args(args)
+        return collected["--cmake-args"], collected["--build-args"], filtered_args
 
     def parse(self, args: Optional[List[str]] = None) -> ForgeArguments:
         """
@@ -161,12 +177,25 @@ class ArgumentParser:
         if args is None:
             args = sys.argv[1:]
 
-        # Extract special arguments
-        cmake_args_list, build_args_list, filtered_args = self._extract_special_args(args)
-
-        # Parse arguments
+        # Extract special arguments, then parse the rest
+        collected, filtered_args = self._collect_special_args(args)
         parsed = self.parser.parse_args(filtered_args)
 
+        return self._build_arguments(parsed, collected)
+
+    def _build_arguments(
+        self, parsed: argparse.Namespace, collected: Dict[str, List[str]]
+    ) -> ForgeArguments:
+        """
+        Convert parsed arguments to a ForgeArguments object.
+
+        Args:
+            parsed: Namespace from argparse
+            collected: Values of SPECIAL_ARGS options
+
+        Returns:
+            ForgeArguments object with parsed values.
+        """
         # Convert to absolute paths and expand user directory
         build_dir = Path(parsed.build_dir).expanduser().resolve()
         source_dir = Path(parsed.source_dir).expanduser().resolve() if parsed.source_dir else None
@@ -174,19 +203,208 @@ class ArgumentParser:
             Path(parsed.database_path).expanduser().resolve() if parsed.database_path else None
         )
 
-        # Use the cmake_args and build_args we collected
-        cmake_args = cmake_args_list if cmake_args_list else []
-        build_args = build_args_list if build_args_list else []
-
         # Create and return ForgeArguments object
         return ForgeArguments(
             build_dir=build_dir,
             source_dir=source_dir,
-            cmake_args=cmake_args,
-            build_args=build_args,
+            cmake_args=collected["--cmake-args"],
+            build_args=collected["--build-args"],
             database_path=database_path,
             project_name=parsed.project_name,
             verbose=parsed.verbose,
             configure=parsed.configure,
             clean_build=parsed.clean_build,
         )
+
+
+class CoverageArgumentParser(ArgumentParser):
+    """
+    Parser for `forge coverage` arguments.
+
+    Accepts every build argument plus the coverage options and returns a
+    CoverageArguments object.
+    """
+
+    PROG = "forge coverage"
+    DESCRIPTION = "Forge - Build with coverage instrumentation, run tests and collect coverage"
+
+    SPECIAL_ARGS = ArgumentParser.SPECIAL_ARGS + ("--ctest-args",)
+
+    FORGE_FLAGS = ArgumentParser.FORGE_FLAGS | {
+        "--toolchain",
+        "--jobs",
+        "--anvil-database",
+        "--commit",
+        "--no-record",
+    }
+
+    def _add_arguments(self):
+        """Add build arguments and coverage options to the parser."""
+        super()._add_arguments()
+
+        self.parser.add_argument(
+            "--toolchain",
+            choices=["auto", "gcc", "llvm"],
+            default="auto",
+            help=(
+                "Coverage instrumentation: gcc (--coverage, gcov) or llvm "
+                "(-fprofile-instr-generate, llvm-cov); auto picks from the compiler"
+            ),
+        )
+
+        self.parser.add_argument(
+            "--jobs",
+            type=int,
+            default=None,
+            help="Parallel coverage collection workers (default: CPU count)",
+        )
+
+        self.parser.add_argument(
+            "--anvil-database",
+            type=Path,
+            default=None,
+            help="Anvil history database to record into (default: <source-dir>/.anvil/history.db)",
+        )
+
+        self.parser.add_argument(
+            "--commit",
+            type=str,
+            default="HEAD",
+            help="Git commit the coverage run is recorded for (default: HEAD)",
+        )
+
+        self.parser.add_argument(
+            "--no-record",
+            action="store_false",
+            dest="record",
+            default=True,
+            help="Only write the lcov report, do not record it in the Anvil database",
+        )
+
+    def parse(self, args: Optional[List[str]] = None) -> CoverageArguments:
+        """
+        Parse `forge coverage` arguments and return CoverageArguments object.
+
+        Args:
+            args: Argument strings after "coverage". If None, uses sys.argv[2:].
+
+        Returns:
+            CoverageArguments object with parsed values.
+
+        Raises:
+            SystemExit: If parsing fails or --help/--version is used.
+        """
+        return super().parse(sys.argv[2:] if args is None else args)
+
+    def _build_arguments(
+        self, parsed: argparse.Namespace, collected: Dict[str, List[str]]
+    ) -> CoverageArguments:
+        """
+        Convert parsed arguments to a CoverageArguments object.
+
+        Args:
+            parsed: Namespace from argparse
+            collected: Values of SPECIAL_ARGS options
+
+        Returns:
+            CoverageArguments object with parsed values.
+        """
+        if parsed.jobs is not None and parsed.jobs < 1:
+            self.parser.error("--jobs must be at least 1")
+
+        base = super()._build_arguments(parsed, collected)
+        return CoverageArguments(
+            **vars(base),
+            toolchain=parsed.toolchain,
+            jobs=parsed.jobs,
+            ctest_args=collected["--ctest-args"],
+            anvil_database=(
+                Path(parsed.anvil_database).expanduser().resolve()
+                if parsed.anvil_database
+                else None
+            ),
+            commit=parsed.commit,
+            record=parsed.record,
+        )
+
+
+class TimeTraceArgumentParser(ArgumentParser):
+    """
+    Parser for `forge time-trace` arguments.
+
+    Accepts every build argument plus the profiling options and returns a
+    TimeTraceArguments object.
+    """
+
+    PROG = "forge time-trace"
+    DESCRIPTION = "Forge - Build with Clang -ftime-trace and report template instantiation costs"
+
+    FORGE_FLAGS = ArgumentParser.FORGE_FLAGS | {"--jobs", "--granularity", "--top"}
+
+    def _add_arguments(self):
+        """Add build arguments and profiling options to the parser."""
+        super()._add_arguments()
+
+        self.parser.add_argument(
+            "--jobs",
+            type=int,
+            default=None,
+            help="Parallel trace parsing processes (default: CPU count)",
+        )
+
+        self.parser.add_argument(
+            "--granularity",
+            type=int,
+            default=500,
+            help="Shortest instantiation traced, in microseconds (default: 500)",
+        )
+
+        self.parser.add_argument(
+            "--top",
+            type=int,
+            default=20,
+            help="Templates and instantiations to print (default: 20)",
+        )
+
+    def parse(self, args: Optional[List[str]] = None) -> TimeTraceArguments:
+        """
+        Parse `forge time-trace` arguments and return TimeTraceArguments object.
+
+        Args:
+            args: Argument strings after "time-trace". If None, uses sys.argv[2:].
+
+        Returns:
+            TimeTraceArguments object with parsed values.
+
+        Raises:
+            SystemExit: If parsing fails or --help/--version is used.
+        """
+        return super().parse(sys.argv[2:] if args is None else args)
+
+    def _build_arguments(
+        self, parsed: argparse.Namespace, collected: Dict[str, List[str]]
+    ) -> TimeTraceArguments:
+        """
+        Convert parsed arguments to a TimeTraceArguments object.
+
+        Args:
+            parsed: Namespace from argparse
+            collected: Values of SPECIAL_ARGS options
+
+        Returns:
+            TimeTraceArguments object with parsed values.
+        """
+        if parsed.jobs is not None and parsed.jobs < 1:
+            self.parser.error("--jobs must be at least 1")
+        if parsed.granularity < 0:
+            self.parser.error("--granularity must not be negative")
+        if parsed.top < 1:
+            self.parser.error("--top must be at least 1")
+
+        base = super()._build_arguments(parsed, collected)
+        return TimeTraceArguments(
+            **vars(base),
+            jobs=parsed.jobs,
+            granularity=parsed.granularity,
+            top=parsed.top,
+        )
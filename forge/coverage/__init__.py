@@ -0,0 +1,23 @@
+"""
+Coverage collection for forge-built C++ targets.
+
+Builds with gcc (--coverage) or LLVM source-based (-fprofile-instr-generate
+-fcoverage-mapping) instrumentation, runs the tests and merges the .gcda or
+.profraw counters in parallel into an lcov report that Anvil records.
+"""
+
+from forge.coverage.collector import (
+    COVERAGE_FLAGS,
+    CoverageCollector,
+    CoverageError,
+    detect_toolchain,
+    record_in_anvil,
+)
+
+__all__ = [
+    "COVERAGE_FLAGS",
+    "CoverageCollector",
+    "CoverageError",
+    "detect_toolchain",
+    "record_in_anvil",
+]
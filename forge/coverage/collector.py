@@ -0,0 +1,482 @@
+"""
+CoverageCollector class for instrumented builds and parallel counter merging.
+
+Processing coverage counters one translation unit (gcov) or one test process
+(llvm-profdata) at a time can take longer than the tests themselves. The
+counter files are sharded by directory, each shard is processed by its own
+gcov or llvm-profdata process, and the shard results are combined at the end:
+
+- gcc: gcov --json-format --stdout per shard, converted to lcov records.
+  Headers seen by several translation units get one record per unit; Anvil's
+  coverage parser merges them.
+- llvm: llvm-profdata merge per shard, a final merge of the shard profiles,
+  then one llvm-cov export -format=lcov over the test binaries.
+"""
+
+from collections import defaultdict
+from concurrent.futures import ThreadPoolExecutor
+import json
+import logging
+import os
+from pathlib import Path
+import re
+import shutil
+import subprocess
+from typing import Callable, Dict, Iterable, Iterator, List, Mapping, Optional, Tuple
+
+from forge.utils.tracing import span
+
+logger = logging.getLogger(__name__)
+
+# Compiler and linker flags per instrumentation toolchain
+COVERAGE_FLAGS = {
+    "gcc": "--coverage",
+    "llvm": "-fprofile-instr-generate -fcoverage-mapping",
+}
+
+# CMake cache variables that receive the coverage flags
+FLAG_VARIABLES = (
+    "CMAKE_C_FLAGS",
+    "CMAKE_CXX_FLAGS",
+    "CMAKE_EXE_LINKER_FLAGS",
+    "CMAKE_SHARED_LINKER_FLAGS",
+)
+
+# Counter files written by instrumented binaries
+COUNTER_SUFFIXES = {"gcc": ".gcda", "llvm": ".profraw"}
+
+# Shared libraries may carry coverage mapping of code the tests exercised
+_SHARED_LIBRARY = re.compile(r"\.(so(\.\d+)*|dylib|dll)$")
+
+Runner = Callable[..., subprocess.CompletedProcess]
+
+
+class CoverageError(Exception):
+    """Exception raised when coverage cannot be collected or recorded."""
+
+
+def detect_toolchain(
+    parameters: Mapping[str, str],
+    build_dir: Path,
+    environ: Optional[Mapping[str, str]] = None,
+) -> str:
+    """
+    Pick the coverage toolchain from the C++ compiler that will be used.
+
+    Looks at -DCMAKE_CXX_COMPILER, then the compiler id in an existing
+    CMakeCache.txt, then the CXX environment variable.
+
+    Args:
+        parameters: CMake -D parameters of the configure step
+        build_dir: Build directory (may hold a CMakeCache.txt)
+        environ: Environment (defaults to os.environ)
+
+    Returns:
+        "llvm" for Clang, otherwise "gcc"
+    """
+    environ = os.environ if environ is None else environ
+    compiler = parameters.get("CMAKE_CXX_COMPILER")
+
+    if not compiler:
+        cache = build_dir / "CMakeCache.txt"
+        if cache.exists():
+            with open(cache, encoding="utf-8", errors="replace") as f:
+                for line in f:
+                    if line.startswith("CMAKE_CXX_COMPILER_ID:"):
+                        compiler = line.split("=", 1)[-1].strip()
+                        break
+
+    compiler = compiler or environ.get("CXX", "")
+    return "llvm" if "clang" in Path(compiler).name.lower() else "gcc"
+
+
+def shard_by_directory(files: Iterable[Path], jobs: int) -> List[List[Path]]:
+    """
+    Split counter files into shards of one directory each.
+
+    Directories holding more than their share of the files are split
+    further, so one large directory does not serialize the merge.
+
+    Args:
+        files: Counter files
+        jobs: Number of parallel workers
+
+    Returns:
+        Non-empty shards, each within a single directory
+    """
+    by_dir: Dict[Path, List[Path]] = defaultdict(list)
+    total = 0
+    for path in files:
+        by_dir[path.parent].append(path)
+        total += 1
+
+    limit = max(1, -(-total // max(1, jobs)))
+    shards = []
+    for directory in sorted(by_dir):
+        members = sorted(by_dir[directory])
+        shards.extend(members[i : i + limit] for i in range(0, len(members), limit))
+    return shards
+
+
+class CoverageCollector:  # pylint: disable=too-many-instance-attributes
+    """
+    Configures instrumentation, runs tests and collects coverage.
+
+    Args:
+        toolchain: "gcc" or "llvm"
+        build_dir: Dedicated coverage build directory
+        source_dir: Source directory; only files below it are reported
+        jobs: Parallel workers (default: CPU count)
+        runner: subprocess.run compatible callable (replaceable in tests)
+
+    Attributes:
+        output_dir: Directory for profiles and the lcov report
+        gcov: gcov executable
+        llvm_profdata: llvm-profdata executable
+        llvm_cov: llvm-cov executable
+    """
+
+    def __init__(
+        self,
+        toolchain: str,
+        build_dir: Path,
+        source_dir: Optional[Path] = None,
+        jobs: Optional[int] = None,
+        runner: Runner = subprocess.run,
+    ):
+        """Initialize CoverageCollector."""
+        if toolchain not in COVERAGE_FLAGS:
+            raise CoverageError(f"Unknown coverage toolchain: {toolchain}")
+        self.toolchain = toolchain
+        self.build_dir = Path(build_dir).resolve()
+        self.source_dir = Path(source_dir).resolve() if source_dir else None
+        self.jobs = jobs or os.cpu_count() or 1
+        self.runner = runner
+        self.output_dir = self.build_dir / "coverage"
+        self.gcov = "gcov"
+        self.llvm_profdata = "llvm-profdata"
+        self.llvm_cov = "llvm-cov"
+
+    @property
+    def report_path(self) -> Path:
+        """Path of the lcov report written by collect()."""
+        return self.output_dir / "coverage.info"
+
+    def configure_parameters(self, parameters: Mapping[str, str]) -> Dict[str, str]:
+        """
+        Get CMake parameters that add the coverage flags.
+
+        Flags already given with -D are kept; the coverage flags are appended.
+
+        Args:
+            parameters: Current -D parameters
+
+        Returns:
+            Parameters to add to the configure command
+        """
+        flags = COVERAGE_FLAGS[self.toolchain]
+        added = {
+            name: f"{parameters[name]} {flags}" if parameters.get(name) else flags
+            for name in FLAG_VARIABLES
+        }
+        if "CMAKE_BUILD_TYPE" not in parameters:
+            # Optimized code maps poorly back to source lines
+            added["CMAKE_BUILD_TYPE"] = "Debug"
+        return added
+
+    def _iter_counter_files(self) -> Iterator[Path]:
+        """Find the counter files of the toolchain in the build directory."""
+        suffix = COUNTER_SUFFIXES[self.toolchain]
+        for dirpath, _, filenames in os.walk(self.build_dir):
+            for name in filenames:
+                if name.endswith(suffix):
+                    yield Path(dirpath) / name
+
+    def reset_counters(self) -> int:
+        """
+        Delete counters left by earlier test runs.
+
+        gcc adds to existing .gcda files, so stale counters would be reported
+        as coverage of this run.
+
+        Returns:
+            Number of files deleted
+        """
+        removed = 0
+        for path in list(self._iter_counter_files()):
+            path.unlink()
+            removed += 1
+        shutil.rmtree(self.output_dir, ignore_errors=True)
+        return removed
+
+    def test_environment(self) -> Dict[str, str]:
+        """
+        Get the environment for the test run.
+
+        Returns:
+            os.environ plus LLVM_PROFILE_FILE (llvm) so every test process
+            writes its own raw profile into the coverage directory
+        """
+        env = dict(os.environ)
+        if self.toolchain == "llvm":
+            env["LLVM_PROFILE_FILE"] = str(self.output_dir / "profraw" / "%p-%m.profraw")
+        return env
+
+    def test_command(self, ctest_args: Optional[List[str]] = None) -> List[str]:
+        """
+        Generate the ctest command.
+
+        Args:
+            ctest_args: Extra ctest arguments
+
+        Returns:
+            Command to run in the build directory
+        """
+        return ["ctest", "--output-on-failure", "-j", str(self.jobs), *(ctest_args or [])]
+
+    def run_tests(self, ctest_args: Optional[List[str]] = None) -> int:
+        """
+        Run the tests of the build with output shown on the console.
+
+        Args:
+            ctest_args: Extra ctest arguments
+
+        Returns:
+            ctest exit code
+
+        Raises:
+            CoverageError: If ctest is not installed
+        """
+        try:
+            return self.runner(
+                self.test_command(ctest_args),
+                cwd=str(self.build_dir),
+                env=self.test_environment(),
+                check=False,
+            ).returncode
+        except FileNotFoundError as e:
+            raise CoverageError("ctest not found. Please ensure it's in your PATH.") from e
+
+    def _run(self, command: List[str], **kwargs) -> subprocess.CompletedProcess:
+        """Run a coverage tool, raising CoverageError when it fails."""
+        kwargs.setdefault("stdout", subprocess.PIPE)
+        try:
+            with span("forge.coverage.tool", tool=command[0], args=len(command)):
+                result = self.runner(command, stderr=subprocess.PIPE, check=False, **kwargs)
+        except FileNotFoundError as e:
+            raise CoverageError(f"{command[0]} not found. Please ensure it's in your PATH.") from e
+        if result.returncode != 0:
+            stderr = (result.stderr or b"").decode("utf-8", errors="replace").strip()
+            raise CoverageError(f"{command[0]} failed with exit code {result.returncode}: {stderr}")
+        return result
+
+    def _map_shards(self, worker: Callable, shards: List[List[Path]]) -> List:
+        """Run a worker over the shards on a thread pool, keeping shard order."""
+        if len(shards) == 1:
+            return [worker(0, shards[0])]
+        with ThreadPoolExecutor(max_workers=min(self.jobs, len(shards))) as pool:
+            return list(pool.map(worker, range(len(shards)), shards))
+
+    def _is_reported(self, path: str) -> bool:
+        """Check whether a source file belongs in the report."""
+        if self.source_dir is None:
+            return not path.startswith(str(self.build_dir) + os.sep)
+        return path.startswith(str(self.source_dir) + os.sep) and not path.startswith(
+            str(self.build_dir) + os.sep
+        )
+
+    def collect(self) -> Path:
+        """
+        Merge the counters of the last test run into an lcov report.
+
+        Returns:
+            Path of the lcov report
+
+        Raises:
+            CoverageError: If no counters were written or a tool fails
+        """
+        self.output_dir.mkdir(parents=True, exist_ok=True)
+        counters = list(self._iter_counter_files())
+        if not counters:
+            suffix = COUNTER_SUFFIXES[self.toolchain]
+            raise CoverageError(
+                f"No {suffix} files found in {self.build_dir}. "
+                f"Were the targets built with coverage flags and the tests run?"
+            )
+
+        shards = shard_by_directory(counters, self.jobs)
+        logger.info(
+            f"Merging {len(counters)} {COUNTER_SUFFIXES[self.toolchain]} files "
+            f"in {len(shards)} shards"
+        )
+        if self.toolchain == "gcc":
+            self._collect_gcov(shards)
+        else:
+            self._collect_llvm(shards)
+        return self.report_path
+
+    # gcc / gcov
+
+    def _gcov_shard(self, _index: int, files: List[Path]) -> str:
+        """Run gcov over one directory's .gcda files and convert to lcov."""
+        directory = files[0].parent
+        result = self._run(
+            [self.gcov, "--json-format", "--stdout", "--object-directory", str(directory)]
+            + [f.name for f in files],
+            cwd=str(directory),
+        )
+        return "".join(self._gcov_json_to_lcov(result.stdout.splitlines()))
+
+    def _gcov_json_to_lcov(self, documents: Iterable[bytes]) -> Iterator[str]:
+        """
+        Convert gcov JSON documents (one per .gcda file) to lcov records.
+
+        Args:
+            documents: gcov --json-format --stdout output lines
+
+        Yields:
+            lcov SF/DA/end_of_record blocks
+        """
+        for document in documents:
+            if not document.strip():
+                continue
+            data = json.loads(document)
+            cwd = data.get("current_working_directory", "")
+            for entry in data.get("files", []):
+                path = os.path.normpath(os.path.join(cwd, entry["file"]))
+                if not self._is_reported(path):
+                    continue
+                # Inlined and template code yields several entries per line
+                counts: Dict[int, int] = defaultdict(int)
+                for line in entry.get("lines", []):
+                    counts[line["line_number"]] += line["count"]
+                records = "".join(f"DA:{n},{counts[n]}\n" for n in sorted(counts))
+                yield f"SF:{path}\n{records}end_of_record\n"
+
+    def _collect_gcov(self, shards: List[List[Path]]) -> None:
+        """Process .gcda shards in parallel and write the lcov report."""
+        with open(self.report_path, "w", encoding="utf-8") as report:
+            for records in self._map_shards(self._gcov_shard, shards):
+                report.write(records)
+
+    # llvm / llvm-profdata / llvm-cov
+
+    def _profdata_merge(self, inputs: List[Path], output: Path) -> Path:
+        """Merge raw or indexed profiles, passing inputs in a file list."""
+        input_list = output.with_suffix(".inputs")
+        input_list.write_text("".join(f"{p}\n" for p in inputs), encoding="utf-8")
+        self._run(
+            [
+                self.llvm_profdata,
+                "merge",
+                "-sparse",
+                f"--input-files={input_list}",
+                "-o",
+                str(output),
+            ]
+        )
+        return output
+
+    def _test_binaries(self) -> List[Path]:
+        """
+        Find the instrumented binaries: test executables ctest knows about
+        plus shared libraries built in the tree.
+        """
+        result = self._run(["ctest", "--show-only=json-v1"], cwd=str(self.build_dir))
+        binaries: Dict[Path, None] = {}
+        for test in json.loads(result.stdout or b"{}").get("tests", []):
+            command = test.get("command") or []
+            if command:
+                path = Path(command[0])
+                if path.is_file() and self.build_dir in path.resolve().parents:
+                    binaries[path.resolve()] = None
+        for dirpath, _, filenames in os.walk(self.build_dir):
+            for name in filenames:
+                if _SHARED_LIBRARY.search(name):
+                    binaries[Path(dirpath) / name] = None
+        return list(binaries)
+
+    def _collect_llvm(self, shards: List[List[Path]]) -> None:
+        """Merge .profraw shards in parallel and export the lcov report."""
+        shard_dir = self.output_dir / "shards"
+        shard_dir.mkdir(parents=True, exist_ok=True)
+        profile = self.output_dir / "coverage.profdata"
+
+        if len(shards) == 1:
+            self._profdata_merge(shards[0], profile)
+        else:
+            merged = self._map_shards(
+                lambda i, files: self._profdata_merge(files, shard_dir / f"shard-{i}.profdata"),
+                shards,
+            )
+            self._profdata_merge(merged, profile)
+
+        binaries = self._test_binaries()
+        if not binaries:
+            raise CoverageError(f"No test executables found for llvm-cov in {self.build_dir}")
+
+        command = [
+            self.llvm_cov,
+            "export",
+            "-format=lcov",
+            f"-instr-profile={profile}",
+            f"-num-threads={self.jobs}",
+            f"-ignore-filename-regex=^{re.escape(str(self.build_dir))}/",
+            str(binaries[0]),
+        ]
+        for binary in binaries[1:]:
+            command.extend(["-object", str(binary)])
+        if self.source_dir is not None:
+            command.append(str(self.source_dir))
+
+        with open(self.report_path, "wb") as report:
+            self._run(command, stdout=report)
+
+
+def record_in_anvil(
+    report: Path,
+    repo_dir: Path,
+    database_path: Path,
+    commit: Optional[str] = "HEAD",
+) -> Tuple[str, object]:
+    """
+    Record an lcov report in Anvil's coverage_summary/coverage_history tables.
+
+    When the commit cannot be resolved (e.g. the sources are not in a git
+    repository) the run is recorded without one.
+
+    Args:
+        report: lcov report written by CoverageCollector.collect()
+        repo_dir: Directory inside the git repository the coverage is of
+        database_path: Anvil history database
+        commit: Commit to record the run for (None if not in a git repository)
+
+    Returns:
+        Tuple of (execution_id, CoverageData)
+
+    Raises:
+        CoverageError: If Anvil is not installed
+    """
+    try:
+        from anvil.core.patch_coverage import PatchCoverageEngine
+        from anvil.git.staged import StagedContentError
+        from anvil.parsers.coverage_parser import CoverageParser
+        from anvil.storage.execution_schema import ExecutionDatabase
+    except ImportError as e:
+        raise CoverageError(
+            "Anvil is not installed; install it with: pip install -e path/to/anvil"
+        ) from e
+
+    coverage = CoverageParser().parse(str(report), format="lcov")
+    database_path.parent.mkdir(parents=True, exist_ok=True)
+    db = ExecutionDatabase(str(database_path))
+    try:
+        engine = PatchCoverageEngine(repo_dir, db)
+        try:
+            execution_id = engine.record(coverage, commit=commit)
+        except StagedContentError as e:
+            logger.warning(f"Recording coverage without a commit: {e}")
+            execution_id = engine.record(coverage, commit=None)
+    finally:
+        db.close()
+    return execution_id, coverage
@@ -10,7 +10,7 @@ This module provides functionality for:
 
 from pathlib import Path, PureWindowsPath
 import re
-from typing import List, Optional, Union
+from typing import Iterator, List, Optional, Union
 
 from forge.models.metadata import (
     BuildMetadata,
@@ -20,6 +20,11 @@ from forge.models.metadata import (
     Error,
 )
 
+try:
+    from anvil.parsers.log_scan import select_lines, strip_ansi
+except ImportError:  # pragma: no cover - Anvil is optional
+    select_lines = strip_ansi = None
+
 
 class BuildInspector:
     """
@@ -309,7 +314,7 @@ class BuildInspector:
         # or: ld: warning: message
         generic_pattern = r"^(?:\w+:\s+)?warning:\s*(.+)"
 
-        for line in clean_output.splitlines():
+        for line in self._lines_containing(clean_output, "warning"):
             line = line.strip()
 
             # Try GCC/Clang format
@@ -400,7 +405,7 @@ class BuildInspector:
         # MSVC fatal: file.cpp(10): fatal error C1083: message
         msvc_pattern = r"^(.+?)\((\d+)(?:,(\d+))?\)\s*:\s*(?:fatal\s+)?error\s+(C\d+):\s*(.+)"
 
-        for line in clean_output.splitlines():
+        for line in self._lines_containing(clean_output, "error"):
             line = line.strip()
 
             # Try GCC/Clang format
@@ -443,11 +448,35 @@ class BuildInspector:
         Returns:
             Text with ANSI codes removed
         """
+        if strip_ansi is not None:
+            return strip_ansi(text, sgr_only=True)
+
         # Pattern matches: ESC [ ... m
         # Where ESC is \033 or \x1b
         ansi_pattern = r"\033\[[0-9;]*m"
         return re.sub(ansi_pattern, "", text)
 
+    def _lines_containing(self, text: str, needle: str) -> Iterator[str]:
+        """
+        Lines of text that may contain needle, split as str.splitlines() does.
+
+        Every warning and error pattern contains its keyword, so only the
+        newline-delimited lines holding it need to be split and matched. On
+        large build logs this skips almost all of the output.
+
+        Args:
+            text: Build output without ANSI codes
+            needle: Keyword every matching line contains
+
+        Yields:
+            Lines of text, a superset of those containing needle
+        """
+        if select_lines is None:
+            yield from text.splitlines()
+            return
+        for start, end in select_lines(text, (needle,)):
+            yield from text[start:end].splitlines()
+
     def _deduplicate_warnings(self, warnings: List[BuildWarning]) -> List[BuildWarning]:
         """
         Remove duplicate warnings based on file, line, and message.
@@ -4,7 +4,7 @@ Forge data models package.
 Contains all dataclasses for representing build arguments, results, and metadata.
 """
 
-from forge.models.arguments import ForgeArguments
+from forge.models.arguments import CoverageArguments, ForgeArguments, TimeTraceArguments
 from forge.models.metadata import (
     BuildMetadata,
     BuildWarning,
@@ -15,6 +15,8 @@ from forge.models.results import BuildResult, ConfigureResult
 
 __all__ = [
     "ForgeArguments",
+    "CoverageArguments",
+    "TimeTraceArguments",
     "ConfigureResult",
     "BuildResult",
     "ConfigureMetadata",
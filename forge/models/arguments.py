@@ -85,3 +85,49 @@ class ForgeArguments:  # pylint: disable=too-many-instance-attributes
             data["database_path"] = Path(data["database_path"])
 
         return cls(**data)
+
+
+@dataclass
+class CoverageArguments(ForgeArguments):  # pylint: disable=too-many-instance-attributes
+    """
+    Arguments of `forge coverage`: a build plus instrumented test run.
+
+    Attributes:
+        toolchain: Coverage instrumentation, "gcc" (gcov), "llvm" (source-based
+            llvm-cov) or "auto" (from the configured compiler)
+        jobs: Parallel collection workers (None uses the CPU count)
+        ctest_args: Extra arguments passed to ctest
+        anvil_database: Anvil history database receiving the coverage run
+            (default: <source_dir>/.anvil/history.db)
+        commit: Git commit the coverage run is recorded for
+        record: Whether to record the run in the Anvil database
+    """
+
+    toolchain: str = "auto"
+    jobs: Optional[int] = None
+    ctest_args: List[str] = field(default_factory=list)
+    anvil_database: Optional[Path] = None
+    commit: str = "HEAD"
+    record: bool = True
+
+    def __post_init__(self):
+        """Convert string paths to Path objects."""
+        super().__post_init__()
+        if self.anvil_database and isinstance(self.anvil_database, str):
+            self.anvil_database = Path(self.anvil_database)
+
+
+@dataclass
+class TimeTraceArguments(ForgeArguments):
+    """
+    Arguments of `forge time-trace`: a build compiled with Clang's -ftime-trace.
+
+    Attributes:
+        jobs: Parallel trace parsing processes (None uses the CPU count)
+        granularity: Shortest traced instantiation in microseconds
+        top: Templates and instantiations printed per kind
+    """
+
+    jobs: Optional[int] = None
+    granularity: int = 500
+    top: int = 20
@@ -0,0 +1,29 @@
+"""
+Compile-time profiling for forge-built C++ targets.
+
+Builds with Clang's -ftime-trace and aggregates the per translation unit
+traces in parallel into the costliest templates and instantiations, which
+are stored per build so template-heavy changes show their compile-time cost.
+"""
+
+from forge.profiling.time_trace import (
+    DEFAULT_GRANULARITY_US,
+    STORED_COSTS,
+    TemplateCost,
+    TimeTraceCollector,
+    TimeTraceError,
+    TimeTraceReport,
+    summarize_trace,
+    template_name,
+)
+
+__all__ = [
+    "DEFAULT_GRANULARITY_US",
+    "STORED_COSTS",
+    "TemplateCost",
+    "TimeTraceCollector",
+    "TimeTraceError",
+    "TimeTraceReport",
+    "summarize_trace",
+    "template_name",
+]
@@ -0,0 +1,353 @@
+"""
+TimeTraceCollector class for template instantiation profiling with Clang.
+
+Compiled with -ftime-trace, Clang writes a Chrome trace next to every object
+file (main.cpp.o -> main.cpp.json) holding an InstantiateClass or
+InstantiateFunction event per template instantiation that took longer than
+-ftime-trace-granularity. The traces of all translation units are parsed in
+parallel worker processes and aggregated into the costliest templates and
+instantiations:
+
+- instantiation: one specialization, e.g. "scale::max<int>"; its time
+  includes the instantiations it triggers, as Clang reports it.
+- template: every specialization of a template, e.g. "scale::max<$>"; a
+  recursive template's time is counted once per outermost instantiation,
+  not once per nesting level.
+
+Each cost has its total time, the number of instantiations and the number of
+translation units that instantiated it.
+"""
+
+from collections import Counter
+from concurrent.futures import ProcessPoolExecutor
+from dataclasses import dataclass, field
+import json
+import logging
+import os
+from pathlib import Path
+from typing import Callable, Dict, Iterator, List, Mapping, Optional, Tuple
+
+logger = logging.getLogger(__name__)
+
+# Clang's default granularity: instantiations shorter than this are not traced
+DEFAULT_GRANULARITY_US = 500
+
+# Trace events of template instantiations
+INSTANTIATION_EVENTS = frozenset({"InstantiateClass", "InstantiateFunction"})
+
+# Costs kept per kind when a profile is stored
+STORED_COSTS = 200
+
+# Operators whose name contains angle brackets, longest first
+OPERATOR_TOKENS = ("<=>", "<<=", ">>=", "<<", ">>", "<=", ">=", "<", ">")
+
+# Object file suffixes a trace file sits next to
+OBJECT_SUFFIXES = (".o", ".obj")
+
+Executor = Callable[..., ProcessPoolExecutor]
+
+
+class TimeTraceError(Exception):
+    """Exception raised when time traces cannot be collected."""
+
+
+def template_name(detail: str) -> str:
+    """
+    Name of the template an instantiation belongs to.
+
+    Template argument lists are replaced with "$", so every specialization
+    of a template maps to the same name.
+
+    Args:
+        detail: Instantiation as Clang prints it, e.g. "std::vector<int>::push_back"
+
+    Returns:
+        Template name, e.g. "std::vector<$>::push_back"
+    """
+    out: List[str] = []
+    depth = 0
+    i = 0
+    while i < len(detail):
+        char = detail[i]
+        if depth == 0 and char in "<>" and "".join(out[-8:]).endswith("operator"):
+            # operator<, operator<<= etc. are names, not argument lists
+            token = next(op for op in OPERATOR_TOKENS if detail.startswith(op, i))
+            out.append(token)
+            i += len(token)
+            continue
+        if char == "<":
+            if depth == 0:
+                out.append("<$>")
+            depth += 1
+        elif char == ">" and depth:
+            depth -= 1
+        elif depth == 0:
+            out.append(char)
+        i += 1
+    return "".join(out)
+
+
+@dataclass
+class TraceSummary:
+    """
+    Instantiation costs of one translation unit.
+
+    Attributes:
+        path: Trace file
+        compile_us: Time of the whole compiler invocation
+        instantiation_us: Time spent in outermost instantiations
+        instantiations: Total time and count per instantiation
+        templates: Total time and count per template
+    """
+
+    path: str
+    compile_us: int = 0
+    instantiation_us: int = 0
+    instantiations: Dict[str, List[int]] = field(default_factory=dict)
+    templates: Dict[str, List[int]] = field(default_factory=dict)
+
+
+def summarize_trace(path: Path) -> Optional[TraceSummary]:
+    """
+    Read the instantiation costs of one Clang time trace.
+
+    Args:
+        path: Trace file written by -ftime-trace
+
+    Returns:
+        Summary, or None if the file is not a readable Chrome trace
+    """
+    try:
+        data = json.loads(Path(path).read_bytes())
+    except (OSError, ValueError):
+        return None
+    events = data.get("traceEvents") if isinstance(data, dict) else None
+    if not isinstance(events, list):
+        return None
+
+    summary = TraceSummary(str(path))
+    spans: List[Tuple[int, int, str]] = []
+    for event in events:
+        if not isinstance(event, dict) or event.get("ph") != "X":
+            continue
+        name = event.get("name")
+        if name == "ExecuteCompiler":
+            summary.compile_us = max(summary.compile_us, int(event.get("dur", 0)))
+        elif name in INSTANTIATION_EVENTS:
+            detail = (event.get("args") or {}).get("detail")
+            if detail:
+                spans.append((int(event.get("ts", 0)), int(event.get("dur", 0)), detail))
+
+    # Parents start no later and last longer than the instantiations they trigger
+    spans.sort(key=lambda span: (span[0], -span[1]))
+    stack: List[Tuple[int, str]] = []
+    open_templates: Counter = Counter()
+    for start, duration, detail in spans:
+        while stack and stack[-1][0] <= start:
+            open_templates[stack.pop()[1]] -= 1
+        template = template_name(detail)
+
+        cost = summary.instantiations.setdefault(detail, [0, 0])
+        cost[0] += duration
+        cost[1] += 1
+        cost = summary.templates.setdefault(template, [0, 0])
+        if not open_templates[template]:
+            cost[0] += duration
+        cost[1] += 1
+        if not stack:
+            summary.instantiation_us += duration
+
+        stack.append((start + duration, template))
+        open_templates[template] += 1
+    return summary
+
+
+@dataclass
+class TemplateCost:
+    """
+    Compile-time cost of a template or instantiation across a build.
+
+    Attributes:
+        kind: "template" or "instantiation"
+        name: Template name ("max<$>") or instantiation ("max<int>")
+        total_ms: Total instantiation time in milliseconds
+        count: Number of instantiations
+        translation_units: Number of translation units instantiating it
+    """
+
+    kind: str
+    name: str
+    total_ms: float
+    count: int
+    translation_units: int
+
+    def to_dict(self) -> Dict:
+        """Convert to a JSON-serializable dictionary."""
+        return {
+            "kind": self.kind,
+            "name": self.name,
+            "total_ms": self.total_ms,
+            "count": self.count,
+            "translation_units": self.translation_units,
+        }
+
+
+@dataclass
+class TimeTraceReport:
+    """
+    Instantiation costs aggregated over every traced translation unit.
+
+    Attributes:
+        translation_units: Number of traces aggregated
+        compile_ms: Total compiler time in milliseconds
+        instantiation_ms: Total time in outermost instantiations
+        templates: Costs per template, costliest first
+        instantiations: Costs per instantiation, costliest first
+    """
+
+    translation_units: int = 0
+    compile_ms: float = 0.0
+    instantiation_ms: float = 0.0
+    templates: List[TemplateCost] = field(default_factory=list)
+    instantiations: List[TemplateCost] = field(default_factory=list)
+
+    def costs(self, limit: Optional[int] = None) -> List[TemplateCost]:
+        """
+        Costliest templates and instantiations.
+
+        Args:
+            limit: Costs to keep per kind (default: all)
+
+        Returns:
+            Template costs followed by instantiation costs
+        """
+        return self.templates[:limit] + self.instantiations[:limit]
+
+
+def aggregate(summaries: List[TraceSummary]) -> TimeTraceReport:
+    """
+    Combine per translation unit summaries into one report.
+
+    Args:
+        summaries: Summaries of the traced translation units
+
+    Returns:
+        Report with costs sorted by total time, then name
+    """
+    report = TimeTraceReport(translation_units=len(summaries))
+    merged: Dict[str, Dict[str, List[int]]] = {"template": {}, "instantiation": {}}
+    for summary in summaries:
+        report.compile_ms += summary.compile_us / 1000
+        report.instantiation_ms += summary.instantiation_us / 1000
+        for kind, costs in (
+            ("template", summary.templates),
+            ("instantiation", summary.instantiations),
+        ):
+            totals = merged[kind]
+            for name, (total_us, count) in costs.items():
+                entry = totals.setdefault(name, [0, 0, 0])
+                entry[0] += total_us
+                entry[1] += count
+                entry[2] += 1
+
+    for kind, totals in merged.items():
+        costs = [
+            TemplateCost(kind, name, total_us / 1000, count, units)
+            for name, (total_us, count, units) in totals.items()
+        ]
+        costs.sort(key=lambda cost: (-cost.total_ms, cost.name))
+        if kind == "template":
+            report.templates = costs
+        else:
+            report.instantiations = costs
+    return report
+
+
+class TimeTraceCollector:
+    """
+    Configures -ftime-trace builds and aggregates their traces.
+
+    Args:
+        build_dir: Build directory compiled with -ftime-trace
+        granularity: Shortest traced instantiation in microseconds
+        jobs: Parallel trace parsing processes (default: CPU count)
+        executor: ProcessPoolExecutor compatible factory (replaceable in tests)
+    """
+
+    def __init__(
+        self,
+        build_dir: Path,
+        granularity: int = DEFAULT_GRANULARITY_US,
+        jobs: Optional[int] = None,
+        executor: Executor = ProcessPoolExecutor,
+    ):
+        """Initialize TimeTraceCollector."""
+        self.build_dir = Path(build_dir).resolve()
+        self.granularity = granularity
+        self.jobs = jobs or os.cpu_count() or 1
+        self.executor = executor
+
+    @property
+    def flags(self) -> str:
+        """Compiler flags that write the traces."""
+        return f"-ftime-trace -ftime-trace-granularity={self.granularity}"
+
+    def configure_parameters(self, parameters: Mapping[str, str]) -> Dict[str, str]:
+        """
+        Get CMake parameters that add the time trace flags.
+
+        C++ flags already given with -D are kept; the trace flags are appended.
+
+        Args:
+            parameters: Current -D parameters
+
+        Returns:
+            Parameters to add to the configure command
+        """
+        flags = parameters.get("CMAKE_CXX_FLAGS")
+        return {"CMAKE_CXX_FLAGS": f"{flags} {self.flags}" if flags else self.flags}
+
+    def find_traces(self) -> Iterator[Path]:
+        """
+        Find the traces of the objects currently in the build directory.
+
+        A trace whose object file is gone (its source was removed) is skipped.
+
+        Yields:
+            Trace files
+        """
+        for dirpath, _, filenames in os.walk(self.build_dir):
+            names = set(filenames)
+            for name in filenames:
+                if not name.endswith(".json"):
+                    continue
+                stem = name[: -len(".json")]
+                if any(stem + suffix in names for suffix in OBJECT_SUFFIXES):
+                    yield Path(dirpath) / name
+
+    def collect(self) -> TimeTraceReport:
+        """
+        Parse every trace in parallel and aggregate the costs.
+
+        Returns:
+            Aggregated report
+
+        Raises:
+            TimeTraceError: If the build directory holds no traces
+        """
+        traces = sorted(self.find_traces())
+        if not traces:
+            raise TimeTraceError(
+                f"No -ftime-trace files found in {self.build_dir}. "
+                f"Was the build compiled with Clang and -ftime-trace?"
+            )
+
+        workers = min(self.jobs, len(traces))
+        logger.info(f"Aggregating {len(traces)} time traces with {workers} workers")
+        if workers == 1:
+            summaries = [summarize_trace(path) for path in traces]
+        else:
+            chunksize = max(1, len(traces) // (workers * 4))
+            with self.executor(max_workers=workers) as pool:
+                summaries = list(pool.map(summarize_trace, traces, chunksize=chunksize))
+        return aggregate([summary for summary in summaries if summary is not None])
@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+"""
+Generate a large synthetic CMake C++ project for Forge scaling benchmarks.
+
+Writes a project with the requested number of translation units, libraries,
+template headers and warnings (see forge/testing/project_generator.py),
+plus forge-scale.json listing what a full build must report. Optionally
+writes the synthesized Ninja output of a full build as well, for measuring
+output parsing without compiling.
+"""
+
+import argparse
+from pathlib import Path
+import sys
+
+# Make the forge package importable when run from the forge directory
+sys.path.insert(0, str(Path(__file__).resolve().parents[2]))
+
+from forge.testing.project_generator import ProjectSpec, generate_project  # noqa: E402
+
+
+def parse_args(argv=None) -> argparse.Namespace:
+    """Parse command line arguments."""
+    defaults = ProjectSpec()
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("output_dir", type=Path, help="Directory to write the project into")
+    parser.add_argument(
+        "--units",
+        type=int,
+        default=defaults.translation_units,
+        help=f"Translation units (default: {defaults.translation_units})",
+    )
+    parser.add_argument(
+        "--libraries",
+        type=int,
+        default=defaults.libraries,
+        help=f"Libraries (default: {defaults.libraries})",
+    )
+    parser.add_argument(
+        "--shared-fraction",
+        type=float,
+        default=defaults.shared_fraction,
+        help=f"Fraction of shared libraries (default: {defaults.shared_fraction})",
+    )
+    parser.add_argument(
+        "--headers",
+        type=int,
+        default=defaults.headers,
+        help=f"Template headers (default: {defaults.headers})",
+    )
+    parser.add_argument(
+        "--template-depth",
+        type=int,
+        default=defaults.template_depth,
+        help=f"Template recursion depth (default: {defaults.template_depth})",
+    )
+    parser.add_argument(
+        "--include-depth",
+        type=int,
+        default=defaults.include_depth,
+        help=f"Header include chain length (default: {defaults.include_depth})",
+    )
+    parser.add_argument(
+        "--warning-density",
+        type=float,
+        default=defaults.warning_density,
+        help=f"Warnings per translation unit (default: {defaults.warning_density})",
+    )
+    parser.add_argument(
+        "--build-output",
+        type=Path,
+        help="Also write the synthesized output of a full build to this file",
+    )
+    return parser.parse_args(argv)
+
+
+def main(argv=None) -> int:
+    """Generate the project and print a summary."""
+    args = parse_args(argv)
+    try:
+        spec = ProjectSpec(
+            translation_units=args.units,
+            libraries=args.libraries,
+            shared_fraction=args.shared_fraction,
+            headers=args.headers,
+            template_depth=args.template_depth,
+            include_depth=args.include_depth,
+            warning_density=args.warning_density,
+        )
+    except ValueError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 2
+
+    manifest = generate_project(args.output_dir, spec)
+    shared = sum(1 for library in manifest.libraries if library.kind == "SHARED")
+    print(f"Generated {manifest.root}")
+    print(f"  Translation units: {manifest.translation_units}")
+    print(f"  Libraries:         {len(manifest.libraries)} ({shared} shared)")
+    print(f"  Headers:           {len(manifest.headers)}")
+    print(f"  Expected warnings: {len(manifest.warnings)}")
+    for kind, count in manifest.warning_counts().items():
+        print(f"    {kind}: {count}")
+
+    if args.build_output:
+        args.build_output.write_text(manifest.synthesize_build_output(), encoding="utf-8")
+        print(f"  Build output:      {args.build_output}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -12,6 +12,7 @@ from typing import Dict, List, Optional
 
 from forge.models.metadata import BuildMetadata, ConfigureMetadata
 from forge.models.results import BuildResult, ConfigureResult
+from forge.utils.tracing import traced
 
 
 class DataPersistence:
@@ -148,6 +149,7 @@ class DataPersistence:
 
         return result[0]
 
+    @traced("forge.db.save_configuration")
     def save_configuration(self, result: ConfigureResult, metadata: ConfigureMetadata) -> int:
         """
         Save configuration result and metadata to database.
@@ -224,6 +226,7 @@ class DataPersistence:
             self._connection.rollback()
             raise RuntimeError(f"Failed to save configuration: {e}") from e
 
+    @traced("forge.db.save_build")
     def save_build(
         self, result: BuildResult, metadata: BuildMetadata, configuration_id: Optional[int]
     ) -> int:
@@ -301,6 +304,7 @@ class DataPersistence:
             self._connection.rollback()
             raise RuntimeError(f"Failed to save build: {e}") from e
 
+    @traced("forge.db.save_warnings")
     def save_warnings(self, build_id: int, warnings: list) -> int:
         """
         Save build warnings to database.
@@ -360,6 +364,7 @@ class DataPersistence:
             self._connection.rollback()
             raise RuntimeError(f"Failed to save warnings: {e}") from e
 
+    @traced("forge.db.save_errors")
     def save_errors(self, build_id: int, errors: list) -> int:
         """
         Save build errors to database.
@@ -419,6 +424,118 @@ class DataPersistence:
             self._connection.rollback()
             raise RuntimeError(f"Failed to save errors: {e}") from e
 
+    @traced("forge.db.save_template_costs")
+    def save_template_costs(self, build_id: int, costs: list) -> int:
+        """
+        Save template instantiation costs of a -ftime-trace build.
+
+        Args:
+            build_id: Build ID to associate costs with (foreign key).
+            costs: List of TemplateCost objects to save.
+
+        Returns:
+            Number of costs saved.
+
+        Raises:
+            RuntimeError: If database operation fails (e.g., invalid build_id).
+
+        Examples:
+            >>> count = persistence.save_template_costs(build_id, report.costs(200))
+        """
+        if not costs:
+            return 0
+
+        cursor = self._connection.cursor()
+
+        try:
+            cursor.executemany(
+                """
+                INSERT INTO template_costs (
+                    build_id, kind, name, total_ms, count, translation_units
+                )
+                VALUES (?, ?, ?, ?, ?, ?)
+                """,
+                [
+                    (build_id, c.kind, c.name, c.total_ms, c.count, c.translation_units)
+                    for c in costs
+                ],
+            )
+
+            self._connection.commit()
+            return len(costs)
+
+        except sqlite3.Error as e:
+            self._connection.rollback()
+            raise RuntimeError(f"Failed to save template costs: {e}") from e
+
+    def get_template_costs(
+        self, build_id: int, kind: Optional[str] = None, limit: Optional[int] = None
+    ) -> List[Dict]:
+        """
+        Retrieve template instantiation costs of a build, costliest first.
+
+        Args:
+            build_id: Build ID to retrieve costs for.
+            kind: Optional filter, "template" or "instantiation".
+            limit: Maximum number of costs to return (default: all).
+
+        Returns:
+            List of dictionaries with kind, name, total_ms, count and
+            translation_units.
+
+        Examples:
+            >>> persistence.get_template_costs(build_id, kind="template", limit=10)
+            [{'kind': 'template', 'name': 'std::vector<$>', 'total_ms': 812.5, ...}, ...]
+        """
+        query = """
+            SELECT kind, name, total_ms, count, translation_units
+            FROM template_costs
+            WHERE build_id = ? AND (? IS NULL OR kind = ?)
+            ORDER BY total_ms DESC, name
+            LIMIT ?
+        """
+        try:
+            cursor = self._connection.cursor()
+            cursor.execute(query, (build_id, kind, kind, -1 if limit is None else limit))
+            return [
+                {
+                    "kind": row[0],
+                    "name": row[1],
+                    "total_ms": row[2],
+                    "count": row[3],
+                    "translation_units": row[4],
+                }
+                for row in cursor.fetchall()
+            ]
+
+        except sqlite3.Error as e:
+            raise RuntimeError(f"Failed to retrieve template costs: {e}") from e
+
+    def get_previous_profiled_build(self, project_name: str, build_id: int) -> Optional[int]:
+        """
+        Find the latest earlier build of a project with template costs.
+
+        Args:
+            project_name: Project to search.
+            build_id: Build to look before.
+
+        Returns:
+            Build ID, or None if no earlier build was profiled.
+        """
+        query = """
+            SELECT MAX(b.id)
+            FROM builds b
+            WHERE b.project_name = ? AND b.id < ?
+              AND EXISTS (SELECT 1 FROM template_costs t WHERE t.build_id = b.id)
+        """
+        try:
+            cursor = self._connection.cursor()
+            cursor.execute(query, (project_name, build_id))
+            return cursor.fetchone()[0]
+
+        except sqlite3.Error as e:
+            raise RuntimeError(f"Failed to retrieve previous profiled build: {e}") from e
+
     def get_recent_builds(self, limit: int = 10, project_name: Optional[str] = None) -> List[Dict]:
         """
         Retrieve recent builds ordered by timestamp (newest first).
@@ -105,3 +105,19 @@ CREATE TABLE IF NOT EXISTS build_targets (
 
 CREATE INDEX IF NOT EXISTS idx_targets_build ON build_targets(build_id);
 CREATE INDEX IF NOT EXISTS idx_targets_name ON build_targets(target_name);
+
+-- Template instantiation costs from -ftime-trace builds
+CREATE TABLE IF NOT EXISTS template_costs (
+    id INTEGER PRIMARY KEY AUTOINCREMENT,
+    build_id INTEGER NOT NULL,
+    kind TEXT NOT NULL,
+    name TEXT NOT NULL,
+    total_ms REAL NOT NULL,
+    count INTEGER NOT NULL,
+    translation_units INTEGER NOT NULL,
+    created_at TEXT DEFAULT CURRENT_TIMESTAMP,
+    FOREIGN KEY (build_id) REFERENCES builds(id) ON DELETE CASCADE
+);
+
+CREATE INDEX IF NOT EXISTS idx_template_costs_build ON template_costs(build_id, kind);
+CREATE INDEX IF NOT EXISTS idx_template_costs_name ON template_costs(name);
@@ -0,0 +1,23 @@
+"""
+Test and benchmark helpers for Forge.
+
+Synthesizes CMake C++ projects far larger than the hand-written fixtures in
+tests/fixtures/projects, so configure time, build output parsing and
+persistence can be measured at scale.
+"""
+
+from forge.testing.project_generator import (
+    ExpectedWarning,
+    LibraryInfo,
+    ProjectManifest,
+    ProjectSpec,
+    generate_project,
+)
+
+__all__ = [
+    "ExpectedWarning",
+    "LibraryInfo",
+    "ProjectManifest",
+    "ProjectSpec",
+    "generate_project",
+]
@@ -0,0 +1,567 @@
+"""
+Synthetic large CMake C++ projects for measuring Forge at scale.
+
+The fixture projects in tests/fixtures/projects are a few lines each. This
+module writes projects of any size: thousands of translation units spread
+over static and shared libraries, deep template-heavy header chains built on
+an extended copy of header_only/template_utils.h, and a configurable density
+of compiler warnings.
+
+Every warning is placed deliberately (an unused variable, an unused
+parameter or a signed/unsigned comparison, all reported by GCC and Clang
+with -Wall -Wextra and by MSVC with /W4), so the manifest knows how many
+warnings of each kind a build must report. The manifest can also synthesize
+the Ninja/GCC output of a full build, so build output parsing and
+persistence can be measured without compiling anything.
+
+Generation is deterministic: the same spec always writes the same files.
+
+Example:
+    >>> spec = ProjectSpec(translation_units=2000, libraries=40)
+    >>> manifest = generate_project(Path("/tmp/scale"), spec)  # doctest: +SKIP
+    >>> manifest.warning_counts()  # doctest: +SKIP
+    {'unused-variable': 134, 'sign-compare': 133, 'unused-parameter': 133}
+"""
+
+from dataclasses import asdict, dataclass, field
+import json
+from pathlib import Path
+from typing import Any, Dict, List, Optional
+
+# Name of the manifest written at the root of a generated project
+MANIFEST_NAME = "forge-scale.json"
+
+GENERATED_NOTICE = "// Generated by forge.testing.project_generator; do not edit."
+
+# Injected warnings, in the order they are cycled through
+WARNING_KINDS = ("unused-variable", "sign-compare", "unused-parameter")
+
+SIGN_COMPARE_MESSAGE = (
+    "comparison of integer expressions of different signedness: 'int' and "
+    "'std::vector<int>::size_type' {aka 'long unsigned int'}"
+)
+
+TEMPLATE_UTILS = """\
+{notice}
+// Extends tests/fixtures/projects/header_only/template_utils.h.
+#ifndef SCALE_TEMPLATE_UTILS_H
+#define SCALE_TEMPLATE_UTILS_H
+
+namespace scale {{
+
+template <typename T>
+T max(T a, T b) {{
+    return (a > b) ? a : b;
+}}
+
+template <typename T>
+T min(T a, T b) {{
+    return (a < b) ? a : b;
+}}
+
+template <typename T>
+T clamp(T value, T low, T high) {{
+    return max(low, min(value, high));
+}}
+
+template <typename... Ts>
+auto sum(Ts... values) {{
+    return (values + ... + 0);
+}}
+
+template <typename T, int N>
+struct Power {{
+    static constexpr T of(T base) {{ return base * Power<T, N - 1>::of(base); }}
+}};
+
+template <typename T>
+struct Power<T, 0> {{
+    static constexpr T of(T) {{ return T(1); }}
+}};
+
+}}  // namespace scale
+
+#endif  // SCALE_TEMPLATE_UTILS_H
+"""
+
+
+@dataclass
+class ProjectSpec:
+    """
+    Shape of a generated project.
+
+    Attributes:
+        translation_units: Number of generated unit sources, spread evenly
+            over the libraries (each library also has one entry source and
+            the executable one main source)
+        libraries: Number of libraries; library i links library (i - 1) // 2
+        shared_fraction: Fraction of the libraries built as shared libraries
+        headers: Number of template headers
+        template_depth: Recursion depth each unit instantiates its header's
+            templates with
+        include_depth: Length of the chains of headers including each other
+        warning_density: Warnings per translation unit (may exceed 1)
+        name: CMake project name
+    """
+
+    translation_units: int = 1000
+    libraries: int = 20
+    shared_fraction: float = 0.25
+    headers: int = 50
+    template_depth: int = 16
+    include_depth: int = 8
+    warning_density: float = 0.2
+    name: str = "ForgeScale"
+
+    def __post_init__(self):
+        """
+        Validate the spec.
+
+        Raises:
+            ValueError: If a count or fraction is out of range
+        """
+        if self.translation_units < 1:
+            raise ValueError(f"translation_units must be at least 1: {self.translation_units}")
+        if not 1 <= self.libraries <= self.translation_units:
+            raise ValueError(
+                f"libraries must be between 1 and translation_units "
+                f"({self.translation_units}): {self.libraries}"
+            )
+        if not 0.0 <= self.shared_fraction <= 1.0:
+            raise ValueError(f"shared_fraction must be between 0 and 1: {self.shared_fraction}")
+        for name in ("headers", "template_depth", "include_depth"):
+            if getattr(self, name) < 1:
+                raise ValueError(f"{name} must be at least 1: {getattr(self, name)}")
+        if self.warning_density < 0:
+            raise ValueError(f"warning_density must not be negative: {self.warning_density}")
+
+
+@dataclass
+class LibraryInfo:
+    """
+    A generated library.
+
+    Attributes:
+        name: CMake target name
+        kind: "STATIC" or "SHARED"
+        units: Number of unit sources
+        dependency: Library it links, or None for the root library
+    """
+
+    name: str
+    kind: str
+    units: int
+    dependency: Optional[str] = None
+
+
+@dataclass
+class ExpectedWarning:
+    """
+    A warning deliberately placed in a generated source.
+
+    Attributes:
+        file: Source path relative to the project root
+        line: 1-based line
+        column: 1-based column GCC reports
+        message: GCC's wording of the warning
+        warning_type: Warning flag without -W, e.g. "unused-variable"
+        function: Function containing the warning
+        source_line: Text of the line
+    """
+
+    file: str
+    line: int
+    column: int
+    message: str
+    warning_type: str
+    function: str
+    source_line: str
+
+
+@dataclass
+class ProjectManifest:
+    """
+    What a generated project contains and what its build must report.
+
+    Attributes:
+        root: Project directory
+        spec: Spec the project was generated from
+        libraries: Generated libraries, in target order
+        headers: Header paths relative to the root
+        sources: Source paths relative to the root, in build order
+        warnings: Warnings a full build reports, in build order
+    """
+
+    root: Path
+    spec: ProjectSpec
+    libraries: List[LibraryInfo] = field(default_factory=list)
+    headers: List[str] = field(default_factory=list)
+    sources: List[str] = field(default_factory=list)
+    warnings: List[ExpectedWarning] = field(default_factory=list)
+
+    @property
+    def translation_units(self) -> int:
+        """Number of sources compiled by a full build."""
+        return len(self.sources)
+
+    def warning_counts(self) -> Dict[str, int]:
+        """Expected warnings per warning type."""
+        counts = {kind: 0 for kind in WARNING_KINDS}
+        for warning in self.warnings:
+            counts[warning.warning_type] += 1
+        return counts
+
+    def to_dict(self) -> Dict[str, Any]:
+        """Convert to a JSON-serializable dictionary."""
+        return {
+            "root": str(self.root),
+            "spec": asdict(self.spec),
+            "translation_units": self.translation_units,
+            "libraries": [asdict(library) for library in self.libraries],
+            "headers": self.headers,
+            "sources": self.sources,
+            "warning_counts": self.warning_counts(),
+            "warnings": [asdict(warning) for warning in self.warnings],
+        }
+
+    def synthesize_build_output(self) -> str:
+        """
+        Ninja output of a full GCC build of the project, without building it.
+
+        Compile steps, warnings (with GCC's source excerpt and caret lines)
+        and link steps appear in the order Ninja would print them for a
+        single-job build.
+
+        Returns:
+            Build output text
+        """
+        warnings_by_file: Dict[str, List[ExpectedWarning]] = {}
+        for warning in self.warnings:
+            warnings_by_file.setdefault(warning.file, []).append(warning)
+        sources_by_library: Dict[str, List[str]] = {}
+        for source in self.sources:
+            sources_by_library.setdefault(source.split("/")[1], []).append(source)
+
+        steps = self.translation_units + len(self.libraries) + 1
+        out: List[str] = []
+        step = 0
+        for library in self.libraries:
+            for source in sources_by_library[library.name]:
+                step += 1
+                directory, filename = source.rsplit("/", 1)
+                obj = f"{directory}/CMakeFiles/{library.name}.dir/{filename}.o"
+                self._compile_step(out, f"[{step}/{steps}]", obj, source, warnings_by_file)
+            step += 1
+            if library.kind == "SHARED":
+                artifact = f"shared library libs/{library.name}/lib{library.name}.so"
+            else:
+                artifact = f"static library libs/{library.name}/lib{library.name}.a"
+            out.append(f"[{step}/{steps}] Linking CXX {artifact}")
+        obj = "CMakeFiles/scale_app.dir/apps/main.cpp.o"
+        self._compile_step(out, f"[{steps - 1}/{steps}]", obj, "apps/main.cpp", warnings_by_file)
+        out.append(f"[{steps}/{steps}] Linking CXX executable scale_app")
+        return "\n".join(out) + "\n"
+
+    def _compile_step(
+        self,
+        out: List[str],
+        progress: str,
+        obj: str,
+        source: str,
+        warnings_by_file: Dict[str, List[ExpectedWarning]],
+    ) -> None:
+        """Append one compile step and the warnings it reports."""
+        out.append(f"{progress} Building CXX object {obj}")
+        path = f"{self.root}/{source}"
+        function = None
+        for warning in warnings_by_file.get(source, []):
+            if warning.function != function:
+                function = warning.function
+                out.append(f"{path}: In function 'int scale::{function}(int)':")
+            out.append(
+                f"{path}:{warning.line}:{warning.column}: warning: "
+                f"{warning.message} [-W{warning.warning_type}]"
+            )
+            out.append(f"{warning.line:5d} | {warning.source_line}")
+            out.append(f"      | {' ' * (warning.column - 1)}^")
+
+
+def _spread(index: int, rate: float) -> int:
+    """How many of `rate` items per slot fall in slot `index`."""
+    return int((index + 1) * rate) - int(index * rate)
+
+
+class _ProjectWriter:
+    """Writes the files of one project and tallies its manifest."""
+
+    def __init__(self, root: Path, spec: ProjectSpec):
+        self.root = root
+        self.spec = spec
+        self.manifest = ProjectManifest(root=root, spec=spec)
+        self.warning_index = 0
+
+    def write(self) -> ProjectManifest:
+        """Write every file of the project."""
+        spec = self.spec
+        self._write_file("include/scale/template_utils.h", self._template_utils())
+        for header in range(spec.headers):
+            self._write_file(f"include/scale/{self._header_name(header)}.h", self._header(header))
+            self.manifest.headers.append(f"include/scale/{self._header_name(header)}.h")
+
+        libraries = [f"scale_{i:03d}" for i in range(spec.libraries)]
+        for i, library in enumerate(libraries):
+            units = [u for u in range(i, spec.translation_units, spec.libraries)]
+            kind = "SHARED" if _spread(i, spec.shared_fraction) else "STATIC"
+            dependency = libraries[(i - 1) // 2] if i else None
+            self.manifest.libraries.append(LibraryInfo(library, kind, len(units), dependency))
+            self._write_library(library, kind, units, dependency)
+
+        self._write_file("apps/main.cpp", self._main(libraries))
+        self.manifest.sources.append("apps/main.cpp")
+        self._write_file("CMakeLists.txt", self._root_cmakelists(libraries))
+        self._write_file(MANIFEST_NAME, json.dumps(self.manifest.to_dict(), indent=2) + "\n")
+        return self.manifest
+
+    def _write_file(self, relative: str, content: str) -> None:
+        path = self.root / relative
+        path.parent.mkdir(parents=True, exist_ok=True)
+        path.write_text(content, encoding="utf-8")
+
+    @staticmethod
+    def _header_name(header: int) -> str:
+        return f"header_{header:03d}"
+
+    @staticmethod
+    def _layer_name(header: int) -> str:
+        return f"Layer{header:03d}"
+
+    def _template_utils(self) -> str:
+        return TEMPLATE_UTILS.format(notice=GENERATED_NOTICE)
+
+    def _header(self, header: int) -> str:
+        """A header whose templates recurse into the previous header's."""
+        guard = f"SCALE_{self._header_name(header).upper()}_H"
+        layer = self._layer_name(header)
+        chained = header % self.spec.include_depth != 0
+        if chained:
+            include = f'#include "scale/{self._header_name(header - 1)}.h"'
+            inner = f"{self._layer_name(header - 1)}<T, N / 2>::apply(min(next, T(N)))"
+        else:
+            include = '#include "scale/template_utils.h"'
+            inner = "Power<T, 2>::of(T(N % 5))"
+        return "\n".join(
+            [
+                GENERATED_NOTICE,
+                f"#ifndef {guard}",
+                f"#define {guard}",
+                "",
+                include,
+                "",
+                "namespace scale {",
+                "",
+                "template <typename T, int N>",
+                f"struct {layer} {{",
+                "    static T apply(T value) {",
+                f"        T next = clamp(T(value + T(N % {header % 7 + 2})), T(-4096), T(4096));",
+                f"        return max({layer}<T, N - 1>::apply(next), {inner});",
+                "    }",
+                "};",
+                "",
+                "template <typename T>",
+                f"struct {layer}<T, 0> {{",
+                "    static T apply(T value) { return value; }",
+                "};",
+                "",
+                "}  // namespace scale",
+                "",
+                f"#endif  // {guard}",
+                "",
+            ]
+        )
+
+    def _write_library(
+        self, library: str, kind: str, units: List[int], dependency: Optional[str]
+    ) -> None:
+        directory = f"libs/{library}"
+        declarations = [f"int {library}_entry(int seed);"]
+        sources = [f"{library}.cpp"]
+        for unit in units:
+            function = f"{library}_unit_{unit:05d}"
+            declarations.append(f"int {function}(int seed);")
+            source = f"unit_{unit:05d}.cpp"
+            sources.append(source)
+            text = self._unit(library, function, f"{directory}/{source}", unit)
+            self._write_file(f"{directory}/{source}", text)
+            self.manifest.sources.append(f"{directory}/{source}")
+
+        guard = f"{library.upper()}_H"
+        self._write_file(
+            f"{directory}/{library}.h",
+            "\n".join(
+                [
+                    GENERATED_NOTICE,
+                    f"#ifndef {guard}",
+                    f"#define {guard}",
+                    "",
+                    "namespace scale {",
+                    "",
+                ]
+                + declarations
+                + ["", "}  // namespace scale", "", f"#endif  // {guard}", ""]
+            ),
+        )
+        self._write_file(f"{directory}/{library}.cpp", self._entry(library, units, dependency))
+        self.manifest.sources.append(f"{directory}/{library}.cpp")
+
+        links = "scale_headers" + (f" {dependency}" if dependency else "")
+        self._write_file(
+            f"{directory}/CMakeLists.txt",
+            "\n".join(
+                [f"add_library({library} {kind}"]
+                + [f"    {source}" for source in sources]
+                + [
+                    ")",
+                    f"target_include_directories({library} PUBLIC ${{PROJECT_SOURCE_DIR}}/libs)",
+                    f"target_link_libraries({library} PUBLIC {links})",
+                    "",
+                ]
+            ),
+        )
+
+    def _entry(self, library: str, units: List[int], dependency: Optional[str]) -> str:
+        """The library's entry point, calling each unit and its dependency."""
+        lines = [
+            GENERATED_NOTICE,
+            f'#include "{library}/{library}.h"',
+        ]
+        if dependency:
+            lines.append(f'#include "{dependency}/{dependency}.h"')
+        lines += [
+            '#include "scale/template_utils.h"',
+            "",
+            "namespace scale {",
+            "",
+            f"int {library}_entry(int seed) {{",
+            f"    int total = {f'{dependency}_entry(seed)' if dependency else 'seed'};",
+        ]
+        lines += [f"    total = max(total, {library}_unit_{unit:05d}(seed));" for unit in units]
+        lines += ["    return total;", "}", "", "}  // namespace scale", ""]
+        return "\n".join(lines)
+
+    def _unit(self, library: str, function: str, path: str, unit: int) -> str:
+        """A unit instantiating its header's templates, with its warnings."""
+        header = unit % self.spec.headers
+        layer = self._layer_name(header)
+        depth = self.spec.template_depth
+        kinds = []
+        for _ in range(_spread(unit, self.spec.warning_density)):
+            kinds.append(WARNING_KINDS[self.warning_index % len(WARNING_KINDS)])
+            self.warning_index += 1
+
+        lines = [
+            GENERATED_NOTICE,
+            f'#include "{library}/{library}.h"',
+            f'#include "scale/{self._header_name(header)}.h"',
+            "",
+            "#include <cstddef>",
+            "#include <vector>",
+            "",
+            "namespace scale {",
+            "",
+        ]
+        for k, kind in enumerate(kinds):
+            if kind == "unused-parameter":
+                helper = f"{function}_helper_{k}"
+                lines.append(f"int {helper}(int value, int unused_{k}) {{")
+                self._expect(
+                    lines, path, f"unused_{k}", kind, helper, f"unused parameter 'unused_{k}'"
+                )
+                lines += ["    return value;", "}", ""]
+
+        lines += [
+            f"int {function}(int seed) {{",
+            "    std::vector<int> values(static_cast<std::size_t>(seed % 16 + 1), seed);",
+            f"    int total = {layer}<int, {depth}>::apply(seed);",
+            f"    total = max(total, static_cast<int>({layer}<long, {depth}>::apply(seed)));",
+            "    for (std::size_t i = 0; i < values.size(); ++i) {",
+            "        total = max(total, values[i]);",
+            "    }",
+        ]
+        for k, kind in enumerate(kinds):
+            if kind == "unused-variable":
+                lines.append(f"    int unused_{k} = seed + {k};")
+                self._expect(
+                    lines, path, f"unused_{k}", kind, function, f"unused variable 'unused_{k}'"
+                )
+            elif kind == "sign-compare":
+                lines.append(f"    for (int i_{k} = 0; i_{k} < values.size(); ++i_{k}) {{")
+                self._expect(lines, path, "< values", kind, function, SIGN_COMPARE_MESSAGE)
+                lines += [f"        total = max(total, i_{k});", "    }"]
+        lines += ["    return total;", "}", "", "}  // namespace scale", ""]
+        return "\n".join(lines)
+
+    def _expect(
+        self, lines: List[str], path: str, marker: str, kind: str, function: str, message: str
+    ) -> None:
+        """Record a warning at `marker` on the last line written."""
+        column = lines[-1].index(marker) + 1
+        self.manifest.warnings.append(
+            ExpectedWarning(path, len(lines), column, message, kind, function, lines[-1])
+        )
+
+    def _main(self, libraries: List[str]) -> str:
+        lines = [GENERATED_NOTICE, "#include <iostream>", ""]
+        lines += [f'#include "{library}/{library}.h"' for library in libraries]
+        lines += ["", "int main() {", "    int total = 0;"]
+        lines += [f"    total += scale::{library}_entry(1) % 7;" for library in libraries]
+        lines += ['    std::cout << "total " << total << std::endl;', "    return 0;", "}", ""]
+        return "\n".join(lines)
+
+    def _root_cmakelists(self, libraries: List[str]) -> str:
+        lines = [
+            "cmake_minimum_required(VERSION 3.10)",
+            f"project({self.spec.name} VERSION 1.0.0 LANGUAGES CXX)",
+            "",
+            "set(CMAKE_CXX_STANDARD 17)",
+            "set(CMAKE_CXX_STANDARD_REQUIRED ON)",
+            "set(CMAKE_POSITION_INDEPENDENT_CODE ON)",
+            "set(CMAKE_WINDOWS_EXPORT_ALL_SYMBOLS ON)",
+            "",
+            "if(MSVC)",
+            "    add_compile_options(/W4)",
+            "else()",
+            "    add_compile_options(-Wall -Wextra)",
+            "endif()",
+            "",
+            "add_library(scale_headers INTERFACE)",
+            "target_include_directories(scale_headers INTERFACE ${PROJECT_SOURCE_DIR}/include)",
+            "",
+        ]
+        lines += [f"add_subdirectory(libs/{library})" for library in libraries]
+        lines += [
+            "",
+            "add_executable(scale_app apps/main.cpp)",
+            f"target_link_libraries(scale_app PRIVATE {' '.join(libraries)})",
+            "",
+        ]
+        return "\n".join(lines)
+
+
+def generate_project(root: Path, spec: Optional[ProjectSpec] = None) -> ProjectManifest:
+    """
+    Write a synthetic CMake C++ project.
+
+    Files are written one at a time, so projects with tens of thousands of
+    translation units do not need their sources in memory. The manifest is
+    also written to forge-scale.json at the project root.
+
+    Args:
+        root: Directory to write the project into (created if missing)
+        spec: Project shape (default: ProjectSpec())
+
+    Returns:
+        Manifest of the generated project
+    """
+    root = Path(root)
+    root.mkdir(parents=True, exist_ok=True)
+    return _ProjectWriter(root, spec or ProjectSpec()).write()
@@ -0,0 +1,275 @@
+"""
+Tests for `forge coverage`.
+
+Covers argument parsing, toolchain detection, coverage flags, sharding of
+counter files, gcov and llvm-profdata/llvm-cov collection (with a fake
+process runner), recording into Anvil and a real gcc run when available.
+"""
+
+import json
+from pathlib import Path
+import shutil
+import subprocess
+
+import pytest
+
+from forge.__main__ import main
+from forge.cli.argument_parser import CoverageArgumentParser
+from forge.coverage.collector import (
+    CoverageCollector,
+    CoverageError,
+    detect_toolchain,
+    record_in_anvil,
+    shard_by_directory,
+)
+
+
+class FakeRunner:
+    """subprocess.run stand-in that records commands and returns canned output."""
+
+    def __init__(self, outputs=None):
+        """Map a command's first two words to the stdout to return."""
+        self.outputs = outputs or {}
+        self.commands = []
+
+    def __call__(self, command, stdout=None, **kwargs):
+        self.commands.append(command)
+        output = self.outputs.get(tuple(command[:2]), b"")
+        if hasattr(stdout, "write"):
+            stdout.write(output)
+            output = None
+        return subprocess.CompletedProcess(command, 0, output, b"")
+
+
+def _touch(path):
+    """Create an empty file and its parent directories."""
+    path.parent.mkdir(parents=True, exist_ok=True)
+    path.touch()
+    return path
+
+
+class TestCoverageArguments:
+    """Tests for CoverageArgumentParser."""
+
+    def test_coverage_options(self, temp_dir):
+        """Verify coverage options and --ctest-args next to the build options."""
+        args = CoverageArgumentParser().parse(
+            [
+                "--build-dir",
+                str(temp_dir / "build-coverage"),
+                "--cmake-args",
+                "-DBUILD_TESTING=ON",
+                "--ctest-args",
+                "-L",
+                "unit",
+                "--toolchain",
+                "llvm",
+                "--jobs",
+                "3",
+                "--no-record",
+            ]
+        )
+
+        assert args.cmake_args == ["-DBUILD_TESTING=ON"]
+        assert args.ctest_args == ["-L", "unit"]
+        assert (args.toolchain, args.jobs, args.record, args.commit) == ("llvm", 3, False, "HEAD")
+
+    def test_invalid_jobs(self, temp_dir):
+        """Verify --jobs must be positive."""
+        with pytest.raises(SystemExit):
+            CoverageArgumentParser().parse(["--build-dir", str(temp_dir), "--jobs", "0"])
+
+    def test_main_dispatch_validates(self, temp_dir):
+        """Verify `forge coverage` runs the build argument validation."""
+        assert main(["coverage", "--build-dir", str(temp_dir / "missing")]) == 2
+
+
+class TestToolchain:
+    """Tests for toolchain detection and coverage flags."""
+
+    def test_detection(self, temp_dir):
+        """Verify the compiler parameter, cache and environment are consulted in order."""
+        assert detect_toolchain({"CMAKE_CXX_COMPILER": "/usr/bin/clang++-17"}, temp_dir) == "llvm"
+        assert detect_toolchain({}, temp_dir, {"CXX": "g++"}) == "gcc"
+
+        (temp_dir / "CMakeCache.txt").write_text("CMAKE_CXX_COMPILER_ID:STRING=AppleClang\n")
+        assert detect_toolchain({}, temp_dir, {"CXX": "g++"}) == "llvm"
+
+    def test_flags_are_appended(self, temp_dir):
+        """Verify coverage flags extend user flags and default to a Debug build."""
+        collector = CoverageCollector("llvm", temp_dir)
+
+        params = collector.configure_parameters({"CMAKE_CXX_FLAGS": "-Wall"})
+
+        assert params["CMAKE_CXX_FLAGS"] == "-Wall -fprofile-instr-generate -fcoverage-mapping"
+        assert params["CMAKE_EXE_LINKER_FLAGS"] == "-fprofile-instr-generate -fcoverage-mapping"
+        assert params["CMAKE_BUILD_TYPE"] == "Debug"
+        assert "CMAKE_BUILD_TYPE" not in collector.configure_parameters(
+            {"CMAKE_BUILD_TYPE": "RelWithDebInfo"}
+        )
+
+
+class TestSharding:
+    """Tests for shard_by_directory."""
+
+    def test_directories_and_large_directories_split(self):
+        """Verify shards never span directories and big directories are split."""
+        files = [Path(f"/b/big/{i}.gcda") for i in range(6)] + [Path("/b/small/x.gcda")]
+
+        shards = shard_by_directory(files, jobs=2)
+
+        assert [len(s) for s in shards] == [4, 2, 1]
+        assert all(len({p.parent for p in shard}) == 1 for shard in shards)
+
+
+class TestGcovCollection:
+    """Tests for .gcda processing with gcov."""
+
+    def test_gcov_json_to_lcov(self, temp_dir):
+        """Verify gcov JSON becomes lcov, summing repeated lines and skipping system headers."""
+        source, build = temp_dir / "src", temp_dir / "build"
+        for name in ("a", "b"):
+            _touch(build / "obj" / f"{name}.gcda")
+        document = {
+            "current_working_directory": str(build),
+            "files": [
+                {
+                    "file": str(source / "a.cpp"),
+                    "lines": [
+                        {"line_number": 3, "count": 0},
+                        {"line_number": 2, "count": 1},
+                        {"line_number": 3, "count": 2},
+                    ],
+                },
+                {"file": "/usr/include/c++/vector", "lines": [{"line_number": 1, "count": 5}]},
+            ],
+        }
+        runner = FakeRunner({("gcov", "--json-format"): json.dumps(document).encode() + b"\n"})
+        collector = CoverageCollector("gcc", build, source, jobs=1, runner=runner)
+
+        report = collector.collect()
+
+        assert report.read_text() == f"SF:{source / 'a.cpp'}\nDA:2,1\nDA:3,2\nend_of_record\n"
+        assert runner.commands[0][-2:] == ["a.gcda", "b.gcda"]
+
+    def test_no_counters(self, temp_dir):
+        """Verify a clear error when the tests wrote no counters."""
+        with pytest.raises(CoverageError, match=r"No \.gcda files"):
+            CoverageCollector("gcc", temp_dir, runner=FakeRunner()).collect()
+
+    def test_reset_counters(self, temp_dir):
+        """Verify stale counters from an earlier run are deleted."""
+        _touch(temp_dir / "obj" / "a.gcda")
+        _touch(temp_dir / "obj" / "a.gcno")
+
+        assert CoverageCollector("gcc", temp_dir).reset_counters() == 1
+        assert (temp_dir / "obj" / "a.gcno").exists()
+
+
+class TestLlvmCollection:
+    """Tests for .profraw merging and llvm-cov export."""
+
+    def test_sharded_merge_and_export(self, temp_dir):
+        """Verify per-shard merges, a final merge and one export over all binaries."""
+        build = temp_dir / "build"
+        for directory in ("t1", "t2"):
+            _touch(build / directory / "1-abc.profraw")
+        test_binary = _touch(build / "tests" / "test_math")
+        _touch(build / "lib" / "libcore.so")
+        ctest_json = {"tests": [{"command": [str(test_binary)]}, {"command": ["/bin/sh"]}]}
+        runner = FakeRunner(
+            {
+                ("ctest", "--show-only=json-v1"): json.dumps(ctest_json).encode(),
+                ("llvm-cov", "export"): b"SF:/src/a.cpp\nDA:1,1\nend_of_record\n",
+            }
+        )
+        collector = CoverageCollector("llvm", build, jobs=4, runner=runner)
+
+        report = collector.collect()
+
+        merges = [c for c in runner.commands if c[:2] == ["llvm-profdata", "merge"]]
+        assert len(merges) == 3
+        assert merges[-1][-1] == str(build / "coverage" / "coverage.profdata")
+        final_inputs = (build / "coverage" / "coverage.inputs").read_text().split()
+        assert len(final_inputs) == 2 and all("shard-" in p for p in final_inputs)
+
+        export = runner.commands[-1]
+        assert export[export.index("-object") + 1] == str(build / "lib" / "libcore.so")
+        assert str(test_binary) in export and "/bin/sh" not in export
+        assert report.read_bytes().startswith(b"SF:/src/a.cpp")
+
+    def test_profile_environment(self, temp_dir):
+        """Verify each test process writes its own raw profile."""
+        env = CoverageCollector("llvm", temp_dir).test_environment()
+
+        assert env["LLVM_PROFILE_FILE"].endswith("%p-%m.profraw")
+        assert "LLVM_PROFILE_FILE" not in CoverageCollector("gcc", temp_dir).test_environment()
+
+
+class TestAnvilRecording:
+    """Tests for recording reports into Anvil's coverage tables."""
+
+    def test_record_outside_git(self, temp_dir):
+        """Verify a report is stored per file, without a commit outside git."""
+        pytest.importorskip("anvil.core.patch_coverage")
+        from anvil.storage.execution_schema import ExecutionDatabase
+
+        report = temp_dir / "coverage.info"
+        report.write_text(
+            "SF:/src/a.cpp\nDA:1,1\nDA:2,0\nend_of_record\n"
+            "SF:/src/a.cpp\nDA:2,3\nend_of_record\n"
+            "SF:/src/b.h\nDA:7,0\nend_of_record\n"
+        )
+        database = temp_dir / ".anvil" / "history.db"
+
+        execution_id, coverage = record_in_anvil(report, temp_dir, database)
+
+        assert coverage.files_analyzed == 2 and coverage.covered_statements == 2
+        db = ExecutionDatabase(str(database))
+        try:
+            summary = db.get_coverage_summary(limit=1)[0]
+            lines = db.get_coverage_lines(execution_id, ["/src/a.cpp"])
+        finally:
+            db.close()
+        assert summary.execution_id == execution_id and summary.git_commit is None
+        assert lines["/src/a.cpp"][0] == [1, 2]
+
+
+@pytest.mark.skipif(
+    not all(shutil.which(tool) for tool in ("cmake", "ctest", "g++", "gcov")),
+    reason="cmake, ctest, g++ and gcov are required",
+)
+def test_gcc_end_to_end(temp_dir, monkeypatch):
+    """Verify a real instrumented build, test run and gcov collection."""
+    source = temp_dir / "source"
+    source.mkdir()
+    (source / "CMakeLists.txt").write_text(
+        "cmake_minimum_required(VERSION 3.16)\n"
+        "project(CoverageSample CXX)\n"
+        "enable_testing()\n"
+        "add_executable(unit unit.cpp)\n"
+        "add_test(NAME unit COMMAND unit)\n"
+    )
+    (source / "unit.cpp").write_text(
+        "int used() {\n  return 0;\n}\nint unused() {\n  return 1;\n}\n"
+        "int main() {\n  return used();\n}\n"
+    )
+    monkeypatch.setenv("CXX", "g++")
+
+    exit_code = main(
+        [
+            "coverage",
+            "--source-dir",
+            str(source),
+            "--build-dir",
+            str(temp_dir / "build-coverage"),
+            "--database",
+            str(temp_dir / "forge.db"),
+            "--no-record",
+        ]
+    )
+
+    assert exit_code == 0
+    report = (temp_dir / "build-coverage" / "coverage" / "coverage.info").read_text()
+    assert f"SF:{source / 'unit.cpp'}" in report
+    assert "DA:2,1" in report and "DA:5,0" in report
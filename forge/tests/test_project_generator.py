@@ -0,0 +1,189 @@
+"""
+Tests for the synthetic large project generator.
+
+Tests that generated projects have the requested shape, are deterministic,
+and that both the synthesized build output and a real build report exactly
+the warnings listed in the manifest.
+"""
+
+import json
+from pathlib import Path
+import shutil
+import subprocess
+
+import pytest
+
+from forge.cmake.executor import CMakeExecutor
+from forge.inspector.build_inspector import BuildInspector
+from forge.testing.project_generator import (
+    MANIFEST_NAME,
+    WARNING_KINDS,
+    ProjectSpec,
+    generate_project,
+)
+
+SMALL_SPEC = ProjectSpec(
+    translation_units=24,
+    libraries=4,
+    shared_fraction=0.5,
+    headers=6,
+    template_depth=4,
+    include_depth=3,
+    warning_density=0.5,
+)
+
+
+def _tree(root: Path) -> dict:
+    """Contents of every file under root, by relative path."""
+    return {
+        str(path.relative_to(root)): path.read_bytes()
+        for path in sorted(root.rglob("*"))
+        if path.is_file()
+    }
+
+
+class TestProjectSpec:
+    """Test ProjectSpec validation."""
+
+    @pytest.mark.parametrize(
+        "kwargs, message",
+        [
+            ({"translation_units": 0}, "translation_units"),
+            ({"translation_units": 5, "libraries": 6}, "libraries"),
+            ({"shared_fraction": 1.5}, "shared_fraction"),
+            ({"headers": 0}, "headers"),
+            ({"template_depth": 0}, "template_depth"),
+            ({"warning_density": -1}, "warning_density"),
+        ],
+    )
+    def test_invalid_spec(self, kwargs, message):
+        """Test out-of-range values are rejected."""
+        with pytest.raises(ValueError, match=message):
+            ProjectSpec(**kwargs)
+
+
+class TestGenerateProject:
+    """Test generate_project."""
+
+    def test_project_shape(self, temp_dir):
+        """Test sources, libraries and headers match the spec."""
+        manifest = generate_project(temp_dir, SMALL_SPEC)
+
+        # 24 units, one entry source per library and main.cpp
+        assert manifest.translation_units == 24 + 4 + 1
+        assert all((temp_dir / source).is_file() for source in manifest.sources)
+        assert [library.units for library in manifest.libraries] == [6, 6, 6, 6]
+        assert [library.kind for library in manifest.libraries] == [
+            "STATIC",
+            "SHARED",
+            "STATIC",
+            "SHARED",
+        ]
+        assert [library.dependency for library in manifest.libraries] == [
+            None,
+            "scale_000",
+            "scale_000",
+            "scale_001",
+        ]
+        assert len(manifest.headers) == 6
+        assert (temp_dir / "include" / "scale" / "template_utils.h").is_file()
+
+    def test_header_chains(self, temp_dir):
+        """Test headers include the previous header up to the include depth."""
+        generate_project(temp_dir, SMALL_SPEC)
+        headers = temp_dir / "include" / "scale"
+
+        assert '#include "scale/template_utils.h"' in (headers / "header_000.h").read_text()
+        assert '#include "scale/header_001.h"' in (headers / "header_002.h").read_text()
+        assert '#include "scale/template_utils.h"' in (headers / "header_003.h").read_text()
+
+    def test_warnings_spread_over_units(self, temp_dir):
+        """Test the warning density and the cycle through warning kinds."""
+        manifest = generate_project(temp_dir, SMALL_SPEC)
+
+        assert len(manifest.warnings) == 12
+        assert manifest.warning_counts() == {kind: 4 for kind in WARNING_KINDS}
+        for warning in manifest.warnings:
+            lines = (temp_dir / warning.file).read_text().splitlines()
+            assert lines[warning.line - 1] == warning.source_line
+
+    def test_manifest_file(self, temp_dir):
+        """Test the manifest is written next to the project."""
+        manifest = generate_project(temp_dir, SMALL_SPEC)
+
+        written = json.loads((temp_dir / MANIFEST_NAME).read_text())
+        assert written["translation_units"] == manifest.translation_units
+        assert written["warning_counts"] == manifest.warning_counts()
+        assert written["spec"]["libraries"] == 4
+
+    def test_deterministic(self, temp_dir):
+        """Test the same spec writes the same files."""
+        generate_project(temp_dir / "a", SMALL_SPEC)
+        generate_project(temp_dir / "b", SMALL_SPEC)
+
+        a, b = _tree(temp_dir / "a"), _tree(temp_dir / "b")
+        a.pop(MANIFEST_NAME)
+        b.pop(MANIFEST_NAME)
+        assert a == b
+
+
+class TestSynthesizedBuildOutput:
+    """Test the synthesized build output against the BuildInspector."""
+
+    def test_inspector_finds_expected_warnings(self, temp_dir):
+        """Test every expected warning and target is extracted."""
+        manifest = generate_project(temp_dir, ProjectSpec(translation_units=300, libraries=10))
+
+        metadata = BuildInspector().inspect_build_output(
+            manifest.synthesize_build_output(), temp_dir
+        )
+
+        assert metadata.project_name == "ForgeScale"
+        assert len(metadata.targets) == len(manifest.libraries) + 1
+        assert sorted((w.file, w.line, w.column, w.warning_type) for w in metadata.warnings) == (
+            sorted(
+                (str(temp_dir / w.file), w.line, w.column, w.warning_type)
+                for w in manifest.warnings
+            )
+        )
+        assert metadata.errors == []
+
+
+@pytest.mark.skipif(
+    shutil.which("cmake") is None
+    or not any(shutil.which(cxx) for cxx in ("g++", "clang++", "cl.exe")),
+    reason="CMake and a C++ compiler are required",
+)
+class TestRealBuild:
+    """Test a generated project builds and warns as its manifest says."""
+
+    def test_build_reports_expected_warnings(self, temp_dir):
+        """Test the compiler reports one warning per expected warning."""
+        manifest = generate_project(temp_dir / "project", SMALL_SPEC)
+        build_dir = temp_dir / "build"
+        executor = CMakeExecutor()
+
+        configure = executor.execute_configure(
+            ["cmake", "-S", str(manifest.root), "-B", str(build_dir)], stream_output=False
+        )
+        assert configure.success, configure.stderr
+        build = executor.execute_build(["cmake", "--build", str(build_dir)], stream_output=False)
+        assert build.success, build.stdout + build.stderr
+
+        warnings = BuildInspector().extract_warnings(build.stdout + build.stderr)
+        counts = {kind: 0 for kind in WARNING_KINDS}
+        for warning in warnings:
+            kind = warning.warning_type
+            # MSVC reports codes rather than GCC/Clang flag names
+            if kind in counts:
+                counts[kind] += 1
+        if not any(counts.values()):
+            pytest.skip("compiler does not report GCC-style warning flags")
+        assert counts == manifest.warning_counts()
+
+        apps = [
+            p for p in build_dir.rglob("scale_app*") if p.is_file() and p.suffix in ("", ".exe")
+        ]
+        assert apps
+        run = subprocess.run([str(apps[0])], capture_output=True, text=True, timeout=30)
+        assert run.returncode == 0 and run.stdout.startswith("total ")
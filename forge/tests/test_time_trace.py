@@ -0,0 +1,318 @@
+"""
+Tests for `forge time-trace`.
+
+Covers argument parsing, template names, per translation unit trace
+summaries (nested and recursive instantiations), discovery and parallel
+aggregation of synthetic -ftime-trace files, persistence of the costs and a
+real Clang run when available.
+"""
+
+from datetime import datetime
+import json
+import shutil
+
+import pytest
+
+from forge.__main__ import main
+from forge.cli.argument_parser import TimeTraceArgumentParser
+from forge.models.metadata import BuildMetadata
+from forge.models.results import BuildResult
+from forge.profiling.time_trace import (
+    TimeTraceCollector,
+    TimeTraceError,
+    summarize_trace,
+    template_name,
+)
+from forge.storage.data_persistence import DataPersistence
+
+
+def _event(name, start, duration, detail=None):
+    """Complete ("X") trace event as Clang writes it."""
+    event = {"pid": 1, "tid": 1, "ph": "X", "ts": start, "dur": duration, "name": name}
+    if detail is not None:
+        event["args"] = {"detail": detail}
+    return event
+
+
+def _write_trace(path, events, compile_us=10_000, with_object=True):
+    """Write a trace file, and the object file it belongs to."""
+    path.parent.mkdir(parents=True, exist_ok=True)
+    trace = {
+        "traceEvents": [_event("ExecuteCompiler", 0, compile_us)]
+        + events
+        + [{"ph": "M", "name": "process_name", "args": {"name": "clang"}}],
+        "beginningOfTime": 0,
+    }
+    path.write_text(json.dumps(trace))
+    if with_object:
+        path.with_suffix(".o").touch()
+    return path
+
+
+# Layer<3> instantiates Layer<2>, which instantiates Layer<1>
+RECURSIVE = [
+    _event("InstantiateClass", 100, 3000, "Layer<3>"),
+    _event("InstantiateClass", 200, 2000, "Layer<2>"),
+    _event("InstantiateClass", 300, 1000, "Layer<1>"),
+    _event("InstantiateFunction", 5000, 700, "scale::max<int>"),
+    _event("InstantiateFunction", 6000, 500, "scale::max<double>"),
+]
+
+
+def _save_build(persistence, project="Templates"):
+    """Save a successful build and return its ID."""
+    result = BuildResult(
+        success=True,
+        exit_code=0,
+        duration=1.0,
+        stdout="",
+        stderr="",
+        start_time=datetime(2024, 1, 15, 14, 32, 0),
+        end_time=datetime(2024, 1, 15, 14, 32, 1),
+    )
+    return persistence.save_build(result, BuildMetadata(project_name=project), None)
+
+
+class TestTimeTraceArguments:
+    """Tests for TimeTraceArgumentParser."""
+
+    def test_options(self, temp_dir):
+        """Verify profiling options next to the build options."""
+        args = TimeTraceArgumentParser().parse(
+            [
+                "--build-dir",
+                str(temp_dir / "build"),
+                "--cmake-args",
+                "-DCMAKE_CXX_COMPILER=clang++",
+                "--jobs",
+                "4",
+                "--granularity",
+                "100",
+                "--top",
+                "5",
+            ]
+        )
+
+        assert args.cmake_args == ["-DCMAKE_CXX_COMPILER=clang++"]
+        assert (args.jobs, args.granularity, args.top) == (4, 100, 5)
+
+    @pytest.mark.parametrize("option", [["--jobs", "0"], ["--top", "0"], ["--granularity", "-1"]])
+    def test_invalid_values(self, temp_dir, option):
+        """Verify out-of-range values are rejected."""
+        with pytest.raises(SystemExit):
+            TimeTraceArgumentParser().parse(["--build-dir", str(temp_dir)] + option)
+
+    def test_main_dispatch_validates(self, temp_dir):
+        """Verify `forge time-trace` runs the build argument validation."""
+        assert main(["time-trace", "--build-dir", str(temp_dir / "missing")]) == 2
+
+    def test_requires_clang(self, temp_dir, monkeypatch):
+        """Verify a non-Clang compiler is reported before building."""
+        monkeypatch.setenv("CXX", "g++")
+        (temp_dir / "CMakeLists.txt").write_text("project(Sample CXX)\n")
+
+        exit_code = main(
+            [
+                "time-trace",
+                "--source-dir",
+                str(temp_dir),
+                "--build-dir",
+                str(temp_dir / "build"),
+                "--database",
+                str(temp_dir / "forge.db"),
+            ]
+        )
+
+        assert exit_code == 2
+        assert not (temp_dir / "forge.db").exists()
+
+
+class TestTemplateName:
+    """Tests for template_name."""
+
+    @pytest.mark.parametrize(
+        "detail, expected",
+        [
+            ("scale::max<int>", "scale::max<$>"),
+            ("std::map<int, std::vector<int>>", "std::map<$>"),
+            ("std::vector<int>::push_back", "std::vector<$>::push_back"),
+            ("Outer<A>::Inner<B<C>>", "Outer<$>::Inner<$>"),
+            ("operator<<<char>", "operator<<<$>"),
+            ("plain_function", "plain_function"),
+        ],
+    )
+    def test_argument_lists_collapse(self, detail, expected):
+        """Verify every specialization maps to one template."""
+        assert template_name(detail) == expected
+
+
+class TestSummarizeTrace:
+    """Tests for summarize_trace."""
+
+    def test_nested_instantiations(self, temp_dir):
+        """Verify a recursive template is not counted once per nesting level."""
+        summary = summarize_trace(_write_trace(temp_dir / "a.cpp.json", RECURSIVE))
+
+        assert summary.compile_us == 10_000
+        # Layer<3> (outermost) plus the two max instantiations
+        assert summary.instantiation_us == 3000 + 700 + 500
+        assert summary.instantiations["Layer<2>"] == [2000, 1]
+        assert summary.templates["Layer<$>"] == [3000, 3]
+        assert summary.templates["scale::max<$>"] == [1200, 2]
+
+    def test_siblings_after_parent_ends(self, temp_dir):
+        """Verify an instantiation starting as its predecessor ends is not nested."""
+        events = [
+            _event("InstantiateClass", 0, 100, "A<1>"),
+            _event("InstantiateClass", 100, 50, "A<2>"),
+        ]
+        summary = summarize_trace(_write_trace(temp_dir / "a.cpp.json", events))
+
+        assert summary.templates["A<$>"] == [150, 2]
+        assert summary.instantiation_us == 150
+
+    @pytest.mark.parametrize("content", ["not json", "[]", '{"traceEvents": 3}'])
+    def test_unreadable_trace(self, temp_dir, content):
+        """Verify files that are not Chrome traces are ignored."""
+        path = temp_dir / "a.cpp.json"
+        path.write_text(content)
+
+        assert summarize_trace(path) is None
+
+
+class TestTimeTraceCollector:
+    """Tests for TimeTraceCollector."""
+
+    def test_flags_are_appended(self, temp_dir):
+        """Verify the trace flags extend user C++ flags."""
+        collector = TimeTraceCollector(temp_dir, granularity=100)
+
+        assert collector.configure_parameters({"CMAKE_CXX_FLAGS": "-Wall"}) == {
+            "CMAKE_CXX_FLAGS": "-Wall -ftime-trace -ftime-trace-granularity=100"
+        }
+
+    def test_find_traces(self, temp_dir):
+        """Verify only traces next to an existing object file are found."""
+        objects = temp_dir / "CMakeFiles" / "app.dir"
+        current = _write_trace(objects / "main.cpp.json", RECURSIVE)
+        _write_trace(objects / "removed.cpp.json", RECURSIVE, with_object=False)
+        (temp_dir / "compile_commands.json").write_text("[]")
+
+        assert list(TimeTraceCollector(temp_dir).find_traces()) == [current]
+
+    def test_aggregates_across_units(self, temp_dir):
+        """Verify totals, counts and translation units over several traces."""
+        objects = temp_dir / "CMakeFiles" / "app.dir"
+        _write_trace(objects / "a.cpp.json", RECURSIVE)
+        _write_trace(objects / "b.cpp.json", RECURSIVE[3:], compile_us=4000)
+
+        report = TimeTraceCollector(temp_dir, jobs=1).collect()
+
+        assert report.translation_units == 2
+        assert report.compile_ms == 14.0
+        assert report.instantiation_ms == 4.2 + 1.2
+        assert [(c.name, c.total_ms, c.count, c.translation_units) for c in report.templates] == [
+            ("Layer<$>", 3.0, 3, 1),
+            ("scale::max<$>", 2.4, 4, 2),
+        ]
+        assert report.instantiations[0].name == "Layer<3>"
+        assert report.instantiations[2].name == "scale::max<int>"
+        assert report.instantiations[2].translation_units == 2
+        assert [c.kind for c in report.costs(1)] == ["template", "instantiation"]
+
+    def test_parallel_matches_serial(self, temp_dir):
+        """Verify worker processes produce the same report as a single process."""
+        for unit in range(12):
+            events = [_event("InstantiateFunction", 0, 100 + unit, f"f<T{unit % 3}>")]
+            _write_trace(temp_dir / "CMakeFiles" / f"u{unit}.dir" / "u.cpp.json", events)
+
+        serial = TimeTraceCollector(temp_dir, jobs=1).collect()
+        parallel = TimeTraceCollector(temp_dir, jobs=3).collect()
+
+        assert parallel == serial
+        assert serial.templates[0].translation_units == 12
+
+    def test_no_traces(self, temp_dir):
+        """Verify a build without traces is reported."""
+        with pytest.raises(TimeTraceError, match="No -ftime-trace files"):
+            TimeTraceCollector(temp_dir).collect()
+
+
+class TestTemplateCostStorage:
+    """Tests for storing template costs per build."""
+
+    def test_round_trip(self, temp_dir):
+        """Verify costs are stored per build and read back costliest first."""
+        _write_trace(temp_dir / "a.cpp.json", RECURSIVE)
+        report = TimeTraceCollector(temp_dir).collect()
+
+        with DataPersistence(temp_dir / "forge.db") as persistence:
+            build_id = _save_build(persistence)
+            assert persistence.save_template_costs(build_id, report.costs()) == 7
+
+            templates = persistence.get_template_costs(build_id, kind="template")
+            assert [(c["name"], c["count"]) for c in templates] == [
+                ("Layer<$>", 3),
+                ("scale::max<$>", 2),
+            ]
+            assert len(persistence.get_template_costs(build_id, limit=3)) == 3
+
+    def test_previous_profiled_build(self, temp_dir):
+        """Verify the previous build with costs of the same project is found."""
+        _write_trace(temp_dir / "a.cpp.json", RECURSIVE)
+        costs = TimeTraceCollector(temp_dir).collect().costs()
+
+        with DataPersistence(temp_dir / "forge.db") as persistence:
+            profiled = _save_build(persistence)
+            persistence.save_template_costs(profiled, costs)
+            _save_build(persistence)
+            other = _save_build(persistence, project="Other")
+            persistence.save_template_costs(other, costs)
+            current = _save_build(persistence)
+
+            assert persistence.get_previous_profiled_build("Templates", current) == profiled
+            assert persistence.get_previous_profiled_build("Templates", profiled) is None
+
+
+@pytest.mark.skipif(
+    not all(shutil.which(tool) for tool in ("cmake", "clang++")),
+    reason="cmake and clang++ are required",
+)
+def test_clang_end_to_end(temp_dir, monkeypatch):
+    """Verify a real -ftime-trace build is profiled and stored."""
+    source = temp_dir / "source"
+    source.mkdir()
+    (source / "CMakeLists.txt").write_text(
+        "cmake_minimum_required(VERSION 3.16)\n"
+        "project(TimeTraceSample CXX)\n"
+        "add_executable(app main.cpp)\n"
+    )
+    (source / "main.cpp").write_text(
+        "#include <map>\n#include <string>\n#include <vector>\n"
+        "int main() {\n"
+        "  std::map<std::string, std::vector<int>> values;\n"
+        '  values["a"].push_back(1);\n'
+        "  return static_cast<int>(values.size()) - 1;\n"
+        "}\n"
+    )
+    monkeypatch.setenv("CXX", "clang++")
+    database = temp_dir / "forge.db"
+
+    exit_code = main(
+        [
+            "time-trace",
+            "--source-dir",
+            str(source),
+            "--build-dir",
+            str(temp_dir / "build"),
+            "--database",
+            str(database),
+            "--granularity",
+            "0",
+        ]
+    )
+
+    assert exit_code == 0
+    with DataPersistence(database) as persistence:
+        build_id = persistence.get_recent_builds(limit=1)[0]["id"]
+        assert persistence.get_template_costs(build_id, kind="template")
@@ -5,6 +5,9 @@ Tests extraction of compiler warnings and errors from GCC, Clang, and MSVC
 output formats with file/line/column information.
 """
 
+import pytest
+
+from forge.inspector import build_inspector
 from forge.inspector.build_inspector import BuildInspector
 
 
@@ -509,3 +512,31 @@ class TestEdgeCases:
 
         assert len(warnings) == 1
         assert "café" in warnings[0].message
+
+
+class TestLogScanPrefilter:
+    """Test that Anvil's log scanner leaves extraction results unchanged."""
+
+    OUTPUT = (
+        "[1/3] Building CXX object a.cpp.o\r\n"
+        "\x1b[1ma.cpp:3:7: \x1b[35mwarning:\x1b[0m unused 'x' [-Wunused-variable]\r\n"
+        "b.cpp(4,2): warning C4101: 'y': unreferenced\x0cc.cpp:9:1: warning: after form feed\n"
+        "ld: warning: relocation in read-only section\n"
+        "d.cpp:1:10: fatal error: missing.h: No such file or directory\n"
+        "e.cpp(8): error C2065: 'z': undeclared identifier\n"
+        "plain line mentioning nothing\n"
+    )
+
+    def test_same_results_without_prefilter(self, monkeypatch):
+        """Test warnings and errors match the plain line-by-line scan."""
+        pytest.importorskip("anvil.parsers.log_scan")
+        inspector = BuildInspector()
+        warnings = inspector.extract_warnings(self.OUTPUT, deduplicate=False)
+        errors = inspector.extract_errors(self.OUTPUT)
+
+        monkeypatch.setattr(build_inspector, "select_lines", None)
+        monkeypatch.setattr(build_inspector, "strip_ansi", None)
+
+        assert inspector.extract_warnings(self.OUTPUT, deduplicate=False) == warnings
+        assert inspector.extract_errors(self.OUTPUT) == errors
+        assert len(warnings) == 4 and len(errors) == 2
@@ -1837,9 +1837,43 @@ async def list_executions(
         )
 
 
+def _grep_log(raw: bytes, needle: str, ignore_case: bool) -> List[dict]:
+    """
+    Lines of a stored log containing needle, decoding only those lines.
+
+    Args:
+        raw: Log contents as stored
+        needle: Text to look for
+        ignore_case: Match needle in either case
+
+    Returns:
+        List of {"line": 1-based line number, "content": line}
+    """
+    try:
+        from anvil.parsers.log_view import LogView
+    except ImportError:
+        LogView = None
+
+    if LogView is not None:
+        matches = LogView(raw).grep([needle], ignore_case)
+    else:
+        text = raw.decode("utf-8", errors="replace")
+        folded = needle.lower() if ignore_case else needle
+        matches = (
+            (number, line)
+            for number, line in enumerate(text.splitlines(), 1)
+            if folded in (line.lower() if ignore_case else line)
+        )
+    return [{"line": number, "content": line} for number, line in matches]
+
+
 @router.get("/show-log/{run_id}", response_model=dict)
 async def show_logs(
     run_id: int,
+    grep: Optional[str] = Query(
+        None, description="Only return log lines containing this text"
+    ),
+    ignore_case: bool = Query(False, description="Case-insensitive grep"),
     project: dict = Depends(get_active_project_dep)
 ) -> dict:
     """
@@ -1848,14 +1882,21 @@ async def show_logs(
     This retrieves stored logs from the ExecutionLog table and returns
     the actual raw log content from GitHub Actions.
 
+    With grep, each log is read from the database as bytes and only the
+    matching lines are decoded and returned (in "log_lines", with
+    "raw_log" left empty), so large logs are not sent or held as a whole.
+
     Args:
         run_id: GitHub Actions workflow run ID
+        grep: Only return lines containing this text
+        ignore_case: Match grep in either case
         project: Active project (injected via dependency)
 
     Returns:
         Dictionary with workflow run info and raw logs from jobs
     """
     try:
+        from sqlalchemy import LargeBinary, cast
         from scout.storage.schema import ExecutionLog
 
         db_path = get_scout_db_path(project)
@@ -1879,12 +1920,24 @@ async def show_logs(
             # Build response with job information and raw logs
             job_logs = []
             for job in jobs:
-                # Get raw logs from ExecutionLog table
-                execution_log = (
-                    session.query(ExecutionLog)
-                    .filter_by(job_id=job.job_id)
-                    .first()
-                )
+                if grep is not None:
+                    # Read the log as a blob so it is never decoded whole
+                    log_blob = (
+                        session.query(
+                            cast(ExecutionLog.raw_content, LargeBinary)
+                        )
+                        .filter(ExecutionLog.job_id == job.job_id)
+                        .first()
+                    )
+                    execution_log = None
+                else:
+                    # Get raw logs from ExecutionLog table
+                    log_blob = None
+                    execution_log = (
+                        session.query(ExecutionLog)
+                        .filter_by(job_id=job.job_id)
+                        .first()
+                    )
 
                 # Get test results for this job to show as summary
                 test_results = (
@@ -1902,7 +1955,9 @@ async def show_logs(
                     if job.started_at else None,
                     "completed_at": job.completed_at.isoformat()
                     if job.completed_at else None,
-                    "has_raw_log": execution_log is not None,
+                    "has_raw_log": (
+                        execution_log is not None or log_blob is not None
+                    ),
                     "raw_log": execution_log.raw_content if execution_log else None,
                     "test_summary": {
                         "total": len(test_results),
@@ -1917,6 +1972,10 @@ async def show_logs(
                         ),
                     },
                 }
+                if log_blob is not None:
+                    job_log_data["log_lines"] = _grep_log(
+                        log_blob[0] or b"", grep, ignore_case
+                    )
                 job_logs.append(job_log_data)
 
             return {
@@ -16,6 +16,11 @@ from typing import Dict, List, Optional
 
 from scout.failure_parser import Failure
 
+try:
+    from anvil.utils.contingency import fisher_exact_greater
+except ImportError:  # pragma: no cover - Anvil is optional
+    fisher_exact_greater = None
+
 
 @dataclass
 class FlakyTest:
@@ -76,11 +81,14 @@ class PlatformFailure:
         test_name: Name of the test
         failing_platforms: List of platforms where test fails
         passing_platforms: List of platforms where test passes
+        p_value: Smallest one-sided Fisher's exact p-value of a failing
+            platform against the others (None without Anvil installed)
     """
 
     test_name: str
     failing_platforms: List[str]
     passing_platforms: List[str]
+    p_value: Optional[float] = None
 
 
 @dataclass
@@ -205,44 +213,75 @@ class AnalysisEngine:
     def detect_platform_specific_failures(
         self,
         runs: List[Dict],
+        max_p_value: Optional[float] = None,
     ) -> List[PlatformFailure]:
         """
         Detect platform-specific failures.
 
+        Runs are tallied once into passed/failed counts per test and
+        platform; a platform is the runner OS, plus the compiler and build
+        type of C++ matrix jobs when present. Each failing platform is then
+        tested against the rest of the test's platforms with Fisher's exact
+        test, for all tests in one batch (Anvil's anvil.utils.contingency,
+        which also backs CIStorageLayer.get_platform_failure_statistics).
+
         Args:
-            runs: List of test runs with 'test_name', 'platform', 'passed'
+            runs: List of test runs with 'test_name', 'platform', 'passed' and
+                optionally 'compiler' and 'build_type'
+            max_p_value: Only report failing platforms at this significance
+                level (optional; ignored without Anvil installed)
 
         Returns:
             List of platform-specific failures
         """
-        # Group runs by test name
-        test_runs = defaultdict(list)
+        # test name -> platform -> [passed, failed]
+        outcomes = defaultdict(lambda: defaultdict(lambda: [0, 0]))
         for run in runs:
-            test_runs[run["test_name"]].append(run)
+            platform = "-".join(
+                part
+                for part in (run["platform"], run.get("compiler"), run.get("build_type"))
+                if part
+            )
+            outcomes[run["test_name"]][platform][0 if run["passed"] else 1] += 1
+
+        # Platform-specific if fails on some platforms but passes on others
+        candidates = []
+        tables = []
+        for test_name, platforms in outcomes.items():
+            failing = sorted(platform for platform, (_, failed) in platforms.items() if failed)
+            passing = sorted(platform for platform, (passed, _) in platforms.items() if passed)
+            if not (failing and passing):
+                continue
 
+            passed_total = sum(passed for passed, _ in platforms.values())
+            failed_total = sum(failed for _, failed in platforms.values())
+            candidates.append((test_name, failing, passing))
+            for platform in failing:
+                passed, failed = platforms[platform]
+                tables.append((failed, passed, failed_total - failed, passed_total - passed))
+
+        if fisher_exact_greater is None:
+            return [PlatformFailure(*candidate) for candidate in candidates]
+
+        p_values = iter(fisher_exact_greater(tables))
         platform_failures = []
+        for test_name, failing, passing in candidates:
+            failing_p_values = dict(zip(failing, p_values))
+            if max_p_value is not None:
+                failing = [
+                    platform for platform in failing if failing_p_values[platform] <= max_p_value
+                ]
+                if not failing:
+                    continue
 
-        for test_name, test_run_list in test_runs.items():
-            # Get platforms where test passed and failed
-            passing_platforms = set()
-            failing_platforms = set()
-
-            for run in test_run_list:
-                platform = run["platform"]
-                if run["passed"]:
-                    passing_platforms.add(platform)
-                else:
-                    failing_platforms.add(platform)
-
-            # Platform-specific if fails on some platforms but passes on others
-            if failing_platforms and passing_platforms:
-                platform_failures.append(
-                    PlatformFailure(
-                        test_name=test_name,
-                        failing_platforms=sorted(list(failing_platforms)),
-                        passing_platforms=sorted(list(passing_platforms)),
-                    )
+            platform_failures.append(
+                PlatformFailure(
+                    test_name=test_name,
+                    failing_platforms=failing,
+                    passing_platforms=passing,
+                    p_value=min(failing_p_values.values()),
                 )
+            )
 
         return platform_failures
 
@@ -16,6 +16,7 @@ from sqlalchemy import select
 
 from scout.storage.schema import WorkflowJob
 from scout.storage.schema import WorkflowRun as DBWorkflowRun
+from scout.tracing import span
 
 if TYPE_CHECKING:
     from scout.providers.base import CIProvider
@@ -115,6 +116,22 @@ class GitHubActionsAPIClient:
 
         return self._session
 
+    def _get(self, url: str, **kwargs):
+        """
+        Send a GET request through the session, as a trace span.
+
+        Args:
+            url: Request URL
+            **kwargs: Arguments for requests.Session.get
+
+        Returns:
+            requests.Response
+        """
+        with span("scout.http.get", url=url.split("?", 1)[0]) as request_span:
+            response = self.session.get(url, **kwargs)
+            request_span.set_attribute("status_code", response.status_code)
+            return response
+
     def get_workflow_runs(
         self, workflow: Optional[str] = None, limit: Optional[int] = None, status: str = "completed"
     ) -> Iterator[WorkflowRun]:
@@ -140,7 +157,7 @@ class GitHubActionsAPIClient:
         count = 0
         while True:
             try:
-                response = self.session.get(url, params=params, timeout=self.timeout)
+                response = self._get(url, params=params, timeout=self.timeout)
                 response.raise_for_status()
             except Exception as e:
                 logger.error(f"Failed to get workflow runs: {e}")
@@ -198,7 +215,7 @@ class GitHubActionsAPIClient:
 
         while True:
             try:
-                response = self.session.get(url, params=params, timeout=self.timeout)
+                response = self._get(url, params=params, timeout=self.timeout)
                 response.raise_for_status()
             except Exception as e:
                 logger.error(f"Failed to get jobs for run {run_id}: {e}")
@@ -249,13 +266,13 @@ class GitHubActionsAPIClient:
         retry_count = 0
         while retry_count < self.retries:
             try:
-                response = self.session.get(url, timeout=self.timeout)
+                response = self._get(url, timeout=self.timeout)
 
                 # GitHub redirects to the actual log URL
                 if response.status_code == 302:
                     log_url = response.headers.get("Location")
                     if log_url:
-                        response = self.session.get(log_url, timeout=self.timeout)
+                        response = self._get(log_url, timeout=self.timeout)
 
                 response.raise_for_status()
                 return response.text
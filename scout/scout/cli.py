@@ -22,6 +22,7 @@ from scout.log_retrieval import LogRetriever
 from scout.providers.github_actions import GitHubActionsProvider
 from scout.repo_data_manager import RepoDataManager
 from scout.reporting import ConsoleReporter, CsvExporter, HtmlReporter, JsonExporter
+from scout.tracing import set_service_name
 
 
 class Config:
@@ -1032,6 +1033,7 @@ def main(argv=None) -> int:
         # dotenv not available, continue without it
         pass
 
+    set_service_name("scout")
     parser = create_parser()
 
     # Parse arguments
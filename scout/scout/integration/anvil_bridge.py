@@ -17,7 +17,17 @@ Architecture:
 import re
 import sys
 from pathlib import Path
-from typing import Any, Dict, List, Optional
+from typing import Any, Dict, List, Optional, Tuple
+
+try:
+    from anvil.parsers.log_scan import select_lines
+except ImportError:  # pragma: no cover - Anvil is optional
+    select_lines = None
+
+# Non-ASCII characters re.IGNORECASE matches to ASCII letters (İ and ı to "i",
+# ſ to "s", the Kelvin sign to "k"). The ASCII-only line prefilter is exact
+# only for logs without them.
+_IGNORECASE_EXTRAS = "\u0130\u0131\u017f\u212a"
 
 # Import Anvil parsers (lazy loading to avoid hard dependency)
 _ANVIL_PARSERS = None
@@ -114,7 +124,7 @@ class AnvilBridge:
         output: str,
         files: Optional[List[Path]] = None,
         output_format: str = "text",
-        **kwargs
+        **kwargs,
     ) -> Dict[str, Any]:
         """
         Parse validator output using Anvil's specialized parsers.
@@ -172,9 +182,7 @@ class AnvilBridge:
             elif validator_name == "pylint":
                 result = parser_class.parse_json(output, files)
             elif validator_name == "pytest":
-                result = parser_class.parse_json(
-                    output, files, config=kwargs.get("config", {})
-                )
+                result = parser_class.parse_json(output, files, config=kwargs.get("config", {}))
             elif validator_name == "autoflake":
                 result = parser_class.parse_text(output, files)
             elif validator_name == "vulture":
@@ -284,6 +292,28 @@ class AnvilLogExtractor:
         },
     }
 
+    # Text every start marker contains, in any case. Only lines holding one
+    # are searched for start markers, so new start patterns must contain one.
+    START_MARKER_NEEDLES = ("running", "executing", "test session starts")
+
+    @staticmethod
+    def _start_marker_lines(log_content: str) -> Optional[List[Tuple[int, int]]]:
+        """
+        Find the lines of a log that can hold a start marker.
+
+        Args:
+            log_content: Full CI job log content
+
+        Returns:
+            (start, end) offsets of the candidate lines, or None if the whole
+            log has to be searched
+        """
+        if select_lines is None:
+            return None
+        if not log_content.isascii() and any(c in log_content for c in _IGNORECASE_EXTRAS):
+            return None
+        return select_lines(log_content, AnvilLogExtractor.START_MARKER_NEEDLES, ignore_case=True)
+
     @staticmethod
     def extract_validator_output(log_content: str, validator_name: str) -> Optional[str]:
         """
@@ -303,20 +333,27 @@ class AnvilLogExtractor:
         start_pattern = pattern["start"]
         end_pattern = pattern["end"]
 
-        # Find start marker
-        start_match = re.search(start_pattern, log_content, re.IGNORECASE)
+        # Find start marker; markers never span lines, so only candidate lines are searched
+        start_regex = re.compile(start_pattern, re.IGNORECASE)
+        lines = AnvilLogExtractor._start_marker_lines(log_content)
+        if lines is None:
+            start_match = start_regex.search(log_content)
+        else:
+            start_match = next(
+                filter(None, (start_regex.search(log_content, s, e) for s, e in lines)), None
+            )
         if not start_match:
             return None
 
         start_pos = start_match.start()
 
         # Find end marker (search from start position)
-        end_match = re.search(end_pattern, log_content[start_pos:], re.IGNORECASE)
+        end_match = re.compile(end_pattern, re.IGNORECASE).search(log_content, start_pos)
         if not end_match:
             # No end marker found, take rest of log
             return log_content[start_pos:]
 
-        end_pos = start_pos + end_match.end()
+        end_pos = end_match.end()
         return log_content[start_pos:end_pos]
 
     @staticmethod
@@ -330,6 +367,10 @@ class AnvilLogExtractor:
         Returns:
             List of detected validator names
         """
+        lines = AnvilLogExtractor._start_marker_lines(log_content)
+        if lines is not None:
+            log_content = "\n".join(log_content[start:end] for start, end in lines)
+
         detected = []
         for validator_name, pattern in AnvilLogExtractor.VALIDATOR_PATTERNS.items():
             if re.search(pattern["start"], log_content, re.IGNORECASE):
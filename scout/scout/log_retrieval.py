@@ -5,14 +5,23 @@ This module handles downloading logs from CI providers, parsing them
 (removing ANSI codes, extracting timestamps), and caching them locally.
 """
 
+import os
 import re
+import tempfile
+from contextlib import contextmanager
 from dataclasses import dataclass
 from datetime import datetime
 from pathlib import Path
-from typing import List, Optional
+from typing import Iterable, List, Optional
 
 from scout.providers.base import CIProvider, LogEntry
 
+try:
+    from anvil.parsers.log_scan import index_lines, select_lines, strip_ansi
+    from anvil.parsers.log_view import LogView
+except ImportError:  # pragma: no cover - Anvil is optional
+    index_lines = select_lines = strip_ansi = LogView = None
+
 
 @dataclass
 class WorkflowLog:
@@ -58,6 +67,9 @@ class LogParser:
         re.compile(r"\[(\d{10})\]"),
     ]
 
+    # Every TIMESTAMP_PATTERNS match contains one of these
+    TIMESTAMP_MARKERS = (":", "[")
+
     @classmethod
     def remove_ansi_codes(cls, text: str) -> str:
         """
@@ -73,6 +85,8 @@ class LogParser:
             >>> LogParser.remove_ansi_codes("\\x1b[31mError\\x1b[0m")
             'Error'
         """
+        if strip_ansi is not None:
+            return strip_ansi(text)
         return cls.ANSI_PATTERN.sub("", text)
 
     @classmethod
@@ -94,6 +108,9 @@ class LogParser:
             >>> ts.year
             2026
         """
+        if not any(marker in line for marker in cls.TIMESTAMP_MARKERS):
+            return None
+
         for pattern in cls.TIMESTAMP_PATTERNS:
             match = pattern.search(line)
             if match:
@@ -134,12 +151,15 @@ class LogParser:
             '2026-02-01T10:30:45Z Build started'
         """
         entries = []
-        lines = raw_log.splitlines()
-
-        for line_num, line in enumerate(lines, start=1):
-            # Remove ANSI codes
-            clean_line = cls.remove_ansi_codes(line)
+        # Escape sequences never span or contain line breaks, so stripping the
+        # whole log once gives the same lines as stripping each line. The
+        # line index does both in one pass and slices each line on demand.
+        if index_lines is not None:
+            lines = index_lines(raw_log)
+        else:
+            lines = cls.remove_ansi_codes(raw_log).splitlines()
 
+        for line_num, clean_line in enumerate(lines, start=1):
             # Skip empty lines
             if not clean_line.strip():
                 continue
@@ -154,6 +174,25 @@ class LogParser:
         return entries
 
 
+def _parse_cache_line(line: str) -> Optional[LogEntry]:
+    """Parse a "timestamp|line_number|content" cache line, or None if malformed."""
+    parts = line.split("|", 2)
+    if len(parts) != 3:
+        return None
+    timestamp_str, line_num_str, content = parts
+    timestamp = None
+    if timestamp_str != "None":
+        try:
+            timestamp = datetime.fromisoformat(timestamp_str)
+        except ValueError:
+            pass
+    try:
+        line_number = int(line_num_str)
+    except ValueError:
+        return None
+    return LogEntry(timestamp=timestamp, line_number=line_number, content=content)
+
+
 class LogCache:
     """
     Local cache for downloaded logs.
@@ -239,14 +278,14 @@ class LogCache:
         log_path.parent.mkdir(parents=True, exist_ok=True)
 
         # Save log entries
-        with open(log_path, "w", encoding="utf-8") as f:
+        with self._replace(log_path) as f:
             for entry in workflow_log.entries:
                 # Format: timestamp|line_number|content
                 timestamp_str = entry.timestamp.isoformat() if entry.timestamp else "None"
                 f.write(f"{timestamp_str}|{entry.line_number}|{entry.content}\n")
 
         # Save metadata
-        with open(metadata_path, "w", encoding="utf-8") as f:
+        with self._replace(metadata_path) as f:
             f.write(f"run_id={workflow_log.run_id}\n")
             f.write(f"job_id={workflow_log.job_id}\n")
             f.write(f"job_name={workflow_log.job_name}\n")
@@ -254,6 +293,25 @@ class LogCache:
             f.write(f"raw_size={workflow_log.raw_size}\n")
             f.write(f"parsed_size={workflow_log.parsed_size}\n")
 
+    @staticmethod
+    @contextmanager
+    def _replace(path: Path):
+        """
+        Write a file through a temporary file that then replaces it.
+
+        Readers never see a truncated file, and a file that is memory-mapped
+        elsewhere (by search()) keeps its old contents instead of shrinking
+        under the mapping.
+        """
+        fd, temp_path = tempfile.mkstemp(dir=path.parent, prefix=f".{path.name}.")
+        try:
+            with os.fdopen(fd, "w", encoding="utf-8") as f:
+                yield f
+            os.replace(temp_path, path)
+        except BaseException:
+            os.unlink(temp_path)
+            raise
+
     def load(self, run_id: str, job_id: str) -> Optional[WorkflowLog]:
         """
         Load a log from the cache.
@@ -285,29 +343,7 @@ class LogCache:
                     key, value = line.strip().split("=", 1)
                     metadata[key] = value
 
-        # Load log entries
-        entries = []
-        with open(log_path, "r", encoding="utf-8") as f:
-            for line in f:
-                parts = line.rstrip("\n").split("|", 2)
-                if len(parts) == 3:
-                    timestamp_str, line_num_str, content = parts
-
-                    # Parse timestamp
-                    timestamp = None
-                    if timestamp_str != "None":
-                        try:
-                            timestamp = datetime.fromisoformat(timestamp_str)
-                        except ValueError:
-                            pass
-
-                    # Create entry
-                    entry = LogEntry(
-                        timestamp=timestamp,
-                        line_number=int(line_num_str),
-                        content=content,
-                    )
-                    entries.append(entry)
+        entries = self._read_entries(log_path)
 
         # Create WorkflowLog
         return WorkflowLog(
@@ -320,6 +356,70 @@ class LogCache:
             parsed_size=int(metadata["parsed_size"]),
         )
 
+    def search(
+        self, run_id: str, job_id: str, needles: Iterable[str], ignore_case: bool = False
+    ) -> List[LogEntry]:
+        """
+        Find cached log entries whose content contains any of the needles.
+
+        With Anvil available, the cache file is memory-mapped and only
+        matching lines are decoded.
+
+        Args:
+            run_id: Workflow run ID
+            job_id: Job ID
+            needles: Substrings to look for
+            ignore_case: Match ASCII letters in either case
+
+        Returns:
+            Matching entries in log order (empty if the log is not cached)
+        """
+        if not self.is_cached(run_id, job_id):
+            return []
+        needles = list(needles)
+        log_path = self._get_log_path(run_id, job_id)
+
+        if LogView is None:
+            if ignore_case:
+                needles = [n.lower() for n in needles]
+            entries = []
+            for entry in self._read_entries(log_path):
+                content = entry.content.lower() if ignore_case else entry.content
+                if any(n in content for n in needles):
+                    entries.append(entry)
+            return entries
+
+        with LogView.open(log_path) as view:
+            entries = []
+            # The needles may also match the timestamp and line number prefix.
+            for _, line in view.grep(needles, ignore_case):
+                entry = _parse_cache_line(line)
+                if entry is not None and select_lines(entry.content, needles, ignore_case):
+                    entries.append(entry)
+            return entries
+
+    @staticmethod
+    def _read_entries(log_path: Path) -> List[LogEntry]:
+        """
+        Read every entry of a cache file into memory, skipping malformed lines.
+
+        With Anvil available the file is memory-mapped for the read and
+        unmapped before returning, so no mapping outlives the call.
+        """
+        if LogView is not None:
+            with LogView.open(log_path) as view:
+                lines = list(view)
+        else:
+            with open(log_path, "r", encoding="utf-8") as f:
+                lines = [line.rstrip("\n") for line in f]
+
+        entries = []
+        for line in lines:
+            entry = _parse_cache_line(line)
+            if entry is not None:
+                entries.append(entry)
+        return entries
+
     def clear(self, run_id: Optional[str] = None) -> int:
         """
         Clear cached logs.
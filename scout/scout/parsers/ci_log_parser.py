@@ -9,7 +9,12 @@ Parses CI logs from various sources (GitHub Actions, etc.) to extract:
 """
 
 import re
-from typing import Dict, List, Optional
+from typing import Dict, Iterator, List, Optional
+
+try:
+    from anvil.parsers.log_scan import select_lines
+except ImportError:  # pragma: no cover - Anvil is optional
+    select_lines = None
 
 
 class CILogParser:
@@ -57,7 +62,7 @@ class CILogParser:
         )
 
         # Find all test results
-        for match in test_pattern.finditer(log_content):
+        for match in self._match_line_starts(test_pattern, log_content, "::"):
             filepath = match.group(1).strip()
             test_name = match.group(2)
             outcome = match.group(3).lower()
@@ -82,6 +87,37 @@ class CILogParser:
 
         return results
 
+    @staticmethod
+    def _match_line_starts(
+        pattern: re.Pattern, log_content: str, needle: str
+    ) -> Iterator[re.Match]:
+        """
+        Find the matches of a line-anchored pattern, like pattern.finditer().
+
+        The pattern must start with ^ (in MULTILINE mode) and contain needle
+        on its first line. It is then only tried at the starts of the lines
+        holding needle, which skips most of a large log.
+
+        Args:
+            pattern: Compiled pattern starting with ^
+            log_content: Text to search
+            needle: Literal text every match has on its first line
+
+        Yields:
+            Non-overlapping matches in order
+        """
+        if select_lines is None:
+            yield from pattern.finditer(log_content)
+            return
+        end = 0
+        for start, _ in select_lines(log_content, (needle,)):
+            if start < end:
+                continue
+            match = pattern.match(log_content, start)
+            if match:
+                end = match.end()
+                yield match
+
     def _extract_failure_details(self, log_content: str, results: List[Dict]) -> None:
         """
         Extract failure details (error messages and tracebacks) from log.
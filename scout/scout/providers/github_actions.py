@@ -13,6 +13,7 @@ import requests
 from requests.exceptions import HTTPError, RequestException, Timeout  # noqa: F401
 
 from scout.providers.base import CIProvider, Job, LogEntry, WorkflowRun
+from scout.tracing import span
 
 
 class GitHubActionsProvider(CIProvider):
@@ -67,6 +68,22 @@ class GitHubActionsProvider(CIProvider):
             headers["Authorization"] = f"token {self.token}"
         return headers
 
+    def _get(self, url: str, **kwargs) -> requests.Response:
+        """
+        Send a GET request, as a trace span.
+
+        Args:
+            url: Request URL
+            **kwargs: Arguments for requests.get
+
+        Returns:
+            HTTP response
+        """
+        with span("scout.http.get", url=url.split("?", 1)[0]) as request_span:
+            response = requests.get(url, **kwargs)
+            request_span.set_attribute("status_code", response.status_code)
+            return response
+
     def _parse_timestamp(self, timestamp_str: str) -> datetime:
         """
         Parse ISO 8601 timestamp from GitHub API.
@@ -107,7 +124,7 @@ class GitHubActionsProvider(CIProvider):
         query_string = urlencode(params)
         full_url = f"{url}?{query_string}"
 
-        response = requests.get(full_url, headers=self._get_headers())
+        response = self._get(full_url, headers=self._get_headers())
         response.raise_for_status()
 
         data = response.json()
@@ -154,7 +171,7 @@ class GitHubActionsProvider(CIProvider):
         """
         url = f"{self.BASE_URL}/repos/{self.owner}/{self.repo}/actions/runs/{run_id}"
 
-        response = requests.get(url, headers=self._get_headers())
+        response = self._get(url, headers=self._get_headers())
         response.raise_for_status()
 
         data = response.json()
@@ -188,7 +205,7 @@ class GitHubActionsProvider(CIProvider):
         """
         url = f"{self.BASE_URL}/repos/{self.owner}/{self.repo}/actions/runs/{run_id}/jobs"
 
-        response = requests.get(url, headers=self._get_headers())
+        response = self._get(url, headers=self._get_headers())
         response.raise_for_status()
 
         data = response.json()
@@ -229,7 +246,7 @@ class GitHubActionsProvider(CIProvider):
         """
         url = f"{self.BASE_URL}/repos/{self.owner}/{self.repo}/actions/jobs/{job_id}/logs"
 
-        response = requests.get(url, headers=self._get_headers())
+        response = self._get(url, headers=self._get_headers())
         response.raise_for_status()
 
         # GitHub returns logs as plain text
@@ -303,7 +320,7 @@ class GitHubActionsProvider(CIProvider):
         query_string = urlencode(params)
         full_url = f"{url}?{query_string}"
 
-        response = requests.get(full_url, headers=self._get_headers())
+        response = self._get(full_url, headers=self._get_headers())
         response.raise_for_status()
 
         data = response.json()
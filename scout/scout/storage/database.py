@@ -8,11 +8,34 @@ and managing the Scout CI data database.
 from pathlib import Path
 from typing import Optional
 
-from sqlalchemy import create_engine
+from sqlalchemy import create_engine, event
 from sqlalchemy.engine import Engine
 from sqlalchemy.orm import Session, sessionmaker
 
 from scout.storage.schema import Base
+from scout.tracing import span
+
+
+def _trace_transactions(session_factory: sessionmaker) -> None:
+    """
+    Time each session transaction as a scout.db.transaction trace span.
+
+    Args:
+        session_factory: Factory whose sessions are traced
+    """
+
+    def begin(session, transaction, connection):
+        if "trace_span" not in session.info:
+            session.info["trace_span"] = span("scout.db.transaction")
+
+    def finish(session):
+        transaction_span = session.info.pop("trace_span", None)
+        if transaction_span is not None:
+            transaction_span.end()
+
+    event.listen(session_factory, "after_begin", begin)
+    event.listen(session_factory, "after_commit", finish)
+    event.listen(session_factory, "after_rollback", finish)
 
 
 class DatabaseManager:
@@ -87,6 +110,7 @@ class DatabaseManager:
 
         # Create session factory
         self._session_factory = sessionmaker(bind=self._engine)
+        _trace_transactions(self._session_factory)
 
     def get_session(self) -> Session:
         """
@@ -12,6 +12,9 @@ Tests analysis algorithms including:
 
 from datetime import datetime, timedelta
 
+import pytest
+
+from scout import analysis
 from scout.analysis import (
     AnalysisEngine,
     FailureGroup,
@@ -293,6 +296,44 @@ class TestPlatformSpecificFailures:
 
         assert len(platform_failures) == 0
 
+    @pytest.mark.skipif(analysis.fisher_exact_greater is None, reason="Anvil is required")
+    def test_compiler_and_build_type_split_platforms(self):
+        """Test C++ matrix jobs are told apart by compiler and build type."""
+        engine = AnalysisEngine()
+
+        runs = [
+            {
+                "test_name": "test_locale",
+                "platform": "windows-latest",
+                "compiler": compiler,
+                "build_type": "Release",
+                "passed": compiler != "msvc",
+            }
+            for compiler in ("msvc", "clang")
+            for _ in range(5)
+        ]
+
+        (platform_failure,) = engine.detect_platform_specific_failures(runs)
+
+        assert platform_failure.failing_platforms == ["windows-latest-msvc-Release"]
+        assert platform_failure.passing_platforms == ["windows-latest-clang-Release"]
+        # One arrangement in C(10, 5) puts all five failures with MSVC
+        assert platform_failure.p_value == pytest.approx(1 / 252)
+
+    @pytest.mark.skipif(analysis.fisher_exact_greater is None, reason="Anvil is required")
+    def test_max_p_value_drops_insignificant_platforms(self):
+        """Test a single failure is not significant while a consistent one is."""
+        engine = AnalysisEngine()
+
+        runs = [{"test_name": "test_path", "platform": "windows", "passed": False}] * 6
+        runs += [{"test_name": "test_path", "platform": "linux", "passed": True}] * 6
+        runs += [{"test_name": "test_signal", "platform": "linux", "passed": False}]
+        runs += [{"test_name": "test_signal", "platform": "macos", "passed": True}] * 2
+
+        platform_failures = engine.detect_platform_specific_failures(runs, max_p_value=0.05)
+
+        assert [failure.test_name for failure in platform_failures] == ["test_path"]
+
 
 class TestFailureGrouping:
     """Test failure grouping by similarity."""
@@ -0,0 +1,56 @@
+"""
+Tests for extracting validator output from CI logs.
+
+Covers start and end markers and the line prefilter that limits the start
+marker search to lines mentioning "running", "executing" or a pytest
+session.
+"""
+
+import pytest
+
+from scout.integration import anvil_bridge
+from scout.integration.anvil_bridge import AnvilLogExtractor
+
+LOG = (
+    "Set up job\n"
+    "Executing BLACK --check .\n"
+    "would reformat a.py\n"
+    "--- done\n"
+    "Running flake8\n"
+    "a.py:1:1: F401 unused import\n"
+    "flake8 failed\n"
+    "============================= test session starts ==============================\n"
+    "tests/test_a.py::test_one PASSED\n"
+    "============================== 1 passed in 0.01s ===============================\n"
+)
+
+
+class TestAnvilLogExtractor:
+    """Tests for AnvilLogExtractor."""
+
+    def test_extract_and_detect(self):
+        """Test extraction between markers and detection of validators."""
+        assert AnvilLogExtractor.extract_validator_output(LOG, "black") == (
+            "Executing BLACK --check .\nwould reformat a.py\n---"
+        )
+        assert AnvilLogExtractor.extract_validator_output(LOG, "flake8").endswith("flake8 failed")
+        assert AnvilLogExtractor.extract_validator_output(LOG, "pylint") is None
+        assert AnvilLogExtractor.detect_validators_in_log(LOG) == ["black", "flake8", "pytest"]
+
+    @pytest.mark.parametrize(
+        "log_content",
+        [LOG, LOG.replace("Running", "RUNNİNG"), "Executing isortK\n" + LOG, ""],
+    )
+    def test_prefilter_matches_full_search(self, log_content, monkeypatch):
+        """Test the prefiltered search agrees with searching the whole log."""
+        pytest.importorskip("anvil.parsers.log_scan")
+        names = list(AnvilLogExtractor.VALIDATOR_PATTERNS)
+        outputs = [AnvilLogExtractor.extract_validator_output(log_content, n) for n in names]
+        detected = AnvilLogExtractor.detect_validators_in_log(log_content)
+
+        monkeypatch.setattr(anvil_bridge, "select_lines", None)
+
+        assert [AnvilLogExtractor.extract_validator_output(log_content, n) for n in names] == (
+            outputs
+        )
+        assert AnvilLogExtractor.detect_validators_in_log(log_content) == detected
@@ -7,6 +7,7 @@ coverage data, and failure patterns from CI logs.
 
 import pytest
 
+from scout.parsers import ci_log_parser
 from scout.parsers.ci_log_parser import CILogParser
 
 
@@ -247,6 +248,30 @@ collected 0 items
         results = parser.parse_pytest_log(log_content)
         assert results == []
 
+    def test_line_prefilter_matches_full_scan(self, parser, monkeypatch):
+        """Test that matching only at lines with '::' finds the same results."""
+        pytest.importorskip("anvil.parsers.log_scan")
+        log_content = (
+            "tests/test_a.py::test_one PASSED [ 25%]\n"
+            "tests/test_a.py::test_split\n"
+            "PASSED\n"
+            "tests/test_b.py::test_two FAILED tests/test_b.py::test_three PASSED\n"
+            "not a result: tests/test_c.py::test_four PASSED\n"
+            "tests/test_c.py::test_five SKIPPED\n"
+        )
+        results = parser.parse_pytest_log(log_content)
+
+        monkeypatch.setattr(ci_log_parser, "select_lines", None)
+
+        assert parser.parse_pytest_log(log_content) == results
+        assert [r["test_nodeid"] for r in results] == [
+            "tests/test_a.py::test_one",
+            "tests/test_a.py::test_split",
+            "tests/test_b.py::test_two",
+            "not a result: tests/test_c.py::test_four",
+            "tests/test_c.py::test_five",
+        ]
+
 
 class TestCoverageLogParsing:
     """Test parsing coverage output from CI logs."""
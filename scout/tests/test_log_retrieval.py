@@ -105,6 +105,23 @@ class TestLogParser:
         assert entries[0].content == "Success"
         assert entries[1].content == "Error"
 
+    def test_parse_log_lines_strips_whole_log_once(self):
+        """Test that stripping the whole log keeps per-line numbering and content."""
+        raw_log = "\x1b[1mA\x1b[0m\r\n\x1b[2Kb\x0bc\u2028\x1b[31md\x1b[ e\n\n\x1b[0m\nf"
+        entries = LogParser.parse_log_lines(raw_log)
+
+        expected = [
+            (number, LogParser.ANSI_PATTERN.sub("", line))
+            for number, line in enumerate(raw_log.splitlines(), start=1)
+            if LogParser.ANSI_PATTERN.sub("", line).strip()
+        ]
+        assert [(e.line_number, e.content) for e in entries] == expected
+
+    def test_extract_timestamp_without_markers(self):
+        """Test that lines without ':' or '[' have no timestamp."""
+        assert LogParser.extract_timestamp("2026-02-01 build 1234567890") is None
+        assert LogParser.extract_timestamp("at [1767225600]") is not None
+
     def test_parse_log_lines_with_timestamps(self):
         """Test parsing log lines with timestamps."""
         raw_log = "2026-02-01T10:30:45Z Build started\n" "2026-02-01T10:30:50Z Build completed"
@@ -289,6 +306,122 @@ class TestLogCache:
             assert not cache.is_cached("run1", "job1")
             assert not cache.is_cached("run2", "job2")
 
+    def test_load_supports_indexing(self):
+        """Test loaded entries support len, indexing and slicing."""
+        with tempfile.TemporaryDirectory() as tmpdir:
+            cache = LogCache(Path(tmpdir))
+            entries = [
+                LogEntry(timestamp=None, line_number=i, content=f"line {i}") for i in range(1, 6)
+            ]
+            cache.save(
+                WorkflowLog(
+                    run_id="run1",
+                    job_id="job1",
+                    job_name="Test",
+                    entries=entries,
+                    retrieved_at=datetime.now(),
+                    raw_size=50,
+                    parsed_size=50,
+                )
+            )
+
+            loaded = cache.load("run1", "job1")
+
+            assert len(loaded.entries) == 5
+            assert loaded.entries[-1].content == "line 5"
+            assert [e.line_number for e in loaded.entries[1:3]] == [2, 3]
+            assert [e.content for e in loaded.entries] == [e.content for e in entries]
+
+    def test_save_after_load(self):
+        """Test re-saving a loaded log leaves the loaded entries readable."""
+        with tempfile.TemporaryDirectory() as tmpdir:
+            cache = LogCache(Path(tmpdir))
+
+            def workflow_log(count, prefix):
+                return WorkflowLog(
+                    run_id="run1",
+                    job_id="job1",
+                    job_name="Test",
+                    entries=[
+                        LogEntry(timestamp=None, line_number=i, content=f"{prefix} {i}")
+                        for i in range(1, count + 1)
+                    ],
+                    retrieved_at=datetime.now(),
+                    raw_size=50,
+                    parsed_size=50,
+                )
+
+            cache.save(workflow_log(1000, "old"))
+            loaded = cache.load("run1", "job1")
+
+            # A shorter log truncated a mapped file in place before
+            cache.save(workflow_log(2, "new"))
+
+            assert len(loaded.entries) == 1000
+            assert loaded.entries[-1].content == "old 1000"
+            assert [e.content for e in cache.load("run1", "job1").entries] == ["new 1", "new 2"]
+            assert sorted(p.name for p in (Path(tmpdir) / "run1").iterdir()) == [
+                "job1.log",
+                "job1.meta",
+            ]
+
+    def test_load_skips_malformed_lines(self):
+        """Test lines that are not cache entries are skipped."""
+        with tempfile.TemporaryDirectory() as tmpdir:
+            cache = LogCache(Path(tmpdir))
+            cache.save(
+                WorkflowLog(
+                    run_id="run1",
+                    job_id="job1",
+                    job_name="Test",
+                    entries=[LogEntry(timestamp=None, line_number=1, content="first")],
+                    retrieved_at=datetime.now(),
+                    raw_size=50,
+                    parsed_size=50,
+                )
+            )
+            with open(Path(tmpdir) / "run1" / "job1.log", "a", encoding="utf-8") as f:
+                f.write("not a cache line\nNone|x|bad number\n")
+
+            loaded = cache.load("run1", "job1")
+
+            assert [(e.line_number, e.content) for e in loaded.entries] == [(1, "first")]
+
+    def test_search_cached_log(self):
+        """Test search returns only entries whose content matches."""
+        with tempfile.TemporaryDirectory() as tmpdir:
+            cache = LogCache(Path(tmpdir))
+            entries = [
+                LogEntry(
+                    timestamp=datetime(2026, 2, 1, 10, 30, 45),
+                    line_number=1,
+                    content="Compiling",
+                ),
+                LogEntry(timestamp=None, line_number=2, content="ERROR: link failed"),
+                LogEntry(timestamp=None, line_number=3, content="error count 1"),
+            ]
+            cache.save(
+                WorkflowLog(
+                    run_id="run1",
+                    job_id="job1",
+                    job_name="Test",
+                    entries=entries,
+                    retrieved_at=datetime.now(),
+                    raw_size=50,
+                    parsed_size=50,
+                )
+            )
+
+            found = cache.search("run1", "job1", ["error"])
+            assert [e.line_number for e in found] == [3]
+
+            found = cache.search("run1", "job1", ["error"], ignore_case=True)
+            assert [e.content for e in found] == ["ERROR: link failed", "error count 1"]
+
+            # The timestamp prefix of the cache line is not searched
+            assert cache.search("run1", "job1", ["2026"]) == []
+            assert cache.search("missing", "job1", ["error"]) == []
+
 
 class TestLogRetriever:
     """Test the LogRetriever class."""
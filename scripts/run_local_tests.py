@@ -125,6 +125,7 @@ def store_coverage_data(db, execution_id, coverage_file, space, timestamp):
             covered_statements=file_cov.covered_statements,
             coverage_percentage=file_cov.coverage_percentage,
             missing_lines=file_cov.missing_lines,
+            covered_lines=file_cov.covered_lines,
             space=space,
         )
         db.insert_coverage_history(history)
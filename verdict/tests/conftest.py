@@ -142,3 +142,84 @@ def failing_callable(input_text: str) -> dict:
         ValueError: Always raised
     """
     raise ValueError("Something went wrong")
+
+
+def sleeping_callable(input_text: str) -> dict:
+    """
+    Callable that sleeps for the number of seconds given as input (for testing).
+
+    Args:
+        input_text: Sleep duration in seconds
+
+    Returns:
+        Dictionary with the slept duration
+    """
+    import time
+
+    time.sleep(float(input_text))
+    return {"slept": float(input_text)}
+
+
+def spinning_callable(input_text: str) -> dict:
+    """
+    Callable that burns CPU for the number of seconds given as input (for testing).
+
+    Args:
+        input_text: Busy-loop duration in seconds
+
+    Returns:
+        Dictionary with the number of loop iterations
+    """
+    import time
+
+    deadline = time.perf_counter() + float(input_text)
+    iterations = 0
+    while time.perf_counter() < deadline:
+        iterations += 1
+    return {"iterations": iterations}
+
+
+def allocating_callable(input_text: str) -> dict:
+    """
+    Callable that allocates the number of MiB given as input (for testing).
+
+    Args:
+        input_text: Allocation size in MiB
+
+    Returns:
+        Dictionary with the allocated size
+    """
+    block = bytearray(int(input_text) * 1024 * 1024)
+    return {"allocated": len(block)}
+
+
+_retained_blocks = []
+
+
+def retaining_callable(input_text: str) -> dict:
+    """
+    Callable that allocates the number of MiB given as input and keeps it (for testing).
+
+    Args:
+        input_text: Allocation size in MiB
+
+    Returns:
+        Dictionary with the total size retained by this process
+    """
+    _retained_blocks.append(bytearray(int(input_text) * 1024 * 1024))
+    return {"retained": sum(len(block) for block in _retained_blocks)}
+
+
+def crashing_callable(input_text: str) -> dict:
+    """
+    Callable that terminates its process abruptly (for testing).
+
+    Args:
+        input_text: Ignored
+
+    Raises:
+        SystemExit: Never returns; the process exits immediately
+    """
+    import os
+
+    os._exit(3)
@@ -169,3 +169,12 @@ class TestTargetExecutor:
         assert "text" in result
         assert "length" in result
         assert "dummy" in result
+
+    def test_execute_with_usage_error_reports_cpu_time(self):
+        """Test that exceptions from execute_with_usage carry the CPU time spent."""
+        executor = TargetExecutor()
+
+        with pytest.raises(Exception, match="Something went wrong") as excinfo:
+            executor.execute_with_usage("tests.conftest.failing_callable", "test")
+
+        assert excinfo.value.cpu_time >= 0
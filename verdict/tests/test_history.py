@@ -0,0 +1,220 @@
+"""
+Tests for verdict.history module.
+
+Tests ResultHistory persistence, regression and flakiness detection, and
+duration-based scheduling in TestRunner.
+"""
+
+import json
+import sys
+from unittest.mock import patch
+
+import pytest
+import yaml
+
+from verdict.cli import main
+from verdict.history import ResultHistory
+from verdict.runner import TestResult, TestRunner
+
+
+def _result(name: str, duration: float, passed: bool = True, suite: str = "suite") -> TestResult:
+    """Create a TestResult with the given duration."""
+    return TestResult(name, suite, passed, duration=duration)
+
+
+@pytest.fixture
+def history(temp_dir):
+    """Create a ResultHistory in a temporary directory."""
+    with ResultHistory(temp_dir / "history" / "history.db") as history:
+        yield history
+
+
+class TestResultHistory:
+    """Test suite for ResultHistory class."""
+
+    def test_creates_database(self, temp_dir):
+        """Test that the database and parent directories are created."""
+        db_path = temp_dir / ".verdict" / "history.db"
+        with ResultHistory(db_path):
+            pass
+
+        assert db_path.exists()
+
+    def test_record_run(self, history):
+        """Test recording runs and counting them."""
+        history.record_run([_result("a", 0.1), _result("b", 0.2)])
+        history.record_run([_result("a", 0.1)])
+
+        assert history.get_run_count() == 2
+
+    def test_history_persists_across_instances(self, temp_dir):
+        """Test that recorded results survive reopening the database."""
+        db_path = temp_dir / "history.db"
+        with ResultHistory(db_path) as history:
+            history.record_run([_result("a", 0.3)])
+
+        with ResultHistory(db_path) as history:
+            assert history.get_expected_durations("suite") == {"a": 0.3}
+
+    def test_expected_durations_use_recent_median(self, history):
+        """Test that expected durations are the median of the recent window."""
+        for duration in [5.0, 0.1, 0.2, 0.3]:
+            history.record_run([_result("a", duration)])
+
+        assert history.get_expected_durations("suite", window=3) == {"a": 0.2}
+
+    def test_expected_durations_filter_by_suite(self, history):
+        """Test that expected durations only include the requested suite."""
+        history.record_run([_result("a", 0.1, suite="s1"), _result("b", 0.2, suite="s2")])
+
+        assert history.get_expected_durations("s2") == {"b": 0.2}
+
+    def test_slowest_cases(self, history):
+        """Test that slowest cases are sorted by median duration."""
+        history.record_run([_result("fast", 0.01), _result("slow", 1.0), _result("mid", 0.5)])
+
+        slowest = history.get_slowest_cases(limit=2)
+
+        assert [c["test_name"] for c in slowest] == ["slow", "mid"]
+
+    def test_regressed_cases(self, history):
+        """Test that a case much slower than its baseline is reported."""
+        for _ in range(3):
+            history.record_run([_result("stable", 0.1), _result("regressed", 0.1)])
+        history.record_run([_result("stable", 0.11), _result("regressed", 0.5)])
+
+        regressed = history.get_regressed_cases()
+
+        assert [c["test_name"] for c in regressed] == ["regressed"]
+        assert regressed[0]["ratio"] == pytest.approx(5.0)
+        assert regressed[0]["baseline_duration"] == pytest.approx(0.1)
+
+    def test_regression_ignores_timer_noise(self, history):
+        """Test that tiny absolute slowdowns on fast cases are ignored."""
+        history.record_run([_result("tiny", 0.0001)])
+        history.record_run([_result("tiny", 0.001)])
+
+        assert history.get_regressed_cases() == []
+
+    def test_flaky_cases(self, history):
+        """Test that cases flipping between pass and fail are reported."""
+        for passed in [True, False, True, True]:
+            history.record_run([_result("flaky", 0.1, passed), _result("steady", 0.1)])
+
+        flaky = history.get_flaky_cases()
+
+        assert len(flaky) == 1
+        assert flaky[0]["test_name"] == "flaky"
+        assert flaky[0]["flips"] == 2
+        assert flaky[0]["pass_rate"] == pytest.approx(0.75)
+
+
+class TestDurationScheduling:
+    """Test suite for history-driven scheduling in TestRunner."""
+
+    def test_results_include_duration(self, temp_dir):
+        """Test that executed cases record a non-negative duration."""
+        config_file = _write_suite(temp_dir, ["one"])
+
+        results = TestRunner(config_file).run_all(max_workers=1)
+
+        assert results[0].duration >= 0
+        assert "duration" in results[0].to_dict()
+
+    def test_schedule_longest_first(self, temp_dir, history):
+        """Test that cases are ordered by historical duration, unknown first."""
+        history.record_run([_result("short", 0.1), _result("long", 2.0)])
+        runner = TestRunner(_write_suite(temp_dir, ["short"]), history=history)
+
+        cases = [{"name": "short"}, {"name": "new"}, {"name": "long"}]
+        ordered = runner._schedule_by_duration(cases, "suite")
+
+        assert [c["name"] for c in ordered] == ["new", "long", "short"]
+
+
+class TestHistoryCLI:
+    """Test suite for history-related CLI commands."""
+
+    def test_run_records_history(self, temp_dir):
+        """Test that verdict run --history records every case."""
+        config_file = _write_suite(temp_dir, ["one", "two"])
+        db_path = temp_dir / "history.db"
+
+        argv = ["verdict", "run", "--config", str(config_file), "--history", str(db_path)]
+        with patch.object(sys, "argv", argv):
+            assert main() == 0
+
+        with ResultHistory(db_path) as history:
+            assert history.get_run_count() == 1
+            assert set(history.get_expected_durations("suite")) == {"one", "two"}
+
+    def test_run_uses_history_setting(self, temp_dir):
+        """Test that settings.history is resolved relative to the config file."""
+        config_file = _write_suite(temp_dir, ["one"], settings={"history": "db/history.db"})
+
+        with patch.object(sys, "argv", ["verdict", "run", "--config", str(config_file)]):
+            assert main() == 0
+
+        assert (temp_dir / "db" / "history.db").exists()
+
+    def test_history_command_json(self, temp_dir, capsys):
+        """Test that verdict history reports recorded cases as JSON."""
+        db_path = temp_dir / "history.db"
+        with ResultHistory(db_path) as history:
+            history.record_run([_result("a", 0.1), _result("b", 0.4)])
+
+        with patch.object(
+            sys, "argv", ["verdict", "history", "--history", str(db_path), "--format", "json"]
+        ):
+            assert main() == 0
+
+        report = json.loads(capsys.readouterr().out)
+        assert report["runs"] == 1
+        assert report["slowest"][0]["test_name"] == "b"
+
+    def test_history_command_console(self, temp_dir, capsys):
+        """Test that verdict history prints all report sections."""
+        db_path = temp_dir / "history.db"
+        with ResultHistory(db_path) as history:
+            history.record_run([_result("a", 0.1)])
+
+        with patch.object(
+            sys, "argv", ["verdict", "history", "--history", str(db_path), "--no-color"]
+        ):
+            assert main() == 0
+
+        output = capsys.readouterr().out
+        assert "Slowest cases" in output
+        assert "Most regressed cases" in output
+        assert "Flaky cases" in output
+
+    def test_history_command_missing_database(self, temp_dir):
+        """Test that a missing history database is an error."""
+        argv = ["verdict", "history", "--history", str(temp_dir / "missing.db")]
+        with patch.object(sys, "argv", argv):
+            assert main() == 2
+
+
+def _write_suite(temp_dir, case_names, settings=None):
+    """Write a config with one single_file suite of passing cases."""
+    for name in case_names:
+        case = {"name": name, "input": name, "expected": {"text": name}}
+        (temp_dir / f"{name}.yaml").write_text(yaml.dump(case))
+
+    config = {
+        "targets": {"test": {"callable": "tests.conftest.dummy_callable"}},
+        "test_suites": [
+            {
+                "name": "suite",
+                "target": "test",
+                "type": "single_file",
+                "cases": [f"{name}.yaml" for name in case_names],
+            }
+        ],
+    }
+    if settings:
+        config["settings"] = settings
+
+    config_file = temp_dir / "config.yaml"
+    config_file.write_text(yaml.dump(config))
+    return config_file
@@ -0,0 +1,226 @@
+"""
+Tests for verdict.isolation module.
+
+Tests IsolatedExecutor timeouts, memory caps, CPU accounting and worker
+reuse, and isolated execution through TestRunner.
+"""
+
+import sys
+from unittest.mock import patch
+
+import pytest
+import yaml
+
+from verdict.cli import main
+from verdict.isolation import IsolatedExecutionError, IsolatedExecutor, IsolationOptions
+from verdict.runner import TestRunner
+
+requires_rlimit = pytest.mark.skipif(
+    sys.platform == "win32" or sys.platform == "darwin",
+    reason="RLIMIT_AS is only enforced on Linux",
+)
+
+requires_proc = pytest.mark.skipif(
+    not sys.platform.startswith("linux"),
+    reason="CPU time of hung workers is read from /proc",
+)
+
+
+@pytest.fixture
+def isolated():
+    """Create an isolated executor with a single worker and a short timeout."""
+    with IsolatedExecutor(workers=1, timeout=2.0) as executor:
+        yield executor
+
+
+class TestIsolatedExecutor:
+    """Test suite for IsolatedExecutor class."""
+
+    def test_execute_returns_result(self, isolated):
+        """Test that results are returned from the worker."""
+        result = isolated.execute("tests.conftest.dummy_callable", "test")
+
+        assert result == {"text": "test", "length": 4, "dummy": True}
+
+    def test_import_error_propagates(self, isolated):
+        """Test that import errors raised in the worker reach the caller."""
+        with pytest.raises(ImportError, match="has no attribute"):
+            isolated.execute("pathlib.NonExistentClass", "test")
+
+    def test_type_error_propagates(self, isolated):
+        """Test that wrong return types are reported as TypeError."""
+        with pytest.raises(TypeError, match="must return dict"):
+            isolated.execute("tests.conftest.bad_callable", "test")
+
+    def test_callable_exception_propagates(self, isolated):
+        """Test that exceptions raised by the callable reach the caller."""
+        with pytest.raises(Exception, match="Something went wrong"):
+            isolated.execute("tests.conftest.failing_callable", "test")
+
+    def test_worker_is_reused(self, isolated):
+        """Test that consecutive cases run in the same worker process."""
+        worker = isolated.pool.acquire()
+        isolated.pool.release(worker)
+
+        isolated.execute("tests.conftest.dummy_callable", "a")
+        isolated.execute("tests.conftest.dummy_callable", "b")
+
+        reused = isolated.pool.acquire()
+        assert reused.process.pid == worker.process.pid
+        isolated.pool.release(reused)
+
+    def test_workers_do_not_fork_from_threads(self, isolated):
+        """Test that workers come from a fork server or spawn, never a bare fork."""
+        assert isolated.pool._context.get_start_method() in ("forkserver", "spawn")
+
+    def test_timeout_replaces_worker(self):
+        """Test that a hung case times out and the pool keeps working."""
+        with IsolatedExecutor(workers=1, timeout=0.5) as executor:
+            with pytest.raises(IsolatedExecutionError, match="timed out after 0.5s"):
+                executor.execute("tests.conftest.sleeping_callable", "30")
+
+            result = executor.execute("tests.conftest.dummy_callable", "ok")
+
+        assert result["text"] == "ok"
+
+    def test_worker_crash_is_reported(self, isolated):
+        """Test that a worker dying mid-case is reported and replaced."""
+        with pytest.raises(IsolatedExecutionError, match="died"):
+            isolated.execute("tests.conftest.crashing_callable", "")
+
+        assert isolated.execute("tests.conftest.dummy_callable", "ok")["text"] == "ok"
+
+    def test_cpu_time_accounting(self, isolated):
+        """Test that CPU time is measured per case in the worker."""
+        _, busy_cpu = isolated.execute_with_usage("tests.conftest.spinning_callable", "0.2")
+        _, idle_cpu = isolated.execute_with_usage("tests.conftest.sleeping_callable", "0.2")
+
+        assert busy_cpu >= 0.1
+        assert idle_cpu < busy_cpu
+
+    def test_callable_error_reports_cpu_time(self, isolated):
+        """Test that exceptions from the worker carry the case's CPU time."""
+        with pytest.raises(Exception, match="Something went wrong") as excinfo:
+            isolated.execute_with_usage("tests.conftest.failing_callable", "test")
+
+        assert excinfo.value.cpu_time is not None
+
+    @requires_proc
+    def test_timeout_reports_cpu_time(self):
+        """Test that a timed-out case reports the CPU time its worker burned."""
+        with IsolatedExecutor(workers=1, timeout=0.5) as executor:
+            with pytest.raises(IsolatedExecutionError) as excinfo:
+                executor.execute_with_usage("tests.conftest.spinning_callable", "30")
+
+        assert excinfo.value.cpu_time >= 0.2
+
+    @requires_proc
+    def test_crash_reports_cpu_time(self, isolated):
+        """Test that a case whose worker died still reports CPU time."""
+        with pytest.raises(IsolatedExecutionError) as excinfo:
+            isolated.execute_with_usage("tests.conftest.crashing_callable", "")
+
+        assert excinfo.value.cpu_time is not None
+
+    @requires_rlimit
+    def test_memory_limit(self):
+        """Test that allocations beyond the cap fail without killing the run."""
+        with IsolatedExecutor(workers=1, timeout=10, memory_limit_mb=256) as executor:
+            with pytest.raises(MemoryError, match="256 MiB"):
+                executor.execute("tests.conftest.allocating_callable", "1024")
+
+            result = executor.execute("tests.conftest.allocating_callable", "8")
+
+        assert result["allocated"] == 8 * 1024 * 1024
+
+    @requires_rlimit
+    def test_memory_limit_is_per_case(self):
+        """Test that memory kept by earlier cases does not shrink later cases' cap."""
+        with IsolatedExecutor(workers=1, timeout=10, memory_limit_mb=256) as executor:
+            for _ in range(3):
+                result = executor.execute("tests.conftest.retaining_callable", "192")
+
+        assert result["retained"] == 3 * 192 * 1024 * 1024
+
+
+class TestIsolationOptions:
+    """Test suite for IsolationOptions configuration parsing."""
+
+    def test_disabled_settings(self):
+        """Test that missing or false settings disable isolation."""
+        assert IsolationOptions.from_setting(None) is None
+        assert IsolationOptions.from_setting(False) is None
+        assert IsolationOptions.from_setting({"enabled": False}) is None
+
+    def test_enabled_settings(self):
+        """Test that true or a mapping enables isolation."""
+        assert IsolationOptions.from_setting(True) == IsolationOptions()
+        assert IsolationOptions.from_setting(
+            {"timeout": 5, "memory_limit_mb": 128}
+        ) == IsolationOptions(timeout=5, memory_limit_mb=128)
+
+    def test_invalid_setting(self):
+        """Test that invalid setting types are rejected."""
+        with pytest.raises(ValueError):
+            IsolationOptions.from_setting("yes")
+
+
+class TestIsolatedRunner:
+    """Test suite for isolated execution through TestRunner and the CLI."""
+
+    def _write_config(self, temp_dir, settings=None):
+        """Write a suite with a passing case and a hanging case."""
+        cases = {
+            "fast": ("tests.conftest.dummy_callable", "hi", {"text": "hi"}),
+            "hang": ("tests.conftest.sleeping_callable", "30", {"slept": 30.0}),
+        }
+        config = {"targets": {}, "test_suites": []}
+        for name, (callable_path, input_text, expected) in cases.items():
+            (temp_dir / f"{name}.yaml").write_text(
+                yaml.dump({"name": name, "input": input_text, "expected": expected})
+            )
+            config["targets"][name] = {"callable": callable_path}
+            config["test_suites"].append(
+                {"name": name, "target": name, "type": "single_file", "file": f"{name}.yaml"}
+            )
+        if settings:
+            config["settings"] = settings
+
+        config_file = temp_dir / "config.yaml"
+        config_file.write_text(yaml.dump(config))
+        return config_file
+
+    def test_runner_times_out_hanging_case(self, temp_dir):
+        """Test that a hanging case fails with a timeout instead of hanging the run."""
+        config_file = self._write_config(temp_dir, {"isolation": {"timeout": 0.5}})
+
+        results = {r.test_name: r for r in TestRunner(config_file).run_all(max_workers=2)}
+
+        assert results["fast"].passed is True
+        assert results["fast"].cpu_time is not None
+        assert results["hang"].passed is False
+        assert "timed out" in results["hang"].error
+        if sys.platform.startswith("linux"):
+            assert results["hang"].cpu_time is not None
+        assert results["hang"].duration < 10
+
+    def test_runner_restores_in_process_executor(self, temp_dir):
+        """Test that the worker pool is shut down after run_all."""
+        config_file = self._write_config(temp_dir)
+        runner = TestRunner(config_file, isolation=IsolationOptions(timeout=0.5))
+        executor = runner.executor
+
+        runner.run_all(max_workers=1)
+
+        assert runner.executor is executor
+
+    def test_cli_timeout_flag(self, temp_dir):
+        """Test that --timeout enables isolation from the command line."""
+        config_file = self._write_config(temp_dir)
+
+        argv = ["verdict", "run", "--config", str(config_file), "--timeout", "0.5"]
+        with patch.object(sys, "argv", argv):
+            exit_code = main()
+
+        # The hanging case is reported as an execution error
+        assert exit_code == 2
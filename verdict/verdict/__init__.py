@@ -8,6 +8,7 @@ components by comparing actual outputs against expected results.
 __version__ = "1.0.0"
 
 from verdict.executor import TargetExecutor
+from verdict.history import ResultHistory
 from verdict.loader import ConfigLoader, TestCaseLoader
 from verdict.logger import TestLogger
 from verdict.runner import TestRunner
@@ -18,6 +19,7 @@ __all__ = [
     "TestCaseLoader",
     "TargetExecutor",
     "OutputValidator",
+    "ResultHistory",
     "TestRunner",
     "TestLogger",
 ]
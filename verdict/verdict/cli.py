@@ -7,9 +7,15 @@ This module provides the CLI for running tests and viewing results.
 import argparse
 import sys
 from pathlib import Path
+from typing import Optional
 
+import yaml
+
+from verdict.history import ResultHistory
+from verdict.isolation import IsolationOptions
 from verdict.logger import TestLogger
 from verdict.runner import TestRunner
+from verdict.tracing import set_service_name
 
 
 def main() -> int:
@@ -19,6 +25,7 @@ def main() -> int:
     Returns:
         Exit code (0 for success, 1 for failures, 2 for errors)
     """
+    set_service_name("verdict")
     parser = argparse.ArgumentParser(
         description="Verdict: Generic test validation framework",
         formatter_class=argparse.RawDescriptionHelpFormatter,
@@ -29,6 +36,9 @@ Examples:
   verdict run --config config.yaml --workers 8
   verdict run --config config.yaml --format json
   verdict run --config config.yaml --no-color
+  verdict run --config config.yaml --history .verdict/history.db
+  verdict run --config config.yaml --isolate --timeout 10 --memory-limit 512
+  verdict history --history .verdict/history.db --limit 20
         """,
     )
 
@@ -69,6 +79,79 @@ Examples:
         action="store_true",
         help="Disable colored output",
     )
+    run_parser.add_argument(
+        "--history",
+        type=str,
+        default=None,
+        help="Result history database to record into and schedule from "
+        "(default: settings.history from config, if set)",
+    )
+    run_parser.add_argument(
+        "--isolate",
+        action="store_true",
+        help="Run each case in a pooled worker process (default: settings.isolation)",
+    )
+    run_parser.add_argument(
+        "--timeout",
+        type=float,
+        default=None,
+        help="Per-case wall-clock timeout in seconds (implies --isolate)",
+    )
+    run_parser.add_argument(
+        "--memory-limit",
+        type=int,
+        default=None,
+        metavar="MB",
+        help="Per-case address-space cap in MiB (implies --isolate)",
+    )
+
+    # History command
+    history_parser = subparsers.add_parser(
+        "history", help="Show slowest, regressed and flaky cases from result history"
+    )
+    history_source = history_parser.add_mutually_exclusive_group(required=True)
+    history_source.add_argument(
+        "--history",
+        type=str,
+        help="Path to result history database",
+    )
+    history_source.add_argument(
+        "--config",
+        "-c",
+        type=str,
+        help="Configuration file whose settings.history database to read",
+    )
+    history_parser.add_argument(
+        "--limit",
+        "-n",
+        type=int,
+        default=10,
+        help="Number of cases to show per section (default: 10)",
+    )
+    history_parser.add_argument(
+        "--window",
+        type=int,
+        default=5,
+        help="Number of recent runs per case to consider (default: 5)",
+    )
+    history_parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.5,
+        help="Relative slowdown that counts as a regression (default: 0.5 = 50%%)",
+    )
+    history_parser.add_argument(
+        "--format",
+        "-f",
+        choices=["console", "json"],
+        default="console",
+        help="Output format (default: console)",
+    )
+    history_parser.add_argument(
+        "--no-color",
+        action="store_true",
+        help="Disable colored output",
+    )
 
     # Parse arguments
     args = parser.parse_args()
@@ -81,10 +164,42 @@ Examples:
     # Execute command
     if args.command == "run":
         return run_tests(args)
+    if args.command == "history":
+        return show_history(args)
 
     return 0
 
 
+def resolve_history_path(config_path: Path, history_arg: Optional[str]) -> Optional[Path]:
+    """
+    Resolve the result history database path.
+
+    An explicit --history argument wins; otherwise ``settings.history`` from
+    the configuration file is used, relative to the configuration directory.
+
+    Args:
+        config_path: Path to configuration YAML file
+        history_arg: Value of the --history argument (may be None)
+
+    Returns:
+        Path to the history database, or None if history is not enabled
+    """
+    if history_arg:
+        return Path(history_arg)
+
+    with open(config_path, "r", encoding="utf-8") as f:
+        config = yaml.safe_load(f) or {}
+
+    history_setting = (config.get("settings") or {}).get("history")
+    if not history_setting:
+        return None
+
+    history_path = Path(history_setting)
+    if not history_path.is_absolute():
+        history_path = config_path.parent / history_path
+    return history_path
+
+
 def run_tests(args: argparse.Namespace) -> int:
     """
     Run tests based on command-line arguments.
@@ -102,11 +217,25 @@ def run_tests(args: argparse.Namespace) -> int:
         print(f"Error: Configuration file not found: {config_path}", file=sys.stderr)
         return 2
 
+    history = None
     try:
+        # Open result history (if enabled) so durations drive scheduling
+        history_path = resolve_history_path(config_path, args.history)
+        if history_path is not None:
+            history = ResultHistory(history_path)
+
+        # Command-line isolation options override settings.isolation
+        isolation = None
+        if args.isolate or args.timeout is not None or args.memory_limit is not None:
+            isolation = IsolationOptions(timeout=args.timeout, memory_limit_mb=args.memory_limit)
+
         # Create runner and execute tests
-        runner = TestRunner(config_path)
+        runner = TestRunner(config_path, history=history, isolation=isolation)
         results = runner.run_all(max_workers=args.workers, case_filter=args.case)
 
+        if history is not None:
+            history.record_run(results, label=str(config_path))
+
         # Check if a filter was applied and no results were found
         if args.case and not results:
             print(f"Warning: No test cases found matching '{args.case}'", file=sys.stderr)
@@ -139,6 +268,62 @@ def run_tests(args: argparse.Namespace) -> int:
         print(f"Error: {e}", file=sys.stderr)
         return 2
 
+    finally:
+        if history is not None:
+            history.close()
+
+
+def show_history(args: argparse.Namespace) -> int:
+    """
+    Show the slowest, most-regressed and flaky cases from result history.
+
+    Args:
+        args: Parsed command-line arguments
+
+    Returns:
+        Exit code (0 for success, 2 for errors)
+    """
+    if args.config:
+        config_path = Path(args.config)
+        if not config_path.exists():
+            print(f"Error: Configuration file not found: {config_path}", file=sys.stderr)
+            return 2
+        history_path = resolve_history_path(config_path, None)
+        if history_path is None:
+            print(
+                f"Error: No settings.history configured in {config_path}",
+                file=sys.stderr,
+            )
+            return 2
+    else:
+        history_path = Path(args.history)
+
+    if not history_path.exists():
+        print(f"Error: History database not found: {history_path}", file=sys.stderr)
+        return 2
+
+    try:
+        with ResultHistory(history_path) as history:
+            report = {
+                "runs": history.get_run_count(),
+                "slowest": history.get_slowest_cases(limit=args.limit, window=args.window),
+                "regressed": history.get_regressed_cases(
+                    limit=args.limit, window=args.window, threshold=args.threshold
+                ),
+                "flaky": history.get_flaky_cases(limit=args.limit, window=args.window * 2),
+            }
+    except Exception as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 2
+
+    logger = TestLogger(use_color=not args.no_color)
+    if args.format == "json":
+        print(logger.log_history_json(report))
+    else:
+        logger.log_history_console(report)
+
+    return 0
+
 
 if __name__ == "__main__":
     sys.exit(main())
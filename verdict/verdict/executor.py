@@ -6,7 +6,8 @@ with input strings.
 """
 
 import importlib
-from typing import Callable, Dict
+import time
+from typing import Callable, Dict, Tuple
 
 
 class TargetExecutor:
@@ -58,6 +59,36 @@ class TargetExecutor:
 
         return result
 
+    def execute_with_usage(self, callable_path: str, input_text: str) -> Tuple[dict, float]:
+        """
+        Execute target callable and report the CPU time it consumed.
+
+        CPU time is measured on the calling thread, so it is accurate when
+        cases run concurrently on a thread pool.
+
+        Args:
+            callable_path: Dotted path to callable (e.g., "module.path.function")
+            input_text: Input string to pass to callable
+
+        Returns:
+            Tuple of (callable result, CPU seconds spent by this thread)
+
+        Raises:
+            ImportError: If module or callable cannot be imported
+            TypeError: If callable doesn't match (str) -> dict signature
+            Exception: Any exception raised by the callable
+
+        Raised exceptions carry the CPU seconds spent in a ``cpu_time``
+        attribute.
+        """
+        start_cpu = time.thread_time()
+        try:
+            result = self.execute(callable_path, input_text)
+        except Exception as e:
+            e.cpu_time = time.thread_time() - start_cpu
+            raise
+        return result, time.thread_time() - start_cpu
+
     def _import_callable(self, callable_path: str) -> Callable[[str], dict]:
         """
         Import callable from dotted path.
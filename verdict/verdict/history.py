@@ -0,0 +1,301 @@
+"""
+Persistent per-case result history.
+
+This module stores the outcome and duration of every executed test case in
+a compact local SQLite database, so results can be compared across runs to
+find slow, regressed, and flaky cases and to schedule long cases first.
+"""
+
+import sqlite3
+import statistics
+from datetime import datetime
+from pathlib import Path
+from typing import Any, Dict, List, Optional, Sequence
+
+from verdict.runner import TestResult
+from verdict.tracing import traced
+
+
+class ResultHistory:
+    """
+    Stores test case outcomes and durations across Verdict runs.
+
+    Cases are stored once in a lookup table and each run only appends
+    (run_id, case_id, passed, duration) rows, keeping the store compact.
+
+    Example:
+        >>> history = ResultHistory(Path(".verdict/history.db"))
+        >>> run_id = history.record_run(results)
+        >>> history.get_slowest_cases(limit=5)
+    """
+
+    def __init__(self, db_path: Path):
+        """
+        Initialize result history, creating the database if needed.
+
+        Args:
+            db_path: Path to SQLite database file
+        """
+        self.db_path = Path(db_path)
+        self.db_path.parent.mkdir(parents=True, exist_ok=True)
+        self.connection = sqlite3.connect(str(self.db_path), check_same_thread=False)
+        self.connection.row_factory = sqlite3.Row
+        self._create_schema()
+
+    def _create_schema(self) -> None:
+        """Create history tables and indexes if they don't exist."""
+        self.connection.executescript(
+            """
+            CREATE TABLE IF NOT EXISTS runs (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                timestamp TEXT NOT NULL,
+                label TEXT
+            );
+
+            CREATE TABLE IF NOT EXISTS cases (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                suite_name TEXT NOT NULL,
+                test_name TEXT NOT NULL,
+                UNIQUE (suite_name, test_name)
+            );
+
+            CREATE TABLE IF NOT EXISTS outcomes (
+                run_id INTEGER NOT NULL REFERENCES runs(id),
+                case_id INTEGER NOT NULL REFERENCES cases(id),
+                passed INTEGER NOT NULL,
+                errored INTEGER NOT NULL DEFAULT 0,
+                duration REAL NOT NULL,
+                PRIMARY KEY (case_id, run_id)
+            ) WITHOUT ROWID;
+            """
+        )
+        self.connection.commit()
+
+    def close(self) -> None:
+        """Close the database connection."""
+        self.connection.close()
+
+    def __enter__(self) -> "ResultHistory":
+        """Enter context manager."""
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb) -> None:
+        """Exit context manager and close the connection."""
+        self.close()
+
+    @traced("verdict.db.record_run")
+    def record_run(self, results: Sequence[TestResult], label: Optional[str] = None) -> int:
+        """
+        Record the outcome and duration of every result in a new run.
+
+        Args:
+            results: Test results from a single Verdict run
+            label: Optional run label (e.g., commit hash or config name)
+
+        Returns:
+            ID of the recorded run
+        """
+        with self.connection:
+            cursor = self.connection.execute(
+                "INSERT INTO runs (timestamp, label) VALUES (?, ?)",
+                (datetime.now().isoformat(), label),
+            )
+            run_id = cursor.lastrowid
+
+            self.connection.executemany(
+                "INSERT OR IGNORE INTO cases (suite_name, test_name) VALUES (?, ?)",
+                [(r.suite_name, r.test_name) for r in results],
+            )
+            self.connection.executemany(
+                """
+                INSERT OR REPLACE INTO outcomes (run_id, case_id, passed, errored, duration)
+                SELECT ?, id, ?, ?, ? FROM cases WHERE suite_name = ? AND test_name = ?
+                """,
+                [
+                    (
+                        run_id,
+                        int(r.passed),
+                        int(r.error is not None),
+                        r.duration,
+                        r.suite_name,
+                        r.test_name,
+                    )
+                    for r in results
+                ],
+            )
+
+        return run_id
+
+    def get_run_count(self) -> int:
+        """
+        Get the number of recorded runs.
+
+        Returns:
+            Number of runs in the history
+        """
+        return self.connection.execute("SELECT COUNT(*) FROM runs").fetchone()[0]
+
+    def get_expected_durations(self, suite_name: str, window: int = 5) -> Dict[str, float]:
+        """
+        Estimate each case's duration from its recent history.
+
+        Args:
+            suite_name: Name of the test suite
+            window: Number of most recent runs per case to consider
+
+        Returns:
+            Dictionary mapping test name to median recent duration in seconds
+        """
+        history = self._case_histories(window, suite_name=suite_name)
+        return {
+            test_name: statistics.median(entry["durations"])
+            for (_, test_name), entry in history.items()
+        }
+
+    def get_slowest_cases(self, limit: int = 10, window: int = 5) -> List[Dict[str, Any]]:
+        """
+        Get the cases with the highest median recent duration.
+
+        Args:
+            limit: Maximum number of cases to return
+            window: Number of most recent runs per case to consider
+
+        Returns:
+            List of case dictionaries sorted by median duration (descending)
+        """
+        cases = [
+            {
+                "suite_name": suite_name,
+                "test_name": test_name,
+                "median_duration": statistics.median(entry["durations"]),
+                "last_duration": entry["durations"][-1],
+                "runs": len(entry["durations"]),
+            }
+            for (suite_name, test_name), entry in self._case_histories(window).items()
+        ]
+        cases.sort(key=lambda c: c["median_duration"], reverse=True)
+        return cases[:limit]
+
+    def get_regressed_cases(
+        self,
+        limit: int = 10,
+        window: int = 5,
+        threshold: float = 0.5,
+        min_delta: float = 0.005,
+    ) -> List[Dict[str, Any]]:
+        """
+        Find cases whose latest duration regressed against their baseline.
+
+        The baseline is the median of the previous ``window`` durations. A case
+        is regressed when its latest duration exceeds the baseline by more than
+        ``threshold`` (relative) and ``min_delta`` seconds (absolute), so timer
+        noise on very fast cases is not reported.
+
+        Args:
+            limit: Maximum number of cases to return
+            window: Number of previous runs forming the baseline
+            threshold: Minimum relative slowdown (0.5 = 50% slower)
+            min_delta: Minimum absolute slowdown in seconds
+
+        Returns:
+            List of case dictionaries sorted by slowdown ratio (descending)
+        """
+        regressed = []
+        for (suite_name, test_name), entry in self._case_histories(window + 1).items():
+            durations = entry["durations"]
+            if len(durations) < 2:
+                continue
+
+            latest = durations[-1]
+            baseline = statistics.median(durations[:-1])
+            delta = latest - baseline
+            if delta <= min_delta or latest <= baseline * (1 + threshold):
+                continue
+
+            regressed.append(
+                {
+                    "suite_name": suite_name,
+                    "test_name": test_name,
+                    "baseline_duration": baseline,
+                    "last_duration": latest,
+                    "ratio": latest / baseline if baseline > 0 else float("inf"),
+                }
+            )
+
+        regressed.sort(key=lambda c: c["ratio"], reverse=True)
+        return regressed[:limit]
+
+    def get_flaky_cases(self, limit: int = 10, window: int = 10) -> List[Dict[str, Any]]:
+        """
+        Find cases whose outcome flipped between passing and failing.
+
+        Args:
+            limit: Maximum number of cases to return
+            window: Number of most recent runs per case to consider
+
+        Returns:
+            List of case dictionaries sorted by number of flips (descending)
+        """
+        flaky = []
+        for (suite_name, test_name), entry in self._case_histories(window).items():
+            outcomes = entry["outcomes"]
+            flips = sum(1 for a, b in zip(outcomes, outcomes[1:]) if a != b)
+            if flips == 0:
+                continue
+
+            flaky.append(
+                {
+                    "suite_name": suite_name,
+                    "test_name": test_name,
+                    "flips": flips,
+                    "pass_rate": sum(outcomes) / len(outcomes),
+                    "runs": len(outcomes),
+                }
+            )
+
+        flaky.sort(key=lambda c: (c["flips"], -c["pass_rate"]), reverse=True)
+        return flaky[:limit]
+
+    def _case_histories(
+        self, window: int, suite_name: Optional[str] = None
+    ) -> Dict[tuple, Dict[str, List]]:
+        """
+        Load the most recent outcomes of each case, oldest first.
+
+        Args:
+            window: Number of most recent runs per case to load
+            suite_name: Optional suite to restrict the query to
+
+        Returns:
+            Dictionary mapping (suite_name, test_name) to
+            {"durations": [...], "outcomes": [...]} in run order
+        """
+        query = """
+            SELECT suite_name, test_name, passed, duration FROM (
+                SELECT c.suite_name, c.test_name, o.passed, o.duration, o.run_id,
+                       ROW_NUMBER() OVER (
+                           PARTITION BY o.case_id ORDER BY o.run_id DESC
+                       ) AS recency
+                FROM outcomes o
+                JOIN cases c ON c.id = o.case_id
+                {where}
+            )
+            WHERE recency <= ?
+            ORDER BY suite_name, test_name, run_id
+        """
+        if suite_name is not None:
+            rows = self.connection.execute(
+                query.format(where="WHERE c.suite_name = ?"), (suite_name, window)
+            )
+        else:
+            rows = self.connection.execute(query.format(where=""), (window,))
+
+        history: Dict[tuple, Dict[str, List]] = {}
+        for row in rows:
+            entry = history.setdefault(
+                (row["suite_name"], row["test_name"]), {"durations": [], "outcomes": []}
+            )
+            entry["durations"].append(row["duration"])
+            entry["outcomes"].append(bool(row["passed"]))
+
+        return history
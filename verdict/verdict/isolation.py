@@ -0,0 +1,423 @@
+"""
+Subprocess-isolated target execution.
+
+This module runs target callables in a reusable pool of worker processes,
+so a pathological input (infinite loop, catastrophic regex backtracking,
+runaway allocation) costs one case instead of hanging the whole run.
+
+Each case gets a wall-clock timeout, an optional address-space cap
+(RLIMIT_AS) on top of what its worker already uses, and reports the CPU
+time its worker spent on it, whether it passed, raised, crashed or timed
+out. Workers are started once from a fork server (spawned where there is
+none) and reused; only a worker that timed out, crashed or ran out of
+memory is replaced.
+"""
+
+import multiprocessing
+import os
+import queue
+import sys
+import threading
+import time
+from contextlib import contextmanager
+from dataclasses import dataclass
+from typing import Any, Iterator, List, Optional, Tuple
+
+from verdict.executor import TargetExecutor
+
+try:
+    import resource
+except ImportError:  # pragma: no cover - Windows has no resource module
+    resource = None
+
+
+class IsolatedExecutionError(Exception):
+    """Raised when an isolated case times out or its worker process dies."""
+
+    def __init__(self, message: str, cpu_time: Optional[float] = None):
+        """
+        Initialize the error.
+
+        Args:
+            message: Error message
+            cpu_time: CPU seconds the worker spent on the case, if known
+        """
+        super().__init__(message)
+        self.cpu_time = cpu_time
+
+
+@dataclass
+class IsolationOptions:
+    """
+    Options for isolated execution.
+
+    Attributes:
+        timeout: Per-case wall-clock timeout in seconds (None = no timeout)
+        memory_limit_mb: Per-case address-space cap in MiB (None = no cap).
+            Ignored on platforms without the resource module.
+    """
+
+    timeout: Optional[float] = None
+    memory_limit_mb: Optional[int] = None
+
+    @classmethod
+    def from_setting(cls, setting: Any) -> Optional["IsolationOptions"]:
+        """
+        Build options from a ``settings.isolation`` configuration value.
+
+        Accepts ``true``/``false`` or a mapping with ``timeout`` and
+        ``memory_limit_mb`` keys.
+
+        Args:
+            setting: Value of settings.isolation
+
+        Returns:
+            IsolationOptions, or None if isolation is disabled
+
+        Raises:
+            ValueError: If the setting has an invalid type
+        """
+        if setting is None or setting is False:
+            return None
+        if setting is True:
+            return cls()
+        if isinstance(setting, dict):
+            if not setting.get("enabled", True):
+                return None
+            return cls(
+                timeout=setting.get("timeout"),
+                memory_limit_mb=setting.get("memory_limit_mb"),
+            )
+        raise ValueError("settings.isolation must be a boolean or a mapping")
+
+
+def _process_cpu_time(pid: int) -> Optional[float]:
+    """
+    Read the CPU time consumed so far by a (possibly hung) process.
+
+    Args:
+        pid: Process ID
+
+    Returns:
+        User plus system CPU seconds, or None where /proc is unavailable
+    """
+    try:
+        with open(f"/proc/{pid}/stat", "rb") as f:
+            # The command name may contain spaces; fields resume after ")"
+            fields = f.read().rsplit(b")", 1)[1].split()
+        return (int(fields[11]) + int(fields[12])) / os.sysconf("SC_CLK_TCK")
+    except (OSError, ValueError, IndexError, AttributeError):
+        return None
+
+
+def _address_space_bytes() -> Optional[int]:
+    """Return this process's current address-space size, if /proc has it."""
+    try:
+        with open("/proc/self/statm", "rb") as f:
+            return int(f.read().split()[0]) * os.sysconf("SC_PAGE_SIZE")
+    except (OSError, ValueError, IndexError, AttributeError):
+        return None
+
+
+@contextmanager
+def _memory_limit(memory_limit_mb: Optional[int]) -> Iterator[None]:
+    """
+    Cap the address space for one case and lift the cap afterwards.
+
+    The cap is added to what the worker already uses, so memory retained
+    by earlier cases does not eat into the budget of later ones.
+
+    Args:
+        memory_limit_mb: Address-space budget for the case (None = no cap)
+    """
+    if not memory_limit_mb or resource is None:
+        yield
+        return
+
+    soft, hard = resource.getrlimit(resource.RLIMIT_AS)
+    limit = int(memory_limit_mb) * 1024 * 1024 + (_address_space_bytes() or 0)
+    if hard != resource.RLIM_INFINITY:
+        limit = min(limit, hard)
+    resource.setrlimit(resource.RLIMIT_AS, (limit, hard))
+    try:
+        yield
+    finally:
+        resource.setrlimit(resource.RLIMIT_AS, (soft, hard))
+
+
+def _worker_main(conn: Any, memory_limit_mb: Optional[int], sys_path: List[str]) -> None:
+    """
+    Worker process loop: execute requests until the pipe closes.
+
+    Each request is a (callable_path, input_text) tuple. Each reply is a
+    ("ok", result, cpu_time) or ("error", exception, cpu_time) tuple.
+
+    Args:
+        conn: Worker end of the request/reply pipe
+        memory_limit_mb: Address-space cap to apply to each case
+        sys_path: Parent's import path, so targets resolve as they would
+            in-process
+    """
+    sys.path[:] = sys_path
+    executor = TargetExecutor()
+
+    while True:
+        try:
+            request = conn.recv()
+        except (EOFError, OSError):
+            break
+        if request is None:
+            break
+
+        callable_path, input_text = request
+        start_cpu = time.process_time()
+        try:
+            with _memory_limit(memory_limit_mb):
+                result = executor.execute(callable_path, input_text)
+            reply = ("ok", result, time.process_time() - start_cpu)
+        except Exception as e:
+            # TargetExecutor wraps callable errors, so check the cause as well
+            if isinstance(e, MemoryError) or isinstance(e.__cause__, MemoryError):
+                e = MemoryError(f"Callable '{callable_path}' exceeded {memory_limit_mb} MiB limit")
+            reply = ("error", e, time.process_time() - start_cpu)
+
+        try:
+            conn.send(reply)
+        except Exception:
+            # Unpicklable result or exception: report it as a plain error
+            conn.send(("error", RuntimeError(f"{type(reply[1]).__name__}: {reply[1]}"), reply[2]))
+
+
+class _Worker:
+    """A worker process and the parent end of its pipe."""
+
+    def __init__(self, context: Any, memory_limit_mb: Optional[int]):
+        """
+        Start a worker process.
+
+        Args:
+            context: multiprocessing context used to start the process
+            memory_limit_mb: Per-case address-space cap for the worker
+        """
+        self.conn, child_conn = context.Pipe()
+        self.process = context.Process(
+            target=_worker_main, args=(child_conn, memory_limit_mb, list(sys.path)), daemon=True
+        )
+        self.process.start()
+        child_conn.close()
+
+    def stop(self, force: bool = False) -> None:
+        """
+        Stop the worker process.
+
+        Args:
+            force: Kill immediately instead of asking the worker to exit
+        """
+        if not force:
+            try:
+                self.conn.send(None)
+            except (OSError, ValueError):
+                force = True
+
+        if force:
+            self.process.kill()
+        self.process.join(timeout=5)
+        self.conn.close()
+
+
+class WorkerPool:
+    """
+    Pool of reusable worker processes.
+
+    Workers are started from a fork server where the platform has one
+    (spawned otherwise) and handed out one per concurrent case. Replacements
+    are started from runner threads, and forking a multi-threaded process
+    directly could copy a lock held by another thread into the child.
+    """
+
+    def __init__(self, size: int, memory_limit_mb: Optional[int] = None):
+        """
+        Initialize the pool and start its workers.
+
+        Args:
+            size: Number of worker processes
+            memory_limit_mb: Per-case address-space cap for each worker
+        """
+        methods = multiprocessing.get_all_start_methods()
+        start_method = "forkserver" if "forkserver" in methods else "spawn"
+        self._context = multiprocessing.get_context(start_method)
+        self._memory_limit_mb = memory_limit_mb
+        self._idle: "queue.Queue[_Worker]" = queue.Queue()
+        self._workers: List[_Worker] = []
+        self._lock = threading.Lock()
+        self._closed = False
+
+        for _ in range(max(1, size)):
+            self._idle.put(self._start_worker())
+
+    def _start_worker(self) -> _Worker:
+        """Start a worker and track it for shutdown."""
+        with self._lock:
+            worker = _Worker(self._context, self._memory_limit_mb)
+            self._workers.append(worker)
+            return worker
+
+    def acquire(self) -> _Worker:
+        """
+        Take an idle worker, blocking until one is available.
+
+        Returns:
+            Idle worker
+        """
+        return self._idle.get()
+
+    def release(self, worker: _Worker) -> None:
+        """
+        Return a healthy worker to the pool.
+
+        Args:
+            worker: Worker previously returned by acquire()
+        """
+        self._idle.put(worker)
+
+    def replace(self, worker: _Worker) -> None:
+        """
+        Kill a broken or hung worker and add a fresh one to the pool.
+
+        Args:
+            worker: Worker previously returned by acquire()
+        """
+        worker.stop(force=True)
+        with self._lock:
+            self._workers.remove(worker)
+            if self._closed:
+                return
+        self._idle.put(self._start_worker())
+
+    def close(self) -> None:
+        """Stop all workers."""
+        with self._lock:
+            self._closed = True
+            workers = list(self._workers)
+            self._workers.clear()
+
+        for worker in workers:
+            worker.stop()
+
+
+class IsolatedExecutor:
+    """
+    Executes target callables in isolated worker processes.
+
+    Drop-in replacement for TargetExecutor that enforces a per-case timeout
+    and memory cap. Results, ImportError/TypeError and target exceptions are
+    propagated from the worker unchanged.
+    """
+
+    def __init__(
+        self,
+        workers: int = 1,
+        timeout: Optional[float] = None,
+        memory_limit_mb: Optional[int] = None,
+    ):
+        """
+        Initialize isolated executor and start its worker pool.
+
+        Args:
+            workers: Number of worker processes (match the runner's parallelism)
+            timeout: Per-case wall-clock timeout in seconds (None = no timeout)
+            memory_limit_mb: Per-case address-space cap in MiB (None = no cap)
+        """
+        self.timeout = timeout
+        self.memory_limit_mb = memory_limit_mb
+        self.pool = WorkerPool(workers, memory_limit_mb)
+
+    def execute(self, callable_path: str, input_text: str) -> dict:
+        """
+        Execute target callable in a worker process.
+
+        Args:
+            callable_path: Dotted path to callable (e.g., "module.path.function")
+            input_text: Input string to pass to callable
+
+        Returns:
+            Dictionary returned by the callable
+
+        Raises:
+            IsolatedExecutionError: If the case times out or the worker dies
+            Exception: Any exception raised in the worker by TargetExecutor
+        """
+        result, _ = self.execute_with_usage(callable_path, input_text)
+        return result
+
+    def execute_with_usage(self, callable_path: str, input_text: str) -> Tuple[dict, float]:
+        """
+        Execute target callable in a worker and report its CPU time.
+
+        Args:
+            callable_path: Dotted path to callable
+            input_text: Input string to pass to callable
+
+        Returns:
+            Tuple of (callable result, CPU seconds spent by the worker)
+
+        Raises:
+            IsolatedExecutionError: If the case times out or the worker dies
+            Exception: Any exception raised in the worker by TargetExecutor
+
+        Every raised exception carries the case's CPU seconds in a
+        ``cpu_time`` attribute (None if it could not be measured).
+        """
+        worker = self.pool.acquire()
+        # The worker is idle between cases, so its CPU time since now is
+        # the case's, even if it hangs or dies before replying
+        start_cpu = _process_cpu_time(worker.process.pid)
+
+        def worker_cpu_time() -> Optional[float]:
+            end_cpu = _process_cpu_time(worker.process.pid)
+            if start_cpu is None or end_cpu is None:
+                return None
+            return end_cpu - start_cpu
+
+        try:
+            worker.conn.send((callable_path, input_text))
+
+            if not worker.conn.poll(self.timeout):
+                cpu_time = worker_cpu_time()
+                self.pool.replace(worker)
+                raise IsolatedExecutionError(
+                    f"Callable '{callable_path}' timed out after {self.timeout}s", cpu_time
+                )
+
+            status, payload, cpu_time = worker.conn.recv()
+        except (EOFError, OSError) as e:
+            cpu_time = worker_cpu_time()
+            exit_code = worker.process.exitcode
+            self.pool.replace(worker)
+            raise IsolatedExecutionError(
+                f"Worker executing '{callable_path}' died (exit code {exit_code})", cpu_time
+            ) from e
+
+        if status == "ok":
+            self.pool.release(worker)
+            return payload, cpu_time
+
+        # A worker that hit its memory cap may be left in a bad state
+        if isinstance(payload, MemoryError):
+            self.pool.replace(worker)
+        else:
+            self.pool.release(worker)
+        payload.cpu_time = cpu_time
+        raise payload
+
+    def close(self) -> None:
+        """Stop all worker processes."""
+        self.pool.close()
+
+    def __enter__(self) -> "IsolatedExecutor":
+        """Enter context manager."""
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb) -> None:
+        """Exit context manager and stop workers."""
+        self.close()
@@ -5,7 +5,7 @@ This module handles formatting and displaying test results in various formats.
 """
 
 import json
-from typing import Dict, List
+from typing import Any, Dict, List
 
 from verdict.runner import TestResult
 
@@ -81,12 +81,70 @@ class TestLogger:
                 "total": total,
                 "passed": passed,
                 "failed": failed,
+                "duration": sum(r.duration for r in results),
             },
             "results": [r.to_dict() for r in results],
         }
 
         return json.dumps(output, indent=2)
 
+    def log_history_console(self, report: Dict[str, Any]) -> None:
+        """
+        Output a result history report to console.
+
+        Args:
+            report: Dictionary with "runs", "slowest", "regressed" and "flaky"
+                case lists, as produced by the ``verdict history`` command
+        """
+        print("\n" + "=" * 70)
+        print(f"RESULT HISTORY: {report['runs']} run(s) recorded")
+        print("=" * 70)
+
+        print("\nSlowest cases (median duration)")
+        print("-" * 70)
+        if not report["slowest"]:
+            print("  (no recorded cases)")
+        for case in report["slowest"]:
+            print(
+                f"  {case['median_duration']:>9.3f}s  "
+                f"{case['suite_name']}::{case['test_name']} ({case['runs']} run(s))"
+            )
+
+        print("\nMost regressed cases (latest vs baseline)")
+        print("-" * 70)
+        if not report["regressed"]:
+            self._print_colored("  No duration regressions", "green")
+        for case in report["regressed"]:
+            self._print_colored(
+                f"  {case['ratio']:>8.2f}x  {case['suite_name']}::{case['test_name']} "
+                f"({case['baseline_duration']:.3f}s -> {case['last_duration']:.3f}s)",
+                "yellow",
+            )
+
+        print("\nFlaky cases (outcome flips)")
+        print("-" * 70)
+        if not report["flaky"]:
+            self._print_colored("  No flaky cases", "green")
+        for case in report["flaky"]:
+            self._print_colored(
+                f"  {case['flips']:>3} flip(s)  {case['suite_name']}::{case['test_name']} "
+                f"(pass rate {case['pass_rate']:.0%} over {case['runs']} run(s))",
+                "red",
+            )
+        print()
+
+    def log_history_json(self, report: Dict[str, Any]) -> str:
+        """
+        Output a result history report as JSON string.
+
+        Args:
+            report: Result history report dictionary
+
+        Returns:
+            JSON-formatted string
+        """
+        return json.dumps(report, indent=2)
+
     def _print_suite_results(self, suite_name: str, results: List[TestResult]) -> None:
         """
         Print results for a single test suite.
@@ -5,14 +5,20 @@ This module coordinates test execution, manages parallelism, and aggregates resu
 """
 
 import os
+import time
 from concurrent.futures import ThreadPoolExecutor, as_completed
 from pathlib import Path
-from typing import Any, Dict, List, Optional
+from typing import TYPE_CHECKING, Any, Dict, List, Optional
 
 from verdict.executor import TargetExecutor
+from verdict.isolation import IsolatedExecutor, IsolationOptions
 from verdict.loader import ConfigLoader, TestCaseLoader
+from verdict.tracing import span
 from verdict.validator import OutputValidator
 
+if TYPE_CHECKING:
+    from verdict.history import ResultHistory
+
 
 class TestResult:
     """Represents the result of a single test case execution."""
@@ -24,6 +30,8 @@ class TestResult:
         passed: bool,
         differences: Optional[List[str]] = None,
         error: Optional[str] = None,
+        duration: float = 0.0,
+        cpu_time: Optional[float] = None,
     ):
         """
         Initialize test result.
@@ -34,12 +42,18 @@ class TestResult:
             passed: Whether the test passed
             differences: List of differences (if validation failed)
             error: Error message (if execution failed)
+            duration: Wall-clock execution time in seconds
+            cpu_time: CPU time spent in the target callable in seconds
+                (None if it could not be measured, e.g. a hung worker on a
+                platform without /proc)
         """
         self.test_name = test_name
         self.suite_name = suite_name
         self.passed = passed
         self.differences = differences or []
         self.error = error
+        self.duration = duration
+        self.cpu_time = cpu_time
 
     def to_dict(self) -> Dict[str, Any]:
         """Convert result to dictionary."""
@@ -49,6 +63,8 @@ class TestResult:
             "passed": self.passed,
             "differences": self.differences,
             "error": self.error,
+            "duration": self.duration,
+            "cpu_time": self.cpu_time,
         }
 
 
@@ -59,22 +75,37 @@ class TestRunner:
     Loads configuration, executes tests with parallelism, and aggregates results.
     """
 
-    def __init__(self, config_path: Path):
+    def __init__(
+        self,
+        config_path: Path,
+        history: Optional["ResultHistory"] = None,
+        isolation: Optional[IsolationOptions] = None,
+    ):
         """
         Initialize test runner.
 
         Args:
             config_path: Path to configuration YAML file
+            history: Optional result history used to schedule the slowest
+                known cases first when running in parallel
+            isolation: Optional isolated execution options; defaults to
+                settings.isolation from the configuration file
         """
         self.config_path = Path(config_path)
         self.config_loader = ConfigLoader(self.config_path)
         self.test_case_loader = TestCaseLoader(base_path=self.config_path.parent)
         self.executor = TargetExecutor()
         self.validator = OutputValidator()
+        self.history = history
 
         # Load configuration
         self.config = self.config_loader.load()
 
+        if isolation is None:
+            settings = self.config.get("settings") or {}
+            isolation = IsolationOptions.from_setting(settings.get("isolation"))
+        self.isolation = isolation
+
     def run_all(
         self, max_workers: Optional[int] = None, case_filter: Optional[str] = None
     ) -> List[TestResult]:
@@ -100,9 +131,26 @@ class TestRunner:
         results = []
         test_suites = self.config["test_suites"]
 
-        for suite_config in test_suites:
-            suite_results = self.run_suite(suite_config, max_workers, case_filter=case_filter)
-            results.extend(suite_results)
+        # In isolated mode, one worker process per parallel slot serves all suites
+        in_process_executor = self.executor
+        if self.isolation is not None:
+            self.executor = IsolatedExecutor(
+                workers=max_workers,
+                timeout=self.isolation.timeout,
+                memory_limit_mb=self.isolation.memory_limit_mb,
+            )
+
+        try:
+            for suite_config in test_suites:
+                with span("verdict.suite", suite=suite_config["name"]):
+                    suite_results = self.run_suite(
+                        suite_config, max_workers, case_filter=case_filter
+                    )
+                results.extend(suite_results)
+        finally:
+            if self.executor is not in_process_executor:
+                self.executor.close()
+                self.executor = in_process_executor
 
         return results
 
@@ -209,6 +257,9 @@ class TestRunner:
         """
         results = []
 
+        if self.history is not None:
+            test_cases = self._schedule_by_duration(test_cases, suite_name)
+
         with ThreadPoolExecutor(max_workers=max_workers) as executor:
             # Submit all tasks
             future_to_test = {
@@ -225,6 +276,30 @@ class TestRunner:
 
         return results
 
+    def _schedule_by_duration(
+        self, test_cases: List[Dict[str, Any]], suite_name: str
+    ) -> List[Dict[str, Any]]:
+        """
+        Order test cases longest-first using historical durations.
+
+        Submitting the longest cases first keeps a slow case from starting
+        last and stretching the tail of a parallel run. Cases without history
+        are treated as longest, since their cost is unknown.
+
+        Args:
+            test_cases: List of test case dictionaries
+            suite_name: Name of the test suite
+
+        Returns:
+            Test cases sorted by expected duration (descending)
+        """
+        durations = self.history.get_expected_durations(suite_name)
+        return sorted(
+            test_cases,
+            key=lambda tc: durations.get(tc["name"], float("inf")),
+            reverse=True,
+        )
+
     def _execute_test_case(
         self,
         test_case: Dict[str, Any],
@@ -254,9 +329,13 @@ class TestRunner:
             # Use input as-is (should be a string)
             input_text = test_input
 
+        start_time = time.perf_counter()
         try:
             # Execute target callable
-            actual_output = self.executor.execute(callable_path, input_text)
+            with span("verdict.case", suite=suite_name, case=test_name):
+                actual_output, cpu_time = self.executor.execute_with_usage(
+                    callable_path, input_text
+                )
 
             # Validate output
             is_valid, differences = self.validator.validate(actual_output, expected_output)
@@ -266,6 +345,8 @@ class TestRunner:
                 suite_name=suite_name,
                 passed=is_valid,
                 differences=differences if not is_valid else None,
+                duration=time.perf_counter() - start_time,
+                cpu_time=cpu_time,
             )
 
         except Exception as e:
@@ -275,4 +356,6 @@ class TestRunner:
                 suite_name=suite_name,
                 passed=False,
                 error=str(e),
+                duration=time.perf_counter() - start_time,
+                cpu_time=getattr(e, "cpu_time", None),
             )
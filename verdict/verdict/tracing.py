@@ -0,0 +1,45 @@
+"""
+Tracing spans for Verdict.
+
+Re-exports Anvil's shared tracing (anvil.utils.tracing) so Verdict's spans
+join the trace of the other tools; set ARGOS_TRACE to a file to turn it on.
+Without Anvil installed, span() and traced() do nothing.
+
+Generated by anvil/scripts/generate_tracing_shims.py; edit the template
+there instead of this file.
+"""
+
+try:
+    from anvil.utils.tracing import set_service_name, span, traced
+except ImportError:  # pragma: no cover - Anvil is optional
+
+    class _NoopSpan:
+        """Span stand-in used without Anvil."""
+
+        def set_attribute(self, key, value):
+            """Do nothing."""
+
+        def end(self):
+            """Do nothing."""
+
+        def __enter__(self):
+            return self
+
+        def __exit__(self, exc_type, exc_val, exc_tb):
+            return False
+
+    _NOOP_SPAN = _NoopSpan()
+
+    def set_service_name(name):
+        """Do nothing."""
+
+    def span(name, /, **attributes):
+        """Return a span that does nothing."""
+        return _NOOP_SPAN
+
+    def traced(name=None, **attributes):
+        """Return the function unchanged."""
+        return lambda func: func
+
+
+__all__ = ["set_service_name", "span", "traced"]